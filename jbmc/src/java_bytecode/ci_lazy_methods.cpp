@@ -132,12 +132,17 @@ bool ci_lazy_methodst::operator()(
   std::unordered_set<class_method_descriptor_exprt, irep_hash>
     called_virtual_functions;
   bool class_initializer_seen = false;
+  resolved_callsitest resolved_callsites;
 
   messaget log{message_handler};
 
+  std::size_t round = 0;
   bool any_new_classes = true;
   while(any_new_classes)
   {
+    const std::size_t methods_before = methods_already_populated.size();
+    const std::size_t classes_before = instantiated_classes.size();
+
     bool any_new_methods = true;
     while(any_new_methods)
     {
@@ -170,17 +175,20 @@ bool ci_lazy_methodst::operator()(
                   << called_virtual_functions.size() << " callsites)"
                   << messaget::eom;
 
-      for(const class_method_descriptor_exprt &called_virtual_function :
-          called_virtual_functions)
-      {
-        get_virtual_method_targets(
-          called_virtual_function,
-          instantiated_classes,
-          methods_to_convert_later,
-          symbol_table);
-      }
+      add_virtual_method_targets(
+        called_virtual_functions,
+        instantiated_classes,
+        resolved_callsites,
+        methods_to_convert_later,
+        symbol_table);
     }
 
+    log.debug() << "CI lazy methods: round " << ++round << " elaborated "
+                << methods_already_populated.size() - methods_before
+                << " methods and instantiated "
+                << instantiated_classes.size() - classes_before << " classes"
+                << messaget::eom;
+
     any_new_classes = handle_virtual_methods_with_no_callees(
       methods_to_convert_later,
       instantiated_classes,
@@ -499,6 +507,70 @@ void ci_lazy_methodst::get_virtual_method_targets(
   }
 }
 
+/// Add the possible callees of the virtual call sites to
+/// \p methods_to_convert_later, taking into account only what has changed
+/// since the last call: the targets of a new call site are looked up in the
+/// class it calls a method of and all its subclasses, while a newly
+/// instantiated class can only add its own implementation to the call sites
+/// on it and on its ancestors.
+/// \param called_virtual_functions: all virtual call sites seen so far
+/// \param instantiated_classes: set of classes that can be instantiated
+/// \param [in,out] resolved_callsites: the call sites and classes taken into
+///   account by previous calls
+/// \param [out] methods_to_convert_later: populated with the callees
+/// \param symbol_table: global symbol table
+void ci_lazy_methodst::add_virtual_method_targets(
+  const std::unordered_set<class_method_descriptor_exprt, irep_hash>
+    &called_virtual_functions,
+  const std::unordered_set<irep_idt> &instantiated_classes,
+  resolved_callsitest &resolved_callsites,
+  std::unordered_set<irep_idt> &methods_to_convert_later,
+  symbol_tablet &symbol_table)
+{
+  for(const irep_idt &class_name : instantiated_classes)
+  {
+    if(!resolved_callsites.classes.insert(class_name).second)
+      continue;
+
+    class_hierarchyt::idst self_and_parent_classes =
+      class_hierarchy.get_parents_trans(class_name);
+    self_and_parent_classes.push_back(class_name);
+
+    for(const irep_idt &call_class : self_and_parent_classes)
+    {
+      const auto callsites = resolved_callsites.by_class.find(call_class);
+      if(callsites == resolved_callsites.by_class.end())
+        continue;
+
+      for(const class_method_descriptor_exprt &callsite : callsites->second)
+      {
+        const irep_idt method_id = get_virtual_method_target(
+          instantiated_classes,
+          callsite.mangled_method_name(),
+          class_name,
+          symbol_table);
+        if(!method_id.empty())
+          methods_to_convert_later.insert(method_id);
+      }
+    }
+  }
+
+  for(const class_method_descriptor_exprt &called_virtual_function :
+      called_virtual_functions)
+  {
+    if(!resolved_callsites.callsites.insert(called_virtual_function).second)
+      continue;
+
+    resolved_callsites.by_class[called_virtual_function.class_id()].push_back(
+      called_virtual_function);
+    get_virtual_method_targets(
+      called_virtual_function,
+      instantiated_classes,
+      methods_to_convert_later,
+      symbol_table);
+  }
+}
+
 /// See output
 /// \param e: expression tree to search
 /// \param symbol_table: global symbol table
@@ -17,7 +17,9 @@ Author: Diffblue Ltd.
 
 #include <functional>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <util/irep.h>
 
@@ -129,6 +131,24 @@ private:
     std::unordered_set<irep_idt> &callable_methods,
     symbol_tablet &symbol_table);
 
+  /// The virtual call sites whose targets have been added, by the class they
+  /// call a method of, and the instantiated classes taken into account
+  struct resolved_callsitest
+  {
+    std::unordered_set<class_method_descriptor_exprt, irep_hash> callsites;
+    std::unordered_map<irep_idt, std::vector<class_method_descriptor_exprt>>
+      by_class;
+    std::unordered_set<irep_idt> classes;
+  };
+
+  void add_virtual_method_targets(
+    const std::unordered_set<class_method_descriptor_exprt, irep_hash>
+      &called_virtual_functions,
+    const std::unordered_set<irep_idt> &instantiated_classes,
+    resolved_callsitest &resolved_callsites,
+    std::unordered_set<irep_idt> &methods_to_convert_later,
+    symbol_tablet &symbol_table);
+
   void gather_needed_globals(
     const exprt &e,
     const symbol_tablet &symbol_table,
@@ -0,0 +1,122 @@
+/*******************************************************************\
+
+Module: On-Disk Index of JAR Files
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// On-Disk Index of JAR Files
+
+#include "jar_index_cache.h"
+
+#include <util/exception_utils.h>
+#include <util/file_util.h>
+
+#include "jar_pool.h"
+
+#include <sys/stat.h>
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+/// The first line of an index file, to be changed with the format
+static const char index_header[] = "jar-index 1";
+
+/// \return a line identifying the version of \p jar_path, from its size and
+///   modification time, or an empty string if it cannot be accessed
+static std::string jar_version(const std::string &jar_path)
+{
+#ifdef _WIN32
+  struct _stat info;
+  if(_stat(jar_path.c_str(), &info) != 0)
+    return {};
+#else
+  struct stat info;
+  if(stat(jar_path.c_str(), &info) != 0)
+    return {};
+#endif
+
+  std::ostringstream version;
+  version << info.st_size << ' ' << info.st_mtime;
+  return version.str();
+}
+
+std::string jar_index_cachet::index_file(const std::string &jar_path) const
+{
+  // FNV-1a, which unlike std::hash yields the same name in each build
+  std::uint64_t hash = 14695981039346656037u;
+  for(const char ch : jar_path)
+  {
+    hash ^= static_cast<unsigned char>(ch);
+    hash *= 1099511628211u;
+  }
+
+  std::ostringstream name;
+  name << std::hex << hash << ".index";
+  return concat_dir_file(directory, name.str());
+}
+
+const std::unordered_set<std::string> &
+jar_index_cachet::entries(const std::string &jar_path, jar_poolt &jar_pool)
+{
+  const auto entry = indices.find(jar_path);
+  if(entry != indices.end())
+    return entry->second;
+
+  // An index file consists of the header, the path of the JAR file (as
+  // several paths may share a name), the version of the JAR file and then
+  // the names of its entries, one per line.
+  const std::string file_name = index_file(jar_path);
+  const std::string version = jar_version(jar_path);
+
+  std::unordered_set<std::string> &result = indices[jar_path];
+
+  std::ifstream in(file_name);
+  std::string header, path, index_version;
+  if(
+    !version.empty() && std::getline(in, header) && header == index_header &&
+    std::getline(in, path) && path == jar_path &&
+    std::getline(in, index_version) && index_version == version)
+  {
+    std::string name;
+    while(std::getline(in, name))
+      result.insert(name);
+    return result;
+  }
+
+  for(auto &name : jar_pool(jar_path).filenames())
+    result.insert(std::move(name));
+
+  if(
+    version.empty() ||
+    (!is_directory(directory) && !create_directory(directory)))
+  {
+    return result;
+  }
+
+  // write to a temporary file first, as other runs may read the index
+  const std::string tmp_file_name = file_name + ".tmp";
+  {
+    std::ofstream out(tmp_file_name);
+    out << index_header << '\n' << jar_path << '\n' << version << '\n';
+    for(const auto &name : result)
+      out << name << '\n';
+    if(!out)
+      return result;
+  }
+
+  try
+  {
+    file_rename(tmp_file_name, file_name);
+  }
+  catch(const system_exceptiont &)
+  {
+    // the index is merely not cached
+    file_remove(tmp_file_name);
+  }
+
+  return result;
+}
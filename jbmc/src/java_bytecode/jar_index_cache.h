@@ -0,0 +1,50 @@
+/*******************************************************************\
+
+Module: On-Disk Index of JAR Files
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// On-Disk Index of JAR Files
+
+#ifndef CPROVER_JAVA_BYTECODE_JAR_INDEX_CACHE_H
+#define CPROVER_JAVA_BYTECODE_JAR_INDEX_CACHE_H
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+class jar_poolt;
+
+/// A directory of files holding the names of the entries of JAR files, one
+/// file per JAR file, such that later runs can tell whether a JAR file
+/// contains a class without opening it. An index is used only while the size
+/// and modification time of its JAR file are those it was written for, and
+/// is rewritten from the JAR file otherwise.
+class jar_index_cachet
+{
+public:
+  explicit jar_index_cachet(std::string directory)
+    : directory(std::move(directory))
+  {
+  }
+
+  /// \return the names of the entries of \p jar_path, from the index in the
+  ///   cache if it is up to date, or else read from the JAR file in
+  ///   \p jar_pool and written to the cache
+  /// \throw std::runtime_error if the JAR file cannot be opened
+  const std::unordered_set<std::string> &
+  entries(const std::string &jar_path, jar_poolt &jar_pool);
+
+protected:
+  std::string directory;
+
+  /// The indices used so far, by the path of the JAR file
+  std::unordered_map<std::string, std::unordered_set<std::string>> indices;
+
+  std::string index_file(const std::string &jar_path) const;
+};
+
+#endif // CPROVER_JAVA_BYTECODE_JAR_INDEX_CACHE_H
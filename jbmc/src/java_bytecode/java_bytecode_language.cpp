@@ -103,6 +103,8 @@ void parse_java_language_options(const cmdlinet &cmd, optionst &options)
     options.set_option(
       "java-cp-include-files", cmd.get_value("java-cp-include-files"));
   }
+  if(cmd.isset("java-jar-index"))
+    options.set_option("java-jar-index", cmd.get_value("java-jar-index"));
   if(cmd.isset("static-values"))
   {
     options.set_option("static-values", cmd.get_value("static-values"));
@@ -191,6 +193,7 @@ java_bytecode_language_optionst::java_bytecode_language_optionst(
     std::back_inserter(extra_methods),
     build_load_method_by_regex);
 
+  jar_index_directory = options.get_option("java-jar-index");
   java_cp_include_files = options.get_option("java-cp-include-files");
   if(!java_cp_include_files.empty())
   {
@@ -298,6 +301,12 @@ void java_bytecode_languaget::initialize_class_loader()
 {
   java_class_loader.clear_classpath();
 
+  if(!language_options->jar_index_directory.empty())
+  {
+    java_class_loader.set_jar_index_directory(
+      language_options->jar_index_directory);
+  }
+
   for(const auto &p : config.java.classpath)
     java_class_loader.add_classpath_entry(p, get_message_handler());
 
@@ -35,11 +35,13 @@ Author: Daniel Kroening, kroening@kroening.com
   "(java-assume-inputs-non-null)" \
   "(java-assume-inputs-interval):" \
   "(java-assume-inputs-integral)" \
+  "(java-share-nondet-initializers)" \
   "(throw-runtime-exceptions)" \
   "(max-nondet-array-length):" \
   "(max-nondet-tree-depth):" \
   "(java-max-vla-length):" \
   "(java-cp-include-files):" \
+  "(java-jar-index):" \
   "(ignore-manifest-main-class)" \
   "(context-include):" \
   "(context-exclude):" \
@@ -75,9 +77,15 @@ Author: Daniel Kroening, kroening@kroening.com
   " --java-assume-inputs-integral\n" \
   "                              force float and double inputs to have integer values;\n" /* NOLINT(*) */ \
   "                              does not work for arrays;\n" /* NOLINT(*) */ \
+  " --java-share-nondet-initializers\n" \
+  "                              initialize input objects of the same class\n" /* NOLINT(*) */ \
+  "                              by calling a function shared between them\n" /* NOLINT(*) */ \
   " --java-max-vla-length N      limit the length of user-code-created arrays\n" /* NOLINT(*) */ \
   " --java-cp-include-files r    regexp or JSON list of files to load\n" \
   "                              (with '@' prefix)\n" \
+  " --java-jar-index dir         keep an index of the files in each JAR file\n" \
+  "                              in dir, which spares opening the JAR files\n" \
+  "                              that lack a class in later runs\n" \
   " --ignore-manifest-main-class ignore Main-Class entries in JAR manifest files.\n" /* NOLINT(*) */ \
   "                              If this option is specified and the options\n" /* NOLINT(*) */ \
   "                              --function and --main-class are not, we can be\n" /* NOLINT(*) */ \
@@ -239,6 +247,8 @@ struct java_bytecode_language_optionst
   /// list of classes to force load even without reference from the entry point
   std::vector<irep_idt> java_load_classes;
   std::string java_cp_include_files;
+  /// Directory of the on-disk index of the JAR files, if not empty
+  std::string jar_index_directory;
   /// JSON which contains initial values of static fields (right
   /// after the static initializer of the class was run). This is read from the
   /// file specified by the --static-values command-line option.
@@ -10,6 +10,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <algorithm>
 #include <fstream>
+#include <iterator>
 #include <map>
 #include <string>
 
@@ -47,6 +48,12 @@ public:
 
   java_bytecode_parse_treet parse_tree;
 
+  /// The class file is read from the bytes from \ref input up to
+  /// \ref input_end rather than from the stream of \ref parsert, which saves
+  /// a call into the stream for each byte
+  const char *input = nullptr;
+  const char *input_end = nullptr;
+
 private:
   using classt = java_bytecode_parse_treet::classt;
   using methodt = java_bytecode_parse_treet::methodt;
@@ -114,15 +121,12 @@ private:
 
   void skip_bytes(std::size_t bytes)
   {
-    for(std::size_t i=0; i<bytes; i++)
+    if(static_cast<std::size_t>(input_end - input) < bytes)
     {
-      if(!*in)
-      {
-        error() << "unexpected end of bytecode file" << eom;
-        throw 0;
-      }
-      in->get();
+      error() << "unexpected end of bytecode file" << eom;
+      throw 0;
     }
+    input += bytes;
   }
 
   template <typename T>
@@ -131,16 +135,16 @@ private:
     static_assert(
       std::is_unsigned<T>::value, "T should be an unsigned integer");
     const constexpr size_t bytes = sizeof(T);
+    if(static_cast<std::size_t>(input_end - input) < bytes)
+    {
+      error() << "unexpected end of bytecode file" << eom;
+      throw 0;
+    }
     u8 result = 0;
     for(size_t i = 0; i < bytes; i++)
     {
-      if(!*in)
-      {
-        error() << "unexpected end of bytecode file" << eom;
-        throw 0;
-      }
       result <<= 8u;
-      result |= static_cast<u1>(in->get());
+      result |= static_cast<u1>(*input++);
     }
     return narrow_cast<T>(result);
   }
@@ -1807,9 +1811,24 @@ optionalt<java_bytecode_parse_treet> java_bytecode_parse(
   const irep_idt &class_name,
   message_handlert &message_handler,
   bool skip_instructions)
+{
+  const std::string data{std::istreambuf_iterator<char>(istream),
+                         std::istreambuf_iterator<char>()};
+
+  return java_bytecode_parse(
+    data.data(), data.size(), class_name, message_handler, skip_instructions);
+}
+
+optionalt<java_bytecode_parse_treet> java_bytecode_parse(
+  const char *data,
+  std::size_t size,
+  const irep_idt &class_name,
+  message_handlert &message_handler,
+  bool skip_instructions)
 {
   java_bytecode_parsert java_bytecode_parser(skip_instructions);
-  java_bytecode_parser.in=&istream;
+  java_bytecode_parser.input = data;
+  java_bytecode_parser.input_end = data + size;
   java_bytecode_parser.set_message_handler(message_handler);
 
   bool parser_result=java_bytecode_parser.parse();
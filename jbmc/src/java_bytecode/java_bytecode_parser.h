@@ -43,4 +43,20 @@ optionalt<java_bytecode_parse_treet> java_bytecode_parse(
   class message_handlert &msg,
   bool skip_instructions = false);
 
+/// Attempt to parse a Java class from the \p size bytes at \p data, such
+/// as the contents of an entry of a JAR file, without copying them
+/// \param data: the contents of the class file
+/// \param size: the size of the class file
+/// \param class_name: name of the class to load
+/// \param msg: handles log messages
+/// \param skip_instructions: if true, the loaded class's methods will all be
+///   empty. Saves time and memory for consumers that only want signature info.
+/// \return parse tree, or empty optionalt on failure
+optionalt<java_bytecode_parse_treet> java_bytecode_parse(
+  const char *data,
+  std::size_t size,
+  const irep_idt &class_name,
+  class message_handlert &msg,
+  bool skip_instructions = false);
+
 #endif // CPROVER_JAVA_BYTECODE_JAVA_BYTECODE_PARSER_H
@@ -17,6 +17,18 @@ Author: Daniel Kroening, kroening@kroening.com
 
 java_class_loadert::parse_tree_with_overlayst &java_class_loadert::
 operator()(const irep_idt &class_name, message_handlert &message_handler)
+{
+  load_classes({class_name}, message_handler);
+  return class_map.at(class_name);
+}
+
+/// Load the classes in \p class_names, the ones that are always required and
+/// all classes these refer to, in a single pass over the class references.
+/// \param class_names: names of the classes to load
+/// \param message_handler: message handler
+void java_class_loadert::load_classes(
+  const std::vector<irep_idt> &class_names,
+  message_handlert &message_handler)
 {
   messaget log(message_handler);
 
@@ -38,7 +50,8 @@ operator()(const irep_idt &class_name, message_handlert &message_handler)
   // Require java.lang.Throwable as the catch-type used for
   // universal exception handlers:
   queue.push("java.lang.Throwable");
-  queue.push(class_name);
+  for(const auto &class_name : class_names)
+    queue.push(class_name);
 
   // Require user provided classes to be loaded even without explicit reference
   for(const auto &id : java_load_classes)
@@ -72,8 +85,6 @@ operator()(const irep_idt &class_name, message_handlert &message_handler)
         queue.push(id);
     }
   }
-
-  return class_map.at(class_name);
 }
 
 /// Check if class is an overlay class by searching for `ID_overlay_class` in
@@ -220,8 +231,10 @@ std::vector<irep_idt> java_class_loadert::load_entire_jar(
   classpath_entries.push_front(
     classpath_entryt(classpath_entryt::JAR, jar_path));
 
-  for(const auto &c : *classes)
-    operator()(c, message_handler);
+  // one pass for all classes, rather than one for each, as each pass sets
+  // up the class loading limit and revisits the classes that are always
+  // required
+  load_classes(*classes, message_handler);
 
   classpath_entries.pop_front();
 
@@ -237,7 +250,7 @@ optionalt<std::vector<irep_idt>> java_class_loadert::read_jar_file(
   std::vector<std::string> filenames;
   try
   {
-    filenames = jar_pool(jar_path).filenames();
+    filenames = jar_filenames(jar_path);
   }
   catch(const std::runtime_error &)
   {
@@ -107,6 +107,9 @@ private:
 
   optionalt<std::vector<irep_idt>>
   read_jar_file(const std::string &jar_path, message_handlert &);
+
+  void
+  load_classes(const std::vector<irep_idt> &class_names, message_handlert &);
 };
 
 #endif // CPROVER_JAVA_BYTECODE_JAVA_CLASS_LOADER_H
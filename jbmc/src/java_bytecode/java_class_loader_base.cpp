@@ -164,8 +164,18 @@ java_class_loader_baset::get_class_from_jar(
 
   try
   {
+    const std::string entry_name = class_name_to_jar_file(class_name);
+
+    // spare opening JAR files that do not have the class
+    if(
+      jar_index.has_value() &&
+      jar_index->entries(jar_file, jar_pool).count(entry_name) == 0)
+    {
+      return {};
+    }
+
     auto &jar = jar_pool(jar_file);
-    auto data = jar.get_entry(class_name_to_jar_file(class_name));
+    auto data = jar.get_entry(entry_name);
 
     if(!data.has_value())
       return {};
@@ -173,8 +183,8 @@ java_class_loader_baset::get_class_from_jar(
     log.debug() << "Getting class '" << class_name << "' from JAR " << jar_file
                 << messaget::eom;
 
-    std::istringstream istream(*data);
-    return java_bytecode_parse(istream, class_name, message_handler);
+    return java_bytecode_parse(
+      data->data(), data->size(), class_name, message_handler);
   }
   catch(const std::runtime_error &)
   {
@@ -184,6 +194,16 @@ java_class_loader_baset::get_class_from_jar(
   }
 }
 
+std::vector<std::string>
+java_class_loader_baset::jar_filenames(const std::string &jar_path)
+{
+  if(!jar_index.has_value())
+    return jar_pool(jar_path).filenames();
+
+  const auto &entries = jar_index->entries(jar_path, jar_pool);
+  return {entries.begin(), entries.end()};
+}
+
 /// Load class from directory.
 /// \param class_name: name of class to load in Java source format
 /// \param path: directory to load from
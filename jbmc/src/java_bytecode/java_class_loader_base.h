@@ -12,8 +12,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/irep.h>
 #include <util/optional.h>
 
+#include "jar_index_cache.h"
 #include "jar_pool.h"
 
+#include <list>
+
 class message_handlert;
 struct java_bytecode_parse_treet;
 
@@ -37,6 +40,13 @@ public:
   static std::string class_name_to_os_file(const irep_idt &);
   static std::string class_name_to_jar_file(const irep_idt &);
 
+  /// Keep an index of the entries of each JAR file in \p directory, which
+  /// spares opening the JAR files that do not contain a class in later runs
+  void set_jar_index_directory(const std::string &directory)
+  {
+    jar_index.emplace(directory);
+  }
+
   /// a cache for jar_filet, by path name
   jar_poolt jar_pool;
 
@@ -57,6 +67,13 @@ protected:
   /// List of entries in the classpath
   std::list<classpath_entryt> classpath_entries;
 
+  /// The on-disk index of the JAR files, if any
+  optionalt<jar_index_cachet> jar_index;
+
+  /// \return the names of the files in \p jar_path
+  /// \throw std::runtime_error if the JAR file cannot be opened
+  std::vector<std::string> jar_filenames(const std::string &jar_path);
+
   /// attempt to load a class from a classpath_entry
   optionalt<java_bytecode_parse_treet> load_class(
     const irep_idt &class_name,
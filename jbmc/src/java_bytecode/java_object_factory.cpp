@@ -58,6 +58,11 @@ class java_object_factoryt
 
   allocate_objectst allocate_objects;
 
+  /// The functions that initialize the root objects of a class at a depth,
+  /// if object_factory_parameters.share_nondet_initializers is set
+  std::map<std::pair<irep_idt, std::size_t>, symbol_exprt>
+    nondet_init_functions;
+
   /// Log for reporting warnings and errors in object creation
   messaget log;
 
@@ -136,6 +141,11 @@ private:
     size_t depth,
     const source_locationt &location);
 
+  symbol_exprt gen_nondet_init_function(
+    const pointer_typet &pointer_type,
+    size_t depth,
+    const source_locationt &location);
+
   code_blockt assign_element(
     const exprt &element,
     update_in_placet update_in_place,
@@ -530,6 +540,7 @@ void java_object_factoryt::gen_nondet_pointer_init(
   // it points.
   const struct_typet &struct_type = to_struct_type(followed_subtype);
   const irep_idt &struct_tag = struct_type.get_tag();
+  const bool is_root = recursion_set.empty();
 
   // If this is a recursive type of some kind AND the depth is exceeded, set
   // the pointer to null.
@@ -606,14 +617,33 @@ void java_object_factoryt::gen_nondet_pointer_init(
   // and asign to `expr` the address of such object
   code_blockt non_null_inst;
 
-  gen_pointer_target_init(
-    non_null_inst,
-    expr,
-    subtype,
-    lifetime,
-    depth,
-    update_in_placet::NO_UPDATE_IN_PLACE,
-    location);
+  // The code for the object at the root of the tree depends on its type and
+  // depth only, and can be shared if it is not generic
+  const auto class_type = type_try_dynamic_cast<java_class_typet>(struct_type);
+  if(
+    object_factory_parameters.share_nondet_initializers && is_root &&
+    update_in_place == update_in_placet::NO_UPDATE_IN_PLACE &&
+    lifetime == lifetimet::DYNAMIC && expr.type() == pointer_type &&
+    !is_java_generic_type(pointer_type) && class_type &&
+    !is_java_generic_class_type(*class_type) &&
+    !is_java_implicitly_generic_class_type(*class_type) &&
+    !has_prefix(id2string(struct_tag), "java::array[") &&
+    !class_type->get_base("java::java.lang.Enum"))
+  {
+    non_null_inst.add(code_function_callt{
+      expr, gen_nondet_init_function(pointer_type, depth, location), {}});
+  }
+  else
+  {
+    gen_pointer_target_init(
+      non_null_inst,
+      expr,
+      subtype,
+      lifetime,
+      depth,
+      update_in_placet::NO_UPDATE_IN_PLACE,
+      location);
+  }
 
   const code_assignt set_null_inst{
     expr, null_pointer_exprt{pointer_type}, location};
@@ -714,6 +744,94 @@ symbol_exprt java_object_factoryt::gen_nondet_subtype_pointer_init(
   return new_symbol_expr;
 }
 
+/// Get a function that allocates an object of dynamic lifetime of the class
+/// that \p pointer_type points to, nondet-initializes its members like
+/// \ref gen_pointer_target_init and returns a pointer to it, creating the
+/// function if there is none yet. The function is shared by the objects at
+/// the root of object trees, whose initialization does not depend on any
+/// object containing them. Its name includes the depth and
+/// object_factory_parameters.min_null_tree_depth, which differs between
+/// inputs, while the remaining parameters are the same for a symbol table.
+/// \param pointer_type: The type of the pointer to return, which points to a
+///   class that is not generic
+/// \param depth: Number of times that a pointer has been dereferenced from the
+///   root of the object tree that we are initializing
+/// \param location: Source location associated with nondet-initialization
+/// \return A symbol expression for the function
+symbol_exprt java_object_factoryt::gen_nondet_init_function(
+  const pointer_typet &pointer_type,
+  size_t depth,
+  const source_locationt &location)
+{
+  const namespacet ns(symbol_table);
+  const java_class_typet &class_type =
+    to_java_class_type(ns.follow(pointer_type.subtype()));
+  const irep_idt &class_name = class_type.get_name();
+
+  const auto function_it = nondet_init_functions.find({class_name, depth});
+  if(function_it != nondet_init_functions.end())
+    return function_it->second;
+
+  const irep_idt function_id =
+    id2string(class_name) + ".<nondet_init>:" + std::to_string(depth) + ":" +
+    std::to_string(object_factory_parameters.min_null_tree_depth);
+
+  // created by another instance of this class for the same symbol table
+  if(const auto function_symbol = symbol_table.lookup(function_id))
+  {
+    const symbol_exprt function = function_symbol->symbol_expr();
+    nondet_init_functions.emplace(std::make_pair(class_name, depth), function);
+    return function;
+  }
+
+  // The objects and temporaries must be created within the function, with
+  // the class already on the path to them
+  java_object_factory_parameterst function_parameters =
+    object_factory_parameters;
+  function_parameters.function_id = function_id;
+  java_object_factoryt function_factory(
+    location,
+    function_parameters,
+    symbol_table,
+    pointer_type_selector,
+    log.get_message_handler());
+  function_factory.recursion_set = recursion_set;
+
+  const symbol_exprt result =
+    function_factory.allocate_objects.allocate_automatic_local_object(
+      pointer_type, "tmp_object_factory");
+  code_blockt assignments;
+  function_factory.gen_pointer_target_init(
+    assignments,
+    result,
+    pointer_type.subtype(),
+    lifetimet::DYNAMIC,
+    depth,
+    update_in_placet::NO_UPDATE_IN_PLACE,
+    location);
+
+  code_blockt body;
+  function_factory.declare_created_symbols(body);
+  body.append(assignments);
+  body.add(code_returnt{result});
+
+  symbolt function_symbol;
+  function_symbol.name = function_id;
+  function_symbol.pretty_name = function_id;
+  function_symbol.base_name = "<nondet_init>";
+  function_symbol.type = java_method_typet({}, pointer_type);
+  function_symbol.value = std::move(body);
+  function_symbol.location = location;
+  function_symbol.mode = ID_java;
+  set_declaring_class(function_symbol, class_name);
+  const bool failed = symbol_table.add(function_symbol);
+  INVARIANT(!failed, "nondet initializer symbol should be fresh");
+
+  const symbol_exprt function = function_symbol.symbol_expr();
+  nondet_init_functions.emplace(std::make_pair(class_name, depth), function);
+  return function;
+}
+
 /// Creates an alternate_casest vector in which each item contains an
 /// assignment of a string from \p string_input_values (or more precisely the
 /// literal symbol corresponding to the string) to \p expr.
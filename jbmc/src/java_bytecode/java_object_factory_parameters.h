@@ -29,6 +29,10 @@ struct java_object_factory_parameterst final : public object_factory_parameterst
   /// Force double and float inputs to be integral
   bool assume_inputs_integral;
 
+  /// Initialize the objects of dynamic lifetime at the root of an object tree
+  /// by calling a function generated once per class and depth
+  bool share_nondet_initializers = false;
+
   /// Assigns the parameters from given options
   void set(const optionst &);
 };
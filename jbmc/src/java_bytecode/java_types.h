@@ -219,7 +219,7 @@ public:
     }
   };
 
-  using componentst = std::vector<componentt>;
+  using componentst = irep_sub_containert<componentt>;
 
   const componentst &components() const
   {
@@ -295,7 +295,7 @@ public:
     }
   };
 
-  using methodst = std::vector<methodt>;
+  using methodst = irep_sub_containert<methodt>;
 
   const methodst &methods() const
   {
@@ -308,7 +308,7 @@ public:
   }
 
   using static_membert = componentt;
-  using static_memberst = std::vector<componentt>;
+  using static_memberst = irep_sub_containert<componentt>;
 
   const static_memberst &static_members() const
   {
@@ -732,7 +732,7 @@ public:
   }
 
 private:
-  typedef std::vector<type_variablet> type_variablest;
+  typedef irep_sub_containert<type_variablet> type_variablest;
   const type_variablest &type_variables() const
   {
     return (const type_variablest &)(find(ID_type_variables).get_sub());
@@ -856,7 +856,7 @@ inline java_generic_parametert &to_java_generic_parameter(typet &type)
 class java_generic_struct_tag_typet : public struct_tag_typet
 {
 public:
-  typedef std::vector<reference_typet> generic_typest;
+  typedef irep_sub_containert<reference_typet> generic_typest;
 
   explicit java_generic_struct_tag_typet(const struct_tag_typet &type)
     : struct_tag_typet(type)
@@ -970,7 +970,7 @@ inline java_generic_typet &to_java_generic_type(typet &type)
 class java_generic_class_typet:public java_class_typet
 {
  public:
-  typedef std::vector<java_generic_parametert> generic_typest;
+  typedef irep_sub_containert<java_generic_parametert> generic_typest;
 
   java_generic_class_typet()
   {
@@ -172,13 +172,15 @@ private:
     const key_type &name,
     symbol_table_baset &function_symbol_table) const
   {
-    // Fill in symbol table entry body if not already done
-    language_files.convert_lazy_method(name, function_symbol_table);
-
+    // Functions already converted, or read from a goto binary, such as one
+    // of prebuilt library models, need no conversion from bytecode
     underlying_mapt::iterator it = goto_functions.find(name);
     if(it != goto_functions.end())
       return *it;
 
+    // Fill in symbol table entry body if not already done
+    language_files.convert_lazy_method(name, function_symbol_table);
+
     goto_functiont function;
 
     // First chance: see if the driver program wants to provide a replacement:
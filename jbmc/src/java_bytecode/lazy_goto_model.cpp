@@ -268,6 +268,14 @@ void lazy_goto_modelt::initialize(
   config.set_object_bits_from_symbol_table(symbol_table);
 }
 
+bool lazy_goto_modelt::rebuild_entry_point()
+{
+  if(symbol_table.has_symbol(goto_functionst::entry_point()))
+    remove_existing_entry_point(symbol_table);
+
+  return language_files.generate_support_functions(symbol_table);
+}
+
 /// Eagerly loads all functions from the symbol table.
 void lazy_goto_modelt::load_all_functions() const
 {
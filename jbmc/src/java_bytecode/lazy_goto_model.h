@@ -183,6 +183,13 @@ public:
   /// Eagerly loads all functions from the symbol table.
   void load_all_functions() const;
 
+  /// Replace the entry point generated by \ref initialize by one for the
+  /// function `config.main` now denotes, which must have been loaded, e.g.,
+  /// as an extra entry point of lazy method loading. Must be called before
+  /// the entry point is loaded.
+  /// \return true on error
+  bool rebuild_entry_point();
+
   void unload(const irep_idt &name) const
   {
     goto_functions.unload(name);
@@ -89,18 +89,21 @@ class remove_exceptionst
 
 public:
   typedef std::function<bool(const irep_idt &)> function_may_throwt;
+  typedef std::map<irep_idt, std::set<irep_idt>> exceptions_mapt;
 
   explicit remove_exceptionst(
     symbol_table_baset &_symbol_table,
     const class_hierarchyt *_class_hierarchy,
     function_may_throwt _function_may_throw,
     bool _remove_added_instanceof,
-    message_handlert &_message_handler)
+    message_handlert &_message_handler,
+    const exceptions_mapt *_exceptions_map = nullptr)
     : symbol_table(_symbol_table),
       class_hierarchy(_class_hierarchy),
       function_may_throw(_function_may_throw),
       remove_added_instanceof(_remove_added_instanceof),
-      message_handler(_message_handler)
+      message_handler(_message_handler),
+      exceptions_map(_exceptions_map)
   {
     if(remove_added_instanceof)
     {
@@ -122,6 +125,10 @@ protected:
   bool remove_added_instanceof;
   message_handlert &message_handler;
 
+  /// The types of the exceptions that may escape each function, if known,
+  /// such that the handlers no such exception is caught by can be skipped
+  const exceptions_mapt *exceptions_map;
+
   enum class instrumentation_resultt
   {
     DID_NOTHING,
@@ -149,7 +156,12 @@ protected:
     goto_programt &goto_program,
     const goto_programt::targett &instr_it,
     const stack_catcht &stack_catch,
-    const std::vector<symbol_exprt> &locals);
+    const std::vector<symbol_exprt> &locals,
+    const std::set<irep_idt> *thrown_types = nullptr);
+
+  bool may_catch(
+    const irep_idt &handler_type,
+    const std::set<irep_idt> &thrown_types) const;
 
   bool instrument_throw(
     const irep_idt &function_identifier,
@@ -310,6 +322,28 @@ goto_programt::targett remove_exceptionst::find_universal_exception(
   return goto_program.get_end_function();
 }
 
+/// \return whether a handler of exceptions of type \p handler_type may catch
+///   an exception of one of the \p thrown_types, i.e., whether one of them
+///   is \p handler_type or one of its subtypes
+bool remove_exceptionst::may_catch(
+  const irep_idt &handler_type,
+  const std::set<irep_idt> &thrown_types) const
+{
+  PRECONDITION(class_hierarchy != nullptr);
+
+  for(const irep_idt &thrown_type : thrown_types)
+  {
+    if(thrown_type == handler_type)
+      return true;
+
+    const auto parents = class_hierarchy->get_parents_trans(thrown_type);
+    if(std::find(parents.begin(), parents.end(), handler_type) != parents.end())
+      return true;
+  }
+
+  return false;
+}
+
 /// Emit the code:
 /// if (exception instanceof ExnA) then goto handlerA
 /// else if (exception instanceof ExnB) then goto handlerB
@@ -320,12 +354,15 @@ goto_programt::targett remove_exceptionst::find_universal_exception(
 ///   exception source
 /// \param stack_catch: exception handlers currently registered
 /// \param locals: local variables to kill on a function-exit edge
+/// \param thrown_types: if not null, the types of the exceptions that may be
+///   in flight; handlers that cannot catch any of them are left out
 void remove_exceptionst::add_exception_dispatch_sequence(
   const irep_idt &function_identifier,
   goto_programt &goto_program,
   const goto_programt::targett &instr_it,
   const remove_exceptionst::stack_catcht &stack_catch,
-  const std::vector<symbol_exprt> &locals)
+  const std::vector<symbol_exprt> &locals,
+  const std::set<irep_idt> *thrown_types)
 {
   // Jump to the universal handler or function end, as appropriate.
   // This will appear after the GOTO-based dynamic dispatch below
@@ -356,7 +393,10 @@ void remove_exceptionst::add_exception_dispatch_sequence(
       j--;
       goto_programt::targett new_state_pc=
         stack_catch[i][j].second;
-      if(!stack_catch[i][j].first.empty())
+      if(
+        !stack_catch[i][j].first.empty() &&
+        (thrown_types == nullptr ||
+         may_catch(stack_catch[i][j].first, *thrown_types)))
       {
         // Normal exception handler, make an instanceof check.
         goto_programt::targett t_exc = goto_program.insert_after(
@@ -469,8 +509,21 @@ remove_exceptionst::instrument_function_call(
     }
     else
     {
+      const std::set<irep_idt> *thrown_types = nullptr;
+      if(exceptions_map != nullptr && class_hierarchy != nullptr)
+      {
+        const auto entry = exceptions_map->find(callee_id);
+        if(entry != exceptions_map->end())
+          thrown_types = &entry->second;
+      }
+
       add_exception_dispatch_sequence(
-        function_identifier, goto_program, instr_it, stack_catch, locals);
+        function_identifier,
+        goto_program,
+        instr_it,
+        stack_catch,
+        locals,
+        thrown_types);
 
       // add a null check (so that instanceof can be applied)
       goto_program.insert_after(
@@ -709,7 +762,12 @@ void remove_exceptions(
     };
 
   remove_exceptionst remove_exceptions(
-    symbol_table, &class_hierarchy, function_may_throw, true, message_handler);
+    symbol_table,
+    &class_hierarchy,
+    function_may_throw,
+    true,
+    message_handler,
+    &exceptions_map);
 
   remove_exceptions(goto_functions);
 }
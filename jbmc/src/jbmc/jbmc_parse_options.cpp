@@ -12,13 +12,22 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "jbmc_parse_options.h"
 
 #include <cstdlib> // exit()
+#include <fstream>
 #include <iostream>
 #include <memory>
 
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
 #include <util/config.h>
 #include <util/exit_codes.h>
 #include <util/invariant.h>
 #include <util/make_unique.h>
+#include <util/process_pool.h>
+#include <util/string2int.h>
+#include <util/tempfile.h>
 #include <util/version.h>
 #include <util/xml.h>
 
@@ -64,6 +73,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <java_bytecode/java_single_path_symex_checker.h>
 #include <java_bytecode/java_single_path_symex_only_checker.h>
 #include <java_bytecode/lazy_goto_model.h>
+#include <java_bytecode/load_method_by_regex.h>
 #include <java_bytecode/remove_exceptions.h>
 #include <java_bytecode/remove_instanceof.h>
 #include <java_bytecode/remove_java_new.h>
@@ -193,6 +203,29 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("localize-faults"))
     options.set_option("localize-faults", true);
 
+  if(cmdline.isset("property-jobs"))
+  {
+    options.set_option("property-jobs", cmdline.get_value("property-jobs"));
+  }
+
+  if(cmdline.isset("property-conflict-budget"))
+  {
+    options.set_option(
+      "property-conflict-budget",
+      cmdline.get_value("property-conflict-budget"));
+  }
+
+  if(cmdline.isset("property-cache"))
+    options.set_option("property-cache", cmdline.get_value("property-cache"));
+
+  if(cmdline.isset("stream-equation"))
+  {
+    options.set_option("stream-equation", true);
+  }
+
+  if(cmdline.isset("memory-budget"))
+    options.set_option("memory-budget", cmdline.get_value("memory-budget"));
+
   if(cmdline.isset("symex-complexity-limit"))
   {
     options.set_option(
@@ -206,6 +239,9 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
       cmdline.get_value("symex-complexity-failed-child-loops-limit"));
   }
 
+  if(cmdline.isset("symex-complexity-adaptive"))
+    options.set_option("symex-complexity-adaptive", true);
+
   if(cmdline.isset("unwind"))
     options.set_option("unwind", cmdline.get_value("unwind"));
 
@@ -264,6 +300,12 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
     "slice-formula",
     cmdline.isset("slice-formula"));
 
+  if(cmdline.isset("deduplicate-steps"))
+    options.set_option("deduplicate-steps", true);
+
+  if(cmdline.isset("symmetry-breaking"))
+    options.set_option("symmetry-breaking", true);
+
   // simplify if conditions and branches
   if(cmdline.isset("no-simplify-if"))
     options.set_option("simplify-if", false);
@@ -406,6 +448,9 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("trace", true);
   }
 
+  if(cmdline.isset("graphml-compact-proof"))
+    options.set_option("graphml-compact-proof", true);
+
   if(cmdline.isset("symex-coverage-report"))
     options.set_option(
       "symex-coverage-report",
@@ -424,6 +469,19 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
   options.set_option(
     "symex-cache-dereferences", cmdline.isset("symex-cache-dereferences"));
 
+  if(cmdline.isset("symex-simplify-cache-size"))
+  {
+    options.set_option(
+      "symex-simplify-cache-size",
+      cmdline.get_value("symex-simplify-cache-size"));
+  }
+
+  if(cmdline.isset("symex-rename-cache-size"))
+  {
+    options.set_option(
+      "symex-rename-cache-size", cmdline.get_value("symex-rename-cache-size"));
+  }
+
   PARSE_OPTIONS_GOTO_TRACE(cmdline, options);
 
   if(cmdline.isset("no-lazy-methods"))
@@ -454,6 +512,34 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("java-threading"))
     options.set_option("allow-pointer-unsoundness", true);
 
+  if(cmdline.isset("batch-functions"))
+  {
+    if(cmdline.isset("function") || cmdline.isset("symex-driven-lazy-loading"))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "cannot use --batch-functions with --function or "
+        "--symex-driven-lazy-loading",
+        "--batch-functions");
+    }
+
+    // all entry methods need to be loaded, whichever the first one is
+    optionst::value_listt entry_points =
+      options.get_list_option("lazy-methods-extra-entry-point");
+    entry_points.push_back(cmdline.get_value("batch-functions"));
+    options.set_option("lazy-methods-extra-entry-point", entry_points);
+  }
+
+  if(cmdline.isset("batch-jobs"))
+  {
+    const auto jobs = string2optional_size_t(cmdline.get_value("batch-jobs"));
+    if(!jobs.has_value() || *jobs == 0)
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "the number of jobs must be a positive integer", "--batch-jobs");
+    }
+    options.set_option("batch-jobs", cmdline.get_value("batch-jobs"));
+  }
+
   if(cmdline.isset("show-goto-symex-steps"))
     options.set_option("show-goto-symex-steps", true);
 }
@@ -559,11 +645,21 @@ int jbmc_parse_optionst::doit()
   stub_objects_are_not_null =
     options.get_bool_option("java-assume-inputs-non-null");
 
+  if(cmdline.isset("batch-functions"))
+    return verify_batch(options);
+
   std::unique_ptr<abstract_goto_modelt> goto_model_ptr;
   int get_goto_program_ret = get_goto_program(goto_model_ptr, options);
   if(get_goto_program_ret != -1)
     return get_goto_program_ret;
 
+  return verify(*goto_model_ptr, options);
+}
+
+int jbmc_parse_optionst::verify(
+  abstract_goto_modelt &goto_model,
+  const optionst &options)
+{
   if(
     options.get_bool_option("program-only") ||
     options.get_bool_option("show-vcc") ||
@@ -576,21 +672,21 @@ int jbmc_parse_optionst::doit()
     if(options.get_bool_option("paths"))
     {
       all_properties_verifiert<java_single_path_symex_only_checkert> verifier(
-        options, ui_message_handler, *goto_model_ptr);
+        options, ui_message_handler, goto_model);
       (void)verifier();
     }
     else
     {
       all_properties_verifiert<java_multi_path_symex_only_checkert> verifier(
-        options, ui_message_handler, *goto_model_ptr);
+        options, ui_message_handler, goto_model);
       (void)verifier();
     }
 
     if(options.get_bool_option("symex-driven-lazy-loading"))
     {
       // We can only output these after goto-symex has run.
-      (void)show_loaded_symbols(*goto_model_ptr);
-      (void)show_loaded_functions(*goto_model_ptr);
+      (void)show_loaded_symbols(goto_model);
+      (void)show_loaded_functions(goto_model);
     }
 
     return CPROVER_EXIT_SUCCESS;
@@ -602,13 +698,13 @@ int jbmc_parse_optionst::doit()
     if(options.get_bool_option("paths"))
     {
       stop_on_fail_verifiert<java_single_path_symex_checkert> verifier(
-        options, ui_message_handler, *goto_model_ptr);
+        options, ui_message_handler, goto_model);
       (void)verifier();
     }
     else
     {
       stop_on_fail_verifiert<java_multi_path_symex_checkert> verifier(
-        options, ui_message_handler, *goto_model_ptr);
+        options, ui_message_handler, goto_model);
       (void)verifier();
     }
 
@@ -622,7 +718,7 @@ int jbmc_parse_optionst::doit()
   {
     verifier =
       util_make_unique<stop_on_fail_verifiert<java_single_path_symex_checkert>>(
-        options, ui_message_handler, *goto_model_ptr);
+        options, ui_message_handler, goto_model);
   }
   else if(
     options.get_bool_option("stop-on-fail") &&
@@ -633,13 +729,13 @@ int jbmc_parse_optionst::doit()
       verifier =
         util_make_unique<stop_on_fail_verifier_with_fault_localizationt<
           java_multi_path_symex_checkert>>(
-          options, ui_message_handler, *goto_model_ptr);
+          options, ui_message_handler, goto_model);
     }
     else
     {
       verifier = util_make_unique<
         stop_on_fail_verifiert<java_multi_path_symex_checkert>>(
-        options, ui_message_handler, *goto_model_ptr);
+        options, ui_message_handler, goto_model);
     }
   }
   else if(
@@ -648,7 +744,7 @@ int jbmc_parse_optionst::doit()
   {
     verifier = util_make_unique<all_properties_verifier_with_trace_storaget<
       java_single_path_symex_checkert>>(
-      options, ui_message_handler, *goto_model_ptr);
+      options, ui_message_handler, goto_model);
   }
   else if(
     !options.get_bool_option("stop-on-fail") &&
@@ -659,13 +755,13 @@ int jbmc_parse_optionst::doit()
       verifier =
         util_make_unique<all_properties_verifier_with_fault_localizationt<
           java_multi_path_symex_checkert>>(
-          options, ui_message_handler, *goto_model_ptr);
+          options, ui_message_handler, goto_model);
     }
     else
     {
       verifier = util_make_unique<all_properties_verifier_with_trace_storaget<
         java_multi_path_symex_checkert>>(
-        options, ui_message_handler, *goto_model_ptr);
+        options, ui_message_handler, goto_model);
     }
   }
   else
@@ -760,6 +856,141 @@ int jbmc_parse_optionst::get_goto_program(
   return -1; // no error, continue
 }
 
+int jbmc_parse_optionst::verify_batch(const optionst &options)
+{
+#ifdef _WIN32
+  log.error() << "--batch-functions is not supported on this platform"
+              << messaget::eom;
+  return CPROVER_EXIT_USAGE_ERROR;
+#else
+  if(options.is_set("context-include") || options.is_set("context-exclude"))
+    method_context = get_context(options);
+  lazy_goto_modelt lazy_goto_model =
+    lazy_goto_modelt::from_handler_object(*this, options, ui_message_handler);
+  lazy_goto_model.initialize(cmdline.args, options);
+
+  class_hierarchy =
+    util_make_unique<class_hierarchyt>(lazy_goto_model.symbol_table);
+
+  add_failed_symbols(lazy_goto_model.symbol_table);
+
+  // only the methods with a body can be verified
+  std::vector<irep_idt> entry_methods;
+  for(const irep_idt &id : build_load_method_by_regex(
+        cmdline.get_value("batch-functions"))(lazy_goto_model.symbol_table))
+  {
+    if(lazy_goto_model.symbol_table.lookup_ref(id).value.is_not_nil())
+      entry_methods.push_back(id);
+  }
+
+  if(entry_methods.empty())
+  {
+    log.error() << "no method matches --batch-functions" << messaget::eom;
+    return CPROVER_EXIT_INCORRECT_TASK;
+  }
+
+  const std::size_t jobs =
+    options.is_set("batch-jobs")
+      ? string2optional_size_t(options.get_option("batch-jobs")).value()
+      : 1;
+
+  log.status() << "Verifying " << entry_methods.size() << " entry methods"
+               << messaget::eom;
+
+  // Each method is verified by a process of its own, forked from this one
+  // after the classes have been loaded and converted, which writes its report
+  // to a file that this process copies to the output in the order of the
+  // methods.
+  std::vector<temporary_filet> reports;
+  reports.reserve(entry_methods.size());
+  for(std::size_t i = 0; i < entry_methods.size(); ++i)
+    reports.emplace_back("jbmc", ".out");
+
+  std::vector<optionalt<int>> exit_codes(entry_methods.size());
+
+  process_poolt workers;
+  std::size_t next = 0;
+  std::size_t next_report = 0;
+
+  while(next < entry_methods.size() || workers.running() != 0)
+  {
+    if(next < entry_methods.size() && workers.running() < jobs)
+    {
+      const std::size_t index = next++;
+      const auto verify_in_worker = [&]() {
+        const int fd =
+          open(reports[index]().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        if(fd < 0 || dup2(fd, STDOUT_FILENO) < 0)
+          return CPROVER_EXIT_INTERNAL_ERROR;
+        close(fd);
+
+        try
+        {
+          // strip the java:: prefix to make the identifier a friendly name
+          config.main = id2string(entry_methods[index]).substr(6);
+          log.status() << "Entry method " << *config.main << messaget::eom;
+
+          if(lazy_goto_model.rebuild_entry_point())
+            return CPROVER_EXIT_INCORRECT_TASK;
+
+          lazy_goto_model.load_all_functions();
+          std::unique_ptr<goto_modelt> goto_model =
+            lazy_goto_modelt::process_whole_model_and_freeze(
+              std::move(lazy_goto_model));
+          if(goto_model == nullptr)
+            return CPROVER_EXIT_INTERNAL_ERROR;
+
+          if(cmdline.isset("property"))
+            ::set_properties(*goto_model, cmdline.get_values("property"));
+          return verify(*goto_model, options);
+        }
+        catch(const cprover_exception_baset &e)
+        {
+          log.error() << e.what() << messaget::eom;
+          return CPROVER_EXIT_EXCEPTION;
+        }
+      };
+
+      if(workers.start(index, verify_in_worker))
+      {
+        log.error() << "failed to fork a process to verify "
+                    << entry_methods[index] << messaget::eom;
+        exit_codes[index] = CPROVER_EXIT_INTERNAL_ERROR;
+      }
+    }
+    else
+    {
+      const auto finished = workers.wait_for_any();
+      if(!finished.has_value())
+        break;
+
+      exit_codes[finished->id] =
+        finished->exit_code.value_or(CPROVER_EXIT_INTERNAL_ERROR);
+    }
+
+    for(; next_report < next && exit_codes[next_report].has_value();
+        ++next_report)
+    {
+      std::ifstream report(reports[next_report]());
+      if(report.peek() != std::ifstream::traits_type::eof())
+        std::cout << report.rdbuf();
+      std::cout.flush();
+    }
+  }
+
+  // report the outcome of the first method that did not verify successfully
+  for(const auto &exit_code : exit_codes)
+  {
+    if(!exit_code.has_value())
+      return CPROVER_EXIT_INTERNAL_ERROR;
+    else if(*exit_code != CPROVER_EXIT_VERIFICATION_SAFE)
+      return *exit_code;
+  }
+
+  return CPROVER_EXIT_VERIFICATION_SAFE;
+#endif
+}
+
 void jbmc_parse_optionst::process_goto_function(
   goto_model_functiont &function,
   const abstract_goto_modelt &model,
@@ -1059,6 +1290,9 @@ void jbmc_parse_optionst::help()
     "\n"
     HELP_JAVA_CLASSPATH
     HELP_FUNCTIONS
+    " --batch-functions regex      verify each method matching regex separately,\n" // NOLINT(*)
+    "                              loading the classes only once\n"
+    " --batch-jobs n               verify up to n methods in parallel\n"
     "\n"
     "Analysis options:\n"
     HELP_SHOW_PROPERTIES
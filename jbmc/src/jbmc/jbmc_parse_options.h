@@ -88,7 +88,8 @@ class optionst;
   "(java-threading)" \
   OPT_GOTO_TRACE \
   OPT_VALIDATE \
-  "(symex-driven-lazy-loading)"
+  "(symex-driven-lazy-loading)" \
+  "(batch-functions):(batch-jobs):"
 // clang-format on
 
 class jbmc_parse_optionst : public parse_options_baset
@@ -133,6 +134,15 @@ protected:
   int get_goto_program(
     std::unique_ptr<abstract_goto_modelt> &goto_model,
     const optionst &);
+
+  /// Verify the properties of \p goto_model and report the results
+  /// \return the exit code
+  int verify(abstract_goto_modelt &goto_model, const optionst &);
+
+  /// Verify each method matching `--batch-functions` as an entry point of
+  /// its own, loading and converting the classes only once
+  /// \return the exit code of the first method that is not verified safe
+  int verify_batch(const optionst &);
   bool show_loaded_functions(const abstract_goto_modelt &goto_model);
   bool show_loaded_symbols(const abstract_goto_modelt &goto_model);
 
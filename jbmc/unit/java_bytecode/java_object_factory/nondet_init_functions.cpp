@@ -0,0 +1,144 @@
+/*******************************************************************\
+
+Module: Unit tests for the functions shared by nondet objects
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <java-testing-utils/load_java_class.h>
+#include <java-testing-utils/require_goto_statements.h>
+#include <java_bytecode/java_bytecode_language.h>
+#include <java_bytecode/java_object_factory.h>
+#include <langapi/mode.h>
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <algorithm>
+
+static code_blockt initialise_nondet_object_of_type(
+  const typet &type,
+  const irep_idt &base_name,
+  lifetimet lifetime,
+  symbol_tablet &symbol_table)
+{
+  code_blockt created_code;
+  java_object_factory_parameterst parameters;
+  parameters.share_nondet_initializers = true;
+  select_pointer_typet pointer_selector;
+
+  object_factory(
+    type,
+    base_name,
+    created_code,
+    symbol_table,
+    parameters,
+    lifetime,
+    source_locationt(),
+    pointer_selector,
+    null_message_handler);
+
+  return created_code;
+}
+
+static std::size_t count_calls(const codet &code, const irep_idt &function_id)
+{
+  const std::vector<codet> statements =
+    require_goto_statements::get_all_statements(code);
+  return std::count_if(
+    statements.begin(),
+    statements.end(),
+    [&function_id](const codet &statement) {
+      if(statement.get_statement() != ID_function_call)
+        return false;
+      const exprt &function = to_code_function_call(statement).function();
+      return function.id() == ID_symbol &&
+             to_symbol_expr(function).get_identifier() == function_id;
+    });
+}
+
+static std::size_t
+count_nondet_init_functions(const symbol_tablet &symbol_table)
+{
+  return std::count_if(
+    symbol_table.symbols.begin(),
+    symbol_table.symbols.end(),
+    [](const std::pair<const irep_idt, symbolt> &symbol) {
+      return symbol.second.type.id() == ID_code &&
+             id2string(symbol.first).find(".<nondet_init>:") !=
+               std::string::npos;
+    });
+}
+
+SCENARIO(
+  "java_object_factory_nondet_init_functions",
+  "[core][java_bytecode][java_object_factory]")
+{
+  GIVEN("Some classes with fields")
+  {
+    register_language(new_java_bytecode_language);
+    symbol_tablet symbol_table =
+      load_java_class("Root", "./java_bytecode/java_object_factory");
+
+    WHEN("Creating two nondet 'A' objects of dynamic lifetime")
+    {
+      const auto a_pointer = java_reference_type(struct_tag_typet("java::A"));
+      const code_blockt first_code = initialise_nondet_object_of_type(
+        a_pointer, "first", lifetimet::DYNAMIC, symbol_table);
+      const code_blockt second_code = initialise_nondet_object_of_type(
+        a_pointer, "second", lifetimet::DYNAMIC, symbol_table);
+
+      const irep_idt function_id = "java::A.<nondet_init>:1:0";
+
+      THEN("Both call the same function")
+      {
+        REQUIRE(count_calls(first_code, function_id) == 1);
+        REQUIRE(count_calls(second_code, function_id) == 1);
+        REQUIRE(count_nondet_init_functions(symbol_table) == 1);
+      }
+
+      THEN("The function returns an object initialized inline")
+      {
+        const symbolt *function = symbol_table.lookup(function_id);
+        REQUIRE(function != nullptr);
+        REQUIRE(function->type.id() == ID_code);
+        REQUIRE(to_code_type(function->type).return_type() == a_pointer);
+
+        const std::vector<codet> statements =
+          require_goto_statements::get_all_statements(function->value);
+        REQUIRE(std::any_of(
+          statements.begin(), statements.end(), [](const codet &statement) {
+            return statement.get_statement() == ID_return;
+          }));
+      }
+    }
+
+    WHEN("Creating a nondet 'A' object of automatic lifetime")
+    {
+      initialise_nondet_object_of_type(
+        java_reference_type(struct_tag_typet("java::A")),
+        "root",
+        lifetimet::AUTOMATIC_LOCAL,
+        symbol_table);
+
+      THEN("It is initialized inline")
+      {
+        REQUIRE(count_nondet_init_functions(symbol_table) == 0);
+      }
+    }
+
+    WHEN("Creating a nondet 'OtherGeneric' object of dynamic lifetime")
+    {
+      initialise_nondet_object_of_type(
+        java_reference_type(struct_tag_typet("java::OtherGeneric")),
+        "root",
+        lifetimet::DYNAMIC,
+        symbol_table);
+
+      THEN("It is initialized inline, as its class is generic")
+      {
+        REQUIRE(count_nondet_init_functions(symbol_table) == 0);
+      }
+    }
+  }
+}
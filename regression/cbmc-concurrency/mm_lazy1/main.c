@@ -0,0 +1,26 @@
+int x, y;
+int r1, r2;
+_Bool done1, done2;
+
+void t1()
+{
+  x = 1;
+  r1 = y;
+  done1 = 1;
+}
+
+void t2()
+{
+  y = 1;
+  r2 = x;
+  done2 = 1;
+}
+
+int main()
+{
+  __CPROVER_ASYNC_1: t1();
+  __CPROVER_ASYNC_2: t2();
+  __CPROVER_assume(done1 && done2);
+  assert(r1 == 1 || r2 == 1);
+  return 0;
+}
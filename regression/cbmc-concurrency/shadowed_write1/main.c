@@ -0,0 +1,16 @@
+int x;
+
+void writer()
+{
+  x = 3;
+}
+
+int main()
+{
+  __CPROVER_ASYNC_1: writer();
+  x = 1;
+  x = 2;
+  int y = x;
+  assert(y == 2 || y == 3);
+  return 0;
+}
@@ -0,0 +1,18 @@
+int x;
+
+void writer()
+{
+  x = 3;
+}
+
+int main()
+{
+  int c;
+  __CPROVER_ASYNC_1: writer();
+  x = 1;
+  if(c)
+    x = 2;
+  int y = x;
+  assert(y == 2 || y == 3);
+  return 0;
+}
@@ -0,0 +1,11 @@
+int main()
+{
+  int x;
+
+  if(x)
+    x = 1;
+  else
+    x = 2;
+
+  x = 3;
+}
@@ -0,0 +1,13 @@
+int main()
+{
+  int x = 0, y = 0;
+
+  while(x < 3) // main.0
+    x++;
+
+  while(1) // main.1
+  {
+    y++;
+    assert(y != 5);
+  }
+}
@@ -0,0 +1,10 @@
+int main()
+{
+  int x = 0;
+
+  while(1)
+  {
+    assert(x != 3);
+    x = x == 10 ? 0 : x + 1;
+  }
+}
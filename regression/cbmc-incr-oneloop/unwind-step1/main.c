@@ -0,0 +1,10 @@
+int main()
+{
+  int y = 0;
+
+  while(1) // main.0
+  {
+    y++;
+    assert(y != 5);
+  }
+}
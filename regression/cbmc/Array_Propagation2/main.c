@@ -0,0 +1,22 @@
+#include <assert.h>
+
+int B[1000];
+
+int main()
+{
+  int n;
+
+  // too large for field sensitivity, and not constant as a whole
+  int A[1000];
+  A[3] = 1;
+  A[4] = n;
+
+  assert(A[3] == 1);
+
+  // constant as a whole before an element becomes non-constant
+  B[5] = n;
+
+  assert(B[3] == 0);
+
+  return 0;
+}
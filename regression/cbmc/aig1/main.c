@@ -0,0 +1,13 @@
+int main()
+{
+  unsigned char a, b, c;
+
+  // the multiplications share most of their gates once they are rewritten
+  unsigned char x = a * (b + c);
+  unsigned char y = a * b + a * c;
+
+  __CPROVER_assert(x == y, "distributivity");
+  __CPROVER_assert(x != 42, "x can be 42");
+
+  return 0;
+}
@@ -0,0 +1,12 @@
+int a, b;
+
+int main()
+{
+  _Bool c;
+  int *p = c ? &a : &b;
+
+  __CPROVER_assert(p == &a || p == &b, "one of two objects");
+  __CPROVER_assert(p != &b, "may point to b");
+
+  return 0;
+}
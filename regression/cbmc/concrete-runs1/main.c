@@ -0,0 +1,10 @@
+int main()
+{
+  int x;
+  int y = x * 2;
+
+  __CPROVER_assert(y != 6, "found by a concrete run");
+  __CPROVER_assert(y != 7, "holds");
+
+  return 0;
+}
@@ -0,0 +1,9 @@
+int main()
+{
+  int x;
+  __CPROVER_assume(x > 0);
+  __CPROVER_assume(x > 0);
+  __CPROVER_assert(x != 0, "positive");
+  __CPROVER_assert(x != 1, "not one");
+  return 0;
+}
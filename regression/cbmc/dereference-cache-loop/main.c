@@ -0,0 +1,14 @@
+int main()
+{
+  int a, b;
+  int c;
+  int *p = c ? &a : &b;
+  int sum = 0;
+
+  for(int i = 0; i < 10; ++i)
+    sum += *p;
+
+  __CPROVER_assert(sum == 10 * *p, "sum");
+
+  return 0;
+}
@@ -0,0 +1,23 @@
+int called(int x)
+{
+  return x + 1;
+}
+
+int via_pointer(int x)
+{
+  return x - 1;
+}
+
+int (*initial_pointer)(int) = via_pointer;
+
+int unused(int x)
+{
+  return called(x) * 2;
+}
+
+int main()
+{
+  int x;
+  __CPROVER_assert(initial_pointer(called(x)) == x, "inverse");
+  return 0;
+}
@@ -0,0 +1,16 @@
+int address_taken(int x)
+{
+  return x + 1;
+}
+
+int unused(int x)
+{
+  return x - 1;
+}
+
+int main()
+{
+  int (*pointer)(int) = address_taken;
+  __CPROVER_assert(pointer != 0, "address taken, but not called");
+  return 0;
+}
@@ -0,0 +1,15 @@
+int main()
+{
+  float x, y;
+  float a = x, b = y;
+
+  float p = x * y;
+  float q = b * a;
+  __CPROVER_assert(__CPROVER_isnanf(p) || p == q, "same product");
+
+  float s = x + y;
+  float t = a - b;
+  __CPROVER_assert(__CPROVER_isnanf(s) || s == t, "sum and difference");
+
+  return 0;
+}
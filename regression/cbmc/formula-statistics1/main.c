@@ -0,0 +1,7 @@
+int main()
+{
+  unsigned a, b;
+  unsigned product = a * b;
+  __CPROVER_assert(product != 221 || a == 1 || b == 1, "factor");
+  return 0;
+}
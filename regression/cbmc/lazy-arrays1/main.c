@@ -0,0 +1,15 @@
+int main()
+{
+  unsigned n, i, j;
+  __CPROVER_assume(n > 0 && n < 1000 && i < n && j < n);
+
+  int a[n];
+  a[i] = 1;
+  a[j] = 2;
+
+  __CPROVER_assert(i == j || a[i] == 1, "read over write");
+  __CPROVER_assert(a[j] == 2, "last write");
+  __CPROVER_assert(a[i] == 1, "overwritten");
+
+  return 0;
+}
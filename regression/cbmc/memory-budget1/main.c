@@ -0,0 +1,18 @@
+int a[4];
+
+int main()
+{
+  int n, sum = 0;
+  __CPROVER_assume(n >= 0 && n <= 4);
+
+  for(int i = 0; i < n; ++i)
+  {
+    a[i] = i;
+    sum += a[i];
+  }
+
+  __CPROVER_assert(sum <= 6, "holds");
+  __CPROVER_assert(sum != 3, "fails for n == 3");
+
+  return 0;
+}
@@ -0,0 +1,21 @@
+#include <stdint.h>
+
+int main()
+{
+  uint32_t a, b;
+  uint8_t p, q, r;
+  uint64_t x, y;
+
+  // a product by a constant, which is recoded into signed digits
+  __CPROVER_assert(a * 0x7fffffffu == (a << 31) - a, "constant product");
+
+  // products of non-constant operands
+  __CPROVER_assert((uint8_t)(p * (q + r)) == (uint8_t)(p * q + p * r), "dist");
+  __CPROVER_assert((uint16_t)p * q == (uint16_t)q * p, "full product");
+  __CPROVER_assert((x * y) % 2 == ((x % 2) & (y % 2)), "least bit");
+
+  __CPROVER_assume(a > 1 && b > 1);
+  __CPROVER_assert(a * b != 143, "143 = 11 * 13");
+
+  return 0;
+}
@@ -0,0 +1,15 @@
+int main()
+{
+  int x;
+  int y = 0;
+
+  if(x > 0)
+    y = 1;
+  else
+    y = 2;
+
+  __CPROVER_assert(y == 0, "fails on both paths");
+  __CPROVER_assert(y != 2, "fails on the second path only");
+
+  return 0;
+}
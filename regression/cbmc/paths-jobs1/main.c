@@ -0,0 +1,17 @@
+int main()
+{
+  int x, y;
+  int r = 0;
+
+  if(x > 0)
+    r += 1;
+  if(y > 0)
+    r += 2;
+
+  __CPROVER_assert(r <= 3, "always holds");
+
+  if(x > 0 && y > 0)
+    __CPROVER_assert(x > 1 || y > 1, "fails on one path");
+
+  return 0;
+}
@@ -0,0 +1,19 @@
+int main()
+{
+  int x, y;
+
+  if(x > 0)
+  {
+    if(y > 0)
+      y = 1;
+    else
+      y = 2;
+  }
+  else
+  {
+    __CPROVER_assert(x <= 0, "always holds");
+    __CPROVER_assert(y == 0, "fails");
+  }
+
+  return 0;
+}
@@ -0,0 +1,16 @@
+void f(int *p, int *q)
+{
+  if(p != 0)
+    *p = 1; // no check for p being null is needed
+  *p = 2;
+  if(p != 0)
+    *q = 3; // q is not known not to be null
+}
+
+int main()
+{
+  int x;
+  int *p;
+  int *q;
+  f(p, q);
+}
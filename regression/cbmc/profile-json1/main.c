@@ -0,0 +1,6 @@
+int main()
+{
+  int x;
+  __CPROVER_assert(x != 42, "can fail");
+  return 0;
+}
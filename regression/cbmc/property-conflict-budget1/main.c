@@ -0,0 +1,14 @@
+int main()
+{
+  int x, y, z;
+
+  __CPROVER_assert(x + 0 == x, "holds");
+  __CPROVER_assert(y != 1, "fails");
+
+  if(z > 0)
+    __CPROVER_assert(z >= 1, "holds when reached");
+
+  __CPROVER_assert(x != 2 || y != 3, "fails together");
+
+  return 0;
+}
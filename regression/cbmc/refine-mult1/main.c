@@ -0,0 +1,11 @@
+int main()
+{
+  unsigned x, y;
+  __CPROVER_assume(x > 1 && y > 1 && x < 1000 && y < 1000);
+
+  unsigned z = x * y;
+  __CPROVER_assert(z != 391, "391 is composite");
+  __CPROVER_assert(x % 2 == 1 || z % 2 == 0, "even factor");
+
+  return 0;
+}
@@ -0,0 +1,17 @@
+int nondet_int();
+
+int main()
+{
+  int sum = 0;
+  for(int i = 0; i < 4; ++i)
+  {
+    if(nondet_int())
+      sum += i;
+    else
+      sum -= i;
+  }
+
+  __CPROVER_assert(sum != 6, "all branches taken");
+  __CPROVER_assert(sum <= 6, "bounded");
+  return 0;
+}
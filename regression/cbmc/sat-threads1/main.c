@@ -0,0 +1,9 @@
+int main()
+{
+  unsigned x, y;
+  __CPROVER_assume(x > 1 && y > 1);
+
+  __CPROVER_assert(x * y != 35, "35 has factors");
+  __CPROVER_assert(x * y != 0 || x * y == 0, "tautology");
+  return 0;
+}
@@ -0,0 +1,7 @@
+int main()
+{
+  int x;
+  int y = x + 1 + 2;
+  __CPROVER_assert(y != 42, "can fail");
+  return 0;
+}
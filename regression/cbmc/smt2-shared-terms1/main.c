@@ -0,0 +1,7 @@
+int main()
+{
+  unsigned x, y;
+  __CPROVER_assume(x * y + 3 > 10);
+  __CPROVER_assert(x * y + 3 != 5, "product is shared");
+  return 0;
+}
@@ -0,0 +1,10 @@
+int main()
+{
+  unsigned x, y;
+  __CPROVER_assume(x < 100 && y < 100);
+
+  __CPROVER_assert(x * y < 10000, "product is bounded");
+  __CPROVER_assert(x + y != 42, "sum can be 42");
+
+  return 0;
+}
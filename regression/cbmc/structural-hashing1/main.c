@@ -0,0 +1,13 @@
+int main()
+{
+  unsigned a, b;
+
+  // the same products are encoded more than once
+  unsigned x = a * b + a * b;
+  unsigned y = b * a;
+
+  __CPROVER_assert(x == 2 * y, "shared products");
+  __CPROVER_assert(x != 2 * a * b, "distinct");
+
+  return 0;
+}
@@ -0,0 +1,14 @@
+int main()
+{
+  int a[64];
+  int x = 0;
+
+  // After the first iterations the outer loop reaches no new instructions,
+  // but each of its iterations adds more steps than the one before.
+  for(int i = 0; i < 64; ++i)
+    for(int j = 0; j < i; ++j)
+      x += a[j];
+
+  __CPROVER_assert(0, "only reached if the loop is fully unwound");
+  return 0;
+}
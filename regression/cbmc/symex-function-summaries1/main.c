@@ -0,0 +1,34 @@
+int square(int x)
+{
+  int y = x * x;
+  return y;
+}
+
+int g;
+
+int add_global(int x)
+{
+  return x + g;
+}
+
+int main()
+{
+  int a = square(3);
+  int b = square(3);
+  int c = square(4);
+  __CPROVER_assert(a == 9 && b == 9, "same arguments");
+  __CPROVER_assert(c == 16, "other arguments");
+
+  g = 1;
+  int d = add_global(1);
+  g = 2;
+  int e = add_global(1);
+  __CPROVER_assert(d == 2 && e == 3, "reads a global");
+
+  int n;
+  __CPROVER_assume(n == 3 || n == 5);
+  int f = square(n);
+  __CPROVER_assert(f == 9, "non-constant argument");
+
+  return 0;
+}
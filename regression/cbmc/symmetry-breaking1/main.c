@@ -0,0 +1,15 @@
+int main()
+{
+  int a[4];
+  unsigned i, j;
+  __CPROVER_assume(i < 4 && j < 4);
+
+  // the elements of a are interchangeable, hence may be ordered
+  if(i != j)
+  {
+    __CPROVER_assert(a[i] == a[j] || a[i] != a[j], "tautology");
+    __CPROVER_assert(a[i] <= a[j], "either order");
+  }
+
+  return 0;
+}
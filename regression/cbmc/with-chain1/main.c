@@ -0,0 +1,18 @@
+int main()
+{
+  int a[8];
+  unsigned i, j;
+  __CPROVER_assume(i < 8 && j < 8);
+
+  a[1] = 1;
+  a[i] = 2;
+  a[1] = 3;
+  a[j] = 4;
+  a[i] = 5;
+
+  __CPROVER_assert(a[i] == 5, "last write");
+  __CPROVER_assert(i == j || i == 1 || a[1] == 3, "constant write");
+  __CPROVER_assert(a[1] == 3, "overwritten");
+
+  return 0;
+}
@@ -0,0 +1,18 @@
+int main()
+{
+  int c, z;
+  int x;
+
+  // symex merges the branches into an if-expression
+  if(c)
+    x = 5;
+  else
+    x = 5;
+
+  int y = x * z;
+
+  __CPROVER_assert(y == 5 * z, "propagated");
+  __CPROVER_assert(y != 10, "satisfiable");
+
+  return 0;
+}
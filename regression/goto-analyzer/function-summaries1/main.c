@@ -0,0 +1,19 @@
+#include <assert.h>
+
+int increment(int x)
+{
+  return x + 1;
+}
+
+int main(int argc, char **argv)
+{
+  int a = increment(1);
+  int b = increment(1);
+  int c = increment(a);
+
+  assert(a == 2);
+  assert(b == 2);
+  assert(c == 3);
+
+  return 0;
+}
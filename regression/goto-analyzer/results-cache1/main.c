@@ -0,0 +1,18 @@
+#include <assert.h>
+
+int f00(int x)
+{
+  int y = 1;
+  assert(y == 1);
+  assert(x == 0);
+  return x;
+}
+
+int main(int argc, char **argv)
+{
+  int v = 0;
+  v = f00(v);
+  assert(v == 0);
+
+  return 0;
+}
@@ -0,0 +1,26 @@
+#include <assert.h>
+
+int f(int x)
+{
+  int y = x + 1;
+  return y;
+}
+
+int main(int argc, char **argv)
+{
+  int a = 1;
+  int b = a + 1;
+  int c = f(b);
+  assert(c == 3);
+
+  if(argc > 2)
+    a = 2;
+  else
+    a = 3;
+
+  int d = a;
+  assert(b == 2);
+  assert(d == 2);
+
+  return 0;
+}
@@ -0,0 +1,12 @@
+int main()
+{
+  int i, x = 5;
+
+  if(i >= 20)
+    __CPROVER_assert(i >= 10, "i>=10"); // needs the intervals
+
+  __CPROVER_assert((x ^ 3) == 6, "x^3==6"); // needs the constants
+
+  if(i >= 10 && i <= 20)
+    __CPROVER_assert(i != 15, "i!=15"); // fails
+}
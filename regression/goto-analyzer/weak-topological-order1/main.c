@@ -0,0 +1,21 @@
+#include <assert.h>
+
+int main(void)
+{
+  int x = 0;
+  int y = 1;
+
+  goto head;
+
+after:
+  assert(y == 1);
+  return 0;
+
+head:
+  if(x < 10)
+  {
+    x++;
+    goto head;
+  }
+  goto after;
+}
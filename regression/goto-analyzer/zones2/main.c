@@ -0,0 +1,13 @@
+int main()
+{
+  int n;
+  __CPROVER_assume(n >= 0);
+
+  int i;
+  for(i = 0; i < n; i++)
+    __CPROVER_assert(i < n, "i<n");
+
+  __CPROVER_assert(i == n, "i==n");
+  __CPROVER_assert(i < n, "i<n after the loop"); // fails
+  __CPROVER_assert(i <= 10, "i<=10");            // unknown
+}
@@ -0,0 +1,17 @@
+#include <assert.h>
+
+int reachable(int x)
+{
+  return x + 1;
+}
+
+void unreachable(void)
+{
+  assert(0);
+}
+
+int main(int argc, char **argv)
+{
+  assert(reachable(argc) != argc);
+  return 0;
+}
@@ -0,0 +1,6 @@
+static int counter = 1;
+
+int f1(void)
+{
+  return counter;
+}
@@ -0,0 +1,6 @@
+static int counter = 2;
+
+int f2(void)
+{
+  return counter;
+}
@@ -0,0 +1,6 @@
+static int counter = 3;
+
+int f3(void)
+{
+  return counter;
+}
@@ -0,0 +1,8 @@
+int f1(void);
+int f2(void);
+int f3(void);
+
+int main()
+{
+  return f1() + f2() + f3();
+}
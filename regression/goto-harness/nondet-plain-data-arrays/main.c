@@ -0,0 +1,13 @@
+#include <assert.h>
+
+struct st
+{
+  int data[100];
+  struct st *next;
+};
+
+void func(struct st *p)
+{
+  if(p != 0)
+    assert(p->data[99] != 42);
+}
@@ -0,0 +1,8 @@
+int main()
+{
+  unsigned i;
+  for(i = 0; i < 10; ++i)
+    ;
+
+  __CPROVER_assert(i <= 10, "holds with the interval of i at the loop head");
+}
@@ -0,0 +1,18 @@
+int main()
+{
+  int a[10];
+  for(int i = 0; i < 10; ++i)
+    a[i] = i;
+
+  unsigned n;
+  __CPROVER_assume(n <= 100);
+  for(unsigned j = n; j > 0; j--)
+    ;
+
+  int x;
+  while(x < 10)
+    ;
+
+  for(unsigned k = 0; k <= n; k += 3)
+    ;
+}
@@ -0,0 +1,17 @@
+int x, y;
+
+void set_y(void)
+{
+  y = 2;
+}
+
+void main(void)
+{
+  int i;
+  x = 1;
+  set_y();
+  if(i)
+    x = 2;
+  assert(x >= 1);
+  assert(y == 3);
+}
@@ -0,0 +1,9 @@
+#include <assert.h>
+
+int main()
+{
+  int a;
+  int b;
+  assert(a + b < 10);
+  return 0;
+}
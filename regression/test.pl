@@ -5,17 +5,26 @@ use strict;
 use warnings;
 use File::Basename;
 use Term::ANSIColor;
+use Time::HiRes qw(gettimeofday tv_interval);
 
+use Config;
 use Cwd;
 
-my $has_thread_pool = eval
-{
-  # "http://www.cpan.org/authors/id/J/JW/JWU/Thread-Pool-Simple/Thread-Pool-Simple-0.25.tar.gz"
-  # Debian/Ubuntu: libthread-pool-simple-perl
-  require Thread::Pool::Simple;
-  Thread::Pool::Simple->import();
-  1;
-};
+# threads are loaded at compile time, so that the variables declared :shared
+# below are actually shared between the worker threads
+our $has_threads;
+BEGIN {
+  $has_threads = $Config{useithreads} && eval
+  {
+    require threads;
+    threads->import();
+    require threads::shared;
+    threads::shared->import();
+    require Thread::Queue;
+    Thread::Queue->import();
+    1;
+  };
+}
 
 # test.pl
 #
@@ -31,8 +40,11 @@ sub with_color {
   }
 }
 
-sub run($$$$$) {
-  my ($name, $input, $cmd, $options, $output) = @_;
+# GNU time, if available, to measure the peak memory use in performance mode
+my $gnu_time = "/usr/bin/time";
+
+sub run($$$$$$) {
+  my ($name, $input, $cmd, $options, $output, $perf) = @_;
   my $cmdline;
   if(length($input)) {
     $cmdline = "$cmd $options '$input' >'$output' 2>&1";
@@ -40,6 +52,16 @@ sub run($$$$$) {
     $cmdline = "$cmd $options >'$output' 2>&1";
   }
 
+  if(our $timeout) {
+    $cmdline = "timeout -k 10 $timeout $cmdline";
+  }
+
+  my $time_output = "$output.time";
+  my $measure_memory = defined($perf) && -x $gnu_time;
+  if($measure_memory) {
+    $cmdline = "$gnu_time -f '%M' -o '$time_output' $cmdline";
+  }
+
   print LOG "Running $cmdline\n";
   # see https://github.com/git-for-windows/msys2-runtime/pull/11/files
   system("bash", "-c", "cd '$name' ; MSYS_NO_PATHCONV=1 $cmdline");
@@ -48,6 +70,20 @@ sub run($$$$$) {
   my $dumped_core = $? & 128;
   my $failed = 0;
 
+  if($measure_memory && open(my $fh, "<", "$name/$time_output")) {
+    # GNU time exits with 128+signal if the command was killed by a signal
+    while(my $line = <$fh>) {
+      if($line =~ /^Command terminated by signal (\d+)/) {
+        $signal_num = $1;
+        $exit_value = 0;
+      } elsif($line =~ /^(\d+)$/) {
+        $perf->{rss_kb} = $1;
+      }
+    }
+    close($fh);
+    unlink("$name/$time_output");
+  }
+
   print LOG "  Exit: $exit_value\n";
   print LOG "  Signal: $signal_num\n";
   print LOG "  Core: $dumped_core\n";
@@ -59,6 +95,13 @@ sub run($$$$$) {
     }
   }
 
+  # timeout exits with 124 when the time is up, and 137 if it has to kill
+  if(our $timeout && ($exit_value == 124 || $exit_value == 137)) {
+    print "Timed out after $timeout seconds";
+    print LOG "  Timed out after $timeout seconds\n";
+    $failed = 1;
+  }
+
   system("bash", "-c", "cd '$name' ; echo '\nEXIT=$exit_value\nSIGNAL=$signal_num\n' >> '$output'");
 
   if($signal_num == 2) {
@@ -84,8 +127,29 @@ sub load($$) {
   return @data;
 }
 
-sub test($$$$$$$$$$$) {
-  my ($name, $test, $t_level, $cmd, $ign, $dry_run, $defines, $include_tags, $exclude_tags, $output_suffix, $exit_signal_checks) = @_;
+# the statistics that CBMC reports on the way: the solver time and, with
+# --verbosity 8 or higher, the size of the formula
+sub read_statistics($$) {
+  my ($fname, $perf) = @_;
+
+  open(my $fh, "<", $fname) or return;
+  while(my $line = <$fh>) {
+    if($line =~ /^Runtime decision procedure: ([-+.\deE]+)s/) {
+      $perf->{solver} = $1;
+    } elsif($line =~ /^size of program expression: (\d+) steps/) {
+      $perf->{steps} = $1;
+    } elsif($line =~ /^Generated \d+ VCC\(s\), (\d+) remaining/) {
+      $perf->{vccs} = $1;
+    } elsif($line =~ /^(\d+) variables, (\d+) clauses/) {
+      $perf->{variables} = $1;
+      $perf->{clauses} = $2;
+    }
+  }
+  close($fh);
+}
+
+sub test($$$$$$$$$$$$) {
+  my ($name, $test, $t_level, $cmd, $ign, $dry_run, $defines, $include_tags, $exclude_tags, $output_suffix, $exit_signal_checks, $perf) = @_;
   my ($level_and_tags, $input, $options, $grep_options, @results) = load("$test", $exit_signal_checks);
   my @keys = keys %{$defines};
   foreach my $key (@keys) {
@@ -179,7 +243,12 @@ sub test($$$$$$$$$$$) {
       return 0;
     }
 
-    $failed = run($name, $input, $cmd, $options, $output);
+    my $start_time = [gettimeofday];
+    $failed = run($name, $input, $cmd, $options, $output, $perf);
+    if(defined($perf)) {
+      $perf->{wall} = sprintf("%.3f", tv_interval($start_time));
+      read_statistics("$name/$output", $perf);
+    }
 
     if(!$failed) {
       print LOG "Execution [OK]\n";
@@ -284,8 +353,9 @@ Usage: test.pl -c CMD [OPTIONS] [DIRECTORIES ...]
   -c CMD     run tests on CMD - required option
   -e         require EXIT and SIGNAL patterns in test specifications
   -i <regex> options in test.desc matching the specified perl regex are ignored
-  -j <num>   run <num> tests in parallel (requires Thread::Pool::Simple)
-             if present, the environment variable TESTPL_JOBS is used as the default
+  -j <num>   run <num> test directories in parallel (requires a perl with
+             thread support); if present, the environment variable TESTPL_JOBS
+             is used as the default
   -n         dry-run: print the tests that would be run, but don't actually run them
   -p         print logs of each failed test (if any)
   -h         show this help and exit
@@ -302,6 +372,24 @@ Usage: test.pl -c CMD [OPTIONS] [DIRECTORIES ...]
              as runs with different suffixes will operate independently and keep
              independent logs.
   -f         forward the test name to CMD
+  -P <file>  performance mode: record the wall time, the solver time, the peak
+             memory use (if GNU time is installed) and the size of the formula
+             (if CMD reports it, e.g., with --verbosity 8) for each test in
+             <file>, as tab-separated values
+  -B <file>  compare the performance to a baseline recorded with -P: report
+             the tests whose times or sizes exceed those in <file> by more than
+             the tolerance and count them as failures. Defaults the file for
+             -P to performance.tsv.
+  --tolerance <percent>  the tolerated increase over the baseline, 25 by
+             default; times also have an absolute slack of 0.1 seconds
+  --timeout <seconds>  fail each test that runs for longer than <seconds>
+             (requires the timeout command)
+  --durations <file>  run the test directories that took longest in an
+             earlier run recorded with -P first, which shortens parallel runs;
+             defaults to the -B baseline, if any
+  --shard <k>/<n>  split the test directories into <n> shards of about equal
+             duration (using --durations, if given) and run only the <k>th,
+             counting from 1, e.g., to distribute the tests across machines
 
   --[no]color enable/disable color output; enabled by default unless
               TESTPL_COLOR_OUTPUT is set to 0, in which case it is
@@ -341,7 +429,10 @@ use Getopt::Std;
 use Getopt::Long qw(:config pass_through bundling);
 $main::VERSION = 0.1;
 $Getopt::Std::STANDARD_HELP_VERSION = 1;
-our ($opt_c, $opt_e, $opt_f, $opt_i, $opt_j, $opt_n, $opt_p, $opt_h, $opt_C, $opt_T, $opt_F, $opt_K, $opt_s, $opt_S, %defines, @include_tags, @exclude_tags); # the variables for getopt
+our ($opt_c, $opt_e, $opt_f, $opt_i, $opt_j, $opt_n, $opt_p, $opt_h, $opt_C, $opt_T, $opt_F, $opt_K, $opt_s, $opt_S, $opt_P, $opt_B, %defines, @include_tags, @exclude_tags); # the variables for getopt
+my $tolerance = 25;
+our $timeout;
+my ($durations_file, $shard);
 
 # this needs to come before GetOptions to ensure the
 # default -> environment -> flag override priority
@@ -350,14 +441,13 @@ if (exists $ENV{'TESTPL_COLOR_OUTPUT'}) {
   $color_output_enabled = $ENV{'TESTPL_COLOR_OUTPUT'};
 }
 
-GetOptions("D=s" => \%defines, "X=s" => \@exclude_tags, "I=s" => \@include_tags, 'color!' => \$color_output_enabled);
-getopts('c:efi:j:nphCTFKs:S:') or &main::HELP_MESSAGE(\*STDOUT, "", $main::VERSION, "");
+GetOptions("D=s" => \%defines, "X=s" => \@exclude_tags, "I=s" => \@include_tags, 'color!' => \$color_output_enabled, "tolerance=f" => \$tolerance, "timeout=i" => \$timeout, "durations=s" => \$durations_file, "shard=s" => \$shard);
+getopts('c:efi:j:nphCTFKs:S:P:B:') or &main::HELP_MESSAGE(\*STDOUT, "", $main::VERSION, "");
 $opt_c or &main::HELP_MESSAGE(\*STDOUT, "", $main::VERSION, "");
 $opt_j = $opt_j || $ENV{'TESTPL_JOBS'} || 0;
-if($opt_j && $opt_j != 1 && !$has_thread_pool) {
-  warn "Jobs set but thread pool module not found,\n"
-   . "install with 'cpan -i Thread::Pool::Simple'\n"
-   . "Or avoid setting the -j parameter or the TESTPL_JOBS variable\n";
+if($opt_j && $opt_j != 1 && !$has_threads) {
+  warn "Jobs set but this perl does not support threads,\n"
+   . "running the tests sequentially\n";
 }
 $opt_h and &main::HELP_MESSAGE(\*STDOUT, "", $main::VERSION, "");
 my $t_level = 0;
@@ -377,10 +467,90 @@ if($log_suffix) {
 }
 $logfile_name .= ".log";
 
+my $perf_file = $opt_P;
+if(defined($opt_B) && !defined($perf_file)) {
+  $perf_file = "performance";
+  $perf_file .= "-$log_suffix" if($log_suffix);
+  $perf_file .= ".tsv";
+}
+
+# the measurements in a performance results file, after the test descriptor
+my @perf_columns = ("wall", "solver", "rss_kb", "steps", "vccs", "variables", "clauses");
+# the measurements that are times, which get an absolute slack
+my %perf_is_time = ("wall" => 1, "solver" => 1);
+
+sub read_performance($) {
+  my ($fname) = @_;
+  my %results;
+
+  open(my $fh, "<", $fname) or die "Failed to open $fname\n";
+  while(my $line = <$fh>) {
+    chomp $line;
+    next if($line =~ /^#/);
+    my ($descriptor, @values) = split(/\t/, $line);
+    my %perf;
+    @perf{@perf_columns} = @values;
+    $results{$descriptor} = \%perf;
+  }
+  close($fh);
+
+  return %results;
+}
+
+$durations_file //= $opt_B;
+my %durations;
+if(defined($durations_file)) {
+  my %recorded = read_performance($durations_file);
+  foreach my $descriptor (keys %recorded) {
+    my $directory = dirname($descriptor);
+    my $wall = $recorded{$descriptor}->{wall};
+    $durations{$directory} += $wall if(defined($wall) && $wall ne "-");
+  }
+}
+
+# the directories without a recorded duration are assumed to be slow, so
+# that new tests do not end up last
+sub duration($) {
+  my ($test) = @_;
+  return exists($durations{$test}) ? $durations{$test} : 9**9**9;
+}
+
+# longest first, by name otherwise, for a deterministic order
+sub order_tests(@) {
+  return sort { duration($b) <=> duration($a) or $a cmp $b } @_;
+}
+
+# assign each directory in turn to the shard with the least total duration
+# so far, counting one second for those without a recorded duration
+sub select_shard($$@) {
+  my ($index, $shards, @tests) = @_;
+  my @loads = (0) x $shards;
+  my @selected;
+  foreach my $test (order_tests(@tests)) {
+    my $least = 0;
+    foreach my $i (1..$shards-1) {
+      $least = $i if($loads[$i] < $loads[$least]);
+    }
+    $loads[$least] += exists($durations{$test}) ? $durations{$test} : 1;
+    push @selected, $test if($least == $index - 1);
+  }
+  return @selected;
+}
+
 open LOG, (">" . $logfile_name);
 
 print "Loading\n";
 my @tests = @ARGV != 0 ? @ARGV : dirs();
+if(defined($shard)) {
+  my ($index, $shards) = $shard =~ /^(\d+)\/(\d+)$/
+    or die "--shard expects <k>/<n>, not '$shard'\n";
+  ($index >= 1 && $index <= $shards)
+    or die "--shard $shard: <k> must be between 1 and <n>\n";
+  @tests = select_shard($index, $shards, @tests);
+  print "  Shard $index of $shards: " . scalar(@tests) . " " .
+    (1==@tests?"directory":"directories") . "\n";
+}
+@tests = order_tests(@tests);
 my $count = 0;
 for (@tests){
   my @testfiles = glob "$_/*desc";
@@ -392,7 +562,8 @@ use Cwd qw(getcwd);
 my $cwd = getcwd;
 my $failures :shared = 0;
 my $skips :shared = 0;
-my $pool :shared = undef;
+my $parallel = $opt_j>1 && $has_threads && $count>1;
+my %perf_results :shared;
 
 sub do_test($)
 {
@@ -400,14 +571,19 @@ sub do_test($)
   my $failed_skipped = 0;
   my @files = glob "$test/*.desc";
   for (0..$#files){
-    defined($pool) or print "  Running $files[$_]";
+    $parallel or print "  Running $files[$_]";
     my $start_time = time();
+    my $perf = defined($perf_file) ? {} : undef;
     $failed_skipped = test(
-      $test, $files[$_], $t_level, $opt_c, $opt_i, $dry_run, \%defines, \@include_tags, \@exclude_tags, $log_suffix, $exit_signal_checks);
+      $test, $files[$_], $t_level, $opt_c, $opt_i, $dry_run, \%defines, \@include_tags, \@exclude_tags, $log_suffix, $exit_signal_checks, $perf);
     my $runtime = time() - $start_time;
 
     lock($skips);
-    defined($pool) and print "  Running $test $files[$_]";
+    if(defined($perf) && defined($perf->{wall})) {
+      $perf_results{$files[$_]} =
+        join("\t", map { $perf->{$_} // "-" } @perf_columns);
+    }
+    $parallel and print "  Running $files[$_]";
     if(2 == $failed_skipped) {
       $skips++;
       print "  [SKIPPED]\n";
@@ -420,16 +596,6 @@ sub do_test($)
   }
 }
 
-if($opt_j>1 && $has_thread_pool && $count>1)
-{
-  $pool = Thread::Pool::Simple->new(
-    min => 2,
-    max => $opt_j,
-    load => 3,
-    do => [\&do_test]
-  );
-}
-
 if ($log_suffix) {
   print "Running tests with log suffix: $log_suffix\n";
 }
@@ -437,19 +603,26 @@ else
 {
   print "Running tests\n";
 }
-foreach my $test (@tests) {
-  if(defined($pool))
-  {
-    $pool->add($test);
-  }
-  else
-  {
+if($parallel) {
+  # the workers take the directories in order, longest first
+  my $queue = Thread::Queue->new(@tests);
+  $queue->end();
+  my @workers = map {
+    threads->create(sub {
+      while(defined(my $test = $queue->dequeue())) {
+        do_test($test);
+      }
+    })
+  } 1..$opt_j;
+  $_->join() foreach @workers;
+}
+else
+{
+  foreach my $test (@tests) {
     do_test($test);
   }
 }
 
-defined($pool) and $pool->join();
-
 print "\n";
 
 if($failures == 0) {
@@ -461,6 +634,51 @@ if($failures == 0) {
 print ", $skips " . (1==$skips?"test":"tests") . " skipped" if($skips > 0);
 print "\n";
 
+my $regressions = 0;
+if(defined($perf_file)) {
+  open(my $fh, ">", $perf_file) or die "Failed to open $perf_file\n";
+  print $fh join("\t", "#test", @perf_columns) . "\n";
+  foreach my $descriptor (sort keys %perf_results) {
+    print $fh "$descriptor\t$perf_results{$descriptor}\n";
+  }
+  close($fh);
+  print "Performance results written to $perf_file\n";
+}
+
+if(defined($opt_B)) {
+  my %baseline = read_performance($opt_B);
+  my %current = read_performance($perf_file);
+
+  print "\nPerformance compared to $opt_B (tolerance $tolerance%)\n";
+  foreach my $descriptor (sort keys %current) {
+    next unless(exists($baseline{$descriptor}));
+    my @increases;
+    foreach my $column (@perf_columns) {
+      my $old = $baseline{$descriptor}->{$column};
+      my $new = $current{$descriptor}->{$column};
+      next if(!defined($old) || !defined($new) || $old eq "-" || $new eq "-");
+
+      my $limit = $old * (1 + $tolerance / 100);
+      $limit += 0.1 if($perf_is_time{$column});
+      if($new > $limit) {
+        my $change = $old == 0 ? "new" : sprintf("+%.0f%%", 100 * ($new - $old) / $old);
+        push @increases, "$column $old -> $new ($change)";
+      }
+    }
+
+    if(@increases) {
+      $regressions++;
+      print "  $descriptor: " . with_color(join(", ", @increases), "red") . "\n";
+    }
+  }
+
+  if($regressions == 0) {
+    print with_color("No performance regressions", "green") . "\n";
+  } else {
+    print "  $regressions " . (1==$regressions?"test":"tests") . " slower or bigger than the baseline\n";
+  }
+}
+
 
 close LOG;
 
@@ -501,4 +719,4 @@ if($opt_p && $failures != 0) {
   }
 }
 
-exit $failures;
+exit $failures + $regressions;
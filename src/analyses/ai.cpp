@@ -11,9 +11,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "ai.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <type_traits>
+#include <vector>
 
 #include <util/invariant.h>
 #include <util/std_code.h>
@@ -210,11 +212,11 @@ ai_baset::trace_ptrt ai_baset::get_next(working_sett &working_set)
   static_assert(
     std::is_same<
       working_sett,
-      std::set<trace_ptrt, ai_history_baset::compare_historyt>>::value,
+      std::set<std::pair<std::size_t, trace_ptrt>, compare_work_itemt>>::value,
     "begin must return the minimal entry");
   auto first = working_set.begin();
 
-  trace_ptrt t = *first;
+  trace_ptrt t = first->second;
 
   working_set.erase(first);
 
@@ -230,6 +232,15 @@ bool ai_baset::fixedpoint(
 {
   PRECONDITION(start_trace != nullptr);
 
+  if(
+    scheduler == schedulert::WEAK_TOPOLOGICAL_ORDER &&
+    ordered_programs.insert(&goto_program).second)
+  {
+    const weak_topological_ordert wto(goto_program);
+    forall_goto_program_instructions(it, goto_program)
+      wto_positions[it] = wto.position(it);
+  }
+
   working_sett working_set;
   put_in_working_set(working_set, start_trace);
 
@@ -269,6 +280,7 @@ bool ai_baset::visit(
 {
   bool new_data=false;
   locationt l = p->current_location();
+  number_of_visits++;
 
   // Function call and end are special cases
   if(l->is_function_call())
@@ -468,6 +480,48 @@ bool ai_baset::visit_end_function(
   return false;
 }
 
+void ai_intraproceduralt::fixedpoint(
+  trace_ptrt start_trace,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  // the entry state of the entry point has been set up already
+  ai_baset::fixedpoint(start_trace, goto_functions, ns);
+
+  std::vector<goto_functionst::function_mapt::const_iterator> functions;
+  for(auto f_it = goto_functions.function_map.begin();
+      f_it != goto_functions.function_map.end();
+      ++f_it)
+  {
+    if(
+      f_it->second.body_available() &&
+      f_it->first != goto_functions.entry_point() &&
+      skipped_functions.find(f_it->first) == skipped_functions.end())
+    {
+      functions.push_back(f_it);
+    }
+  }
+
+  std::sort(
+    functions.begin(),
+    functions.end(),
+    [](
+      goto_functionst::function_mapt::const_iterator a,
+      goto_functionst::function_mapt::const_iterator b) {
+      return id2string(a->first) < id2string(b->first);
+    });
+
+  for(const auto &f_it : functions)
+  {
+    ai_baset::fixedpoint(
+      entry_state(f_it->second.body),
+      f_it->first,
+      f_it->second.body,
+      goto_functions,
+      ns);
+  }
+}
+
 bool ai_recursive_interproceduralt::visit_edge_function_call(
   const irep_idt &calling_function_id,
   trace_ptrt p_call,
@@ -478,6 +532,51 @@ bool ai_recursive_interproceduralt::visit_edge_function_call(
   const goto_functionst &goto_functions,
   const namespacet &ns)
 {
+  const bool is_recursive = active_callees[callee_function_id] != 0;
+  if(is_recursive)
+    recursive_calls++;
+
+  // The state at the entry of the callee, which a summary is looked up and
+  // recorded for
+  std::unique_ptr<statet> entry;
+
+  if(summary_budget != 0 && !is_recursive)
+  {
+    locationt l_begin = callee.instructions.begin();
+    auto next = p_call->step(
+      l_begin,
+      *(storage->abstract_traces_before(l_begin)),
+      ai_history_baset::no_caller_history);
+
+    if(next.first != ai_history_baset::step_statust::BLOCKED)
+    {
+      entry = make_temporary_state(get_state(p_call));
+      entry->transform(
+        calling_function_id,
+        p_call,
+        callee_function_id,
+        next.second,
+        *this,
+        ns);
+
+      const summaryt *summary =
+        find_summary(callee_function_id, *entry, p_call, next.second);
+      if(summary != nullptr)
+      {
+        return apply_summary(
+          *summary,
+          calling_function_id,
+          p_call,
+          l_return,
+          callee_function_id,
+          working_set,
+          ns);
+      }
+    }
+  }
+
+  const std::size_t recursive_calls_before = recursive_calls;
+
   // This is the edge from call site to function head.
   {
     locationt l_begin = callee.instructions.begin();
@@ -497,12 +596,16 @@ bool ai_recursive_interproceduralt::visit_edge_function_call(
 
     // do we need to do/re-do the fixedpoint of the body?
     if(new_data)
+    {
+      active_callees[callee_function_id]++;
       fixedpoint(
         get_next(catch_working_set),
         callee_function_id,
         callee,
         goto_functions,
         ns);
+      active_callees[callee_function_id]--;
+    }
   }
 
   // This is the edge from function end to return site.
@@ -516,6 +619,13 @@ bool ai_recursive_interproceduralt::visit_edge_function_call(
     // Find the histories for a location
     auto traces = storage->abstract_traces_before(l_end);
 
+    // The states at the end do not depend on an analysis still in progress,
+    // unless the callee has called one of the functions being analysed.
+    summaryt summary;
+    const bool record_summary = entry != nullptr &&
+                                recursive_calls == recursive_calls_before &&
+                                number_of_summaries < summary_budget;
+
     bool new_data = false;
 
     // The history used may mean there are multiple histories at the end of the
@@ -532,6 +642,16 @@ bool ai_recursive_interproceduralt::visit_edge_function_call(
       {
         // function exit point reachable in that history
 
+        if(
+          record_summary &&
+          p_end
+              ->step(
+                l_return, *(storage->abstract_traces_before(l_return)), p_call)
+              .first != ai_history_baset::step_statust::BLOCKED)
+        {
+          summary.exits.emplace_back(p_end, make_temporary_state(end_state));
+        }
+
         new_data |= visit_edge(
           callee_function_id,
           p_end,
@@ -543,6 +663,81 @@ bool ai_recursive_interproceduralt::visit_edge_function_call(
       }
     }
 
+    if(record_summary)
+    {
+      summary.entry = std::move(entry);
+      summaries[callee_function_id].push_back(std::move(summary));
+      number_of_summaries++;
+    }
+
     return new_data;
   }
 }
+
+const ai_recursive_interproceduralt::summaryt *
+ai_recursive_interproceduralt::find_summary(
+  const irep_idt &callee_function_id,
+  const statet &entry,
+  trace_ptrt p_call,
+  trace_ptrt p_begin) const
+{
+  const auto entry_summaries = summaries.find(callee_function_id);
+  if(entry_summaries == summaries.end())
+    return nullptr;
+
+  // the states are equal if neither adds anything to the other
+  for(const auto &summary : entry_summaries->second)
+  {
+    auto summary_entry = domain_factory->copy(*summary.entry);
+    if(domain_factory->merge(*summary_entry, entry, p_call, p_begin))
+      continue;
+
+    auto call_entry = domain_factory->copy(entry);
+    if(domain_factory->merge(*call_entry, *summary.entry, p_call, p_begin))
+      continue;
+
+    return &summary;
+  }
+
+  return nullptr;
+}
+
+bool ai_recursive_interproceduralt::apply_summary(
+  const summaryt &summary,
+  const irep_idt &calling_function_id,
+  trace_ptrt p_call,
+  locationt l_return,
+  const irep_idt &callee_function_id,
+  working_sett &working_set,
+  const namespacet &ns)
+{
+  bool new_data = false;
+
+  for(const auto &exit : summary.exits)
+  {
+    // the history skipping the call, as the callee is not analysed in the
+    // history of this call
+    auto next = p_call->step(
+      l_return,
+      *(storage->abstract_traces_before(l_return)),
+      ai_history_baset::no_caller_history);
+    if(next.first == ai_history_baset::step_statust::BLOCKED)
+      return new_data;
+    trace_ptrt to_p = next.second;
+
+    std::unique_ptr<statet> new_values = make_temporary_state(*exit.second);
+    new_values->transform(
+      callee_function_id, exit.first, calling_function_id, to_p, *this, ns);
+
+    if(
+      merge(*new_values, exit.first, to_p) ||
+      (next.first == ai_history_baset::step_statust::NEW &&
+       !new_values->is_bottom()))
+    {
+      put_in_working_set(working_set, to_p);
+      new_data = true;
+    }
+  }
+
+  return new_data;
+}
@@ -47,6 +47,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <iosfwd>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <util/deprecate.h>
 #include <util/json.h>
@@ -59,6 +61,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "ai_history.h"
 #include "ai_storage.h"
 #include "is_threaded.h"
+#include "weak_topological_order.h"
 
 /// This is the basic interface of the abstract interpreter with default
 /// implementations of the core functionality.
@@ -97,7 +100,8 @@ Author: Daniel Kroening, kroening@kroening.com
 ///
 /// C. To change the way that the fixed point is computed
 ///    \ref ait#fixedpoint()
-///    concurrency_aware_ait does this to compute a fixed point over threads.
+///    concurrency_aware_ait does this to compute a fixed point over threads,
+///    and ai_intraproceduralt to analyse every function on its own.
 ///
 /// D. For pre-analysis initialization
 ///    \ref ait#initialize(const irep_idt&, const goto_programt&),
@@ -264,6 +268,32 @@ public:
   virtual void clear()
   {
     storage->clear();
+    wto_positions.clear();
+    ordered_programs.clear();
+  }
+
+  /// How the work queue orders the histories to visit
+  enum class schedulert
+  {
+    /// By location number, i.e., in program order
+    LOCATION_NUMBER,
+    /// By the weak topological order of each function, see
+    /// \ref weak_topological_ordert, which visits the instructions of a loop
+    /// until it is stable before those after it, even with unstructured
+    /// control flow
+    WEAK_TOPOLOGICAL_ORDER
+  };
+
+  void set_scheduler(schedulert _scheduler)
+  {
+    scheduler = _scheduler;
+  }
+
+  /// \return the number of histories visited, i.e., of calls of \ref visit,
+  ///   which measures how quickly the fixed points were reached
+  std::size_t get_number_of_visits() const
+  {
+    return number_of_visits;
   }
 
   /// Output the abstract states for a single function
@@ -409,17 +439,52 @@ protected:
     const irep_idt &function_id,
     const goto_programt &goto_program) const;
 
-  /// The work queue, sorted using the history's ordering operator
-  typedef trace_sett working_sett;
+  /// Orders the work queue by the priority of the location, and then using
+  /// the history's ordering operator
+  struct compare_work_itemt
+  {
+    bool operator()(
+      const std::pair<std::size_t, trace_ptrt> &l,
+      const std::pair<std::size_t, trace_ptrt> &r) const
+    {
+      return l.first < r.first || (l.first == r.first && *l.second < *r.second);
+    }
+  };
+
+  /// The work queue, sorted by \ref compare_work_itemt
+  typedef std::set<std::pair<std::size_t, trace_ptrt>, compare_work_itemt>
+    working_sett;
 
   /// Get the next location from the work queue
   trace_ptrt get_next(working_sett &working_set);
 
   void put_in_working_set(working_sett &working_set, trace_ptrt t)
   {
-    working_set.insert(t);
+    working_set.emplace(priority(t->current_location()), t);
   }
 
+  schedulert scheduler = schedulert::LOCATION_NUMBER;
+
+  /// The positions of the instructions in the weak topological order of
+  /// their function, for the functions whose fixed point has been computed
+  std::unordered_map<locationt, std::size_t, const_target_hash> wto_positions;
+  std::unordered_set<const goto_programt *> ordered_programs;
+
+  /// \return the priority of \p l in the work queue, lower ones first
+  std::size_t priority(locationt l) const
+  {
+    if(scheduler == schedulert::WEAK_TOPOLOGICAL_ORDER)
+    {
+      auto entry = wto_positions.find(l);
+      if(entry != wto_positions.end())
+        return entry->second;
+    }
+
+    return l->location_number;
+  }
+
+  std::size_t number_of_visits = 0;
+
   /// Run the fixedpoint algorithm until it reaches a fixed point
   /// \return True if we found something new
   virtual bool fixedpoint(
@@ -530,6 +595,25 @@ public:
   {
   }
 
+  /// Keep up to \p budget summaries of calls, each mapping the state at the
+  /// entry of a callee to the states at its end. A call whose entry state
+  /// equals the one of a summary of the callee then takes the states at the
+  /// end from the summary instead of analysing the callee in the history of
+  /// the call, which with a context-sensitive history saves analysing it
+  /// again for each call site. Calls of functions that are being analysed
+  /// already, i.e., recursive ones, are not summarised.
+  void set_summary_budget(std::size_t budget)
+  {
+    summary_budget = budget;
+  }
+
+  void clear() override
+  {
+    ai_baset::clear();
+    summaries.clear();
+    number_of_summaries = 0;
+  }
+
 protected:
   // Override the function that handles a single function call edge
   bool visit_edge_function_call(
@@ -541,6 +625,81 @@ protected:
     const goto_programt &callee,
     const goto_functionst &goto_functions,
     const namespacet &ns) override;
+
+  std::size_t summary_budget = 0;
+  std::size_t number_of_summaries = 0;
+
+  struct summaryt
+  {
+    std::unique_ptr<statet> entry;
+    /// The histories at the end of the callee and their states
+    std::vector<std::pair<trace_ptrt, std::unique_ptr<statet>>> exits;
+  };
+  std::unordered_map<irep_idt, std::vector<summaryt>> summaries;
+
+  /// The number of analyses of each callee in progress
+  std::unordered_map<irep_idt, std::size_t> active_callees;
+
+  /// The number of calls of functions that were being analysed already
+  std::size_t recursive_calls = 0;
+
+  /// \return the summary of \p callee_function_id whose entry state equals
+  ///   \p entry, or nullptr if there is none
+  const summaryt *find_summary(
+    const irep_idt &callee_function_id,
+    const statet &entry,
+    trace_ptrt p_call,
+    trace_ptrt p_begin) const;
+
+  /// Do the edges from the states at the end of the callee in \p summary to
+  /// the return site \p l_return
+  /// \return true if the state at the return site has changed
+  bool apply_summary(
+    const summaryt &summary,
+    const irep_idt &calling_function_id,
+    trace_ptrt p_call,
+    locationt l_return,
+    const irep_idt &callee_function_id,
+    working_sett &working_set,
+    const namespacet &ns);
+};
+
+/// Perform an intraprocedural analysis of every function with a body, not
+/// just of the entry point. Calls are approximated as in ai_baset, thus each
+/// function starts from the entry state and has a fixed point of its own,
+/// which is computed with a work queue holding only its locations.
+/// Functions are analysed one after the other in the order of their names,
+/// making the results independent of the order in which functions were
+/// loaded. They are not analysed in parallel as \ref irept reference
+/// counting, which the domains rely on, is not thread-safe.
+class ai_intraproceduralt : public ai_baset
+{
+public:
+  ai_intraproceduralt(
+    std::unique_ptr<ai_history_factory_baset> &&hf,
+    std::unique_ptr<ai_domain_factory_baset> &&df,
+    std::unique_ptr<ai_storage_baset> &&st)
+    : ai_baset(std::move(hf), std::move(df), std::move(st))
+  {
+  }
+
+  /// Do not analyse \p function_id, whose results are known otherwise.
+  /// Its states remain bottom.
+  void skip_function(const irep_idt &function_id)
+  {
+    skipped_functions.insert(function_id);
+  }
+
+protected:
+  std::unordered_set<irep_idt> skipped_functions;
+
+  // Override the fixed point of a whole program to include all functions
+  void fixedpoint(
+    trace_ptrt start_trace,
+    const goto_functionst &goto_functions,
+    const namespacet &ns) override;
+
+  using ai_baset::fixedpoint;
 };
 
 /// ait supplies three of the four components needed: an abstract interpreter
@@ -0,0 +1,254 @@
+/*******************************************************************\
+
+Module: Abstract Interpretation storing States at Join Points only
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Abstract Interpretation storing States at Join Points only
+
+#include "ai_sparse.h"
+
+#include <util/magic.h>
+
+#include <unordered_set>
+#include <vector>
+
+void ai_sparset::prepare(
+  const irep_idt &function_id,
+  const goto_programt &goto_program)
+{
+  if(
+    goto_program.instructions.empty() ||
+    !prepared_programs.insert(&goto_program).second)
+  {
+    return;
+  }
+
+  std::unordered_map<locationt, std::size_t, const_target_hash> incoming;
+  std::unordered_map<locationt, locationt, const_target_hash> predecessor;
+  std::unordered_set<locationt, const_target_hash> after_call;
+
+  forall_goto_program_instructions(it, goto_program)
+  {
+    for(const auto &succ : goto_program.get_successors(it))
+    {
+      if(succ == goto_program.instructions.end())
+        continue;
+
+      incoming[succ]++;
+      predecessor.emplace(succ, it);
+    }
+
+    if(it->is_function_call())
+      after_call.insert(std::next(it));
+  }
+
+  // Function entry points, calls and return sites are stored as they are
+  // reached by interprocedural edges. Of the other locations with a single
+  // predecessor, those on paths from stored ones whose length is bounded are
+  // not stored.
+  std::unordered_map<locationt, std::vector<locationt>, const_target_hash>
+    unstored_successors;
+  std::vector<locationt> stored;
+  forall_goto_program_instructions(it, goto_program)
+  {
+    if(
+      it == goto_program.instructions.begin() || incoming[it] != 1 ||
+      it->is_function_call() || it->is_end_function() ||
+      after_call.find(it) != after_call.end())
+    {
+      stored.push_back(it);
+    }
+    else
+      unstored_successors[predecessor.at(it)].push_back(it);
+  }
+
+  std::vector<std::pair<locationt, std::size_t>> pending;
+  for(const auto &l : stored)
+    pending.emplace_back(l, 0);
+
+  while(!pending.empty())
+  {
+    const locationt l = pending.back().first;
+    const std::size_t length = pending.back().second + 1;
+    pending.pop_back();
+
+    for(const auto &succ : unstored_successors[l])
+    {
+      if(length > AI_SPARSE_MAX_PATH_LENGTH)
+        pending.emplace_back(succ, 0);
+      else
+      {
+        predecessors.emplace(succ, predecessort{l, function_id});
+        pending.emplace_back(succ, length);
+      }
+    }
+  }
+}
+
+bool ai_sparset::fixedpoint(
+  trace_ptrt start_trace,
+  const irep_idt &function_id,
+  const goto_programt &goto_program,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  last_ns = &ns;
+  prepare(function_id, goto_program);
+
+  return ai_recursive_interproceduralt::fixedpoint(
+    start_trace, function_id, goto_program, goto_functions, ns);
+}
+
+bool ai_sparset::visit(
+  const irep_idt &function_id,
+  trace_ptrt p,
+  working_sett &working_set,
+  const goto_programt &goto_program,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  const locationt l = p->current_location();
+
+  if(l->is_function_call() || l->is_end_function())
+  {
+    return ai_recursive_interproceduralt::visit(
+      function_id, p, working_set, goto_program, goto_functions, ns);
+  }
+
+  number_of_visits++;
+
+  bool new_data = false;
+
+  // the states flowing along straight-line code, which are not stored
+  std::vector<std::pair<trace_ptrt, std::unique_ptr<statet>>> pending;
+  pending.emplace_back(p, make_temporary_state(get_state(p)));
+
+  while(!pending.empty())
+  {
+    const trace_ptrt from = pending.back().first;
+    std::unique_ptr<statet> state = std::move(pending.back().second);
+    pending.pop_back();
+
+    // Successors can be empty, for example assume(0).
+    // Successors can contain duplicates, for example GOTO next;
+    std::vector<locationt> successors;
+    const locationt from_l = from->current_location();
+    for(const auto &to_l : goto_program.get_successors(from_l))
+    {
+      if(to_l != goto_program.instructions.end())
+        successors.push_back(to_l);
+    }
+
+    for(std::size_t i = 0; i < successors.size(); ++i)
+    {
+      const locationt to_l = successors[i];
+
+      auto next = from->step(
+        to_l,
+        *(storage->abstract_traces_before(to_l)),
+        ai_history_baset::no_caller_history);
+      if(next.first == ai_history_baset::step_statust::BLOCKED)
+        continue;
+      const trace_ptrt to_p = next.second;
+
+      // the last successor can take the state rather than a copy
+      std::unique_ptr<statet> new_values = i + 1 == successors.size()
+                                             ? std::move(state)
+                                             : make_temporary_state(*state);
+
+      new_values->transform(function_id, from, function_id, to_p, *this, ns);
+
+      if(!is_stored(to_l))
+      {
+        if(!new_values->is_bottom())
+          pending.emplace_back(to_p, std::move(new_values));
+      }
+      else if(
+        merge(*new_values, from, to_p) ||
+        (next.first == ai_history_baset::step_statust::NEW &&
+         !new_values->is_bottom()))
+      {
+        put_in_working_set(working_set, to_p);
+        new_data = true;
+      }
+    }
+  }
+
+  return new_data;
+}
+
+std::unique_ptr<ai_sparset::statet>
+ai_sparset::recompute_state_before(locationt l) const
+{
+  // the path from the closest stored location to l, backwards
+  std::vector<std::pair<locationt, irep_idt>> path;
+  for(auto entry = predecessors.find(l); entry != predecessors.end();
+      entry = predecessors.find(entry->second.location))
+  {
+    path.emplace_back(l, entry->second.function_id);
+    l = entry->second.location;
+  }
+
+  const cstate_ptrt stored =
+    ai_recursive_interproceduralt::abstract_state_before(l);
+  if(stored->is_bottom())
+    return nullptr;
+
+  PRECONDITION(last_ns != nullptr);
+
+  // transformers do not modify the analysis, which they are only given
+  // access to so that they can query it
+  ai_baset &ai = const_cast<ai_sparset &>(*this);
+
+  std::unique_ptr<statet> state = domain_factory->copy(*stored);
+  trace_ptrt from = history_factory->epoch(l);
+
+  for(auto it = path.rbegin(); it != path.rend(); ++it)
+  {
+    const trace_ptrt to = history_factory->epoch(it->first);
+    state->transform(it->second, from, it->second, to, ai, *last_ns);
+    if(state->is_bottom())
+      return nullptr;
+    from = to;
+  }
+
+  return state;
+}
+
+ai_sparset::ctrace_set_ptrt
+ai_sparset::abstract_traces_before(locationt l) const
+{
+  if(is_stored(l))
+    return ai_recursive_interproceduralt::abstract_traces_before(l);
+
+  auto traces = std::make_shared<trace_sett>();
+  if(recompute_state_before(l) != nullptr)
+    traces->insert(history_factory->epoch(l));
+
+  return traces;
+}
+
+ai_sparset::cstate_ptrt ai_sparset::abstract_state_before(locationt l) const
+{
+  if(is_stored(l))
+    return ai_recursive_interproceduralt::abstract_state_before(l);
+
+  std::unique_ptr<statet> state = recompute_state_before(l);
+  if(state == nullptr)
+    return domain_factory->make(l);
+
+  return std::move(state);
+}
+
+ai_sparset::cstate_ptrt
+ai_sparset::abstract_state_before(const trace_ptrt &p) const
+{
+  if(is_stored(p->current_location()))
+    return ai_recursive_interproceduralt::abstract_state_before(p);
+
+  return abstract_state_before(p->current_location());
+}
@@ -0,0 +1,98 @@
+/*******************************************************************\
+
+Module: Abstract Interpretation storing States at Join Points only
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Abstract Interpretation storing States at Join Points only
+
+#ifndef CPROVER_ANALYSES_AI_SPARSE_H
+#define CPROVER_ANALYSES_AI_SPARSE_H
+
+#include "ai.h"
+
+#include <unordered_map>
+
+/// A recursive interprocedural abstract interpreter that stores abstract
+/// states only where control flow joins, rather than at every location.
+/// States are kept at the first instruction of each function, at
+/// instructions with more than one predecessor, and at function calls,
+/// returns and their return sites. Along the straight-line code in between,
+/// a state is passed from one transformer to the next without being stored
+/// or merged, and the states there are recomputed from the closest stored
+/// state when they are queried. This saves copying and merging large states
+/// along straight-line code, at the price of recomputing them for queries.
+///
+/// As a state is recomputed from the stored one by applying the transformers
+/// of a unique path, this requires the ahistorical history and one domain
+/// per location.
+class ai_sparset : public ai_recursive_interproceduralt
+{
+public:
+  ai_sparset(
+    std::unique_ptr<ai_history_factory_baset> &&hf,
+    std::unique_ptr<ai_domain_factory_baset> &&df,
+    std::unique_ptr<ai_storage_baset> &&st)
+    : ai_recursive_interproceduralt(std::move(hf), std::move(df), std::move(st))
+  {
+  }
+
+  ctrace_set_ptrt abstract_traces_before(locationt l) const override;
+  cstate_ptrt abstract_state_before(locationt l) const override;
+  cstate_ptrt abstract_state_before(const trace_ptrt &p) const override;
+
+  void clear() override
+  {
+    ai_recursive_interproceduralt::clear();
+    predecessors.clear();
+    prepared_programs.clear();
+  }
+
+protected:
+  /// The unique predecessor of each location whose state is not stored, and
+  /// the function it is in
+  struct predecessort
+  {
+    locationt location;
+    irep_idt function_id;
+  };
+  std::unordered_map<locationt, predecessort, const_target_hash> predecessors;
+  std::unordered_set<const goto_programt *> prepared_programs;
+
+  /// The namespace of the last fixed point, for recomputing states
+  const namespacet *last_ns = nullptr;
+
+  bool is_stored(locationt l) const
+  {
+    return predecessors.find(l) == predecessors.end();
+  }
+
+  /// Determine the locations of \p goto_program whose state is not stored
+  void prepare(const irep_idt &function_id, const goto_programt &goto_program);
+
+  /// \return the state before \p l, which is not stored, recomputed from the
+  ///   closest stored state, or nullptr if \p l is unreachable
+  std::unique_ptr<statet> recompute_state_before(locationt l) const;
+
+  bool fixedpoint(
+    trace_ptrt starting_trace,
+    const irep_idt &function_id,
+    const goto_programt &goto_program,
+    const goto_functionst &goto_functions,
+    const namespacet &ns) override;
+
+  using ai_recursive_interproceduralt::fixedpoint;
+
+  bool visit(
+    const irep_idt &function_id,
+    trace_ptrt p,
+    working_sett &working_set,
+    const goto_programt &goto_program,
+    const goto_functionst &goto_functions,
+    const namespacet &ns) override;
+};
+
+#endif // CPROVER_ANALYSES_AI_SPARSE_H
@@ -11,6 +11,8 @@ Author: Chris Smowton, chris.smowton@diffblue.com
 
 #include "call_graph_helpers.h"
 
+#include <util/csr_graph.h>
+
 /// Get either callers or callees of a given function
 /// \param graph: call graph
 /// \param function: function to query
@@ -51,8 +53,9 @@ static std::set<irep_idt> get_connected_functions(
   const irep_idt &function,
   bool forwards)
 {
-  std::vector<call_grapht::directed_grapht::node_indext> connected_nodes =
-    graph.get_reachable(*(graph.get_node_index(function)), forwards);
+  std::vector<csr_grapht::node_indext> connected_nodes =
+    csr_grapht::from_graph(graph).get_reachable(
+      {*(graph.get_node_index(function))}, forwards);
   std::set<irep_idt> result;
   for(const auto i : connected_nodes)
     result.insert(graph[i].function);
@@ -82,7 +85,8 @@ std::set<irep_idt> get_functions_reachable_within_n_steps(
   for(const auto &func : start_functions)
     start_indices.push_back(*(graph.get_node_index(func)));
 
-  for(const auto &index : graph.depth_limited_search(start_indices, n))
+  for(const auto &index :
+      csr_grapht::from_graph(graph).depth_limited_search(start_indices, n))
     result.insert(graph[index].function);
 
   return result;
@@ -16,6 +16,7 @@ Author: Georg Weissenbacher, georg@weissenbacher.name
 #include <list>
 #include <map>
 #include <iosfwd>
+#include <vector>
 
 #include <goto-programs/goto_functions.h>
 #include <goto-programs/goto_program.h>
@@ -141,11 +142,16 @@ void cfg_dominators_templatet<P, T, post_dom>::initialise(P &program)
   cfg(program);
 }
 
-/// Computes the MOP for the dominator analysis
+/// Computes the immediate dominator of each node following "A Simple, Fast
+/// Dominance Algorithm" by Cooper, Harvey and Kennedy, and then the sets of
+/// dominators from the dominator tree. The nodes are visited in reverse
+/// postorder of a depth-first search from the entry node, so that each pass
+/// over them propagates the dominators of all nodes not on a cycle; the
+/// passes repeat until the immediate dominators no longer change.
 template <class P, class T, bool post_dom>
 void cfg_dominators_templatet<P, T, post_dom>::fixedpoint(P &program)
 {
-  std::list<T> worklist;
+  typedef typename cfgt::node_indext node_indext;
 
   if(cfgt::nodes_empty(program))
     return;
@@ -154,104 +160,131 @@ void cfg_dominators_templatet<P, T, post_dom>::fixedpoint(P &program)
     entry_node = cfgt::get_last_node(program);
   else
     entry_node = cfgt::get_first_node(program);
-  typename cfgt::nodet &n = cfg.get_node(entry_node);
-  n.dominators.insert(entry_node);
 
-  for(typename cfgt::edgest::const_iterator
-      s_it=(post_dom?n.in:n.out).begin();
-      s_it!=(post_dom?n.in:n.out).end();
-      ++s_it)
-    worklist.push_back(cfg[s_it->first].PC);
-
-  // A program may have multiple "exit" nodes when self loops or assume(false)
-  // instructions are present.
+  // The roots of the dominator tree. A program may have multiple "exit" nodes
+  // when self loops or assume(false) instructions are present, which are
+  // roots when computing post-dominators.
+  std::vector<node_indext> roots{cfg.get_node_index(entry_node)};
   if(post_dom)
   {
-    for(auto &cfg_entry : cfg.entry_map)
+    for(node_indext i = 0; i < cfg.size(); ++i)
     {
-      if(cfg[cfg_entry.second].PC == entry_node)
-        continue;
-
-      typename cfgt::nodet &n_it = cfg[cfg_entry.second];
+      const typename cfgt::nodet &n = cfg[i];
       if(
-        n_it.out.empty() ||
-        (n_it.out.size() == 1 && n_it.out.begin()->first == cfg_entry.second))
+        i != roots.front() &&
+        (n.out.empty() || (n.out.size() == 1 && n.out.begin()->first == i)))
       {
-        n_it.dominators.insert(cfg[cfg_entry.second].PC);
-        for(const auto &predecessor : n_it.in)
-          worklist.push_back(cfg[predecessor.first].PC);
+        roots.push_back(i);
       }
     }
   }
 
-  while(!worklist.empty())
-  {
-    // get node from worklist
-    T current=worklist.front();
-    worklist.pop_front();
+  // A virtual node that is the immediate dominator of all roots
+  const node_indext virtual_root = cfg.size();
+  const node_indext undefined = virtual_root + 1;
 
-    bool changed=false;
-    typename cfgt::nodet &node = cfg.get_node(current);
-    if(node.dominators.empty())
-    {
-      for(const auto &edge : (post_dom ? node.out : node.in))
-        if(!cfg[edge.first].dominators.empty())
-        {
-          node.dominators=cfg[edge.first].dominators;
-          node.dominators.insert(current);
-          changed=true;
-        }
-    }
+  // depth-first search from the roots, numbering nodes in postorder
+  std::vector<node_indext> postorder_number(cfg.size() + 1, undefined);
+  std::vector<node_indext> postorder;
+  postorder.reserve(cfg.size());
+  {
+    std::vector<bool> visited(cfg.size(), false);
+    typedef typename cfgt::edgest::const_iterator edge_itt;
+    std::vector<std::pair<node_indext, edge_itt>> stack;
 
-    // compute intersection of predecessors
-    for(const auto &edge : (post_dom ? node.out : node.in))
+    for(const auto root : roots)
     {
-      const target_sett &other=cfg[edge.first].dominators;
-      if(other.empty())
+      if(visited[root])
         continue;
 
-      typename target_sett::const_iterator n_it=node.dominators.begin();
-      typename target_sett::const_iterator o_it=other.begin();
+      visited[root] = true;
+      const auto &edges = post_dom ? cfg[root].in : cfg[root].out;
+      stack.emplace_back(root, edges.begin());
 
-      // in-place intersection. not safe to use set_intersect
-      while(n_it!=node.dominators.end() && o_it!=other.end())
+      while(!stack.empty())
       {
-        if(*n_it==current)
-          ++n_it;
-        else if(*n_it<*o_it)
+        const node_indext n = stack.back().first;
+        const auto &n_edges = post_dom ? cfg[n].in : cfg[n].out;
+        edge_itt &it = stack.back().second;
+
+        if(it == n_edges.end())
         {
-          changed=true;
-          node.dominators.erase(n_it++);
+          postorder_number[n] = postorder.size();
+          postorder.push_back(n);
+          stack.pop_back();
+          continue;
         }
-        else if(*o_it<*n_it)
-          ++o_it;
-        else
+
+        const node_indext successor = it->first;
+        ++it;
+        if(!visited[successor])
         {
-          ++n_it;
-          ++o_it;
+          visited[successor] = true;
+          const auto &s_edges =
+            post_dom ? cfg[successor].in : cfg[successor].out;
+          stack.emplace_back(successor, s_edges.begin());
         }
       }
+    }
+  }
+  postorder_number[virtual_root] = postorder.size();
+
+  std::vector<node_indext> idom(cfg.size() + 1, undefined);
+  idom[virtual_root] = virtual_root;
+  for(const auto root : roots)
+    idom[root] = virtual_root;
+
+  auto intersect = [&](node_indext a, node_indext b) {
+    while(a != b)
+    {
+      while(postorder_number[a] < postorder_number[b])
+        a = idom[a];
+      while(postorder_number[b] < postorder_number[a])
+        b = idom[b];
+    }
+    return a;
+  };
+
+  for(bool changed = true; changed;)
+  {
+    changed = false;
+
+    for(auto it = postorder.rbegin(); it != postorder.rend(); ++it)
+    {
+      const node_indext n = *it;
+      if(idom[n] == virtual_root)
+        continue;
 
-      while(n_it!=node.dominators.end())
+      node_indext new_idom = undefined;
+      for(const auto &edge : (post_dom ? cfg[n].out : cfg[n].in))
       {
-        if(*n_it==current)
-          ++n_it;
+        const node_indext predecessor = edge.first;
+        if(idom[predecessor] == undefined)
+          continue;
+
+        if(new_idom == undefined)
+          new_idom = predecessor;
         else
-        {
-          changed=true;
-          node.dominators.erase(n_it++);
-        }
+          new_idom = intersect(predecessor, new_idom);
       }
-    }
 
-    if(changed) // fixed point for node reached?
-    {
-      for(const auto &edge : (post_dom ? node.in : node.out))
+      if(new_idom != idom[n])
       {
-        worklist.push_back(cfg[edge.first].PC);
+        idom[n] = new_idom;
+        changed = true;
       }
     }
   }
+
+  // The dominators of a node are the node and those of its immediate
+  // dominator, which precedes it in reverse postorder.
+  for(auto it = postorder.rbegin(); it != postorder.rend(); ++it)
+  {
+    const node_indext n = *it;
+    if(idom[n] != virtual_root)
+      cfg[n].dominators = cfg[idom[n]].dominators;
+    cfg[n].dominators.insert(cfg[n].PC);
+  }
 }
 
 /// Pretty-print a single node in the dominator tree. Supply a specialisation if
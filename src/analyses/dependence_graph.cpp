@@ -145,19 +145,18 @@ static bool may_be_def_use_pair(
     return false;
 }
 
-void dep_graph_domaint::data_dependencies(
-  goto_programt::const_targett,
+/// Add to \p data_deps the instructions whose definitions, reaching \p to
+/// according to \p rd_state, may be read by \p to
+static void add_data_dependencies(
   const irep_idt &function_to,
   goto_programt::const_targett to,
-  dependence_grapht &dep_graph,
-  const namespacet &ns)
+  const reaching_definitions_analysist &rd,
+  const rd_range_domaint &rd_state,
+  const namespacet &ns,
+  std::set<goto_programt::const_targett> &data_deps)
 {
-  // data dependencies using def-use pairs
-  data_deps.clear();
-
   // TODO use (future) reaching-definitions-dereferencing rw_set
-  value_setst &value_sets=
-    dep_graph.reaching_definitions().get_value_sets();
+  value_setst &value_sets = rd.get_value_sets();
   rw_range_set_value_sett rw_set(ns, value_sets);
   goto_rw(function_to, to, rw_set);
 
@@ -165,7 +164,7 @@ void dep_graph_domaint::data_dependencies(
   {
     const range_domaint &r_ranges = rw_set.get_ranges(read_object_entry.second);
     const rd_range_domaint::ranges_at_loct &w_ranges =
-      dep_graph.reaching_definitions()[to].get(read_object_entry.first);
+      rd_state.get(read_object_entry.first);
 
     for(const auto &w_range : w_ranges)
     {
@@ -186,10 +185,29 @@ void dep_graph_domaint::data_dependencies(
       }
     }
 
-    dep_graph.reaching_definitions()[to].clear_cache(read_object_entry.first);
+    rd_state.clear_cache(read_object_entry.first);
   }
 }
 
+void dep_graph_domaint::data_dependencies(
+  goto_programt::const_targett,
+  const irep_idt &function_to,
+  goto_programt::const_targett to,
+  dependence_grapht &dep_graph,
+  const namespacet &ns)
+{
+  // data dependencies using def-use pairs
+  data_deps.clear();
+
+  add_data_dependencies(
+    function_to,
+    to,
+    dep_graph.reaching_definitions(),
+    dep_graph.reaching_definitions()[to],
+    ns,
+    data_deps);
+}
+
 void dep_graph_domaint::transform(
   const irep_idt &function_from,
   trace_ptrt trace_from,
@@ -385,3 +403,118 @@ void dep_graph_domaint::populate_dep_graph(
   for(const auto &d_dep : data_deps)
     dep_graph.add_dep(dep_edget::kindt::DATA, d_dep, this_loc);
 }
+
+lazy_dependence_grapht::lazy_dependence_grapht(
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+  : goto_functions(goto_functions), ns(ns), rd(ns)
+{
+  rd(goto_functions, ns);
+}
+
+const cfg_post_dominatorst &
+lazy_dependence_grapht::post_dominators(const irep_idt &function_id)
+{
+  const auto entry = post_dominators_map.find(function_id);
+  if(entry != post_dominators_map.end())
+    return entry->second;
+
+  cfg_post_dominatorst &pd = post_dominators_map[function_id];
+  pd(goto_functions.function_map.at(function_id).body);
+  return pd;
+}
+
+lazy_dependence_grapht::depst lazy_dependence_grapht::control_dependencies(
+  const irep_idt &function_id,
+  locationt target)
+{
+  // As in dep_graph_domaint::control_dependencies, the candidates for the
+  // instructions that the one at target is control dependent on are the
+  // gotos and assumptions of the same function from which there is a path to
+  // target. Rather than propagating them forwards through the whole function,
+  // collect them by walking backwards from target.
+  const cfg_post_dominatorst &pd = post_dominators(function_id);
+
+  depst control_deps;
+  std::vector<bool> visited(pd.cfg.size(), false);
+  std::vector<cfg_post_dominatorst::cfgt::entryt> worklist{
+    pd.get_node_index(target)};
+
+  while(!worklist.empty())
+  {
+    const cfg_post_dominatorst::cfgt::nodet &n = pd.cfg[worklist.back()];
+    worklist.pop_back();
+
+    for(const auto &in_edge : n.in)
+    {
+      if(visited[in_edge.first])
+        continue;
+      visited[in_edge.first] = true;
+      worklist.push_back(in_edge.first);
+
+      const cfg_post_dominatorst::cfgt::nodet &m = pd.cfg[in_edge.first];
+      if(!m.PC->is_goto() && !m.PC->is_assume())
+        continue;
+
+      // target is control dependent on m if it post-dominates one but not
+      // all of the successors of m; an assumption is a control dependency of
+      // all instructions that post-dominate it
+      bool post_dom_all = !m.PC->is_assume();
+      bool post_dom_one = false;
+
+      for(const auto &out_edge : m.out)
+      {
+        if(pd.cfg[out_edge.first].dominators.count(target) != 0)
+          post_dom_one = true;
+        else
+          post_dom_all = false;
+      }
+
+      if(post_dom_one && !post_dom_all)
+        control_deps.insert(m.PC);
+    }
+  }
+
+  // As in dep_graph_domaint::transform, the instruction after a call of a
+  // function with a body also has the control dependencies of the call.
+  const goto_programt &body = goto_functions.function_map.at(function_id).body;
+  if(target != body.instructions.begin())
+  {
+    const locationt call = std::prev(target);
+    if(
+      call->is_function_call() &&
+      has_body(call->get_function_call().function()))
+    {
+      const depst call_deps = control_dependencies(function_id, call);
+      control_deps.insert(call_deps.begin(), call_deps.end());
+    }
+  }
+
+  return control_deps;
+}
+
+bool lazy_dependence_grapht::has_body(const exprt &function) const
+{
+  if(function.id() != ID_symbol)
+    return false;
+
+  const auto entry = goto_functions.function_map.find(
+    to_symbol_expr(function).get_identifier());
+  return entry != goto_functions.function_map.end() &&
+         entry->second.body_available();
+}
+
+lazy_dependence_grapht::depst lazy_dependence_grapht::data_dependencies(
+  const irep_idt &function_id,
+  locationt target) const
+{
+  depst data_deps;
+
+  // there are no definitions reaching an instruction that is not reachable
+  const auto state = rd.abstract_state_before(target);
+  const auto &rd_state = static_cast<const rd_range_domaint &>(*state);
+  if(!rd_state.is_bottom())
+    add_data_dependencies(function_id, target, rd, rd_state, ns, data_deps);
+
+  return data_deps;
+}
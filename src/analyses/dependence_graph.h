@@ -275,4 +275,54 @@ protected:
   reaching_definitions_analysist rd;
 };
 
+/// Computes the control and data dependencies of single instructions on
+/// demand, giving the same ones as \ref dependence_grapht. This suits
+/// clients like the full slicer that only need the dependencies of the
+/// instructions they reach backwards from a few criteria: no analysis is run
+/// over all instructions up front, and the post-dominators of a function are
+/// only computed once one of its instructions is queried. The reaching
+/// definitions are still computed for the whole program, as definitions flow
+/// across functions.
+///
+/// Unlike in \ref dependence_grapht, the first instruction of a function
+/// does not depend on the calls of the function, and instructions that are
+/// not reachable from the entry point may have control dependencies.
+class lazy_dependence_grapht
+{
+public:
+  typedef goto_programt::const_targett locationt;
+  typedef std::set<locationt> depst;
+
+  lazy_dependence_grapht(
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+  /// \return the gotos and assumptions of function \p function_id that
+  ///   decide whether \p target is executed
+  depst control_dependencies(const irep_idt &function_id, locationt target);
+
+  /// \return the instructions with a definition that reaches \p target in
+  ///   function \p function_id and may be read by it
+  depst data_dependencies(const irep_idt &function_id, locationt target) const;
+
+  /// \return the post-dominators of function \p function_id, computing them
+  ///   on first use
+  const cfg_post_dominatorst &post_dominators(const irep_idt &function_id);
+
+  const reaching_definitions_analysist &reaching_definitions() const
+  {
+    return rd;
+  }
+
+protected:
+  const goto_functionst &goto_functions;
+  const namespacet &ns;
+
+  dependence_grapht::post_dominators_mapt post_dominators_map;
+  reaching_definitions_analysist rd;
+
+  /// \return whether calls of \p function enter a function body
+  bool has_body(const exprt &function) const;
+};
+
 #endif // CPROVER_ANALYSES_DEPENDENCE_GRAPH_H
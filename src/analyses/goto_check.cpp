@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "goto_check.h"
 
 #include <algorithm>
+#include <unordered_set>
 
 #include <util/arith_tools.h>
 #include <util/array_name.h>
@@ -24,6 +25,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/floatbv_expr.h>
 #include <util/ieee_float.h>
 #include <util/invariant.h>
+#include <util/irep_hash.h>
 #include <util/make_unique.h>
 #include <util/options.h>
 #include <util/pointer_expr.h>
@@ -41,6 +43,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "guard.h"
 #include "local_bitvector_analysis.h"
+#include "local_safe_pointers.h"
 
 class goto_checkt
 {
@@ -71,6 +74,8 @@ public:
     enable_simplify=_options.get_bool_option("simplify");
     enable_nan_check=_options.get_bool_option("nan-check");
     retain_trivial = _options.get_bool_option("retain-trivial-checks");
+    omit_guarded_null_checks =
+      _options.get_bool_option("omit-guarded-null-checks");
     enable_assert_to_assume=_options.get_bool_option("assert-to-assume");
     enable_assertions=_options.get_bool_option("assertions");
     enable_built_in_assertions=_options.get_bool_option("built-in-assertions");
@@ -96,6 +101,10 @@ public:
 protected:
   const namespacet &ns;
   std::unique_ptr<local_bitvector_analysist> local_bitvector_analysis;
+  /// Pointers known not to be null because of a preceding comparison, when
+  /// pointer checks are enabled, guarded null-pointer checks are to be
+  /// omitted, and the location numbers of the function are up to date
+  std::unique_ptr<local_safe_pointerst> local_safe_pointers;
   goto_programt::const_targett current_target;
   guard_managert guard_manager;
   bool no_enum_check;
@@ -244,7 +253,17 @@ protected:
     const guardt &guard);
 
   goto_programt new_code;
-  typedef std::set<std::pair<exprt, exprt>> assertionst;
+  /// Hashes an expression and the assertion about it
+  struct assertion_hasht
+  {
+    std::size_t operator()(const std::pair<exprt, exprt> &assertion) const
+    {
+      return hash_combine(assertion.first.hash(), assertion.second.hash());
+    }
+  };
+
+  typedef std::unordered_set<std::pair<exprt, exprt>, assertion_hasht>
+    assertionst;
   assertionst assertions;
 
   /// Remove all assertions containing the symbol in \p lhs as well as all
@@ -267,6 +286,7 @@ protected:
   bool enable_simplify;
   bool enable_nan_check;
   bool retain_trivial;
+  bool omit_guarded_null_checks;
   bool enable_assert_to_assume;
   bool enable_assertions;
   bool enable_built_in_assertions;
@@ -283,6 +303,10 @@ protected:
   allocationst allocations;
 
   irep_idt mode;
+
+  /// The language of \ref mode, to print the expressions properties are
+  /// about
+  std::unique_ptr<languaget> language;
 };
 
 void goto_checkt::collect_allocations(
@@ -1553,7 +1577,7 @@ void goto_checkt::add_guarded_property(
                                   std::move(guarded_expr), source_location));
 
     std::string source_expr_string;
-    get_language_from_mode(mode)->from_expr(src_expr, source_expr_string, ns);
+    language->from_expr(src_expr, source_expr_string, ns);
 
     t->source_location.set_comment(comment + " in " + source_expr_string);
     t->source_location.set_property_class(property_class);
@@ -1861,6 +1885,8 @@ void goto_checkt::goto_check(
   assertions.clear();
 
   const auto &function_symbol = ns.lookup(function_identifier);
+  if(!language || function_symbol.mode != mode)
+    language = get_language_from_mode(function_symbol.mode);
   mode = function_symbol.mode;
 
   bool did_something = false;
@@ -1870,6 +1896,32 @@ void goto_checkt::goto_check(
 
   goto_programt &goto_program=goto_function.body;
 
+  // Null-pointer checks guarded by a comparison with null, as in
+  // if(p != NULL) *p, are omitted if so requested. The analysis identifies
+  // instructions by location number, and relies on forward jumps going to
+  // larger ones.
+  local_safe_pointers.reset();
+  if(enable_pointer_check && omit_guarded_null_checks)
+  {
+    bool numbered = true;
+    for(auto it = goto_program.instructions.begin();
+        numbered && it != goto_program.instructions.end();
+        ++it)
+    {
+      const auto next = std::next(it);
+      numbered = next == goto_program.instructions.end() ||
+                 it->location_number < next->location_number;
+    }
+
+    if(numbered)
+    {
+      goto_program.compute_target_numbers();
+      goto_program.compute_incoming_edges();
+      local_safe_pointers = util_make_unique<local_safe_pointerst>();
+      (*local_safe_pointers)(goto_program);
+    }
+  }
+
   Forall_goto_program_instructions(it, goto_program)
   {
     current_target = it;
@@ -2307,6 +2359,14 @@ optionalt<goto_checkt::conditiont> goto_checkt::get_pointer_is_null_condition(
   const auto &pointer_type = to_pointer_type(address.type());
   local_bitvector_analysist::flagst flags =
     local_bitvector_analysis->get(current_target, address);
+
+  if(
+    local_safe_pointers &&
+    local_safe_pointers->is_non_null_at_program_point(address, current_target))
+  {
+    return {};
+  }
+
   if(mode == ID_java)
   {
     if(flags.is_unknown() || flags.is_null())
@@ -2373,6 +2433,27 @@ void goto_check(
   }
 }
 
+void goto_check(
+  const namespacet &ns,
+  const optionst &options,
+  goto_functionst &goto_functions,
+  const std::function<void(goto_functionst::goto_functiont &)> &before,
+  const std::function<void(goto_functionst::goto_functiont &)> &after)
+{
+  goto_checkt goto_check(ns, options);
+
+  // the allocations are collected before any function is transformed, which
+  // none of the function-local transformations affect
+  goto_check.collect_allocations(goto_functions);
+
+  for(auto &gf_entry : goto_functions.function_map)
+  {
+    before(gf_entry.second);
+    goto_check.goto_check(gf_entry.first, gf_entry.second);
+    after(gf_entry.second);
+  }
+}
+
 void goto_check(
   const optionst &options,
   goto_modelt &goto_model)
@@ -14,6 +14,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <goto-programs/goto_functions.h>
 
+#include <functional>
+
 class goto_modelt;
 class namespacet;
 class optionst;
@@ -23,6 +25,17 @@ void goto_check(
   const optionst &options,
   goto_functionst &goto_functions);
 
+/// Instrument \p goto_functions as above, one function at a time: each
+/// function is passed to \p before, instrumented, and passed to \p after
+/// before the next one is, which lets function-local transformations that
+/// precede or follow the checks share a single traversal of the functions.
+void goto_check(
+  const namespacet &ns,
+  const optionst &options,
+  goto_functionst &goto_functions,
+  const std::function<void(goto_functionst::goto_functiont &)> &before,
+  const std::function<void(goto_functionst::goto_functiont &)> &after);
+
 void goto_check(
   const irep_idt &function_identifier,
   goto_functionst::goto_functiont &goto_function,
@@ -41,6 +54,7 @@ void goto_check(
   "(float-overflow-check)(nan-check)(no-built-in-assertions)"                  \
   "(pointer-primitive-check)"                                                  \
   "(retain-trivial-checks)"                                                    \
+  "(omit-guarded-null-checks)"                                                 \
   "(error-label):"                                                             \
   "(no-assertions)(no-assumptions)"                                            \
   "(assert-to-assume)"
@@ -61,6 +75,7 @@ void goto_check(
   " --enum-range-check           checks that all enum type expressions have values in the enum range\n" /* NOLINT(whitespace/line_length) */ \
   " --pointer-primitive-check    checks that all pointers in pointer primitives are valid or null\n" /* NOLINT(whitespace/line_length) */ \
   " --retain-trivial-checks      include checks that are trivially true\n" \
+  " --omit-guarded-null-checks   omit null-pointer checks of pointers compared with null before\n" /* NOLINT(whitespace/line_length) */ \
   " --error-label label          check that label is unreachable\n" \
   " --no-built-in-assertions     ignore assertions in built-in library\n" \
   " --no-assertions              ignore user assertions\n" \
@@ -84,6 +99,7 @@ void goto_check(
   options.set_option("pointer-primitive-check", cmdline.isset("pointer-primitive-check")); /* NOLINT(whitespace/line_length) */ \
   options.set_option("retain-trivial-checks", \
                      cmdline.isset("retain-trivial-checks")); \
+  options.set_option("omit-guarded-null-checks", cmdline.isset("omit-guarded-null-checks")); /* NOLINT(whitespace/line_length) */ \
   options.set_option("assertions", !cmdline.isset("no-assertions")); /* NOLINT(whitespace/line_length) */ \
   options.set_option("assumptions", !cmdline.isset("no-assumptions")); /* NOLINT(whitespace/line_length) */ \
   options.set_option("assert-to-assume", cmdline.isset("assert-to-assume")); /* NOLINT(whitespace/line_length) */ \
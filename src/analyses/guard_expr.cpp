@@ -16,6 +16,54 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/simplify_utils.h>
 #include <util/std_expr.h>
 
+#include <unordered_set>
+
+/// Collect the atoms of \p expr, i.e., the operands that are not Boolean
+/// connectives, the same way as \ref bdd_exprt::from_expr does.
+/// \return false if there are more than \p max_atoms atoms
+static bool collect_atoms(
+  const exprt &expr,
+  std::size_t max_atoms,
+  std::unordered_set<const void *> &visited,
+  std::unordered_set<exprt, irep_hash> &atoms)
+{
+  if(!visited.insert(&expr.read()).second || expr.is_constant())
+    return true;
+
+  if(
+    expr.id() == ID_not || expr.id() == ID_and || expr.id() == ID_or ||
+    expr.id() == ID_xor || expr.id() == ID_implies || expr.id() == ID_if ||
+    (expr.id() == ID_equal &&
+     to_equal_expr(expr).lhs().type().id() == ID_bool))
+  {
+    for(const auto &op : expr.operands())
+    {
+      if(!collect_atoms(op, max_atoms, visited, atoms))
+        return false;
+    }
+
+    return true;
+  }
+
+  atoms.insert(expr);
+  return atoms.size() <= max_atoms;
+}
+
+exprt guard_expr_managert::disjunction(const exprt &a, const exprt &b)
+{
+  std::unordered_set<const void *> visited;
+  std::unordered_set<exprt, irep_hash> atoms;
+
+  if(
+    !collect_atoms(a, max_bdd_atoms, visited, atoms) ||
+    !collect_atoms(b, max_bdd_atoms, visited, atoms))
+  {
+    return or_exprt{a, b};
+  }
+
+  return bdd.as_expr(bdd.from_expr(a).bdd_or(bdd.from_expr(b)));
+}
+
 exprt guard_exprt::guard_expr(exprt expr) const
 {
   if(is_true())
@@ -149,9 +197,7 @@ guard_exprt &operator|=(guard_exprt &g1, const guard_exprt &g2)
     if(tmp == g1.as_expr())
       g1.expr = true_exprt();
     else
-      g1.expr = or_exprt(g1.as_expr(), g2.as_expr());
-
-    // TODO: make simplify more capable and apply here
+      g1.expr = g1.manager->disjunction(g1.as_expr(), g2.as_expr());
 
     return g1;
   }
@@ -203,8 +249,7 @@ guard_exprt &operator|=(guard_exprt &g1, const guard_exprt &g2)
     {
     }
     else
-      // TODO: make simplify more capable and apply here
-      g1.add(or_exprt(and_expr1, and_expr2));
+      g1.add(g1.manager->disjunction(and_expr1, and_expr2));
   }
 
   return g1;
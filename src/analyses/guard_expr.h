@@ -13,25 +13,40 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_ANALYSES_GUARD_EXPR_H
 
 #include <util/expr.h>
+#include <util/magic.h>
 
-/// This is unused by this implementation of guards, but can be used by other
-/// implementations of the same interface.
+#include <solvers/prop/bdd_expr.h>
+
+/// Simplifies the disjunctions built when merging guards by means of BDDs, as
+/// long as the disjuncts have few atoms, i.e., distinct conditions of
+/// branches. Disjunctions with more atoms are built syntactically, which keeps
+/// merging linear where BDDs might grow exponentially.
 struct guard_expr_managert
 {
+  /// \return an expression equivalent to `a || b`, which is simplified using
+  ///   BDDs if \p a and \p b together have at most \ref max_bdd_atoms atoms
+  exprt disjunction(const exprt &a, const exprt &b);
+
+  std::size_t max_bdd_atoms = GUARD_MAX_BDD_ATOMS;
+
+protected:
+  bdd_exprt bdd;
 };
 
 class guard_exprt
 {
 public:
-  /// Construct a BDD from an expression
-  /// The \c guard_managert parameter is not used, but we keep it for uniformity
-  /// with other implementations of guards which may use it.
-  explicit guard_exprt(const exprt &e, guard_expr_managert &) : expr(e)
+  /// Construct a guard from an expression
+  /// The \c guard_managert parameter simplifies disjunctions of guards, it
+  /// must outlive the guard.
+  explicit guard_exprt(const exprt &e, guard_expr_managert &manager)
+    : manager(&manager), expr(e)
   {
   }
 
   guard_exprt &operator=(const guard_exprt &other)
   {
+    manager = other.manager;
     expr = other.expr;
     return *this;
   }
@@ -76,6 +91,7 @@ public:
   bool disjunction_may_simplify(const guard_exprt &other_guard);
 
 private:
+  guard_expr_managert *manager;
   exprt expr;
 };
 
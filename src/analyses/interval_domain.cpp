@@ -139,6 +139,39 @@ void interval_domaint::transform(
   }
 }
 
+/// Join the intervals of \p b into \p map, removing the variables that are
+/// not in \p b. As both maps are ordered by the same key, they are traversed
+/// together rather than searching \p b for each variable of \p map.
+/// \return true if \p map changed
+template <typename mapt>
+static bool join_maps(mapt &map, const mapt &b)
+{
+  bool result = false;
+  typename mapt::const_iterator b_it = b.begin();
+
+  for(typename mapt::iterator it = map.begin(); it != map.end();) // no it++
+  {
+    while(b_it != b.end() && map.key_comp()(b_it->first, it->first))
+      ++b_it;
+
+    if(b_it == b.end() || map.key_comp()(it->first, b_it->first))
+    {
+      it = map.erase(it);
+      result = true;
+    }
+    else
+    {
+      if(it->second.join(b_it->second))
+        result = true;
+
+      ++it;
+      ++b_it;
+    }
+  }
+
+  return result;
+}
+
 /// Sets *this to the mathematical join between the two domains. This can be
 /// thought of as an abstract version of union; *this is increased so that it
 /// contains all of the values that are represented by b as well as its original
@@ -162,51 +195,10 @@ bool interval_domaint::join(
     return true;
   }
 
-  bool result=false;
-
-  for(int_mapt::iterator it=int_map.begin();
-      it!=int_map.end(); ) // no it++
-  {
-    // search for the variable that needs to be merged
-    // containers have different size and variable order
-    const int_mapt::const_iterator b_it=b.int_map.find(it->first);
-    if(b_it==b.int_map.end())
-    {
-      it=int_map.erase(it);
-      result=true;
-    }
-    else
-    {
-      integer_intervalt previous=it->second;
-      it->second.join(b_it->second);
-      if(it->second!=previous)
-        result=true;
-
-      it++;
-    }
-  }
-
-  for(float_mapt::iterator it=float_map.begin();
-      it!=float_map.end(); ) // no it++
-  {
-    const float_mapt::const_iterator b_it=b.float_map.begin();
-    if(b_it==b.float_map.end())
-    {
-      it=float_map.erase(it);
-      result=true;
-    }
-    else
-    {
-      ieee_float_intervalt previous=it->second;
-      it->second.join(b_it->second);
-      if(it->second!=previous)
-        result=true;
+  const bool int_result = join_maps(int_map, b.int_map);
+  const bool float_result = join_maps(float_map, b.float_map);
 
-      it++;
-    }
-  }
-
-  return result;
+  return int_result || float_result;
 }
 
 void interval_domaint::assign(const code_assignt &code_assign)
@@ -14,6 +14,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <memory>
 #include <stack>
+#include <unordered_map>
 
 #include <util/union_find.h>
 #include <util/make_unique.h>
@@ -103,6 +104,11 @@ public:
   {
     goto_functions=&_goto_functions;
 
+    std::size_t number_of_instructions = 0;
+    for(const auto &gf_entry : _goto_functions.function_map)
+      number_of_instructions += gf_entry.second.body.instructions.size();
+    target_map.reserve(number_of_instructions);
+
     for(const auto &gf_entry : _goto_functions.function_map)
     {
       forall_goto_program_instructions(i_it, gf_entry.second.body)
@@ -137,10 +143,15 @@ public:
 
 protected:
   const goto_functionst *goto_functions;
-  typedef std::map<irep_idt, std::unique_ptr<local_may_aliast> > fkt_mapt;
+  typedef std::unordered_map<irep_idt, std::unique_ptr<local_may_aliast>>
+    fkt_mapt;
   fkt_mapt fkt_map;
 
-  typedef std::map<goto_programt::const_targett, irep_idt > target_mapt;
+  // one entry per instruction of the program, hence hashed on the address
+  // rather than ordered
+  typedef std::
+    unordered_map<goto_programt::const_targett, irep_idt, const_target_hash>
+      target_mapt;
   target_mapt target_map;
 };
 
@@ -81,7 +81,7 @@ static optionalt<goto_null_checkt> get_null_checked_expr(const exprt &expr)
 /// \param goto_program: program to analyse
 void local_safe_pointerst::operator()(const goto_programt &goto_program)
 {
-  std::set<exprt, type_comparet> checked_expressions(type_comparet{});
+  std::set<exprt> checked_expressions;
 
   for(const auto &instruction : goto_program.instructions)
   {
@@ -95,9 +95,7 @@ void local_safe_pointerst::operator()(const goto_programt &goto_program)
       if(findit != non_null_expressions.end())
         checked_expressions = findit->second;
       else
-      {
-        checked_expressions = std::set<exprt, type_comparet>(type_comparet{});
-      }
+        checked_expressions.clear();
     }
 
     // Save the working set at this program point:
@@ -24,17 +24,12 @@ Author: Diffblue Ltd
 /// possibly-aliasing operations are handled pessimistically.
 class local_safe_pointerst
 {
-  /// Comparator that regards type-equal expressions as equal, and otherwise
-  /// uses the natural (operator<) ordering on irept.
-  struct type_comparet
-  {
-    bool operator()(const exprt &e1, const exprt &e2) const
-    {
-      return e1.type() != e2.type() && e1 < e2;
-    }
-  };
-
-  std::map<unsigned, std::set<exprt, type_comparet>> non_null_expressions;
+  /// The expressions known not to be null before each instruction, by
+  /// location number. These are ordered by the natural (operator<) ordering on
+  /// irept, which includes the types: a comparison that regarded all
+  /// expressions of the same type as equal would consider any pointer of the
+  /// type of a checked one non-null.
+  std::map<unsigned, std::set<exprt>> non_null_expressions;
 
 public:
   void operator()(const goto_programt &goto_program);
@@ -25,6 +25,7 @@ Date: February 2013
 #ifndef CPROVER_ANALYSES_REACHING_DEFINITIONS_H
 #define CPROVER_ANALYSES_REACHING_DEFINITIONS_H
 
+#include <util/sparse_bitset.h>
 #include <util/threeval.h>
 
 #include "ai.h"
@@ -250,7 +251,10 @@ private:
   /// `this` is passed to `set_bitvector_container` for all instances.
   sparse_bitvector_analysist<reaching_definitiont> *const bv_container;
 
-  typedef std::set<std::size_t> values_innert;
+  /// The `ID`s of the definitions of one variable. These are handed out
+  /// consecutively, so they are stored as a sparse bit set, which makes the
+  /// kills and merges of the analysis operate on whole words.
+  typedef sparse_bitsett values_innert;
   #ifdef USE_DSTRING
   typedef std::map<irep_idt, values_innert> valuest;
   #else
@@ -320,7 +320,12 @@ bool abstract_environmentt::merge(
   // if it is new, or merge with the existing key if it is not present
   if(bottom)
   {
+    // the statistics are those of this environment, not of env
+    const std::size_t merges = number_of_merges + 1;
+    const std::size_t merged_entries = number_of_merged_entries;
     *this = env;
+    number_of_merges = merges;
+    number_of_merged_entries = merged_entries;
     return !env.bottom;
   }
 
@@ -329,15 +334,24 @@ bool abstract_environmentt::merge(
 
   // For each element in the intersection of map and env.map merge
   // If the result of the merge is top, remove from the map
+  // Entries shared between the maps are not visited, and those that do not
+  // change are not replaced so that the path to them stays shared.
   bool modified = false;
-  for(const auto &entry : env.map.get_delta_view(map))
+  const auto delta_view = env.map.get_delta_view(map);
+  for(const auto &entry : delta_view)
   {
     auto merge_result =
       abstract_objectt::merge(entry.get_other_map_value(), entry.m, widen_mode);
-    modified |= merge_result.modified;
-    map.replace(entry.k, merge_result.object);
+    if(merge_result.modified)
+    {
+      modified = true;
+      map.replace(entry.k, merge_result.object);
+    }
   }
 
+  number_of_merges++;
+  number_of_merged_entries += delta_view.size();
+
   return modified;
 }
 
@@ -427,32 +441,30 @@ abstract_environmentt::modified_symbols(
   const abstract_environmentt &first,
   const abstract_environmentt &second)
 {
-  // Find all symbols who have different write locations in each map
+  // Find all symbols who have different write locations in each map. The
+  // objects shared between the maps have not been modified, so only the
+  // subtrees that are not shared are visited.
   std::vector<abstract_environmentt::map_keyt> symbols_diff;
-  decltype(first.map)::viewt view;
-  first.map.get_view(view);
-  for(const auto &entry : view)
+  decltype(first.map)::delta_viewt delta_view;
+  decltype(first.map)::delta_viewt second_only_view;
+  first.map.get_symmetric_delta_view(second.map, delta_view, second_only_view);
+
+  for(const auto &entry : delta_view)
   {
-    const auto &second_entry = second.map.find(entry.first);
-    if(second_entry.has_value())
+    if(
+      entry.is_in_both_maps() &&
+      entry.get_other_map_value()->has_been_modified(entry.m))
     {
-      if(second_entry.value().get()->has_been_modified(entry.second))
-      {
-        CHECK_RETURN(!entry.first.empty());
-        symbols_diff.push_back(entry.first);
-      }
+      CHECK_RETURN(!entry.k.empty());
+      symbols_diff.push_back(entry.k);
     }
   }
 
   // Add any symbols that are only in the second map
-  for(const auto &entry : second.map.get_view())
+  for(const auto &entry : second_only_view)
   {
-    const auto &second_entry = first.map.find(entry.first);
-    if(!second_entry.has_value())
-    {
-      CHECK_RETURN(!entry.first.empty());
-      symbols_diff.push_back(entry.first);
-    }
+    CHECK_RETURN(!entry.k.empty());
+    symbols_diff.push_back(entry.k);
   }
   return symbols_diff;
 }
@@ -474,6 +486,8 @@ abstract_environmentt::gather_statistics(const namespacet &ns) const
 {
   abstract_object_statisticst statistics = {};
   statistics.number_of_globals = count_globals(ns);
+  statistics.number_of_merges = number_of_merges;
+  statistics.number_of_merged_entries = number_of_merged_entries;
   decltype(map)::viewt view;
   map.get_view(view);
   abstract_object_visitedt visited;
@@ -255,6 +255,11 @@ protected:
 
   sharing_mapt<map_keyt, abstract_object_pointert> map;
 
+  /// The number of environments merged into this one, and the number of
+  /// entries these merges visited, for the statistics
+  std::size_t number_of_merges = 0;
+  std::size_t number_of_merged_entries = 0;
+
 private:
   /// Look at the configuration for the sensitivity and create an
   /// appropriate abstract_object
@@ -24,6 +24,11 @@ struct abstract_object_statisticst
   std::size_t number_of_pointers = 0;
   std::size_t number_of_constants = 0;
   std::size_t number_of_globals = 0;
+  /// The number of environments merged into the environment
+  std::size_t number_of_merges = 0;
+  /// The number of entries the merges visited, which excludes those shared
+  /// between the environments
+  std::size_t number_of_merged_entries = 0;
   /// An underestimation of the memory usage of the abstract objects
   memory_sizet objects_memory_usage;
 };
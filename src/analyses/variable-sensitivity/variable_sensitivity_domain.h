@@ -297,6 +297,9 @@ struct get_domain_statisticst<variable_sensitivity_domaint>
     total_statistics.number_of_arrays += statistics.number_of_arrays;
     total_statistics.number_of_structs += statistics.number_of_arrays;
     total_statistics.objects_memory_usage += statistics.objects_memory_usage;
+    total_statistics.number_of_merges += statistics.number_of_merges;
+    total_statistics.number_of_merged_entries +=
+      statistics.number_of_merged_entries;
   }
 
   void print(std::ostream &out) const
@@ -315,6 +318,9 @@ struct get_domain_statisticst<variable_sensitivity_domaint>
         << "  Number of single value intervals: "
         << total_statistics.number_of_single_value_intervals << '\n'
         << "  Number of globals: " << total_statistics.number_of_globals << '\n'
+        << "  Number of merges: " << total_statistics.number_of_merges << '\n'
+        << "  Entries visited by merges: "
+        << total_statistics.number_of_merged_entries << '\n'
         << "<< End Variable Sensitivity Domain Statistics >>\n";
   }
 };
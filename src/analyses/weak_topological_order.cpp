@@ -0,0 +1,183 @@
+/*******************************************************************\
+
+Module: Weak Topological Order
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Weak Topological Order
+
+#include "weak_topological_order.h"
+
+#include <functional>
+#include <limits>
+#include <ostream>
+
+weak_topological_ordert::weak_topological_ordert(
+  const goto_programt &goto_program)
+{
+  std::vector<locationt> nodes;
+  std::unordered_map<locationt, std::size_t, const_target_hash> node_index;
+  forall_goto_program_instructions(it, goto_program)
+  {
+    node_index.emplace(it, nodes.size());
+    nodes.push_back(it);
+  }
+
+  std::vector<std::vector<std::size_t>> successors(nodes.size());
+  for(std::size_t v = 0; v < nodes.size(); ++v)
+  {
+    for(const auto &succ : goto_program.get_successors(nodes[v]))
+    {
+      if(succ != goto_program.instructions.end())
+        successors[v].push_back(node_index.at(succ));
+    }
+  }
+
+  // The hierarchy built by Bourdoncle's algorithm. Elements are added to a
+  // component once they are complete, i.e., in reverse order. Index 0 is the
+  // top level.
+  struct treet
+  {
+    std::size_t vertex;
+    bool is_component;
+    std::vector<std::size_t> children;
+  };
+  std::vector<treet> tree{{0, true, {}}};
+
+  // The recursive algorithm, with an explicit stack to cope with long
+  // functions. A frame of `visit` becomes one of `component` once its
+  // vertex turns out to be a head.
+  struct framet
+  {
+    std::size_t vertex;
+    std::size_t next_successor;
+    std::size_t head;
+    bool loop;
+    bool is_component;
+    std::size_t parent;
+    std::size_t component;
+  };
+  std::vector<framet> frames;
+
+  const std::size_t infinity = std::numeric_limits<std::size_t>::max();
+  std::vector<std::size_t> dfn(nodes.size(), 0);
+  std::vector<std::size_t> stack;
+  std::size_t number = 0;
+
+  auto visit = [&](std::size_t v, std::size_t parent) {
+    stack.push_back(v);
+    dfn[v] = ++number;
+    frames.push_back({v, 0, dfn[v], false, false, parent, 0});
+  };
+
+  if(!nodes.empty())
+    visit(0, 0);
+
+  while(!frames.empty())
+  {
+    framet &frame = frames.back();
+
+    if(frame.next_successor < successors[frame.vertex].size())
+    {
+      const std::size_t w = successors[frame.vertex][frame.next_successor++];
+
+      if(dfn[w] == 0)
+        visit(w, frame.is_component ? frame.component : frame.parent);
+      else if(!frame.is_component && dfn[w] <= frame.head)
+      {
+        frame.head = dfn[w];
+        frame.loop = true;
+      }
+
+      continue;
+    }
+
+    std::size_t result = frame.head;
+
+    if(frame.is_component)
+      tree[frame.parent].children.push_back(frame.component);
+    else if(frame.head == dfn[frame.vertex])
+    {
+      dfn[frame.vertex] = infinity;
+      std::size_t element = stack.back();
+      stack.pop_back();
+
+      if(frame.loop)
+      {
+        while(element != frame.vertex)
+        {
+          dfn[element] = 0;
+          element = stack.back();
+          stack.pop_back();
+        }
+
+        tree.push_back({frame.vertex, true, {}});
+        frame.component = tree.size() - 1;
+        frame.is_component = true;
+        frame.next_successor = 0;
+        continue;
+      }
+
+      tree.push_back({frame.vertex, false, {}});
+      tree[frame.parent].children.push_back(tree.size() - 1);
+    }
+
+    frames.pop_back();
+
+    if(!frames.empty() && !frames.back().is_component)
+    {
+      framet &caller = frames.back();
+      if(result <= caller.head)
+      {
+        caller.head = result;
+        caller.loop = true;
+      }
+    }
+  }
+
+  // flatten the hierarchy, which only recurses as deep as loops are nested
+  std::function<void(std::size_t)> flatten = [&](std::size_t t) {
+    const bool is_component = t != 0 && tree[t].is_component;
+    if(t != 0)
+      order.push_back({nodes[tree[t].vertex], is_component, 0});
+
+    for(auto it = tree[t].children.rbegin(); it != tree[t].children.rend();
+        ++it)
+    {
+      flatten(*it);
+    }
+
+    if(is_component)
+      order.back().components_closed++;
+  };
+  flatten(0);
+
+  for(std::size_t v = 0; v < nodes.size(); ++v)
+  {
+    if(dfn[v] == 0)
+      order.push_back({nodes[v], false, 0});
+  }
+
+  for(std::size_t i = 0; i < order.size(); ++i)
+    positions[order[i].location] = {i, order[i].is_head};
+}
+
+void weak_topological_ordert::output(std::ostream &out) const
+{
+  bool first = true;
+  for(const auto &element : order)
+  {
+    if(!first)
+      out << ' ';
+    first = false;
+
+    if(element.is_head)
+      out << '(';
+    out << element.location->location_number;
+    for(std::size_t i = 0; i < element.components_closed; ++i)
+      out << ')';
+  }
+}
@@ -0,0 +1,73 @@
+/*******************************************************************\
+
+Module: Weak Topological Order
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Weak Topological Order
+
+#ifndef CPROVER_ANALYSES_WEAK_TOPOLOGICAL_ORDER_H
+#define CPROVER_ANALYSES_WEAK_TOPOLOGICAL_ORDER_H
+
+#include <goto-programs/goto_program.h>
+
+#include <iosfwd>
+#include <unordered_map>
+
+/// A weak topological order of the instructions of a goto program, as in
+/// Bourdoncle, "Efficient chaotic iteration strategies with widenings",
+/// FMPA 1993. This is a hierarchical ordering in which every cycle of the
+/// control-flow graph lies within a component, written `(h ...)`, whose
+/// first element, the head, is entered by all edges into the component from
+/// outside of it. All other edges go forward in the order. Visiting the
+/// instructions in this order thus stabilises each loop before the
+/// instructions after it, and the heads are where widening is needed.
+class weak_topological_ordert
+{
+public:
+  typedef goto_programt::const_targett locationt;
+
+  explicit weak_topological_ordert(const goto_programt &goto_program);
+
+  /// \return the position of \p l in the flattened order, in which each head
+  ///   comes before the other elements of its component. Instructions not
+  ///   reachable from the first one come after all reachable ones, in
+  ///   program order.
+  std::size_t position(locationt l) const
+  {
+    return positions.at(l).position;
+  }
+
+  /// \return true if \p l is the head of a component
+  bool is_head(locationt l) const
+  {
+    return positions.at(l).is_head;
+  }
+
+  /// Output the order using location numbers, as in `1 (2 3) 4`
+  void output(std::ostream &out) const;
+
+protected:
+  struct positiont
+  {
+    std::size_t position;
+    bool is_head;
+  };
+
+  std::unordered_map<locationt, positiont, const_target_hash> positions;
+
+  /// The instructions in the flattened order, with a marker for where a
+  /// component starts and ends
+  struct elementt
+  {
+    locationt location;
+    bool is_head;
+    std::size_t components_closed;
+  };
+  std::vector<elementt> order;
+};
+
+#endif // CPROVER_ANALYSES_WEAK_TOPOLOGICAL_ORDER_H
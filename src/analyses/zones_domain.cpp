@@ -0,0 +1,664 @@
+/*******************************************************************\
+
+Module: Zones Domain
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Zones Domain
+
+#include "zones_domain.h"
+
+#include <util/arith_tools.h>
+#include <util/simplify_expr.h>
+#include <util/std_expr.h>
+
+void zones_domaint::output(
+  std::ostream &out,
+  const ai_baset &,
+  const namespacet &) const
+{
+  if(bottom)
+  {
+    out << "BOTTOM\n";
+    return;
+  }
+
+  zones_domaint d(*this);
+  d.close();
+
+  for(std::size_t i = 0; i < d.variables.size(); ++i)
+  {
+    for(std::size_t j = 0; j < d.variables.size(); ++j)
+    {
+      const auto &b = d.bound(i, j);
+      if(i == j || !b.has_value())
+        continue;
+
+      if(j == 0)
+        out << d.variables[i] << " <= " << *b << "\n";
+      else if(i == 0)
+        out << d.variables[j] << " >= " << -*b << "\n";
+      else
+        out << d.variables[i] << " - " << d.variables[j] << " <= " << *b
+            << "\n";
+    }
+  }
+}
+
+void zones_domaint::transform(
+  const irep_idt &,
+  trace_ptrt trace_from,
+  const irep_idt &,
+  trace_ptrt trace_to,
+  ai_baset &,
+  const namespacet &ns)
+{
+  locationt from{trace_from->current_location()};
+  locationt to{trace_to->current_location()};
+
+  const goto_programt::instructiont &instruction = *from;
+  switch(instruction.type)
+  {
+  case DECL:
+    havoc_rec(instruction.decl_symbol());
+    break;
+
+  case DEAD:
+    havoc_rec(instruction.dead_symbol());
+    break;
+
+  case ASSIGN:
+    assign(instruction.assign_lhs(), instruction.assign_rhs());
+    break;
+
+  case GOTO:
+  {
+    // Comparing iterators is safe as the target must be within the same list
+    // of instructions because this is a GOTO.
+    locationt next = std::next(from);
+    if(from->get_target() != next) // If equal then a skip
+    {
+      if(next == to)
+        assume(not_exprt(instruction.get_condition()), ns);
+      else
+        assume(instruction.get_condition(), ns);
+    }
+    break;
+  }
+
+  case ASSUME:
+    assume(instruction.get_condition(), ns);
+    break;
+
+  case FUNCTION_CALL:
+  {
+    const code_function_callt &code_function_call =
+      instruction.get_function_call();
+    if(code_function_call.lhs().is_not_nil())
+      havoc_rec(code_function_call.lhs());
+    break;
+  }
+
+  case CATCH:
+  case THROW:
+    DATA_INVARIANT(false, "Exceptions must be removed before analysis");
+    break;
+  case RETURN:
+    DATA_INVARIANT(false, "Returns must be removed before analysis");
+    break;
+  case ATOMIC_BEGIN: // Ignoring is a valid over-approximation
+  case ATOMIC_END:   // Ignoring is a valid over-approximation
+  case END_FUNCTION: // No action required
+  case START_THREAD: // Require a concurrent analysis at higher level
+  case END_THREAD:   // Require a concurrent analysis at higher level
+  case ASSERT:       // No action required
+  case LOCATION:     // No action required
+  case SKIP:         // No action required
+  case OTHER:        // As in the interval domain
+    break;
+  case INCOMPLETE_GOTO:
+  case NO_INSTRUCTION_TYPE:
+    DATA_INVARIANT(false, "Only complete instructions can be analyzed");
+    break;
+  }
+}
+
+bool zones_domaint::is_top() const
+{
+  if(bottom)
+    return false;
+
+  for(std::size_t i = 0; i < variables.size(); ++i)
+  {
+    for(std::size_t j = 0; j < variables.size(); ++j)
+    {
+      if(i != j && bound(i, j).has_value())
+        return false;
+    }
+  }
+
+  return true;
+}
+
+std::size_t zones_domaint::add_variable(const irep_idt &identifier)
+{
+  const auto entry = variable_index.emplace(identifier, variables.size());
+  if(!entry.second)
+    return entry.first->second;
+
+  const std::size_t n = variables.size();
+  std::vector<optionalt<mp_integer>> new_bounds((n + 1) * (n + 1));
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    for(std::size_t j = 0; j < n; ++j)
+      new_bounds[i * (n + 1) + j] = std::move(bound(i, j));
+  }
+  new_bounds[n * (n + 1) + n] = mp_integer(0);
+
+  variables.push_back(identifier);
+  bounds = std::move(new_bounds);
+
+  return n;
+}
+
+void zones_domaint::havoc(std::size_t i)
+{
+  for(std::size_t k = 0; k < variables.size(); ++k)
+  {
+    if(k != i)
+    {
+      bound(i, k).reset();
+      bound(k, i).reset();
+    }
+  }
+}
+
+void zones_domaint::add_constraint(
+  std::size_t i,
+  std::size_t j,
+  const mp_integer &c)
+{
+  if(bottom)
+    return;
+
+  if(i == j)
+  {
+    if(c < 0)
+      make_bottom();
+    return;
+  }
+
+  const auto &existing = bound(i, j);
+  if(existing.has_value() && *existing <= c)
+    return;
+
+  const auto &reverse = bound(j, i);
+  if(reverse.has_value() && *reverse + c < 0)
+  {
+    make_bottom();
+    return;
+  }
+
+  if(!closed)
+  {
+    bound(i, j) = c;
+    return;
+  }
+
+  // The only new paths are those through the new edge from i to j, so each
+  // bound of x_a - x_b is tightened by x_a - x_i + c + x_j - x_b. As the new
+  // edge does not close a negative cycle, this does not change the bounds
+  // of row j and column i that the loop reads.
+  const std::size_t n = variables.size();
+  for(std::size_t a = 0; a < n; ++a)
+  {
+    const auto &a_i = bound(a, i);
+    if(!a_i.has_value())
+      continue;
+
+    for(std::size_t b = 0; b < n; ++b)
+    {
+      const auto &j_b = bound(j, b);
+      if(!j_b.has_value())
+        continue;
+
+      const mp_integer candidate = *a_i + c + *j_b;
+      auto &a_b = bound(a, b);
+      if(!a_b.has_value() || candidate < *a_b)
+        a_b = candidate;
+    }
+  }
+}
+
+void zones_domaint::close()
+{
+  if(closed || bottom)
+    return;
+
+  const std::size_t n = variables.size();
+  for(std::size_t k = 0; k < n; ++k)
+  {
+    for(std::size_t a = 0; a < n; ++a)
+    {
+      const auto &a_k = bound(a, k);
+      if(!a_k.has_value())
+        continue;
+
+      for(std::size_t b = 0; b < n; ++b)
+      {
+        const auto &k_b = bound(k, b);
+        if(!k_b.has_value())
+          continue;
+
+        const mp_integer candidate = *a_k + *k_b;
+        auto &a_b = bound(a, b);
+        if(!a_b.has_value() || candidate < *a_b)
+          a_b = candidate;
+      }
+    }
+  }
+
+  closed = true;
+
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    if(*bound(i, i) < 0)
+    {
+      make_bottom();
+      return;
+    }
+  }
+}
+
+/// Sets *this to the join of the two states, which keeps the bounds of the
+/// pairs of variables of both states, each the larger of the two. When
+/// widening, which ensures that loops reach a fixed point, the bounds that
+/// \p b exceeds are dropped rather than increased.
+/// \return True if the join increases the set represented by *this, False if
+///   there is no change.
+bool zones_domaint::join(const zones_domaint &b, bool widen)
+{
+  if(b.bottom)
+    return false;
+  if(bottom)
+  {
+    *this = b;
+    return true;
+  }
+
+  // The pointwise maximum of closed matrices is their join, and is closed.
+  // The left operand of widening is not closed, as tightening the bounds
+  // that widening dropped may keep loops from reaching a fixed point.
+  zones_domaint closed_b;
+  const zones_domaint *other = &b;
+  if(!b.closed)
+  {
+    closed_b = b;
+    closed_b.close();
+    other = &closed_b;
+  }
+
+  if(!widen)
+    close();
+
+  const std::size_t n = variables.size();
+  std::vector<optionalt<std::size_t>> other_indices(n);
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    const auto entry = other->variable_index.find(variables[i]);
+    if(entry != other->variable_index.end())
+      other_indices[i] = entry->second;
+  }
+
+  bool result = false;
+
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    for(std::size_t j = 0; j < n; ++j)
+    {
+      auto &this_bound = bound(i, j);
+      if(i == j || !this_bound.has_value())
+        continue;
+
+      if(!other_indices[i].has_value() || !other_indices[j].has_value())
+      {
+        this_bound.reset();
+        result = true;
+        continue;
+      }
+
+      const auto &other_bound =
+        other->bound(*other_indices[i], *other_indices[j]);
+      if(!other_bound.has_value() || (widen && *other_bound > *this_bound))
+      {
+        this_bound.reset();
+        result = true;
+      }
+      else if(*other_bound > *this_bound)
+      {
+        this_bound = *other_bound;
+        result = true;
+      }
+    }
+  }
+
+  if(widen && result)
+    closed = false;
+
+  return result;
+}
+
+bool zones_domaint::merge(
+  const zones_domaint &b,
+  trace_ptrt from,
+  trace_ptrt to)
+{
+  const locationt l_from = from->current_location();
+  const bool widen = l_from->is_backwards_goto() &&
+                     l_from->get_target() == to->current_location();
+
+  return join(b, widen);
+}
+
+optionalt<zones_domaint::termt> zones_domaint::get_term(const exprt &expr)
+{
+  if(!is_int(expr.type()))
+    return {};
+
+  // as in the interval domain, casts between integer types are ignored
+  if(expr.id() == ID_typecast)
+    return get_term(to_typecast_expr(expr).op());
+
+  if(expr.id() == ID_symbol)
+    return termt{to_symbol_expr(expr).get_identifier(), 0};
+
+  if(expr.id() == ID_constant)
+  {
+    const auto value = numeric_cast<mp_integer>(to_constant_expr(expr));
+    if(!value.has_value())
+      return {};
+    return termt{{}, *value};
+  }
+
+  if(expr.id() == ID_plus)
+  {
+    termt result{{}, 0};
+
+    for(const auto &op : expr.operands())
+    {
+      const auto term = get_term(op);
+      if(!term.has_value())
+        return {};
+
+      if(term->identifier.has_value())
+      {
+        if(result.identifier.has_value())
+          return {};
+        result.identifier = term->identifier;
+      }
+
+      result.constant += term->constant;
+    }
+
+    return result;
+  }
+
+  if(expr.id() == ID_minus)
+  {
+    const auto lhs = get_term(to_minus_expr(expr).lhs());
+    const auto rhs = get_term(to_minus_expr(expr).rhs());
+    if(!lhs.has_value() || !rhs.has_value() || rhs->identifier.has_value())
+      return {};
+
+    return termt{lhs->identifier, lhs->constant - rhs->constant};
+  }
+
+  return {};
+}
+
+void zones_domaint::assign(const exprt &lhs, const exprt &rhs)
+{
+  if(bottom)
+    return;
+
+  if(lhs.id() != ID_symbol || !is_int(lhs.type()))
+  {
+    havoc_rec(lhs);
+    return;
+  }
+
+  const irep_idt &identifier = to_symbol_expr(lhs).get_identifier();
+  const auto term = get_term(rhs);
+
+  if(term.has_value() && term->identifier == identifier)
+  {
+    // x := x + c shifts all bounds of x, which keeps them closed
+    const std::size_t i = add_variable(identifier);
+    for(std::size_t k = 0; k < variables.size(); ++k)
+    {
+      if(k == i)
+        continue;
+      if(bound(i, k).has_value())
+        *bound(i, k) += term->constant;
+      if(bound(k, i).has_value())
+        *bound(k, i) -= term->constant;
+    }
+    return;
+  }
+
+  havoc_rec(lhs);
+
+  if(term.has_value())
+  {
+    const std::size_t i = add_variable(identifier);
+    const std::size_t j = get_index(*term);
+    add_constraint(i, j, term->constant);
+    add_constraint(j, i, -term->constant);
+  }
+}
+
+void zones_domaint::havoc_rec(const exprt &lhs)
+{
+  if(lhs.id() == ID_if)
+  {
+    havoc_rec(to_if_expr(lhs).true_case());
+    havoc_rec(to_if_expr(lhs).false_case());
+  }
+  else if(lhs.id() == ID_symbol)
+  {
+    const auto entry =
+      variable_index.find(to_symbol_expr(lhs).get_identifier());
+    if(entry != variable_index.end())
+      havoc(entry->second);
+  }
+  else if(lhs.id() == ID_typecast)
+  {
+    havoc_rec(to_typecast_expr(lhs).op());
+  }
+}
+
+void zones_domaint::assume_rec(
+  const exprt &lhs,
+  irep_idt id,
+  const exprt &rhs)
+{
+  if(id == ID_equal)
+  {
+    assume_rec(lhs, ID_ge, rhs);
+    assume_rec(lhs, ID_le, rhs);
+    return;
+  }
+
+  if(id == ID_notequal)
+    return; // won't do split
+
+  if(id == ID_ge)
+    return assume_rec(rhs, ID_le, lhs);
+
+  if(id == ID_gt)
+    return assume_rec(rhs, ID_lt, lhs);
+
+  // we now have lhs <  rhs or
+  //             lhs <= rhs
+
+  PRECONDITION(id == ID_lt || id == ID_le);
+
+  const auto lhs_term = get_term(lhs);
+  const auto rhs_term = get_term(rhs);
+  if(!lhs_term.has_value() || !rhs_term.has_value())
+    return;
+
+  // x + c1 <= y + c2  --->  x - y <= c2 - c1
+  mp_integer c = rhs_term->constant - lhs_term->constant;
+  if(id == ID_lt)
+    --c;
+
+  const std::size_t i = get_index(*lhs_term);
+  const std::size_t j = get_index(*rhs_term);
+  add_constraint(i, j, c);
+}
+
+void zones_domaint::assume(const exprt &cond, const namespacet &ns)
+{
+  if(bottom)
+    return;
+
+  assume_rec(simplify_expr(cond, ns), false);
+}
+
+void zones_domaint::assume_rec(const exprt &cond, bool negation)
+{
+  if(
+    cond.id() == ID_lt || cond.id() == ID_le || cond.id() == ID_gt ||
+    cond.id() == ID_ge || cond.id() == ID_equal || cond.id() == ID_notequal)
+  {
+    const auto &rel = to_binary_relation_expr(cond);
+
+    if(negation) // !x<y  ---> x>=y
+    {
+      if(rel.id() == ID_lt)
+        assume_rec(rel.op0(), ID_ge, rel.op1());
+      else if(rel.id() == ID_le)
+        assume_rec(rel.op0(), ID_gt, rel.op1());
+      else if(rel.id() == ID_gt)
+        assume_rec(rel.op0(), ID_le, rel.op1());
+      else if(rel.id() == ID_ge)
+        assume_rec(rel.op0(), ID_lt, rel.op1());
+      else if(rel.id() == ID_equal)
+        assume_rec(rel.op0(), ID_notequal, rel.op1());
+      else if(rel.id() == ID_notequal)
+        assume_rec(rel.op0(), ID_equal, rel.op1());
+    }
+    else
+      assume_rec(rel.op0(), rel.id(), rel.op1());
+  }
+  else if(cond.id() == ID_not)
+  {
+    assume_rec(to_not_expr(cond).op(), !negation);
+  }
+  else if(cond.id() == ID_and)
+  {
+    if(!negation)
+    {
+      for(const auto &op : cond.operands())
+        assume_rec(op, false);
+    }
+  }
+  else if(cond.id() == ID_or)
+  {
+    if(negation)
+    {
+      for(const auto &op : cond.operands())
+        assume_rec(op, true);
+    }
+  }
+}
+
+bool zones_domaint::ai_simplify(exprt &condition, const namespacet &ns) const
+{
+  zones_domaint d(*this);
+  d.close();
+  if(d.is_bottom())
+    return true;
+
+  const exprt simplified = simplify_expr(condition, ns);
+
+  // A comparison of two terms is represented exactly, so it holds if the
+  // constraints it adds are implied, i.e., joining them does not change them.
+  // This also decides equalities, which are not refuted by their negation.
+  if(
+    (simplified.id() == ID_lt || simplified.id() == ID_le ||
+     simplified.id() == ID_gt || simplified.id() == ID_ge ||
+     simplified.id() == ID_equal) &&
+    get_term(to_binary_relation_expr(simplified).lhs()).has_value() &&
+    get_term(to_binary_relation_expr(simplified).rhs()).has_value())
+  {
+    zones_domaint a;
+    a.make_top();
+    a.assume(simplified, ns);
+    if(!a.join(d, false))
+    {
+      const bool unchanged = condition.is_true();
+      condition = true_exprt();
+      return unchanged;
+    }
+  }
+
+  zones_domaint negated(d);
+  negated.assume(not_exprt(simplified), ns);
+  if(negated.is_bottom())
+  {
+    const bool unchanged = condition.is_true();
+    condition = true_exprt();
+    return unchanged;
+  }
+
+  d.assume(simplified, ns);
+  if(d.is_bottom())
+  {
+    const bool unchanged = condition.is_false();
+    condition = false_exprt();
+    return unchanged;
+  }
+
+  return true;
+}
+
+optionalt<mp_integer>
+zones_domaint::difference_bound(const exprt &lhs, const exprt &rhs) const
+{
+  if(!closed)
+  {
+    zones_domaint d(*this);
+    d.close();
+    return d.difference_bound(lhs, rhs);
+  }
+
+  const auto lhs_term = get_term(lhs);
+  const auto rhs_term = get_term(rhs);
+  if(bottom || !lhs_term.has_value() || !rhs_term.has_value())
+    return {};
+
+  const mp_integer constant = lhs_term->constant - rhs_term->constant;
+  if(lhs_term->identifier == rhs_term->identifier)
+    return constant;
+
+  const auto index = [this](const termt &term) -> optionalt<std::size_t> {
+    if(!term.identifier.has_value())
+      return std::size_t(0);
+    const auto entry = variable_index.find(*term.identifier);
+    if(entry == variable_index.end())
+      return {};
+    return entry->second;
+  };
+
+  const auto i = index(*lhs_term);
+  const auto j = index(*rhs_term);
+  if(!i.has_value() || !j.has_value() || !bound(*i, *j).has_value())
+    return {};
+
+  return *bound(*i, *j) + constant;
+}
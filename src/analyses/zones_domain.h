@@ -0,0 +1,161 @@
+/*******************************************************************\
+
+Module: Zones Domain
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Zones Domain
+
+#ifndef CPROVER_ANALYSES_ZONES_DOMAIN_H
+#define CPROVER_ANALYSES_ZONES_DOMAIN_H
+
+#include <util/mp_arith.h>
+#include <util/optional.h>
+
+#include "ai_domain.h"
+
+#include <unordered_map>
+#include <vector>
+
+/// A relational domain of constraints `x - y <= c` between pairs of integer
+/// variables, and `x <= c`, `-x <= c` on single ones. Unlike the interval
+/// domain, this keeps relations such as `i <= n` across loops that count up
+/// to a bound, so conditions like `i == n` after the loop can be decided.
+///
+/// The constraints are stored as a dense difference bound matrix. The
+/// variable with index 0 stands for the constant zero, and the entry in row
+/// i and column j is the least known upper bound of `x_i - x_j`, or none if
+/// there is no bound. The matrix is kept closed, i.e., each entry is the
+/// tightest bound implied by the others, by an incremental closure whenever
+/// a constraint is added. Only widening breaks this, and the state is closed
+/// again before it is joined or queried.
+class zones_domaint : public ai_domain_baset
+{
+public:
+  zones_domaint() : bottom(true)
+  {
+  }
+
+  void transform(
+    const irep_idt &function_from,
+    trace_ptrt trace_from,
+    const irep_idt &function_to,
+    trace_ptrt trace_to,
+    ai_baset &ai,
+    const namespacet &ns) final override;
+
+  void output(std::ostream &out, const ai_baset &ai, const namespacet &ns)
+    const override;
+
+  /// Join \p b into this state, widening it when the edge from \p from to
+  /// \p to goes back to a loop head
+  bool merge(const zones_domaint &b, trace_ptrt from, trace_ptrt to);
+
+  void make_bottom() final override
+  {
+    variables.clear();
+    variable_index.clear();
+    bounds.clear();
+    closed = true;
+    bottom = true;
+  }
+
+  void make_top() final override
+  {
+    variables.clear();
+    variable_index.clear();
+    bounds.clear();
+    closed = true;
+    bottom = false;
+    add_variable(irep_idt());
+  }
+
+  void make_entry() final override
+  {
+    make_top();
+  }
+
+  bool is_bottom() const override final
+  {
+    return bottom;
+  }
+
+  bool is_top() const override final;
+
+  void assume(const exprt &, const namespacet &);
+
+  static bool is_int(const typet &src)
+  {
+    return src.id() == ID_signedbv || src.id() == ID_unsignedbv;
+  }
+
+  bool ai_simplify(exprt &condition, const namespacet &ns) const override;
+
+  /// \return the least upper bound on `lhs - rhs` implied by this state, for
+  ///   integer expressions that are a variable plus a constant, or a
+  ///   constant, if there is one
+  optionalt<mp_integer>
+  difference_bound(const exprt &lhs, const exprt &rhs) const;
+
+protected:
+  bool bottom;
+
+  /// Whether each bound is the tightest one implied by the others
+  bool closed = true;
+
+  /// The variables of the matrix, where the first one is the constant zero
+  std::vector<irep_idt> variables;
+  std::unordered_map<irep_idt, std::size_t> variable_index;
+
+  /// The matrix of bounds in row-major order
+  std::vector<optionalt<mp_integer>> bounds;
+
+  optionalt<mp_integer> &bound(std::size_t i, std::size_t j)
+  {
+    return bounds[i * variables.size() + j];
+  }
+
+  const optionalt<mp_integer> &bound(std::size_t i, std::size_t j) const
+  {
+    return bounds[i * variables.size() + j];
+  }
+
+  /// \return the index of \p identifier, adding it if it is not yet a
+  ///   variable of the matrix
+  std::size_t add_variable(const irep_idt &identifier);
+
+  /// A variable, or the constant zero if there is none, plus a constant
+  struct termt
+  {
+    optionalt<irep_idt> identifier;
+    mp_integer constant;
+  };
+
+  static optionalt<termt> get_term(const exprt &);
+
+  std::size_t get_index(const termt &term)
+  {
+    return term.identifier.has_value() ? add_variable(*term.identifier) : 0;
+  }
+
+  /// Add the constraint `x_i - x_j <= c` and restore the closure
+  void add_constraint(std::size_t i, std::size_t j, const mp_integer &c);
+
+  /// Remove all constraints on the variable with index \p i
+  void havoc(std::size_t i);
+
+  /// Make each bound the tightest one implied by the others
+  void close();
+
+  bool join(const zones_domaint &b, bool widen);
+
+  void havoc_rec(const exprt &);
+  void assume_rec(const exprt &, bool negation = false);
+  void assume_rec(const exprt &lhs, irep_idt id, const exprt &rhs);
+  void assign(const exprt &lhs, const exprt &rhs);
+};
+
+#endif // CPROVER_ANALYSES_ZONES_DOMAIN_H
@@ -13,6 +13,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <linking/static_lifetime_init.h>
 
+#include <sstream>
+
 const char gcc_builtin_headers_types[]=
 "# 1 \"gcc_builtin_headers_types.h\"\n"
 #include "gcc_builtin_headers_types.inc"
@@ -336,3 +338,38 @@ void ansi_c_architecture_strings(std::string &code)
   code+=architecture_string(configt::ansi_ct::os_to_string(config.ansi_c.os), "os"); // NOLINT(whitespace/line_length)
   code+=architecture_string(config.ansi_c.NULL_is_zero, "NULL_is_zero");
 }
+
+std::string ansi_c_configuration_key()
+{
+  const configt::ansi_ct &ansi_c = config.ansi_c;
+
+  std::ostringstream key;
+  key << static_cast<int>(ansi_c.mode) << ' '
+      << static_cast<int>(ansi_c.preprocessor) << ' '
+      << static_cast<int>(ansi_c.os) << ' ' << ansi_c.arch << ' '
+      << static_cast<int>(ansi_c.endianness) << ' '
+      << static_cast<int>(ansi_c.c_standard) << ' ' << ansi_c.char_is_unsigned
+      << ansi_c.wchar_t_is_unsigned << ansi_c.for_has_scope
+      << ansi_c.ts_18661_3_Floatn_types << ansi_c.gcc__float128_type
+      << ansi_c.single_precision_constant << ansi_c.NULL_is_zero
+      << ansi_c.malloc_may_fail << ' ' << ansi_c.malloc_failure_mode << ' '
+      << ansi_c.alignment << ' ' << ansi_c.memory_operand_size << '\n';
+
+  for(const auto &list :
+      {ansi_c.defines,
+       ansi_c.undefines,
+       ansi_c.preprocessor_options,
+       ansi_c.include_paths,
+       ansi_c.include_files})
+  {
+    for(const auto &entry : list)
+      key << entry << '\0';
+    key << '\n';
+  }
+
+  std::string additions;
+  ansi_c_internal_additions(additions);
+  key << additions;
+
+  return key.str();
+}
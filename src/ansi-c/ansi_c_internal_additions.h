@@ -15,6 +15,11 @@ Author: Daniel Kroening, kroening@kroening.com
 void ansi_c_internal_additions(std::string &code);
 void ansi_c_architecture_strings(std::string &code);
 
+/// \return everything type checking C depends on besides the source: the
+///   configuration of the front-end and the declarations added to every file,
+///   which have the widths of all types
+std::string ansi_c_configuration_key();
+
 extern const char clang_builtin_headers[];
 extern const char cprover_builtin_headers[];
 extern const char gcc_builtin_headers_types[];
@@ -8,11 +8,17 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "cprover_library.h"
 
+#include <cstdlib>
 #include <sstream>
 
 #include <util/config.h>
 #include <util/symbol_table.h>
 
+#include <goto-programs/symbol_table_cache.h>
+
+#include <linking/linking.h>
+
+#include "ansi_c_internal_additions.h"
 #include "ansi_c_language.h"
 
 static std::string get_cprover_library_text(
@@ -92,14 +98,11 @@ void cprover_c_library_factory(
   add_library(library_text, symbol_table, message_handler);
 }
 
-void add_library(
+static void typecheck_library(
   const std::string &src,
   symbol_tablet &symbol_table,
   message_handlert &message_handler)
 {
-  if(src.empty())
-    return;
-
   std::istringstream in(src);
 
   ansi_c_languaget ansi_c_language;
@@ -108,3 +111,36 @@ void add_library(
 
   ansi_c_language.typecheck(symbol_table, "<built-in-library>");
 }
+
+void add_library(
+  const std::string &src,
+  symbol_tablet &symbol_table,
+  message_handlert &message_handler)
+{
+  if(src.empty())
+    return;
+
+  // The symbols of the library, before linking them with the program, only
+  // depend on its source and the configuration, and can thus be reused by
+  // later runs when the environment names a directory to keep them in.
+  const char *cache_directory = getenv("CPROVER_LIBRARY_CACHE");
+  if(cache_directory == nullptr || *cache_directory == 0)
+  {
+    typecheck_library(src, symbol_table, message_handler);
+    return;
+  }
+
+  const std::string key = ansi_c_configuration_key() + '\n' + src;
+  const std::string file_name =
+    symbol_table_cache_file(cache_directory, "library", key);
+
+  symbol_tablet library_symbol_table;
+  if(read_symbol_table_cache(file_name, key, library_symbol_table))
+  {
+    typecheck_library(src, library_symbol_table, message_handler);
+    write_symbol_table_cache(
+      file_name, key, library_symbol_table, message_handler);
+  }
+
+  linking(symbol_table, library_symbol_table, message_handler);
+}
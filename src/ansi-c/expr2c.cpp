@@ -116,6 +116,8 @@ static std::string clean_identifier(const irep_idt &id)
 
 void expr2ct::get_shorthands(const exprt &expr)
 {
+  type_strings.clear();
+
   const std::unordered_set<irep_idt> symbols = find_symbol_identifiers(expr);
 
   // avoid renaming parameters, if possible
@@ -185,7 +187,17 @@ void expr2ct::get_shorthands(const exprt &expr)
 
 std::string expr2ct::convert(const typet &src)
 {
-  return convert_rec(src, c_qualifierst(), "");
+  // types are printed differently within sizeof
+  if(sizeof_nesting != 0)
+    return convert_rec(src, c_qualifierst(), "");
+
+  const auto entry = type_strings.find(src);
+  if(entry != type_strings.end())
+    return entry->second;
+
+  std::string result = convert_rec(src, c_qualifierst(), "");
+  type_strings.emplace(src, result);
+  return result;
 }
 
 std::string expr2ct::convert_rec(
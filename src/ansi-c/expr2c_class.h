@@ -81,6 +81,12 @@ protected:
   std::unordered_map<irep_idt, std::unordered_set<irep_idt>> ns_collision;
   std::unordered_map<irep_idt, irep_idt> shorthands;
 
+  /// The strings \ref convert produced for types, which recur in the casts of
+  /// the operands of an expression, outside of sizeof; valid as long as the
+  /// shorthands are
+  std::unordered_map<typet, std::string, irep_full_hash, irep_full_eq>
+    type_strings;
+
   unsigned sizeof_nesting;
 
   irep_idt id_shorthand(const irep_idt &identifier) const;
@@ -272,14 +272,16 @@ digit_div (onedig_t *r, const onedig_t *y, unsigned yl, onedig_t *q, unsigned ql
 }
 
 
-// Newly allocate uninitialized space for specified number of digits.
+// Free the digits if on the heap.
 
 inline void
-BigInt::allocate (unsigned digits)
+BigInt::release()
 {
-  size = adjust_size (digits);
-  length = 0;
-  digit = new onedig_t[size];
+  if (on_heap())
+    {
+      memset (digit, 0, size * sizeof digit[0]); // Crypto-paranoia.
+      delete[] digit;
+    }
 }
 
 
@@ -291,8 +293,7 @@ BigInt::reallocate (unsigned digits)
 {
   if (digits > size)
     {
-      if (size)
-	delete[] digit;
+      release();
       size = adjust_size (digits);
       digit = new onedig_t[size];
     }
@@ -307,13 +308,13 @@ BigInt::resize (unsigned digits)
   if (digits > size)
     {
       onedig_t *old_digit = digit;
-      unsigned old_size = size;
+      bool old_on_heap = on_heap();
       size = adjust_size (digits);
       digit = new onedig_t[size];
       if (old_digit)
 	{
 	  memcpy (digit, old_digit, length * sizeof (onedig_t));
-	  if (old_size)
+	  if (old_on_heap)
 	    delete[] old_digit;
 	}
     }
@@ -360,6 +361,20 @@ digit_set (ullong_t ul, onedig_t d[small], unsigned &l)
     }
 }
 
+// Read string of at most small onedig_t into unsigned elementary integer.
+
+inline ullong_t
+digit_get (onedig_t const *d, unsigned l)
+{
+  ullong_t ul = 0;
+  for (int i = l; --i >= 0; )
+    {
+      ul <<= single_bits;
+      ul |= d[i];
+    }
+  return ul;
+}
+
 void
 BigInt::assign (ullong_t ul)
 {
@@ -386,11 +401,7 @@ BigInt::assign (llong_t l)
 
 BigInt::~BigInt()
 {
-  if (size > 0)
-    {
-      memset (digit, 0, size * sizeof digit[0]); // Crypto-paranoia.
-      delete[] digit;
-    }
+  release();
 }
 
 BigInt::BigInt (onedig_t *dig, unsigned len, bool pos)
@@ -401,64 +412,65 @@ BigInt::BigInt (onedig_t *dig, unsigned len, bool pos)
 {}
 
 BigInt::BigInt()
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size]),
+    digit (inline_digit),
     positive (true)
 {}
 
 BigInt::BigInt (signed long int n)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (llong_t (n));
 }
 
 BigInt::BigInt (unsigned long int n)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (ullong_t (n));
 }
 
 BigInt::BigInt (int n)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (llong_t (n));
 }
 
 BigInt::BigInt (unsigned u)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (ullong_t (u));
 }
 
 BigInt::BigInt (llong_t l)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (l);
 }
 
 BigInt::BigInt (ullong_t ul)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (ul);
 }
 
 BigInt::BigInt (BigInt const &y)
-  : size (adjust_size (y.length)),
+  : size (y.length <= inline_size ? unsigned (inline_size)
+				  : adjust_size (y.length)),
     length (y.length),
-    digit (new onedig_t[size]),
+    digit (y.length <= inline_size ? inline_digit : new onedig_t[size]),
     positive (y.positive)
 {
   memcpy (digit, y.digit, length * sizeof (onedig_t));
@@ -471,9 +483,9 @@ BigInt::BigInt (BigInt &&y)
 }
 
 BigInt::BigInt (char const *s, onedig_t b)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size]),
+    digit (inline_digit),
     positive (true)
 {
   scan (s, b);
@@ -482,8 +494,14 @@ BigInt::BigInt (char const *s, onedig_t b)
 BigInt &
 BigInt::operator= (BigInt const &y)
 {
-  BigInt copy(y);
-  swap(copy);
+  if (this != &y)
+    {
+      // Reuse the digits of this where they suffice.
+      reallocate (y.length);
+      length = y.length;
+      positive = y.positive;
+      memcpy (digit, y.digit, length * sizeof (onedig_t));
+    }
   return *this;
 }
 
@@ -494,6 +512,27 @@ BigInt::operator= (BigInt &&y)
   return *this;
 }
 
+void
+BigInt::swap (BigInt &other)
+{
+  // Digits stored inline move with the inline storage.
+  bool this_inline = digit == inline_digit;
+  bool other_inline = other.digit == other.inline_digit;
+  std::swap (other.size, size);
+  std::swap (other.length, length);
+  std::swap (other.digit, digit);
+  std::swap (other.positive, positive);
+  if (this_inline || other_inline)
+    {
+      for (unsigned i = 0; i < inline_size; ++i)
+	std::swap (inline_digit[i], other.inline_digit[i]);
+      if (this_inline)
+	other.digit = other.inline_digit;
+      if (other_inline)
+	digit = inline_digit;
+    }
+}
+
 
 char const *
 BigInt::scan_on (char const *s, onedig_t b)
@@ -690,13 +729,7 @@ BigInt::is_long() const
 
 ullong_t BigInt::to_ulong() const
 {
-  ullong_t ul = 0;
-  for (int i = length; --i >= 0; )
-    {
-      ul <<= single_bits;
-      ul |= digit[i];
-    }
-  return ul;
+  return digit_get (digit, length);
 }
 
 llong_t BigInt::to_long() const
@@ -726,6 +759,11 @@ BigInt::compare (ullong_t b) const
 {
   if (!positive)
     return -1;
+  if (length <= small)
+    {
+      ullong_t a = to_ulong();
+      return a < b ? -1 : a > b ? 1 : 0;
+    }
   onedig_t dig[small];
   unsigned len;
   digit_set (b, dig, len);
@@ -750,6 +788,14 @@ BigInt::compare (llong_t b) const
   if (positive)
     return 1;
 
+  if (length <= small)
+    {
+      // Magnitude of b, avoiding overflow on the most negative value.
+      ullong_t a = to_ulong();
+      ullong_t ub = ullong_t (-(b + 1)) + 1;
+      return a > ub ? -1 : a < ub ? 1 : 0;
+    }
+
   onedig_t dig[small];
   unsigned len;
   digit_set (-b, dig, len);
@@ -778,6 +824,34 @@ BigInt::compare (BigInt const &b) const
 void
 BigInt::add (onedig_t const *dig, unsigned len, bool pos)
 {
+  // Fast path for operands that fit into an elementary type, as long as
+  // the result does, too.
+  if (length <= small && len <= small)
+    {
+      ullong_t a = to_ulong();
+      ullong_t b = digit_get (dig, len);
+      if (positive != pos)
+	{
+	  // We're subtracting effectively.
+	  if (a >= b)
+	    digit_set (a - b, digit, length);
+	  else
+	    {
+	      digit_set (b - a, digit, length);
+	      positive = pos;
+	    }
+	  if (length == 0)
+	    positive = true;
+	  return;
+	}
+      ullong_t sum = a + b;
+      if (sum >= a)
+	{
+	  digit_set (sum, digit, length);
+	  return;
+	}
+    }
+
   // Make sure the result fits into this, even with carry.
   resize ((length > len ? length : len) + 1);
 
@@ -831,7 +905,14 @@ BigInt::add (onedig_t const *dig, unsigned len, bool pos)
 void
 BigInt::mul (onedig_t const *dig, unsigned len, bool pos)
 {
-  if (len < 2)
+  if (length + len <= small)
+    {
+      // The product fits into an elementary type.
+      digit_set (to_ulong() * digit_get (dig, len), digit, length);
+      positive = length == 0 || positive == pos;
+      return;
+    }
+  else if (len < 2)
     {
       // Handle small dig/len operand efficiently.
       if (len == 0 || dig[0] == 0)
@@ -873,7 +954,7 @@ BigInt::mul (onedig_t const *dig, unsigned len, bool pos)
   else
     {
       // Get a new string of digits for the result.
-      unsigned old_size = size;
+      bool old_on_heap = on_heap();
       size = adjust_size (length + len);
       onedig_t *r = new onedig_t[size];
 
@@ -885,7 +966,7 @@ BigInt::mul (onedig_t const *dig, unsigned len, bool pos)
 	digit_mul (dig, len, digit, length, r);
 
       // Replace digit string of this with result.
-      if (old_size)
+      if (old_on_heap)
 	delete[] digit;
       digit = r;
       length += len;
@@ -128,17 +128,25 @@ public:
   // by an elementary type.
   enum { small = sizeof (ullong_t) / sizeof (onedig_t) };
 
+  // Number of digits stored within the object rather than on the heap:
+  // any elementary value plus a carry.
+  enum { inline_size = small + 1 };
+
 private:
   unsigned size;			// Length of digit vector.
   unsigned length;			// Used places in digit vector.
   onedig_t *digit;			// Least significant first.
   bool positive;			// Signed magnitude representation.
+  onedig_t inline_digit[inline_size];	// Digit vector unless on the heap.
 
   // Create or resize this.
-  inline void allocate (unsigned digits);
   inline void reallocate (unsigned digits);
   inline void resize (unsigned digits);
 
+  // Whether digit was allocated on the heap, and thus must be deleted.
+  bool on_heap() const { return size != 0 && digit != inline_digit; }
+  inline void release();
+
   // Adjust length (e.g. after subtraction).
   inline void adjust();
 
@@ -281,13 +289,7 @@ public:
   // Not part of original BigInt.
   void setPower2 (unsigned exponent) _fast;
 
-  void swap (BigInt &other)
-  {
-    std::swap(other.size, size);
-    std::swap(other.length, length);
-    std::swap(other.digit, digit);
-    std::swap(other.positive, positive);
-  }
+  void swap (BigInt &other) _fast;
 };
 
 
@@ -50,13 +50,20 @@ void test_inputst::output_plain_text(
   out << '\n';
 }
 
-json_objectt test_inputst::to_json(
+void test_inputst::output_json(
+  json_stream_objectt &dest,
   const namespacet &ns,
   const goto_tracet &goto_trace,
   bool print_trace) const
 {
-  json_objectt json_result;
-  json_arrayt &json_inputs = json_result["inputs"].make_array();
+  json_arrayt goal_refs;
+  for(const auto &goal_id : goto_trace.get_failed_property_ids())
+  {
+    goal_refs.push_back(json_stringt(goal_id));
+  }
+  dest.push_back("coveredGoals", goal_refs);
+
+  json_stream_arrayt &json_inputs = dest.push_back_stream_array("inputs");
 
   for(const auto &step : goto_trace.steps)
   {
@@ -66,24 +73,15 @@ json_objectt test_inputst::to_json(
       if(step.io_args.size() == 1)
         json_input["value"] =
           json(step.io_args.front(), ns, ns.lookup(step.function_id).mode);
-      json_inputs.push_back(std::move(json_input));
+      json_inputs.push_back(json_input);
     }
   }
 
-  json_arrayt goal_refs;
-  for(const auto &goal_id : goto_trace.get_failed_property_ids())
-  {
-    goal_refs.push_back(json_stringt(goal_id));
-  }
-  json_result["coveredGoals"] = std::move(goal_refs);
-
   if(print_trace)
   {
-    json_arrayt json_trace;
-    convert(ns, goto_trace, json_trace);
-    json_result["trace"] = std::move(json_trace);
+    json_stream_arrayt &json_trace = dest.push_back_stream_array("trace");
+    convert<json_stream_arrayt>(ns, goto_trace, json_trace);
   }
-  return json_result;
 }
 
 xmlt test_inputst::to_xml(
@@ -156,7 +154,8 @@ void c_test_input_generatort::operator()(const goto_trace_storaget &traces)
     for(const auto &trace : traces.all())
     {
       test_inputst test_inputs = (*this)(trace, ns);
-      tests_array.push_back(test_inputs.to_json(ns, trace, print_trace));
+      test_inputs.output_json(
+        tests_array.push_back_stream_object(), ns, trace, print_trace);
     }
     break;
   }
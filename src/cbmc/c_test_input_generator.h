@@ -18,7 +18,7 @@ Author: Daniel Kroening, Peter Schrammel
 
 class goto_tracet;
 class goto_trace_storaget;
-class json_objectt;
+class json_stream_objectt;
 class namespacet;
 class optionst;
 class ui_message_handlert;
@@ -32,9 +32,10 @@ public:
     const namespacet &ns,
     const goto_tracet &goto_trace) const;
 
-  /// Returns the test inputs in JSON format
-  /// including the trace if desired
-  json_objectt to_json(
+  /// Outputs the test inputs in JSON format to \p dest
+  /// including the trace if desired, each step as soon as it is converted
+  void output_json(
+    json_stream_objectt &dest,
     const namespacet &ns,
     const goto_tracet &goto_trace,
     bool print_trace) const;
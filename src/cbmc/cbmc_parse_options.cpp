@@ -14,12 +14,18 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <cstdlib> // exit()
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
 
 #include <util/config.h>
 #include <util/exit_codes.h>
 #include <util/invariant.h>
+#include <util/irep_hash_consing.h>
+#include <util/json.h>
+#include <util/json_stream.h>
 #include <util/make_unique.h>
+#include <util/phase_profile.h>
+#include <util/string2int.h>
 #include <util/version.h>
 
 #ifdef _MSC_VER
@@ -40,7 +46,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-checker/all_properties_verifier_with_fault_localization.h>
 #include <goto-checker/all_properties_verifier_with_trace_storage.h>
 #include <goto-checker/bmc_util.h>
+#include <goto-checker/concrete_execution_checker.h>
 #include <goto-checker/cover_goals_verifier_with_trace_storage.h>
+#include <goto-checker/distributed_verifier.h>
+#include <goto-checker/k_induction_symex_checker.h>
 #include <goto-checker/multi_path_symex_checker.h>
 #include <goto-checker/multi_path_symex_only_checker.h>
 #include <goto-checker/properties.h>
@@ -51,6 +60,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-checker/stop_on_fail_verifier_with_fault_localization.h>
 
 #include <goto-programs/add_malloc_may_fail_variable_initializations.h>
+#include <goto-programs/binary_goto_trace.h>
 #include <goto-programs/initialize_goto_model.h>
 #include <goto-programs/link_to_library.h>
 #include <goto-programs/loop_ids.h>
@@ -72,9 +82,12 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <pointer-analysis/add_failed_symbols.h>
 
+#include <json/json_interface.h>
+
 #include <langapi/mode.h>
 
 #include "c_test_input_generator.h"
+#include "request_server.h"
 
 cbmc_parse_optionst::cbmc_parse_optionst(int argc, const char **argv)
   : parse_options_baset(
@@ -198,11 +211,131 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("show-vcc", true);
 
   if(cmdline.isset("cover"))
+  {
     parse_cover_options(cmdline, options);
+    options.set_option("cover-batching", cmdline.isset("cover-batching"));
+  }
 
   if(cmdline.isset("mm"))
     options.set_option("mm", cmdline.get_value("mm"));
 
+  if(cmdline.isset("mm-lazy"))
+  {
+    if(cmdline.isset("beautify") || cmdline.isset("localize-faults"))
+    {
+      log.error() << "--mm-lazy cannot be used with --beautify or "
+                  << "--localize-faults" << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("mm-lazy", true);
+  }
+
+  if(cmdline.isset("mm-prune-read-from"))
+    options.set_option("mm-prune-read-from", true);
+
+  if(cmdline.isset("property-jobs"))
+    options.set_option("property-jobs", cmdline.get_value("property-jobs"));
+
+  if(cmdline.isset("coordinate"))
+  {
+    options.set_option("coordinate", cmdline.get_value("coordinate"));
+
+    if(cmdline.isset("coordinator-jobs"))
+    {
+      options.set_option(
+        "coordinator-jobs", cmdline.get_value("coordinator-jobs"));
+    }
+
+    if(cmdline.isset("coordinator-retries"))
+    {
+      options.set_option(
+        "coordinator-retries", cmdline.get_value("coordinator-retries"));
+    }
+  }
+
+  if(cmdline.isset("property-conflict-budget"))
+  {
+    options.set_option(
+      "property-conflict-budget",
+      cmdline.get_value("property-conflict-budget"));
+  }
+
+  if(cmdline.isset("stream-equation"))
+    options.set_option("stream-equation", true);
+
+  if(cmdline.isset("memory-budget"))
+    options.set_option("memory-budget", cmdline.get_value("memory-budget"));
+
+  if(
+    cmdline.isset("symex-checkpoint") || cmdline.isset("resume") ||
+    cmdline.isset("dump-equation") || cmdline.isset("solve-equation"))
+  {
+    if(
+      cmdline.isset("paths") || cmdline.isset("incremental-loop") ||
+      cmdline.isset("incremental-loops") || cmdline.isset("stream-equation"))
+    {
+      log.error() << "--symex-checkpoint, --resume, --dump-equation and "
+                  << "--solve-equation are not supported with --paths, "
+                  << "--incremental-loop(s) or --stream-equation"
+                  << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    if(
+      cmdline.isset("solve-equation") &&
+      (cmdline.isset("resume") || cmdline.isset("dump-equation")))
+    {
+      log.error() << "--solve-equation cannot be combined with --resume or "
+                  << "--dump-equation" << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    if(cmdline.isset("dump-equation"))
+      options.set_option("dump-equation", cmdline.get_value("dump-equation"));
+
+    if(cmdline.isset("solve-equation"))
+    {
+      options.set_option(
+        "solve-equation", cmdline.get_value("solve-equation"));
+    }
+
+    if(cmdline.isset("symex-checkpoint"))
+    {
+      options.set_option(
+        "symex-checkpoint", cmdline.get_value("symex-checkpoint"));
+    }
+
+    if(cmdline.isset("symex-checkpoint-interval"))
+    {
+      options.set_option(
+        "symex-checkpoint-interval",
+        cmdline.get_value("symex-checkpoint-interval"));
+    }
+
+    if(cmdline.isset("resume"))
+      options.set_option("resume", cmdline.get_value("resume"));
+  }
+
+  if(cmdline.isset("property-cache"))
+    options.set_option("property-cache", cmdline.get_value("property-cache"));
+
+  if(cmdline.isset("concrete-runs"))
+  {
+    if(cmdline.isset("paths") || cmdline.isset("localize-faults"))
+    {
+      log.error() << "--concrete-runs not supported with --paths or "
+                  << "--localize-faults" << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("concrete-runs", cmdline.get_value("concrete-runs"));
+    options.set_option(
+      "concrete-steps",
+      cmdline.isset("concrete-steps") ? cmdline.get_value("concrete-steps")
+                                      : "100000");
+  }
+
   if(cmdline.isset("symex-complexity-limit"))
     options.set_option(
       "symex-complexity-limit", cmdline.get_value("symex-complexity-limit"));
@@ -212,12 +345,18 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
       "symex-complexity-failed-child-loops-limit",
       cmdline.get_value("symex-complexity-failed-child-loops-limit"));
 
+  if(cmdline.isset("symex-complexity-adaptive"))
+    options.set_option("symex-complexity-adaptive", true);
+
   if(cmdline.isset("property"))
     options.set_option("property", cmdline.get_values("property"));
 
   if(cmdline.isset("drop-unused-functions"))
     options.set_option("drop-unused-functions", true);
 
+  if(cmdline.isset("read-reachable-functions"))
+    options.set_option("read-reachable-functions", true);
+
   if(cmdline.isset("havoc-undefined-functions"))
     options.set_option("havoc-undefined-functions", true);
 
@@ -297,6 +436,18 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("slice-formula"))
     options.set_option("slice-formula", true);
 
+  if(cmdline.isset("word-level-preprocessing"))
+    options.set_option("word-level-preprocessing", true);
+
+  if(cmdline.isset("deduplicate-steps"))
+    options.set_option("deduplicate-steps", true);
+
+  if(cmdline.isset("compact-object-bits"))
+    options.set_option("compact-object-bits", true);
+
+  if(cmdline.isset("symmetry-breaking"))
+    options.set_option("symmetry-breaking", true);
+
   // simplify if conditions and branches
   if(cmdline.isset("no-simplify-if"))
     options.set_option("simplify-if", false);
@@ -306,6 +457,9 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   else if(cmdline.isset("arrays-uf-never"))
     options.set_option("arrays-uf", "never");
 
+  if(cmdline.isset("lazy-arrays"))
+    options.set_option("lazy-arrays", true);
+
   if(cmdline.isset("dimacs"))
     options.set_option("dimacs", true);
 
@@ -345,10 +499,46 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   options.set_option(
     "symex-cache-dereferences", cmdline.isset("symex-cache-dereferences"));
 
-  if(cmdline.isset("incremental-loop"))
+  options.set_option(
+    "symex-function-summaries", cmdline.isset("symex-function-summaries"));
+
+  if(cmdline.isset("symex-simplify-cache-size"))
   {
     options.set_option(
-      "incremental-loop", cmdline.get_value("incremental-loop"));
+      "symex-simplify-cache-size",
+      cmdline.get_value("symex-simplify-cache-size"));
+  }
+
+  if(cmdline.isset("symex-rename-cache-size"))
+  {
+    options.set_option(
+      "symex-rename-cache-size", cmdline.get_value("symex-rename-cache-size"));
+  }
+
+  if(cmdline.isset("incremental-loop") && cmdline.isset("incremental-loops"))
+  {
+    log.error() << "--incremental-loop and --incremental-loops cannot be used "
+                << "together" << messaget::eom;
+    exit(CPROVER_EXIT_USAGE_ERROR);
+  }
+
+  if(cmdline.isset("incremental-loops") && cmdline.isset("k-induction"))
+  {
+    log.error() << "--k-induction requires --incremental-loop"
+                << messaget::eom;
+    exit(CPROVER_EXIT_USAGE_ERROR);
+  }
+
+  if(cmdline.isset("incremental-loop") || cmdline.isset("incremental-loops"))
+  {
+    if(cmdline.isset("incremental-loop"))
+    {
+      options.set_option(
+        "incremental-loop", cmdline.get_value("incremental-loop"));
+    }
+    else
+      options.set_option("incremental-loops", true);
+
     options.set_option("refine", true);
     options.set_option("refine-arrays", true);
 
@@ -358,12 +548,27 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     if(cmdline.isset("unwind-max"))
       options.set_option("unwind-max", cmdline.get_value("unwind-max"));
 
+    if(cmdline.isset("unwind-step"))
+    {
+      const auto step =
+        string2optional_unsigned(cmdline.get_value("unwind-step"));
+      if(!step.has_value() || *step == 0)
+      {
+        log.error() << "--unwind-step must be positive" << messaget::eom;
+        exit(CPROVER_EXIT_USAGE_ERROR);
+      }
+      options.set_option("unwind-step", cmdline.get_value("unwind-step"));
+    }
+
     if(cmdline.isset("ignore-properties-before-unwind-min"))
       options.set_option("ignore-properties-before-unwind-min", true);
 
+    if(cmdline.isset("k-induction"))
+      options.set_option("k-induction", true);
+
     if(cmdline.isset("paths"))
     {
-      log.error() << "--paths not supported with --incremental-loop"
+      log.error() << "--paths not supported with --incremental-loop(s)"
                   << messaget::eom;
       exit(CPROVER_EXIT_USAGE_ERROR);
     }
@@ -383,6 +588,9 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("fpa"))
     options.set_option("fpa", true);
 
+  if(cmdline.isset("smt2-shared-terms"))
+    options.set_option("smt2-shared-terms", true);
+
   bool solver_set=false;
 
   if(cmdline.isset("boolector"))
@@ -449,24 +657,85 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     }
   }
 
+  if(cmdline.isset("solver-portfolio"))
+  {
+    options.set_option(
+      "solver-portfolio", cmdline.get_value("solver-portfolio"));
+  }
+
   if(cmdline.isset("write-solver-stats-to"))
   {
     options.set_option(
       "write-solver-stats-to", cmdline.get_value("write-solver-stats-to"));
   }
 
+  if(cmdline.isset("solver-stats-by"))
+  {
+    const std::string aggregation = cmdline.get_value("solver-stats-by");
+    if(aggregation != "line" && aggregation != "function")
+    {
+      log.error() << "--solver-stats-by expects 'line' or 'function'"
+                  << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+    options.set_option("solver-stats-by", aggregation);
+  }
+
+  if(cmdline.isset("formula-statistics"))
+  {
+    options.set_option(
+      "formula-statistics", cmdline.get_value("formula-statistics"));
+
+    // the clauses are collected by source line
+    if(!cmdline.isset("solver-stats-by"))
+      options.set_option("solver-stats-by", "line");
+    else if(options.get_option("solver-stats-by") != "line")
+    {
+      log.error() << "--formula-statistics requires --solver-stats-by line"
+                  << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+  }
+
   if(cmdline.isset("beautify"))
     options.set_option("beautify", true);
 
   if(cmdline.isset("no-sat-preprocessor"))
     options.set_option("sat-preprocessor", false);
 
+  if(cmdline.isset("sat-threads"))
+    options.set_option("sat-threads", cmdline.get_value("sat-threads"));
+
+  if(cmdline.isset("sat-cubes"))
+    options.set_option("sat-cubes", cmdline.get_value("sat-cubes"));
+
+  if(cmdline.isset("structural-hashing"))
+    options.set_option("structural-hashing", true);
+
+  if(cmdline.isset("aig"))
+    options.set_option("aig", true);
+
+  if(cmdline.isset("simplify-cnf"))
+    options.set_option("simplify-cnf", true);
+
+  if(cmdline.isset("multiplier-encoding"))
+  {
+    options.set_option(
+      "multiplier-encoding", cmdline.get_value("multiplier-encoding"));
+  }
+
   if(cmdline.isset("no-pretty-names"))
     options.set_option("pretty-names", false);
 
   if(cmdline.isset("outfile"))
     options.set_option("outfile", cmdline.get_value("outfile"));
 
+  if(cmdline.isset("binary-trace"))
+  {
+    options.set_option("binary-trace", cmdline.get_value("binary-trace"));
+    options.set_option("trace", true);
+  }
+
   if(cmdline.isset("graphml-witness"))
   {
     options.set_option("graphml-witness", cmdline.get_value("graphml-witness"));
@@ -474,6 +743,9 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("trace", true);
   }
 
+  if(cmdline.isset("graphml-compact-proof"))
+    options.set_option("graphml-compact-proof", true);
+
   if(cmdline.isset("symex-coverage-report"))
   {
     options.set_option(
@@ -513,6 +785,24 @@ int cbmc_parse_optionst::doit()
     return CPROVER_EXIT_SUCCESS;
   }
 
+  if(cmdline.isset("binary-trace-to-json"))
+  {
+    const std::string filename = cmdline.get_value("binary-trace-to-json");
+    std::ifstream in(filename, std::ios::binary);
+    if(!in)
+    {
+      log.error() << "failed to open binary trace file '" << filename << "'"
+                  << messaget::eom;
+      return CPROVER_EXIT_INCORRECT_TASK;
+    }
+
+    json_stream_arrayt json_traces(std::cout, 0);
+    binary_trace_to_json(in, json_traces);
+    json_traces.close();
+    std::cout << '\n';
+    return CPROVER_EXIT_SUCCESS;
+  }
+
   //
   // command line options
   //
@@ -525,6 +815,35 @@ int cbmc_parse_optionst::doit()
 
   log_version_and_architecture("CBMC");
 
+  if(cmdline.isset("hash-cons-ireps"))
+    irep_hash_consingt::enable();
+
+  // report the effect of hash-consing however this method returns
+  struct hash_consing_reportt
+  {
+    explicit hash_consing_reportt(messaget &log) : log(log)
+    {
+    }
+
+    ~hash_consing_reportt()
+    {
+      if(!irep_hash_consingt::is_enabled())
+        return;
+
+      const irep_hash_consingt &table = irep_hash_consingt::instance();
+      const std::size_t lookups = table.number_of_lookups();
+      log.statistics() << "Hash consing: " << lookups
+                       << " irep nodes interned, " << table.size()
+                       << " distinct";
+      if(lookups != 0)
+        log.statistics() << " (" << 100 - (100 * table.size()) / lookups
+                         << "% shared)";
+      log.statistics() << messaget::eom;
+    }
+
+    messaget &log;
+  } hash_consing_report(log);
+
   //
   // Unwinding of transition systems is done by hw-cbmc.
   //
@@ -637,6 +956,21 @@ int cbmc_parse_optionst::doit()
   if(get_goto_program_ret!=-1)
     return get_goto_program_ret;
 
+  if(irep_hash_consingt::is_enabled())
+    irep_hash_consingt::instance()(goto_model.symbol_table);
+
+  if(cmdline.isset("daemon"))
+    return run_daemon(options);
+
+  return verify(goto_model, options, cmdline, ui_message_handler);
+}
+
+int cbmc_parse_optionst::verify(
+  goto_modelt &goto_model,
+  const optionst &options,
+  const cmdlinet &cmdline,
+  ui_message_handlert &ui_message_handler)
+{
   if(cmdline.isset("show-claims") || // will go away
      cmdline.isset("show-properties")) // use this one
   {
@@ -644,13 +978,14 @@ int cbmc_parse_optionst::doit()
     return CPROVER_EXIT_SUCCESS;
   }
 
-  if(set_properties())
+  if(set_properties(goto_model, cmdline))
     return CPROVER_EXIT_SET_PROPERTIES_FAILED;
 
   if(
     options.get_bool_option("program-only") ||
     options.get_bool_option("show-vcc") ||
-    options.get_bool_option("show-byte-ops"))
+    options.get_bool_option("show-byte-ops") ||
+    options.is_set("dump-equation"))
   {
     if(options.get_bool_option("paths"))
     {
@@ -703,9 +1038,54 @@ int cbmc_parse_optionst::doit()
     return CPROVER_EXIT_SUCCESS;
   }
 
+  if(options.is_set("coordinate"))
+  {
+    // the workers run the command line of the coordinator, with the
+    // properties of their jobs
+    cmdlinet job_cmdline = cmdline;
+    for(const char *option : {"coordinate",
+                              "coordinator-jobs",
+                              "coordinator-retries",
+                              "claim",
+                              "property",
+                              "trace",
+                              "xml-ui",
+                              "xml-interface",
+                              "json-ui",
+                              "json-interface",
+                              "daemon"})
+    {
+      job_cmdline.unset(option);
+    }
+
+    distributed_verifiert verifier(
+      options, ui_message_handler, goto_model, json_command_line(job_cmdline));
+    const resultt result = verifier();
+    verifier.report();
+    return result_to_exit_code(result);
+  }
+
   std::unique_ptr<goto_verifiert> verifier = nullptr;
 
-  if(options.is_set("incremental-loop"))
+  if(
+    options.is_set("incremental-loop") &&
+    options.get_bool_option("k-induction"))
+  {
+    if(options.get_bool_option("stop-on-fail"))
+    {
+      verifier =
+        util_make_unique<stop_on_fail_verifiert<k_induction_symex_checkert>>(
+          options, ui_message_handler, goto_model);
+    }
+    else
+    {
+      verifier = util_make_unique<all_properties_verifier_with_trace_storaget<
+        k_induction_symex_checkert>>(options, ui_message_handler, goto_model);
+    }
+  }
+  else if(
+    options.is_set("incremental-loop") ||
+    options.get_bool_option("incremental-loops"))
   {
     if(options.get_bool_option("stop-on-fail"))
     {
@@ -720,6 +1100,20 @@ int cbmc_parse_optionst::doit()
         options, ui_message_handler, goto_model);
     }
   }
+  else if(options.is_set("concrete-runs"))
+  {
+    if(options.get_bool_option("stop-on-fail"))
+    {
+      verifier =
+        util_make_unique<stop_on_fail_verifiert<concrete_execution_checkert>>(
+          options, ui_message_handler, goto_model);
+    }
+    else
+    {
+      verifier = util_make_unique<all_properties_verifier_with_trace_storaget<
+        concrete_execution_checkert>>(options, ui_message_handler, goto_model);
+    }
+  }
   else if(
     options.get_bool_option("stop-on-fail") && options.get_bool_option("paths"))
   {
@@ -774,13 +1168,16 @@ int cbmc_parse_optionst::doit()
     UNREACHABLE;
   }
 
+  phase_profile_scopet phase_profile_scope("verification");
   const resultt result = (*verifier)();
   verifier->report();
 
   return result_to_exit_code(result);
 }
 
-bool cbmc_parse_optionst::set_properties()
+bool cbmc_parse_optionst::set_properties(
+  goto_modelt &goto_model,
+  const cmdlinet &cmdline)
 {
   if(cmdline.isset("claim")) // will go away
     ::set_properties(goto_model, cmdline.get_values("claim"));
@@ -791,12 +1188,97 @@ bool cbmc_parse_optionst::set_properties()
   return false;
 }
 
+int cbmc_parse_optionst::run_daemon(const optionst &options)
+{
+  const cmdlinet daemon_cmdline = cmdline;
+
+  // The processed model for each entry function requested so far, which the
+  // requests share: a request runs in a child process, whose changes to the
+  // model, such as those of --property, the server does not see.
+  std::map<std::string, goto_modelt> models;
+  models.emplace(daemon_cmdline.get_value("function"), std::move(goto_model));
+
+  goto_modelt *request_model = nullptr;
+
+  const auto prepare = [&](const json_objectt &request) -> std::string {
+    cmdline = daemon_cmdline;
+
+    try
+    {
+      cmdline.unset("daemon");
+      cmdline.unset("xml-ui");
+      cmdline.unset("xml-interface");
+      cmdline.set("json-ui");
+      if(request.find("options") != request.end())
+        get_json_options(request["options"], cmdline);
+    }
+    catch(const invalid_command_line_argument_exceptiont &e)
+    {
+      return e.what();
+    }
+
+    const std::string function = cmdline.get_value("function");
+    auto model_it = models.find(function);
+
+    if(model_it == models.end())
+    {
+      log.status() << "Building the program for entry function '" << function
+                   << "'" << messaget::eom;
+
+      optionst function_options;
+      function_options = options;
+      function_options.set_option("function", function);
+      const auto main = config.main;
+      config.main = function;
+
+      goto_modelt function_model;
+      const int get_goto_program_ret = get_goto_program(
+        function_model, function_options, daemon_cmdline, ui_message_handler);
+      config.main = main;
+
+      if(get_goto_program_ret != -1)
+        return "failed to build the program for entry function '" + function +
+               "'";
+
+      if(irep_hash_consingt::is_enabled())
+        irep_hash_consingt::instance()(function_model.symbol_table);
+
+      model_it = models.emplace(function, std::move(function_model)).first;
+    }
+
+    request_model = &model_it->second;
+    return std::string();
+  };
+
+  const auto serve = [&]() {
+    optionst request_options;
+    get_command_line_options(request_options);
+
+    ui_message_handlert request_message_handler(
+      cmdline, std::string("CBMC ") + CBMC_VERSION);
+    messaget::eval_verbosity(
+      cmdline.get_value("verbosity"),
+      messaget::M_STATISTICS,
+      request_message_handler);
+
+    return verify(
+      *request_model, request_options, cmdline, request_message_handler);
+  };
+
+  const int exit_code = serve_requests(
+    daemon_cmdline.get_value("daemon"), prepare, serve, ui_message_handler);
+  cmdline = daemon_cmdline;
+  return exit_code;
+}
+
 int cbmc_parse_optionst::get_goto_program(
   goto_modelt &goto_model,
   const optionst &options,
   const cmdlinet &cmdline,
   ui_message_handlert &ui_message_handler)
 {
+  phase_profile_scopet phase_profile_scope("front-end");
+
   messaget log{ui_message_handler};
   if(cmdline.args.empty())
   {
@@ -880,6 +1362,8 @@ bool cbmc_parse_optionst::process_goto_program(
   const optionst &options,
   messaget &log)
 {
+  phase_profile_scopet phase_profile_scope("process goto program");
+
   // Remove inline assembler; this needs to happen before
   // adding the library.
   remove_asm(goto_model);
@@ -887,10 +1371,13 @@ bool cbmc_parse_optionst::process_goto_program(
   // add the library
   log.status() << "Adding CPROVER library (" << config.ansi_c.arch << ")"
                << messaget::eom;
-  link_to_library(
-    goto_model, log.get_message_handler(), cprover_cpp_library_factory);
-  link_to_library(
-    goto_model, log.get_message_handler(), cprover_c_library_factory);
+  {
+    phase_profile_scopet phase_profile_scope("link library");
+    link_to_library(
+      goto_model, log.get_message_handler(), cprover_cpp_library_factory);
+    link_to_library(
+      goto_model, log.get_message_handler(), cprover_c_library_factory);
+  }
 
   add_malloc_may_fail_variable_initializations(goto_model);
 
@@ -945,6 +1432,7 @@ bool cbmc_parse_optionst::process_goto_program(
   {
     log.status() << "Performing a forwards-backwards reachability slice"
                  << messaget::eom;
+    phase_profile_scopet phase_profile_scope("reachability slice");
     if(options.is_set("property"))
       reachability_slicer(
         goto_model, options.get_list_option("property"), true);
@@ -955,6 +1443,7 @@ bool cbmc_parse_optionst::process_goto_program(
   if(options.get_bool_option("reachability-slice"))
   {
     log.status() << "Performing a reachability slice" << messaget::eom;
+    phase_profile_scopet phase_profile_scope("reachability slice");
     if(options.is_set("property"))
       reachability_slicer(goto_model, options.get_list_option("property"));
     else
@@ -965,6 +1454,7 @@ bool cbmc_parse_optionst::process_goto_program(
   if(options.get_bool_option("full-slice"))
   {
     log.status() << "Performing a full slice" << messaget::eom;
+    phase_profile_scopet phase_profile_scope("full slice");
     if(options.is_set("property"))
       property_slicer(goto_model, options.get_list_option("property"));
     else
@@ -1019,12 +1509,22 @@ void cbmc_parse_optionst::help()
     "Program instrumentation options:\n"
     HELP_GOTO_CHECK
     HELP_COVER
+    " --cover-batching             ask the solver to cover as many goals as\n"
+    "                              possible per call (requires --cover)\n"
     " --mm MM                      memory consistency model for concurrent programs (default: sc)\n" // NOLINT(*)
+    " --mm-lazy                    add memory-model constraints only when a\n"
+    "                              model of the formula violates them\n"
+    " --mm-prune-read-from         do not let a read observe a write of its\n"
+    "                              own thread that a later write with the\n"
+    "                              same guard overwrites\n"
     HELP_CONFIG_LIBRARY
     HELP_REACHABILITY_SLICER
     HELP_REACHABILITY_SLICER_FB
     " --full-slice                 run full slicer (experimental)\n" // NOLINT(*)
     " --drop-unused-functions      drop functions trivially unreachable from main function\n" // NOLINT(*)
+    " --read-reachable-functions   read the bodies of functions trivially\n"
+    "                              reachable from the entry point only when\n"
+    "                              given a single goto binary\n"
     " --havoc-undefined-functions\n"
     "                              for any function that has no body, assign non-deterministic values to\n" // NOLINT(*)
     "                              any parameters passed as non-const pointers and the return value\n" // NOLINT(*)
@@ -1041,6 +1541,18 @@ void cbmc_parse_optionst::help()
     " --dimacs                     generate CNF in DIMACS format\n"
     " --beautify                   beautify the counterexample (greedy heuristic)\n" // NOLINT(*)
     " --localize-faults            localize faults (experimental)\n"
+    " --concrete-runs n            first run the program n times on random inputs\n" // NOLINT(*)
+    "                              with the interpreter, then check the\n"
+    "                              properties that did not fail symbolically\n" // NOLINT(*)
+    " --concrete-steps n           stop each run after n steps (default: 100000)\n" // NOLINT(*)
+    " --coordinate file            check the properties in jobs run by the\n"
+    "                              worker commands in file, one per line,\n"
+    "                              which read the --json-interface command\n"
+    "                              line of a job (-D, -I are not passed on)\n"
+    " --coordinator-jobs n         partition the properties into n jobs\n"
+    "                              (default: twice the number of workers)\n"
+    " --coordinator-retries n      retry a failed job n times on other\n"
+    "                              workers (default: 2)\n"
     " --smt2                       use default SMT2 solver (Z3)\n"
     " --boolector                  use Boolector\n"
     " --cprover-smt2               use CPROVER SMT2 solver\n"
@@ -1048,27 +1560,71 @@ void cbmc_parse_optionst::help()
     " --mathsat                    use MathSAT\n"
     " --yices                      use Yices\n"
     " --z3                         use Z3\n"
+    " --smt2-shared-terms          define terms that occur repeatedly in the\n"
+    "                              SMT2 formula once\n"
     " --refine                     use refinement procedure (experimental)\n"
     " --incremental-smt2-solver cmd\n"
     "                              command to invoke external SMT solver for\n"
-    "                              incremental solving (experimental)\n"
+    "                              incremental solving, which reads commands\n"
+    "                              from stdin, e.g., 'z3 -smt2 -in'\n"
+    "                              (experimental)\n"
     " --external-sat-solver cmd    command to invoke SAT solver process\n"
+    " --simplify-cnf               simplify the formula before writing it with\n" // NOLINT(*)
+    "                              --dimacs or --external-sat-solver\n"
+    " --solver-portfolio s1,...    run the given solvers (sat, refine, z3, ...)\n" // NOLINT(*)
+    "                              in parallel processes and use the result\n"
+    "                              of the first to finish (not with --paths)\n" // NOLINT(*)
+    " --sat-threads n              run n differently seeded instances of MiniSat\n" // NOLINT(*)
+    "                              in parallel threads, 0 for one per hardware\n" // NOLINT(*)
+    "                              thread (default: 1)\n"
+    " --sat-cubes k                split the formula into 2^k cubes over the\n"
+    "                              branch conditions chosen by look-ahead,\n"
+    "                              which the --sat-threads instances solve\n"
+    " --structural-hashing         share gates over the same inputs in the\n"
+    "                              propositional encoding\n"
+    " --aig                        build the formula as an And-Inverter Graph,\n" // NOLINT(*)
+    "                              which is simplified before passing it to\n"
+    "                              the SAT solver\n"
+    " --multiplier-encoding e      encode multiplications using shift-add\n"
+    "                              (default), wallace, dadda or karatsuba\n"
     HELP_STRING_REFINEMENT_CBMC
     " --outfile filename           output formula to given file\n"
     " --arrays-uf-never            never turn arrays into uninterpreted functions\n" // NOLINT(*)
     " --arrays-uf-always           always turn arrays into uninterpreted functions\n" // NOLINT(*)
+    " --lazy-arrays                add array constraints only when violated\n"
+    "                              by a satisfying assignment\n"
     "\n"
     "Other options:\n"
     " --version                    show version and exit\n"
+    " --binary-trace-to-json filename\n"
+    "                              convert the traces --binary-trace wrote to\n"
+    "                              filename to JSON and exit\n"
     HELP_XML_INTERFACE
     HELP_JSON_INTERFACE
+    " --daemon socket              keep the program in memory and check the\n"
+    "                              requests of --json-interface format that\n"
+    "                              connect to the Unix domain socket, each\n"
+    "                              in a process of its own, with JSON output\n"
     HELP_VALIDATE
     HELP_GOTO_TRACE
     HELP_FLUSH
     " --verbosity #                verbosity level\n"
     HELP_TIMESTAMP
+    " --profile-json               report the time spent and the memory used\n"
+    "                              in each phase, as JSON\n"
+    " --simplifier-stats           report the calls, rewrites and time of\n"
+    "                              each rule of the simplifier\n"
     " --write-solver-stats-to json-file\n"
     "                              collect the solver query complexity\n"
+    " --solver-stats-by line|function\n"
+    "                              only count the SSA steps, clauses and\n"
+    "                              literals of each source line or function\n"
+    " --formula-statistics n       show the n source lines with the most\n"
+    "                              clauses in the formula, with their SSA\n"
+    "                              steps, bit width and literals\n"
+    " --hash-cons-ireps            share structurally identical types and\n"
+    "                              constants, and report the ratio of shared\n"
+    "                              nodes\n"
     " --show-array-constraints     show array theory constraints added\n"
     "                              during post processing.\n"
     "                              Requires --json-ui.\n"
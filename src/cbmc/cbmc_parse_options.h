@@ -46,7 +46,11 @@ class optionst;
   OPT_REACHABILITY_SLICER \
   "(debug-level):(no-propagation)(no-simplify-if)" \
   "(document-subgoals)(outfile):(test-preprocessor)" \
-  "(write-solver-stats-to):"  \
+  "(write-solver-stats-to):(solver-stats-by):" \
+  "(formula-statistics):"  \
+  "(hash-cons-ireps)" \
+  "(profile-json)" \
+  "(simplifier-stats)" \
   "(show-array-constraints)"  \
   OPT_CONFIG_C_CPP \
   OPT_CONFIG_PLATFORM \
@@ -57,9 +61,17 @@ class optionst;
   OPT_JSON_INTERFACE \
   "(smt1)(smt2)(fpa)(cvc3)(cvc4)(boolector)(yices)(z3)(mathsat)" \
   "(cprover-smt2)" \
+  "(smt2-shared-terms)" \
   "(incremental-smt2-solver):" \
   "(external-sat-solver):" \
+  "(solver-portfolio):" \
   "(no-sat-preprocessor)" \
+  "(sat-threads):" \
+  "(sat-cubes):" \
+  "(structural-hashing)" \
+  "(aig)" \
+  "(multiplier-encoding):" \
+  "(simplify-cnf)" \
   "(beautify)" \
   "(dimacs)(refine)(max-node-refinement):(refine-arrays)(refine-arithmetic)"\
   OPT_STRING_REFINEMENT_CBMC \
@@ -67,18 +79,24 @@ class optionst;
   OPT_SHOW_PROPERTIES \
   "(show-symbol-table)(show-parse-tree)" \
   "(drop-unused-functions)" \
+  "(read-reachable-functions)" \
   "(havoc-undefined-functions)" \
   "(property):(stop-on-fail)(trace)" \
   "(verbosity):(no-library)" \
   "(nondet-static)" \
   "(version)" \
+  "(binary-trace-to-json):" \
   OPT_COVER \
+  "(cover-batching)" \
   "(symex-coverage-report):" \
-  "(mm):" \
+  "(mm):(mm-lazy)(mm-prune-read-from)" \
   OPT_TIMESTAMP \
-  "(arrays-uf-always)(arrays-uf-never)" \
+  "(arrays-uf-always)(arrays-uf-never)(lazy-arrays)" \
   OPT_FLUSH \
   "(localize-faults)" \
+  "(concrete-runs):(concrete-steps):" \
+  "(daemon):" \
+  "(coordinate):(coordinator-jobs):(coordinator-retries):" \
   OPT_GOTO_TRACE \
   OPT_VALIDATE \
   OPT_ANSI_C_LANGUAGE \
@@ -111,13 +129,30 @@ public:
     const cmdlinet &,
     ui_message_handlert &);
 
+  /// Check the properties of the processed \p goto_model as configured by
+  /// \p options and \p cmdline, reporting to \p ui_message_handler
+  /// \return the exit code of CBMC
+  static int verify(
+    goto_modelt &goto_model,
+    const optionst &options,
+    const cmdlinet &cmdline,
+    ui_message_handlert &ui_message_handler);
+
 protected:
   goto_modelt goto_model;
 
   void register_languages();
   void get_command_line_options(optionst &);
   void preprocessing(const optionst &);
-  bool set_properties();
+  static bool set_properties(goto_modelt &, const cmdlinet &);
+
+  /// Serve the verification requests on the socket given by `--daemon`,
+  /// see \ref serve_requests, with \ref goto_model processed as configured
+  /// by \p options. Each request is a command line in the format of
+  /// \ref json_interface whose options replace those of the daemon and
+  /// whose arguments are ignored. The processed program is built once for
+  /// each entry function that the requests give with `"function"`.
+  int run_daemon(const optionst &options);
 };
 
 #endif // CPROVER_CBMC_CBMC_PARSE_OPTIONS_H
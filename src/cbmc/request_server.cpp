@@ -0,0 +1,225 @@
+/*******************************************************************\
+
+Module: Serving Verification Requests on a Socket
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Serving Verification Requests on a Socket
+
+#include "request_server.h"
+
+#include <util/exit_codes.h>
+#include <util/json.h>
+#include <util/message.h>
+#include <util/process_pool.h>
+
+#include <json/json_parser.h>
+
+#ifndef _WIN32
+#  include <cerrno>
+#  include <csignal>
+#  include <cstring>
+#  include <sstream>
+
+#  include <sys/socket.h>
+#  include <sys/stat.h>
+#  include <sys/un.h>
+#  include <unistd.h>
+#endif
+
+#ifndef _WIN32
+/// Read from \p fd up to a newline or the end of the input
+static std::string read_request(int fd)
+{
+  std::string result;
+  char ch;
+  while(true)
+  {
+    const ssize_t n = read(fd, &ch, 1);
+    if(n < 0 && errno == EINTR)
+      continue;
+    if(n <= 0 || ch == '\n')
+      return result;
+    result += ch;
+  }
+}
+
+/// Write \p text to \p fd entirely, giving up when the client has gone
+static void write_response(int fd, const std::string &text)
+{
+  std::size_t written = 0;
+  while(written < text.size())
+  {
+    const ssize_t n = write(fd, text.data() + written, text.size() - written);
+    if(n < 0 && errno == EINTR)
+      continue;
+    if(n <= 0)
+      return;
+    written += static_cast<std::size_t>(n);
+  }
+}
+
+/// Respond to a request that cannot be served, like a JSON UI run would
+static void write_error(int fd, const std::string &error)
+{
+  json_objectt message{{"messageType", json_stringt{"ERROR"}},
+                       {"messageText", json_stringt{error}}};
+  std::ostringstream out;
+  out << json_arrayt{std::move(message)} << '\n';
+  write_response(fd, out.str());
+}
+
+/// Serve the prepared request in a child process writing to \p fd
+/// \return the exit code of the child process
+static int serve_in_child(int fd, int socket_fd, const serve_requestt &serve)
+{
+  process_poolt child;
+
+  const auto serve_to_client = [&]() {
+    close(socket_fd);
+    signal(SIGPIPE, SIG_DFL);
+    dup2(fd, STDOUT_FILENO);
+    close(fd);
+
+    return serve();
+  };
+
+  if(child.start(0, serve_to_client))
+  {
+    write_error(fd, "failed to fork a process for the request");
+    return CPROVER_EXIT_INTERNAL_ERROR;
+  }
+
+  const auto finished = child.wait_for_any();
+  if(!finished.has_value())
+    return CPROVER_EXIT_INTERNAL_ERROR;
+
+  return finished->exit_code.value_or(CPROVER_EXIT_INTERNAL_ERROR);
+}
+#endif
+
+int serve_requests(
+  const std::string &socket_path,
+  prepare_requestt prepare,
+  serve_requestt serve,
+  message_handlert &message_handler)
+{
+  messaget log{message_handler};
+
+#ifdef _WIN32
+  (void)socket_path; // unused parameter
+  (void)prepare;     // unused parameter
+  (void)serve;       // unused parameter
+
+  log.error() << "--daemon is not supported on Windows" << messaget::eom;
+  return CPROVER_EXIT_USAGE_ERROR;
+#else
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+
+  if(socket_path.empty() || socket_path.size() >= sizeof(address.sun_path))
+  {
+    log.error() << "invalid socket path '" << socket_path << "'"
+                << messaget::eom;
+    return CPROVER_EXIT_USAGE_ERROR;
+  }
+
+  std::strncpy(address.sun_path, socket_path.c_str(), socket_path.size());
+
+  const int socket_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if(socket_fd < 0)
+  {
+    log.error() << "failed to create socket: " << std::strerror(errno)
+                << messaget::eom;
+    return CPROVER_EXIT_INTERNAL_ERROR;
+  }
+
+  // a socket left behind by an earlier run, but never any other file
+  struct stat existing;
+  if(lstat(socket_path.c_str(), &existing) == 0)
+  {
+    if(!S_ISSOCK(existing.st_mode))
+    {
+      log.error() << "failed to listen on '" << socket_path
+                  << "': path exists and is not a socket" << messaget::eom;
+      close(socket_fd);
+      return CPROVER_EXIT_USAGE_ERROR;
+    }
+
+    unlink(socket_path.c_str());
+  }
+
+  if(
+    bind(socket_fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) !=
+      0 ||
+    listen(socket_fd, 16) != 0)
+  {
+    log.error() << "failed to listen on '" << socket_path
+                << "': " << std::strerror(errno) << messaget::eom;
+    close(socket_fd);
+    return CPROVER_EXIT_INTERNAL_ERROR;
+  }
+
+  // clients that go away must not take the server with them
+  signal(SIGPIPE, SIG_IGN);
+
+  log.status() << "Serving requests on " << socket_path << messaget::eom;
+
+  std::size_t requests = 0;
+  bool quit = false;
+
+  while(!quit)
+  {
+    const int fd = accept(socket_fd, nullptr, nullptr);
+    if(fd < 0)
+    {
+      if(errno == EINTR)
+        continue;
+
+      log.error() << "failed to accept connection: " << std::strerror(errno)
+                  << messaget::eom;
+      break;
+    }
+
+    std::istringstream in{read_request(fd)};
+    jsont request;
+    null_message_handlert null_message_handler;
+
+    if(
+      parse_json(in, "", null_message_handler, request) ||
+      !request.is_object())
+    {
+      write_error(fd, "JSON object expected as request");
+    }
+    else if(request["quit"].is_true())
+      quit = true;
+    else
+    {
+      ++requests;
+      const std::string error = prepare(to_json_object(request));
+
+      if(!error.empty())
+        write_error(fd, error);
+      else
+      {
+        const int exit_code = serve_in_child(fd, socket_fd, serve);
+        log.status() << "Request " << requests << " finished with exit code "
+                     << exit_code << messaget::eom;
+      }
+    }
+
+    close(fd);
+  }
+
+  close(socket_fd);
+  unlink(socket_path.c_str());
+
+  log.status() << "Served " << requests << " requests" << messaget::eom;
+
+  return CPROVER_EXIT_SUCCESS;
+#endif
+}
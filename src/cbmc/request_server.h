@@ -0,0 +1,45 @@
+/*******************************************************************\
+
+Module: Serving Verification Requests on a Socket
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Serving Verification Requests on a Socket
+
+#ifndef CPROVER_CBMC_REQUEST_SERVER_H
+#define CPROVER_CBMC_REQUEST_SERVER_H
+
+#include <functional>
+#include <string>
+
+class json_objectt;
+class message_handlert;
+
+/// Prepares the serving of a request in the server process, for example by
+/// building state that is to be kept for later requests.
+/// \return an error message, empty if the request can be served
+using prepare_requestt = std::function<std::string(const json_objectt &)>;
+
+/// Serves the request last prepared, in a process of its own whose standard
+/// output is the connection to the client
+/// \return the exit code of the request
+using serve_requestt = std::function<int()>;
+
+/// Accepts connections on the Unix domain socket \p socket_path, one at a
+/// time, and reads a JSON object from each, up to a newline or the end of
+/// the input. A request `{"quit": true}` ends the serving. Any other request
+/// is passed to \p prepare and then, unless that fails, served by \p serve
+/// in a forked child process, so that nothing one request does to the state
+/// of the server, the goto model in particular, is seen by the next.
+/// Not available on Windows.
+/// \return an exit code as in util/exit_codes.h
+int serve_requests(
+  const std::string &socket_path,
+  prepare_requestt prepare,
+  serve_requestt serve,
+  message_handlert &message_handler);
+
+#endif // CPROVER_CBMC_REQUEST_SERVER_H
@@ -310,6 +310,21 @@ const symbolt &cpp_typecheckt::instantiate_template(
   // produce new symbol name
   std::string suffix=template_suffix(full_template_args);
 
+  // let's see if we have a complete instance already
+  const auto instance_key = std::make_pair(template_symbol.name, suffix);
+  {
+    const auto instance = template_instances.find(instance_key);
+    if(instance != template_instances.end())
+    {
+      const symbolt &symb = lookup(instance->second.identifier);
+
+      if(instance->second.is_class && symb.type.id() == ID_struct)
+        return symb;
+      else if(symb.value.is_not_nil())
+        return symb;
+    }
+  }
+
   // we need the template scope to see the template parameters
   cpp_scopet *template_scope=
     static_cast<cpp_scopet *>(cpp_scopes.id_map[template_symbol.name]);
@@ -371,12 +386,15 @@ const symbolt &cpp_typecheckt::instantiate_template(
 
       const symbolt &symb=lookup(cpp_id.identifier);
 
+      const bool is_class = cpp_id.id_class == cpp_idt::id_classt::CLASS;
+
       // continue if the type is incomplete only
-      if(cpp_id.id_class==cpp_idt::id_classt::CLASS &&
-         symb.type.id()==ID_struct)
-        return symb;
-      else if(symb.value.is_not_nil())
+      if(
+        (is_class && symb.type.id() == ID_struct) || symb.value.is_not_nil())
+      {
+        template_instances[instance_key] = {symb.name, is_class};
         return symb;
+      }
     }
 
     cpp_scopes.go_to(sub_scope);
@@ -468,6 +486,8 @@ const symbolt &cpp_typecheckt::instantiate_template(
     new_symb.type.set(ID_C_template, template_type);
     new_symb.type.set(ID_C_template_arguments, specialization_template_args);
 
+    template_instances[instance_key] = {new_symb.name, true};
+
 #ifdef DEBUG
     std::cout << "instance symbol: " << new_symb.name << "\n\n";
     std::cout << "template type: " << template_type.pretty() << "\n\n";
@@ -22,7 +22,7 @@ public:
   {
   }
 
-  typedef std::vector<template_parametert> template_parameterst;
+  typedef irep_sub_containert<template_parametert> template_parameterst;
 
   template_parameterst &template_parameters()
   {
@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@cs.cmu.edu
 #include "cpp_typecheck.h"
 
 #include <algorithm>
+#include <chrono>
 
 #include <util/source_location.h>
 #include <util/symbol.h>
@@ -48,16 +49,37 @@ void cpp_typecheckt::typecheck()
   // default linkage is "automatic"
   current_linkage_spec=ID_auto;
 
+  const auto start = std::chrono::steady_clock::now();
+
   for(auto &item : cpp_parse_tree.items)
     convert(item);
 
+  const auto initialization_start = std::chrono::steady_clock::now();
+
   static_and_dynamic_initialization();
 
+  const auto method_bodies_start = std::chrono::steady_clock::now();
+
   typecheck_method_bodies();
 
   do_not_typechecked();
 
   clean_up();
+
+  const auto stop = std::chrono::steady_clock::now();
+
+  const std::chrono::duration<double> runtime = stop - start;
+  const std::chrono::duration<double> declarations_runtime =
+    initialization_start - start;
+  const std::chrono::duration<double> initialization_runtime =
+    method_bodies_start - initialization_start;
+  const std::chrono::duration<double> method_bodies_runtime =
+    stop - method_bodies_start;
+  statistics() << "Runtime C++ type checking: " << runtime.count() << "s"
+               << " (declarations " << declarations_runtime.count() << "s,"
+               << " initialization " << initialization_runtime.count() << "s,"
+               << " method bodies " << method_bodies_runtime.count() << "s, "
+               << template_instances.size() << " template instances)" << eom;
 }
 
 const struct_typet &cpp_typecheckt::this_struct_type()
@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@cs.cmu.edu
 #define CPROVER_CPP_CPP_TYPECHECK_H
 
 #include <list>
+#include <map>
 #include <set>
 #include <unordered_set>
 
@@ -220,6 +221,18 @@ protected:
   unsigned template_counter;
   unsigned anon_counter;
 
+  struct template_instancet
+  {
+    irep_idt identifier;
+    bool is_class;
+  };
+
+  /// The complete instances of templates, by the identifier of the template
+  /// and the suffix naming the template arguments, to find these without
+  /// setting up the template scope again
+  std::map<std::pair<irep_idt, std::string>, template_instancet>
+    template_instances;
+
   template_mapt template_map;
 
   std::string template_suffix(
@@ -9,6 +9,7 @@ Author: Martin Brain, martin.brain@cs.ox.ac.uk
 #include "build_analyzer.h"
 
 #include <analyses/ai.h>
+#include <analyses/ai_sparse.h>
 #include <analyses/call_stack_history.h>
 #include <analyses/constant_propagator.h>
 #include <analyses/dependence_graph.h>
@@ -19,6 +20,7 @@ Author: Martin Brain, martin.brain@cs.ox.ac.uk
 #include <analyses/variable-sensitivity/variable_sensitivity_dependence_graph.h>
 #include <analyses/variable-sensitivity/variable_sensitivity_domain.h>
 #include <analyses/variable-sensitivity/variable_sensitivity_object_factory.h>
+#include <analyses/zones_domain.h>
 
 #include <goto-programs/goto_model.h>
 
@@ -38,6 +40,8 @@ std::unique_ptr<ai_baset> build_analyzer(
   // These support all of the option categories
   if(
     options.get_bool_option("recursive-interprocedural") ||
+    options.get_bool_option("intraprocedural") ||
+    options.get_bool_option("sparse") ||
     options.get_bool_option("three-way-merge"))
   {
     // Build the history factory
@@ -72,6 +76,11 @@ std::unique_ptr<ai_baset> build_analyzer(
       df = util_make_unique<
         ai_domain_factory_default_constructort<interval_domaint>>();
     }
+    else if(options.get_bool_option("zones"))
+    {
+      df = util_make_unique<
+        ai_domain_factory_default_constructort<zones_domaint>>();
+    }
     else if(options.get_bool_option("vsd"))
     {
       df = util_make_unique<variable_sensitivity_domain_factoryt>(
@@ -98,7 +107,29 @@ std::unique_ptr<ai_baset> build_analyzer(
     {
       if(options.get_bool_option("recursive-interprocedural"))
       {
-        return util_make_unique<ai_recursive_interproceduralt>(
+        auto ai = util_make_unique<ai_recursive_interproceduralt>(
+          std::move(hf), std::move(df), std::move(st));
+        if(options.is_set("function-summaries"))
+        {
+          ai->set_summary_budget(
+            options.get_unsigned_int_option("function-summaries"));
+        }
+        return std::move(ai);
+      }
+      else if(options.get_bool_option("sparse"))
+      {
+        // states are recomputed along unique paths of locations
+        if(
+          options.get_bool_option("ahistorical") &&
+          options.get_bool_option("one-domain-per-location"))
+        {
+          return util_make_unique<ai_sparset>(
+            std::move(hf), std::move(df), std::move(st));
+        }
+      }
+      else if(options.get_bool_option("intraprocedural"))
+      {
+        return util_make_unique<ai_intraproceduralt>(
           std::move(hf), std::move(df), std::move(st));
       }
       else if(options.get_bool_option("three-way-merge"))
@@ -139,6 +170,10 @@ std::unique_ptr<ai_baset> build_analyzer(
     {
       return util_make_unique<ait<interval_domaint>>();
     }
+    else if(options.get_bool_option("zones"))
+    {
+      return util_make_unique<ait<zones_domaint>>();
+    }
 #if 0
     // Not actually implemented, despite the option...
     else if(options.get_bool_option("non-null"))
@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <sstream>
 
 #include <ansi-c/ansi_c_language.h>
 #include <ansi-c/cprover_library.h>
@@ -43,10 +44,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/config.h>
 #include <util/exception_utils.h>
 #include <util/exit_codes.h>
+#include <util/make_unique.h>
 #include <util/options.h>
 #include <util/version.h>
 
 #include "build_analyzer.h"
+#include "results_cache.h"
 #include "show_on_source.h"
 #include "static_show_domain.h"
 #include "static_simplifier.h"
@@ -206,6 +209,10 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
     // Abstract interpreter choice
     if(cmdline.isset("recursive-interprocedural"))
       options.set_option("recursive-interprocedural", true);
+    else if(cmdline.isset("intraprocedural"))
+      options.set_option("intraprocedural", true);
+    else if(cmdline.isset("sparse"))
+      options.set_option("sparse", true);
     else if(cmdline.isset("three-way-merge"))
       options.set_option("three-way-merge", true);
     else if(cmdline.isset("legacy-ait") || cmdline.isset("location-sensitive"))
@@ -236,6 +243,15 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
       options.set_option("storage set", true);
     }
 
+    if(cmdline.isset("weak-topological-order"))
+      options.set_option("weak-topological-order", true);
+
+    if(cmdline.isset("function-summaries"))
+    {
+      options.set_option(
+        "function-summaries", cmdline.get_value("function-summaries"));
+    }
+
     // History choice
     if(cmdline.isset("ahistorical"))
     {
@@ -303,6 +319,11 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
       options.set_option("intervals", true);
       options.set_option("domain set", true);
     }
+    else if(cmdline.isset("zones"))
+    {
+      options.set_option("zones", true);
+      options.set_option("domain set", true);
+    }
     else if(cmdline.isset("non-null"))
     {
       options.set_option("non-null", true);
@@ -324,6 +345,40 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
       options.set_option("data-dependencies", true); // Always set
     }
 
+    // Assertions may be checked with several domains, taking the strongest
+    // verdict any of them gives; the first of them is the one chosen above.
+    if(options.get_bool_option("verify"))
+    {
+      optionst::value_listt domains;
+      for(const std::string domain : {"constants",
+                                      "dependence-graph",
+                                      "intervals",
+                                      "zones",
+                                      "non-null",
+                                      "vsd",
+                                      "dependence-graph-vs"})
+      {
+        if(
+          cmdline.isset(domain.c_str()) ||
+          (domain == "vsd" && cmdline.isset("variable-sensitivity")))
+        {
+          domains.push_back(domain);
+        }
+      }
+
+      if(domains.size() > 1)
+      {
+        if(cmdline.isset("results-cache"))
+        {
+          throw invalid_command_line_argument_exceptiont(
+            "the results cache requires a single domain", "--results-cache");
+        }
+
+        options.set_option("verify-domains", domains);
+        PARSE_OPTIONS_VSD(cmdline, options);
+      }
+    }
+
     // Reachability questions, when given with a domain swap from specific
     // to general tasks so that they can use the domain & parameterisations.
     if(reachability_task)
@@ -373,6 +428,18 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
   {
     options.set_option("validate-goto-model", true);
   }
+
+  // the cached results of a function only depend on its callees when each
+  // function is analysed on its own
+  if(
+    cmdline.isset("results-cache") &&
+    (!options.get_bool_option("verify") ||
+     !options.get_bool_option("intraprocedural")))
+  {
+    throw invalid_command_line_argument_exceptiont(
+      "the results cache requires --verify and --intraprocedural",
+      "--results-cache");
+  }
 }
 
 /// invoke main modules
@@ -597,9 +664,87 @@ int goto_analyzer_parse_optionst::perform_analysis(const optionst &options)
       return CPROVER_EXIT_INTERNAL_ERROR;
     }
 
+    // one more analyzer for each further domain to verify the assertions in
+    std::vector<std::unique_ptr<ai_baset>> further_analyzers;
+    if(options.is_set("verify-domains"))
+    {
+      const auto &domains = options.get_list_option("verify-domains");
+      for(auto it = std::next(domains.begin()); it != domains.end(); ++it)
+      {
+        optionst domain_options = options;
+        for(const auto &domain : domains)
+          domain_options.set_option(domain, false);
+        domain_options.set_option(*it, true);
+        if(*it == "dependence-graph-vs")
+          domain_options.set_option("data-dependencies", true);
+
+        further_analyzers.push_back(
+          build_analyzer(domain_options, goto_model, ns));
+        if(further_analyzers.back() == nullptr)
+        {
+          log.status() << "Task / Interpreter combination not supported"
+                       << messaget::eom;
+          return CPROVER_EXIT_INTERNAL_ERROR;
+        }
+      }
+    }
+
+    if(options.get_bool_option("weak-topological-order"))
+    {
+      analyzer->set_scheduler(ai_baset::schedulert::WEAK_TOPOLOGICAL_ORDER);
+      for(auto &further_analyzer : further_analyzers)
+      {
+        further_analyzer->set_scheduler(
+          ai_baset::schedulert::WEAK_TOPOLOGICAL_ORDER);
+      }
+    }
+
+    // Functions whose results are cached are not analysed again
+    std::unique_ptr<results_cachet> results_cache;
+    if(cmdline.isset("results-cache"))
+    {
+      std::ostringstream configuration;
+      options.output(configuration);
+      results_cache = util_make_unique<results_cachet>(
+        goto_model.goto_functions, configuration.str());
+
+      if(results_cache->read(
+           cmdline.get_value("results-cache"), ui_message_handler))
+      {
+        return CPROVER_EXIT_INCORRECT_TASK;
+      }
+
+      auto intraprocedural =
+        dynamic_cast<ai_intraproceduralt *>(analyzer.get());
+      CHECK_RETURN(intraprocedural != nullptr);
+
+      std::size_t cached_functions = 0;
+      for(const auto &gf_entry : goto_model.goto_functions.function_map)
+      {
+        if(results_cache->lookup(gf_entry.first) != nullptr)
+        {
+          intraprocedural->skip_function(gf_entry.first);
+          cached_functions++;
+        }
+      }
+
+      log.statistics() << "Reusing the results of " << cached_functions
+                       << " unchanged functions" << messaget::eom;
+    }
+
     // Run
     log.status() << "Computing abstract states" << messaget::eom;
     (*analyzer)(goto_model);
+    log.statistics() << "Visited " << analyzer->get_number_of_visits()
+                     << " abstract states" << messaget::eom;
+
+    for(auto &further_analyzer : further_analyzers)
+    {
+      (*further_analyzer)(goto_model);
+      log.statistics() << "Visited "
+                       << further_analyzer->get_number_of_visits()
+                       << " abstract states" << messaget::eom;
+    }
 
     // Perform the task
     log.status() << "Performing task" << messaget::eom;
@@ -618,8 +763,25 @@ int goto_analyzer_parse_optionst::perform_analysis(const optionst &options)
     }
     else if(options.get_bool_option("verify"))
     {
+      std::vector<const ai_baset *> analyzers{analyzer.get()};
+      for(const auto &further_analyzer : further_analyzers)
+        analyzers.push_back(further_analyzer.get());
+
       result = static_verifier(
-        goto_model, *analyzer, options, ui_message_handler, out);
+        goto_model,
+        analyzers,
+        options,
+        ui_message_handler,
+        out,
+        results_cache.get());
+
+      if(
+        results_cache != nullptr &&
+        results_cache->write(
+          cmdline.get_value("results-cache"), ui_message_handler))
+      {
+        return CPROVER_EXIT_INTERNAL_ERROR;
+      }
     }
     else if(options.get_bool_option("simplify"))
     {
@@ -709,7 +871,18 @@ void goto_analyzer_parse_optionst::help()
     // NOLINTNEXTLINE(whitespace/line_length)
     " --verify                     use the abstract domains to check assertions\n"
     // NOLINTNEXTLINE(whitespace/line_length)
+    "                              (with several domains, each assertion gets the\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              strongest verdict any of them gives)\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
     " --simplify file_name         use the abstract domains to simplify the program\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --results-cache file_name    with --verify and --intraprocedural, reuse the results\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              of functions that did not change, and whose callees\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              did not change, since the run that stored them in\n"
+    "                              the given file\n"
     " --unreachable-instructions   list dead code\n"
     // NOLINTNEXTLINE(whitespace/line_length)
     " --unreachable-functions      list functions unreachable from the entry point\n"
@@ -720,11 +893,27 @@ void goto_analyzer_parse_optionst::help()
     // NOLINTNEXTLINE(whitespace/line_length)
     " --recursive-interprocedural  use recursion to handle interprocedural reasoning\n"
     // NOLINTNEXTLINE(whitespace/line_length)
+    " --intraprocedural            analyse each function on its own, approximating calls\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --sparse                     recursive-interprocedural, storing states only where\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              control flow joins (requires --ahistorical and\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              --one-domain-per-location)\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
     " --three-way-merge            use VSD's three-way merge on return from function call\n"
     // NOLINTNEXTLINE(whitespace/line_length)
     " --legacy-ait                 recursion for function and one domain per location\n"
     // NOLINTNEXTLINE(whitespace/line_length)
     " --legacy-concurrent          legacy-ait with an extended fixed-point for concurrency\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --weak-topological-order     visit the instructions of each function in weak\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              topological order rather than by location number\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --function-summaries n       recursive-interprocedural, reusing up to n summaries\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              of callees analysed before from an equal state\n"
     "\n"
     "History options:\n"
     // NOLINTNEXTLINE(whitespace/line_length)
@@ -749,6 +938,8 @@ void goto_analyzer_parse_optionst::help()
     "Domain options:\n"
     " --constants                  a constant for each variable if possible\n"
     " --intervals                  an interval for each variable\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --zones                      bounds on the differences of integer variables\n"
     " --non-null                   tracks which pointers are non-null\n"
     " --dependence-graph           data and control dependencies between instructions\n" // NOLINT(*)
     " --vsd                        a configurable non-relational domain\n" // NOLINT(*)
@@ -108,14 +108,19 @@ class optionst;
 // clang-format off
 #define GOTO_ANALYSER_OPTIONS_TASKS \
   "(show)(verify)(simplify):" \
+  "(results-cache):" \
   "(show-on-source)" \
   "(unreachable-instructions)(unreachable-functions)" \
   "(reachable-functions)"
 
 #define GOTO_ANALYSER_OPTIONS_AI \
   "(recursive-interprocedural)" \
+  "(intraprocedural)" \
+  "(sparse)" \
   "(three-way-merge)" \
   "(legacy-ait)" \
+  "(weak-topological-order)" \
+  "(function-summaries):" \
   "(legacy-concurrent)"
 
 #define GOTO_ANALYSER_OPTIONS_HISTORY \
@@ -127,6 +132,7 @@ class optionst;
 
 #define GOTO_ANALYSER_OPTIONS_DOMAIN \
   "(intervals)" \
+  "(zones)" \
   "(non-null)" \
   "(constants)" \
   "(dependence-graph)" \
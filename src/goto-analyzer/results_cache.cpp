@@ -0,0 +1,222 @@
+/*******************************************************************\
+
+Module: goto-analyzer
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Verification Results cached across Runs
+
+#include "results_cache.h"
+
+#include <util/irep_hash.h>
+#include <util/json.h>
+#include <util/message.h>
+#include <util/string2int.h>
+#include <util/string_hash.h>
+
+#include <goto-programs/goto_functions.h>
+#include <goto-programs/goto_program_fingerprint.h>
+
+#include <json/json_parser.h>
+
+#include <fstream>
+#include <unordered_set>
+
+results_cachet::results_cachet(
+  const goto_functionst &goto_functions,
+  const std::string &configuration)
+{
+  const std::size_t configuration_hash = hash_string(configuration);
+
+  std::unordered_map<irep_idt, std::size_t> body_hashes;
+  std::unordered_map<irep_idt, std::vector<irep_idt>> callees;
+
+  for(const auto &gf_entry : goto_functions.function_map)
+  {
+    if(!gf_entry.second.body_available())
+      continue;
+
+    body_hashes[gf_entry.first] =
+      goto_program_fingerprint(gf_entry.second.body);
+
+    for(const auto &instruction : gf_entry.second.body.instructions)
+    {
+      if(!instruction.is_function_call())
+        continue;
+
+      const exprt &function = instruction.get_function_call().function();
+      if(function.id() == ID_symbol)
+      {
+        callees[gf_entry.first].push_back(
+          to_symbol_expr(function).get_identifier());
+      }
+    }
+  }
+
+  // The key of a function combines its body with those of all functions it
+  // calls, directly or indirectly, in any order.
+  for(const auto &body_hash : body_hashes)
+  {
+    std::size_t callees_hash = 0;
+
+    std::unordered_set<irep_idt> reached;
+    std::vector<irep_idt> pending{body_hash.first};
+    while(!pending.empty())
+    {
+      const irep_idt function_id = pending.back();
+      pending.pop_back();
+
+      for(const auto &callee : callees[function_id])
+      {
+        if(!reached.insert(callee).second)
+          continue;
+
+        const auto callee_hash = body_hashes.find(callee);
+        callees_hash += hash_combine(
+          hash_string(id2string(callee)),
+          callee_hash == body_hashes.end() ? 0 : callee_hash->second);
+        pending.push_back(callee);
+      }
+    }
+
+    keys[body_hash.first] = hash_combine(
+      hash_combine(configuration_hash, body_hash.second), callees_hash);
+  }
+}
+
+static optionalt<ai_verifier_statust> string2status(const std::string &s)
+{
+  for(const auto status : {ai_verifier_statust::TRUE,
+                           ai_verifier_statust::FALSE_IF_REACHABLE,
+                           ai_verifier_statust::NOT_REACHABLE,
+                           ai_verifier_statust::UNKNOWN})
+  {
+    if(as_string(status) == s)
+      return status;
+  }
+
+  return {};
+}
+
+bool results_cachet::read(
+  const std::string &file_name,
+  message_handlert &message_handler)
+{
+  // there are no results on the first run
+  if(!std::ifstream(file_name))
+    return false;
+
+  messaget log(message_handler);
+  jsont json;
+
+  if(parse_json(file_name, message_handler, json))
+  {
+    log.error() << "results cache is not a valid json file" << messaget::eom;
+    return true;
+  }
+
+  if(!json.is_object() || !json["functions"].is_array())
+  {
+    log.error() << "expecting an object with an array \"functions\" in the "
+                << "results cache, but got " << json << messaget::eom;
+    return true;
+  }
+
+  for(const auto &function : to_json_array(json["functions"]))
+  {
+    const auto key = string2optional_size_t(function["key"].value);
+
+    if(
+      function["function"].value.empty() || !key.has_value() ||
+      !function["statuses"].is_array())
+    {
+      log.error() << "results cache entry must have \"function\", \"key\" "
+                  << "and \"statuses\", but got " << function << messaget::eom;
+      return true;
+    }
+
+    entryt entry{*key, {}};
+
+    for(const auto &status : to_json_array(function["statuses"]))
+    {
+      const auto s = string2status(status.value);
+      if(!s.has_value())
+      {
+        log.error() << "unknown status in results cache: " << status
+                    << messaget::eom;
+        return true;
+      }
+
+      entry.statuses.push_back(*s);
+    }
+
+    entries[function["function"].value] = std::move(entry);
+  }
+
+  return false;
+}
+
+bool results_cachet::write(
+  const std::string &file_name,
+  message_handlert &message_handler) const
+{
+  json_arrayt functions;
+
+  for(const auto &key : keys)
+  {
+    const auto entry = entries.find(key.first);
+    if(entry == entries.end() || entry->second.key != key.second)
+      continue;
+
+    json_arrayt statuses;
+    for(const auto status : entry->second.statuses)
+      statuses.push_back(json_stringt{as_string(status)});
+
+    functions.push_back(
+      json_objectt{{"function", json_stringt{key.first}},
+                   {"key", json_stringt{std::to_string(key.second)}},
+                   {"statuses", std::move(statuses)}});
+  }
+
+  std::ofstream out(file_name);
+  out << json_objectt{{"functions", std::move(functions)}} << '\n';
+
+  if(!out)
+  {
+    messaget log(message_handler);
+    log.error() << "failed to write results cache '" << file_name << "'"
+                << messaget::eom;
+    return true;
+  }
+
+  return false;
+}
+
+const std::vector<ai_verifier_statust> *
+results_cachet::lookup(const irep_idt &function_id) const
+{
+  const auto key = keys.find(function_id);
+  const auto entry = entries.find(function_id);
+
+  if(
+    key == keys.end() || entry == entries.end() ||
+    entry->second.key != key->second)
+  {
+    return nullptr;
+  }
+
+  return &entry->second.statuses;
+}
+
+void results_cachet::update(
+  const irep_idt &function_id,
+  std::vector<ai_verifier_statust> statuses)
+{
+  const auto key = keys.find(function_id);
+  PRECONDITION(key != keys.end());
+
+  entries[function_id] = entryt{key->second, std::move(statuses)};
+}
@@ -0,0 +1,71 @@
+/*******************************************************************\
+
+Module: goto-analyzer
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Verification Results cached across Runs
+
+#ifndef CPROVER_GOTO_ANALYZER_RESULTS_CACHE_H
+#define CPROVER_GOTO_ANALYZER_RESULTS_CACHE_H
+
+#include "static_verifier.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class goto_functionst;
+class message_handlert;
+
+/// The statuses of the assertions of each function found by `--verify`,
+/// stored in a file across runs of goto-analyzer on different versions of a
+/// program. The results of a function are keyed by a hash of its body, the
+/// bodies of the functions it calls, directly or indirectly, and the
+/// configuration of the analysis, so they are only reused when none of these
+/// have changed. This is sound for analyses that analyse each function on
+/// its own, i.e., `--intraprocedural`, where the results of a function do
+/// not depend on its callers.
+class results_cachet
+{
+public:
+  results_cachet(
+    const goto_functionst &goto_functions,
+    const std::string &configuration);
+
+  /// Read the results of a previous run from \p file_name, unless there is
+  /// no such file
+  /// \return true on error
+  bool read(const std::string &file_name, message_handlert &message_handler);
+
+  /// Write the results of the functions of this run to \p file_name
+  /// \return true on error
+  bool
+  write(const std::string &file_name, message_handlert &message_handler) const;
+
+  /// \return the statuses of the assertions of \p function_id in program
+  ///   order, if they are known from a previous run, or nullptr
+  const std::vector<ai_verifier_statust> *
+  lookup(const irep_idt &function_id) const;
+
+  /// Record the statuses of the assertions of \p function_id
+  void update(
+    const irep_idt &function_id,
+    std::vector<ai_verifier_statust> statuses);
+
+protected:
+  /// The key of each function with a body in this run
+  std::unordered_map<irep_idt, std::size_t> keys;
+
+  struct entryt
+  {
+    std::size_t key;
+    std::vector<ai_verifier_statust> statuses;
+  };
+  std::unordered_map<irep_idt, entryt> entries;
+};
+
+#endif // CPROVER_GOTO_ANALYZER_RESULTS_CACHE_H
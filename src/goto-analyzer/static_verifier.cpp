@@ -19,6 +19,8 @@ Author: Martin Brain, martin.brain@cs.ox.ac.uk
 
 #include <analyses/ai.h>
 
+#include "results_cache.h"
+
 /// Makes a status message string from a status.
 std::string as_string(const ai_verifier_statust &status)
 {
@@ -397,20 +399,56 @@ static void static_verifier_console(
     m.result() << '\n';
 }
 
+/// \return the strength of the verdict \p status, the higher the stronger
+static int verdict_strength(ai_verifier_statust status)
+{
+  switch(status)
+  {
+  case ai_verifier_statust::NOT_REACHABLE:
+    return 3;
+  case ai_verifier_statust::TRUE:
+    return 2;
+  case ai_verifier_statust::FALSE_IF_REACHABLE:
+    return 1;
+  case ai_verifier_statust::UNKNOWN:
+    return 0;
+  }
+
+  UNREACHABLE;
+}
+
+bool static_verifier(
+  const goto_modelt &goto_model,
+  const ai_baset &ai,
+  const optionst &options,
+  message_handlert &message_handler,
+  std::ostream &out,
+  results_cachet *results_cache)
+{
+  return static_verifier(
+    goto_model, {&ai}, options, message_handler, out, results_cache);
+}
+
 /// Runs the analyzer and then prints out the domain
 /// \param goto_model: the program analyzed
-/// \param ai: the abstract interpreter after it has been run to fix point
+/// \param ais: the abstract interpreters after they have been run to fix
+///   point
 /// \param options: the parsed user options
 /// \param message_handler: the system message handler
 /// \param out: output stream for the printing
+/// \param results_cache: if not nullptr, the results of functions not
+///   analysed by \p ais, which are updated with those of the others
 /// \return false on success with the domain printed to out
 bool static_verifier(
   const goto_modelt &goto_model,
-  const ai_baset &ai,
+  const std::vector<const ai_baset *> &ais,
   const optionst &options,
   message_handlert &message_handler,
-  std::ostream &out)
+  std::ostream &out,
+  results_cachet *results_cache)
 {
+  PRECONDITION(!ais.empty());
+
   std::size_t pass = 0, fail = 0, unknown = 0;
 
   namespacet ns(goto_model.symbol_table);
@@ -426,15 +464,41 @@ bool static_verifier(
 
     m.progress() << "Checking " << symbol.display_name() << messaget::eom;
 
-    if(!f.second.body.has_assertion())
-      continue;
+    const std::vector<ai_verifier_statust> *cached_statuses =
+      results_cache == nullptr ? nullptr : results_cache->lookup(f.first);
+    std::vector<ai_verifier_statust> statuses;
 
     forall_goto_program_instructions(i_it, f.second.body)
     {
       if(!i_it->is_assert())
         continue;
 
-      results.push_back(static_verifier_resultt(ai, i_it, f.first, ns));
+      if(cached_statuses != nullptr)
+      {
+        INVARIANT(
+          statuses.size() < cached_statuses->size(),
+          "an unchanged function has the same assertions");
+        results.push_back(static_verifier_resultt(
+          (*cached_statuses)[statuses.size()], i_it, f.first));
+      }
+      else
+      {
+        results.push_back(
+          static_verifier_resultt(*ais.front(), i_it, f.first, ns));
+
+        for(auto it = std::next(ais.begin()); it != ais.end(); ++it)
+        {
+          static_verifier_resultt result(**it, i_it, f.first, ns);
+          if(
+            verdict_strength(result.status) >
+            verdict_strength(results.back().status))
+          {
+            results.back() = std::move(result);
+          }
+        }
+      }
+
+      statuses.push_back(results.back().status);
 
       switch(results.back().status)
       {
@@ -454,6 +518,13 @@ bool static_verifier(
         UNREACHABLE;
       }
     }
+
+    if(
+      results_cache != nullptr && cached_statuses == nullptr &&
+      f.second.body_available())
+    {
+      results_cache->update(f.first, std::move(statuses));
+    }
   }
 
   if(options.get_bool_option("json"))
@@ -12,6 +12,7 @@ Author: Martin Brain, martin.brain@cs.ox.ac.uk
 #include <goto-checker/properties.h>
 
 #include <iosfwd>
+#include <vector>
 
 #include <analyses/ai_history.h>
 
@@ -20,13 +21,26 @@ class ai_baset;
 class goto_modelt;
 class message_handlert;
 class optionst;
+class results_cachet;
 
 bool static_verifier(
   const goto_modelt &,
   const ai_baset &,
   const optionst &,
   message_handlert &,
-  std::ostream &);
+  std::ostream &,
+  results_cachet *results_cache = nullptr);
+
+/// Check the assertions with each of the abstract interpreters in \p ais,
+/// which are all run to fixpoint, and report the strongest verdict any of
+/// them gives for each assertion, the first one in case of a tie
+bool static_verifier(
+  const goto_modelt &,
+  const std::vector<const ai_baset *> &ais,
+  const optionst &,
+  message_handlert &,
+  std::ostream &,
+  results_cachet *results_cache = nullptr);
 
 /// Use the information from the abstract interpreter to fill out the statuses
 /// of the passed properties
@@ -78,6 +92,17 @@ public:
     irep_idt func_id,
     const namespacet &ns);
 
+  /// A result known without the abstract interpreter, so no histories
+  static_verifier_resultt(
+    ai_verifier_statust status,
+    goto_programt::const_targett assert_location,
+    irep_idt func_id)
+    : status(status),
+      source_location(assert_location->source_location),
+      function_id(func_id)
+  {
+  }
+
   jsont output_json(void) const;
   xmlt output_xml(void) const;
 };
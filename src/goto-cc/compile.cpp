@@ -13,16 +13,20 @@ Date: June 2006
 
 #include "compile.h"
 
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 
 #include <util/cmdline.h>
 #include <util/config.h>
 #include <util/file_util.h>
 #include <util/get_base_name.h>
 #include <util/prefix.h>
+#include <util/process_pool.h>
 #include <util/run.h>
+#include <util/string2int.h>
 #include <util/symbol_table_builder.h>
 #include <util/tempdir.h>
 #include <util/tempfile.h>
@@ -33,11 +37,13 @@ Date: June 2006
 #endif
 
 #include <ansi-c/ansi_c_entry_point.h>
+#include <ansi-c/ansi_c_internal_additions.h>
 #include <ansi-c/c_object_factory_parameters.h>
 
 #include <goto-programs/goto_convert_functions.h>
 #include <goto-programs/name_mangler.h>
 #include <goto-programs/read_goto_binary.h>
+#include <goto-programs/symbol_table_cache.h>
 #include <goto-programs/write_goto_binary.h>
 
 #include <langapi/language.h>
@@ -322,10 +328,10 @@ bool compilet::link(optionalt<symbol_tablet> &&symbol_table)
   convert_symbols(goto_model);
 
   // parse object files
-  for(const auto &file_name : object_files)
+  if(read_objects_and_link(
+       object_files, goto_model, log.get_message_handler()))
   {
-    if(read_object_and_link(file_name, goto_model, log.get_message_handler()))
-      return true;
+    return true;
   }
 
   // produce entry point?
@@ -373,6 +379,11 @@ optionalt<symbol_tablet> compilet::compile()
 {
   symbol_tablet symbol_table;
 
+  // the results of the workers are linked in the order of the files, which
+  // makes the result independent of the order the workers finish in
+  std::vector<optionalt<symbol_tablet>> parsed = parse_sources_in_workers();
+  auto parsed_it = parsed.begin();
+
   while(!source_files.empty())
   {
     std::string file_name=source_files.front();
@@ -383,7 +394,12 @@ optionalt<symbol_tablet> compilet::compile()
     if(echo_file_name)
       std::cout << get_base_name(file_name, false) << '\n' << std::flush;
 
-    auto file_symbol_table = parse_source(file_name);
+    optionalt<symbol_tablet> file_symbol_table;
+    if(parsed_it != parsed.end())
+      file_symbol_table = std::move(*(parsed_it++));
+
+    if(!file_symbol_table.has_value())
+      file_symbol_table = parse_source(file_name);
 
     if(!file_symbol_table.has_value())
     {
@@ -449,26 +465,32 @@ optionalt<symbol_tablet> compilet::compile()
   return std::move(symbol_table);
 }
 
-/// parses a source file (low-level parsing)
-/// \return true on error, false otherwise
-bool compilet::parse(
-  const std::string &file_name,
-  language_filest &language_files)
+std::unique_ptr<languaget>
+compilet::get_language(const std::string &file_name) const
 {
-  std::unique_ptr<languaget> languagep;
-
   // Using '-x', the type of a file can be overridden;
   // otherwise, it's guessed from the extension.
 
   if(!override_language.empty())
   {
     if(override_language=="c++" || override_language=="c++-header")
-      languagep = get_language_from_mode(ID_cpp);
+      return get_language_from_mode(ID_cpp);
     else
-      languagep = get_language_from_mode(ID_C);
+      return get_language_from_mode(ID_C);
   }
   else if(file_name != "-")
-    languagep=get_language_from_filename(file_name);
+    return get_language_from_filename(file_name);
+  else
+    return nullptr;
+}
+
+/// parses a source file (low-level parsing)
+/// \return true on error, false otherwise
+bool compilet::parse(
+  const std::string &file_name,
+  language_filest &language_files)
+{
+  std::unique_ptr<languaget> languagep = get_language(file_name);
 
   if(languagep==nullptr)
   {
@@ -620,8 +642,80 @@ bool compilet::write_bin_object_file(
 
 /// Parses and type checks a source file located at \p file_name.
 /// \return A symbol table if, and only if, parsing and type checking succeeded.
+optionalt<std::string>
+compilet::source_cache_key(const std::string &file_name) const
+{
+  std::unique_ptr<languaget> languagep = get_language(file_name);
+  if(languagep == nullptr)
+    return {};
+
+  // errors are output when the file is parsed
+  null_message_handlert null_message_handler;
+  languagep->set_message_handler(null_message_handler);
+
+#ifdef _MSC_VER
+  std::ifstream infile(widen(file_name));
+#else
+  std::ifstream infile(file_name);
+#endif
+
+  // front-ends that do not preprocess output nothing
+  std::ostringstream preprocessed;
+  if(
+    !infile || languagep->preprocess(infile, file_name, preprocessed) ||
+    preprocessed.str().empty())
+  {
+    return {};
+  }
+
+  // The preprocessed source has the contents of all headers and the effect
+  // of all defines. The names of the file and the working directory are in
+  // the source locations of the symbols.
+  std::ostringstream key;
+  key << languagep->id() << '\n'
+      << working_directory << '\n'
+      << file_name << '\n'
+      << keep_file_local << '\n'
+      << static_cast<int>(config.cpp.cpp_standard) << '\n'
+      << ansi_c_configuration_key() << '\n'
+      << preprocessed.str();
+
+  return key.str();
+}
+
 optionalt<symbol_tablet> compilet::parse_source(const std::string &file_name)
 {
+  // The symbols of a file only depend on its preprocessed source and the
+  // configuration, and can thus be reused by later runs when the environment
+  // names a directory to keep them in.
+  const char *cache_directory = getenv("GOTO_CC_CACHE");
+  optionalt<std::string> cache_key;
+  std::string cache_file_name;
+
+  if(
+    cache_directory != nullptr && *cache_directory != 0 &&
+    mode != PREPROCESS_ONLY)
+  {
+    cache_key = source_cache_key(file_name);
+    if(cache_key.has_value())
+    {
+      cache_file_name =
+        symbol_table_cache_file(cache_directory, "source", *cache_key);
+
+      symbol_tablet file_symbol_table;
+      if(!read_symbol_table_cache(
+           cache_file_name, *cache_key, file_symbol_table))
+      {
+        log.statistics() << "Reusing cached symbols of " << file_name
+                         << messaget::eom;
+        return std::move(file_symbol_table);
+      }
+    }
+  }
+
+  const std::size_t warnings_before =
+    log.get_message_handler().get_message_count(messaget::M_WARNING);
+
   language_filest language_files;
   language_files.set_message_handler(log.get_message_handler());
 
@@ -642,9 +736,104 @@ optionalt<symbol_tablet> compilet::parse_source(const std::string &file_name)
     return {};
   }
 
+  // files with warnings are not cached, as a hit would not output them
+  if(
+    cache_key.has_value() &&
+    log.get_message_handler().get_message_count(messaget::M_WARNING) ==
+      warnings_before)
+  {
+    write_symbol_table_cache(
+      cache_file_name,
+      *cache_key,
+      file_symbol_table,
+      log.get_message_handler());
+  }
+
   return std::move(file_symbol_table);
 }
 
+std::vector<optionalt<symbol_tablet>> compilet::parse_sources_in_workers()
+{
+  std::vector<optionalt<symbol_tablet>> result;
+
+#ifndef _WIN32
+  // Workers do not output anything, hence messages beyond warnings, which
+  // make a file be parsed once more, would be lost.
+  message_handlert &message_handler = log.get_message_handler();
+  if(
+    jobs <= 1 || source_files.size() <= 1 ||
+    message_handler.get_verbosity() > messaget::M_WARNING)
+  {
+    return result;
+  }
+
+  const std::vector<std::string> file_names(
+    source_files.begin(), source_files.end());
+
+  std::vector<temporary_filet> result_files;
+  result_files.reserve(file_names.size());
+  for(std::size_t i = 0; i < file_names.size(); ++i)
+    result_files.emplace_back("goto-cc", ".gb");
+
+  result.resize(file_names.size());
+
+  process_poolt workers;
+  std::size_t next = 0;
+
+  while(next < file_names.size() || workers.running() != 0)
+  {
+    if(next < file_names.size() && workers.running() < jobs)
+    {
+      const std::size_t index = next;
+      const auto parse_in_worker = [&]() {
+        message_handler.set_verbosity(0);
+        const std::size_t warnings_before =
+          message_handler.get_message_count(messaget::M_WARNING);
+
+        auto file_symbol_table = parse_source(file_names[index]);
+        if(
+          !file_symbol_table.has_value() ||
+          message_handler.get_message_count(messaget::M_WARNING) !=
+            warnings_before)
+        {
+          return 1;
+        }
+
+        std::ofstream out(result_files[index](), std::ios::binary);
+        const bool error =
+          write_goto_binary(out, *file_symbol_table, goto_functionst()) ||
+          !out.flush();
+        return error ? 1 : 0;
+      };
+
+      // if no process can be started, the remaining files are left to this
+      // one
+      if(workers.start(index, parse_in_worker))
+        next = file_names.size();
+      else
+        ++next;
+
+      continue;
+    }
+
+    const auto finished = workers.wait_for_any();
+    if(!finished.has_value())
+      break;
+
+    if(finished->exit_code == 0)
+    {
+      null_message_handlert null_message_handler;
+      auto goto_model =
+        read_goto_binary(result_files[finished->id](), null_message_handler);
+      if(goto_model.has_value())
+        result[finished->id] = std::move(goto_model->symbol_table);
+    }
+  }
+#endif
+
+  return result;
+}
+
 /// constructor
 compilet::compilet(cmdlinet &_cmdline, message_handlert &mh, bool Werror)
   : log(mh),
@@ -655,7 +844,8 @@ compilet::compilet(cmdlinet &_cmdline, message_handlert &mh, bool Werror)
       cmdline.isset("export-function-local-symbols") ||
       cmdline.isset("export-file-local-symbols")),
     file_local_mangle_suffix(
-      cmdline.isset("mangle-suffix") ? cmdline.get_value("mangle-suffix") : "")
+      cmdline.isset("mangle-suffix") ? cmdline.get_value("mangle-suffix") : ""),
+    jobs(1)
 {
   mode=COMPILE_LINK_EXECUTABLE;
   echo_file_name=false;
@@ -669,6 +859,18 @@ compilet::compilet(cmdlinet &_cmdline, message_handlert &mh, bool Werror)
          "Please use `--export-file-local-symbols` instead."
       << messaget::eom;
   }
+
+  if(cmdline.isset("jobs"))
+  {
+    const auto parsed_jobs = string2optional_size_t(cmdline.get_value("jobs"));
+    if(parsed_jobs.has_value() && *parsed_jobs >= 1)
+      jobs = *parsed_jobs;
+    else
+    {
+      log.warning() << "ignoring invalid number of jobs '"
+                    << cmdline.get_value("jobs") << "'" << messaget::eom;
+    }
+  }
 }
 
 /// cleans up temporary files
@@ -18,7 +18,10 @@ Date: June 2006
 #include <util/std_types.h>
 #include <util/symbol.h>
 
+#include <list>
 #include <map>
+#include <memory>
+#include <vector>
 
 class cmdlinet;
 class goto_functionst;
@@ -67,8 +70,20 @@ public:
   optionalt<symbol_tablet> compile();
   bool link(optionalt<symbol_tablet> &&symbol_table);
 
+  /// Parse and type check a source file. When the environment variable
+  /// GOTO_CC_CACHE names a directory, the resulting symbols are stored there,
+  /// keyed on the preprocessed source and the configuration, and reused for
+  /// a file with the same key.
   optionalt<symbol_tablet> parse_source(const std::string &);
 
+  /// Parse and type check the source files in up to \ref jobs worker
+  /// processes at a time. A worker that fails or warns leaves its file to be
+  /// parsed once more by this process, which outputs the messages.
+  /// \return the symbol table of each source file, in the order of
+  ///   \ref source_files, nothing for the files left to this process; empty
+  ///   if workers are not used
+  std::vector<optionalt<symbol_tablet>> parse_sources_in_workers();
+
   /// Writes the goto functions of \p src_goto_model to a binary format object
   /// file.
   /// \param file_name: Target file to serialize \p src_goto_model to
@@ -116,8 +131,18 @@ protected:
   /// \brief String to include in all mangled names
   const std::string file_local_mangle_suffix;
 
+  /// \brief Number of source files to parse and type check concurrently
+  std::size_t jobs;
+
   static std::size_t function_body_count(const goto_functionst &);
 
+  /// \return the front-end for \p file_name, if any
+  std::unique_ptr<languaget> get_language(const std::string &file_name) const;
+
+  /// \return everything the symbols of \p file_name depend on, nothing if
+  ///   it cannot be preprocessed
+  optionalt<std::string> source_cache_key(const std::string &file_name) const;
+
   bool write_bin_object_file(
     const std::string &file_name,
     const goto_modelt &src_goto_model)
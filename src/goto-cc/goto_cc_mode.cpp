@@ -67,6 +67,8 @@ void goto_cc_modet::help()
   " --print-rejected-preprocessed-source file\n"
   "                             copy failing (preprocessed) source to file\n"
   " --object-bits               number of bits used for object addresses\n"
+  " --jobs #                    parse and type check up to # source files\n"
+  "                             concurrently\n"
   "\n";
   // clang-format on
 }
@@ -6,6 +6,7 @@
 #define CPROVER_GOTO_CC_LINKER_SCRIPT_MERGE_H
 
 #include <functional>
+#include <list>
 #include <map>
 
 #include <util/message.h>
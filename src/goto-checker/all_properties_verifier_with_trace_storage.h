@@ -48,14 +48,26 @@ public:
       if(options.get_bool_option("trace"))
       {
         message_building_error_trace(log);
+        std::vector<irep_idt> failed_property_ids;
         for(const auto &property_id : result.updated_properties)
         {
           if(properties.at(property_id).status == property_statust::FAIL)
-          {
-            // get correctly truncated error trace for property and store it
-            (void)traces.insert(
-              incremental_goto_checker.build_trace(property_id));
-          }
+            failed_property_ids.push_back(property_id);
+        }
+
+        // all properties that failed in this iteration fail in one model,
+        // so a single trace yields all of theirs as prefixes
+        if(failed_property_ids.size() > 1)
+        {
+          failed_property_ids = traces.insert_prefixes(
+            incremental_goto_checker.build_full_trace(), failed_property_ids);
+        }
+
+        for(const auto &property_id : failed_property_ids)
+        {
+          // get correctly truncated error trace for property and store it
+          (void)traces.insert(
+            incremental_goto_checker.build_trace(property_id));
         }
       }
 
@@ -72,6 +84,7 @@ public:
       const trace_optionst trace_options(options);
       output_properties_with_traces(
         properties, traces, trace_options, iterations, ui_message_handler);
+      output_binary_traces(properties, traces, options);
     }
     else
     {
@@ -13,6 +13,7 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include <iostream>
 
+#include <goto-programs/binary_goto_trace.h>
 #include <goto-programs/graphml_witness.h>
 #include <goto-programs/json_goto_trace.h>
 #include <goto-programs/xml_goto_trace.h>
@@ -21,16 +22,24 @@ Author: Daniel Kroening, Peter Schrammel
 #include <goto-symex/memory_model_pso.h>
 #include <goto-symex/slice.h>
 #include <goto-symex/symex_target_equation.h>
+#include <goto-symex/symmetry_breaking.h>
+#include <goto-symex/word_level_preprocessing.h>
 
 #include <linking/static_lifetime_init.h>
 
 #include <solvers/decision_procedure.h>
 
+#include <util/byte_operators.h>
+#include <util/config.h>
+#include <util/json_binary.h>
 #include <util/json_stream.h>
 #include <util/make_unique.h>
+#include <util/phase_profile.h>
+#include <util/pointer_expr.h>
 #include <util/ui_message.h>
 
 #include "goto_symex_property_decider.h"
+#include "goto_trace_storage.h"
 #include "symex_bmc.h"
 
 void message_building_error_trace(messaget &log)
@@ -114,16 +123,16 @@ void output_graphml(
   if(graphml.empty())
     return;
 
-  graphml_witnesst graphml_witness(ns);
-  graphml_witness(goto_trace);
+  std::ofstream file;
+  if(graphml != "-")
+    file.open(graphml);
+  std::ostream &out = graphml == "-" ? std::cout : file;
 
-  if(graphml == "-")
-    write_graphml(graphml_witness.graph(), std::cout);
-  else
-  {
-    std::ofstream out(graphml);
-    write_graphml(graphml_witness.graph(), out);
-  }
+  // the witness is written as it is generated
+  graphml_witnesst graphml_witness(ns);
+  graphml_writert writer(out, graphml_witness.graph().key_values);
+  graphml_witness(goto_trace, writer);
+  writer.finish();
 }
 
 /// outputs a proof in graphml format
@@ -136,15 +145,54 @@ void output_graphml(
   if(graphml.empty())
     return;
 
-  graphml_witnesst graphml_witness(ns);
-  graphml_witness(symex_target_equation);
+  std::ofstream file;
+  if(graphml != "-")
+    file.open(graphml);
+  std::ostream &out = graphml == "-" ? std::cout : file;
 
-  if(graphml == "-")
-    write_graphml(graphml_witness.graph(), std::cout);
-  else
+  graphml_witnesst graphml_witness(
+    ns, options.get_bool_option("graphml-compact-proof"));
+  graphml_writert writer(out, graphml_witness.graph().key_values);
+  graphml_witness(symex_target_equation, writer);
+  writer.finish();
+}
+
+void output_binary_trace(
+  const goto_tracet &goto_trace,
+  const namespacet &ns,
+  const optionst &options)
+{
+  const std::string filename = options.get_option("binary-trace");
+  if(filename.empty())
+    return;
+
+  std::ofstream out(filename, std::ios::binary);
+  binary_json_writert writer(out);
+  write_binary_trace(writer, ns, goto_trace, trace_optionst(options));
+}
+
+void output_binary_traces(
+  const propertiest &properties,
+  const goto_trace_storaget &traces,
+  const optionst &options)
+{
+  const std::string filename = options.get_option("binary-trace");
+  if(filename.empty())
+    return;
+
+  std::ofstream out(filename, std::ios::binary);
+  binary_json_writert writer(out);
+  const trace_optionst trace_options(options);
+  for(const auto &property_pair : properties)
   {
-    std::ofstream out(graphml);
-    write_graphml(graphml_witness.graph(), out);
+    if(property_pair.second.status == property_statust::FAIL)
+    {
+      write_binary_trace(
+        writer,
+        traces.get_namespace(),
+        traces[property_pair.first],
+        trace_options);
+    }
   }
 }
 
@@ -164,16 +212,24 @@ get_memory_model(const optionst &options, const namespacet &ns)
 {
   const std::string mm = options.get_option("mm");
 
+  std::unique_ptr<memory_model_baset> memory_model;
+
   if(mm.empty() || mm == "sc")
-    return util_make_unique<memory_model_sct>(ns);
+    memory_model = util_make_unique<memory_model_sct>(ns);
   else if(mm == "tso")
-    return util_make_unique<memory_model_tsot>(ns);
+    memory_model = util_make_unique<memory_model_tsot>(ns);
   else if(mm == "pso")
-    return util_make_unique<memory_model_psot>(ns);
+    memory_model = util_make_unique<memory_model_psot>(ns);
   else
   {
     throw "invalid memory model '" + mm + "': use one of sc, tso, pso";
   }
+
+  memory_model->set_lazy(options.get_bool_option("mm-lazy"));
+  memory_model->set_prune_read_from(
+    options.get_bool_option("mm-prune-read-from"));
+
+  return memory_model;
 }
 
 void setup_symex(
@@ -205,7 +261,12 @@ void slice(
   messaget msg(ui_message_handler);
 
   // any properties to check at all?
-  if(symex_target_equation.has_threads())
+  if(symex_target_equation.is_streaming())
+  {
+    msg.statistics() << "no slicing as the equation has been converted"
+                     << messaget::eom;
+  }
+  else if(symex_target_equation.has_threads())
   {
     // we should build a thread-aware SSA slicer
     msg.statistics() << "no slicing due to threads" << messaget::eom;
@@ -229,6 +290,23 @@ void slice(
                          << " assignments" << messaget::eom;
       }
     }
+
+    if(options.get_bool_option("word-level-preprocessing"))
+    {
+      msg.statistics() << "word-level preprocessing simplified "
+                       << word_level_preprocessing(symex_target_equation, ns)
+                       << " steps" << messaget::eom;
+    }
+
+    if(options.get_bool_option("deduplicate-steps"))
+    {
+      const std::size_t removed = deduplicate_SSA_steps(symex_target_equation);
+      if(removed != 0)
+      {
+        msg.statistics() << "deduplication removed " << removed << " steps"
+                         << messaget::eom;
+      }
+    }
   }
   msg.statistics() << "Generated " << symex.get_total_vccs() << " VCC(s), "
                    << symex.get_remaining_vccs()
@@ -332,6 +410,9 @@ void postprocess_equation(
   {
     std::unique_ptr<memory_model_baset> memory_model =
       get_memory_model(options, ns);
+    // the memory model constrains the whole equation, hence replace any lazy
+    // constraints of an earlier, shorter version of it
+    equation.lazy_constraints.clear();
     (*memory_model)(equation, ui_message_handler);
   }
 
@@ -341,6 +422,25 @@ void postprocess_equation(
 
   slice(symex, equation, ns, options, ui_message_handler);
 
+  // later steps could break the symmetries, as could other threads
+  if(
+    options.get_bool_option("symmetry-breaking") && !equation.is_streaming() &&
+    !equation.has_threads() && !options.is_set("incremental-loop") &&
+    !options.get_bool_option("incremental-loops"))
+  {
+    log.statistics() << "symmetry breaking ordered "
+                     << break_array_symmetries(equation) << " arrays"
+                     << messaget::eom;
+  }
+
+  if(
+    options.get_bool_option("compact-object-bits") &&
+    !equation.is_streaming() && !options.is_set("incremental-loop") &&
+    !options.get_bool_option("incremental-loops"))
+  {
+    compact_object_bits(equation, ui_message_handler);
+  }
+
   if(options.get_bool_option("validate-ssa-equation"))
   {
     symex.validate(validation_modet::INVARIANT);
@@ -354,12 +454,103 @@ void postprocess_equation(
                << postprocess_equation_runtime.count() << "s" << messaget::eom;
 }
 
+/// Add the objects that \ref pointer_logict assigns numbers to when
+/// converting the address of \p expr to \p objects
+static void collect_addressed_objects(
+  const exprt &expr,
+  std::unordered_set<exprt, irep_hash> &objects)
+{
+  if(expr.id() == ID_index)
+    collect_addressed_objects(to_index_expr(expr).array(), objects);
+  else if(expr.id() == ID_member)
+    collect_addressed_objects(to_member_expr(expr).compound(), objects);
+  else if(expr.id() == ID_if)
+  {
+    collect_addressed_objects(to_if_expr(expr).true_case(), objects);
+    collect_addressed_objects(to_if_expr(expr).false_case(), objects);
+  }
+  else if(
+    expr.id() == ID_byte_extract_little_endian ||
+    expr.id() == ID_byte_extract_big_endian)
+  {
+    collect_addressed_objects(to_byte_extract_expr(expr).op(), objects);
+  }
+  else if(expr.id() == ID_typecast)
+    collect_addressed_objects(to_typecast_expr(expr).op(), objects);
+  else
+    objects.insert(expr);
+}
+
+void compact_object_bits(
+  const symex_target_equationt &equation,
+  message_handlert &message_handler)
+{
+  std::unordered_set<exprt, irep_hash> objects;
+  bool has_constant_address = false;
+
+  const auto collect = [&](const exprt &expr) {
+    expr.visit_pre([&](const exprt &e) {
+      if(e.id() == ID_address_of)
+        collect_addressed_objects(to_address_of_expr(e).object(), objects);
+      else if(e.id() == ID_object_address)
+        objects.insert(to_object_address_expr(e).object_expr());
+      else if(
+        e.id() == ID_constant && e.type().id() == ID_pointer &&
+        e.operands().empty() && to_constant_expr(e).get_value() != ID_NULL &&
+        !to_constant_expr(e).value_is_zero_string())
+      {
+        has_constant_address = true;
+      }
+    });
+  };
+
+  for(const auto &step : equation.SSA_steps)
+  {
+    if(step.ignore)
+      continue;
+
+    collect(step.guard);
+    collect(step.cond_expr);
+    for(const auto &arg : step.io_args)
+      collect(arg);
+    for(const auto &arg : step.ssa_function_arguments)
+      collect(arg);
+  }
+
+  messaget log(message_handler);
+
+  if(has_constant_address)
+  {
+    log.warning() << "keeping " << config.bv_encoding.object_bits
+                  << " object bits as the program uses constant addresses"
+                  << messaget::eom;
+    return;
+  }
+
+  // the null and the invalid object come first
+  const std::size_t number_of_objects = objects.size() + 2;
+  std::size_t object_bits = 1;
+  while((std::size_t(1) << object_bits) < number_of_objects)
+    ++object_bits;
+
+  if(object_bits >= config.ansi_c.pointer_width)
+    return;
+
+  log.status() << "Using " << object_bits << " instead of "
+               << config.bv_encoding.object_bits << " object bits for "
+               << number_of_objects << " objects" << messaget::eom;
+
+  config.bv_encoding.object_bits = object_bits;
+}
+
 std::chrono::duration<double> prepare_property_decider(
   propertiest &properties,
   symex_target_equationt &equation,
   goto_symex_property_decidert &property_decider,
   ui_message_handlert &ui_message_handler)
 {
+  phase_profile_scopet phase_profile_scope("convert equation");
+
   auto solver_start = std::chrono::steady_clock::now();
 
   messaget log(ui_message_handler);
@@ -373,6 +564,7 @@ std::chrono::duration<double> prepare_property_decider(
   property_decider.update_properties_goals_from_symex_target_equation(
     properties);
   property_decider.convert_goals();
+  property_decider.set_split_candidates();
 
   auto solver_stop = std::chrono::steady_clock::now();
   return std::chrono::duration<double>(solver_stop - solver_start);
@@ -386,6 +578,8 @@ void run_property_decider(
   std::chrono::duration<double> solver_runtime,
   bool set_pass)
 {
+  phase_profile_scopet phase_profile_scope("solve");
+
   auto solver_start = std::chrono::steady_clock::now();
 
   messaget log(ui_message_handler);
@@ -394,20 +588,35 @@ void run_property_decider(
     << property_decider.get_decision_procedure().decision_procedure_text()
     << messaget::eom;
 
-  property_decider.add_constraint_from_goals(
-    [&properties](const irep_idt &property_id) {
-      return is_property_to_check(properties.at(property_id).status);
-    });
+  const auto is_unresolved = [&properties](const irep_idt &property_id) {
+    return is_property_to_check(properties.at(property_id).status);
+  };
 
   auto const sat_solver_start = std::chrono::steady_clock::now();
 
-  decision_proceduret::resultt dec_result = property_decider.solve();
+  // the properties that exhaust their budgets are decided together
+  optionalt<decision_proceduret::resultt> budget_result =
+    property_decider.decide_with_budgets(
+      properties, result.updated_properties, is_unresolved, set_pass);
+
+  decision_proceduret::resultt dec_result;
+  if(budget_result.has_value())
+    dec_result = *budget_result;
+  else
+  {
+    property_decider.add_constraint_from_goals(is_unresolved);
+    dec_result = property_decider.solve_batched(is_unresolved);
+  }
 
   auto const sat_solver_stop = std::chrono::steady_clock::now();
   std::chrono::duration<double> sat_solver_runtime =
     std::chrono::duration<double>(sat_solver_stop - sat_solver_start);
   log.status() << "Runtime Solver: " << sat_solver_runtime.count() << "s"
                << messaget::eom;
+  log.statistics()
+    << "Solver calls: "
+    << property_decider.get_decision_procedure().get_number_of_solver_calls()
+    << messaget::eom;
 
   property_decider.update_properties_status_from_goals(
     properties, result.updated_properties, dec_result, set_pass);
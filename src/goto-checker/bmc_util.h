@@ -22,6 +22,7 @@ Author: Daniel Kroening, Peter Schrammel
 
 class decision_proceduret;
 class goto_symex_property_decidert;
+class goto_trace_storaget;
 class goto_tracet;
 class memory_model_baset;
 class message_handlert;
@@ -64,6 +65,20 @@ void output_graphml(
   const namespacet &,
   const optionst &);
 
+/// Writes \p goto_trace in the compact binary trace format to the file
+/// given by the option "binary-trace", if any
+void output_binary_trace(
+  const goto_tracet &goto_trace,
+  const namespacet &ns,
+  const optionst &options);
+
+/// Writes the traces of all failed \p properties in the compact binary trace
+/// format to the file given by the option "binary-trace", if any
+void output_binary_traces(
+  const propertiest &properties,
+  const goto_trace_storaget &traces,
+  const optionst &options);
+
 std::unique_ptr<memory_model_baset>
 get_memory_model(const optionst &options, const namespacet &);
 
@@ -91,6 +106,15 @@ void postprocess_equation(
   const namespacet &ns,
   ui_message_handlert &ui_message_handler);
 
+/// Set the number of bits that pointers use for the object number to the
+/// minimum that the objects whose address \p equation takes need. This must
+/// happen before any pointer is converted, and the equation must not be
+/// extended later on. Nothing is done if \p equation contains constant
+/// addresses, as their simplification depends on the number of object bits.
+void compact_object_bits(
+  const symex_target_equationt &equation,
+  message_handlert &message_handler);
+
 /// Output a coverage report as generated by \ref symex_coveraget
 /// if \p cov_out is non-empty.
 /// \param cov_out: file to write the report to; no report is generated
@@ -177,29 +201,87 @@ void run_property_decider(
   "(show-goto-symex-steps)" \
   "(show-points-to-sets)" \
   "(slice-formula)" \
+  "(word-level-preprocessing)" \
+  "(deduplicate-steps)" \
+  "(compact-object-bits)" \
+  "(symmetry-breaking)" \
   "(unwinding-assertions)" \
   "(no-unwinding-assertions)" \
   "(no-pretty-names)" \
   "(no-self-loops-to-assumptions)" \
   "(partial-loops)" \
   "(paths):" \
+  "(paths-jobs):" \
+  "(property-jobs):" \
+  "(property-conflict-budget):" \
+  "(stream-equation)" \
+  "(memory-budget):" \
+  "(symex-checkpoint):" \
+  "(symex-checkpoint-interval):" \
+  "(resume):" \
+  "(dump-equation):" \
+  "(solve-equation):" \
+  "(property-cache):" \
   "(show-symex-strategies)" \
   "(depth):" \
   "(unwind):" \
   "(max-field-sensitivity-array-size):" \
   "(no-array-field-sensitivity)" \
   "(graphml-witness):" \
+  "(graphml-compact-proof)" \
+  "(binary-trace):" \
   "(unwindset):" \
   "(symex-complexity-limit):" \
   "(symex-complexity-failed-child-loops-limit):" \
+  "(symex-complexity-adaptive)" \
   "(incremental-loop):" \
+  "(incremental-loops)" \
   "(unwind-min):" \
   "(unwind-max):" \
+  "(unwind-step):" \
   "(ignore-properties-before-unwind-min)" \
+  "(k-induction)" \
   "(symex-cache-dereferences)" \
+  "(symex-simplify-cache-size):" \
+  "(symex-rename-cache-size):" \
+  "(symex-function-summaries)" \
 
 #define HELP_BMC \
   " --paths [strategy]           explore paths one at a time\n" \
+  " --paths-jobs n               with --paths, decide paths using n worker\n" \
+  "                              processes while exploring further paths\n" \
+  " --property-jobs n            decide the properties in n groups, each\n" \
+  "                              using its own worker process\n" \
+  " --property-conflict-budget n decide the properties one at a time, each\n" \
+  "                              with n conflicts of the SAT solver, and\n" \
+  "                              retry those exceeding it with increasing\n" \
+  "                              budgets after the others\n" \
+  " --stream-equation            pass each step of the program expression\n" \
+  "                              to the solver as soon as it is generated,\n" \
+  "                              which disables slicing (not with --paths\n" \
+  "                              or --incremental-loop)\n" \
+  " --memory-budget MB           once the memory use approaches MB\n" \
+  "                              megabytes, write the parts of the program\n" \
+  "                              expression only needed for traces to a\n" \
+  "                              temporary file\n" \
+  " --symex-checkpoint file      periodically write the program expression\n" \
+  "                              generated so far to file\n" \
+  " --symex-checkpoint-interval s\n" \
+  "                              write a checkpoint every s seconds\n" \
+  "                              (default: 600)\n" \
+  " --resume file                decide the properties on the program\n" \
+  "                              expression read from the checkpoint file\n" \
+  "                              instead of running symbolic execution\n" \
+  " --dump-equation file         write the program expression, once sliced,\n" \
+  "                              and the properties to file instead of\n" \
+  "                              deciding them\n" \
+  " --solve-equation file        decide the properties with the program\n" \
+  "                              expression written by --dump-equation for\n" \
+  "                              the same program\n" \
+  " --property-cache file        do not decide properties that passed on\n" \
+  "                              the same slice of the program expression\n" \
+  "                              in an earlier run with this file, and add\n" \
+  "                              those passing in this run to it\n" \
   " --show-symex-strategies      list strategies for use with --paths\n" \
   " --show-goto-symex-steps      show which steps symex travels, includes\n" \
   "                              diagnostic information\n" \
@@ -224,18 +306,41 @@ void run_property_decider(
   " --incremental-loop L         check properties after each unwinding\n" \
   "                              of loop L\n" \
   "                              (use --show-loops to get the loop IDs)\n" \
-  " --unwind-min nr              start incremental-loop after nr unwindings\n" \
+  " --incremental-loops          check properties whenever any loop reaches\n" \
+  "                              an unwinding not reached before, unwinding\n" \
+  "                              all loops incrementally in lockstep\n" \
+  " --unwind-min nr              start incremental-loop(s) after nr\n" \
+  "                              unwindings\n" \
   "                              but before solving that iteration. If for\n" \
   "                              example it is 1, then the loop will be\n" \
   "                              unwound once, and immediately checked.\n" \
   "                              Note: this means for min-unwind 1 or\n"\
   "                              0 all properties are checked.\n" \
-  " --unwind-max nr              stop incremental-loop after nr unwindings\n" \
+  " --unwind-max nr              stop incremental-loop(s) after nr\n" \
+  "                              unwindings\n" \
+  " --unwind-step nr             with incremental-loop(s), check the\n" \
+  "                              properties only after every nr\n" \
+  "                              unwindings, starting from unwind-min\n" \
+  "                              (default: 1)\n" \
   " --ignore-properties-before-unwind-min\n" \
   "                              do not check properties before unwind-min\n" \
   "                              when using incremental-loop\n" \
+  " --k-induction                with --incremental-loop, also try to prove\n" \
+  "                              the properties within the loop by\n" \
+  "                              k-induction\n" \
   " --show-vcc                   show the verification conditions\n" \
   " --slice-formula              remove assignments unrelated to property\n" \
+  " --word-level-preprocessing   substitute symbols defined to be constants\n" \
+  "                              or other symbols and simplify the formula\n" \
+  "                              before passing it to the solver\n" \
+  " --deduplicate-steps          do not pass assignments, assumptions and\n" \
+  "                              constraints that occur earlier in the\n" \
+  "                              formula to the solver once more\n" \
+  " --compact-object-bits        use only as many bits for the object part\n" \
+  "                              of pointers as the objects need\n" \
+  " --symmetry-breaking          order the elements of arrays that the\n" \
+  "                              formula treats alike, which permutes them\n" \
+  "                              in traces\n" \
   " --unwinding-assertions       generate unwinding assertions (cannot be\n" \
   "                              used with --cover or --partial-loops)\n" \
   " --partial-loops              permit paths with partial loops\n" \
@@ -250,8 +355,29 @@ void run_property_decider(
   "                              iteration are allowed to fail due to\n" \
   "                              complexity violations before the loop\n" \
   "                              gets blacklisted\n" \
+  " --symex-complexity-adaptive  with --symex-complexity-limit, also limit\n" \
+  "                              how much an iteration of a loop may grow\n" \
+  "                              the equation without reaching new\n" \
+  "                              instructions, adapting the limit of each\n" \
+  "                              loop to the iterations seen so far\n" \
   " --graphml-witness filename   write the witness in GraphML format to filename\n" /* NOLINT(*) */ \
-  " --symex-cache-dereferences   enable caching of repeated dereferences" \
+  " --graphml-compact-proof      write a correctness witness with one node per\n" \
+  "                              program location rather than one per step\n" \
+  " --binary-trace filename      write the traces of failed properties in a\n" \
+  "                              compact binary format to filename, which\n" \
+  "                              --binary-trace-to-json converts to JSON\n" \
+  " --symex-cache-dereferences   enable caching of repeated dereferences\n" \
+  " --symex-simplify-cache-size N\n" \
+  "                              memoize the simplified form of at most N\n" \
+  "                              expressions during symex (default 65536,\n" \
+  "                              0 to disable)\n" \
+  " --symex-rename-cache-size N\n" \
+  "                              memoize the renaming of at most N\n" \
+  "                              expressions during symex (default 65536,\n" \
+  "                              0 to disable)\n" \
+  " --symex-function-summaries   reuse the return value of calls of\n" \
+  "                              functions without side effects on the\n" \
+  "                              same constant arguments\n" \
 // clang-format on
 
 #endif // CPROVER_GOTO_CHECKER_BMC_UTIL_H
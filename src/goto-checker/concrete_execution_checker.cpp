@@ -0,0 +1,221 @@
+/*******************************************************************\
+
+Module: Goto Checker using Concrete Execution before Symbolic Execution
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Goto Checker using Concrete Execution before Symbolic Execution
+
+#include "concrete_execution_checker.h"
+
+#include <iterator>
+
+#include <util/options.h>
+#include <util/ui_message.h>
+
+#include <goto-programs/abstract_goto_model.h>
+#include <goto-programs/interpreter_class.h>
+
+#include <solvers/prop/prop.h>
+
+concrete_execution_checkert::concrete_execution_checkert(
+  const optionst &options,
+  ui_message_handlert &ui_message_handler,
+  abstract_goto_modelt &goto_model)
+  : incremental_goto_checkert(options, ui_message_handler),
+    goto_model(goto_model),
+    symex_checker(options, ui_message_handler, goto_model),
+    concrete_runs(options.get_unsigned_int_option("concrete-runs")),
+    concrete_steps(options.get_unsigned_int_option("concrete-steps")),
+    runs_done(0),
+    last_result_concrete(false),
+    symex_started(false)
+{
+}
+
+incremental_goto_checkert::resultt concrete_execution_checkert::
+operator()(propertiest &properties)
+{
+  if(runs_done < concrete_runs)
+  {
+    resultt result = run_concretely(properties);
+    if(result.progress == resultt::progresst::FOUND_FAIL)
+      return result;
+  }
+
+  return run_symex(properties);
+}
+
+incremental_goto_checkert::resultt
+concrete_execution_checkert::run_concretely(propertiest &properties)
+{
+  resultt result(resultt::progresst::DONE);
+
+  while(runs_done < concrete_runs && has_properties_to_check(properties))
+  {
+    // each run on inputs of its own, reproducibly
+    std::mt19937_64 random(runs_done);
+    ++runs_done;
+
+    null_message_handlert null_message_handler;
+    interpretert interpreter(
+      goto_model.get_symbol_table(),
+      goto_model.get_goto_functions(),
+      null_message_handler);
+    interpreter.run(random, concrete_steps);
+
+    for(const auto &step : interpreter.get_trace().steps)
+    {
+      if(!step.is_assert() || step.cond_value)
+        continue;
+
+      auto property_it = properties.find(step.property_id);
+      if(
+        property_it == properties.end() ||
+        !is_property_to_check(property_it->second.status))
+      {
+        continue;
+      }
+
+      property_it->second.status = property_statust::FAIL;
+      concrete_failures.insert(step.property_id);
+      result.updated_properties.insert(step.property_id);
+    }
+
+    if(!result.updated_properties.empty())
+    {
+      log.status() << "Concrete run " << runs_done << " failed "
+                   << result.updated_properties.size() << " properties"
+                   << messaget::eom;
+      concrete_trace = interpreter.get_trace();
+      last_result_concrete = true;
+      result.progress = resultt::progresst::FOUND_FAIL;
+      return result;
+    }
+  }
+
+  // no more runs to come
+  runs_done = concrete_runs;
+  return result;
+}
+
+incremental_goto_checkert::resultt
+concrete_execution_checkert::run_symex(propertiest &properties)
+{
+  last_result_concrete = false;
+
+  // Symbolic execution checks the properties that failed concretely as well,
+  // but with its own statuses for them: a bounded model check may well
+  // not reach the failure that the run has shown.
+  if(!symex_started)
+  {
+    symex_properties = properties;
+    for(const auto &property_id : concrete_failures)
+      symex_properties.at(property_id).status = property_statust::NOT_CHECKED;
+    symex_started = true;
+  }
+
+  resultt symex_result = symex_checker(symex_properties);
+
+  resultt result(symex_result.progress);
+  for(const auto &property_id : symex_result.updated_properties)
+  {
+    if(concrete_failures.count(property_id) != 0)
+      continue;
+
+    const property_infot &property_info = symex_properties.at(property_id);
+    auto emplace_result = properties.emplace(property_id, property_info);
+    if(!emplace_result.second)
+      emplace_result.first->second = property_info;
+    result.updated_properties.insert(property_id);
+  }
+
+  return result;
+}
+
+template <typename predicatet>
+goto_tracet concrete_execution_checkert::truncated_trace(
+  predicatet is_failure,
+  bool first) const
+{
+  goto_tracet::stepst::const_iterator end = concrete_trace.steps.end();
+  for(auto it = concrete_trace.steps.begin(); it != concrete_trace.steps.end();
+      ++it)
+  {
+    if(it->is_assert() && !it->cond_value && is_failure(*it))
+    {
+      end = std::next(it);
+      if(first)
+        break;
+    }
+  }
+
+  goto_tracet result;
+  result.steps.assign(concrete_trace.steps.begin(), end);
+  return result;
+}
+
+goto_tracet concrete_execution_checkert::build_full_trace() const
+{
+  if(!last_result_concrete)
+    return symex_checker.build_full_trace();
+
+  return truncated_trace(
+    [this](const goto_trace_stept &step) {
+      return concrete_failures.count(step.property_id) != 0;
+    },
+    false);
+}
+
+goto_tracet concrete_execution_checkert::build_shortest_trace() const
+{
+  if(!last_result_concrete)
+    return symex_checker.build_shortest_trace();
+
+  return truncated_trace(
+    [this](const goto_trace_stept &step) {
+      return concrete_failures.count(step.property_id) != 0;
+    },
+    true);
+}
+
+goto_tracet
+concrete_execution_checkert::build_trace(const irep_idt &property_id) const
+{
+  if(!last_result_concrete || concrete_failures.count(property_id) == 0)
+    return symex_checker.build_trace(property_id);
+
+  return truncated_trace(
+    [&property_id](const goto_trace_stept &step) {
+      return step.property_id == property_id;
+    },
+    true);
+}
+
+const namespacet &concrete_execution_checkert::get_namespace() const
+{
+  return symex_checker.get_namespace();
+}
+
+void concrete_execution_checkert::output_error_witness(
+  const goto_tracet &error_trace)
+{
+  symex_checker.output_error_witness(error_trace);
+}
+
+void concrete_execution_checkert::output_proof()
+{
+  symex_checker.output_proof();
+}
+
+void concrete_execution_checkert::report()
+{
+  log.statistics() << "Concrete runs: " << runs_done << ", properties failed: "
+                   << concrete_failures.size() << messaget::eom;
+
+  if(symex_started)
+    symex_checker.report();
+}
@@ -0,0 +1,86 @@
+/*******************************************************************\
+
+Module: Goto Checker using Concrete Execution before Symbolic Execution
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Goto Checker using Concrete Execution before Symbolic Execution
+
+#ifndef CPROVER_GOTO_CHECKER_CONCRETE_EXECUTION_CHECKER_H
+#define CPROVER_GOTO_CHECKER_CONCRETE_EXECUTION_CHECKER_H
+
+#include <goto-programs/goto_trace.h>
+
+#include "goto_trace_provider.h"
+#include "incremental_goto_checker.h"
+#include "multi_path_symex_checker.h"
+#include "witness_provider.h"
+
+class abstract_goto_modelt;
+
+/// Runs the program with the interpreter on random inputs a number of times
+/// (`--concrete-runs`), each for at most `--concrete-steps` steps, and
+/// reports the assertions that fail in these runs, with the runs as their
+/// traces. Shallow bugs are thus found without building an equation at all.
+/// The remaining properties are then checked by a
+/// \ref multi_path_symex_checkert.
+class concrete_execution_checkert : public incremental_goto_checkert,
+                                    public goto_trace_providert,
+                                    public witness_providert
+{
+public:
+  concrete_execution_checkert(
+    const optionst &options,
+    ui_message_handlert &ui_message_handler,
+    abstract_goto_modelt &goto_model);
+
+  /// \copydoc incremental_goto_checkert::operator()(propertiest &properties)
+  resultt operator()(propertiest &) override;
+
+  goto_tracet build_full_trace() const override;
+  goto_tracet build_shortest_trace() const override;
+  goto_tracet build_trace(const irep_idt &) const override;
+  const namespacet &get_namespace() const override;
+
+  void output_error_witness(const goto_tracet &) override;
+  void output_proof() override;
+
+  void report() override;
+
+protected:
+  abstract_goto_modelt &goto_model;
+  multi_path_symex_checkert symex_checker;
+
+  std::size_t concrete_runs;
+  std::size_t concrete_steps;
+
+  /// The number of concrete runs done so far
+  std::size_t runs_done;
+
+  /// Whether the last result was produced by a concrete run, whose trace
+  /// is \ref concrete_trace, rather than by \ref symex_checker
+  bool last_result_concrete;
+  goto_tracet concrete_trace;
+
+  /// The properties that failed in a concrete run
+  std::unordered_set<irep_idt> concrete_failures;
+
+  /// The properties as seen by \ref symex_checker, in which those in
+  /// \ref concrete_failures have not been checked
+  propertiest symex_properties;
+  bool symex_started;
+
+  resultt run_concretely(propertiest &);
+  resultt run_symex(propertiest &);
+
+  /// \return \ref concrete_trace up to and including the failure of the
+  ///   assertion for which \p is_failure holds: the first one if \p first,
+  ///   else the last one
+  template <typename predicatet>
+  goto_tracet truncated_trace(predicatet is_failure, bool first) const;
+};
+
+#endif // CPROVER_GOTO_CHECKER_CONCRETE_EXECUTION_CHECKER_H
@@ -0,0 +1,332 @@
+/*******************************************************************\
+
+Module: Goto Verifier Distributing Properties to Worker Processes
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Goto Verifier Distributing Properties to Worker Processes
+
+#include "distributed_verifier.h"
+
+#include <util/exception_utils.h>
+#include <util/options.h>
+#include <util/process_pool.h>
+#include <util/tempfile.h>
+#include <util/ui_message.h>
+
+#include <goto-programs/abstract_goto_model.h>
+
+#include <json/json_parser.h>
+
+#include "report_util.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <unordered_set>
+
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+distributed_verifiert::distributed_verifiert(
+  const optionst &options,
+  ui_message_handlert &ui_message_handler,
+  abstract_goto_modelt &goto_model,
+  json_objectt job_template)
+  : goto_verifiert(options, ui_message_handler),
+    job_template(std::move(job_template)),
+    retries(
+      options.is_set("coordinator-retries")
+        ? options.get_unsigned_int_option("coordinator-retries")
+        : 2)
+{
+  properties = initialize_properties(goto_model);
+
+  const std::string workers_file = options.get_option("coordinate");
+  std::ifstream in(workers_file);
+  if(!in)
+  {
+    throw invalid_command_line_argument_exceptiont(
+      "failed to open worker file '" + workers_file + "'", "--coordinate");
+  }
+
+  // one worker command per line, # starts a comment
+  std::string line;
+  while(std::getline(in, line))
+  {
+    if(!line.empty() && line[0] != '#')
+      workers.push_back(line);
+  }
+
+  if(workers.empty())
+  {
+    throw invalid_command_line_argument_exceptiont(
+      "no worker commands in '" + workers_file + "'", "--coordinate");
+  }
+
+  number_of_jobs = options.is_set("coordinator-jobs")
+                     ? options.get_unsigned_int_option("coordinator-jobs")
+                     : 2 * workers.size();
+}
+
+std::vector<distributed_verifiert::jobt>
+distributed_verifiert::make_jobs() const
+{
+  std::vector<irep_idt> property_ids;
+  for(const auto &property_pair : properties)
+  {
+    if(is_property_to_check(property_pair.second.status))
+      property_ids.push_back(property_pair.first);
+  }
+
+  const std::size_t jobs_size =
+    std::max<std::size_t>(1, std::min(number_of_jobs, property_ids.size()));
+
+  // as in multi_path_symex_checkert::decide_property_groups, properties of
+  // the same function end up in one job as properties are sorted by id
+  std::vector<jobt> jobs;
+  for(std::size_t job = 0; job < jobs_size && !property_ids.empty(); ++job)
+  {
+    jobs.emplace_back();
+    jobs.back().property_ids.assign(
+      property_ids.begin() + job * property_ids.size() / jobs_size,
+      property_ids.begin() + (job + 1) * property_ids.size() / jobs_size);
+  }
+
+  return jobs;
+}
+
+std::string distributed_verifiert::job_input(const jobt &job) const
+{
+  json_objectt input = job_template;
+
+  json_objectt &job_options = to_json_object(input["options"]);
+  json_arrayt &job_properties = job_options["property"].make_array();
+  for(const auto &property_id : job.property_ids)
+    job_properties.push_back(json_stringt{property_id});
+  job_options["json-ui"] = json_truet();
+
+  std::ostringstream out;
+  out << input << '\n';
+  return out.str();
+}
+
+/// \return the property status whose \ref as_string is \p status, if any
+static optionalt<property_statust> status_from_string(const std::string &status)
+{
+  for(const auto candidate : {property_statust::NOT_CHECKED,
+                              property_statust::UNKNOWN,
+                              property_statust::NOT_REACHABLE,
+                              property_statust::PASS,
+                              property_statust::FAIL,
+                              property_statust::ERROR})
+  {
+    if(as_string(candidate) == status)
+      return candidate;
+  }
+
+  return {};
+}
+
+bool distributed_verifiert::apply_job_output(
+  const jobt &job,
+  const std::string &output)
+{
+  std::istringstream in(output);
+  jsont json;
+  null_message_handlert null_message_handler;
+
+  if(parse_json(in, "", null_message_handler, json) || !json.is_array())
+    return true;
+
+  const std::unordered_set<irep_idt> job_ids(
+    job.property_ids.begin(), job.property_ids.end());
+  std::unordered_set<irep_idt> decided;
+
+  for(const auto &message : to_json_array(json))
+  {
+    if(!message.is_object() || !message["result"].is_array())
+      continue;
+
+    for(const auto &result : to_json_array(message["result"]))
+    {
+      const irep_idt property_id = result["property"].value;
+      const auto status = status_from_string(result["status"].value);
+
+      if(job_ids.count(property_id) != 0 && status.has_value())
+      {
+        properties.at(property_id).status = *status;
+        decided.insert(property_id);
+      }
+    }
+  }
+
+  return decided.size() != job_ids.size();
+}
+
+void distributed_verifiert::job_failed(
+  jobt &job,
+  std::size_t job_index,
+  std::size_t worker,
+  std::deque<std::size_t> &pending)
+{
+  ++job.failures;
+  job.failed_worker = worker;
+
+  if(job.failures <= retries)
+  {
+    log.warning() << "Job " << job_index << " failed on worker '"
+                  << workers[worker] << "', retrying" << messaget::eom;
+    pending.push_back(job_index);
+    return;
+  }
+
+  log.error() << "Job " << job_index << " failed " << job.failures
+              << " times, giving up on its " << job.property_ids.size()
+              << " properties" << messaget::eom;
+
+  for(const auto &property_id : job.property_ids)
+    properties.at(property_id).status = property_statust::ERROR;
+}
+
+#ifndef _WIN32
+namespace
+{
+/// A job running in a worker process
+struct running_jobt
+{
+  explicit running_jobt(std::size_t job_index)
+    : job_index(job_index), input("coordinator_job_", ".json")
+  {
+  }
+
+  std::size_t job_index;
+  temporary_filet input;
+};
+} // namespace
+
+/// Run \p command by the shell, with standard input from the file \p input
+/// \return only if \p command cannot be run
+static int run_worker(const std::string &command, const std::string &input)
+{
+  const int input_fd = open(input.c_str(), O_RDONLY);
+  if(input_fd < 0)
+    return 127;
+
+  dup2(input_fd, STDIN_FILENO);
+  close(input_fd);
+
+  execl("/bin/sh", "sh", "-c", command.c_str(), static_cast<char *>(nullptr));
+  return 127;
+}
+#endif
+
+resultt distributed_verifiert::operator()()
+{
+  std::vector<jobt> jobs = make_jobs();
+
+  log.status() << "Distributing the properties in " << jobs.size()
+               << " jobs to " << workers.size() << " workers" << messaget::eom;
+
+#ifdef _WIN32
+  log.error() << "--coordinate is not supported on Windows" << messaget::eom;
+
+  for(const auto &job : jobs)
+  {
+    for(const auto &property_id : job.property_ids)
+      properties.at(property_id).status = property_statust::ERROR;
+  }
+#else
+  std::deque<std::size_t> pending;
+  for(std::size_t job_index = 0; job_index < jobs.size(); ++job_index)
+    pending.push_back(job_index);
+
+  // the jobs running on the workers, by the index of the worker, which is
+  // the identifier of its process
+  std::map<std::size_t, running_jobt> running;
+  process_poolt worker_processes;
+
+  while(!pending.empty() || !running.empty())
+  {
+    // start pending jobs on idle workers, preferring other workers than
+    // the one that a job failed on last
+    for(auto pending_it = pending.begin(); pending_it != pending.end();)
+    {
+      jobt &job = jobs[*pending_it];
+
+      optionalt<std::size_t> worker;
+      for(std::size_t w = 0; w < workers.size(); ++w)
+      {
+        if(running.count(w) != 0)
+          continue;
+
+        if(job.failures == 0 || w != job.failed_worker)
+        {
+          worker = w;
+          break;
+        }
+
+        if(!worker.has_value())
+          worker = w;
+      }
+
+      if(!worker.has_value())
+        break;
+
+      const std::size_t job_index = *pending_it;
+      pending_it = pending.erase(pending_it);
+
+      const running_jobt &new_job =
+        running.emplace(*worker, job_index).first->second;
+
+      std::ofstream(new_job.input()) << job_input(job);
+
+      const std::string &command = workers[*worker];
+      const std::string input = new_job.input();
+      if(worker_processes.start(
+           *worker, [&]() { return run_worker(command, input); }, true))
+      {
+        running.erase(*worker);
+        job_failed(job, job_index, *worker, pending);
+        // start the retry in the next round
+        break;
+      }
+    }
+
+    if(running.empty())
+      continue;
+
+    const auto finished = worker_processes.wait_for_any();
+    if(!finished.has_value())
+      throw system_exceptiont("failed to wait for worker processes");
+
+    const std::size_t worker = finished->id;
+    const std::size_t job_index = running.at(worker).job_index;
+    running.erase(worker);
+
+    jobt &job = jobs[job_index];
+    if(apply_job_output(job, finished->output))
+      job_failed(job, job_index, worker, pending);
+    else
+    {
+      log.status() << "Job " << job_index << " of "
+                   << job.property_ids.size() << " properties done by '"
+                   << workers[worker] << "'" << messaget::eom;
+    }
+  }
+#endif
+
+  return determine_result(properties);
+}
+
+void distributed_verifiert::report()
+{
+  output_properties(properties, 1, ui_message_handler);
+  output_overall_result(determine_result(properties), ui_message_handler);
+}
@@ -0,0 +1,88 @@
+/*******************************************************************\
+
+Module: Goto Verifier Distributing Properties to Worker Processes
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Goto Verifier Distributing Properties to Worker Processes
+
+#ifndef CPROVER_GOTO_CHECKER_DISTRIBUTED_VERIFIER_H
+#define CPROVER_GOTO_CHECKER_DISTRIBUTED_VERIFIER_H
+
+#include <util/json.h>
+
+#include "goto_verifier.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+class abstract_goto_modelt;
+
+/// Coordinates the checking of the properties by worker processes, which
+/// may run on other nodes of a cluster. The properties are partitioned into
+/// `--coordinator-jobs` jobs. Each job is a command line in the format of
+/// \ref json_interface: the given \p job_template, the command line of the
+/// coordinator, with the properties of the job added. A job is written to
+/// the standard input of one of the worker commands listed in the file
+/// given by `--coordinate`, such as `ssh node1 cbmc --json-interface`, and
+/// the statuses of its properties are taken from the JSON UI output of the
+/// worker. Each worker runs one job at a time. A job whose worker fails is
+/// retried on another worker, `--coordinator-retries` times at most, and its
+/// properties are ERROR if all attempts fail. Traces are not collected: a
+/// failing property needs to be checked on its own to get its trace.
+class distributed_verifiert : public goto_verifiert
+{
+public:
+  distributed_verifiert(
+    const optionst &options,
+    ui_message_handlert &ui_message_handler,
+    abstract_goto_modelt &goto_model,
+    json_objectt job_template);
+
+  resultt operator()() override;
+  void report() override;
+
+protected:
+  json_objectt job_template;
+
+  /// The commands that start a worker reading a job from its standard input
+  std::vector<std::string> workers;
+
+  std::size_t number_of_jobs;
+  std::size_t retries;
+
+  struct jobt
+  {
+    std::vector<irep_idt> property_ids;
+    std::size_t failures = 0;
+    /// The worker of the last failed attempt, which is not chosen again
+    /// while other workers are idle
+    std::size_t failed_worker = 0;
+  };
+
+  /// \return the jobs for the properties to be checked
+  std::vector<jobt> make_jobs() const;
+
+  /// \return the command line of \p job in the format of \ref json_interface
+  std::string job_input(const jobt &job) const;
+
+  /// Take the statuses of the properties of \p job from the JSON UI
+  /// \p output of a worker
+  /// \return true if there was no result for some property of \p job
+  bool apply_job_output(const jobt &job, const std::string &output);
+
+  /// Record that \p job failed on \p worker, and retry it by adding
+  /// \p job_index to \p pending unless it has failed too often, in which case
+  /// its properties are ERROR
+  void job_failed(
+    jobt &job,
+    std::size_t job_index,
+    std::size_t worker,
+    std::deque<std::size_t> &pending);
+};
+
+#endif // CPROVER_GOTO_CHECKER_DISTRIBUTED_VERIFIER_H
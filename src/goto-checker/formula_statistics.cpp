@@ -0,0 +1,117 @@
+/*******************************************************************\
+
+Module: Source Lines Contributing Most to the Formula
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Source Lines Contributing Most to the Formula
+
+#include "formula_statistics.h"
+
+#include <util/message.h>
+
+#include <goto-symex/symex_target_equation.h>
+
+#include <solvers/decision_procedure.h>
+#include <solvers/flattening/boolbv_width.h>
+#include <solvers/hardness_collector.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct line_statisticst
+{
+  source_locationt source_location;
+  std::size_t ssa_steps = 0;
+  std::size_t bit_width = 0;
+  std::size_t clauses = 0;
+  std::size_t literals = 0;
+};
+} // namespace
+
+void output_formula_statistics(
+  const symex_target_equationt &equation,
+  decision_proceduret &decision_procedure,
+  const namespacet &ns,
+  std::size_t top,
+  messaget &log)
+{
+  const auto aggregation = solver_hardnesst::aggregationt::SOURCE_LINE;
+  std::map<std::string, line_statisticst> lines;
+
+  const boolbv_widtht boolbv_width(ns);
+  for(const auto &step : equation.SSA_steps)
+  {
+    if(step.ignore)
+      continue;
+
+    const source_locationt &source_location = step.source.pc->source_location;
+    auto entry = lines.emplace(
+      solver_hardnesst::aggregation_key(source_location, aggregation),
+      line_statisticst{});
+    line_statisticst &line = entry.first->second;
+    if(entry.second)
+      line.source_location = source_location;
+
+    ++line.ssa_steps;
+    if(step.is_assignment())
+      line.bit_width += boolbv_width(step.ssa_lhs.type());
+  }
+
+  bool have_clauses = false;
+  with_solver_hardness(decision_procedure, [&](solver_hardnesst &hardness) {
+    for(const auto &entry : hardness.get_aggregated_stats())
+    {
+      auto line_entry = lines.emplace(entry.first, line_statisticst{});
+      line_statisticst &line = line_entry.first->second;
+      if(line_entry.second)
+        line.source_location = entry.second.source_location;
+      line.clauses += entry.second.clauses;
+      line.literals += entry.second.literals;
+      have_clauses = have_clauses || entry.second.clauses != 0;
+    }
+  });
+
+  std::vector<const line_statisticst *> ranking;
+  ranking.reserve(lines.size());
+  for(const auto &entry : lines)
+    ranking.push_back(&entry.second);
+
+  std::stable_sort(
+    ranking.begin(),
+    ranking.end(),
+    [](const line_statisticst *a, const line_statisticst *b) {
+      if(a->clauses != b->clauses)
+        return a->clauses > b->clauses;
+      return a->bit_width > b->bit_width;
+    });
+  if(ranking.size() > top)
+    ranking.resize(top);
+
+  log.status() << "Source lines contributing most to the formula"
+               << (have_clauses ? "" : " (no clause counts, by bit width)")
+               << ":\n"
+               << std::setw(10) << "SSA steps" << std::setw(12) << "bit width"
+               << std::setw(12) << "clauses" << std::setw(12) << "literals"
+               << "  location";
+  for(const auto line : ranking)
+  {
+    const source_locationt &source_location = line->source_location;
+    log.status() << '\n'
+                 << std::setw(10) << line->ssa_steps << std::setw(12)
+                 << line->bit_width << std::setw(12) << line->clauses
+                 << std::setw(12) << line->literals << "  "
+                 << source_location.get_file() << ':'
+                 << source_location.get_line() << ' '
+                 << source_location.get_function();
+  }
+  log.status() << messaget::eom;
+}
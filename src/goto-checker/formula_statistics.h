@@ -0,0 +1,35 @@
+/*******************************************************************\
+
+Module: Source Lines Contributing Most to the Formula
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Source Lines Contributing Most to the Formula
+
+#ifndef CPROVER_GOTO_CHECKER_FORMULA_STATISTICS_H
+#define CPROVER_GOTO_CHECKER_FORMULA_STATISTICS_H
+
+#include <cstddef>
+
+class decision_proceduret;
+class messaget;
+class namespacet;
+class symex_target_equationt;
+
+/// Print a table of the \p top source lines with the most clauses in the
+/// formula, with their SSA steps, the bit width of the variables they
+/// assign, and their clauses and literals. The clauses and literals are
+/// those collected by the solver hardness of \p decision_procedure, by
+/// source line (see `--solver-stats-by`); without them, the lines are
+/// ranked by bit width.
+void output_formula_statistics(
+  const symex_target_equationt &equation,
+  decision_proceduret &decision_procedure,
+  const namespacet &ns,
+  std::size_t top,
+  messaget &log);
+
+#endif // CPROVER_GOTO_CHECKER_FORMULA_STATISTICS_H
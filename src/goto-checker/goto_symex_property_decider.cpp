@@ -11,16 +11,28 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include "goto_symex_property_decider.h"
 
+#include <algorithm>
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/magic.h>
+#include <util/simplify_expr.h>
 #include <util/ui_message.h>
 
+#include <solvers/prop/cube_splitter.h>
+#include <solvers/prop/literal_expr.h>
 #include <solvers/prop/prop.h>
+#include <solvers/stack_decision_procedure.h>
 
 goto_symex_property_decidert::goto_symex_property_decidert(
   const optionst &options,
   ui_message_handlert &ui_message_handler,
   symex_target_equationt &equation,
   const namespacet &ns)
-  : options(options), ui_message_handler(ui_message_handler), equation(equation)
+  : options(options),
+    ui_message_handler(ui_message_handler),
+    equation(equation),
+    ns(ns)
 {
   solver_factoryt solvers(
     options,
@@ -77,11 +89,98 @@ void goto_symex_property_decidert::convert_goals()
     goal_pair.second.condition = solver->decision_procedure().handle(
       not_exprt(goal_pair.second.as_expr()));
   }
+
+  selectors_added = false;
+}
+
+propt *goto_symex_property_decidert::selector_solver() const
+{
+  propt *prop = solver->prop_ptr.get();
+
+  if(
+    prop == nullptr || !prop->has_set_assumptions() ||
+    !prop->has_is_in_conflict() ||
+    dynamic_cast<stack_decision_proceduret *>(&solver->decision_procedure()) ==
+      nullptr)
+  {
+    return nullptr;
+  }
+
+  for(const auto &goal_pair : goal_map)
+  {
+    const exprt &condition = goal_pair.second.condition;
+    if(condition.id() != ID_literal && !condition.is_constant())
+      return nullptr;
+  }
+
+  return prop;
+}
+
+void goto_symex_property_decidert::set_split_candidates() const
+{
+  auto cube_splitter = dynamic_cast<cube_splittert *>(solver->prop_ptr.get());
+  if(cube_splitter == nullptr)
+    return;
+
+  bvt candidates;
+  std::unordered_set<literalt::var_not> seen;
+  const auto add_candidate = [&candidates, &seen](const exprt &handle) {
+    if(handle.id() != ID_literal)
+      return;
+    const literalt l = to_literal_expr(handle).get_literal();
+    if(!l.is_constant() && seen.insert(l.var_no()).second)
+      candidates.push_back(l);
+  };
+
+  for(const auto &step : equation.SSA_steps)
+  {
+    add_candidate(step.guard_handle);
+    if(step.is_goto())
+      add_candidate(step.cond_handle);
+  }
+
+  cube_splitter->set_split_candidates(candidates);
 }
 
 void goto_symex_property_decidert::add_constraint_from_goals(
   std::function<bool(const irep_idt &)> select_property)
 {
+  selector_assumptions.clear();
+
+  if(propt *prop = selector_solver())
+  {
+    if(!selectors_added)
+    {
+      exprt::operandst disjuncts;
+      for(auto &goal_pair : goal_map)
+      {
+        goalt &goal = goal_pair.second;
+        if(goal.condition.is_false())
+          continue;
+
+        goal.selector = prop->new_variable();
+        disjuncts.push_back(literal_exprt(prop->land(
+          goal.selector, to_literal_expr(goal.condition).get_literal())));
+      }
+
+      // this is 'false' if there are no disjuncts
+      solver->decision_procedure().set_to_true(disjunction(disjuncts));
+      selectors_added = true;
+    }
+
+    for(const auto &goal_pair : goal_map)
+    {
+      const literalt selector = goal_pair.second.selector;
+      if(!selector.is_constant())
+      {
+        selector_assumptions.push_back(literal_exprt(
+          select_property(goal_pair.first) ? selector : !selector));
+      }
+    }
+
+    return;
+  }
+
   exprt::operandst disjuncts;
 
   for(const auto &goal_pair : goal_map)
@@ -100,7 +199,274 @@ void goto_symex_property_decidert::add_constraint_from_goals(
 
 decision_proceduret::resultt goto_symex_property_decidert::solve()
 {
-  return solver->decision_procedure()();
+  messaget log(ui_message_handler);
+  std::size_t added = 0;
+  std::size_t iterations = 0;
+
+  while(true)
+  {
+    decision_proceduret::resultt result;
+    if(selector_assumptions.empty())
+      result = solver->decision_procedure()();
+    else
+    {
+      // this only drops the assumptions, the solution remains available, and
+      // lazy constraints are then added in the enclosing context
+      solver->stack_decision_procedure().push(selector_assumptions);
+      result = solver->decision_procedure()();
+      solver->stack_decision_procedure().pop();
+    }
+
+    if(result != decision_proceduret::resultt::D_SATISFIABLE)
+      return result;
+
+    const std::size_t violated = add_violated_lazy_constraints();
+    if(violated == 0)
+    {
+      if(iterations != 0)
+      {
+        log.statistics() << "Added " << added << " of "
+                         << equation.lazy_constraints.size()
+                         << " lazy constraints in " << iterations
+                         << " iterations" << messaget::eom;
+      }
+
+      return result;
+    }
+
+    added += violated;
+    ++iterations;
+  }
+}
+
+decision_proceduret::resultt goto_symex_property_decidert::solve_batched(
+  std::function<bool(const irep_idt &)> select_property)
+{
+  // batching requires assumptions to be able to relax the target
+  auto stack_decision_procedure =
+    dynamic_cast<stack_decision_proceduret *>(&solver->decision_procedure());
+
+  if(
+    !options.get_bool_option("cover-batching") ||
+    stack_decision_procedure == nullptr)
+  {
+    return solve();
+  }
+
+  exprt::operandst goals;
+  for(const auto &goal_pair : goal_map)
+  {
+    if(
+      select_property(goal_pair.first) &&
+      !goal_pair.second.condition.is_false())
+    {
+      goals.push_back(goal_pair.second.condition);
+    }
+  }
+
+  // start with half of the goals, and keep the target that worked last time
+  if(batch_target == 0)
+    batch_target = (goals.size() + 1) / 2;
+  batch_target = std::min(batch_target, goals.size());
+
+  while(batch_target > 1)
+  {
+    const unsignedbv_typet count_type(address_bits(goals.size() + 1));
+
+    exprt::operandst summands;
+    summands.reserve(goals.size());
+    for(const auto &goal : goals)
+      summands.push_back(typecast_exprt(goal, count_type));
+
+    const binary_relation_exprt at_least_target(
+      plus_exprt(std::move(summands), count_type),
+      ID_ge,
+      from_integer(batch_target, count_type));
+
+    stack_decision_procedure->push(
+      {solver->decision_procedure().handle(at_least_target)});
+    const decision_proceduret::resultt result = solve();
+    // this only drops the assumption, the solution remains available
+    stack_decision_procedure->pop();
+
+    if(result != decision_proceduret::resultt::D_UNSATISFIABLE)
+      return result;
+
+    batch_target /= 2;
+  }
+
+  return solve();
+}
+
+std::size_t goto_symex_property_decidert::add_violated_lazy_constraints()
+{
+  decision_proceduret &decision_procedure = solver->decision_procedure();
+  std::size_t violated = 0;
+
+  for(const auto &constraint : equation.lazy_constraints)
+  {
+    // constraints that refer to symbols unknown to the solver do not
+    // evaluate to a constant and are added as well
+    if(!simplify_expr(decision_procedure.get(constraint), ns).is_true())
+    {
+      decision_procedure.set_to_true(constraint);
+      ++violated;
+    }
+  }
+
+  return violated;
+}
+
+void goto_symex_property_decidert::update_unselected_properties_from_conflict(
+  propertiest &properties,
+  std::unordered_set<irep_idt> &updated_properties) const
+{
+  propt *prop = selector_solver();
+  if(prop == nullptr)
+    return;
+
+  // an unselected goal whose negated selector is not part of the final
+  // conflict cannot be reached either
+  for(const auto &goal_pair : goal_map)
+  {
+    const literalt selector = goal_pair.second.selector;
+    auto &status = properties.at(goal_pair.first).status;
+    if(
+      selector.is_constant() || !is_property_to_check(status) ||
+      std::find(
+        selector_assumptions.begin(),
+        selector_assumptions.end(),
+        literal_exprt(!selector)) == selector_assumptions.end() ||
+      prop->is_in_conflict(!selector))
+    {
+      continue;
+    }
+
+    status = property_statust::PASS;
+    updated_properties.insert(goal_pair.first);
+  }
+}
+
+/// \return the element \p i, counting from 0, of the Luby sequence
+///   1, 1, 2, 1, 1, 2, 4, 1, ...
+static std::size_t luby(std::size_t i)
+{
+  // find the finite subsequence that contains i, and its size
+  std::size_t size = 1;
+  std::size_t exponent = 0;
+  while(size < i + 1)
+  {
+    size = 2 * size + 1;
+    ++exponent;
+  }
+
+  while(size - 1 != i)
+  {
+    size = (size - 1) / 2;
+    --exponent;
+    i = i % size;
+  }
+
+  return std::size_t(1) << exponent;
+}
+
+optionalt<decision_proceduret::resultt>
+goto_symex_property_decidert::decide_with_budgets(
+  propertiest &properties,
+  std::unordered_set<irep_idt> &updated_properties,
+  std::function<bool(const irep_idt &)> select_property,
+  bool set_pass)
+{
+  const std::size_t budget =
+    options.get_unsigned_int_option("property-conflict-budget");
+  if(budget == 0)
+    return {};
+
+  messaget log(ui_message_handler);
+
+  propt *prop = selector_solver();
+  if(prop == nullptr || !prop->has_conflict_limit())
+  {
+    if(!property_schedule_initialized)
+    {
+      log.warning() << "--property-conflict-budget requires a SAT solver "
+                    << "with assumptions and conflict limits, ignoring it"
+                    << messaget::eom;
+      property_schedule_initialized = true;
+    }
+    return {};
+  }
+
+  if(!property_schedule_initialized)
+  {
+    for(const auto &goal_pair : goal_map)
+    {
+      if(
+        select_property(goal_pair.first) &&
+        !goal_pair.second.condition.is_false())
+      {
+        property_schedule.push_back({goal_pair.first, 0});
+      }
+    }
+    property_schedule_initialized = true;
+  }
+
+  while(!property_schedule.empty())
+  {
+    const scheduled_propertyt scheduled = property_schedule.front();
+    property_schedule.pop_front();
+
+    // it may have been decided by an earlier solution or conflict
+    if(
+      !select_property(scheduled.property_id) ||
+      !is_property_to_check(properties.at(scheduled.property_id).status))
+    {
+      continue;
+    }
+
+    const std::size_t limit = budget * luby(scheduled.attempts);
+    log.status() << "Deciding " << scheduled.property_id << " with at most "
+                 << limit << " conflicts" << messaget::eom;
+
+    add_constraint_from_goals([&scheduled](const irep_idt &property_id) {
+      return property_id == scheduled.property_id;
+    });
+
+    prop->set_conflict_limit(limit);
+    const decision_proceduret::resultt result = solve();
+    prop->set_conflict_limit(0);
+
+    switch(result)
+    {
+    case decision_proceduret::resultt::D_SATISFIABLE:
+      return result;
+    case decision_proceduret::resultt::D_UNSATISFIABLE:
+      if(set_pass)
+      {
+        properties.at(scheduled.property_id).status = property_statust::PASS;
+        updated_properties.insert(scheduled.property_id);
+        update_unselected_properties_from_conflict(
+          properties, updated_properties);
+      }
+      break;
+    case decision_proceduret::resultt::D_ERROR:
+      // other errors, such as timeouts, are left to the caller
+      if(!prop->reached_conflict_limit())
+      {
+        property_schedule.clear();
+        return result;
+      }
+
+      if(scheduled.attempts + 1 < PROPERTY_BUDGET_MAX_ATTEMPTS)
+      {
+        property_schedule.push_back(
+          {scheduled.property_id, scheduled.attempts + 1});
+      }
+      break;
+    }
+  }
+
+  return {};
 }
 
 decision_proceduret &
@@ -155,6 +521,8 @@ void goto_symex_property_decidert::update_properties_status_from_goals(
         updated_properties.insert(property_pair.first);
       }
     }
+
+    update_unselected_properties_from_conflict(properties, updated_properties);
     break;
   case decision_proceduret::resultt::D_ERROR:
     for(auto &property_pair : properties)
@@ -12,8 +12,12 @@ Author: Daniel Kroening, Peter Schrammel
 #ifndef CPROVER_GOTO_CHECKER_GOTO_SYMEX_PROPERTY_DECIDER_H
 #define CPROVER_GOTO_CHECKER_GOTO_SYMEX_PROPERTY_DECIDER_H
 
+#include <util/optional.h>
+
 #include <goto-symex/symex_target_equation.h>
 
+#include <deque>
+
 #include "properties.h"
 #include "solver_factory.h"
 
@@ -37,13 +41,54 @@ public:
   /// Convert the instances of a property into a goal variable
   void convert_goals();
 
-  /// Add disjunction of negated selected properties to the equation
+  /// If the solver splits the formula into cubes, pass it the guards and
+  /// branch conditions of the equation as candidates for splitting
+  void set_split_candidates() const;
+
+  /// Add disjunction of negated selected properties to the equation. With a
+  /// SAT solver that supports assumptions, each goal has a selector literal
+  /// instead, and a single disjunction of the goals and their selectors is
+  /// added. \ref solve then selects the goals by assuming their selectors,
+  /// so the same constraint serves all calls, and the final conflict of the
+  /// solver tells which of the unselected goals are unreachable as well.
   void add_constraint_from_goals(
     std::function<bool(const irep_idt &property_id)> select_property);
 
-  /// Calls solve() on the solver instance
+  /// Calls solve() on the solver instance. As long as the solution found
+  /// violates any of the lazy constraints of the equation, these are added to
+  /// the formula and the solver is called again.
   decision_proceduret::resultt solve();
 
+  /// Calls \ref solve. With `--cover-batching`, first asks the solver for a
+  /// solution that makes a target number of the goals of the properties
+  /// selected by \p select_property true, halving the target as long as no
+  /// such solution exists. Thus a single solver call may cover many goals.
+  decision_proceduret::resultt solve_batched(
+    std::function<bool(const irep_idt &property_id)> select_property);
+
+  /// With `--property-conflict-budget`, decides the properties selected by
+  /// \p select_property one at a time, each with a limited number of
+  /// conflicts of the SAT solver. A property that exhausts its budget is
+  /// tried again after all others, with budgets following the Luby sequence,
+  /// such that easy properties are decided first rather than after a hard
+  /// one. Stops at the first failing property. Properties that have been
+  /// tried PROPERTY_BUDGET_MAX_ATTEMPTS times are left to \ref solve
+  /// without limits.
+  /// \param [inout] properties: The status is updated in this data structure
+  /// \param [inout] updated_properties: The set of property IDs of
+  ///   updated properties
+  /// \param select_property: selects the properties to decide
+  /// \param set_pass: If true then update properties to PASS if the solver
+  ///   returns UNSATISFIABLE
+  /// \return D_SATISFIABLE if a property failed, D_ERROR if the solver failed
+  ///   for a reason other than the budget, which are yet to be passed to
+  ///   \ref update_properties_status_from_goals, and nothing otherwise
+  optionalt<decision_proceduret::resultt> decide_with_budgets(
+    propertiest &properties,
+    std::unordered_set<irep_idt> &updated_properties,
+    std::function<bool(const irep_idt &property_id)> select_property,
+    bool set_pass);
+
   /// Returns the solver instance
   decision_proceduret &get_decision_procedure() const;
 
@@ -69,8 +114,49 @@ protected:
   const optionst &options;
   ui_message_handlert &ui_message_handler;
   symex_target_equationt &equation;
+  const namespacet &ns;
   std::unique_ptr<solver_factoryt::solvert> solver;
 
+  /// Add the lazy constraints of the equation that the current solution of
+  /// the solver violates
+  /// \return the number of constraints added
+  std::size_t add_violated_lazy_constraints();
+
+  /// Number of goals that \ref solve_batched asks to be true at once, or 0
+  /// before its first call
+  std::size_t batch_target = 0;
+
+  /// \return the propositional solver if goals can be selected by assuming
+  ///   their selectors, nullptr otherwise
+  propt *selector_solver() const;
+
+  /// Whether the disjunction of the goals and their selectors has been added
+  /// since the goals were converted
+  bool selectors_added = false;
+
+  /// The selectors of the goals to solve for, and the negated selectors of all
+  /// other goals, which \ref solve assumes
+  std::vector<exprt> selector_assumptions;
+
+  /// Update the properties of unselected goals to PASS whose negated
+  /// selectors are not in the final conflict of an UNSATISFIABLE answer
+  void update_unselected_properties_from_conflict(
+    propertiest &properties,
+    std::unordered_set<irep_idt> &updated_properties) const;
+
+  /// A property to be decided by \ref decide_with_budgets and the number of
+  /// times its budget has been exhausted
+  struct scheduled_propertyt
+  {
+    irep_idt property_id;
+    std::size_t attempts;
+  };
+
+  /// The properties still to be decided by \ref decide_with_budgets, in the
+  /// order in which they are tried
+  std::deque<scheduled_propertyt> property_schedule;
+  bool property_schedule_initialized = false;
+
   struct goalt
   {
     /// A property holds if all instances of it are true
@@ -79,6 +165,9 @@ protected:
     /// The goal variable
     exprt condition;
 
+    /// A literal that enables the goal, see \ref add_constraint_from_goals
+    literalt selector = const_literal(false);
+
     exprt as_expr() const;
   };
 
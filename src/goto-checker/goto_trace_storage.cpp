@@ -51,6 +51,59 @@ const goto_tracet &goto_trace_storaget::insert_all(goto_tracet &&trace)
   return traces.back();
 }
 
+std::vector<irep_idt> goto_trace_storaget::insert_prefixes(
+  goto_tracet &&trace,
+  const std::vector<irep_idt> &property_ids)
+{
+  std::unordered_map<irep_idt, std::size_t> prefix_lengths;
+  for(const auto &property_id : property_ids)
+    prefix_lengths.emplace(property_id, 0);
+
+  std::size_t steps = 0;
+  std::size_t found = 0;
+  for(const auto &step : trace.steps)
+  {
+    ++steps;
+    if(step.is_assert() && !step.cond_value)
+    {
+      auto entry = prefix_lengths.find(step.property_id);
+      if(entry != prefix_lengths.end() && entry->second == 0)
+      {
+        entry->second = steps;
+        if(++found == prefix_lengths.size())
+          break;
+      }
+    }
+  }
+
+  // the steps beyond the last violation are not needed
+  trace.steps.resize(steps);
+  for(auto &step : trace.steps)
+    step.merge_ireps(merge_ireps);
+  full_traces.push_back(std::move(trace));
+
+  std::vector<irep_idt> missing;
+  for(const auto &property_id : property_ids)
+  {
+    const std::size_t prefix_length = prefix_lengths.at(property_id);
+    if(prefix_length == 0)
+    {
+      missing.push_back(property_id);
+      continue;
+    }
+
+    INVARIANT(
+      property_id_to_trace_index.count(property_id) == 0 &&
+        property_id_to_prefix.count(property_id) == 0,
+      "cannot associate more than one error trace with property " +
+        id2string(property_id));
+    property_id_to_prefix.emplace(
+      property_id, std::make_pair(full_traces.size() - 1, prefix_length));
+  }
+
+  return missing;
+}
+
 const std::list<goto_tracet> &goto_trace_storaget::all() const
 {
   return traces;
@@ -59,8 +112,23 @@ const std::list<goto_tracet> &goto_trace_storaget::all() const
 const goto_tracet &goto_trace_storaget::
 operator[](const irep_idt &property_id) const
 {
-  const auto trace_found = property_id_to_trace_index.find(property_id);
-  PRECONDITION(trace_found != property_id_to_trace_index.end());
+  auto trace_found = property_id_to_trace_index.find(property_id);
+  if(trace_found == property_id_to_trace_index.end())
+  {
+    // build the prefix of a stored trace
+    const auto prefix_found = property_id_to_prefix.find(property_id);
+    PRECONDITION(prefix_found != property_id_to_prefix.end());
+    const goto_tracet &full_trace = full_traces[prefix_found->second.first];
+
+    traces.emplace_back();
+    auto end = full_trace.steps.begin();
+    std::advance(end, prefix_found->second.second);
+    traces.back().steps.assign(full_trace.steps.begin(), end);
+    property_id_to_prefix.erase(prefix_found);
+
+    trace_found =
+      property_id_to_trace_index.emplace(property_id, traces.size() - 1).first;
+  }
   CHECK_RETURN(trace_found->second < traces.size());
 
   return *(std::next(traces.begin(), trace_found->second));
@@ -17,6 +17,8 @@ Author: Daniel Kroening, Peter Schrammel
 #include <util/merge_irep.h>
 
 #include <list>
+#include <utility>
+#include <vector>
 
 class goto_trace_storaget
 {
@@ -32,6 +34,15 @@ public:
   ///   are mapped to the given trace.
   const goto_tracet &insert_all(goto_tracet &&);
 
+  /// Store trace that violates each of \p property_ids, without copying any
+  /// part of it yet: the trace of each of these properties is the prefix of
+  /// \p trace up to the first violation of the property, which is only built
+  /// once \ref operator[] asks for it. This way a single trace serves all
+  /// properties a model of the solver violates.
+  /// \return the property IDs the trace does not contain a violation of
+  std::vector<irep_idt>
+  insert_prefixes(goto_tracet &&, const std::vector<irep_idt> &property_ids);
+
   const std::list<goto_tracet> &all() const;
   const goto_tracet &operator[](const irep_idt &property_id) const;
 
@@ -41,11 +52,19 @@ protected:
   /// the namespace related to the traces
   const namespacet &ns;
 
-  /// stores the traces
-  std::list<goto_tracet> traces;
+  /// stores the traces, including the prefixes built on demand
+  mutable std::list<goto_tracet> traces;
 
   // maps property ID to index in traces
-  std::unordered_map<irep_idt, std::size_t> property_id_to_trace_index;
+  mutable std::unordered_map<irep_idt, std::size_t> property_id_to_trace_index;
+
+  /// the traces that prefixes are built from, see \ref insert_prefixes
+  std::vector<goto_tracet> full_traces;
+
+  /// maps property ID to the index in full_traces and the number of steps of
+  /// the prefix of a trace that has not been built yet
+  mutable std::unordered_map<irep_idt, std::pair<std::size_t, std::size_t>>
+    property_id_to_prefix;
 
   /// irep container for shared ireps
   merge_irept merge_ireps;
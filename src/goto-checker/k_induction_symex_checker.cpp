@@ -0,0 +1,501 @@
+/*******************************************************************\
+
+Module: Goto Checker using k-Induction on a specified Loop
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Goto Checker using k-induction on a specified loop
+
+#include "k_induction_symex_checker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+#include <util/make_unique.h>
+
+#include <analyses/local_may_alias.h>
+
+#include <goto-instrument/loop_utils.h>
+
+#include <goto-symex/slice.h>
+
+#include "bmc_util.h"
+#include "counterexample_beautification.h"
+#include "single_loop_incremental_symex_checker.h"
+
+/// \return true if the function \p function_id is the entry point, or is
+///   called exactly once, directly from the entry point
+static bool is_entered_once(
+  const goto_functionst &goto_functions,
+  const irep_idt &function_id)
+{
+  const irep_idt entry_point = goto_functionst::entry_point();
+
+  if(function_id == entry_point)
+    return true;
+
+  std::size_t calls = 0;
+
+  for(const auto &gf_entry : goto_functions.function_map)
+  {
+    for(const auto &instruction : gf_entry.second.body.instructions)
+    {
+      if(!instruction.is_function_call())
+        continue;
+
+      const exprt &function = instruction.get_function_call().function();
+      if(
+        function.id() == ID_symbol &&
+        to_symbol_expr(function).get_identifier() == function_id)
+      {
+        if(gf_entry.first != entry_point)
+          return false;
+        ++calls;
+      }
+    }
+  }
+
+  return calls == 1;
+}
+
+/// Insert code before the loop \p loop_id that assigns nondeterministic
+/// values to all objects the loop may modify, and collect the ids of the
+/// properties within the loop in \p loop_properties.
+/// \return false if the loop cannot be found, or the step case cannot be
+///   built for it soundly, i.e., when the loop is nested, contains another
+///   loop or a function call, or may be entered more than once
+static bool build_step_case(
+  goto_functionst &goto_functions,
+  const irep_idt &loop_id,
+  std::unordered_set<irep_idt> &loop_properties,
+  messaget &log)
+{
+  for(auto &gf_entry : goto_functions.function_map)
+  {
+    goto_functionst::goto_functiont &goto_function = gf_entry.second;
+    natural_loops_mutablet natural_loops(goto_function.body);
+
+    for(const auto &loop_pair : natural_loops.loop_map)
+    {
+      const goto_programt::targett loop_head = loop_pair.first;
+      const loopt &loop = loop_pair.second;
+
+      const bool is_loop =
+        std::any_of(loop.begin(), loop.end(), [&](goto_programt::targett t) {
+          return t->is_backwards_goto() && t->get_target() == loop_head &&
+                 goto_programt::loop_id(gf_entry.first, *t) == loop_id;
+        });
+      if(!is_loop)
+        continue;
+
+      for(const auto &other : natural_loops.loop_map)
+      {
+        if(
+          other.first != loop_head && (other.second.contains(loop_head) ||
+                                       loop.contains(other.first)))
+        {
+          log.warning() << "k-induction: loop " << loop_id
+                        << " is nested with another loop" << messaget::eom;
+          return false;
+        }
+      }
+
+      if(std::any_of(loop.begin(), loop.end(), [](goto_programt::targett t) {
+           return t->is_function_call();
+         }))
+      {
+        log.warning() << "k-induction: loop " << loop_id
+                      << " contains a function call" << messaget::eom;
+        return false;
+      }
+
+      if(!is_entered_once(goto_functions, gf_entry.first))
+      {
+        log.warning() << "k-induction: function " << gf_entry.first
+                      << " may be called more than once" << messaget::eom;
+        return false;
+      }
+
+      modifiest modifies;
+      get_modifies(local_may_aliast(goto_function), loop, modifies);
+
+      for(const auto &t : loop)
+      {
+        // objects declared in the loop are not live before it
+        if(t->is_decl())
+          modifies.erase(t->decl_symbol());
+        else if(t->is_assert())
+          loop_properties.insert(t->source_location.get_property_id());
+      }
+
+      goto_programt havoc_code;
+      build_havoc_code(loop_head, modifies, havoc_code);
+      const std::size_t havoc_size = havoc_code.instructions.size();
+      goto_function.body.destructive_insert(loop_head, havoc_code);
+      const goto_programt::targett first_havoc =
+        std::prev(loop_head, havoc_size);
+
+      // jumps into the loop from outside now go via the havoc code, while
+      // the back edges still go to the loop head
+      for(auto it = goto_function.body.instructions.begin();
+          it != goto_function.body.instructions.end();
+          ++it)
+      {
+        if(loop.contains(it))
+          continue;
+
+        for(auto &target : it->targets)
+        {
+          if(target == loop_head)
+            target = first_havoc;
+        }
+      }
+
+      goto_functions.update();
+      return true;
+    }
+  }
+
+  log.warning() << "k-induction: loop " << loop_id << " not found"
+                << messaget::eom;
+  return false;
+}
+
+k_induction_symex_checkert::caset::caset(
+  const optionst &options,
+  ui_message_handlert &ui_message_handler,
+  const symbol_tablet &outer_symbol_table)
+  : ns(outer_symbol_table, symex_symbol_table),
+    equation(ui_message_handler),
+    symex(
+      ui_message_handler,
+      outer_symbol_table,
+      equation,
+      options,
+      path_storage,
+      guard_manager,
+      ui_message_handler.get_ui()),
+    property_decider(options, ui_message_handler, equation, ns)
+{
+  setup_symex(symex, ns, options, ui_message_handler);
+
+  // Freeze all symbols if we are using a prop_conv_solvert
+  prop_conv_solvert *prop_conv_solver = dynamic_cast<prop_conv_solvert *>(
+    &property_decider.get_stack_decision_procedure());
+  if(prop_conv_solver != nullptr)
+    prop_conv_solver->set_all_frozen();
+}
+
+k_induction_symex_checkert::k_induction_symex_checkert(
+  const optionst &options,
+  ui_message_handlert &ui_message_handler,
+  abstract_goto_modelt &goto_model)
+  : incremental_goto_checkert(options, ui_message_handler),
+    goto_model(goto_model),
+    base_case(options, ui_message_handler, goto_model.get_symbol_table())
+{
+  if(options.get_bool_option("ignore-properties-before-unwind-min"))
+  {
+    log.warning() << "k-induction is not supported with "
+                  << "--ignore-properties-before-unwind-min" << messaget::eom;
+  }
+  else
+  {
+    step_case_model.symbol_table = goto_model.get_symbol_table();
+    step_case_model.goto_functions.copy_from(goto_model.get_goto_functions());
+
+    if(build_step_case(
+         step_case_model.goto_functions,
+         options.get_option("incremental-loop"),
+         loop_properties,
+         log))
+    {
+      step_case = util_make_unique<caset>(
+        options, ui_message_handler, step_case_model.symbol_table);
+    }
+  }
+
+  if(!step_case)
+  {
+    log.warning() << "k-induction: only checking the base case"
+                  << messaget::eom;
+  }
+}
+
+decision_proceduret::resultt k_induction_symex_checkert::decide(
+  caset &c,
+  propertiest &properties,
+  std::unordered_set<irep_idt> &updated_properties)
+{
+  if(!c.current_equation_converted)
+  {
+    postprocess_equation(
+      c.symex, c.equation, options, c.ns, ui_message_handler);
+
+    log.status() << "converting SSA" << messaget::eom;
+    c.equation.convert_without_assertions(
+      c.property_decider.get_decision_procedure());
+
+    c.property_decider.update_properties_goals_from_symex_target_equation(
+      properties);
+
+    // We convert the assertions in a new context.
+    c.property_decider.get_stack_decision_procedure().push();
+    c.equation.convert_assertions(
+      c.property_decider.get_decision_procedure(), false);
+    c.property_decider.convert_goals();
+
+    c.current_equation_converted = true;
+  }
+
+  c.property_decider.add_constraint_from_goals(
+    [&properties](const irep_idt &property_id) {
+      return is_property_to_check(properties.at(property_id).status);
+    });
+
+  log.status()
+    << "Running "
+    << c.property_decider.get_decision_procedure().decision_procedure_text()
+    << messaget::eom;
+
+  const decision_proceduret::resultt dec_result = c.property_decider.solve();
+
+  c.property_decider.update_properties_status_from_goals(
+    properties, updated_properties, dec_result, false);
+
+  return dec_result;
+}
+
+void k_induction_symex_checkert::check_step_case(
+  propertiest &properties,
+  std::unordered_set<irep_idt> &updated_properties)
+{
+  // Only the properties that the base case has checked can be proved.
+  propertiest step_properties;
+  for(const auto &property_id : loop_properties)
+  {
+    const auto property_it = properties.find(property_id);
+    if(
+      property_it != properties.end() &&
+      property_it->second.status == property_statust::UNKNOWN)
+    {
+      step_properties.insert(*property_it);
+    }
+  }
+
+  if(step_properties.empty())
+    return;
+
+  log.status() << "Checking the step case of k-induction" << messaget::eom;
+
+  std::unordered_set<irep_idt> step_updated_properties;
+  const decision_proceduret::resultt dec_result =
+    decide(*step_case, step_properties, step_updated_properties);
+  step_case->property_decider.get_stack_decision_procedure().pop();
+
+  // From now on, the assertions of this unwinding are assumed to hold, which
+  // is what the step case of the next unwinding requires.
+  auto &equation = step_case->equation;
+  for(auto it = equation.get_SSA_step(step_case->assumed_steps);
+      it != equation.SSA_steps.end();
+      ++it)
+  {
+    if(it->is_assert() && it->converted)
+      step_case->property_decider.get_decision_procedure().set_to_true(
+        it->cond_handle);
+  }
+  step_case->assumed_steps = equation.SSA_steps.size();
+
+  if(dec_result != decision_proceduret::resultt::D_UNSATISFIABLE)
+    return;
+
+  for(const auto &property_pair : step_properties)
+  {
+    properties.at(property_pair.first).status = property_statust::PASS;
+    updated_properties.insert(property_pair.first);
+  }
+
+  log.status() << "Step case of k-induction passed" << messaget::eom;
+}
+
+incremental_goto_checkert::resultt k_induction_symex_checkert::
+operator()(propertiest &properties)
+{
+  resultt result(resultt::progresst::DONE);
+
+  std::chrono::duration<double> solver_runtime(0);
+
+  // we haven't got an equation yet
+  if(!initial_equation_generated)
+  {
+    base_case.full_equation_generated = !base_case.symex.from_entry_point_of(
+      goto_symext::get_goto_function(goto_model),
+      base_case.symex_symbol_table);
+
+    // This might add new properties such as unwinding assertions, for instance.
+    update_properties_status_from_symex_target_equation(
+      properties, result.updated_properties, base_case.equation);
+
+    if(step_case)
+    {
+      step_case->full_equation_generated =
+        !step_case->symex.from_entry_point_of(
+          goto_symext::get_goto_function(step_case_model),
+          step_case->symex_symbol_table);
+    }
+
+    initial_equation_generated = true;
+  }
+
+  while(has_properties_to_check(properties))
+  {
+    // There are NOT_CHECKED or UNKNOWN properties.
+
+    if(count_properties(properties, property_statust::UNKNOWN) > 0)
+    {
+      log.status() << "Passing problem to "
+                   << base_case.property_decider.get_decision_procedure()
+                        .decision_procedure_text()
+                   << messaget::eom;
+
+      const auto solver_start = std::chrono::steady_clock::now();
+
+      const decision_proceduret::resultt dec_result =
+        decide(base_case, properties, result.updated_properties);
+
+      if(dec_result == decision_proceduret::resultt::D_SATISFIABLE)
+      {
+        // Failing properties must not be assumed in the step case.
+        step_case.reset();
+        result.progress = resultt::progresst::FOUND_FAIL;
+      }
+      else
+      {
+        // Nothing else to do with the current set of assertions.
+        // Let's pop them.
+        base_case.property_decider.get_stack_decision_procedure().pop();
+
+        if(step_case && !step_case->full_equation_generated)
+          check_step_case(properties, result.updated_properties);
+      }
+
+      const auto solver_stop = std::chrono::steady_clock::now();
+      solver_runtime +=
+        std::chrono::duration<double>(solver_stop - solver_start);
+      log.status() << "Runtime decision procedure: " << solver_runtime.count()
+                   << "s" << messaget::eom;
+
+      // We've got a trace to report.
+      if(result.progress == resultt::progresst::FOUND_FAIL)
+        break;
+    }
+
+    // Now we are finally done.
+    if(base_case.full_equation_generated)
+    {
+      // For now, we assume that UNKNOWN properties are PASS.
+      update_status_of_unknown_properties(
+        properties, result.updated_properties);
+
+      // For now, we assume that NOT_REACHED properties are PASS.
+      update_status_of_not_checked_properties(
+        properties, result.updated_properties);
+
+      break;
+    }
+
+    if(!has_properties_to_check(properties))
+      break;
+
+    output_incremental_status(properties, log);
+
+    // We continue symbolic execution of both cases by one unwinding.
+    base_case.full_equation_generated =
+      !base_case.symex.resume(goto_symext::get_goto_function(goto_model));
+    revert_slice(base_case.equation);
+
+    // This might add new properties such as unwinding assertions, for instance.
+    update_properties_status_from_symex_target_equation(
+      properties, result.updated_properties, base_case.equation);
+
+    base_case.current_equation_converted = false;
+
+    if(step_case && !step_case->full_equation_generated)
+    {
+      step_case->full_equation_generated = !step_case->symex.resume(
+        goto_symext::get_goto_function(step_case_model));
+      revert_slice(step_case->equation);
+      step_case->current_equation_converted = false;
+    }
+  }
+
+  return result;
+}
+
+goto_tracet k_induction_symex_checkert::build_full_trace() const
+{
+  goto_tracet goto_trace;
+  build_goto_trace(
+    base_case.equation,
+    base_case.equation.SSA_steps.end(),
+    base_case.property_decider.get_decision_procedure(),
+    base_case.ns,
+    goto_trace);
+
+  return goto_trace;
+}
+
+goto_tracet k_induction_symex_checkert::build_shortest_trace() const
+{
+  if(options.get_bool_option("beautify"))
+  {
+    // NOLINTNEXTLINE(whitespace/braces)
+    counterexample_beautificationt{ui_message_handler}(
+      dynamic_cast<boolbvt &>(
+        base_case.property_decider.get_stack_decision_procedure()),
+      base_case.equation);
+  }
+
+  goto_tracet goto_trace;
+  build_goto_trace(
+    base_case.equation,
+    base_case.property_decider.get_decision_procedure(),
+    base_case.ns,
+    goto_trace);
+
+  return goto_trace;
+}
+
+goto_tracet
+k_induction_symex_checkert::build_trace(const irep_idt &property_id) const
+{
+  goto_tracet goto_trace;
+  build_goto_trace(
+    base_case.equation,
+    ssa_step_matches_failing_property(property_id),
+    base_case.property_decider.get_decision_procedure(),
+    base_case.ns,
+    goto_trace);
+
+  return goto_trace;
+}
+
+const namespacet &k_induction_symex_checkert::get_namespace() const
+{
+  return base_case.ns;
+}
+
+void k_induction_symex_checkert::output_proof()
+{
+  output_graphml(base_case.equation, base_case.ns, options);
+}
+
+void k_induction_symex_checkert::output_error_witness(
+  const goto_tracet &error_trace)
+{
+  output_graphml(error_trace, base_case.ns, options);
+}
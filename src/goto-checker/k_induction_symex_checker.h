@@ -0,0 +1,118 @@
+/*******************************************************************\
+
+Module: Goto Checker using k-Induction on a specified Loop
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Goto Checker using k-induction on a specified loop
+
+#ifndef CPROVER_GOTO_CHECKER_K_INDUCTION_SYMEX_CHECKER_H
+#define CPROVER_GOTO_CHECKER_K_INDUCTION_SYMEX_CHECKER_H
+
+#include <goto-programs/goto_model.h>
+
+#include <goto-symex/path_storage.h>
+
+#include "goto_symex_property_decider.h"
+#include "goto_trace_provider.h"
+#include "incremental_goto_checker.h"
+#include "symex_bmc_incremental_one_loop.h"
+#include "witness_provider.h"
+
+#include <memory>
+#include <unordered_set>
+
+/// Proves or refutes the properties by k-induction on the loop given by
+/// `--incremental-loop`, increasing k with each unwinding of the loop.
+///
+/// The base case is the program itself, which is unwound incrementally as by
+/// single_loop_incremental_symex_checkert, and yields the counterexamples.
+/// The step case is a copy of the program in which the objects modified by
+/// the loop are assigned nondeterministic values before the loop, so that its
+/// iterations start from an arbitrary state. Once the base case for k
+/// unwindings has passed, the assertions of the step case are checked under
+/// the assumption that they held in all previous iterations; if they cannot
+/// be violated, the properties within the loop hold for any number of
+/// iterations. Each case keeps its symex state and its solver across
+/// unwindings, and only the steps of the new unwinding are added to it.
+class k_induction_symex_checkert : public incremental_goto_checkert,
+                                   public goto_trace_providert,
+                                   public witness_providert
+{
+public:
+  k_induction_symex_checkert(
+    const optionst &options,
+    ui_message_handlert &ui_message_handler,
+    abstract_goto_modelt &goto_model);
+
+  /// \copydoc incremental_goto_checkert::operator()(propertiest &properties)
+  ///
+  /// Note: This operator can handle shrinking and expanding sets of properties
+  ///   in repeated invocations.
+  resultt operator()(propertiest &) override;
+
+  goto_tracet build_full_trace() const override;
+  goto_tracet build_trace(const irep_idt &) const override;
+  goto_tracet build_shortest_trace() const override;
+  const namespacet &get_namespace() const override;
+
+  void output_error_witness(const goto_tracet &) override;
+  void output_proof() override;
+
+protected:
+  /// Symbolic execution of one program with incremental unwinding of the
+  /// loop, and the solver deciding its equation
+  struct caset
+  {
+    caset(
+      const optionst &options,
+      ui_message_handlert &ui_message_handler,
+      const symbol_tablet &outer_symbol_table);
+
+    symbol_tablet symex_symbol_table;
+    namespacet ns;
+    symex_target_equationt equation;
+    path_fifot path_storage; // should go away
+    guard_managert guard_manager;
+    symex_bmc_incremental_one_loopt symex;
+    goto_symex_property_decidert property_decider;
+    bool full_equation_generated = false;
+    bool current_equation_converted = false;
+    /// Number of steps of `equation` whose assertions have been checked,
+    /// and are assumed from then on
+    std::size_t assumed_steps = 0;
+  };
+
+  abstract_goto_modelt &goto_model;
+  caset base_case;
+
+  /// The program of the step case
+  goto_modelt step_case_model;
+  /// The step case; null if it could not be built for the loop
+  std::unique_ptr<caset> step_case;
+  /// The properties of assertions within the loop, which are the ones
+  /// k-induction can prove
+  std::unordered_set<irep_idt> loop_properties;
+
+  bool initial_equation_generated = false;
+
+  /// Convert the equation of \p c, unless done already, and check the
+  /// properties of status UNKNOWN in \p properties. The assertions are
+  /// converted in a new solver context, which the caller pops once it is
+  /// done with them.
+  decision_proceduret::resultt decide(
+    caset &c,
+    propertiest &properties,
+    std::unordered_set<irep_idt> &updated_properties);
+
+  /// Check the step case for the current unwinding, and set the properties
+  /// within the loop to PASS if none of them can be violated
+  void check_step_case(
+    propertiest &properties,
+    std::unordered_set<irep_idt> &updated_properties);
+};
+
+#endif // CPROVER_GOTO_CHECKER_K_INDUCTION_SYMEX_CHECKER_H
@@ -11,15 +11,23 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include "multi_path_symex_checker.h"
 
+#include <algorithm>
 #include <chrono>
 
+#include <util/options.h>
+#include <util/string_utils.h>
 #include <util/ui_message.h>
 
+#include <goto-symex/slice.h>
+
 #include <solvers/hardness_collector.h>
 
 #include "bmc_util.h"
 #include "counterexample_beautification.h"
+#include "formula_statistics.h"
 #include "goto_symex_fault_localizer.h"
+#include "property_worker.h"
+#include "solver_factory.h"
 
 multi_path_symex_checkert::multi_path_symex_checkert(
   const optionst &options,
@@ -29,6 +37,20 @@ multi_path_symex_checkert::multi_path_symex_checkert(
     equation_generated(false),
     property_decider(options, ui_message_handler, equation, ns)
 {
+  if(options.is_set("memory-budget"))
+  {
+    equation.set_memory_budget(
+      options.get_unsigned_int_option("memory-budget") * 1024 * 1024);
+  }
+
+  if(options.get_bool_option("stream-equation"))
+    equation.stream_to(property_decider.get_decision_procedure());
+
+  if(options.is_set("property-cache"))
+  {
+    property_cache.emplace(
+      options.get_option("property-cache"), ui_message_handler);
+  }
 }
 
 incremental_goto_checkert::resultt multi_path_symex_checkert::
@@ -60,16 +82,120 @@ operator()(propertiest &properties)
     if(!has_properties_to_check(properties))
       return result;
 
+    if(property_cache.has_value())
+    {
+      decide_from_property_cache(properties, result);
+
+      if(!has_properties_to_check(properties))
+      {
+        equation_generated = true;
+        return result;
+      }
+    }
+
+    const std::size_t number_of_groups =
+      options.get_unsigned_int_option("property-jobs");
+    const std::string portfolio = options.get_option("solver-portfolio");
+    if(
+      (number_of_groups != 0 || !portfolio.empty()) && equation.is_streaming())
+    {
+      log.warning() << "--property-jobs and --solver-portfolio are ignored as "
+                    << "the equation has been converted while generating it"
+                    << messaget::eom;
+    }
+    else if(!portfolio.empty())
+    {
+      decide_with_portfolio(properties, result, portfolio);
+      update_property_cache(properties);
+
+      if(!has_properties_to_check(properties))
+      {
+        equation_generated = true;
+        return result;
+      }
+    }
+    else if(number_of_groups != 0)
+    {
+      decide_property_groups(properties, result, number_of_groups);
+      update_property_cache(properties);
+
+      if(!has_properties_to_check(properties))
+      {
+        equation_generated = true;
+        return result;
+      }
+    }
+
     solver_runtime += prepare_property_decider(properties);
+    equation.spill_if_over_budget();
 
     equation_generated = true;
   }
 
   run_property_decider(result, properties, solver_runtime);
+  update_property_cache(properties);
+
+  // the traces need the expressions of the steps
+  if(result.progress == resultt::progresst::FOUND_FAIL)
+    equation.restore_spilled_steps();
 
   return result;
 }
 
+void multi_path_symex_checkert::decide_from_property_cache(
+  propertiest &properties,
+  resultt &result)
+{
+  // the slice of an incomplete equation may miss assertions
+  if(!equation_complete)
+    return;
+
+  // --compact-object-bits has set the object bits by now
+  const std::string settings = property_cachet::settings(options);
+
+  std::size_t number_of_hits = 0;
+  for(auto &property_pair : properties)
+  {
+    if(!is_property_to_check(property_pair.second.status))
+      continue;
+
+    const std::string key =
+      property_cachet::key(equation, property_pair.first, settings);
+
+    if(property_cache->has_passed(key))
+    {
+      property_pair.second.status = property_statust::PASS;
+      result.updated_properties.insert(property_pair.first);
+      ++number_of_hits;
+    }
+    else
+      property_cache_keys.emplace(property_pair.first, key);
+  }
+
+  log.status() << number_of_hits << " properties passed in an earlier run"
+               << messaget::eom;
+}
+
+void multi_path_symex_checkert::update_property_cache(
+  const propertiest &properties)
+{
+  if(!property_cache.has_value())
+    return;
+
+  for(auto it = property_cache_keys.begin(); it != property_cache_keys.end();)
+  {
+    if(properties.at(it->first).status == property_statust::PASS)
+    {
+      property_cache->set_passed(it->second);
+      it = property_cache_keys.erase(it);
+    }
+    else
+      ++it;
+  }
+
+  property_cache->write();
+}
+
 std::chrono::duration<double>
 multi_path_symex_checkert::prepare_property_decider(propertiest &properties)
 {
@@ -85,7 +211,193 @@ void multi_path_symex_checkert::run_property_decider(
   std::chrono::duration<double> solver_runtime)
 {
   ::run_property_decider(
-    result, properties, property_decider, ui_message_handler, solver_runtime);
+    result,
+    properties,
+    property_decider,
+    ui_message_handler,
+    solver_runtime,
+    equation_complete);
+}
+
+void multi_path_symex_checkert::decide_property_groups(
+  propertiest &properties,
+  resultt &result,
+  std::size_t number_of_groups)
+{
+  std::vector<irep_idt> property_ids;
+  for(const auto &property_pair : properties)
+  {
+    if(is_property_to_check(property_pair.second.status))
+      property_ids.push_back(property_pair.first);
+  }
+
+  number_of_groups = std::min(number_of_groups, property_ids.size());
+  if(number_of_groups <= 1)
+    return;
+
+  log.status() << "Deciding " << property_ids.size() << " properties in "
+               << number_of_groups << " groups" << messaget::eom;
+
+  property_workerst workers(ui_message_handler);
+
+  for(std::size_t group = 0; group < number_of_groups; ++group)
+  {
+    // properties are sorted by id, hence properties of the same function,
+    // which are likely to have similar slices, end up in one group
+    const std::vector<irep_idt> group_ids(
+      property_ids.begin() + group * property_ids.size() / number_of_groups,
+      property_ids.begin() +
+        (group + 1) * property_ids.size() / number_of_groups);
+
+    workers.start(group, group_ids, [&]() -> property_updatest {
+      const std::unordered_set<irep_idt> group_id_set(
+        group_ids.begin(), group_ids.end());
+
+      symex_target_equationt group_equation(equation);
+
+      group_equation.SSA_steps.clear();
+      for(const SSA_stept &step : equation.SSA_steps)
+      {
+        if(
+          !step.is_assert() || group_id_set.count(step.get_property_id()) != 0)
+        {
+          group_equation.SSA_steps.push_back(step);
+        }
+      }
+
+      // as in ::slice, the slicer is not thread-aware
+      if(!group_equation.has_threads())
+        ::slice(group_equation);
+
+      propertiest group_properties;
+      for(const auto &property_id : group_ids)
+        group_properties.emplace(property_id, properties.at(property_id));
+
+      return decide_in_worker(options, group_equation, group_properties);
+    });
+  }
+
+  while(workers.running() != 0)
+  {
+    property_updatest updates = workers.wait_for_any().updates;
+
+    // Failing properties are left to be decided once more by this process,
+    // which provides their traces.
+    updates.erase(
+      std::remove_if(
+        updates.begin(),
+        updates.end(),
+        [](const std::pair<irep_idt, property_statust> &update) {
+          return update.second == property_statust::FAIL;
+        }),
+      updates.end());
+
+    apply_property_updates(updates, properties, result.updated_properties);
+  }
+}
+
+void multi_path_symex_checkert::decide_with_portfolio(
+  propertiest &properties,
+  resultt &result,
+  const std::string &solvers)
+{
+  const std::vector<std::string> solver_names =
+    split_string(solvers, ',', true);
+
+  // fail early on a misspelt solver rather than in a worker process
+  std::vector<optionst> solver_options(solver_names.size(), options);
+  for(std::size_t i = 0; i < solver_names.size(); ++i)
+    select_solver(solver_options[i], solver_names[i]);
+
+  log.status() << "Racing " << solver_names.size() << " solvers"
+               << messaget::eom;
+
+  std::vector<irep_idt> property_ids;
+  for(const auto &property_pair : properties)
+  {
+    if(is_property_to_check(property_pair.second.status))
+      property_ids.push_back(property_pair.first);
+  }
+
+  property_workerst workers(ui_message_handler);
+  for(std::size_t i = 0; i < solver_options.size(); ++i)
+  {
+    const optionst &worker_options = solver_options[i];
+    workers.start(i, property_ids, [&]() -> property_updatest {
+      symex_target_equationt worker_equation(equation);
+      propertiest worker_properties(properties);
+      return decide_in_worker(
+        worker_options, worker_equation, worker_properties);
+    });
+  }
+
+  while(workers.running() != 0)
+  {
+    property_workerst::finishedt finished = workers.wait_for_any();
+
+    // a solver that failed, e.g., as it is not installed, does not decide
+    // the race unless all others fail as well
+    if(finished.failed && workers.running() != 0)
+    {
+      log.warning() << "Solver " << solver_names[finished.id] << " failed"
+                    << messaget::eom;
+      continue;
+    }
+
+    log.status() << "Solver " << solver_names[finished.id] << " finished first"
+                 << messaget::eom;
+
+    // Failing properties are left to be decided once more by this process,
+    // which provides their traces.
+    property_updatest &updates = finished.updates;
+    updates.erase(
+      std::remove_if(
+        updates.begin(),
+        updates.end(),
+        [](const std::pair<irep_idt, property_statust> &update) {
+          return update.second == property_statust::FAIL;
+        }),
+      updates.end());
+
+    apply_property_updates(updates, properties, result.updated_properties);
+
+    // the solvers that have not finished yet are terminated by the
+    // destructor of the workers
+    break;
+  }
+}
+
+property_updatest multi_path_symex_checkert::decide_in_worker(
+  const optionst &decider_options,
+  symex_target_equationt &worker_equation,
+  propertiest &properties)
+{
+  goto_symex_property_decidert decider(
+    decider_options, ui_message_handler, worker_equation, ns);
+  const auto solver_runtime = ::prepare_property_decider(
+    properties, worker_equation, decider, ui_message_handler);
+
+  resultt result(resultt::progresst::FOUND_FAIL);
+  while(result.progress == resultt::progresst::FOUND_FAIL &&
+        has_properties_to_check(properties))
+  {
+    result.progress = resultt::progresst::DONE;
+    ::run_property_decider(
+      result,
+      properties,
+      decider,
+      ui_message_handler,
+      solver_runtime,
+      equation_complete);
+  }
+
+  property_updatest updates;
+  for(const auto &property_pair : properties)
+  {
+    if(property_pair.second.status != property_statust::UNKNOWN)
+      updates.emplace_back(property_pair.first, property_pair.second.status);
+  }
+  return updates;
 }
 
 goto_tracet multi_path_symex_checkert::build_full_trace() const
@@ -139,6 +451,7 @@ const namespacet &multi_path_symex_checkert::get_namespace() const
 
 void multi_path_symex_checkert::output_proof()
 {
+  equation.restore_spilled_steps();
   output_graphml(equation, ns, options);
 }
 
@@ -168,4 +481,14 @@ void multi_path_symex_checkert::report()
       property_decider.get_decision_procedure(),
       [](solver_hardnesst &hardness) { hardness.produce_report(); });
   }
+
+  if(options.is_set("formula-statistics") && equation_generated)
+  {
+    output_formula_statistics(
+      equation,
+      property_decider.get_decision_procedure(),
+      ns,
+      options.get_unsigned_int_option("formula-statistics"),
+      log);
+  }
 }
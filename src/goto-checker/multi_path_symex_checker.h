@@ -14,10 +14,14 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include <chrono>
 
+#include <util/optional.h>
+
 #include "fault_localization_provider.h"
 #include "goto_symex_property_decider.h"
 #include "goto_trace_provider.h"
 #include "multi_path_symex_only_checker.h"
+#include "property_cache.h"
+#include "property_worker.h"
 #include "witness_provider.h"
 
 /// Performs a multi-path symbolic execution using goto-symex
@@ -60,6 +64,12 @@ protected:
   bool equation_generated;
   goto_symex_property_decidert property_decider;
 
+  /// With `--property-cache`, the properties that passed in earlier runs
+  optionalt<property_cachet> property_cache;
+
+  /// The keys of the properties to be checked in \ref property_cache
+  std::unordered_map<irep_idt, std::string> property_cache_keys;
+
   /// Prepare the property decider for solving. This sets up the data structures
   /// for tracking goal literals, sets the status of \p properties to be checked
   /// to UNKNOWN and pushes the equation into the solver.
@@ -76,6 +86,42 @@ protected:
     incremental_goto_checkert::resultt &result,
     propertiest &properties,
     std::chrono::duration<double> solver_runtime);
+
+  /// Split the \p properties to be checked into \p number_of_groups groups,
+  /// and decide each group on the equation sliced with respect to its
+  /// properties in a worker process. Properties found to pass (or to be
+  /// erroneous) are updated in \p properties, and their ids added to
+  /// `result.updated_properties`. Failing properties are left to be decided
+  /// by \ref property_decider, so that traces can be built.
+  void
+  decide_property_groups(propertiest &properties, resultt &result, std::size_t);
+
+  /// Decide the \p properties to be checked on the whole equation with each
+  /// of the comma-separated \p solvers (see \ref select_solver) in a worker
+  /// process of its own, taking the statuses from the first worker to finish
+  /// and terminating the others. As in \ref decide_property_groups, failing
+  /// properties are left to be decided by \ref property_decider.
+  void decide_with_portfolio(
+    propertiest &properties,
+    resultt &result,
+    const std::string &solvers);
+
+  /// Set the \p properties to be checked that have passed in an earlier run
+  /// on the same slice of the equation to PASS, and add their ids to
+  /// `result.updated_properties`
+  void decide_from_property_cache(propertiest &properties, resultt &result);
+
+  /// Add the \p properties that have passed to \ref property_cache and write
+  /// it back to its file
+  void update_property_cache(const propertiest &properties);
+
+  /// Decide all \p properties to be checked on \p worker_equation with a new
+  /// property decider configured by \p decider_options
+  /// \return the statuses determined, for use by a worker process
+  property_updatest decide_in_worker(
+    const optionst &decider_options,
+    symex_target_equationt &worker_equation,
+    propertiest &properties);
 };
 
 #endif // CPROVER_GOTO_CHECKER_MULTI_PATH_SYMEX_CHECKER_H
@@ -11,6 +11,7 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include "multi_path_symex_only_checker.h"
 
+#include <util/exception_utils.h>
 #include <util/ui_message.h>
 
 #include <goto-symex/show_program.h>
@@ -19,6 +20,7 @@ Author: Daniel Kroening, Peter Schrammel
 #include <chrono>
 
 #include "bmc_util.h"
+#include "symex_checkpoint.h"
 
 multi_path_symex_only_checkert::multi_path_symex_only_checkert(
   const optionst &options,
@@ -67,21 +69,97 @@ operator()(propertiest &properties)
 
   resultt result(resultt::progresst::DONE);
   update_properties(properties, result.updated_properties);
+
+  if(
+    options.is_set("dump-equation") &&
+    write_equation_dump(
+      options.get_option("dump-equation"),
+      goto_model,
+      equation,
+      symex_symbol_table,
+      equation_complete,
+      properties,
+      ui_message_handler))
+  {
+    throw system_exceptiont("failed to write equation dump");
+  }
+
   return result;
 }
 
 void multi_path_symex_only_checkert::generate_equation()
 {
-  const auto symex_start = std::chrono::steady_clock::now();
-
-  symex.symex_from_entry_point_of(
-    goto_symext::get_goto_function(goto_model), symex_symbol_table);
+  if(options.is_set("solve-equation"))
+  {
+    const std::string &dump = options.get_option("solve-equation");
+    log.status() << "Reading equation " << dump << messaget::eom;
+
+    dumped_properties.emplace();
+    if(read_equation_dump(
+         dump,
+         goto_model,
+         equation,
+         symex_symbol_table,
+         equation_complete,
+         *dumped_properties,
+         ui_message_handler))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "failed to read equation", "--solve-equation");
+    }
+
+    // the equation has been post-processed before it was written
+    return;
+  }
 
-  const auto symex_stop = std::chrono::steady_clock::now();
-  std::chrono::duration<double> symex_runtime =
-    std::chrono::duration<double>(symex_stop - symex_start);
-  log.status() << "Runtime Symex: " << symex_runtime.count() << "s"
-               << messaget::eom;
+  if(options.is_set("resume"))
+  {
+    const std::string &checkpoint = options.get_option("resume");
+    log.status() << "Reading symex checkpoint " << checkpoint
+                 << messaget::eom;
+
+    if(read_symex_checkpoint(
+         checkpoint,
+         goto_model,
+         equation,
+         symex_symbol_table,
+         equation_complete,
+         ui_message_handler))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "failed to read checkpoint", "--resume");
+    }
+
+    if(!equation_complete)
+    {
+      log.warning() << "checkpoint was written before symbolic execution "
+                    << "finished, properties can only be found to fail"
+                    << messaget::eom;
+    }
+  }
+  else
+  {
+    const auto symex_start = std::chrono::steady_clock::now();
+
+    symex.symex_from_entry_point_of(
+      goto_symext::get_goto_function(goto_model), symex_symbol_table);
+
+    const auto symex_stop = std::chrono::steady_clock::now();
+    std::chrono::duration<double> symex_runtime =
+      std::chrono::duration<double>(symex_stop - symex_start);
+    log.status() << "Runtime Symex: " << symex_runtime.count() << "s"
+                 << messaget::eom;
+
+    if(!symex.checkpoint_file.empty())
+    {
+      write_symex_checkpoint(
+        symex.checkpoint_file,
+        equation,
+        symex_symbol_table,
+        true,
+        ui_message_handler);
+    }
+  }
 
   postprocess_equation(symex, equation, options, ns, ui_message_handler);
 }
@@ -90,7 +168,14 @@ void multi_path_symex_only_checkert::update_properties(
   propertiest &properties,
   std::unordered_set<irep_idt> &updated_properties)
 {
-  if(options.get_bool_option("symex-driven-lazy-loading"))
+  if(dumped_properties.has_value())
+  {
+    // the equation only has the steps for these properties
+    properties = *dumped_properties;
+    for(const auto &property_pair : properties)
+      updated_properties.insert(property_pair.first);
+  }
+  else if(options.get_bool_option("symex-driven-lazy-loading"))
     update_properties_from_goto_model(properties, goto_model);
 
   update_properties_status_from_symex_target_equation(
@@ -98,5 +183,6 @@ void multi_path_symex_only_checkert::update_properties(
   // Since we will not symex any further we can decide the status
   // of all properties that do not occur in the equation now.
   // The current behavior is PASS.
-  update_status_of_not_checked_properties(properties, updated_properties);
+  if(equation_complete)
+    update_status_of_not_checked_properties(properties, updated_properties);
 }
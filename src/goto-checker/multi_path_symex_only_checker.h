@@ -14,6 +14,8 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include "incremental_goto_checker.h"
 
+#include <util/optional.h>
+
 #include <goto-symex/path_storage.h>
 
 #include "symex_bmc.h"
@@ -37,7 +39,19 @@ protected:
   path_fifot path_storage; // should go away
   symex_bmct symex;
 
-  /// Generates the equation by running goto-symex
+  /// False if the equation has been read from a checkpoint that was
+  /// written before symbolic execution finished. The equation is then a
+  /// prefix of the one for the whole program, and properties can only be
+  /// found to fail.
+  bool equation_complete = true;
+
+  /// The properties read with the equation given by `--solve-equation`,
+  /// which take the place of those of the program
+  optionalt<propertiest> dumped_properties;
+
+  /// Generates the equation by running goto-symex, or by reading the
+  /// checkpoint given by `--resume` or the equation given by
+  /// `--solve-equation`
   virtual void generate_equation();
 
   /// Updates the \p properties from the `equation` and
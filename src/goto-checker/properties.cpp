@@ -167,6 +167,18 @@ count_properties(const propertiest &properties, property_statust status)
   return count;
 }
 
+std::unordered_set<irep_idt>
+get_properties(const propertiest &properties, property_statust status)
+{
+  std::unordered_set<irep_idt> property_ids;
+  for(const auto &property_pair : properties)
+  {
+    if(property_pair.second.status == status)
+      property_ids.insert(property_pair.first);
+  }
+  return property_ids;
+}
+
 bool is_property_to_check(property_statust status)
 {
   return status == property_statust::NOT_CHECKED ||
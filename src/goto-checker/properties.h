@@ -13,6 +13,7 @@ Author: Daniel Kroening, Peter Schrammel
 #define CPROVER_GOTO_CHECKER_PROPERTIES_H
 
 #include <unordered_map>
+#include <unordered_set>
 
 #include <goto-programs/goto_program.h>
 
@@ -99,6 +100,10 @@ int result_to_exit_code(resultt result);
 /// Return the number of properties with given \p status
 std::size_t count_properties(const propertiest &, property_statust);
 
+/// Return the IDs of the properties with given \p status
+std::unordered_set<irep_idt>
+get_properties(const propertiest &, property_statust);
+
 /// Return true if the status is NOT_CHECKED or UNKNOWN
 bool is_property_to_check(property_statust);
 
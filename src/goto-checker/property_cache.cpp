@@ -0,0 +1,294 @@
+/*******************************************************************\
+
+Module: Cache of Property Outcomes
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Cache of Property Outcomes
+
+#include "property_cache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include <util/config.h>
+#include <util/options.h>
+
+#include <goto-symex/slice.h>
+#include <goto-symex/symex_target_equation.h>
+
+#define PROPERTY_CACHE_HEADER "CBMC property cache"
+
+namespace
+{
+/// Two 64-bit FNV-1a hashes with different parameters, which together make
+/// accidental collisions of digests very unlikely
+struct digestt
+{
+  std::uint64_t h1 = 0xcbf29ce484222325;
+  std::uint64_t h2 = 0x84222325cbf29ce4;
+
+  void add(const char *data, std::size_t size)
+  {
+    for(std::size_t i = 0; i < size; ++i)
+    {
+      const auto byte = static_cast<unsigned char>(data[i]);
+      h1 = (h1 ^ byte) * 0x100000001b3;
+      h2 = (h2 ^ byte) * 0xc6a4a7935bd1e995;
+    }
+  }
+
+  void add(std::uint64_t value)
+  {
+    char bytes[8];
+    for(std::size_t i = 0; i < 8; ++i)
+      bytes[i] = static_cast<char>(value >> (8 * i));
+    add(bytes, 8);
+  }
+
+  void add(const std::string &s)
+  {
+    add(s.size());
+    add(s.data(), s.size());
+  }
+
+  void add(const digestt &other)
+  {
+    add(other.h1);
+    add(other.h2);
+  }
+};
+
+/// Digests of ireps, which unlike irept::hash do not depend on the order in
+/// which strings have been numbered. Shared subtrees are hashed once.
+class irep_digestt
+{
+public:
+  const digestt &operator()(const irept &irep);
+
+protected:
+  std::unordered_map<const void *, digestt> digests;
+};
+
+const digestt &irep_digestt::operator()(const irept &irep)
+{
+  const auto entry = digests.find(&irep.read());
+  if(entry != digests.end())
+    return entry->second;
+
+  digestt digest;
+  digest.add(id2string(irep.id()));
+
+  digest.add(irep.get_sub().size());
+  for(const auto &sub : irep.get_sub())
+    digest.add((*this)(sub));
+
+  // named operands are ordered by the numbers of their names, which differ
+  // between runs
+  std::vector<std::pair<std::string, const irept *>> named_subs;
+  for(const auto &named_sub : irep.get_named_sub())
+  {
+    if(!irept::is_comment(named_sub.first))
+      named_subs.emplace_back(id2string(named_sub.first), &named_sub.second);
+  }
+  std::sort(named_subs.begin(), named_subs.end());
+
+  for(const auto &named_sub : named_subs)
+  {
+    digest.add(named_sub.first);
+    digest.add((*this)(*named_sub.second));
+  }
+
+  return digests.emplace(&irep.read(), digest).first->second;
+}
+} // namespace
+
+property_cachet::property_cachet(
+  std::string _filename,
+  message_handlert &message_handler)
+  : filename(std::move(_filename)), log(message_handler)
+{
+  std::ifstream in(filename);
+  if(!in)
+    return;
+
+  const std::string header =
+    PROPERTY_CACHE_HEADER " " + std::to_string(PROPERTY_CACHE_VERSION);
+
+  std::string line;
+  if(!std::getline(in, line))
+    return;
+
+  if(line != header)
+  {
+    log.warning() << "ignoring property cache '" << filename
+                  << "' written by a different version" << messaget::eom;
+    return;
+  }
+
+  while(std::getline(in, line))
+  {
+    if(!line.empty())
+      keys.insert(line);
+  }
+
+  log.status() << "Read " << keys.size() << " passed properties from '"
+               << filename << "'" << messaget::eom;
+}
+
+std::string property_cachet::settings(const optionst &options)
+{
+  // the options that select the solver or change what it is given
+  static const char *const solver_options[] = {
+    "aig",
+    "arrays-uf",
+    "boolector",
+    "compact-object-bits",
+    "cprover-smt2",
+    "cvc3",
+    "cvc4",
+    "external-sat-solver",
+    "fpa",
+    "generic",
+    "incremental-smt2-solver",
+    "lazy-arrays",
+    "mathsat",
+    "max-node-refinement",
+    "max-nondet-string-length",
+    "multiplier-encoding",
+    "refine",
+    "refine-arithmetic",
+    "refine-arrays",
+    "refine-strings",
+    "sat-cubes",
+    "sat-preprocessor",
+    "simplify-cnf",
+    "smt2",
+    "smt2-shared-terms",
+    "solver-portfolio",
+    "structural-hashing",
+    "yices",
+    "z3"};
+
+  std::ostringstream result;
+  result << "object-bits=" << config.bv_encoding.object_bits;
+
+  for(const char *option : solver_options)
+  {
+    if(options.is_set(option))
+      result << ' ' << option << '=' << options.get_option(option);
+  }
+
+  return result.str();
+}
+
+std::string property_cachet::key(
+  const symex_target_equationt &equation,
+  const irep_idt &property_id,
+  const std::string &settings)
+{
+  symex_target_equationt slice_equation(equation);
+
+  slice_equation.SSA_steps.clear();
+  for(const SSA_stept &step : equation.SSA_steps)
+  {
+    if(
+      !step.ignore &&
+      (!step.is_assert() || step.get_property_id() == property_id))
+    {
+      slice_equation.SSA_steps.push_back(step);
+    }
+  }
+
+  // as in ::slice, the slicer is not thread-aware
+  if(!slice_equation.has_threads())
+    ::slice(slice_equation);
+
+  digestt digest;
+  irep_digestt irep_digest;
+  digest.add(settings);
+  digest.add(id2string(property_id));
+
+  for(const SSA_stept &step : slice_equation.SSA_steps)
+  {
+    if(step.ignore)
+      continue;
+
+    digest.add(static_cast<std::uint64_t>(step.type));
+    digest.add(step.source.thread_nr);
+    digest.add(step.atomic_section_id);
+    digest.add(irep_digest(step.guard));
+    digest.add(irep_digest(step.ssa_lhs));
+    digest.add(irep_digest(step.ssa_rhs));
+    digest.add(irep_digest(step.cond_expr));
+  }
+
+  std::ostringstream result;
+  result << std::hex << std::setfill('0') << std::setw(16) << digest.h1
+         << std::setw(16) << digest.h2;
+  return result.str();
+}
+
+void property_cachet::set_passed(const std::string &key)
+{
+  if(keys.insert(key).second)
+    changed = true;
+}
+
+bool property_cachet::write()
+{
+  if(!changed)
+    return false;
+
+  // as with checkpoints, write to a temporary file first so that the cache
+  // survives if we are interrupted
+  const std::string tmp_filename = filename + ".tmp";
+
+  {
+    std::ofstream out(tmp_filename);
+
+    if(!out)
+    {
+      log.error() << "failed to open '" << tmp_filename << "'"
+                  << messaget::eom;
+      return true;
+    }
+
+    std::vector<std::string> sorted_keys(keys.begin(), keys.end());
+    std::sort(sorted_keys.begin(), sorted_keys.end());
+
+    out << PROPERTY_CACHE_HEADER << ' ' << PROPERTY_CACHE_VERSION << '\n';
+    for(const auto &key : sorted_keys)
+      out << key << '\n';
+
+    if(!out.flush())
+    {
+      log.error() << "failed to write '" << tmp_filename << "'"
+                  << messaget::eom;
+      return true;
+    }
+  }
+
+  if(std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+  {
+    // renaming onto an existing file fails on Windows
+    std::remove(filename.c_str());
+    if(std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+    {
+      log.error() << "failed to create '" << filename << "'" << messaget::eom;
+      return true;
+    }
+  }
+
+  changed = false;
+  return false;
+}
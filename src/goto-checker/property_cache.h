@@ -0,0 +1,73 @@
+/*******************************************************************\
+
+Module: Cache of Property Outcomes
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Cache of Property Outcomes
+
+#ifndef CPROVER_GOTO_CHECKER_PROPERTY_CACHE_H
+#define CPROVER_GOTO_CHECKER_PROPERTY_CACHE_H
+
+#include <util/irep.h>
+#include <util/message.h>
+
+#include <string>
+#include <unordered_set>
+
+class optionst;
+class symex_target_equationt;
+
+#define PROPERTY_CACHE_VERSION 2
+
+/// The properties that passed in earlier runs, which are read from and
+/// written to a file. A property is identified by a digest of the steps of
+/// the equation sliced with respect to its assertions, hence it is found in
+/// the cache as long as its slice is unchanged, even if other parts of the
+/// program have changed, and the settings that the encoding of the equation
+/// and the solver depend on are unchanged. Failing properties are not stored,
+/// as their traces require solving anyway.
+class property_cachet
+{
+public:
+  /// Read the cache from \p filename, which is empty if the file does not
+  /// exist yet
+  property_cachet(std::string filename, message_handlert &message_handler);
+
+  /// \return the settings that the outcome of deciding a property depends on
+  ///   besides the equation: the number of object bits of \ref config, and
+  ///   the solver, its options and the refinement settings in \p options
+  static std::string settings(const optionst &options);
+
+  /// \return a digest of \p settings, as returned by \ref settings, and of
+  ///   the steps of \p equation that the assertions of \p property_id depend
+  ///   on. Source locations are left out and strings are hashed by their
+  ///   contents, thus the digest is the same in each run.
+  static std::string key(
+    const symex_target_equationt &equation,
+    const irep_idt &property_id,
+    const std::string &settings);
+
+  bool has_passed(const std::string &key) const
+  {
+    return keys.count(key) != 0;
+  }
+
+  void set_passed(const std::string &key);
+
+  /// Write the cache back to the file if any properties have been added,
+  /// replacing it only once the new one has been written completely
+  /// \return true on error, false otherwise
+  bool write();
+
+protected:
+  std::string filename;
+  messaget log;
+  std::unordered_set<std::string> keys;
+  bool changed = false;
+};
+
+#endif // CPROVER_GOTO_CHECKER_PROPERTY_CACHE_H
@@ -0,0 +1,135 @@
+/*******************************************************************\
+
+Module: Deciding Properties in Worker Processes
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Deciding Properties in Worker Processes
+
+#include "property_worker.h"
+
+#include <util/exception_utils.h>
+#include <util/invariant.h>
+#include <util/message.h>
+
+#include <iostream>
+#include <sstream>
+
+/// Precedes the statuses in the output of a worker process, which may be
+/// preceded by error messages in turn
+static const char results_marker[] = "-- property statuses --\n";
+
+property_workerst::finishedt property_workerst::failed_worker(
+  std::size_t id,
+  const std::vector<irep_idt> &property_ids)
+{
+  finishedt finished{id, true, {}};
+  for(const auto &property_id : property_ids)
+    finished.updates.emplace_back(property_id, property_statust::ERROR);
+  return finished;
+}
+
+void property_workerst::start(
+  std::size_t id,
+  std::vector<irep_idt> property_ids,
+  std::function<property_updatest()> decide)
+{
+  const bool not_started = pool.start(
+    id,
+    [this, &decide]() {
+      message_handler.set_verbosity(messaget::M_ERROR);
+
+      const property_updatest updates = decide();
+
+      std::cout << results_marker;
+      for(const auto &update : updates)
+      {
+        std::cout << static_cast<int>(update.second) << ' ' << update.first
+                  << '\n';
+      }
+      return 0;
+    },
+    true);
+
+  if(!not_started)
+  {
+    worker_properties.emplace(id, std::move(property_ids));
+    return;
+  }
+
+  try
+  {
+    finished_workers.push_back({id, false, decide()});
+  }
+  catch(...)
+  {
+    finished_workers.push_back(failed_worker(id, property_ids));
+  }
+}
+
+property_workerst::finishedt property_workerst::wait_for_any()
+{
+  PRECONDITION(running() != 0);
+
+  if(!finished_workers.empty())
+  {
+    finishedt finished = std::move(finished_workers.front());
+    finished_workers.pop_front();
+    return finished;
+  }
+
+  const auto process = pool.wait_for_any();
+  if(!process.has_value())
+    throw system_exceptiont("failed to wait for worker processes");
+
+  const auto properties_it = worker_properties.find(process->id);
+  CHECK_RETURN(properties_it != worker_properties.end());
+  const std::vector<irep_idt> property_ids = std::move(properties_it->second);
+  worker_properties.erase(properties_it);
+
+  const std::string &output = process->output;
+  const std::size_t results = output.rfind(results_marker);
+
+  // forward the error messages of the worker
+  std::cout << output.substr(0, results);
+
+  // a worker that was killed or crashed did not report all of its results
+  if(
+    results == std::string::npos || !process->exit_code.has_value() ||
+    *process->exit_code != 0)
+  {
+    return failed_worker(process->id, property_ids);
+  }
+
+  finishedt finished{process->id, false, {}};
+  std::istringstream in(output.substr(results + sizeof(results_marker) - 1));
+  int worker_status;
+  while(in >> worker_status)
+  {
+    std::string property_id;
+    std::getline(in >> std::ws, property_id);
+    finished.updates.emplace_back(
+      property_id, static_cast<property_statust>(worker_status));
+  }
+
+  return finished;
+}
+
+void apply_property_updates(
+  const property_updatest &updates,
+  propertiest &properties,
+  std::unordered_set<irep_idt> &updated_properties)
+{
+  for(const auto &update : updates)
+  {
+    auto &status = properties.at(update.first).status;
+    if(status == property_statust::UNKNOWN)
+    {
+      status |= update.second;
+      updated_properties.insert(update.first);
+    }
+  }
+}
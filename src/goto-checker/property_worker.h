@@ -0,0 +1,103 @@
+/*******************************************************************\
+
+Module: Deciding Properties in Worker Processes
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Deciding Properties in Worker Processes
+
+#ifndef CPROVER_GOTO_CHECKER_PROPERTY_WORKER_H
+#define CPROVER_GOTO_CHECKER_PROPERTY_WORKER_H
+
+#include "properties.h"
+
+#include <util/process_pool.h>
+
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/// Statuses of properties as determined by a worker
+typedef std::vector<std::pair<irep_idt, property_statust>> property_updatest;
+
+class message_handlert;
+
+/// Workers that decide properties in processes forked by a \ref process_poolt,
+/// so that several solvers can run concurrently. Objects such as ireps cannot
+/// be shared between threads, but a forked process works on its own copy of
+/// the objects of this process. Where no process can be forked, as on
+/// Windows, a worker is run by this process upon \ref start instead. The
+/// workers that are still running upon destruction are terminated.
+class property_workerst
+{
+public:
+  /// Only errors are output via \p message_handler in worker processes, as
+  /// the output of concurrent workers would be interleaved, and would break
+  /// structured (XML, JSON) output.
+  explicit property_workerst(message_handlert &message_handler)
+    : message_handler(message_handler)
+  {
+  }
+
+  /// Start a worker that runs \p decide
+  /// \param id: the identifier of the worker, which \ref wait_for_any returns
+  /// \param property_ids: the properties that the worker decides, which are
+  ///   reported as ERROR if it fails
+  /// \param decide: the function deciding the properties
+  void start(
+    std::size_t id,
+    std::vector<irep_idt> property_ids,
+    std::function<property_updatest()> decide);
+
+  struct finishedt
+  {
+    /// The identifier given to \ref start
+    std::size_t id;
+
+    /// True if the worker crashed, was killed, or threw an exception
+    bool failed;
+
+    /// The statuses of properties determined by the worker, or ERROR for
+    /// each of its properties if it failed
+    property_updatest updates;
+  };
+
+  /// Wait for any of the running workers to finish
+  finishedt wait_for_any();
+
+  /// \return the number of workers that have been started, but not returned
+  ///   by \ref wait_for_any
+  std::size_t running() const
+  {
+    return pool.running() + finished_workers.size();
+  }
+
+protected:
+  message_handlert &message_handler;
+  process_poolt pool;
+
+  /// The properties of each worker running in \ref pool
+  std::unordered_map<std::size_t, std::vector<irep_idt>> worker_properties;
+
+  /// The workers that have been run by this process
+  std::list<finishedt> finished_workers;
+
+  static finishedt
+  failed_worker(std::size_t id, const std::vector<irep_idt> &property_ids);
+};
+
+/// Apply the \p updates reported by a worker to \p properties, adding the ids
+/// of changed properties to \p updated_properties. Only properties of status
+/// UNKNOWN are changed.
+void apply_property_updates(
+  const property_updatest &updates,
+  propertiest &properties,
+  std::unordered_set<irep_idt> &updated_properties);
+
+#endif // CPROVER_GOTO_CHECKER_PROPERTY_WORKER_H
@@ -173,7 +173,10 @@ operator()(propertiest &properties)
 
     output_incremental_status(properties, log);
 
-    // We continue symbolic execution
+    // We continue symbolic execution, without recording further assertions of
+    // properties that are known to fail already.
+    symex.decided_properties =
+      get_properties(properties, property_statust::FAIL);
     full_equation_generated =
       !symex.resume(goto_symext::get_goto_function(goto_model));
     revert_slice(equation);
@@ -23,8 +23,8 @@ Author: Daniel Kroening, Peter Schrammel
 #include "witness_provider.h"
 
 /// Performs a multi-path symbolic execution using goto-symex
-/// that incrementally unwinds a given loop
-/// and calls a SAT/SMT solver to check the status of the properties
+/// that incrementally unwinds a given loop, or all loops in lockstep
+/// (see symex_bmc_incremental_one_loopt), and calls a SAT/SMT solver to check the status of the properties
 /// after each iteration.
 class single_loop_incremental_symex_checkert : public incremental_goto_checkert,
                                                public goto_trace_providert,
@@ -64,4 +64,10 @@ protected:
   goto_symex_property_decidert property_decider;
 };
 
+/// Output the status of an incremental check, FAILURE if any of the
+/// \p properties fails, otherwise INCONCLUSIVE
+void output_incremental_status(
+  const propertiest &properties,
+  messaget &message_hander);
+
 #endif // CPROVER_GOTO_CHECKER_SINGLE_LOOP_INCREMENTAL_SYMEX_CHECKER_H
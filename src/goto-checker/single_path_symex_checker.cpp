@@ -11,6 +11,9 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include "single_path_symex_checker.h"
 
+#include <algorithm>
+
+#include <util/make_unique.h>
 #include <util/ui_message.h>
 
 #include "bmc_util.h"
@@ -21,7 +24,9 @@ single_path_symex_checkert::single_path_symex_checkert(
   const optionst &options,
   ui_message_handlert &ui_message_handler,
   abstract_goto_modelt &goto_model)
-  : single_path_symex_only_checkert(options, ui_message_handler, goto_model)
+  : single_path_symex_only_checkert(options, ui_message_handler, goto_model),
+    number_of_jobs(options.get_unsigned_int_option("paths-jobs")),
+    workers(ui_message_handler)
 {
 }
 
@@ -40,7 +45,7 @@ operator()(propertiest &properties)
       return result;
   }
 
-  if(!worklist->empty())
+  if(!worklist->empty() && number_of_jobs == 0)
   {
     // We pop the item processed in the previous iteration.
     worklist->pop();
@@ -53,8 +58,48 @@ operator()(propertiest &properties)
     initialize_worklist();
   }
 
+  // Symbolic execution stays in this process, as it shares ireps with the goto
+  // model, and irept is not thread-safe. The equation of each path is handed
+  // to a forked worker process with its own solver instead.
+  while(number_of_jobs != 0)
+  {
+    const bool finished = has_finished_exploration(properties);
+
+    if(
+      !pending_decisions.empty() &&
+      (finished || pending_decisions.size() >= number_of_jobs))
+    {
+      finish_decision(result, properties);
+
+      if(result.progress == resultt::progresst::FOUND_FAIL)
+        return result;
+
+      continue;
+    }
+
+    if(finished)
+      break;
+
+    // A failing property fails on all paths, hence there is no need to
+    // record its assertions on the remaining ones.
+    decided_properties = get_properties(properties, property_statust::FAIL);
+
+    path_storaget::patht &path = worklist->peek();
+    const bool ready_to_decide = resume_path(path);
+
+    if(ready_to_decide)
+    {
+      update_properties(properties, result.updated_properties, path.equation);
+      start_decision(properties, path.equation);
+    }
+
+    worklist->pop();
+  }
+
   while(!has_finished_exploration(properties))
   {
+    decided_properties = get_properties(properties, property_statust::FAIL);
+
     path_storaget::patht &path = worklist->peek();
     const bool ready_to_decide = resume_path(path);
 
@@ -87,6 +132,98 @@ operator()(propertiest &properties)
   return result;
 }
 
+void single_path_symex_checkert::start_decision(
+  const propertiest &properties,
+  const symex_target_equationt &equation)
+{
+  const std::size_t worker_id = next_worker_id++;
+  symex_target_equationt &pending_equation =
+    pending_decisions.emplace(worker_id, equation).first->second;
+
+  // the properties that the path may decide, which are erroneous if the
+  // worker fails
+  std::vector<irep_idt> property_ids;
+  for(const SSA_stept &step : pending_equation.SSA_steps)
+  {
+    if(
+      step.is_assert() &&
+      properties.at(step.get_property_id()).status ==
+        property_statust::UNKNOWN &&
+      std::find(
+        property_ids.begin(), property_ids.end(), step.get_property_id()) ==
+        property_ids.end())
+    {
+      property_ids.push_back(step.get_property_id());
+    }
+  }
+
+  workers.start(worker_id, property_ids, [&]() -> property_updatest {
+    propertiest worker_properties(properties);
+    resultt worker_result(resultt::progresst::DONE);
+
+    goto_symex_property_decidert decider(
+      options, ui_message_handler, pending_equation, ns);
+    const auto solver_runtime = ::prepare_property_decider(
+      worker_properties, pending_equation, decider, ui_message_handler);
+    ::run_property_decider(
+      worker_result,
+      worker_properties,
+      decider,
+      ui_message_handler,
+      solver_runtime,
+      false);
+
+    property_updatest updates;
+    for(const auto &property_id : worker_result.updated_properties)
+    {
+      updates.emplace_back(
+        property_id, worker_properties.at(property_id).status);
+    }
+    return updates;
+  });
+}
+
+void single_path_symex_checkert::finish_decision(
+  resultt &result,
+  propertiest &properties)
+{
+  PRECONDITION(!pending_decisions.empty());
+
+  property_workerst::finishedt finished = workers.wait_for_any();
+  const auto pending_it = pending_decisions.find(finished.id);
+  CHECK_RETURN(pending_it != pending_decisions.end());
+
+  // Failing properties are left to be decided once more by this process,
+  // which provides their traces.
+  property_updatest &updates = finished.updates;
+  const auto fail_it = std::remove_if(
+    updates.begin(),
+    updates.end(),
+    [](const std::pair<irep_idt, property_statust> &update) {
+      return update.second == property_statust::FAIL;
+    });
+  const bool found_fail = fail_it != updates.end();
+  updates.erase(fail_it, updates.end());
+
+  apply_property_updates(updates, properties, result.updated_properties);
+
+  if(found_fail)
+  {
+    property_decider.reset();
+    failing_equation =
+      util_make_unique<symex_target_equationt>(pending_it->second);
+    property_decider = util_make_unique<goto_symex_property_decidert>(
+      options, ui_message_handler, *failing_equation, ns);
+
+    const auto solver_runtime = prepare_property_decider(
+      properties, *failing_equation, *property_decider);
+
+    run_property_decider(result, properties, *property_decider, solver_runtime);
+  }
+
+  pending_decisions.erase(pending_it);
+}
+
 bool single_path_symex_checkert::is_ready_to_decide(
   const symex_bmct &symex,
   const path_storaget::patht &)
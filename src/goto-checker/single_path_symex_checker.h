@@ -13,9 +13,11 @@ Author: Daniel Kroening, Peter Schrammel
 #define CPROVER_GOTO_CHECKER_SINGLE_PATH_SYMEX_CHECKER_H
 
 #include <chrono>
+#include <map>
 
 #include "goto_symex_property_decider.h"
 #include "goto_trace_provider.h"
+#include "property_worker.h"
 #include "single_path_symex_only_checker.h"
 #include "witness_provider.h"
 
@@ -47,6 +49,37 @@ protected:
   bool symex_initialized = false;
   std::unique_ptr<goto_symex_property_decidert> property_decider;
 
+  /// Number of worker processes deciding the equations of paths while
+  /// symbolic execution continues with further paths (`--paths-jobs`); 0
+  /// if equations are decided one at a time by this process
+  std::size_t number_of_jobs;
+
+  /// The worker processes deciding the equations of paths
+  property_workerst workers;
+
+  /// The identifier of the next worker started in \ref workers
+  std::size_t next_worker_id = 0;
+
+  /// The equations being decided in \ref workers by the identifier of their
+  /// worker, which are decided once more by this process if the worker finds
+  /// a property violation, to obtain a trace
+  std::map<std::size_t, symex_target_equationt> pending_decisions;
+
+  /// The equation that \ref property_decider refers to if that has been set
+  /// up for a failing equation reported by a worker process
+  std::unique_ptr<symex_target_equationt> failing_equation;
+
+  /// Start a worker process that decides \p equation
+  void start_decision(
+    const propertiest &properties,
+    const symex_target_equationt &equation);
+
+  /// Wait for a worker process to finish and update \p properties with its
+  /// result. If the worker found a property violation, the equation is
+  /// decided by this process, setting up \ref property_decider for building
+  /// traces, and `result.progress` is set to FOUND_FAIL.
+  void finish_decision(resultt &result, propertiest &properties);
+
   bool
   is_ready_to_decide(const symex_bmct &, const path_storaget::patht &) override;
 
@@ -150,6 +150,7 @@ void single_path_symex_only_checkert::equation_output(
 void single_path_symex_only_checkert::setup_symex(symex_bmct &symex)
 {
   ::setup_symex(symex, ns, options, ui_message_handler);
+  symex.decided_properties = decided_properties;
 }
 
 void single_path_symex_only_checkert::update_properties(
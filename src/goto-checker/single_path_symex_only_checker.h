@@ -41,6 +41,10 @@ protected:
   std::unique_ptr<path_storaget> worklist;
   std::chrono::duration<double> symex_runtime;
 
+  /// Properties whose assertions symex does not need to record on the paths
+  /// still to be explored, see \ref goto_symext::decided_properties
+  std::unordered_set<irep_idt> decided_properties;
+
   void equation_output(
     const symex_bmct &symex,
     const symex_target_equationt &equation);
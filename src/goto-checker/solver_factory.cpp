@@ -11,9 +11,13 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include "solver_factory.h"
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <thread>
 
 #include <util/exception_utils.h>
+#include <util/magic.h>
 #include <util/make_unique.h>
 #include <util/message.h>
 #include <util/options.h>
@@ -26,6 +30,7 @@ Author: Daniel Kroening, Peter Schrammel
 #include <solvers/stack_decision_procedure.h>
 
 #include <solvers/flattening/bv_dimacs.h>
+#include <solvers/prop/aig_prop.h>
 #include <solvers/prop/prop.h>
 #include <solvers/prop/solver_resource_limits.h>
 #include <solvers/refinement/bv_refinement.h>
@@ -111,6 +116,28 @@ void solver_factoryt::set_decision_procedure_time_limit(
   }
 }
 
+void solver_factoryt::set_multiplier_encoding(boolbvt &boolbv)
+{
+  const std::string encoding = options.get_option("multiplier-encoding");
+
+  if(encoding.empty() || encoding == "shift-add")
+    boolbv.set_multiplier_encoding(bv_utilst::multiplier_encodingt::SHIFT_ADD);
+  else if(encoding == "wallace")
+    boolbv.set_multiplier_encoding(
+      bv_utilst::multiplier_encodingt::WALLACE_TREE);
+  else if(encoding == "dadda")
+    boolbv.set_multiplier_encoding(bv_utilst::multiplier_encodingt::DADDA_TREE);
+  else if(encoding == "karatsuba")
+    boolbv.set_multiplier_encoding(bv_utilst::multiplier_encodingt::KARATSUBA);
+  else
+  {
+    throw invalid_command_line_argument_exceptiont(
+      "unknown multiplier encoding '" + encoding + "'",
+      "--multiplier-encoding",
+      "use shift-add, wallace, dadda or karatsuba");
+  }
+}
+
 void solver_factoryt::solvert::set_decision_procedure(
   std::unique_ptr<decision_proceduret> p)
 {
@@ -179,12 +206,22 @@ smt2_dect::solvert solver_factoryt::get_smt2_solver_type() const
   return s;
 }
 
-template <typename SatcheckT>
-static std::unique_ptr<SatcheckT>
-make_satcheck_prop(message_handlert &message_handler, const optionst &options)
+template <typename SatcheckT, typename... Args>
+static std::unique_ptr<SatcheckT> make_satcheck_prop(
+  message_handlert &message_handler,
+  const optionst &options,
+  Args &&... args)
 {
-  auto satcheck = util_make_unique<SatcheckT>(message_handler);
-  if(options.is_set("write-solver-stats-to"))
+  auto satcheck =
+    util_make_unique<SatcheckT>(message_handler, std::forward<Args>(args)...);
+  if(options.get_bool_option("structural-hashing"))
+  {
+    if(auto cnf = dynamic_cast<cnft *>(&*satcheck))
+      cnf->enable_structural_hashing();
+  }
+  if(
+    options.is_set("write-solver-stats-to") ||
+    options.is_set("formula-statistics"))
   {
     if(
       auto hardness_collector = dynamic_cast<hardness_collectort *>(&*satcheck))
@@ -192,28 +229,79 @@ make_satcheck_prop(message_handlert &message_handler, const optionst &options)
       hardness_collector->enable_hardness_collection();
       hardness_collector->with_solver_hardness(
         [&options](solver_hardnesst &hardness) {
-          hardness.set_outfile(options.get_option("write-solver-stats-to"));
+          if(options.is_set("write-solver-stats-to"))
+          {
+            hardness.set_outfile(
+              options.get_option("write-solver-stats-to"));
+          }
+          const std::string aggregation =
+            options.get_option("solver-stats-by");
+          if(aggregation == "line")
+          {
+            hardness.set_aggregation(
+              solver_hardnesst::aggregationt::SOURCE_LINE);
+          }
+          else if(aggregation == "function")
+            hardness.set_aggregation(solver_hardnesst::aggregationt::FUNCTION);
         });
     }
     else
     {
       messaget log(message_handler);
       log.warning()
-        << "Configured solver does not support --write-solver-stats-to. "
-        << "Solver stats will not be written." << messaget::eom;
+        << "Configured solver does not support --write-solver-stats-to "
+        << "or clause counts for --formula-statistics. "
+        << "Solver stats will not be collected." << messaget::eom;
     }
   }
   return satcheck;
 }
 
+std::size_t solver_factoryt::sat_threads() const
+{
+  if(!options.is_set("sat-threads"))
+    return 1;
+
+  const std::size_t threads = options.get_unsigned_int_option("sat-threads");
+  return threads == 0 ? std::thread::hardware_concurrency() : threads;
+}
+
 std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_default()
 {
   auto solver = util_make_unique<solvert>();
-  if(
+  if(options.get_bool_option("aig"))
+  {
+    // the AIG reuses the gates passed to the SAT solver, which therefore must
+    // not eliminate variables
+    solver->set_prop(util_make_unique<aig_prop_solvert>(
+      make_satcheck_prop<satcheck_no_simplifiert>(message_handler, options),
+      message_handler));
+  }
+  else if(sat_threads() > 1 || options.is_set("sat-cubes"))
+  {
+#ifdef SATCHECK_MINISAT2
+    // the instances do not simplify, hence this works with any of the below
+    const std::size_t split_variables =
+      options.is_set("sat-cubes") ? options.get_unsigned_int_option("sat-cubes")
+                                  : 0;
+    solver->set_prop(make_satcheck_prop<satcheck_minisat_portfoliot>(
+      message_handler, options, sat_threads(), split_variables));
+#else
+    messaget log(message_handler);
+    log.warning()
+      << "--sat-threads and --sat-cubes require MiniSat, using a single thread"
+      << messaget::eom;
+    solver->set_prop(
+      make_satcheck_prop<satcheck_no_simplifiert>(message_handler, options));
+#endif
+  }
+  else if(
     options.get_bool_option("beautify") ||
+    options.get_bool_option("lazy-arrays") ||
     !options.get_bool_option("sat-preprocessor")) // no simplifier
   {
-    // simplifier won't work with beautification
+    // simplifier won't work with beautification, nor with array constraints
+    // that are added after solving
     solver->set_prop(
       make_satcheck_prop<satcheck_no_simplifiert>(message_handler, options));
   }
@@ -232,7 +320,11 @@ std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_default()
   else if(options.get_option("arrays-uf") == "always")
     bv_pointers->unbounded_array = bv_pointerst::unbounded_arrayt::U_ALL;
 
+  if(options.get_bool_option("lazy-arrays"))
+    bv_pointers->enable_lazy_array_constraints();
+
   set_decision_procedure_time_limit(*bv_pointers);
+  set_multiplier_encoding(*bv_pointers);
   solver->set_decision_procedure(std::move(bv_pointers));
 
   return solver;
@@ -244,11 +336,14 @@ std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_dimacs()
   no_incremental_check();
 
   auto prop = util_make_unique<dimacs_cnft>(message_handler);
+  if(options.get_bool_option("simplify-cnf"))
+    prop->enable_simplification();
 
   std::string filename = options.get_option("outfile");
 
   auto bv_dimacs =
     util_make_unique<bv_dimacst>(ns, *prop, message_handler, filename);
+  set_multiplier_encoding(*bv_dimacs);
 
   return util_make_unique<solvert>(std::move(bv_dimacs), std::move(prop));
 }
@@ -261,8 +356,11 @@ std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_external_sat()
   std::string external_sat_solver = options.get_option("external-sat-solver");
   auto prop =
     util_make_unique<external_satt>(message_handler, external_sat_solver);
+  if(options.get_bool_option("simplify-cnf"))
+    prop->enable_simplification();
 
   auto bv_pointers = util_make_unique<bv_pointerst>(ns, *prop, message_handler);
+  set_multiplier_encoding(*bv_pointers);
 
   return util_make_unique<solvert>(std::move(bv_pointers), std::move(prop));
 }
@@ -296,6 +394,7 @@ std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_bv_refinement()
 
   auto decision_procedure = util_make_unique<bv_refinementt>(info);
   set_decision_procedure_time_limit(*decision_procedure);
+  set_multiplier_encoding(*decision_procedure);
   return util_make_unique<solvert>(
     std::move(decision_procedure), std::move(prop));
 }
@@ -312,6 +411,14 @@ solver_factoryt::get_string_refinement()
     make_satcheck_prop<satcheck_no_simplifiert>(message_handler, options);
   info.prop = prop.get();
   info.refinement_bound = DEFAULT_MAX_NB_REFINEMENT;
+  if(options.is_set("max-nondet-string-length"))
+  {
+    const auto max_length =
+      options.get_unsigned_int_option("max-nondet-string-length");
+    // strings built from nondet ones may be longer, but are mostly short too
+    if(max_length <= STRING_REFINEMENT_MAX_EAGER_LENGTH)
+      info.eager_instantiation_length = max_length;
+  }
   info.output_xml = output_xml_in_refinement;
   if(options.get_bool_option("max-node-refinement"))
     info.max_node_refinement =
@@ -331,9 +438,15 @@ solver_factoryt::get_incremental_smt2(std::string solver_command)
 {
   no_beautification();
 
-  return util_make_unique<solvert>(
-    util_make_unique<smt2_incremental_decision_proceduret>(
-      std::move(solver_command)));
+  auto smt2_dec = util_make_unique<smt2_incremental_decision_proceduret>(
+    ns, std::move(solver_command), message_handler);
+
+  if(options.get_bool_option("fpa"))
+    smt2_dec->use_FPA_theory = true;
+  if(options.get_bool_option("smt2-shared-terms"))
+    smt2_dec->use_shared_terms = true;
+
+  return util_make_unique<solvert>(std::move(smt2_dec));
 }
 
 std::unique_ptr<solver_factoryt::solvert>
@@ -363,6 +476,8 @@ solver_factoryt::get_smt2(smt2_dect::solvert solver)
 
     if(options.get_bool_option("fpa"))
       smt2_dec->use_FPA_theory = true;
+    if(options.get_bool_option("smt2-shared-terms"))
+      smt2_dec->use_shared_terms = true;
 
     set_decision_procedure_time_limit(*smt2_dec);
     return util_make_unique<solvert>(std::move(smt2_dec));
@@ -379,6 +494,8 @@ solver_factoryt::get_smt2(smt2_dect::solvert solver)
 
     if(options.get_bool_option("fpa"))
       smt2_conv->use_FPA_theory = true;
+    if(options.get_bool_option("smt2-shared-terms"))
+      smt2_conv->use_shared_terms = true;
 
     set_decision_procedure_time_limit(*smt2_conv);
     return util_make_unique<solvert>(std::move(smt2_conv));
@@ -407,6 +524,8 @@ solver_factoryt::get_smt2(smt2_dect::solvert solver)
 
     if(options.get_bool_option("fpa"))
       smt2_conv->use_FPA_theory = true;
+    if(options.get_bool_option("smt2-shared-terms"))
+      smt2_conv->use_shared_terms = true;
 
     set_decision_procedure_time_limit(*smt2_conv);
     return util_make_unique<solvert>(std::move(smt2_conv), std::move(out));
@@ -427,6 +546,7 @@ void solver_factoryt::no_incremental_check()
   const bool all_properties = options.get_bool_option("all-properties");
   const bool cover = options.is_set("cover");
   const bool incremental_loop = options.is_set("incremental-loop");
+  const bool incremental_loops = options.get_bool_option("incremental-loops");
 
   if(all_properties)
   {
@@ -445,4 +565,40 @@ void solver_factoryt::no_incremental_check()
       "the chosen solver does not support incremental solving",
       "--incremental-loop");
   }
+  else if(incremental_loops)
+  {
+    throw invalid_command_line_argument_exceptiont(
+      "the chosen solver does not support incremental solving",
+      "--incremental-loops");
+  }
+}
+
+void select_solver(optionst &options, const std::string &solver)
+{
+  static const char *const smt2_solvers[] = {
+    "boolector", "cprover-smt2", "cvc3", "cvc4", "mathsat", "yices", "z3"};
+
+  if(solver != "sat" && solver != "refine")
+  {
+    if(
+      std::find(std::begin(smt2_solvers), std::end(smt2_solvers), solver) ==
+      std::end(smt2_solvers))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "unknown solver '" + solver + "'",
+        "--solver-portfolio",
+        "use sat, refine, boolector, cprover-smt2, cvc3, cvc4, mathsat, yices "
+        "or z3");
+    }
+  }
+
+  options.set_option("refine", solver == "refine");
+  options.set_option("smt2", false);
+  options.set_option("generic", false);
+  for(const auto &smt2_solver : smt2_solvers)
+  {
+    options.set_option(smt2_solver, solver == smt2_solver);
+    if(solver == smt2_solver)
+      options.set_option("smt2", true);
+  }
 }
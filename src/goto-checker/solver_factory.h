@@ -13,9 +13,11 @@ Author: Daniel Kroening, Peter Schrammel
 #define CPROVER_GOTO_CHECKER_SOLVER_FACTORY_H
 
 #include <memory>
+#include <string>
 
 #include <solvers/smt2/smt2_dec.h>
 
+class boolbvt;
 class message_handlert;
 class namespacet;
 class optionst;
@@ -86,9 +88,25 @@ protected:
   void
   set_decision_procedure_time_limit(decision_proceduret &decision_procedure);
 
+  /// Sets the encoding of multiplications used by \p boolbv to the one given
+  /// by the `multiplier-encoding` option, if any.
+  void set_multiplier_encoding(boolbvt &boolbv);
+
+  /// \return the number of threads for solving the formula as requested by
+  ///   `sat-threads`, which if 0 is the number of hardware threads
+  std::size_t sat_threads() const;
+
   // consistency checks during solver creation
   void no_beautification();
   void no_incremental_check();
 };
 
+/// Select the backend named \p solver, which is one of `sat` for the default
+/// SAT solver, `refine` for the refinement solver, or one of `boolector`,
+/// `cprover-smt2`, `cvc3`, `cvc4`, `mathsat`, `yices` and `z3` for an SMT
+/// solver, for use by solver_factoryt
+/// \param [inout] options: options to update
+/// \param solver: name of the backend
+void select_solver(optionst &options, const std::string &solver);
+
 #endif // CPROVER_GOTO_CHECKER_SOLVER_FACTORY_H
@@ -57,6 +57,8 @@ public:
         incremental_goto_checker.get_namespace(),
         trace_optionst(options),
         ui_message_handler);
+      output_binary_trace(
+        goto_trace, incremental_goto_checker.get_namespace(), options);
       report_failure(ui_message_handler);
       incremental_goto_checker.output_error_witness(goto_trace);
       break;
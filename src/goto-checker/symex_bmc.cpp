@@ -16,6 +16,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/simplify_expr.h>
 #include <util/source_location.h>
 
+#include "symex_checkpoint.h"
+
 symex_bmct::symex_bmct(
   message_handlert &mh,
   const symbol_tablet &outer_symbol_table,
@@ -33,6 +35,12 @@ symex_bmct::symex_bmct(
     record_coverage(!options.get_option("symex-coverage-report").empty()),
     havoc_bodyless_functions(
       options.get_bool_option("havoc-undefined-functions")),
+    checkpoint_file(options.get_option("symex-checkpoint")),
+    checkpoint_interval(
+      options.is_set("symex-checkpoint-interval")
+        ? options.get_unsigned_int_option("symex-checkpoint-interval")
+        : 600),
+    next_checkpoint(std::chrono::steady_clock::now() + checkpoint_interval),
     symex_coverage(ns)
 {
 }
@@ -91,6 +99,22 @@ void symex_bmct::symex_step(
     else if(!state.guard.is_false())
       symex_coverage.covered(cur_pc, state.source.pc);
   }
+
+  if(!checkpoint_file.empty())
+  {
+    const auto now = std::chrono::steady_clock::now();
+    if(now >= next_checkpoint)
+    {
+      log.status() << "Writing symex checkpoint" << log.eom;
+      write_symex_checkpoint(
+        checkpoint_file,
+        target,
+        state.symbol_table,
+        false,
+        log.get_message_handler());
+      next_checkpoint = std::chrono::steady_clock::now() + checkpoint_interval;
+    }
+  }
 }
 
 void symex_bmct::merge_goto(
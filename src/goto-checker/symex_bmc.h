@@ -20,6 +20,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "symex_coverage.h"
 
+#include <chrono>
+
 class symex_bmct : public goto_symext
 {
 public:
@@ -81,9 +83,17 @@ public:
   const bool record_coverage;
   const bool havoc_bodyless_functions;
 
+  /// File to write checkpoints of the equation to while symbolic execution
+  /// is running, empty for no checkpoints
+  const std::string checkpoint_file;
+
   unwindsett unwindset;
 
 protected:
+  /// Time between checkpoints
+  const std::chrono::seconds checkpoint_interval;
+  std::chrono::steady_clock::time_point next_checkpoint;
+
   /// Callbacks that may provide an unwind/do-not-unwind decision for a loop
   std::vector<loop_unwind_handlert> loop_unwind_handlers;
 
@@ -28,12 +28,17 @@ symex_bmc_incremental_one_loopt::symex_bmc_incremental_one_loopt(
       path_storage,
       guard_manager),
     incr_loop_id(options.get_option("incremental-loop")),
+    incr_all_loops(options.get_bool_option("incremental-loops")),
     incr_max_unwind(
       options.is_set("unwind-max") ? options.get_signed_int_option("unwind-max")
                                    : std::numeric_limits<unsigned>::max()),
     incr_min_unwind(
       options.is_set("unwind-min") ? options.get_signed_int_option("unwind-min")
                                    : 0),
+    incr_step_unwind(
+      options.is_set("unwind-step")
+        ? options.get_signed_int_option("unwind-step")
+        : 1),
     output_ui(output_ui)
 {
   // the intended behaviour is to stop asserts that are violated before the
@@ -45,6 +50,12 @@ symex_bmc_incremental_one_loopt::symex_bmc_incremental_one_loopt(
     options.get_bool_option("ignore-properties-before-unwind-min");
 }
 
+bool symex_bmc_incremental_one_loopt::is_incremental_loop(
+  const irep_idt &loop_id) const
+{
+  return incr_all_loops || loop_id == incr_loop_id;
+}
+
 bool symex_bmc_incremental_one_loopt::should_stop_unwind(
   const symex_targett::sourcet &source,
   const call_stackt &context,
@@ -55,8 +66,8 @@ bool symex_bmc_incremental_one_loopt::should_stop_unwind(
   tvt abort_unwind_decision;
   unsigned this_loop_limit = std::numeric_limits<unsigned>::max();
 
-  // use the incremental limits if it is the specified incremental loop
-  if(id == incr_loop_id)
+  // use the incremental limits if it is an incremental loop
+  if(is_incremental_loop(id))
   {
     this_loop_limit = incr_max_unwind;
     if(unwind + 1 >= incr_min_unwind)
@@ -106,7 +117,10 @@ bool symex_bmc_incremental_one_loopt::should_stop_unwind(
 
 /// Defines condition for interrupting symbolic execution for incremental BMC
 /// \return True if the back edge encountered during symbolic execution
-///   corresponds to the given loop (incr_loop_id)
+///   corresponds to the given loop (incr_loop_id), or, with
+///   `--incremental-loops`, completes an unwinding deeper than all previous
+///   ones, at one of the unwindings selected by `--unwind-min` and
+///   `--unwind-step`
 bool symex_bmc_incremental_one_loopt::check_break(
   const irep_idt &loop_id,
   unsigned unwind)
@@ -114,8 +128,22 @@ bool symex_bmc_incremental_one_loopt::check_break(
   if(unwind < incr_min_unwind)
     return false;
 
-  // loop specified by incremental-loop
-  return (loop_id == incr_loop_id);
+  // only every incr_step_unwind-th unwinding is checked
+  if((unwind - incr_min_unwind) % incr_step_unwind != 0)
+    return false;
+
+  if(!incr_all_loops)
+  {
+    // loop specified by incremental-loop
+    return (loop_id == incr_loop_id);
+  }
+
+  // unwindings up to the current depth have been checked with another loop
+  if(unwind <= incr_depth)
+    return false;
+
+  incr_depth = unwind;
+  return true;
 }
 
 bool symex_bmc_incremental_one_loopt::from_entry_point_of(
@@ -12,6 +12,14 @@
 #include "symex_bmc.h"
 #include <util/ui_message.h>
 
+/// Symbolic execution that pauses after each unwinding of the loop given by
+/// `--incremental-loop`, so that the properties can be checked before
+/// symbolic execution is resumed. With `--incremental-loops`, all loops are
+/// unwound incrementally in lockstep instead: symbolic execution pauses
+/// whenever a loop reaches an unwinding that no loop has reached before,
+/// and `--unwind-min`/`--unwind-max` apply to every loop. With
+/// `--unwind-step`, symex only pauses at every so many unwindings, which
+/// saves solver calls when failures are expected to be deep.
 class symex_bmc_incremental_one_loopt : public symex_bmct
 {
 public:
@@ -34,8 +42,17 @@ public:
 
 protected:
   const irep_idt incr_loop_id;
+  const bool incr_all_loops;
   const unsigned incr_max_unwind;
   const unsigned incr_min_unwind;
+  const unsigned incr_step_unwind;
+
+  /// The largest unwinding any loop has been paused at with
+  /// `--incremental-loops`
+  unsigned incr_depth = 0;
+
+  /// Return true if the loop \p loop_id is unwound incrementally
+  bool is_incremental_loop(const irep_idt &loop_id) const;
 
   std::unique_ptr<goto_symext::statet> state;
 
@@ -0,0 +1,559 @@
+/*******************************************************************\
+
+Module: Checkpoints of Symbolic Execution
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Checkpoints of Symbolic Execution
+
+#include "symex_checkpoint.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <unordered_map>
+
+#include <util/irep_serialization.h>
+#include <util/message.h>
+#include <util/optional.h>
+#include <util/symbol_table.h>
+
+#include <goto-programs/abstract_goto_model.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
+
+#include <goto-symex/symex_target_equation.h>
+
+/// Writes a single SSA step, leaving out the handles and the flags that
+/// belong to a decision procedure
+static void write_step(
+  std::ostream &out,
+  const SSA_stept &step,
+  irep_serializationt &irepconverter)
+{
+  write_gb_word(out, static_cast<std::size_t>(step.type));
+  irepconverter.write_string_ref(out, step.source.function_id);
+  write_gb_word(out, step.source.pc->location_number);
+  write_gb_word(out, step.source.thread_nr);
+  write_gb_word(out, static_cast<std::size_t>(step.assignment_type));
+  write_gb_word(out, step.atomic_section_id);
+
+  unsigned flags = 0;
+  flags = (flags << 1) | static_cast<int>(step.hidden);
+  flags = (flags << 1) | static_cast<int>(step.formatted);
+  flags = (flags << 1) | static_cast<int>(step.ignore);
+  write_gb_word(out, flags);
+
+  irepconverter.reference_convert(step.guard, out);
+  irepconverter.reference_convert(step.ssa_lhs, out);
+  irepconverter.reference_convert(step.ssa_full_lhs, out);
+  irepconverter.reference_convert(step.original_full_lhs, out);
+  irepconverter.reference_convert(step.ssa_rhs, out);
+  irepconverter.reference_convert(step.cond_expr, out);
+
+  write_gb_string(out, step.comment);
+  irepconverter.write_string_ref(out, step.format_string);
+  irepconverter.write_string_ref(out, step.io_id);
+  irepconverter.write_string_ref(out, step.called_function);
+
+  write_gb_word(out, step.io_args.size());
+  for(const auto &arg : step.io_args)
+    irepconverter.reference_convert(arg, out);
+
+  write_gb_word(out, step.ssa_function_arguments.size());
+  for(const auto &arg : step.ssa_function_arguments)
+    irepconverter.reference_convert(arg, out);
+}
+
+/// Writes the symbols and the steps of a checkpoint
+static void write_symbols_and_steps(
+  std::ostream &out,
+  const symex_target_equationt &equation,
+  const symbol_tablet &symex_symbol_table,
+  irep_serializationt &irepconverter)
+{
+  // the symbols, in the same format as in goto binaries
+  write_goto_binary(out, symex_symbol_table, goto_functionst());
+
+  // the steps, all sharing the same context
+  write_gb_word(out, equation.SSA_steps.size());
+  for(const auto &step : equation.SSA_steps)
+    write_step(out, step, irepconverter);
+}
+
+void write_symex_checkpoint(
+  std::ostream &out,
+  const symex_target_equationt &equation,
+  const symbol_tablet &symex_symbol_table,
+  bool complete)
+{
+  // header
+  out << "SXCP";
+  write_gb_word(out, SYMEX_CHECKPOINT_VERSION);
+  write_gb_word(out, complete ? 1 : 0);
+
+  irep_serializationt::ireps_containert irepc;
+  irep_serializationt irepconverter(irepc);
+  write_symbols_and_steps(out, equation, symex_symbol_table, irepconverter);
+}
+
+/// Write to the file \p filename using \p write, to a temporary file first
+/// so that an earlier version of the file survives if we are interrupted
+/// \return true on error, false otherwise
+static bool write_file(
+  const std::string &filename,
+  messaget &log,
+  const std::function<void(std::ostream &)> &write)
+{
+  const std::string tmp_filename = filename + ".tmp";
+
+  {
+    std::ofstream out(tmp_filename, std::ios::binary);
+
+    if(!out)
+    {
+      log.error() << "failed to open '" << tmp_filename << "'"
+                  << messaget::eom;
+      return true;
+    }
+
+    write(out);
+
+    if(!out.flush())
+    {
+      log.error() << "failed to write '" << tmp_filename << "'"
+                  << messaget::eom;
+      return true;
+    }
+  }
+
+  if(std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+  {
+    // renaming onto an existing file fails on Windows
+    std::remove(filename.c_str());
+    if(std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+    {
+      log.error() << "failed to create '" << filename << "'" << messaget::eom;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool write_symex_checkpoint(
+  const std::string &filename,
+  const symex_target_equationt &equation,
+  const symbol_tablet &symex_symbol_table,
+  bool complete,
+  message_handlert &message_handler)
+{
+  messaget log(message_handler);
+
+  if(write_file(filename, log, [&](std::ostream &out) {
+       write_symex_checkpoint(out, equation, symex_symbol_table, complete);
+     }))
+  {
+    return true;
+  }
+
+  log.statistics() << "Wrote checkpoint of " << equation.SSA_steps.size()
+                   << " steps to " << filename << messaget::eom;
+
+  return false;
+}
+
+void write_equation_dump(
+  std::ostream &out,
+  const abstract_goto_modelt &goto_model,
+  const symex_target_equationt &equation,
+  const symbol_tablet &symex_symbol_table,
+  bool complete,
+  const propertiest &properties)
+{
+  // header
+  out << "SXEQ";
+  write_gb_word(out, SYMEX_CHECKPOINT_VERSION);
+  write_gb_word(out, complete ? 1 : 0);
+
+  irep_serializationt::ireps_containert irepc;
+  irep_serializationt irepconverter(irepc);
+  write_symbols_and_steps(out, equation, symex_symbol_table, irepconverter);
+
+  // the properties, ordered by their ID for the file not to depend on the
+  // order of the hash table
+  std::vector<propertiest::const_iterator> sorted;
+  sorted.reserve(properties.size());
+  for(auto it = properties.begin(); it != properties.end(); ++it)
+    sorted.push_back(it);
+  std::sort(
+    sorted.begin(),
+    sorted.end(),
+    [](propertiest::const_iterator a, propertiest::const_iterator b) {
+      return id2string(a->first) < id2string(b->first);
+    });
+
+  // like the steps, the properties refer to their instructions by the
+  // function and the location number
+  std::unordered_map<const goto_programt::instructiont *, irep_idt>
+    functions_of_assertions;
+  for(const auto &function_pair : goto_model.get_goto_functions().function_map)
+  {
+    forall_goto_program_instructions(it, function_pair.second.body)
+    {
+      if(it->is_assert())
+        functions_of_assertions.emplace(&*it, function_pair.first);
+    }
+  }
+
+  write_gb_word(out, sorted.size());
+  for(const auto &property_it : sorted)
+  {
+    const property_infot &property_info = property_it->second;
+    irepconverter.write_string_ref(out, property_it->first);
+    irepconverter.write_string_ref(
+      out, functions_of_assertions[&*property_info.pc]);
+    write_gb_word(out, property_info.pc->location_number);
+    write_gb_string(out, property_info.description);
+    write_gb_word(out, static_cast<std::size_t>(property_info.status));
+  }
+}
+
+bool write_equation_dump(
+  const std::string &filename,
+  const abstract_goto_modelt &goto_model,
+  const symex_target_equationt &equation,
+  const symbol_tablet &symex_symbol_table,
+  bool complete,
+  const propertiest &properties,
+  message_handlert &message_handler)
+{
+  messaget log(message_handler);
+
+  if(write_file(filename, log, [&](std::ostream &out) {
+       write_equation_dump(
+         out, goto_model, equation, symex_symbol_table, complete, properties);
+     }))
+  {
+    return true;
+  }
+
+  log.status() << "Wrote equation of " << equation.SSA_steps.size()
+               << " steps and " << properties.size() << " properties to "
+               << filename << messaget::eom;
+
+  return false;
+}
+
+namespace
+{
+/// Maps the location numbers of the instructions of the functions that
+/// SSA steps refer to back to the instructions
+class instruction_mapt
+{
+public:
+  explicit instruction_mapt(abstract_goto_modelt &goto_model)
+    : goto_model(goto_model)
+  {
+  }
+
+  /// \return the instruction with the \p location_number in the function
+  ///   \p function_id, or an empty optional if there is no such instruction
+  optionalt<goto_programt::const_targett>
+  get(const irep_idt &function_id, std::size_t location_number)
+  {
+    auto entry = functions.emplace(function_id, instructionst{});
+
+    if(entry.second && goto_model.can_produce_function(function_id))
+    {
+      const goto_programt &body =
+        goto_model.get_goto_function(function_id).body;
+      forall_goto_program_instructions(it, body)
+        entry.first->second.emplace(it->location_number, it);
+    }
+
+    const auto instruction_it = entry.first->second.find(location_number);
+    if(instruction_it == entry.first->second.end())
+      return {};
+
+    return instruction_it->second;
+  }
+
+protected:
+  typedef std::unordered_map<std::size_t, goto_programt::const_targett>
+    instructionst;
+
+  abstract_goto_modelt &goto_model;
+  std::unordered_map<irep_idt, instructionst> functions;
+};
+} // namespace
+
+/// Reads a single SSA step written by write_step and appends it to
+/// \p equation
+/// \return true on error, false otherwise
+static bool read_step(
+  std::istream &in,
+  instruction_mapt &instructions,
+  irep_serializationt &irepconverter,
+  symex_target_equationt &equation)
+{
+  const auto type =
+    static_cast<goto_trace_stept::typet>(irepconverter.read_gb_word(in));
+  const irep_idt function_id = irepconverter.read_string_ref(in);
+  const std::size_t location_number = irepconverter.read_gb_word(in);
+
+  if(!in)
+    return true;
+
+  const auto pc = instructions.get(function_id, location_number);
+  if(!pc.has_value())
+    return true;
+
+  equation.SSA_steps.emplace_back(
+    symex_targett::sourcet(function_id, *pc), type);
+  SSA_stept &step = equation.SSA_steps.back();
+
+  step.source.thread_nr =
+    static_cast<unsigned>(irepconverter.read_gb_word(in));
+  step.assignment_type = static_cast<symex_targett::assignment_typet>(
+    irepconverter.read_gb_word(in));
+  step.atomic_section_id =
+    static_cast<unsigned>(irepconverter.read_gb_word(in));
+
+  const std::size_t flags = irepconverter.read_gb_word(in);
+  step.hidden = (flags & (1 << 2)) != 0;
+  step.formatted = (flags & (1 << 1)) != 0;
+  step.ignore = (flags & 1) != 0;
+
+  step.guard = static_cast<const exprt &>(irepconverter.reference_convert(in));
+  step.ssa_lhs =
+    static_cast<const ssa_exprt &>(irepconverter.reference_convert(in));
+  step.ssa_full_lhs =
+    static_cast<const exprt &>(irepconverter.reference_convert(in));
+  step.original_full_lhs =
+    static_cast<const exprt &>(irepconverter.reference_convert(in));
+  step.ssa_rhs =
+    static_cast<const exprt &>(irepconverter.reference_convert(in));
+  step.cond_expr =
+    static_cast<const exprt &>(irepconverter.reference_convert(in));
+
+  step.comment = id2string(irepconverter.read_gb_string(in));
+  step.format_string = irepconverter.read_string_ref(in);
+  step.io_id = irepconverter.read_string_ref(in);
+  step.called_function = irepconverter.read_string_ref(in);
+
+  const std::size_t io_args = irepconverter.read_gb_word(in);
+  for(std::size_t i = 0; i < io_args && in; ++i)
+  {
+    step.io_args.push_back(
+      static_cast<const exprt &>(irepconverter.reference_convert(in)));
+  }
+
+  const std::size_t function_arguments = irepconverter.read_gb_word(in);
+  for(std::size_t i = 0; i < function_arguments && in; ++i)
+  {
+    step.ssa_function_arguments.push_back(
+      static_cast<const exprt &>(irepconverter.reference_convert(in)));
+  }
+
+  return !in;
+}
+
+/// Reads the symbols and the steps written by write_symbols_and_steps
+/// \return true on error, false otherwise
+static bool read_symbols_and_steps(
+  std::istream &in,
+  instruction_mapt &instructions,
+  irep_serializationt &irepconverter,
+  symex_target_equationt &equation,
+  symbol_tablet &symex_symbol_table,
+  message_handlert &message_handler)
+{
+  goto_functionst goto_functions;
+  if(read_bin_goto_object(
+       in, "", symex_symbol_table, goto_functions, message_handler))
+  {
+    return true;
+  }
+
+  const std::size_t number_of_steps = irepconverter.read_gb_word(in);
+  equation.SSA_steps.reserve(equation.SSA_steps.size() + number_of_steps);
+
+  for(std::size_t i = 0; i < number_of_steps; ++i)
+  {
+    if(read_step(in, instructions, irepconverter, equation))
+      return true;
+  }
+
+  return false;
+}
+
+/// Reads the header \p magic followed by the version of the format
+/// \return true on error, false otherwise
+static bool read_header(
+  std::istream &in,
+  const char (&magic)[5],
+  const std::string &what,
+  messaget &log)
+{
+  char hdr[4];
+  if(
+    !in.read(hdr, sizeof(hdr)) || hdr[0] != magic[0] || hdr[1] != magic[1] ||
+    hdr[2] != magic[2] || hdr[3] != magic[3])
+  {
+    log.error() << "not a " << what << messaget::eom;
+    return true;
+  }
+
+  if(irep_serializationt::read_gb_word(in) != SYMEX_CHECKPOINT_VERSION)
+  {
+    log.error() << "unsupported version of " << what << messaget::eom;
+    return true;
+  }
+
+  return false;
+}
+
+bool read_symex_checkpoint(
+  std::istream &in,
+  abstract_goto_modelt &goto_model,
+  symex_target_equationt &equation,
+  symbol_tablet &symex_symbol_table,
+  bool &complete,
+  message_handlert &message_handler)
+{
+  messaget log(message_handler);
+
+  if(read_header(in, "SXCP", "symex checkpoint", log))
+    return true;
+
+  complete = irep_serializationt::read_gb_word(in) != 0;
+
+  irep_serializationt::ireps_containert irepc;
+  irep_serializationt irepconverter(irepc);
+  instruction_mapt instructions(goto_model);
+
+  if(read_symbols_and_steps(
+       in,
+       instructions,
+       irepconverter,
+       equation,
+       symex_symbol_table,
+       message_handler))
+  {
+    log.error() << "symex checkpoint is truncated or does not match the "
+                << "program" << messaget::eom;
+    return true;
+  }
+
+  return false;
+}
+
+bool read_symex_checkpoint(
+  const std::string &filename,
+  abstract_goto_modelt &goto_model,
+  symex_target_equationt &equation,
+  symbol_tablet &symex_symbol_table,
+  bool &complete,
+  message_handlert &message_handler)
+{
+  std::ifstream in(filename, std::ios::binary);
+
+  if(!in)
+  {
+    messaget log(message_handler);
+    log.error() << "failed to open '" << filename << "'" << messaget::eom;
+    return true;
+  }
+
+  return read_symex_checkpoint(
+    in, goto_model, equation, symex_symbol_table, complete, message_handler);
+}
+
+bool read_equation_dump(
+  std::istream &in,
+  abstract_goto_modelt &goto_model,
+  symex_target_equationt &equation,
+  symbol_tablet &symex_symbol_table,
+  bool &complete,
+  propertiest &properties,
+  message_handlert &message_handler)
+{
+  messaget log(message_handler);
+
+  if(read_header(in, "SXEQ", "equation dump", log))
+    return true;
+
+  complete = irep_serializationt::read_gb_word(in) != 0;
+
+  irep_serializationt::ireps_containert irepc;
+  irep_serializationt irepconverter(irepc);
+  instruction_mapt instructions(goto_model);
+
+  bool error = read_symbols_and_steps(
+    in,
+    instructions,
+    irepconverter,
+    equation,
+    symex_symbol_table,
+    message_handler);
+
+  const std::size_t number_of_properties =
+    error ? 0 : irepconverter.read_gb_word(in);
+  for(std::size_t i = 0; i < number_of_properties && !error; ++i)
+  {
+    const irep_idt property_id = irepconverter.read_string_ref(in);
+    const irep_idt function_id = irepconverter.read_string_ref(in);
+    const std::size_t location_number = irepconverter.read_gb_word(in);
+    const std::string description = id2string(irepconverter.read_gb_string(in));
+    const auto status =
+      static_cast<property_statust>(irepconverter.read_gb_word(in));
+
+    const auto pc = instructions.get(function_id, location_number);
+    if(!in || !pc.has_value())
+      error = true;
+    else
+      properties.emplace(property_id, property_infot{*pc, description, status});
+  }
+
+  if(error || !in)
+  {
+    log.error() << "equation dump is truncated or does not match the "
+                << "program" << messaget::eom;
+    return true;
+  }
+
+  return false;
+}
+
+bool read_equation_dump(
+  const std::string &filename,
+  abstract_goto_modelt &goto_model,
+  symex_target_equationt &equation,
+  symbol_tablet &symex_symbol_table,
+  bool &complete,
+  propertiest &properties,
+  message_handlert &message_handler)
+{
+  std::ifstream in(filename, std::ios::binary);
+
+  if(!in)
+  {
+    messaget log(message_handler);
+    log.error() << "failed to open '" << filename << "'" << messaget::eom;
+    return true;
+  }
+
+  return read_equation_dump(
+    in,
+    goto_model,
+    equation,
+    symex_symbol_table,
+    complete,
+    properties,
+    message_handler);
+}
@@ -0,0 +1,131 @@
+/*******************************************************************\
+
+Module: Checkpoints of Symbolic Execution
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Checkpoints of Symbolic Execution
+
+#ifndef CPROVER_GOTO_CHECKER_SYMEX_CHECKPOINT_H
+#define CPROVER_GOTO_CHECKER_SYMEX_CHECKPOINT_H
+
+#include <iosfwd>
+#include <string>
+
+#include "properties.h"
+
+class abstract_goto_modelt;
+class message_handlert;
+class symbol_tablet;
+class symex_target_equationt;
+
+#define SYMEX_CHECKPOINT_VERSION 1
+
+/// Write the SSA steps of \p equation and the symbols \p symex_symbol_table
+/// generated by symbolic execution to \p out, using irep_serializationt.
+/// Instructions are identified by their function and location number, and
+/// anything a decision procedure has done to the steps is left out.
+/// \param out: output stream
+/// \param equation: the equation generated so far
+/// \param symex_symbol_table: the symbols generated so far
+/// \param complete: whether symbolic execution has finished, i.e., the
+///   equation is not a prefix of the one for the whole program
+void write_symex_checkpoint(
+  std::ostream &out,
+  const symex_target_equationt &equation,
+  const symbol_tablet &symex_symbol_table,
+  bool complete);
+
+/// Write a checkpoint to the file \p filename, which replaces an earlier
+/// checkpoint only once the new one has been written completely
+/// \return true on error, false otherwise
+bool write_symex_checkpoint(
+  const std::string &filename,
+  const symex_target_equationt &equation,
+  const symbol_tablet &symex_symbol_table,
+  bool complete,
+  message_handlert &message_handler);
+
+/// Read a checkpoint written by write_symex_checkpoint for the program
+/// \p goto_model, appending its steps to \p equation and its symbols to
+/// \p symex_symbol_table
+/// \param in: input stream
+/// \param goto_model: the program the checkpoint was written for
+/// \param [out] equation: receives the SSA steps
+/// \param [out] symex_symbol_table: receives the symbols generated by
+///   symbolic execution
+/// \param [out] complete: whether symbolic execution had finished
+/// \param message_handler: for error messages
+/// \return true on error, false otherwise
+bool read_symex_checkpoint(
+  std::istream &in,
+  abstract_goto_modelt &goto_model,
+  symex_target_equationt &equation,
+  symbol_tablet &symex_symbol_table,
+  bool &complete,
+  message_handlert &message_handler);
+
+/// Read the checkpoint in the file \p filename
+/// \return true on error, false otherwise
+bool read_symex_checkpoint(
+  const std::string &filename,
+  abstract_goto_modelt &goto_model,
+  symex_target_equationt &equation,
+  symbol_tablet &symex_symbol_table,
+  bool &complete,
+  message_handlert &message_handler);
+
+/// Write the \p equation of the program \p goto_model, once it has been
+/// post-processed, with the symbols \p symex_symbol_table and the
+/// \p properties, to \p out for \ref read_equation_dump to decide the
+/// properties without running symbolic execution. The steps and symbols are
+/// written as in a checkpoint, followed by the identifier, instruction,
+/// description and status of each property.
+void write_equation_dump(
+  std::ostream &out,
+  const abstract_goto_modelt &goto_model,
+  const symex_target_equationt &equation,
+  const symbol_tablet &symex_symbol_table,
+  bool complete,
+  const propertiest &properties);
+
+/// Write an equation dump to the file \p filename
+/// \return true on error, false otherwise
+bool write_equation_dump(
+  const std::string &filename,
+  const abstract_goto_modelt &goto_model,
+  const symex_target_equationt &equation,
+  const symbol_tablet &symex_symbol_table,
+  bool complete,
+  const propertiest &properties,
+  message_handlert &message_handler);
+
+/// Read an equation dump written by write_equation_dump for the program
+/// \p goto_model, appending its steps to \p equation, its symbols to
+/// \p symex_symbol_table and its properties to \p properties, and setting
+/// \p complete to whether symbolic execution had finished
+/// \return true on error, false otherwise
+bool read_equation_dump(
+  std::istream &in,
+  abstract_goto_modelt &goto_model,
+  symex_target_equationt &equation,
+  symbol_tablet &symex_symbol_table,
+  bool &complete,
+  propertiest &properties,
+  message_handlert &message_handler);
+
+/// Read the equation dump in the file \p filename
+/// \return true on error, false otherwise
+bool read_equation_dump(
+  const std::string &filename,
+  abstract_goto_modelt &goto_model,
+  symex_target_equationt &equation,
+  symbol_tablet &symex_symbol_table,
+  bool &complete,
+  propertiest &properties,
+  message_handlert &message_handler);
+
+#endif // CPROVER_GOTO_CHECKER_SYMEX_CHECKPOINT_H
@@ -25,6 +25,7 @@ Author: Peter Schrammel
 #include <goto-programs/link_to_library.h>
 #include <goto-programs/loop_ids.h>
 #include <goto-programs/process_goto_program.h>
+#include <goto-programs/read_bin_goto_object.h>
 #include <goto-programs/remove_skip.h>
 #include <goto-programs/set_properties.h>
 #include <goto-programs/show_properties.h>
@@ -144,6 +145,20 @@ int goto_diff_parse_optionst::doit()
 
   register_languages();
 
+  // A syntactic diff of two goto binaries compares the fingerprints stored
+  // with the function bodies, which are never decoded. The functions are
+  // thus compared as compiled, before the instrumentation below.
+  if(
+    cmdline.isset("syntactic") && !cmdline.isset("cover") &&
+    !cmdline.isset("show-properties") && !cmdline.isset("show-loops") &&
+    !cmdline.isset("show-goto-functions") &&
+    !cmdline.isset("list-goto-functions"))
+  {
+    const int result = diff_fingerprints(options);
+    if(result != -1)
+      return result;
+  }
+
   goto_modelt goto_model1 =
     initialize_goto_model({cmdline.args[0]}, ui_message_handler, options);
   if(process_goto_program(options, goto_model1))
@@ -207,6 +222,69 @@ int goto_diff_parse_optionst::doit()
   return CPROVER_EXIT_SUCCESS;
 }
 
+/// \return whether \p filename is a plain goto binary, as opposed to source
+///   code or a goto binary embedded in an object file
+static bool is_plain_goto_binary(const std::string &filename)
+{
+  std::ifstream in(filename, std::ios::binary);
+  char hdr[4];
+  return in.read(hdr, 4) && hdr[0] == 0x7f && hdr[1] == 'G' &&
+         hdr[2] == 'B' && hdr[3] == 'F';
+}
+
+/// Do a syntactic diff by the fingerprints of the function bodies stored in
+/// the two goto binaries given
+/// \return the exit code, or -1 if the inputs are not both plain goto
+///   binaries
+int goto_diff_parse_optionst::diff_fingerprints(const optionst &options)
+{
+  if(
+    !is_plain_goto_binary(cmdline.args[0]) ||
+    !is_plain_goto_binary(cmdline.args[1]))
+  {
+    return -1;
+  }
+
+  goto_modelt goto_model1, goto_model2;
+  goto_program_fingerprintst fingerprints1, fingerprints2;
+
+  std::ifstream in1(cmdline.args[0], std::ios::binary);
+  if(read_bin_goto_object_fingerprints(
+       in1,
+       cmdline.args[0],
+       goto_model1.symbol_table,
+       goto_model1.goto_functions,
+       ui_message_handler,
+       fingerprints1))
+  {
+    return CPROVER_EXIT_INCORRECT_TASK;
+  }
+
+  std::ifstream in2(cmdline.args[1], std::ios::binary);
+  if(read_bin_goto_object_fingerprints(
+       in2,
+       cmdline.args[1],
+       goto_model2.symbol_table,
+       goto_model2.goto_functions,
+       ui_message_handler,
+       fingerprints2))
+  {
+    return CPROVER_EXIT_INCORRECT_TASK;
+  }
+
+  syntactic_difft sd(
+    goto_model1,
+    fingerprints1,
+    goto_model2,
+    fingerprints2,
+    options,
+    ui_message_handler);
+  sd();
+  sd.output_functions();
+
+  return CPROVER_EXIT_SUCCESS;
+}
+
 bool goto_diff_parse_optionst::process_goto_program(
   const optionst &options,
   goto_modelt &goto_model)
@@ -271,7 +349,10 @@ void goto_diff_parse_optionst::help()
     "Diff options:\n"
     HELP_SHOW_GOTO_FUNCTIONS
     HELP_SHOW_PROPERTIES
-    " --syntactic                  do syntactic diff (default)\n"
+    " --syntactic                  do syntactic diff (default); two goto binaries\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              are compared by the fingerprints of the function\n"
+    "                              bodies, which are not loaded\n"
     " -u | --unified               output unified diff\n"
     " --change-impact | \n"
     "  --forward-impact |\n"
@@ -36,7 +36,7 @@ class optionst;
   "(verbosity):(version)" \
   OPT_FLUSH \
   OPT_TIMESTAMP \
-  "u(unified)(change-impact)(forward-impact)(backward-impact)" \
+  "(syntactic)u(unified)(change-impact)(forward-impact)(backward-impact)" \
   "(compact-output)"
 // clang-format on
 
@@ -54,6 +54,8 @@ protected:
   void get_command_line_options(optionst &options);
 
   bool process_goto_program(const optionst &options, goto_modelt &goto_model);
+
+  int diff_fingerprints(const optionst &options);
 };
 
 #endif // CPROVER_GOTO_DIFF_GOTO_DIFF_PARSE_OPTIONS_H
@@ -13,17 +13,29 @@ Author: Peter Schrammel
 
 #include <goto-programs/goto_model.h>
 
+/// \return whether the function of \p gf_entry has a body, as per
+///   \p fingerprints unless that is nullptr
+static bool body_available(
+  const goto_functionst::function_mapt::value_type &gf_entry,
+  const goto_program_fingerprintst *fingerprints)
+{
+  if(fingerprints == nullptr)
+    return gf_entry.second.body_available();
+  else
+    return fingerprints->find(gf_entry.first) != fingerprints->end();
+}
+
 bool syntactic_difft::operator()()
 {
   for(const auto &gf_entry : goto_model1.goto_functions.function_map)
   {
-    if(!gf_entry.second.body_available())
+    if(!body_available(gf_entry, fingerprints1))
       continue;
 
     goto_functionst::function_mapt::const_iterator f_it =
       goto_model2.goto_functions.function_map.find(gf_entry.first);
     if(f_it==goto_model2.goto_functions.function_map.end() ||
-       !f_it->second.body_available())
+       !body_available(*f_it, fingerprints2))
     {
       deleted_functions.insert(gf_entry.first);
       continue;
@@ -69,7 +81,12 @@ bool syntactic_difft::operator()()
       continue;
     }
 
-    if(!gf_entry.second.body.equals(f_it->second.body))
+    const bool body_changed =
+      fingerprints1 != nullptr
+        ? fingerprints1->at(gf_entry.first) !=
+            fingerprints2->at(gf_entry.first)
+        : !gf_entry.second.body.equals(f_it->second.body);
+    if(body_changed)
     {
       modified_functions.insert(gf_entry.first);
       continue;
@@ -77,7 +94,7 @@ bool syntactic_difft::operator()()
   }
   for(const auto &gf_entry : goto_model2.goto_functions.function_map)
   {
-    if(!gf_entry.second.body_available())
+    if(!body_available(gf_entry, fingerprints2))
       continue;
 
     total_functions_count++;
@@ -85,7 +102,7 @@ bool syntactic_difft::operator()()
     goto_functionst::function_mapt::const_iterator f_it =
       goto_model1.goto_functions.function_map.find(gf_entry.first);
     if(f_it==goto_model1.goto_functions.function_map.end() ||
-       !f_it->second.body_available())
+       !body_available(*f_it, fingerprints1))
     {
       new_functions.insert(gf_entry.first);
     }
@@ -12,6 +12,8 @@ Author: Peter Schrammel
 #ifndef CPROVER_GOTO_DIFF_SYNTACTIC_DIFF_H
 #define CPROVER_GOTO_DIFF_SYNTACTIC_DIFF_H
 
+#include <goto-programs/read_bin_goto_object.h>
+
 #include "goto_diff.h"
 
 class syntactic_difft:public goto_difft
@@ -22,11 +24,33 @@ public:
     const goto_modelt &_goto_model2,
     const optionst &_options,
     ui_message_handlert &_message_handler)
-    : goto_difft(_goto_model1, _goto_model2, _options, _message_handler)
+    : goto_difft(_goto_model1, _goto_model2, _options, _message_handler),
+      fingerprints1(nullptr),
+      fingerprints2(nullptr)
+  {
+  }
+
+  /// Compare the functions by the fingerprints of their bodies, the models
+  /// having the symbols only, as read by
+  /// \ref read_bin_goto_object_fingerprints
+  syntactic_difft(
+    const goto_modelt &_goto_model1,
+    const goto_program_fingerprintst &_fingerprints1,
+    const goto_modelt &_goto_model2,
+    const goto_program_fingerprintst &_fingerprints2,
+    const optionst &_options,
+    ui_message_handlert &_message_handler)
+    : goto_difft(_goto_model1, _goto_model2, _options, _message_handler),
+      fingerprints1(&_fingerprints1),
+      fingerprints2(&_fingerprints2)
   {
   }
 
   virtual bool operator()();
+
+protected:
+  const goto_program_fingerprintst *fingerprints1;
+  const goto_program_fingerprintst *fingerprints2;
 };
 
 #endif // CPROVER_GOTO_DIFF_SYNTACTIC_DIFF_H
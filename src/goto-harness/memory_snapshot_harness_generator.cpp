@@ -12,6 +12,7 @@ Author: Daniel Poetzl
 #include "memory_snapshot_harness_generator_options.h"
 
 #include <goto-programs/goto_convert_functions.h>
+#include <goto-programs/read_goto_binary.h>
 
 #include <json/json_parser.h>
 
@@ -327,6 +328,21 @@ void memory_snapshot_harness_generatort::get_memory_snapshot(
   const std::string &file,
   symbol_tablet &snapshot) const
 {
+  if(is_goto_binary(file, message_handler))
+  {
+    // a symbol table written by memory-analyzer --symtab-snapshot
+    // --output-file
+    auto goto_model = read_goto_binary(file, message_handler);
+    if(!goto_model.has_value())
+    {
+      throw deserialization_exceptiont(
+        "failed to read goto binary memory snapshot");
+    }
+
+    snapshot.swap(goto_model->symbol_table);
+    return;
+  }
+
   jsont json;
 
   const bool r = parse_json(memory_snapshot_file, message_handler, json);
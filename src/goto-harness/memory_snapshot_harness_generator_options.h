@@ -35,7 +35,8 @@ Author: Diffblue Ltd.
   "memory snapshot harness generator (--harness-type\n"                        \
   "  initialise-from-memory-snapshot)\n\n"                                     \
   "--" MEMORY_SNAPSHOT_HARNESS_SNAPSHOT_OPT " <file>      initialise memory "  \
-  "from JSON memory snapshot\n"                                                \
+  "from JSON or goto binary\n"                                                 \
+  "                              memory snapshot\n"                            \
   "--" MEMORY_SNAPSHOT_HARNESS_INITIAL_GOTO_LOC_OPT " <func[:<n>]>\n"          \
   "                              use given function and location number as "   \
   "entry\n                              point\n"                               \
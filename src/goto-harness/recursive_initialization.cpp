@@ -738,6 +738,27 @@ code_blockt recursive_initializationt::build_pointer_constructor(
   return body;
 }
 
+/// \return true if objects of type \p type hold a pointer, and hence cannot
+///   be initialised by a nondet value
+static bool contains_pointer(const typet &type, const namespacet &ns)
+{
+  if(type.id() == ID_pointer)
+    return true;
+  else if(type.id() == ID_array)
+    return contains_pointer(to_array_type(type).subtype(), ns);
+  else if(type.id() == ID_struct_tag || type.id() == ID_union_tag)
+  {
+    for(const auto &component :
+        to_struct_union_type(ns.follow(type)).components())
+    {
+      if(contains_pointer(component.type(), ns))
+        return true;
+    }
+  }
+
+  return false;
+}
+
 code_blockt recursive_initializationt::build_array_constructor(
   const exprt &depth,
   const symbol_exprt &result)
@@ -746,6 +767,13 @@ code_blockt recursive_initializationt::build_array_constructor(
   const typet &type = result.type().subtype();
   PRECONDITION(type.id() == ID_array);
   const array_typet &array_type = to_array_type(type);
+
+  // arrays of plain data get a single nondet value rather than a call of the
+  // constructor of the element type for each of their elements
+  const namespacet ns{goto_model.symbol_table};
+  if(!contains_pointer(array_type.subtype(), ns))
+    return build_nondet_constructor(result);
+
   const auto array_size =
     numeric_cast_v<std::size_t>(to_constant_expr(array_type.size()));
   code_blockt body{};
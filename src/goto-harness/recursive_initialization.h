@@ -9,6 +9,7 @@ Author: Diffblue Ltd.
 #ifndef CPROVER_GOTO_HARNESS_RECURSIVE_INITIALIZATION_H
 #define CPROVER_GOTO_HARNESS_RECURSIVE_INITIALIZATION_H
 
+#include <list>
 #include <map>
 #include <set>
 #include <unordered_set>
@@ -19,8 +19,10 @@ Author: Matt Lewis
 #include <util/arith_tools.h>
 #include <util/find_symbols.h>
 
+#include <algorithm>
 #include <iostream>
 #include <list>
+#include <vector>
 
 #include "accelerator.h"
 #include "enumerating_loop_acceleration.h"
@@ -609,14 +611,22 @@ int acceleratet::accelerate_loops()
 {
   int num_accelerated=0;
 
-  for(natural_loops_mutablet::loop_mapt::iterator it =
-      natural_loops.loop_map.begin();
-      it!=natural_loops.loop_map.end();
-      ++it)
-  {
-    goto_programt::targett t=it->first;
+  // The loop map is ordered by the addresses of the instructions, which
+  // differ from run to run. Accelerate the loops in program order instead,
+  // such that the accelerators are inserted in a deterministic order.
+  std::vector<goto_programt::targett> loop_headers;
+  loop_headers.reserve(natural_loops.loop_map.size());
+  for(const auto &loop : natural_loops.loop_map)
+    loop_headers.push_back(loop.first);
+  std::sort(
+    loop_headers.begin(),
+    loop_headers.end(),
+    [](goto_programt::targett a, goto_programt::targett b) {
+      return a->location_number < b->location_number;
+    });
+
+  for(goto_programt::targett t : loop_headers)
     num_accelerated += accelerate_loop(t);
-  }
 
   program.update();
 
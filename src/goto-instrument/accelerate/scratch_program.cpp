@@ -63,13 +63,14 @@ bool scratch_programt::check_sat(bool do_slice, guard_managert &guard_manager)
     return false;
   }
 
-  equation.convert(*checker);
+  decision_proceduret &checker = get_checker();
+  equation.convert(checker);
 
 #ifdef DEBUG
   std::cout << "Finished symex, invoking decision procedure.\n";
 #endif
 
-  switch((*checker)())
+  switch(checker())
   {
   case decision_proceduret::resultt::D_ERROR:
     throw "error running the SMT solver";
@@ -88,7 +89,19 @@ bool scratch_programt::check_sat(bool do_slice, guard_managert &guard_manager)
 
 exprt scratch_programt::eval(const exprt &e)
 {
-  return checker->get(symex_state->rename<L2>(e, ns).get());
+  return get_checker().get(symex_state->rename<L2>(e, ns).get());
+}
+
+decision_proceduret &scratch_programt::get_checker()
+{
+  if(!checker)
+  {
+    // a bv_pointerst over a satcheckt could be used instead
+    checker = util_make_unique<smt2_dect>(
+      ns, "accelerate", "", "", smt2_dect::solvert::Z3, message_handler);
+  }
+
+  return *checker;
 }
 
 void scratch_programt::append(goto_programt::instructionst &new_instructions)
@@ -73,10 +73,7 @@ public:
       path_storage(),
       options(get_default_options()),
       symex(mh, symbol_table, equation, options, path_storage, guard_manager),
-      satcheck(util_make_unique<satcheckt>(mh)),
-      satchecker(ns, *satcheck, mh),
-      z3(ns, "accelerate", "", "", smt2_dect::solvert::Z3, mh),
-      checker(&z3) // checker(&satchecker)
+      message_handler(mh)
   {
   }
 
@@ -112,10 +109,13 @@ protected:
   optionst options;
   scratch_program_symext symex;
 
-  std::unique_ptr<propt> satcheck;
-  bv_pointerst satchecker;
-  smt2_dect z3;
-  decision_proceduret *checker;
+  message_handlert &message_handler;
+
+  /// The decision procedure, only created once a query is made, as many
+  /// scratch programs are never checked
+  std::unique_ptr<decision_proceduret> checker;
+  decision_proceduret &get_checker();
+
   static optionst get_default_options();
 };
 
@@ -0,0 +1,161 @@
+/*******************************************************************\
+
+Module: Per-Function Models for Checking Contracts
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Per-Function Models for Checking Contracts
+
+#include "contract_harnesses.h"
+
+#include <util/c_types.h>
+#include <util/irep_hash.h>
+#include <util/message.h>
+
+#include <analyses/call_graph.h>
+#include <analyses/call_graph_helpers.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/write_goto_binary.h>
+
+#include <linking/static_lifetime_init.h>
+
+#include "code_contracts.h"
+
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+/// \return a hash of \p irep including its comments that, unlike
+///   irept::full_hash, does not depend on the numbering of strings and is
+///   thus the same in each run
+static std::size_t stable_hash(const irept &irep)
+{
+  std::size_t result = std::hash<std::string>{}(irep.id_string());
+
+  for(const auto &sub : irep.get_sub())
+    result = hash_combine(result, stable_hash(sub));
+
+  for(const auto &named_sub : irep.get_named_sub())
+  {
+    result =
+      hash_combine(result, std::hash<std::string>{}(id2string(named_sub.first)));
+    result = hash_combine(result, stable_hash(named_sub.second));
+  }
+
+  return result;
+}
+
+/// \return a hash of the bodies of the functions the entry point
+///   \p function_id may run in \p goto_model, and of the initialisation of
+///   the static objects
+static std::size_t
+harness_hash(const goto_modelt &goto_model, const irep_idt &function_id)
+{
+  const goto_functionst &goto_functions = goto_model.goto_functions;
+  const call_grapht call_graph =
+    call_grapht::create_from_root_function(goto_model, function_id, false);
+  std::set<irep_idt> functions =
+    get_reachable_functions(call_graph.get_directed_graph(), function_id);
+  functions.insert(INITIALIZE_FUNCTION);
+
+  // the call graph does not know the targets of function pointers
+  for(const auto &id : functions)
+  {
+    const auto entry = goto_functions.function_map.find(id);
+    if(entry == goto_functions.function_map.end())
+      continue;
+
+    for(const auto &instruction : entry->second.body.instructions)
+    {
+      if(
+        instruction.is_function_call() &&
+        instruction.get_function_call().function().id() != ID_symbol)
+      {
+        for(const auto &other : goto_functions.function_map)
+          functions.insert(other.first);
+        break;
+      }
+    }
+  }
+
+  std::size_t result = 0;
+  for(const auto &id : functions)
+  {
+    const auto entry = goto_functions.function_map.find(id);
+    if(entry == goto_functions.function_map.end())
+      continue;
+
+    const goto_programt &body = entry->second.body;
+    std::unordered_map<const goto_programt::instructiont *, std::size_t>
+      indices;
+    for(const auto &instruction : body.instructions)
+      indices.emplace(&instruction, indices.size());
+
+    result = hash_combine(result, std::hash<std::string>{}(id2string(id)));
+    for(const auto &instruction : body.instructions)
+    {
+      const std::size_t type = instruction.type;
+      result = hash_combine(result, type);
+      result = hash_combine(result, stable_hash(instruction.get_code()));
+      result = hash_combine(result, stable_hash(instruction.guard));
+      for(const auto &target : instruction.targets)
+        result = hash_combine(result, indices.at(&*target));
+    }
+  }
+
+  return result;
+}
+
+bool write_contract_harnesses(
+  const goto_modelt &goto_model,
+  const std::string &directory,
+  messaget &log)
+{
+  const namespacet ns(goto_model.symbol_table);
+
+  for(const auto &gf_entry : goto_model.goto_functions.function_map)
+  {
+    const symbolt *symbol;
+    if(
+      ns.lookup(gf_entry.first, symbol) ||
+      !can_cast_type<code_with_contract_typet>(symbol->type) ||
+      !to_code_with_contract_type(symbol->type).has_contract())
+    {
+      continue;
+    }
+
+    goto_modelt harness;
+    harness.symbol_table = goto_model.symbol_table;
+    harness.goto_functions.copy_from(goto_model.goto_functions);
+
+    code_contractst contracts(harness, log);
+    if(
+      contracts.replace_calls() ||
+      contracts.enforce_contracts({id2string(gf_entry.first)}))
+    {
+      return true;
+    }
+
+    std::ostringstream filename;
+    filename << directory << '/' << gf_entry.first << '.' << std::hex
+             << harness_hash(harness, gf_entry.first) << ".gb";
+
+    if(std::ifstream(filename.str()))
+    {
+      log.status() << "Contract harness for " << gf_entry.first
+                   << " unchanged: " << filename.str() << messaget::eom;
+      continue;
+    }
+
+    log.status() << "Writing contract harness for " << gf_entry.first << ": "
+                 << filename.str() << messaget::eom;
+    if(write_goto_binary(filename.str(), harness, log.get_message_handler()))
+      return true;
+  }
+
+  return false;
+}
@@ -0,0 +1,40 @@
+/*******************************************************************\
+
+Module: Per-Function Models for Checking Contracts
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Per-Function Models for Checking Contracts
+
+#ifndef CPROVER_GOTO_INSTRUMENT_CONTRACT_HARNESSES_H
+#define CPROVER_GOTO_INSTRUMENT_CONTRACT_HARNESSES_H
+
+#include <string>
+
+class goto_modelt;
+class messaget;
+
+/// For each function `f` with a contract, write a goto binary to
+/// \p directory that enforces the contract of `f` with all calls replaced by
+/// the contracts of their callees, which `cbmc --function f` then checks.
+/// The models are independent of each other and can thus be checked as
+/// parallel jobs. Each file is named `f.<hash>.gb`, where the hash covers
+/// the functions the model runs, and a file that exists already is not
+/// written again, so that only the contracts of changed functions need to be
+/// checked again.
+/// \return true on error
+bool write_contract_harnesses(
+  const goto_modelt &goto_model,
+  const std::string &directory,
+  messaget &log);
+
+#define FLAG_CONTRACT_HARNESSES "contract-harnesses"
+#define HELP_CONTRACT_HARNESSES                                                \
+  " --contract-harnesses <dir>   write a model per function with a contract\n" \
+  "                              to dir that enforces the contract of that\n"  \
+  "                              function, replacing all calls by contracts\n"
+
+#endif // CPROVER_GOTO_INSTRUMENT_CONTRACT_HARNESSES_H
@@ -26,27 +26,33 @@ Date: May 2016
 /// Applies instrumenters to given goto program
 /// \param function_id: name of \p goto_program
 /// \param goto_program: the goto program
-/// \param instrumenters: the instrumenters
+/// \param cover_config: configuration, with the instrumenters and the
+///   function used to make the assertions
 /// \param mode: mode of the function to instrument (for instance ID_C or
 ///   ID_java)
 /// \param message_handler: a message handler
-/// \param make_assertion: A function which takes an expression, with a source
-///   location and makes an assertion based on that expression. The expression
-///   asserted is expected to include the expression passed in, but may include
-///   other additional conditions.
 static void instrument_cover_goals(
   const irep_idt &function_id,
   goto_programt &goto_program,
-  const cover_instrumenterst &instrumenters,
+  const cover_configt &cover_config,
   const irep_idt &mode,
-  message_handlert &message_handler,
-  const cover_instrumenter_baset::assertion_factoryt &make_assertion)
+  message_handlert &message_handler)
 {
-  const std::unique_ptr<cover_blocks_baset> basic_blocks =
-    mode == ID_java ? std::unique_ptr<cover_blocks_baset>(
-                        new cover_basic_blocks_javat(goto_program))
-                    : std::unique_ptr<cover_blocks_baset>(
-                        new cover_basic_blockst(goto_program));
+  const cover_instrumenterst &instrumenters = cover_config.cover_instrumenters;
+  const cover_instrumenter_baset::assertion_factoryt &make_assertion =
+    cover_config.make_assertion;
+
+  std::unique_ptr<cover_blocks_baset> basic_blocks;
+  if(mode == ID_java)
+    basic_blocks = util_make_unique<cover_basic_blocks_javat>(goto_program);
+  else
+  {
+    auto c_basic_blocks = util_make_unique<cover_basic_blockst>(goto_program);
+    if(cover_config.merge_blocks)
+      c_basic_blocks->merge_equivalent_blocks(
+        goto_program, *cover_config.goal_filters);
+    basic_blocks = std::move(c_basic_blocks);
+  }
 
   basic_blocks->report_block_anomalies(
     function_id, goto_program, message_handler);
@@ -166,6 +172,7 @@ void parse_cover_options(const cmdlinet &cmdline, optionst &options)
     cmdline.isset("cover-traces-must-terminate"));
   options.set_option(
     "cover-failed-assertions", cmdline.isset("cover-failed-assertions"));
+  options.set_option("cover-merge-blocks", cmdline.isset("cover-merge-blocks"));
 
   options.set_option("show-test-suite", cmdline.isset("show-test-suite"));
 }
@@ -230,6 +237,8 @@ cover_configt get_cover_config(
   cover_config.cover_failed_assertions =
     options.get_bool_option("cover-failed-assertions");
 
+  cover_config.merge_blocks = options.get_bool_option("cover-merge-blocks");
+
   return cover_config;
 }
 
@@ -322,10 +331,9 @@ static void instrument_cover_goals(
     instrument_cover_goals(
       function_symbol.name,
       function.body,
-      cover_config.cover_instrumenters,
+      cover_config,
       function_symbol.mode,
-      message_handler,
-      cover_config.make_assertion);
+      message_handler);
     changed = true;
   }
 
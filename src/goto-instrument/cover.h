@@ -27,6 +27,7 @@ class optionst;
 #define OPT_COVER                                                              \
   "(cover):"                                                                   \
   "(cover-failed-assertions)"                                                  \
+  "(cover-merge-blocks)"                                                       \
   "(show-test-suite)"
 
 #define HELP_COVER                                                             \
@@ -36,6 +37,9 @@ class optionst;
   "assertions\n"                                                               \
   "                              (this is the default for --cover "            \
   "assertions)\n"                                                              \
+  " --cover-merge-blocks         use one goal for blocks that are always "     \
+  "covered\n"                                                                  \
+  "                              together (for --cover location)\n"           \
   " --show-test-suite            print test suite for coverage criterion "     \
   "(requires --cover)\n"
 
@@ -56,6 +60,7 @@ struct cover_configt
   bool keep_assertions;
   bool cover_failed_assertions;
   bool traces_must_terminate;
+  bool merge_blocks = false;
   irep_idt mode;
   function_filterst function_filters;
   // cover instruments point to goal_filters, so they must be stored on the heap
@@ -11,7 +11,10 @@ Author: Peter Schrammel
 
 #include "cover_basic_blocks.h"
 
+#include "cover_filter.h"
+
 #include <util/format_number_range.h>
+#include <util/invariant.h>
 #include <util/message.h>
 #include <util/string2int.h>
 
@@ -108,6 +111,143 @@ cover_basic_blockst::source_location_of(const std::size_t block_nr) const
   return block_infos[block_nr].source_location;
 }
 
+optionalt<std::size_t>
+cover_basic_blockst::covering_block(const std::size_t block_nr) const
+{
+  INVARIANT(block_nr < block_infos.size(), "block number out of range");
+  return block_infos[block_nr].covering_block;
+}
+
+std::vector<std::size_t>
+cover_basic_blockst::covered_blocks(const std::size_t block_nr) const
+{
+  INVARIANT(block_nr < block_infos.size(), "block number out of range");
+  return block_infos[block_nr].covered_blocks;
+}
+
+/// \return true if executing \p instruction cannot stop a trace, such that
+///   the trace then reaches one of its successors
+static bool does_not_block(const goto_programt::instructiont &instruction)
+{
+  switch(instruction.type)
+  {
+  case ASSIGN:
+  case DECL:
+  case DEAD:
+  case SKIP:
+  case LOCATION:
+  case GOTO:
+  case ASSERT:
+  case RETURN:
+    return true;
+  case ASSUME:
+  case FUNCTION_CALL:
+  case OTHER:
+  case END_FUNCTION:
+  case START_THREAD:
+  case END_THREAD:
+  case ATOMIC_BEGIN:
+  case ATOMIC_END:
+  case THROW:
+  case CATCH:
+  case INCOMPLETE_GOTO:
+  case NO_INSTRUCTION_TYPE:
+    return false;
+  }
+
+  UNREACHABLE;
+}
+
+optionalt<std::size_t> cover_basic_blockst::equivalent_successor(
+  const std::size_t block_nr,
+  const goto_programt &goto_program,
+  const goal_filterst &goal_filters) const
+{
+  const goto_programt::const_targett start =
+    *block_infos[block_nr].representative_inst;
+
+  // Walk the instructions from the goal of the block in program order, which
+  // is a topological order as long as there are no backwards edges. Once a
+  // single instruction is pending, all paths from the start lead to it.
+  std::map<unsigned, goto_programt::const_targett> pending;
+  std::unordered_set<unsigned> visited;
+  pending.emplace(start->location_number, start);
+
+  while(!pending.empty())
+  {
+    const goto_programt::const_targett it = pending.begin()->second;
+    pending.erase(pending.begin());
+
+    if(it != start)
+    {
+      // the start dominates it
+      for(const auto &predecessor : it->incoming_edges)
+      {
+        if(visited.count(predecessor->location_number) == 0)
+          return {};
+      }
+
+      const std::size_t other = block_of(it);
+      const block_infot &other_info = block_infos[other];
+      if(
+        pending.empty() && other != block_nr &&
+        other_info.representative_inst == it &&
+        !other_info.source_location.is_nil() &&
+        goal_filters(other_info.source_location))
+      {
+        return other;
+      }
+    }
+
+    if(!does_not_block(*it))
+      return {};
+
+    visited.insert(it->location_number);
+
+    for(const auto &successor : goto_program.get_successors(it))
+    {
+      if(successor->location_number <= it->location_number)
+        return {};
+      pending.emplace(successor->location_number, successor);
+    }
+  }
+
+  return {};
+}
+
+void cover_basic_blockst::merge_equivalent_blocks(
+  const goto_programt &goto_program,
+  const goal_filterst &goal_filters)
+{
+  for(std::size_t block_nr = 0; block_nr < block_infos.size(); ++block_nr)
+  {
+    const block_infot &block_info = block_infos[block_nr];
+    if(
+      block_info.representative_inst.has_value() &&
+      !block_info.source_location.is_nil() &&
+      goal_filters(block_info.source_location))
+    {
+      block_infos[block_nr].covering_block =
+        equivalent_successor(block_nr, goto_program, goal_filters);
+    }
+  }
+
+  // the goal of a block that is covered by the goal of another block is not
+  // instrumented, so resolve chains of blocks to the last one
+  for(std::size_t block_nr = 0; block_nr < block_infos.size(); ++block_nr)
+  {
+    optionalt<std::size_t> covering = block_infos[block_nr].covering_block;
+    if(!covering.has_value())
+      continue;
+
+    while(block_infos[*covering].covering_block.has_value())
+      covering = block_infos[*covering].covering_block;
+
+    block_infos[block_nr].covering_block = covering;
+    block_infos[*covering].covered_blocks.push_back(block_nr);
+  }
+}
+
 void cover_basic_blockst::report_block_anomalies(
   const irep_idt &function_id,
   const goto_programt &goto_program,
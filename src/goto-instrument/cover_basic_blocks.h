@@ -13,6 +13,7 @@ Author: Daniel Kroening
 #define CPROVER_GOTO_INSTRUMENT_COVER_BASIC_BLOCKS_H
 
 #include <unordered_set>
+#include <vector>
 
 #include <util/optional.h>
 
@@ -20,6 +21,7 @@ Author: Daniel Kroening
 
 #include "source_lines.h"
 
+class goal_filterst;
 class message_handlert;
 
 class cover_blocks_baset
@@ -46,6 +48,23 @@ public:
   /// Outputs the list of blocks
   virtual void output(std::ostream &out) const = 0;
 
+  /// \param block_nr: a block number
+  /// \return the block whose goal also covers the given block, as the two
+  ///   are always covered together
+  virtual optionalt<std::size_t> covering_block(std::size_t block_nr) const
+  {
+    (void)block_nr; // unused parameter
+    return {};
+  }
+
+  /// \param block_nr: a block number
+  /// \return the blocks the goal of the given block also covers
+  virtual std::vector<std::size_t> covered_blocks(std::size_t block_nr) const
+  {
+    (void)block_nr; // unused parameter
+    return {};
+  }
+
   /// Output warnings about ignored blocks
   /// \param function_id: name of \p goto_program
   /// \param goto_program: The goto program
@@ -96,6 +115,22 @@ public:
   /// Outputs the list of blocks
   void output(std::ostream &out) const override;
 
+  optionalt<std::size_t> covering_block(std::size_t block_nr) const override;
+
+  std::vector<std::size_t> covered_blocks(std::size_t block_nr) const override;
+
+  /// Let the goal of a block cover the ones of the blocks that are always
+  /// covered together with it: a block B is covered together with the nearest
+  /// block A that B dominates if all paths from B reach A without loops or
+  /// instructions that may block the execution, such as assumptions and
+  /// function calls, and none of the instructions in between can be reached
+  /// other than through B.
+  /// \param goto_program: The goto program the blocks were computed for
+  /// \param goal_filters: Blocks whose goals are filtered out are not merged
+  void merge_equivalent_blocks(
+    const goto_programt &goto_program,
+    const goal_filterst &goal_filters);
+
 private:
   typedef std::map<goto_programt::const_targett, std::size_t> block_mapt;
 
@@ -114,8 +149,21 @@ private:
 
     /// the set of source code lines belonging to this block
     source_linest source_lines;
+
+    /// the block whose goal covers this block as well
+    optionalt<std::size_t> covering_block;
+
+    /// the blocks whose goals this block covers as well
+    std::vector<std::size_t> covered_blocks;
   };
 
+  /// \return the nearest block covered if and only if \p block_nr is, see
+  ///   \ref merge_equivalent_blocks
+  optionalt<std::size_t> equivalent_successor(
+    std::size_t block_nr,
+    const goto_programt &goto_program,
+    const goal_filterst &goal_filters) const;
+
   /// map program locations to block numbers
   block_mapt block_map;
   /// map block numbers to block information
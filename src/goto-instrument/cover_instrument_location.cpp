@@ -26,8 +26,11 @@ void cover_location_instrumentert::instrument(
 
   const std::size_t block_nr = basic_blocks.block_of(i_it);
   const auto representative_instruction = basic_blocks.instruction_of(block_nr);
-  // we only instrument the selected instruction
-  if(representative_instruction && *representative_instruction == i_it)
+  // we only instrument the selected instruction, unless the goal of another
+  // block covers this one
+  if(
+    representative_instruction && *representative_instruction == i_it &&
+    !basic_blocks.covering_block(block_nr).has_value())
   {
     const std::string b = std::to_string(block_nr + 1); // start with 1
     const std::string id = id2string(function_id) + "#" + b;
@@ -38,8 +41,9 @@ void cover_location_instrumentert::instrument(
     {
       const std::string source_lines =
         id2string(source_location.get_basic_block_source_lines());
-      const std::string comment =
-        "block " + b + " (lines " + source_lines + ")";
+      std::string comment = "block " + b + " (lines " + source_lines + ")";
+      for(const std::size_t covered : basic_blocks.covered_blocks(block_nr))
+        comment += ", block " + std::to_string(covered + 1);
       goto_program.insert_before_swap(i_it);
       *i_it = make_assertion(false_exprt(), source_location);
       initialize_source_location(i_it, comment, function_id);
@@ -33,6 +33,21 @@ void full_slicert::add_dependencies(
     add_to_queue(queue, dep_node_to_cfg[it->first], node.PC);
 }
 
+void full_slicert::add_dependencies(
+  const cfgt::nodet &node,
+  queuet &queue,
+  lazy_dependence_grapht &dep_graph)
+{
+  for(const auto &dep :
+      dep_graph.control_dependencies(node.function_id, node.PC))
+  {
+    add_to_queue(queue, cfg.get_node_index(dep), node.PC);
+  }
+
+  for(const auto &dep : dep_graph.data_dependencies(node.function_id, node.PC))
+    add_to_queue(queue, cfg.get_node_index(dep), node.PC);
+}
+
 void full_slicert::add_function_calls(
   const cfgt::nodet &node,
   queuet &queue,
@@ -85,7 +100,7 @@ void full_slicert::add_decl_dead(
 void full_slicert::add_jumps(
   queuet &queue,
   jumpst &jumps,
-  const dependence_grapht::post_dominators_mapt &post_dominators)
+  const post_dominatorst &post_dominators)
 {
   // Based on:
   // On slicing programs with jump statements
@@ -139,7 +154,7 @@ void full_slicert::add_jumps(
     }
 
     const irep_idt &id = j.function_id;
-    const cfg_post_dominatorst &pd=post_dominators.at(id);
+    const cfg_post_dominatorst &pd = post_dominators(id);
 
     const auto &j_PC_node = pd.get_node(j.PC);
 
@@ -192,14 +207,9 @@ void full_slicert::fixedpoint(
   queuet &queue,
   jumpst &jumps,
   decl_deadt &decl_dead,
-  const dependence_grapht &dep_graph)
+  const add_dependenciest &add_dependencies,
+  const post_dominatorst &post_dominators)
 {
-  std::vector<cfgt::entryt> dep_node_to_cfg;
-  dep_node_to_cfg.reserve(dep_graph.size());
-
-  for(dependence_grapht::node_indext i = 0; i < dep_graph.size(); ++i)
-    dep_node_to_cfg.push_back(cfg.get_node_index(dep_graph[i].PC));
-
   // process queue until empty
   while(!queue.empty())
   {
@@ -217,7 +227,7 @@ void full_slicert::fixedpoint(
       node.node_required=true;
 
       // add data and control dependencies of node
-      add_dependencies(node, queue, dep_graph, dep_node_to_cfg);
+      add_dependencies(node, queue);
 
       // retain all calls of the containing function
       add_function_calls(node, queue, goto_functions);
@@ -227,7 +237,7 @@ void full_slicert::fixedpoint(
     }
 
     // add any required jumps
-    add_jumps(queue, jumps, dep_graph.cfg_post_dominators());
+    add_jumps(queue, jumps, post_dominators);
   }
 }
 
@@ -254,7 +264,8 @@ static bool implicit(goto_programt::const_targett target)
 void full_slicert::operator()(
   goto_functionst &goto_functions,
   const namespacet &ns,
-  const slicing_criteriont &criterion)
+  const slicing_criteriont &criterion,
+  bool demand_driven)
 {
   // build the CFG data structure
   cfg(goto_functions);
@@ -295,12 +306,49 @@ void full_slicert::operator()(
     }
   }
 
-  // compute program dependence graph (and post-dominators)
-  dependence_grapht dep_graph(ns);
-  dep_graph(goto_functions, ns);
-
-  // compute the fixedpoint
-  fixedpoint(goto_functions, queue, jumps, decl_dead, dep_graph);
+  if(demand_driven)
+  {
+    // compute the dependencies of the instructions in the slice only
+    lazy_dependence_grapht dep_graph(goto_functions, ns);
+
+    fixedpoint(
+      goto_functions,
+      queue,
+      jumps,
+      decl_dead,
+      [this, &dep_graph](const cfgt::nodet &node, queuet &dest) {
+        add_dependencies(node, dest, dep_graph);
+      },
+      [&dep_graph](const irep_idt &id) -> const cfg_post_dominatorst & {
+        return dep_graph.post_dominators(id);
+      });
+  }
+  else
+  {
+    // compute program dependence graph (and post-dominators)
+    dependence_grapht dep_graph(ns);
+    dep_graph(goto_functions, ns);
+
+    dep_node_to_cfgt dep_node_to_cfg;
+    dep_node_to_cfg.reserve(dep_graph.size());
+
+    for(dependence_grapht::node_indext i = 0; i < dep_graph.size(); ++i)
+      dep_node_to_cfg.push_back(cfg.get_node_index(dep_graph[i].PC));
+
+    // compute the fixedpoint
+    fixedpoint(
+      goto_functions,
+      queue,
+      jumps,
+      decl_dead,
+      [this, &dep_graph, &dep_node_to_cfg](
+        const cfgt::nodet &node, queuet &dest) {
+        add_dependencies(node, dest, dep_graph, dep_node_to_cfg);
+      },
+      [&dep_graph](const irep_idt &id) -> const cfg_post_dominatorst & {
+        return dep_graph.cfg_post_dominators().at(id);
+      });
+  }
 
   // now replace those instructions that are not needed
   // by skips
@@ -347,9 +395,10 @@ void full_slicert::operator()(
 void full_slicer(
   goto_functionst &goto_functions,
   const namespacet &ns,
-  const slicing_criteriont &criterion)
+  const slicing_criteriont &criterion,
+  bool demand_driven)
 {
-  full_slicert()(goto_functions, ns, criterion);
+  full_slicert()(goto_functions, ns, criterion, demand_driven);
 }
 
 void full_slicer(
@@ -360,28 +409,30 @@ void full_slicer(
   full_slicert()(goto_functions, ns, a);
 }
 
-void full_slicer(goto_modelt &goto_model)
+void full_slicer(goto_modelt &goto_model, bool demand_driven)
 {
   assert_criteriont a;
   const namespacet ns(goto_model.symbol_table);
-  full_slicert()(goto_model.goto_functions, ns, a);
+  full_slicert()(goto_model.goto_functions, ns, a, demand_driven);
 }
 
 void property_slicer(
   goto_functionst &goto_functions,
   const namespacet &ns,
-  const std::list<std::string> &properties)
+  const std::list<std::string> &properties,
+  bool demand_driven)
 {
   properties_criteriont p(properties);
-  full_slicert()(goto_functions, ns, p);
+  full_slicert()(goto_functions, ns, p, demand_driven);
 }
 
 void property_slicer(
   goto_modelt &goto_model,
-  const std::list<std::string> &properties)
+  const std::list<std::string> &properties,
+  bool demand_driven)
 {
   const namespacet ns(goto_model.symbol_table);
-  property_slicer(goto_model.goto_functions, ns, properties);
+  property_slicer(goto_model.goto_functions, ns, properties, demand_driven);
 }
 
 slicing_criteriont::~slicing_criteriont()
@@ -21,16 +21,22 @@ void full_slicer(
   goto_functionst &,
   const namespacet &);
 
-void full_slicer(goto_modelt &);
+/// Slice away the instructions that the assertions of \p goto_model do not
+/// depend on. With \p demand_driven set, only the dependencies of the
+/// instructions in the slice are computed, rather than the dependence graph
+/// of the whole program, which pays off when the slice is small.
+void full_slicer(goto_modelt &goto_model, bool demand_driven = false);
 
 void property_slicer(
   goto_functionst &,
   const namespacet &,
-  const std::list<std::string> &properties);
+  const std::list<std::string> &properties,
+  bool demand_driven = false);
 
 void property_slicer(
   goto_modelt &,
-  const std::list<std::string> &properties);
+  const std::list<std::string> &properties,
+  bool demand_driven = false);
 
 class slicing_criteriont
 {
@@ -44,6 +50,7 @@ public:
 void full_slicer(
   goto_functionst &goto_functions,
   const namespacet &ns,
-  const slicing_criteriont &criterion);
+  const slicing_criteriont &criterion,
+  bool demand_driven = false);
 
 #endif // CPROVER_GOTO_INSTRUMENT_FULL_SLICER_H
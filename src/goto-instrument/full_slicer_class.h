@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_INSTRUMENT_FULL_SLICER_CLASS_H
 #define CPROVER_GOTO_INSTRUMENT_FULL_SLICER_CLASS_H
 
+#include <functional>
 #include <stack>
 #include <vector>
 #include <list>
@@ -41,7 +42,8 @@ public:
   void operator()(
     goto_functionst &goto_functions,
     const namespacet &ns,
-    const slicing_criteriont &criterion);
+    const slicing_criteriont &criterion,
+    bool demand_driven = false);
 
 protected:
   struct cfg_nodet
@@ -65,12 +67,20 @@ protected:
   typedef std::list<cfgt::entryt> jumpst;
   typedef std::unordered_map<irep_idt, queuet> decl_deadt;
 
+  /// Adds the dependencies of a node to the queue
+  typedef std::function<void(const cfgt::nodet &, queuet &)>
+    add_dependenciest;
+  /// Yields the post-dominators of a function
+  typedef std::function<const cfg_post_dominatorst &(const irep_idt &)>
+    post_dominatorst;
+
   void fixedpoint(
     goto_functionst &goto_functions,
     queuet &queue,
     jumpst &jumps,
     decl_deadt &decl_dead,
-    const dependence_grapht &dep_graph);
+    const add_dependenciest &add_dependencies,
+    const post_dominatorst &post_dominators);
 
   void add_dependencies(
     const cfgt::nodet &node,
@@ -78,6 +88,11 @@ protected:
     const dependence_grapht &dep_graph,
     const dep_node_to_cfgt &dep_node_to_cfg);
 
+  void add_dependencies(
+    const cfgt::nodet &node,
+    queuet &queue,
+    lazy_dependence_grapht &dep_graph);
+
   void add_function_calls(
     const cfgt::nodet &node,
     queuet &queue,
@@ -91,7 +106,7 @@ protected:
   void add_jumps(
     queuet &queue,
     jumpst &jumps,
-    const dependence_grapht::post_dominators_mapt &post_dominators);
+    const post_dominatorst &post_dominators);
 
   void add_to_queue(
     queuet &queue,
@@ -95,6 +95,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "insert_final_assert_false.h"
 #include "interrupt.h"
 #include "k_induction.h"
+#include "loop_bounds.h"
 #include "mmio.h"
 #include "model_argc_argv.h"
 #include "nondet_static.h"
@@ -636,6 +637,12 @@ int goto_instrument_parse_optionst::doit()
       return CPROVER_EXIT_SUCCESS;
     }
 
+    if(cmdline.isset("infer-unwindset"))
+    {
+      show_loop_bounds(goto_model, std::cout);
+      return CPROVER_EXIT_SUCCESS;
+    }
+
     if(cmdline.isset("show-natural-loops"))
     {
       show_natural_loops(goto_model, std::cout);
@@ -1135,6 +1142,15 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     goto_model.goto_functions.update();
   }
 
+  if(cmdline.isset(FLAG_CONTRACT_HARNESSES))
+  {
+    if(write_contract_harnesses(
+         goto_model, cmdline.get_value(FLAG_CONTRACT_HARNESSES), log))
+    {
+      exit(CPROVER_EXIT_CONVERSION_FAILED);
+    }
+  }
+
   const std::list<std::pair<std::string, std::string>> contract_flags(
     {{FLAG_REPLACE_CALL, FLAG_REPLACE_ALL_CALLS},
      {FLAG_ENFORCE_CONTRACT, FLAG_ENFORCE_ALL_CONTRACTS}});
@@ -1192,6 +1208,18 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     do_indirect_call_and_rtti_removal();
   }
 
+  if(cmdline.isset("andersen-fp-removal"))
+  {
+    andersen_fp_removal(goto_model, ui_message_handler);
+    do_indirect_call_and_rtti_removal();
+  }
+
+  if(cmdline.isset("steensgaard-fp-removal"))
+  {
+    steensgaard_fp_removal(goto_model, ui_message_handler);
+    do_indirect_call_and_rtti_removal();
+  }
+
   // replace function pointers, if explicitly requested
   if(cmdline.isset("remove-function-pointers"))
   {
@@ -1449,6 +1477,8 @@ void goto_instrument_parse_optionst::instrument_goto_program()
         inst_strategy=one_event_per_cycle;
       else if(cmdline.isset("minimum-interference"))
         inst_strategy=min_interference;
+      else if(cmdline.isset("greedy-interference"))
+        inst_strategy=greedy_interference;
       else if(cmdline.isset("read-first"))
         inst_strategy=read_first;
       else if(cmdline.isset("write-first"))
@@ -1555,10 +1585,17 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     interval_analysis(goto_model);
   }
 
-  if(cmdline.isset("havoc-loops"))
+  if(cmdline.isset("havoc-loops") || cmdline.isset("havoc-loops-intervals"))
   {
+    const bool use_intervals = cmdline.isset("havoc-loops-intervals");
+    if(use_intervals)
+    {
+      do_indirect_call_and_rtti_removal();
+      do_remove_returns();
+    }
+
     log.status() << "Havocking loops" << messaget::eom;
-    havoc_loops(goto_model);
+    havoc_loops(goto_model, use_intervals);
   }
 
   if(cmdline.isset("k-induction"))
@@ -1636,6 +1673,23 @@ void goto_instrument_parse_optionst::instrument_goto_program()
       reachability_slicer(goto_model);
   }
 
+  if(cmdline.isset("property-slices"))
+  {
+    do_indirect_call_and_rtti_removal();
+
+    log.status() << "Writing the reachability slices of the properties"
+                 << messaget::eom;
+
+    // reachability_slicer requires that the model has unique location numbers:
+    goto_model.goto_functions.update();
+
+    if(write_property_slices(
+         goto_model, cmdline.get_value("property-slices"), ui_message_handler))
+    {
+      exit(CPROVER_EXIT_CONVERSION_FAILED);
+    }
+  }
+
   if(cmdline.isset("fp-reachability-slice"))
   {
     do_indirect_call_and_rtti_removal();
@@ -1653,13 +1707,17 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     do_remove_returns();
 
     log.status() << "Performing a full slice" << messaget::eom;
+    const bool demand_driven = cmdline.isset("demand-driven-slice");
     if(cmdline.isset("property"))
-      property_slicer(goto_model, cmdline.get_values("property"));
+    {
+      property_slicer(
+        goto_model, cmdline.get_values("property"), demand_driven);
+    }
     else
     {
       // full_slicer requires that the model has unique location numbers:
       goto_model.goto_functions.update();
-      full_slicer(goto_model);
+      full_slicer(goto_model, demand_driven);
     }
   }
 
@@ -1769,6 +1827,8 @@ void goto_instrument_parse_optionst::help()
     " --show-struct-alignment      show struct members that might be concurrently accessed\n" // NOLINT(*)
     " --show-natural-loops         show natural loop heads\n"
     // NOLINTNEXTLINE(whitespace/line_length)
+    " --infer-unwindset            show an unwindset with the bounds of the loops that count to a bound\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
     " --list-calls-args            list all function calls with their arguments\n"
     " --call-graph                 show graph of function calls\n"
     // NOLINTNEXTLINE(whitespace/line_length)
@@ -1819,6 +1879,8 @@ void goto_instrument_parse_optionst::help()
     " --step-case                  k-induction: do step-case\n"
     " --base-case                  k-induction: do base-case\n"
     " --havoc-loops                over-approximate all loops\n"
+    " --havoc-loops-intervals      over-approximate all loops, assuming the\n"
+    "                              intervals of the variables at the loop heads\n"
     " --accelerate                 add loop accelerators\n"
     " --skip-loops <loop-ids>      add gotos to skip selected loops during execution\n" // NOLINT(*)
     "\n"
@@ -1827,6 +1889,7 @@ void goto_instrument_parse_optionst::help()
     " --scc                        detects critical cycles per SCC (one thread per SCC)\n" // NOLINT(*)
     " --one-event-per-cycle        only instruments one event per cycle\n"
     " --minimum-interference       instruments an optimal number of events\n"
+    " --greedy-interference        approximates the above, without glpk\n"
     " --my-events                  only instruments events whose ids appear in inst.evt\n" // NOLINT(*)
     " --cfg-kill                   enables symbolic execution used to reduce spurious cycles\n" // NOLINT(*)
     " --no-dependencies            no dependency analysis\n"
@@ -1837,8 +1900,11 @@ void goto_instrument_parse_optionst::help()
     "\n"
     "Slicing:\n"
     HELP_REACHABILITY_SLICER
+    HELP_PROPERTY_SLICES
     " --full-slice                 slice away instructions that don't affect assertions\n" // NOLINT(*)
     " --property id                slice with respect to specific property only\n" // NOLINT(*)
+    " --demand-driven-slice        with --full-slice, only compute the dependencies of\n" // NOLINT(*)
+    "                              instructions in the slice\n"
     " --slice-global-inits         slice away initializations of unused global variables\n" // NOLINT(*)
     " --aggressive-slice           remove bodies of any functions not on the shortest path between\n" // NOLINT(*)
     "                              the start function and the function containing the property(s)\n" // NOLINT(*)
@@ -1863,6 +1929,10 @@ void goto_instrument_parse_optionst::help()
     " --value-set-fi-fp-removal    build flow-insensitive value set and replace function pointers by a case statement\n" // NOLINT(*)
     "                              over the possible assignments. If the set of possible assignments is empty the function pointer\n" // NOLINT(*)
     "                              is removed using the standard remove-function-pointers pass. \n" // NOLINT(*)
+    " --andersen-fp-removal        as --value-set-fi-fp-removal, with a faster\n" // NOLINT(*)
+    "                              field-insensitive points-to analysis\n"
+    " --steensgaard-fp-removal     as --andersen-fp-removal, with a less precise\n" // NOLINT(*)
+    "                              points-to analysis taking almost linear time\n" // NOLINT(*)
     HELP_RESTRICT_FUNCTION_POINTER
     HELP_REMOVE_CALLS_NO_BODY
     HELP_REMOVE_CONST_FUNCTION_POINTERS
@@ -1878,6 +1948,7 @@ void goto_instrument_parse_optionst::help()
     HELP_REPLACE_ALL_CALLS
     HELP_ENFORCE_CONTRACT
     HELP_ENFORCE_ALL_CONTRACTS
+    HELP_CONTRACT_HARNESSES
     "\n"
     "Other options:\n"
     " --no-system-headers          with --dump-c/--dump-cpp: generate C source expanding libc includes\n" // NOLINT(*)
@@ -30,9 +30,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "aggressive_slicer.h"
 #include "code_contracts.h"
+#include "contract_harnesses.h"
 #include "generate_function_bodies.h"
 #include "insert_final_assert_false.h"
 #include "nondet_volatile.h"
+#include "reachability_slicer.h"
 #include "replace_calls.h"
 
 #include "count_eloc.h"
@@ -53,7 +55,7 @@ Author: Daniel Kroening, kroening@kroening.com
   "(no-simplify)" \
   "(uninitialized-check)" \
   "(race-check)(scc)(one-event-per-cycle)" \
-  "(minimum-interference)" \
+  "(minimum-interference)(greedy-interference)" \
   "(mm):(my-events)" \
   "(unwind):(unwindset):(unwindset-file):" \
   "(unwinding-assertions)(partial-loops)(continue-as-loops)" \
@@ -79,9 +81,13 @@ Author: Daniel Kroening, kroening@kroening.com
   "(show-struct-alignment)(interval-analysis)(show-intervals)" \
   "(show-uninitialized)(show-locations)" \
   "(full-slice)(reachability-slice)(slice-global-inits)" \
+  "(demand-driven-slice)" \
   "(fp-reachability-slice):" \
+  OPT_PROPERTY_SLICES \
   "(inline)(partial-inline)(function-inline):(log):(no-caching)" \
   "(value-set-fi-fp-removal)" \
+  "(andersen-fp-removal)" \
+  "(steensgaard-fp-removal)" \
   OPT_REMOVE_CONST_FUNCTION_POINTERS \
   "(print-internal-representation)" \
   "(remove-function-pointers)" \
@@ -90,6 +96,8 @@ Author: Daniel Kroening, kroening@kroening.com
   "(cav11)" \
   OPT_TIMESTAMP \
   "(show-natural-loops)(show-lexical-loops)(accelerate)(havoc-loops)" \
+  "(havoc-loops-intervals)" \
+  "(infer-unwindset)" \
   "(string-abstraction)" \
   "(verbosity):(version)(xml-ui)(json-ui)(show-loops)" \
   "(accelerate)(constant-propagator)" \
@@ -104,6 +112,7 @@ Author: Daniel Kroening, kroening@kroening.com
   "(" FLAG_REPLACE_ALL_CALLS ")" \
   "(" FLAG_ENFORCE_CONTRACT "):" \
   "(" FLAG_ENFORCE_ALL_CONTRACTS ")" \
+  "(" FLAG_CONTRACT_HARNESSES "):" \
   "(show-threaded)(list-calls-args)" \
   "(undefined-function-is-assume-false)" \
   "(remove-function-body):"\
@@ -11,6 +11,12 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "havoc_loops.h"
 
+#include <util/make_unique.h>
+#include <util/std_expr.h>
+
+#include <analyses/ai.h>
+#include <analyses/dirty.h>
+#include <analyses/interval_domain.h>
 #include <analyses/natural_loops.h>
 #include <analyses/local_may_alias.h>
 
@@ -26,11 +32,15 @@ public:
 
   havoc_loopst(
     function_modifiest &_function_modifies,
-    goto_functiont &_goto_function):
+    goto_functiont &_goto_function,
+    const ait<interval_domaint> *_intervals,
+    const dirtyt *_dirty):
     goto_function(_goto_function),
     local_may_alias(_goto_function),
     function_modifies(_function_modifies),
-    natural_loops(_goto_function.body)
+    natural_loops(_goto_function.body),
+    intervals(_intervals),
+    dirty(_dirty)
   {
     havoc_loops();
   }
@@ -40,6 +50,8 @@ protected:
   local_may_aliast local_may_alias;
   function_modifiest &function_modifies;
   natural_loops_mutablet natural_loops;
+  const ait<interval_domaint> *intervals;
+  const dirtyt *dirty;
 
   typedef std::set<exprt> modifiest;
   typedef const natural_loops_mutablet::natural_loopt loopt;
@@ -47,6 +59,11 @@ protected:
   void havoc_loops();
 
   void havoc_loop(
+    const goto_programt::targett loop_head,
+    const loopt &,
+    const exprt &invariant);
+
+  exprt get_invariant(
     const goto_programt::targett loop_head,
     const loopt &);
 
@@ -57,7 +74,8 @@ protected:
 
 void havoc_loopst::havoc_loop(
   const goto_programt::targett loop_head,
-  const loopt &loop)
+  const loopt &loop,
+  const exprt &invariant)
 {
   assert(!loop.empty());
 
@@ -69,6 +87,14 @@ void havoc_loopst::havoc_loop(
   goto_programt havoc_code;
   build_havoc_code(loop_head, modifies, havoc_code);
 
+  // the havocked state is the one at the head of some iteration, in which
+  // the invariant holds
+  if(!invariant.is_true())
+  {
+    havoc_code.add(
+      goto_programt::make_assumption(invariant, loop_head->source_location));
+  }
+
   // Now havoc at the loop head. Use insert_swap to
   // preserve jumps to loop head.
   goto_function.body.insert_before_swap(loop_head, havoc_code);
@@ -107,18 +133,68 @@ void havoc_loopst::get_modifies(
     function_modifies.get_modifies(local_may_alias, instruction_it, modifies);
 }
 
+/// \return the conjunction of the intervals at \p loop_head of the variables
+///   the loop modifies, or true if there are no intervals. The interval
+///   domain ignores assignments through pointers, hence variables whose
+///   address is taken are left out.
+exprt havoc_loopst::get_invariant(
+  const goto_programt::targett loop_head,
+  const loopt &loop)
+{
+  if(intervals == nullptr)
+    return true_exprt();
+
+  modifiest modifies;
+  get_modifies(loop, modifies);
+
+  const interval_domaint &state = (*intervals)[loop_head];
+
+  exprt::operandst conjuncts;
+  for(const auto &lhs : modifies)
+  {
+    if(lhs.id() != ID_symbol || (*dirty)(to_symbol_expr(lhs)))
+      continue;
+
+    exprt tmp = state.make_expression(to_symbol_expr(lhs));
+    if(!tmp.is_true())
+      conjuncts.push_back(std::move(tmp));
+  }
+
+  return conjunction(conjuncts);
+}
+
 void havoc_loopst::havoc_loops()
 {
   // iterate over the (natural) loops in the function
 
+  // the invariants are taken before any of the loops is changed, as the
+  // intervals are those of the original program
+  std::vector<exprt> invariants;
   for(const auto &loop : natural_loops.loop_map)
-    havoc_loop(loop.first, loop.second);
+    invariants.push_back(get_invariant(loop.first, loop.second));
+
+  auto invariant = invariants.begin();
+  for(const auto &loop : natural_loops.loop_map)
+    havoc_loop(loop.first, loop.second, *invariant++);
 }
 
-void havoc_loops(goto_modelt &goto_model)
+void havoc_loops(goto_modelt &goto_model, bool use_intervals)
 {
   function_modifiest function_modifies(goto_model.goto_functions);
 
+  std::unique_ptr<ait<interval_domaint>> intervals;
+  std::unique_ptr<dirtyt> dirty;
+  if(use_intervals)
+  {
+    const namespacet ns(goto_model.symbol_table);
+    intervals = util_make_unique<ait<interval_domaint>>();
+    (*intervals)(goto_model.goto_functions, ns);
+    dirty = util_make_unique<dirtyt>(goto_model.goto_functions);
+  }
+
   for(auto &gf_entry : goto_model.goto_functions.function_map)
-    havoc_loopst(function_modifies, gf_entry.second);
+  {
+    havoc_loopst(
+      function_modifies, gf_entry.second, intervals.get(), dirty.get());
+  }
 }
@@ -14,6 +14,10 @@ Author: Daniel Kroening, kroening@kroening.com
 
 class goto_modelt;
 
-void havoc_loops(goto_modelt &);
+/// Replace each loop by a single iteration from a state in which all variables
+/// the loop may modify are havocked. With \p use_intervals, the intervals an
+/// interval analysis infers for these variables at the loop head are assumed
+/// after havocking.
+void havoc_loops(goto_modelt &, bool use_intervals = false);
 
 #endif // CPROVER_GOTO_INSTRUMENT_HAVOC_LOOPS_H
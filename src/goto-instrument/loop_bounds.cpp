@@ -0,0 +1,435 @@
+/*******************************************************************\
+
+Module: Inference of Loop Bounds
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Inference of Loop Bounds
+
+#include "loop_bounds.h"
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/std_expr.h>
+#include <util/string_utils.h>
+
+#include <goto-programs/goto_model.h>
+
+#include <analyses/ai.h>
+#include <analyses/dirty.h>
+#include <analyses/natural_loops.h>
+#include <analyses/zones_domain.h>
+
+#include <algorithm>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+/// \return \p expr without the casts between integer types that preserve
+///   all values
+static const exprt &skip_widening_casts(const exprt &expr)
+{
+  if(expr.id() != ID_typecast)
+    return expr;
+
+  const exprt &op = to_typecast_expr(expr).op();
+  if(
+    !can_cast_type<integer_bitvector_typet>(expr.type()) ||
+    !can_cast_type<integer_bitvector_typet>(op.type()))
+  {
+    return expr;
+  }
+
+  const auto &from = to_integer_bitvector_type(op.type());
+  const auto &to = to_integer_bitvector_type(expr.type());
+  if(to.smallest() > from.smallest() || to.largest() < from.largest())
+    return expr;
+
+  return skip_widening_casts(op);
+}
+
+/// \return \p expr without any casts between integer types
+static const exprt &skip_casts(const exprt &expr)
+{
+  if(
+    expr.id() == ID_typecast &&
+    can_cast_type<integer_bitvector_typet>(expr.type()) &&
+    can_cast_type<integer_bitvector_typet>(
+      to_typecast_expr(expr).op().type()))
+  {
+    return skip_casts(to_typecast_expr(expr).op());
+  }
+
+  return expr;
+}
+
+/// Rewrite \p condition, or its negation if \p negation is set, to the form
+/// `lhs < rhs` or `lhs <= rhs`, if it is a comparison
+static optionalt<binary_relation_exprt>
+as_less_than(const exprt &condition, bool negation)
+{
+  if(condition.id() == ID_not)
+    return as_less_than(to_not_expr(condition).op(), !negation);
+
+  if(
+    condition.id() != ID_lt && condition.id() != ID_le &&
+    condition.id() != ID_gt && condition.id() != ID_ge)
+  {
+    return {};
+  }
+
+  const auto &relation = to_binary_relation_expr(condition);
+  irep_idt id = relation.id();
+  if(negation) // !x<y  ---> x>=y
+  {
+    if(id == ID_lt)
+      id = ID_ge;
+    else if(id == ID_le)
+      id = ID_gt;
+    else if(id == ID_gt)
+      id = ID_le;
+    else
+      id = ID_lt;
+  }
+
+  if(id == ID_lt || id == ID_le)
+    return binary_relation_exprt(relation.lhs(), id, relation.rhs());
+
+  return binary_relation_exprt(
+    relation.rhs(), id == ID_gt ? ID_lt : ID_le, relation.lhs());
+}
+
+/// The loops of one function and what they need to know about it
+class loop_boundst
+{
+public:
+  loop_boundst(
+    const irep_idt &function_id,
+    const goto_functionst::goto_functiont &goto_function,
+    const ait<zones_domaint> &ai,
+    const namespacet &ns)
+    : function_id(function_id),
+      ai(ai),
+      ns(ns),
+      dirty(goto_function)
+  {
+    natural_loops(goto_function.body);
+  }
+
+  void operator()(std::map<irep_idt, unsigned> &limits);
+
+protected:
+  typedef goto_programt::const_targett locationt;
+  typedef natural_loopst::natural_loopt loopt;
+
+  const irep_idt &function_id;
+  const ait<zones_domaint> &ai;
+  const namespacet &ns;
+  natural_loopst natural_loops;
+  const dirtyt dirty;
+
+  optionalt<unsigned>
+  limit(locationt head, const loopt &loop, locationt latch) const;
+
+  optionalt<mp_integer> iterations(
+    locationt head,
+    const loopt &loop,
+    locationt latch,
+    const exprt &counter,
+    const exprt &bound,
+    bool strict,
+    bool increasing) const;
+
+  /// \return whether \p symbol_expr may be written in \p loop other than by
+  ///   \p except
+  bool is_written(
+    const symbol_exprt &symbol_expr,
+    const loopt &loop,
+    optionalt<locationt> except) const;
+};
+
+void loop_boundst::operator()(std::map<irep_idt, unsigned> &limits)
+{
+  for(const auto &loop : natural_loops.loop_map)
+  {
+    // a loop has a single back edge, where it is identified
+    optionalt<locationt> latch;
+    for(const auto &l : loop.second)
+    {
+      if(l->is_backwards_goto() && l->get_target() == loop.first)
+      {
+        if(latch.has_value())
+        {
+          latch.reset();
+          break;
+        }
+        latch = l;
+      }
+    }
+
+    if(!latch.has_value())
+      continue;
+
+    const auto l = limit(loop.first, loop.second, *latch);
+    if(l.has_value())
+      limits[goto_programt::loop_id(function_id, **latch)] = *l;
+  }
+}
+
+optionalt<unsigned>
+loop_boundst::limit(locationt head, const loopt &loop, locationt latch) const
+{
+  // The loop test must be at the head, leaving the loop, as in while and for
+  // loops. The test of a do-while loop at the back edge does not bound the
+  // counter at its step, as the state at the head is widened.
+  if(
+    !head->is_goto() || head->get_condition().is_true() ||
+    loop.contains(head->get_target()))
+  {
+    return {};
+  }
+
+  const auto condition = as_less_than(head->get_condition(), true);
+  if(!condition.has_value())
+    return {};
+
+  // The loop continues while lhs < rhs or lhs <= rhs, so either the lhs
+  // counts up, or the rhs counts down.
+  const exprt &lhs = skip_widening_casts(condition->lhs());
+  const exprt &rhs = skip_widening_casts(condition->rhs());
+  const bool strict = condition->id() == ID_lt;
+
+  auto result = iterations(head, loop, latch, lhs, rhs, strict, true);
+  if(!result.has_value())
+    result = iterations(head, loop, latch, rhs, lhs, strict, false);
+
+  // The limit counts the loop test that leaves the loop as well.
+  if(
+    !result.has_value() ||
+    *result >= std::numeric_limits<unsigned>::max())
+  {
+    return {};
+  }
+
+  return numeric_cast_v<unsigned>(*result + 1);
+}
+
+optionalt<mp_integer> loop_boundst::iterations(
+  locationt head,
+  const loopt &loop,
+  locationt latch,
+  const exprt &counter,
+  const exprt &bound,
+  bool strict,
+  bool increasing) const
+{
+  if(
+    counter.id() != ID_symbol ||
+    !can_cast_type<integer_bitvector_typet>(counter.type()) ||
+    (bound.id() != ID_symbol && bound.id() != ID_constant))
+  {
+    return {};
+  }
+
+  const symbol_exprt &counter_symbol = to_symbol_expr(counter);
+
+  // The counter must be assigned once in each iteration, by adding a
+  // constant to it, on each path to the back edge and outside any inner
+  // loop.
+  optionalt<locationt> step_location;
+  for(const auto &l : loop)
+  {
+    if(
+      l->is_assign() && l->assign_lhs().id() == ID_symbol &&
+      to_symbol_expr(l->assign_lhs()).get_identifier() ==
+        counter_symbol.get_identifier())
+    {
+      if(step_location.has_value())
+        return {};
+      step_location = l;
+    }
+  }
+
+  if(
+    !step_location.has_value() ||
+    is_written(counter_symbol, loop, step_location) ||
+    !natural_loops.get_dominator_info().dominates(*step_location, latch))
+  {
+    return {};
+  }
+
+  for(const auto &inner : natural_loops.loop_map)
+  {
+    if(
+      inner.first != head && inner.second.contains(*step_location) &&
+      !inner.second.contains(head))
+    {
+      return {};
+    }
+  }
+
+  // the types the result of the step is converted to, which it must fit in
+  std::vector<typet> step_types{counter.type()};
+  const exprt *step_rhs = &(*step_location)->assign_rhs();
+  while(skip_casts(*step_rhs) != *step_rhs)
+  {
+    step_rhs = &to_typecast_expr(*step_rhs).op();
+    step_types.push_back(step_rhs->type());
+  }
+
+  if(step_rhs->id() != ID_plus && step_rhs->id() != ID_minus)
+    return {};
+
+  const auto &step_operation = to_binary_expr(*step_rhs);
+  const exprt *counter_operand = &step_operation.lhs();
+  const exprt *step_operand = &step_operation.rhs();
+  if(
+    step_rhs->id() == ID_plus &&
+    skip_widening_casts(*counter_operand) != counter)
+  {
+    std::swap(counter_operand, step_operand);
+  }
+
+  const auto step = numeric_cast<mp_integer>(skip_casts(*step_operand));
+  if(!step.has_value() || skip_widening_casts(*counter_operand) != counter)
+    return {};
+
+  // the amount by which the counter moves towards the bound in each iteration
+  const mp_integer progress = step_rhs->id() == ID_plus ? *step : -*step;
+  if(increasing ? progress <= 0 : progress >= 0)
+    return {};
+
+  if(bound.id() == ID_symbol && is_written(to_symbol_expr(bound), loop, {}))
+    return {};
+
+  // The difference between the bound and the counter at the head decreases
+  // by the progress in each iteration, and the loop continues while it is
+  // positive, or not negative.
+  const auto head_state_ptr = ai.abstract_state_before(head);
+  const auto &head_state = static_cast<const zones_domaint &>(*head_state_ptr);
+  const auto difference = increasing
+                            ? head_state.difference_bound(bound, counter)
+                            : head_state.difference_bound(counter, bound);
+  if(!difference.has_value())
+    return {};
+
+  // The step must not overflow in any of these types.
+  const auto step_state_ptr = ai.abstract_state_before(*step_location);
+  const auto &step_state = static_cast<const zones_domaint &>(*step_state_ptr);
+  const exprt zero = from_integer(0, counter.type());
+  for(const auto &type : step_types)
+  {
+    if(!can_cast_type<integer_bitvector_typet>(type))
+      return {};
+
+    if(increasing)
+    {
+      const auto upper = step_state.difference_bound(counter, zero);
+      if(
+        !upper.has_value() ||
+        *upper + progress > to_integer_bitvector_type(type).largest())
+      {
+        return {};
+      }
+    }
+    else
+    {
+      const auto lower = step_state.difference_bound(zero, counter);
+      if(
+        !lower.has_value() ||
+        -*lower + progress < to_integer_bitvector_type(type).smallest())
+      {
+        return {};
+      }
+    }
+  }
+
+  const mp_integer distance = increasing ? progress : -progress;
+  const mp_integer last = strict ? *difference - 1 : *difference;
+  if(last < 0)
+    return mp_integer(0);
+
+  return last / distance + 1;
+}
+
+bool loop_boundst::is_written(
+  const symbol_exprt &symbol_expr,
+  const loopt &loop,
+  optionalt<locationt> except) const
+{
+  const irep_idt &identifier = symbol_expr.get_identifier();
+
+  // a variable whose address is taken may be written through a pointer
+  if(dirty(identifier))
+    return true;
+
+  const bool is_static_lifetime = ns.lookup(identifier).is_static_lifetime;
+
+  for(const auto &l : loop)
+  {
+    if(except.has_value() && l == *except)
+      continue;
+
+    const exprt *lhs = nullptr;
+    if(l->is_assign())
+      lhs = &l->assign_lhs();
+    else if(l->is_decl())
+      lhs = &l->decl_symbol();
+    else if(l->is_dead())
+      lhs = &l->dead_symbol();
+    else if(l->is_function_call())
+    {
+      // a function may write any variable of static lifetime
+      if(is_static_lifetime)
+        return true;
+      lhs = &l->get_function_call().lhs();
+    }
+    else if(l->is_other() || l->is_start_thread())
+      return true;
+
+    if(
+      lhs != nullptr && lhs->id() == ID_symbol &&
+      to_symbol_expr(*lhs).get_identifier() == identifier)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::map<irep_idt, unsigned> infer_loop_bounds(const goto_modelt &goto_model)
+{
+  ait<zones_domaint> ai;
+  ai(goto_model);
+
+  const namespacet ns(goto_model.symbol_table);
+  std::map<irep_idt, unsigned> limits;
+
+  for(const auto &gf_entry : goto_model.goto_functions.function_map)
+  {
+    if(!gf_entry.second.body_available())
+      continue;
+
+    loop_boundst(gf_entry.first, gf_entry.second, ai, ns)(limits);
+  }
+
+  return limits;
+}
+
+void show_loop_bounds(const goto_modelt &goto_model, std::ostream &out)
+{
+  std::vector<std::string> elements;
+  for(const auto &limit : infer_loop_bounds(goto_model))
+  {
+    elements.push_back(
+      id2string(limit.first) + ":" + std::to_string(limit.second));
+  }
+
+  std::sort(elements.begin(), elements.end());
+  join_strings(out, elements.begin(), elements.end(), ',');
+  out << '\n';
+}
@@ -0,0 +1,36 @@
+/*******************************************************************\
+
+Module: Inference of Loop Bounds
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Inference of Loop Bounds
+
+#ifndef CPROVER_GOTO_INSTRUMENT_LOOP_BOUNDS_H
+#define CPROVER_GOTO_INSTRUMENT_LOOP_BOUNDS_H
+
+#include <util/irep.h>
+
+#include <iosfwd>
+#include <map>
+
+class goto_modelt;
+
+/// Infer the unwinding limits of the loops of \p goto_model that count a
+/// variable up or down to a bound, such as `for(i = 0; i < n; i++)`. The
+/// variable must change by the same constant in each iteration, the bound
+/// must not change in the loop, and the difference between them at the loop
+/// test is bounded by an analysis with the zones domain. Other loops have no
+/// limit.
+/// \return the limit of each bounded loop, by loop identifier, which always
+///   suffices for the unwinding assertions to hold
+std::map<irep_idt, unsigned> infer_loop_bounds(const goto_modelt &goto_model);
+
+/// Print the limits inferred by \ref infer_loop_bounds in the format of
+/// `--unwindset`
+void show_loop_bounds(const goto_modelt &goto_model, std::ostream &out);
+
+#endif // CPROVER_GOTO_INSTRUMENT_LOOP_BOUNDS_H
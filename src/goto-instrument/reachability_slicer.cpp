@@ -20,11 +20,73 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/remove_skip.h>
 #include <goto-programs/remove_unreachable.h>
 
+#include <goto-programs/write_goto_binary.h>
+
 #include <util/exception_utils.h>
+#include <util/json.h>
+#include <util/message.h>
 
 #include "full_slicer_class.h"
 #include "reachability_slicer_class.h"
 
+#include <fstream>
+#include <map>
+#include <set>
+
+void reachability_slicert::build_cfg(const goto_functionst &goto_functions)
+{
+  cfg(goto_functions);
+  for(const auto &gf_entry : goto_functions.function_map)
+  {
+    forall_goto_program_instructions(i_it, gf_entry.second.body)
+      cfg[cfg.entry_map[i_it]].function_id = gf_entry.first;
+  }
+}
+
+std::vector<std::list<std::string>>
+reachability_slicert::group_properties(const goto_functionst &goto_functions)
+{
+  build_cfg(goto_functions);
+  is_threadedt is_threaded(goto_functions);
+
+  std::set<std::string> property_ids;
+  for(const auto &gf_entry : goto_functions.function_map)
+  {
+    for(const auto &instruction : gf_entry.second.body.instructions)
+    {
+      if(instruction.is_assert())
+        property_ids.insert(
+          id2string(instruction.source_location.get_property_id()));
+    }
+  }
+
+  // The CFG is built once, and only the walk to the property is repeated.
+  // The groups are ordered by their first property.
+  std::vector<std::list<std::string>> groups;
+  std::map<std::vector<bool>, std::size_t> slice_to_group;
+
+  for(const auto &property_id : property_ids)
+  {
+    for(std::size_t i = 0; i < cfg.size(); ++i)
+      cfg[i].reaches_assertion = false;
+
+    const std::list<std::string> properties{property_id};
+    properties_criteriont criterion(properties);
+    fixedpoint_to_assertions(is_threaded, criterion);
+
+    std::vector<bool> slice(cfg.size());
+    for(std::size_t i = 0; i < cfg.size(); ++i)
+      slice[i] = cfg[i].reaches_assertion;
+
+    const auto entry = slice_to_group.emplace(std::move(slice), groups.size());
+    if(entry.second)
+      groups.emplace_back();
+    groups[entry.first->second].push_back(property_id);
+  }
+
+  return groups;
+}
+
 /// Get the set of nodes that correspond to the given criterion, or that can
 /// appear in concurrent execution. None of these should be sliced away so
 /// they are used as a basis for the search.
@@ -213,11 +275,22 @@ void reachability_slicert::forward_walk_call_instruction(
     // Real call -- store the callee head node:
     callee_head_stack.push_back(successor_index);
 
-    // Check if it can return, and if so store the callsite's successor:
-    while(!successor_pc->is_end_function())
-      ++successor_pc;
+    // Check if it can return, and if so store the callsite's successor. This
+    // takes a walk to the end of the callee, which is done once per callee
+    // rather than once per call:
+    auto can_return = callee_can_return.find(successor_index);
+    if(can_return == callee_can_return.end())
+    {
+      while(!successor_pc->is_end_function())
+        ++successor_pc;
+
+      can_return =
+        callee_can_return
+          .emplace(successor_index, !cfg.get_node(successor_pc).out.empty())
+          .first;
+    }
 
-    if(!cfg.get_node(successor_pc).out.empty())
+    if(can_return->second)
       callsite_successor_stack.push_back(
         cfg.get_node_index(callsite_successor_pc));
   }
@@ -433,3 +506,49 @@ void reachability_slicer(
 {
   reachability_slicer(goto_model, properties, false);
 }
+
+bool write_property_slices(
+  const goto_modelt &goto_model,
+  const std::string &directory,
+  message_handlert &message_handler)
+{
+  messaget log(message_handler);
+
+  reachability_slicert grouping;
+  const std::vector<std::list<std::string>> groups =
+    grouping.group_properties(goto_model.goto_functions);
+
+  json_arrayt manifest;
+
+  for(std::size_t i = 0; i < groups.size(); ++i)
+  {
+    goto_modelt slice;
+    slice.symbol_table = goto_model.symbol_table;
+    slice.goto_functions.copy_from(goto_model.goto_functions);
+    reachability_slicer(slice, groups[i]);
+
+    const std::string file = "slice" + std::to_string(i) + ".gb";
+    log.status() << "Writing the slice for " << groups[i].size()
+                 << " properties to " << directory << '/' << file
+                 << messaget::eom;
+    if(write_goto_binary(directory + '/' + file, slice, message_handler))
+      return true;
+
+    json_arrayt properties;
+    for(const auto &property_id : groups[i])
+      properties.push_back(json_stringt{property_id});
+    manifest.push_back(json_objectt{{"file", json_stringt{file}},
+                                    {"properties", std::move(properties)}});
+  }
+
+  const std::string manifest_file = directory + "/manifest.json";
+  std::ofstream out(manifest_file);
+  if(!out)
+  {
+    log.error() << "failed to write " << manifest_file << messaget::eom;
+    return true;
+  }
+
+  out << manifest << '\n';
+  return false;
+}
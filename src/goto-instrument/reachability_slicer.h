@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <string>
 
 class goto_modelt;
+class message_handlert;
 
 void reachability_slicer(goto_modelt &);
 
@@ -36,6 +37,16 @@ void reachability_slicer(
   const std::list<std::string> &properties,
   const bool include_forward_reachability);
 
+/// Partition the properties of \p goto_model into groups whose reachability
+/// slices are the same, and write the slice for each group to its own goto
+/// binary in \p directory. The properties of each group, which are the ones
+/// to check in its binary, are listed in `manifest.json` in \p directory.
+/// \return true on error
+bool write_property_slices(
+  const goto_modelt &goto_model,
+  const std::string &directory,
+  message_handlert &message_handler);
+
 // clang-format off
 #define OPT_REACHABILITY_SLICER                                                \
   "(fp-reachability-slice):(reachability-slice)(reachability-slice-fb)" // NOLINT(*)
@@ -50,5 +61,12 @@ void reachability_slicer(
 #define HELP_REACHABILITY_SLICER_FB                                                   \
   " --reachability-slice-fb      remove instructions that cannot appear on a trace\n" \
   "                              from entry point through a property\n" // NOLINT(*)
+
+#define OPT_PROPERTY_SLICES "(property-slices):"
+
+#define HELP_PROPERTY_SLICES                                                          \
+  " --property-slices <dir>      write a reachability slice per group of\n"         \
+  "                              properties with the same slice to dir, and\n"      \
+  "                              list the groups in dir/manifest.json\n" // NOLINT(*)
 // clang-format on
 #endif // CPROVER_GOTO_INSTRUMENT_REACHABILITY_SLICER_H
@@ -17,6 +17,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <analyses/is_threaded.h>
 
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 class slicing_criteriont;
 
 class reachability_slicert
@@ -27,12 +32,7 @@ public:
     const slicing_criteriont &criterion,
     bool include_forward_reachability)
   {
-    cfg(goto_functions);
-    for(const auto &gf_entry : goto_functions.function_map)
-    {
-      forall_goto_program_instructions(i_it, gf_entry.second.body)
-        cfg[cfg.entry_map[i_it]].function_id = gf_entry.first;
-    }
+    build_cfg(goto_functions);
 
     is_threadedt is_threaded(goto_functions);
     fixedpoint_to_assertions(is_threaded, criterion);
@@ -41,7 +41,15 @@ public:
     slice(goto_functions);
   }
 
+  /// \return the identifiers of the properties in \p goto_functions, in
+  ///   groups such that the properties in one group have the same
+  ///   (backwards) reachability slice
+  std::vector<std::list<std::string>>
+  group_properties(const goto_functionst &goto_functions);
+
 protected:
+  void build_cfg(const goto_functionst &goto_functions);
+
   struct slicer_entryt
   {
     slicer_entryt() : reaches_assertion(false), reachable_from_assertion(false)
@@ -62,6 +70,10 @@ protected:
 
   typedef std::stack<cfgt::entryt> queuet;
 
+  /// Whether the function whose head is the key can return, i.e., whether
+  /// its END_FUNCTION has any successors
+  std::unordered_map<cfgt::node_indext, bool> callee_can_return;
+
   /// A search stack entry, used in tracking nodes to mark reachable when
   /// walking over the CFG in `fixedpoint_to_assertions` and
   /// `fixedpoint_from_assertions`.
@@ -72,6 +72,6 @@ bool splice_call(
     start, goto_programt::make_function_call(splice_call));
 
   // update counters etc.
-  goto_functions.update();
+  goto_functions.update(caller_fun->second.body);
   return false;
 }
@@ -23,6 +23,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "unwindset.h"
 
+#include <unordered_map>
+
 void goto_unwindt::copy_segment(
   const goto_programt::const_targett start,
   const goto_programt::const_targett end, // exclusive
@@ -31,22 +33,20 @@ void goto_unwindt::copy_segment(
   assert(start->location_number<end->location_number);
   assert(goto_program.empty());
 
-  // build map for branch targets inside the loop
-  typedef std::map<goto_programt::const_targett, unsigned> target_mapt;
+  // build map for branch targets inside the loop; the segment may contain
+  // copies made by unwinding inner loops, which share location numbers, so
+  // the instructions are identified by their addresses
+  typedef std::unordered_map<const goto_programt::instructiont *, std::size_t>
+    target_mapt;
   target_mapt target_map;
 
-  unsigned i=0;
-
-  for(goto_programt::const_targett t=start; t!=end; t++, i++)
-    target_map[t]=i;
-
-  // make a copy
+  // make a copy, which shares the expressions of the original instructions
   std::vector<goto_programt::targett> target_vector;
-  target_vector.reserve(target_map.size());
-  assert(target_vector.empty());
 
   for(goto_programt::const_targett t=start; t!=end; t++)
   {
+    target_map.emplace(&*t, target_vector.size());
+
     // copy the instruction
     goto_programt::targett t_new =
       goto_program.add(goto_programt::instructiont(*t));
@@ -67,11 +67,11 @@ void goto_unwindt::copy_segment(
 
     goto_programt::const_targett tgt=t->get_target();
 
-    target_mapt::const_iterator m_it=target_map.find(tgt);
+    target_mapt::const_iterator m_it=target_map.find(&*tgt);
 
     if(m_it!=target_map.end())
     {
-      unsigned j=m_it->second;
+      std::size_t j=m_it->second;
 
       assert(j<target_vector.size());
       t->set_target(target_vector[j]);
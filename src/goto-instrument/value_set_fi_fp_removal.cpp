@@ -10,6 +10,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <goto-programs/goto_model.h>
 
+#include <pointer-analysis/andersen_points_to.h>
+#include <pointer-analysis/steensgaard_points_to.h>
 #include <pointer-analysis/value_set_analysis_fi.h>
 
 #include <util/c_types.h>
@@ -23,6 +25,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #  include <util/dstring.h>
 #endif
 
+#include <functional>
+
 void fix_argument_types(
   code_function_callt &function_call,
   const namespacet &ns)
@@ -179,17 +183,16 @@ void remove_function_pointer(
   target->type = OTHER;
 }
 
-void value_set_fi_fp_removal(
+/// Replace the calls through function pointers in \p goto_model by a case
+/// distinction over the functions \p get_functions gives for the pointer
+static void replace_function_pointers(
   goto_modelt &goto_model,
-  message_handlert &message_handler)
+  messaget &message,
+  const std::function<std::set<symbol_exprt>(
+    const irep_idt &,
+    goto_programt::const_targett,
+    const exprt &)> &get_functions)
 {
-  messaget message(message_handler);
-  message.status() << "Doing FI value set analysis" << messaget::eom;
-
-  const namespacet ns(goto_model.symbol_table);
-  value_set_analysis_fit value_sets(ns);
-  value_sets(goto_model.goto_functions);
-
   message.status() << "Instrumenting" << messaget::eom;
 
   // now replace aliases by addresses
@@ -208,22 +211,8 @@ void value_set_fi_fp_removal(
                            << messaget::eom;
 
           const auto &pointer = to_dereference_expr(call.function()).pointer();
-          auto addresses = value_sets.get_values(f.first, target, pointer);
-
-          std::set<symbol_exprt> functions;
-
-          for(const auto &address : addresses)
-          {
-            // is this a plain function address?
-            // strip leading '&'
-            if(address.id() == ID_object_descriptor)
-            {
-              const auto &od = to_object_descriptor_expr(address);
-              const auto &object = od.object();
-              if(object.type().id() == ID_code && object.id() == ID_symbol)
-                functions.insert(to_symbol_expr(object));
-            }
-          }
+          const std::set<symbol_exprt> functions =
+            get_functions(f.first, target, pointer);
 
           for(const auto &f : functions)
             message.status()
@@ -238,3 +227,108 @@ void value_set_fi_fp_removal(
   }
   goto_model.goto_functions.update();
 }
+
+void value_set_fi_fp_removal(
+  goto_modelt &goto_model,
+  message_handlert &message_handler)
+{
+  messaget message(message_handler);
+  message.status() << "Doing FI value set analysis" << messaget::eom;
+
+  const namespacet ns(goto_model.symbol_table);
+  value_set_analysis_fit value_sets(ns);
+  value_sets(goto_model.goto_functions);
+
+  replace_function_pointers(
+    goto_model,
+    message,
+    [&value_sets](
+      const irep_idt &function_id,
+      goto_programt::const_targett target,
+      const exprt &pointer) {
+      std::set<symbol_exprt> functions;
+
+      for(const auto &address :
+          value_sets.get_values(function_id, target, pointer))
+      {
+        // is this a plain function address?
+        // strip leading '&'
+        if(address.id() == ID_object_descriptor)
+        {
+          const auto &od = to_object_descriptor_expr(address);
+          const auto &object = od.object();
+          if(object.type().id() == ID_code && object.id() == ID_symbol)
+            functions.insert(to_symbol_expr(object));
+        }
+      }
+
+      return functions;
+    });
+}
+
+void andersen_fp_removal(
+  goto_modelt &goto_model,
+  message_handlert &message_handler)
+{
+  messaget message(message_handler);
+  message.status() << "Doing Andersen-style points-to analysis"
+                   << messaget::eom;
+
+  const namespacet ns(goto_model.symbol_table);
+  andersen_points_tot points_to(ns);
+  points_to(goto_model.goto_functions);
+
+  message.statistics() << "Points-to constraint graph: "
+                       << points_to.number_of_nodes() << " nodes, "
+                       << points_to.number_of_collapsed_nodes()
+                       << " collapsed on cycles" << messaget::eom;
+
+  replace_function_pointers(
+    goto_model,
+    message,
+    [&points_to](
+      const irep_idt &, goto_programt::const_targett, const exprt &pointer) {
+      std::set<symbol_exprt> functions;
+
+      for(const auto &object : points_to.get_values(pointer))
+      {
+        if(object.type().id() == ID_code && object.id() == ID_symbol)
+          functions.insert(to_symbol_expr(object));
+      }
+
+      return functions;
+    });
+}
+
+void steensgaard_fp_removal(
+  goto_modelt &goto_model,
+  message_handlert &message_handler)
+{
+  messaget message(message_handler);
+  message.status() << "Doing Steensgaard-style points-to analysis"
+                   << messaget::eom;
+
+  const namespacet ns(goto_model.symbol_table);
+  steensgaard_points_tot points_to(ns);
+  points_to(goto_model.goto_functions);
+
+  message.statistics() << "Points-to classes: " << points_to.number_of_classes()
+                       << " of " << points_to.number_of_nodes()
+                       << " locations" << messaget::eom;
+
+  replace_function_pointers(
+    goto_model,
+    message,
+    [&points_to](
+      const irep_idt &, goto_programt::const_targett, const exprt &pointer) {
+      std::set<symbol_exprt> functions;
+
+      for(const auto &object : points_to.get_values(pointer))
+      {
+        if(object.type().id() == ID_code && object.id() == ID_symbol)
+          functions.insert(to_symbol_expr(object));
+      }
+
+      return functions;
+    });
+}
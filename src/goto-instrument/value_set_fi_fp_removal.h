@@ -25,4 +25,23 @@ void value_set_fi_fp_removal(
   goto_modelt &goto_model,
   message_handlert &message_handler);
 
+/// As \ref value_set_fi_fp_removal, but with the points-to sets computed by
+/// \ref andersen_points_tot, which solves inclusion constraints rather than
+/// iterating the whole program to a fixed point, and scales to much larger
+/// programs. It does not distinguish the fields of structs.
+/// \param goto_model: goto model to be modified
+/// \param message_handler: message handler for status output
+void andersen_fp_removal(
+  goto_modelt &goto_model,
+  message_handlert &message_handler);
+
+/// As \ref value_set_fi_fp_removal, but with the points-to sets computed by
+/// \ref steensgaard_points_tot, which takes almost linear time in the size of
+/// the program and is less precise than \ref andersen_fp_removal.
+/// \param goto_model: goto model to be modified
+/// \param message_handler: message handler for status output
+void steensgaard_fp_removal(
+  goto_modelt &goto_model,
+  message_handlert &message_handler);
+
 #endif // CPROVER_GOTO_INSTRUMENT_VALUE_SET_FI_FP_REMOVAL_H
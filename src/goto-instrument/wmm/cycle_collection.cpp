@@ -15,6 +15,9 @@ Date: 2012
 
 #include <util/message.h>
 
+#include <algorithm>
+#include <limits>
+
 /// after the collection, eliminates the executions forbidden by an indirect
 /// thin-air
 void event_grapht::graph_explorert::filter_thin_air(
@@ -47,6 +50,94 @@ void event_grapht::graph_explorert::filter_thin_air(
 #endif
 }
 
+/// computes the SCCs of the union of the po and com graphs, with an
+/// iterative version of Tarjan's algorithm as the chains of po edges may be
+/// long
+void event_grapht::graph_explorert::compute_SCCs()
+{
+  const std::size_t no_scc=std::numeric_limits<std::size_t>::max();
+  const std::size_t n=egraph.size();
+
+  scc_of_event.assign(n, no_scc);
+  scc_sizes.clear();
+
+  std::vector<std::size_t> index(n, no_scc);
+  std::vector<std::size_t> lowlink(n, 0);
+  std::vector<event_idt> scc_stack;
+  std::vector<bool> on_stack(n, false);
+  std::size_t next_index=0;
+
+  /* an event and the next of its po, then com, successors to visit */
+  struct framet
+  {
+    event_idt v;
+    bool com;
+    wmm_grapht::edgest::const_iterator it;
+  };
+  std::vector<framet> call_stack;
+
+  const auto visit=[&](event_idt v) {
+    index[v]=lowlink[v]=next_index++;
+    scc_stack.push_back(v);
+    on_stack[v]=true;
+    call_stack.push_back(framet{v, false, egraph.po_out(v).begin()});
+  };
+
+  for(event_idt root=0; root<n; ++root)
+  {
+    if(index[root]!=no_scc)
+      continue;
+
+    visit(root);
+
+    while(!call_stack.empty())
+    {
+      framet &frame=call_stack.back();
+      const event_idt v=frame.v;
+
+      if(!frame.com && frame.it==egraph.po_out(v).end())
+      {
+        frame.com=true;
+        frame.it=egraph.com_out(v).begin();
+      }
+
+      if(frame.it!=(frame.com ? egraph.com_out(v) : egraph.po_out(v)).end())
+      {
+        const event_idt w=frame.it->first;
+        ++frame.it;
+        if(index[w]==no_scc)
+          visit(w);
+        else if(on_stack[w])
+          lowlink[v]=std::min(lowlink[v], index[w]);
+        continue;
+      }
+
+      call_stack.pop_back();
+      if(!call_stack.empty())
+      {
+        const event_idt u=call_stack.back().v;
+        lowlink[u]=std::min(lowlink[u], lowlink[v]);
+      }
+
+      if(lowlink[v]==index[v])
+      {
+        const std::size_t scc=scc_sizes.size();
+        scc_sizes.push_back(0);
+        event_idt w;
+        do
+        {
+          w=scc_stack.back();
+          scc_stack.pop_back();
+          on_stack[w]=false;
+          scc_of_event[w]=scc;
+          ++scc_sizes[scc];
+        }
+        while(w!=v);
+      }
+    }
+  }
+}
+
 /// Tarjan 1972 adapted and modified for events
 void event_grapht::graph_explorert::collect_cycles(
   std::set<critical_cyclet> &set_of_cycles,
@@ -82,12 +173,16 @@ void event_grapht::graph_explorert::collect_cycles(
   if(order->empty())
     return;
 
+  compute_SCCs();
+
   for(std::list<event_idt>::const_iterator
       st_it=order->begin();
       st_it!=order->end();
       ++st_it)
   {
     event_idt source=*st_it;
+    if(scc_sizes[scc_of_event[source]]<4)
+      continue;
     egraph.message.debug() << "explore " << egraph[source].id << messaget::eom;
     backtrack(
       set_of_cycles,
@@ -204,6 +299,10 @@ bool event_grapht::graph_explorert::backtrack(
   if(filtering(vertex))
     return false;
 
+  /* no path from outside the SCC of the source leads back to the source */
+  if(scc_of_event[vertex]!=scc_of_event[source])
+    return false;
+
   egraph.message.debug() << "bcktck "<<egraph[vertex].id<<"#"<<vertex<<", "
     <<egraph[source].id<<"#"<<source<<" lw:"<<lwfence_met<<" unsafe:"
     <<unsafe_met << messaget::eom;
@@ -18,6 +18,7 @@ Date: 2012
 #include <set>
 #include <map>
 #include <iosfwd>
+#include <vector>
 
 #include <util/graph.h>
 #include <util/invariant.h>
@@ -289,6 +290,13 @@ protected:
        indirect thin-air */
     void filter_thin_air(std::set<critical_cyclet> &set_of_cycles);
 
+    /* strongly connected components of the union of po and com: a cycle
+       through a source never leaves the SCC of the source, and one with
+       less than 4 events is never critical */
+    std::vector<std::size_t> scc_of_event;
+    std::vector<std::size_t> scc_sizes;
+    void compute_SCCs();
+
   public:
     graph_explorert(
       event_grapht &_egraph,
@@ -17,6 +17,7 @@ Date: 2012
 #include <string>
 #include <fstream>
 
+#include <util/csr_graph.h>
 #include <util/options.h>
 #include <util/prefix.h>
 
@@ -100,7 +101,7 @@ unsigned instrumentert::goto2graph_cfg(
     goto_functions.entry_point());
 
   std::vector<std::size_t> subgraph_index;
-  num_sccs=egraph_alt.SCCs(subgraph_index);
+  num_sccs = csr_grapht::from_graph(egraph_alt).SCCs(subgraph_index);
   assert(egraph_SCCs.empty());
   egraph_SCCs.resize(num_sccs, std::set<event_idt>());
   for(std::map<event_idt, event_idt>::const_iterator
@@ -14,6 +14,9 @@ Date: 2012
 #include "goto2graph.h"
 
 #include <fstream>
+#include <map>
+#include <queue>
+#include <vector>
 
 #ifdef HAVE_GLPK
 #include <glpk.h>
@@ -39,6 +42,9 @@ void instrumentert::instrument_with_strategy(instrumentation_strategyt strategy)
       case min_interference:
         instrument_minimum_interference_inserter(set_of_cycles);
         break;
+      case greedy_interference:
+        instrument_greedy_interference_inserter(set_of_cycles);
+        break;
       case read_first:
         instrument_one_read_per_cycle_inserter(set_of_cycles);
         break;
@@ -64,6 +70,9 @@ void instrumentert::instrument_with_strategy(instrumentation_strategyt strategy)
         case min_interference:
           instrument_minimum_interference_inserter(set_of_cycles_per_SCC[i]);
           break;
+        case greedy_interference:
+          instrument_greedy_interference_inserter(set_of_cycles_per_SCC[i]);
+          break;
         case read_first:
           instrument_one_read_per_cycle_inserter(set_of_cycles_per_SCC[i]);
           break;
@@ -351,6 +360,93 @@ void inline instrumentert::instrument_minimum_interference_inserter(
 #endif
 }
 
+void inline instrumentert::instrument_greedy_interference_inserter(
+  const std::set<event_grapht::critical_cyclet> &subset_of_cycles)
+{
+  /* Idea:
+     The same weighted set cover as for the minimum interference, but
+     solved greedily: repeatedly pick the pair with the largest number of
+     cycles not covered yet per unit of cost, until all cycles are covered.
+     The result is within a logarithmic factor of the optimum, needs no
+     glpk, and as the number of uncovered cycles of a pair only decreases,
+     the gains in the queue are upper bounds that are only recomputed when
+     a pair reaches the top. */
+  typedef event_grapht::critical_cyclet::delayt delayt;
+
+  /* the cycles each unsafe pair belongs to */
+  std::map<delayt, std::vector<std::size_t>> cycles_of_pair;
+  std::size_t nb_cycles=0;
+  for(const auto &cycle : subset_of_cycles)
+  {
+    for(const auto &pair : cycle.unsafe_pairs)
+      cycles_of_pair[pair].push_back(nb_cycles);
+    ++nb_cycles;
+  }
+
+  struct candidatet
+  {
+    std::size_t gain;
+    unsigned cost;
+    std::map<delayt, std::vector<std::size_t>>::const_iterator pair;
+
+    /* lower gain per cost first, ties broken by the order of the pairs */
+    bool operator<(const candidatet &other) const
+    {
+      if(gain*other.cost!=other.gain*cost)
+        return gain*other.cost<other.gain*cost;
+      return other.pair->first<pair->first;
+    }
+  };
+
+  std::priority_queue<candidatet> queue;
+  for(auto it=cycles_of_pair.cbegin(); it!=cycles_of_pair.cend(); ++it)
+    queue.push(candidatet{it->second.size(), cost(it->first), it});
+
+  std::vector<bool> covered(nb_cycles, false);
+  std::size_t total_cost=0;
+
+  while(!queue.empty())
+  {
+    candidatet candidate=queue.top();
+    queue.pop();
+
+    std::size_t gain=0;
+    for(const std::size_t c : candidate.pair->second)
+      if(!covered[c])
+        ++gain;
+
+    if(gain==0)
+      continue;
+    else if(gain<candidate.gain)
+    {
+      candidate.gain=gain;
+      queue.push(candidate);
+      continue;
+    }
+
+    for(const std::size_t c : candidate.pair->second)
+      covered[c]=true;
+    total_cost+=candidate.cost;
+
+    const delayt &pair=candidate.pair->first;
+    const abstract_eventt &first_ev=egraph[pair.first];
+    var_to_instr.insert(first_ev.variable);
+    id2loc.insert(
+      std::pair<irep_idt, source_locationt>(
+        first_ev.variable, first_ev.source_location));
+    if(!pair.is_po)
+    {
+      const abstract_eventt &second_ev=egraph[pair.second];
+      var_to_instr.insert(second_ev.variable);
+      id2loc.insert(
+        std::pair<irep_idt, source_locationt>(
+          second_ev.variable, second_ev.source_location));
+    }
+  }
+
+  message.statistics() << "greedy cost: " << total_cost << messaget::eom;
+}
+
 void inline instrumentert::instrument_my_events_inserter(
   const std::set<event_grapht::critical_cyclet> &set,
   const std::set<event_idt> &my_events)
@@ -21,6 +21,7 @@ Date: September 2011
 
 #include "weak_memory.h"
 
+#include <chrono>
 #include <set>
 
 #include <util/fresh_symbol.h>
@@ -167,6 +168,8 @@ void weak_memory(
   else
     instrumenter.set_parameters_collection(max_thds, 0, ignore_arrays);
 
+  const auto collection_start = std::chrono::steady_clock::now();
+
   if(SCC)
   {
     instrumenter.collect_cycles_by_SCCs(model);
@@ -176,13 +179,20 @@ void weak_memory(
     for(unsigned i=0; i<instrumenter.num_sccs; i++)
       if(instrumenter.egraph_SCCs[i].size()>=4)
       {
+        const std::size_t cycles =
+          instrumenter.set_of_cycles_per_SCC[interesting_scc++].size();
         message.status()<<"SCC #"<<i<<": "
-          <<instrumenter.set_of_cycles_per_SCC[interesting_scc++].size()
+          <<cycles
           <<" cycles found"<<messaget::eom;
-        total_cycles += instrumenter
-          .set_of_cycles_per_SCC[interesting_scc++].size();
+        total_cycles += cycles;
       }
 
+    const std::chrono::duration<double> collection_runtime =
+      std::chrono::steady_clock::now() - collection_start;
+    message.statistics() << "Cycle collection: " << total_cycles
+                         << " cycles in " << collection_runtime.count() << "s"
+                         << messaget::eom;
+
     /* if no cycle, no need to instrument */
     if(total_cycles == 0)
     {
@@ -196,6 +206,12 @@ void weak_memory(
     message.status()<<"cycles collected: "<<instrumenter.set_of_cycles.size()
       <<" cycles found"<<messaget::eom;
 
+    const std::chrono::duration<double> collection_runtime =
+      std::chrono::steady_clock::now() - collection_start;
+    message.statistics() << "Cycle collection: "
+                         << instrumenter.set_of_cycles.size() << " cycles in "
+                         << collection_runtime.count() << "s" << messaget::eom;
+
     /* if no cycle, no need to instrument */
     if(instrumenter.set_of_cycles.empty())
     {
@@ -30,7 +30,8 @@ enum instrumentation_strategyt
   read_first=2,
   write_first=3,
   my_events=4,
-  one_event_per_cycle=5
+  one_event_per_cycle=5,
+  greedy_interference=6
 };
 
 enum loop_strategyt
@@ -0,0 +1,98 @@
+/*******************************************************************\
+
+Module: Traces of GOTO Programs in a Compact Binary Format
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Traces of GOTO Programs in a Compact Binary Format
+
+#include "binary_goto_trace.h"
+
+#include <util/exception_utils.h>
+#include <util/json_binary.h>
+#include <util/json_stream.h>
+
+#include "json_goto_trace.h"
+
+/// The array the JSON conversion of a trace pushes its steps into, writing
+/// each one once the next one is requested, in the same fashion as
+/// json_stream_arrayt does
+class binary_trace_arrayt
+{
+public:
+  explicit binary_trace_arrayt(binary_json_writert &writer) : writer(writer)
+  {
+  }
+
+  jsont &push_back()
+  {
+    flush();
+    pending = true;
+    return step;
+  }
+
+  void flush()
+  {
+    if(pending)
+    {
+      writer.write(step);
+      step.clear();
+      pending = false;
+    }
+  }
+
+protected:
+  binary_json_writert &writer;
+  jsont step;
+  bool pending = false;
+};
+
+void write_binary_trace(
+  binary_json_writert &writer,
+  const namespacet &ns,
+  const goto_tracet &goto_trace,
+  const trace_optionst &trace_options)
+{
+  const goto_trace_stept &last_step = goto_trace.get_last_step();
+  writer.write(json_objectt{{"property", json_stringt(last_step.property_id)},
+                            {"description", json_stringt(last_step.comment)}});
+
+  binary_trace_arrayt steps(writer);
+  convert<binary_trace_arrayt>(ns, goto_trace, steps, trace_options);
+  steps.flush();
+
+  writer.write(json_nullt());
+}
+
+void binary_trace_to_json(std::istream &in, json_stream_arrayt &dest)
+{
+  binary_json_readert reader(in);
+  jsont header;
+
+  while(reader.read(header))
+  {
+    if(!header.is_object())
+      throw deserialization_exceptiont("trace header expected");
+
+    json_stream_objectt &json_result = dest.push_back_stream_object();
+    json_result["property"] = header["property"];
+    json_result["description"] = header["description"];
+    json_result["status"] = json_stringt("failed");
+
+    json_stream_arrayt &json_trace =
+      json_result.push_back_stream_array("trace");
+
+    jsont step;
+    while(true)
+    {
+      if(!reader.read(step))
+        throw deserialization_exceptiont("unexpected end of trace");
+      if(step.is_null())
+        break;
+      json_trace.push_back(step);
+    }
+  }
+}
@@ -0,0 +1,40 @@
+/*******************************************************************\
+
+Module: Traces of GOTO Programs in a Compact Binary Format
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Traces of GOTO Programs in a Compact Binary Format
+
+#ifndef CPROVER_GOTO_PROGRAMS_BINARY_GOTO_TRACE_H
+#define CPROVER_GOTO_PROGRAMS_BINARY_GOTO_TRACE_H
+
+#include "goto_trace.h"
+
+#include <iosfwd>
+
+class binary_json_writert;
+class json_stream_arrayt;
+
+/// Write the failed property of \p goto_trace and its steps, each as the
+/// JSON object the JSON trace has for it, using \p writer. Each step is
+/// written as soon as it is converted, and the sequence of steps ends with
+/// a null value. Several traces can be written one after the other using
+/// the same writer, which then writes each string only once.
+void write_binary_trace(
+  binary_json_writert &writer,
+  const namespacet &ns,
+  const goto_tracet &goto_trace,
+  const trace_optionst &trace_options = trace_optionst::default_options);
+
+/// Convert the traces written by \ref write_binary_trace that \p in holds to
+/// the JSON the `--json-ui` output has for the failed properties, one object
+/// with "property", "description", "status" and "trace" per trace, each step
+/// output as soon as it is read.
+/// \throws deserialization_exceptiont if \p in is malformed
+void binary_trace_to_json(std::istream &in, json_stream_arrayt &dest);
+
+#endif // CPROVER_GOTO_PROGRAMS_BINARY_GOTO_TRACE_H
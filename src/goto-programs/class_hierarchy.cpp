@@ -126,29 +126,15 @@ class_hierarchy_grapht::get_parents_trans(const irep_idt &c) const
   return get_other_reachable_ids(c, false);
 }
 
-void class_hierarchyt::get_children_trans_rec(
-  const irep_idt &c,
-  idst &dest) const
-{
-  class_mapt::const_iterator it=class_map.find(c);
-  if(it==class_map.end())
-    return;
-  const entryt &entry=it->second;
-
-  for(const auto &child : entry.children)
-    dest.push_back(child);
-
-  // recursive calls
-  for(const auto &child : entry.children)
-    get_children_trans_rec(child, dest);
-}
-
 /// Looks for all the struct types in the symbol table and construct a map from
 /// class names to a data structure that contains lists of parent and child
 /// classes for each struct type (ie class).
 /// \param symbol_table: The symbol table to analyze
 void class_hierarchyt::operator()(const symbol_tablet &symbol_table)
 {
+  children_trans.clear();
+  parents_trans.clear();
+
   for(const auto &symbol_pair : symbol_table.symbols)
   {
     if(symbol_pair.second.is_type && symbol_pair.second.type.id() == ID_struct)
@@ -171,26 +157,43 @@ void class_hierarchyt::operator()(const symbol_tablet &symbol_table)
   }
 }
 
-/// Get all the classes that class c inherits from (directly or indirectly). The
-/// first element(s) will be the immediate parents of c, though after this
-/// the order is all the parents of the first immediate parent
+/// Get all the classes that class c inherits from (directly or indirectly),
+/// or inherit from it, depending on \p relatives. The first element(s) will
+/// be the immediate relatives of c, followed by all the further relatives of
+/// the first immediate relative, and so on. Each list is computed once and
+/// then taken from \p cache, which makes repeated queries, as well as queries
+/// for classes sharing relatives, cheap.
 /// \param c: The class to consider
-/// \param [out] dest: A list of class ids that c eventually inherits from.
-void class_hierarchyt::get_parents_trans_rec(
+/// \param relatives: either the parents or the children of an entry
+/// \param cache: the lists computed so far for \p relatives
+/// \return A list of class ids that c eventually inherits from, or that
+///   eventually inherit from c.
+const class_hierarchyt::idst &class_hierarchyt::get_trans(
   const irep_idt &c,
-  idst &dest) const
+  idst entryt::*relatives,
+  trans_cachet &cache) const
 {
-  class_mapt::const_iterator it=class_map.find(c);
-  if(it==class_map.end())
-    return;
-  const entryt &entry=it->second;
+  const auto cached = cache.find(c);
+  if(cached != cache.end())
+    return cached->second;
 
-  for(const auto &child : entry.parents)
-    dest.push_back(child);
+  idst result;
+
+  class_mapt::const_iterator it = class_map.find(c);
+  if(it != class_map.end())
+  {
+    const idst &direct = it->second.*relatives;
+    result = direct;
+
+    for(const auto &relative : direct)
+    {
+      const idst &further = get_trans(relative, relatives, cache);
+      result.insert(result.end(), further.begin(), further.end());
+    }
+  }
 
-  // recursive calls
-  for(const auto &child : entry.parents)
-    get_parents_trans_rec(child, dest);
+  // references to the elements of an unordered_map remain valid on insertion
+  return cache.emplace(c, std::move(result)).first->second;
 }
 
 /// Output the class hierarchy in plain text
@@ -67,17 +67,13 @@ public:
   // transitively gets all children
   idst get_children_trans(const irep_idt &id) const
   {
-    idst result;
-    get_children_trans_rec(id, result);
-    return result;
+    return get_trans(id, &entryt::children, children_trans);
   }
 
   // transitively gets all parents
   idst get_parents_trans(const irep_idt &id) const
   {
-    idst result;
-    get_parents_trans_rec(id, result);
-    return result;
+    return get_trans(id, &entryt::parents, parents_trans);
   }
 
   void output(std::ostream &, bool children_only) const;
@@ -85,8 +81,15 @@ public:
   void output(json_stream_arrayt &, bool children_only) const;
 
 protected:
-  void get_children_trans_rec(const irep_idt &, idst &) const;
-  void get_parents_trans_rec(const irep_idt &, idst &) const;
+  typedef std::unordered_map<irep_idt, idst> trans_cachet;
+
+  /// The transitive children and parents computed so far, which lazy method
+  /// loading and `remove_instanceof` ask for again and again. The caches are
+  /// cleared when the class map is built.
+  mutable trans_cachet children_trans, parents_trans;
+
+  const idst &
+  get_trans(const irep_idt &, idst entryt::*, trans_cachet &) const;
 };
 
 /// Class hierarchy graph node: simply contains a class identifier.
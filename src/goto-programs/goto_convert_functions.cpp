@@ -10,6 +10,7 @@ Date: June 2003
 
 #include "goto_convert_functions.h"
 
+#include <util/find_symbols.h>
 #include <util/prefix.h>
 #include <util/std_code.h>
 #include <util/symbol_table.h>
@@ -19,6 +20,10 @@ Date: June 2003
 
 #include "goto_model.h"
 
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
 goto_convert_functionst::goto_convert_functionst(
   symbol_table_baset &_symbol_table,
   message_handlert &_message_handler)
@@ -30,27 +35,37 @@ goto_convert_functionst::~goto_convert_functionst()
 {
 }
 
+bool goto_convert_functionst::is_function(const symbolt &symbol)
+{
+  return !symbol.is_type && !symbol.is_macro && symbol.type.id() == ID_code &&
+         (symbol.mode == ID_C || symbol.mode == ID_cpp ||
+          symbol.mode == ID_java || symbol.mode == "jsil" ||
+          symbol.mode == ID_statement_list);
+}
+
 void goto_convert_functionst::goto_convert(goto_functionst &functions)
 {
   // warning! hash-table iterators are not stable
 
-  typedef std::list<irep_idt> symbol_listt;
-  symbol_listt symbol_list;
+  std::vector<irep_idt> symbol_list;
 
   for(const auto &symbol_pair : symbol_table.symbols)
   {
-    if(
-      !symbol_pair.second.is_type && !symbol_pair.second.is_macro &&
-      symbol_pair.second.type.id() == ID_code &&
-      (symbol_pair.second.mode == ID_C || symbol_pair.second.mode == ID_cpp ||
-       symbol_pair.second.mode == ID_java ||
-       symbol_pair.second.mode == "jsil" ||
-       symbol_pair.second.mode == ID_statement_list))
-    {
+    if(is_function(symbol_pair.second))
       symbol_list.push_back(symbol_pair.first);
-    }
   }
 
+  // Convert in the order of the identifiers rather than that of the hash
+  // table, so that the messages output are independent of how the symbol
+  // table was built. As all fresh symbols are named after the function they
+  // are introduced for, the result does not depend on the order.
+  std::sort(
+    symbol_list.begin(),
+    symbol_list.end(),
+    [](const irep_idt &a, const irep_idt &b) {
+      return id2string(a) < id2string(b);
+    });
+
   for(const auto &id : symbol_list)
   {
     convert_function(id, functions.function_map[id]);
@@ -72,6 +87,51 @@ void goto_convert_functionst::goto_convert(goto_functionst &functions)
 #endif
 }
 
+void goto_convert_functionst::goto_convert_reachable(
+  goto_functionst &functions)
+{
+  if(!symbol_table.has_symbol(goto_functionst::entry_point()))
+  {
+    goto_convert(functions);
+    return;
+  }
+
+  std::unordered_set<irep_idt> reachable{goto_functionst::entry_point()};
+  std::vector<irep_idt> worklist{goto_functionst::entry_point()};
+
+  while(!worklist.empty())
+  {
+    const irep_idt id = worklist.back();
+    worklist.pop_back();
+
+    goto_functionst::goto_functiont &f = functions.function_map[id];
+    convert_function(id, f);
+
+    // Any function referred to may be called, directly or via a pointer to
+    // it, including the ones in the initializers of static objects, which
+    // are assigned by the body of INITIALIZE_FUNCTION.
+    find_symbols_sett referenced;
+    for(const auto &instruction : f.body.instructions)
+    {
+      find_symbols(instruction.get_code(), referenced, true, false);
+      find_symbols(instruction.guard, referenced, true, false);
+    }
+
+    for(const auto &referenced_id : referenced)
+    {
+      const symbolt *symbol = symbol_table.lookup(referenced_id);
+      if(
+        symbol != nullptr && is_function(*symbol) &&
+        reachable.insert(referenced_id).second)
+      {
+        worklist.push_back(referenced_id);
+      }
+    }
+  }
+
+  functions.compute_location_numbers();
+}
+
 bool goto_convert_functionst::hide(const goto_programt &goto_program)
 {
   for(const auto &instruction : goto_program.instructions)
@@ -255,6 +315,20 @@ void goto_convert(
   goto_convert_functions.goto_convert(functions);
 }
 
+void goto_convert_reachable(
+  symbol_table_baset &symbol_table,
+  goto_functionst &functions,
+  message_handlert &message_handler)
+{
+  symbol_table_buildert symbol_table_builder =
+    symbol_table_buildert::wrap(symbol_table);
+
+  goto_convert_functionst goto_convert_functions(
+    symbol_table_builder, message_handler);
+
+  goto_convert_functions.goto_convert_reachable(functions);
+}
+
 void goto_convert(
   const irep_idt &identifier,
   symbol_table_baset &symbol_table,
@@ -30,6 +30,15 @@ void goto_convert(
   goto_modelt &,
   message_handlert &);
 
+/// Convert the functions reachable from the entry point, which are the ones
+/// it refers to, by calling them or taking their address, the ones these
+/// refer to, and so on. All functions are converted if there is no entry
+/// point.
+void goto_convert_reachable(
+  symbol_table_baset &symbol_table,
+  goto_functionst &functions,
+  message_handlert &);
+
 // just convert a specific function
 void goto_convert(
   const irep_idt &identifier,
@@ -41,6 +50,7 @@ class goto_convert_functionst:public goto_convertt
 {
 public:
   void goto_convert(goto_functionst &functions);
+  void goto_convert_reachable(goto_functionst &functions);
   void convert_function(
     const irep_idt &identifier,
     goto_functionst::goto_functiont &result);
@@ -54,6 +64,9 @@ public:
 protected:
   static bool hide(const goto_programt &);
 
+  /// \return whether \p symbol is a function of a language that is converted
+  static bool is_function(const symbolt &symbol);
+
   //
   // function calls
   //
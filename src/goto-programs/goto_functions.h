@@ -18,6 +18,9 @@ Date: June 2003
 
 #include <util/cprover_prefix.h>
 
+#include <algorithm>
+#include <utility>
+
 /// A collection of goto functions
 class goto_functionst
 {
@@ -86,6 +89,17 @@ public:
     compute_loop_numbers();
   }
 
+  /// Update the indices of \p program, the body of one of the functions,
+  /// when no other function has changed. Its instructions get fresh location
+  /// numbers, which keeps those of all other functions unique.
+  void update(goto_programt &program)
+  {
+    program.compute_incoming_edges();
+    program.compute_target_numbers();
+    compute_location_numbers(program);
+    program.compute_loop_numbers();
+  }
+
   /// Get the identifier of the entry point to a goto model
   static inline irep_idt entry_point()
   {
@@ -96,12 +110,16 @@ public:
   void swap(goto_functionst &other)
   {
     function_map.swap(other.function_map);
+    // keep the fresh location numbers with the functions they are fresh for
+    std::swap(unused_location_number, other.unused_location_number);
   }
 
   void copy_from(const goto_functionst &other)
   {
     for(const auto &fun : other.function_map)
       function_map[fun.first].copy_from(fun.second);
+    unused_location_number =
+      std::max(unused_location_number, other.unused_location_number);
   }
 
   std::vector<function_mapt::const_iterator> sorted() const;
@@ -349,8 +349,9 @@ jsont goto_function_inline_and_log(
   }
 
   goto_inline.goto_inline(function, goto_function, inline_map, true);
-  goto_model.goto_functions.update();
-  goto_model.goto_functions.compute_loop_numbers();
+  // transitive inlining only changes the body of the caller, the callees
+  // being copied into the cache before their calls are expanded
+  goto_model.goto_functions.update(goto_program);
 
   return goto_inline.output_inline_log_json();
 }
@@ -224,22 +224,9 @@ void goto_inlinet::insert_function_body(
   const irep_idt identifier=function.get_identifier();
 
   goto_programt body;
-  body.copy_from(goto_function.body);
+  instantiate(get_template(goto_function), body);
   inline_log.copy_from(goto_function.body, body);
 
-  goto_programt::instructiont &end=body.instructions.back();
-  DATA_INVARIANT(
-    end.is_end_function(),
-    "final instruction of a function must be an END_FUNCTION");
-  end.type=LOCATION;
-
-  // make sure the inlined function does not introduce hiding
-  if(goto_function.is_hidden())
-  {
-    for(auto &instruction : body.instructions)
-      instruction.labels.remove(CPROVER_PREFIX "HIDE");
-  }
-
   replace_return(body, lhs);
 
   goto_programt tmp1;
@@ -296,6 +283,75 @@ void goto_inlinet::insert_function_body(
   dest.destructive_insert(target, tmp);
 }
 
+const goto_inlinet::inline_templatet &
+goto_inlinet::get_template(const goto_functiont &goto_function)
+{
+  templatest::const_iterator t_it = templates.find(&goto_function);
+  if(t_it != templates.end())
+    return t_it->second;
+
+  inline_templatet &inline_template = templates[&goto_function];
+  goto_programt &body = inline_template.body;
+
+  std::unordered_map<const goto_programt::instructiont *, std::size_t> indices;
+
+  for(const auto &instruction : goto_function.body.instructions)
+  {
+    indices.emplace(&instruction, indices.size());
+
+    goto_programt::targett copy =
+      body.add(goto_programt::instructiont(instruction));
+    copy->incoming_edges.clear();
+
+    // make sure the inlined function does not introduce hiding
+    if(goto_function.is_hidden())
+      copy->labels.remove(CPROVER_PREFIX "HIDE");
+  }
+
+  goto_programt::instructiont &end = body.instructions.back();
+  DATA_INVARIANT(
+    end.is_end_function(),
+    "final instruction of a function must be an END_FUNCTION");
+  end.type = LOCATION;
+
+  std::size_t index = 0;
+  for(const auto &instruction : goto_function.body.instructions)
+  {
+    if(!instruction.targets.empty())
+    {
+      std::vector<std::size_t> targets;
+      targets.reserve(instruction.targets.size());
+      for(const auto &target : instruction.targets)
+        targets.push_back(indices.at(&*target));
+
+      inline_template.jumps.emplace_back(index, std::move(targets));
+    }
+
+    ++index;
+  }
+
+  return inline_template;
+}
+
+void goto_inlinet::instantiate(
+  const inline_templatet &inline_template,
+  goto_programt &dest)
+{
+  std::vector<goto_programt::targett> copies;
+  copies.reserve(inline_template.body.instructions.size());
+
+  for(const auto &instruction : inline_template.body.instructions)
+    copies.push_back(dest.add(goto_programt::instructiont(instruction)));
+
+  // the copied targets still refer to the template
+  for(const auto &jump : inline_template.jumps)
+  {
+    auto target = copies[jump.first]->targets.begin();
+    for(const std::size_t index : jump.second)
+      *target++ = copies[index];
+  }
+}
+
 /// Inlines a single function call
 /// Calls out to goto_inline_transitive or goto_inline_nontransitive
 void goto_inlinet::expand_function_call(
@@ -395,6 +451,7 @@ void goto_inlinet::expand_function_call(
                        << cached.body.instructions.size() << messaget::eom;
 
         inline_log.cleanup(cached.body);
+        templates.erase(&cached);
         cache.erase(identifier);
       }
     }
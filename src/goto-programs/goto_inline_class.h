@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_PROGRAMS_GOTO_INLINE_CLASS_H
 #define CPROVER_GOTO_PROGRAMS_GOTO_INLINE_CLASS_H
 
+#include <unordered_map>
 #include <unordered_set>
 
 #include <util/message.h>
@@ -164,6 +165,7 @@ protected:
   void clear()
   {
     cache.clear();
+    templates.clear();
     finished_set.clear();
     recursion_set.clear();
     no_body_set.clear();
@@ -184,6 +186,27 @@ protected:
     const symbol_exprt &function,
     const exprt::operandst &arguments);
 
+  /// The body of a function to be inlined, prepared once for insertion at any
+  /// number of call sites
+  struct inline_templatet
+  {
+    /// The body with the END_FUNCTION turned into a LOCATION, without hiding
+    /// labels nor incoming edges
+    goto_programt body;
+
+    /// The indices of the instructions with targets, with the indices of
+    /// these, for copying the body without a map from targets to their copies
+    std::vector<std::pair<std::size_t, std::vector<std::size_t>>> jumps;
+  };
+
+  /// \return the template of \p goto_function, which must not change while
+  ///   the template is in use
+  const inline_templatet &get_template(const goto_functiont &goto_function);
+
+  /// Append a copy of the body of \p inline_template to \p dest
+  static void
+  instantiate(const inline_templatet &inline_template, goto_programt &dest);
+
   void replace_return(
     goto_programt &body,
     const exprt &lhs);
@@ -204,6 +227,12 @@ protected:
   typedef goto_functionst::function_mapt cachet;
   cachet cache;
 
+  // templates of the functions, either in goto_functions or in the cache,
+  // inlined so far
+  typedef std::unordered_map<const goto_functiont *, inline_templatet>
+    templatest;
+  templatest templates;
+
   typedef std::unordered_set<irep_idt> finished_sett;
   finished_sett finished_set;
 
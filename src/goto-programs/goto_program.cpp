@@ -718,10 +718,14 @@ void goto_programt::instructiont::validate(
   validate_full_code(code, ns, vm);
   validate_full_expr(guard, ns, vm);
 
-  auto expr_symbol_finder = [&](const exprt &e) {
+  // the symbols of all sub-expressions and their types, collected in one
+  // traversal, as those of each sub-expression are contained in the ones of
+  // the whole expression
+  auto expr_symbol_finder = [&](const exprt &root) {
     find_symbols_sett typetags;
-    find_type_symbols(e.type(), typetags);
-    find_symbols_or_nexts(e, typetags);
+    find_symbols_or_nexts(root, typetags);
+    root.visit_pre(
+      [&typetags](const exprt &e) { find_type_symbols(e.type(), typetags); });
     const symbolt *symbol;
     for(const auto &identifier : typetags)
     {
@@ -833,7 +837,7 @@ void goto_programt::instructiont::validate(
       "assert instruction should not have a target",
       source_location);
 
-    std::for_each(guard.depth_begin(), guard.depth_end(), expr_symbol_finder);
+    expr_symbol_finder(guard);
     std::for_each(guard.depth_begin(), guard.depth_end(), type_finder);
     break;
   case OTHER:
@@ -900,7 +904,7 @@ void goto_programt::instructiont::validate(
       "function call instruction should contain a call statement",
       source_location);
 
-    std::for_each(code.depth_begin(), code.depth_end(), expr_symbol_finder);
+    expr_symbol_finder(code);
     std::for_each(code.depth_begin(), code.depth_end(), type_finder);
     break;
   case THROW:
@@ -0,0 +1,71 @@
+/*******************************************************************\
+
+Module: Fingerprints of Goto Programs
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Fingerprints of Goto Programs
+
+#include "goto_program_fingerprint.h"
+
+#include <util/irep_hash.h>
+#include <util/string_hash.h>
+
+#include "goto_program.h"
+
+#include <unordered_map>
+
+std::size_t stable_hash(const irept &irep)
+{
+  std::size_t result = hash_string(id2string(irep.id()));
+
+  for(const auto &sub : irep.get_sub())
+    result = hash_combine(result, stable_hash(sub));
+
+  // the order of the named subtrees depends on the strings, so they are
+  // combined by a commutative operation
+  std::size_t named_sub_hash = 0;
+  for(const auto &named_sub : irep.get_named_sub())
+  {
+    if(!irept::is_comment(named_sub.first))
+    {
+      named_sub_hash += hash_combine(
+        hash_string(id2string(named_sub.first)), stable_hash(named_sub.second));
+    }
+  }
+
+  return hash_combine(result, named_sub_hash);
+}
+
+std::size_t goto_program_fingerprint(const goto_programt &goto_program)
+{
+  // the location numbers may be out of date, hence a numbering of our own
+  std::unordered_map<const goto_programt::instructiont *, std::size_t> index;
+  for(const auto &instruction : goto_program.instructions)
+    index.emplace(&instruction, index.size());
+
+  std::size_t result = goto_program.instructions.size();
+
+  for(const auto &instruction : goto_program.instructions)
+  {
+    result = hash_combine(result, static_cast<std::size_t>(instruction.type));
+    result = hash_combine(result, stable_hash(instruction.get_code()));
+
+    if(instruction.has_condition())
+      result = hash_combine(result, stable_hash(instruction.get_condition()));
+
+    for(const auto &target : instruction.targets)
+    {
+      const std::size_t distance = index.at(&*target) - index.at(&instruction);
+      result = hash_combine(result, distance);
+    }
+
+    for(const auto &label : instruction.labels)
+      result = hash_combine(result, hash_string(id2string(label)));
+  }
+
+  return result;
+}
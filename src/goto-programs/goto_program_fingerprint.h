@@ -0,0 +1,30 @@
+/*******************************************************************\
+
+Module: Fingerprints of Goto Programs
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Fingerprints of Goto Programs
+
+#ifndef CPROVER_GOTO_PROGRAMS_GOTO_PROGRAM_FINGERPRINT_H
+#define CPROVER_GOTO_PROGRAMS_GOTO_PROGRAM_FINGERPRINT_H
+
+#include <cstddef>
+
+class goto_programt;
+class irept;
+
+/// A hash of \p irep that, unlike irept::hash, does not depend on the order
+/// in which strings were created, and is thus the same across runs; like
+/// irept::hash, it ignores comments such as source locations
+std::size_t stable_hash(const irept &irep);
+
+/// A structural hash of \p goto_program that is the same across runs, and
+/// across changes that only move the code: source locations are ignored,
+/// and jump targets are hashed by their distance from the jump
+std::size_t goto_program_fingerprint(const goto_programt &goto_program);
+
+#endif // CPROVER_GOTO_PROGRAMS_GOTO_PROGRAM_FINGERPRINT_H
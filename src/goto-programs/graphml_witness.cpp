@@ -284,8 +284,83 @@ static bool contains_symbol_prefix(const exprt &expr, const std::string &prefix)
   return false;
 }
 
+/// Merges nodes of the same name, and the edges between them, and passes the
+/// resulting graph on once it is complete. A merged node keeps an invariant
+/// only if all nodes merged into it have that same invariant.
+class merging_graphml_outputt : public graphml_outputt
+{
+public:
+  explicit merging_graphml_outputt(graphml_outputt &_output) : output(_output)
+  {
+  }
+
+  void add_node(const xml_graph_nodet &node) override
+  {
+    const auto entry = node_indices.emplace(node.node_name, nodes.size());
+    if(entry.second)
+    {
+      nodes.push_back(node);
+      out_edges.emplace_back();
+      return;
+    }
+
+    xml_graph_nodet &merged = nodes[entry.first->second];
+    merged.is_violation |= node.is_violation;
+    if(
+      merged.has_invariant &&
+      (!node.has_invariant || node.invariant != merged.invariant ||
+       node.invariant_scope != merged.invariant_scope))
+    {
+      merged.has_invariant = false;
+    }
+  }
+
+  void add_edge(const xmlt &edge) override
+  {
+    // the source of an edge is added before the edge
+    const std::size_t from = node_indices.at(edge.get_attribute("source"));
+    out_edges[from].emplace(edge.get_attribute("target"), edge);
+  }
+
+  /// Pass the merged nodes and edges on, in the order the nodes were first
+  /// added
+  void flush()
+  {
+    for(std::size_t i = 0; i < nodes.size(); ++i)
+    {
+      output.add_node(nodes[i]);
+      for(const auto &edge : out_edges[i])
+        output.add_edge(edge.second);
+    }
+  }
+
+protected:
+  graphml_outputt &output;
+  std::unordered_map<std::string, std::size_t> node_indices;
+  std::vector<xml_graph_nodet> nodes;
+  /// The outgoing edges of each node, by target
+  std::vector<std::map<std::string, xmlt>> out_edges;
+};
+
+static xml_graph_nodet make_node(std::string node_name)
+{
+  xml_graph_nodet node;
+  node.node_name = std::move(node_name);
+  node.is_violation = false;
+  node.has_invariant = false;
+  return node;
+}
+
 /// counterexample witness
 void graphml_witnesst::operator()(const goto_tracet &goto_trace)
+{
+  graphml_buildert builder(graphml);
+  (*this)(goto_trace, builder);
+}
+
+void graphml_witnesst::operator()(
+  const goto_tracet &goto_trace,
+  graphml_outputt &output)
 {
   unsigned int max_thread_idx = 0;
   bool trace_has_violation = false;
@@ -299,51 +374,41 @@ void graphml_witnesst::operator()(const goto_tracet &goto_trace)
       trace_has_violation = true;
   }
 
-  graphml.key_values["sourcecodelang"]="C";
-
-  const graphmlt::node_indext sink=graphml.add_node();
-  graphml[sink].node_name="sink";
-  graphml[sink].is_violation=false;
-  graphml[sink].has_invariant=false;
-
   if(max_thread_idx > 0 && trace_has_violation)
   {
-    std::vector<graphmlt::node_indext> nodes;
-
     for(unsigned int i = 0; i <= max_thread_idx + 1; ++i)
     {
-      nodes.push_back(graphml.add_node());
-      graphml[nodes.back()].node_name = "N" + std::to_string(i);
-      graphml[nodes.back()].is_violation = i == max_thread_idx + 1;
-      graphml[nodes.back()].has_invariant = false;
-    }
+      xml_graph_nodet node = make_node("N" + std::to_string(i));
+      node.is_violation = i == max_thread_idx + 1;
+      output.add_node(node);
+
+      if(node.is_violation)
+        break;
 
-    for(auto it = nodes.cbegin(); std::next(it) != nodes.cend(); ++it)
-    {
       xmlt edge("edge");
-      edge.set_attribute("source", graphml[*it].node_name);
-      edge.set_attribute("target", graphml[*std::next(it)].node_name);
-      const auto thread_id = std::distance(nodes.cbegin(), it);
+      edge.set_attribute("source", node.node_name);
+      edge.set_attribute("target", "N" + std::to_string(i + 1));
       xmlt &data = edge.new_element("data");
       data.set_attribute("key", "createThread");
-      data.data = std::to_string(thread_id);
-      if(thread_id == 0)
+      data.data = std::to_string(i);
+      if(i == 0)
       {
         xmlt &data = edge.new_element("data");
         data.set_attribute("key", "enterFunction");
         data.data = "main";
       }
-      graphml[*std::next(it)].in[*it].xml_node = edge;
-      graphml[*it].out[*std::next(it)].xml_node = edge;
+      output.add_edge(edge);
     }
 
+    output.add_node(make_node("sink"));
+
     // we do not provide any further details as CPAchecker does not seem to
     // handle more detailed concurrency witnesses
     return;
   }
 
   // step numbers start at 1
-  std::vector<std::size_t> step_to_node(goto_trace.steps.size()+1, 0);
+  std::vector<bool> is_node(goto_trace.steps.size() + 1, false);
 
   goto_tracet::stepst::const_iterator prev_it=goto_trace.steps.end();
   for(goto_tracet::stepst::const_iterator
@@ -352,11 +417,7 @@ void graphml_witnesst::operator()(const goto_tracet &goto_trace)
       it++) // we cannot replace this by a ranged for
   {
     if(filter_out(goto_trace, prev_it, it))
-    {
-      step_to_node[it->step_nr]=sink;
-
       continue;
-    }
 
     // skip declarations followed by an immediate assignment
     goto_tracet::stepst::const_iterator next=it;
@@ -366,55 +427,63 @@ void graphml_witnesst::operator()(const goto_tracet &goto_trace)
        it->full_lhs==next->full_lhs &&
        it->pc->source_location==next->pc->source_location)
     {
-      step_to_node[it->step_nr]=sink;
-
       continue;
     }
 
     prev_it=it;
-
-    const source_locationt &source_location=it->pc->source_location;
-
-    const graphmlt::node_indext node=graphml.add_node();
-    graphml[node].node_name=
-      std::to_string(it->pc->location_number)+"."+std::to_string(it->step_nr);
-    graphml[node].file=source_location.get_file();
-    graphml[node].line=source_location.get_line();
-    graphml[node].is_violation=
-      it->type==goto_trace_stept::typet::ASSERT && !it->cond_value;
-    graphml[node].has_invariant=false;
-
-    step_to_node[it->step_nr]=node;
+    is_node[it->step_nr] = true;
   }
 
+  const auto node_name = [](const goto_trace_stept &step) {
+    return std::to_string(step.pc->location_number) + "." +
+           std::to_string(step.step_nr);
+  };
+
   unsigned thread_id = 0;
 
-  // build edges
-  for(goto_tracet::stepst::const_iterator
-      it=goto_trace.steps.begin();
-      it!=goto_trace.steps.end();
-      ) // no ++it
+  // Write the nodes in order, each followed by its outgoing edge. The steps
+  // between the source of an edge and its target do not have edges of their
+  // own.
+  goto_tracet::stepst::const_iterator edge_source = goto_trace.steps.begin();
+  for(goto_tracet::stepst::const_iterator it = goto_trace.steps.begin();
+      it != goto_trace.steps.end();
+      ++it)
   {
-    const std::size_t from=step_to_node[it->step_nr];
+    if(!is_node[it->step_nr])
+    {
+      if(it == edge_source)
+        ++edge_source;
+      continue;
+    }
+
+    const source_locationt &source_location = it->pc->source_location;
+
+    xml_graph_nodet node = make_node(node_name(*it));
+    node.file = source_location.get_file();
+    node.line = source_location.get_line();
+    node.is_violation =
+      it->type == goto_trace_stept::typet::ASSERT && !it->cond_value;
+    output.add_node(node);
+
+    if(it != edge_source)
+      continue;
 
-    // no outgoing edges from sinks or violation nodes
-    if(from == sink || graphml[from].is_violation)
+    // no outgoing edges from violation nodes
+    if(node.is_violation)
     {
-      ++it;
+      ++edge_source;
       continue;
     }
 
     auto next = std::next(it);
     for(; next != goto_trace.steps.end() &&
-          (step_to_node[next->step_nr] == sink ||
+          (!is_node[next->step_nr] ||
            pointee_address_equalt{}(it->pc, next->pc)); // NOLINT
         ++next)
     {
       // advance
     }
-    const std::size_t to=
-      next==goto_trace.steps.end()?
-      sink:step_to_node[next->step_nr];
+    edge_source = next;
 
     switch(it->type)
     {
@@ -425,24 +494,24 @@ void graphml_witnesst::operator()(const goto_tracet &goto_trace)
     {
       xmlt edge(
         "edge",
-        {{"source", graphml[from].node_name},
-         {"target", graphml[to].node_name}},
+        {{"source", node.node_name},
+         {"target",
+          next == goto_trace.steps.end() ? "sink" : node_name(*next)}},
         {});
 
       {
         xmlt &data_f = edge.new_element("data");
         data_f.set_attribute("key", "originfile");
-        data_f.data = id2string(graphml[from].file);
+        data_f.data = id2string(node.file);
 
         xmlt &data_l = edge.new_element("data");
         data_l.set_attribute("key", "startline");
-        data_l.data = id2string(graphml[from].line);
+        data_l.data = id2string(node.line);
 
         xmlt &data_t = edge.new_element("data");
         data_t.set_attribute("key", "threadId");
         data_t.data = std::to_string(it->thread_nr);
       }
-
       const auto lhs_object = it->get_lhs_object();
       if(
         it->type == goto_trace_stept::typet::ASSIGNMENT &&
@@ -497,8 +566,7 @@ void graphml_witnesst::operator()(const goto_tracet &goto_trace)
       {
       }
 
-      graphml[to].in[from].xml_node = edge;
-      graphml[from].out[to].xml_node = edge;
+      output.add_edge(edge);
 
       break;
     }
@@ -521,23 +589,39 @@ void graphml_witnesst::operator()(const goto_tracet &goto_trace)
       // ignore
       break;
     }
-
-    it=next;
   }
+
+  output.add_node(make_node("sink"));
 }
 
 /// proof witness
 void graphml_witnesst::operator()(const symex_target_equationt &equation)
 {
-  graphml.key_values["sourcecodelang"]="C";
+  graphml_buildert builder(graphml);
+  (*this)(equation, builder);
+}
 
-  const graphmlt::node_indext sink=graphml.add_node();
-  graphml[sink].node_name="sink";
-  graphml[sink].is_violation=false;
-  graphml[sink].has_invariant=false;
+void graphml_witnesst::operator()(
+  const symex_target_equationt &equation,
+  graphml_outputt &output)
+{
+  if(!compact_proof)
+  {
+    convert_proof(equation, output);
+    return;
+  }
+
+  merging_graphml_outputt merging_output(output);
+  convert_proof(equation, merging_output);
+  merging_output.flush();
+}
 
+void graphml_witnesst::convert_proof(
+  const symex_target_equationt &equation,
+  graphml_outputt &output)
+{
   // step numbers start at 1
-  std::vector<std::size_t> step_to_node(equation.SSA_steps.size()+1, 0);
+  std::vector<bool> is_node(equation.SSA_steps.size() + 1, false);
 
   std::size_t step_nr=1;
   for(symex_target_equationt::SSA_stepst::const_iterator
@@ -554,8 +638,6 @@ void graphml_witnesst::operator()(const symex_target_equationt &equation)
       source_location.is_nil() || source_location.is_built_in() ||
       source_location.get_line().empty())
     {
-      step_to_node[step_nr]=sink;
-
       continue;
     }
 
@@ -567,51 +649,73 @@ void graphml_witnesst::operator()(const symex_target_equationt &equation)
        it->ssa_full_lhs==next->ssa_full_lhs &&
        it->source.pc->source_location==next->source.pc->source_location)
     {
-      step_to_node[step_nr]=sink;
-
       continue;
     }
 
-    const graphmlt::node_indext node=graphml.add_node();
-    graphml[node].node_name=
-      std::to_string(it->source.pc->location_number)+"."+
-      std::to_string(step_nr);
-    graphml[node].file=source_location.get_file();
-    graphml[node].line=source_location.get_line();
-    graphml[node].is_violation=false;
-    graphml[node].has_invariant=false;
-
-    step_to_node[step_nr]=node;
+    is_node[step_nr] = true;
   }
 
-  // build edges
-  step_nr=1;
-  for(symex_target_equationt::SSA_stepst::const_iterator
-      it=equation.SSA_steps.begin();
-      it!=equation.SSA_steps.end();
-      ) // no ++it
+  // all steps at one program location are a single node in a compact proof
+  const auto node_name =
+    [this](const SSA_stept &step, std::size_t nr) {
+      const std::string location =
+        std::to_string(step.source.pc->location_number);
+      return compact_proof ? location : location + "." + std::to_string(nr);
+    };
+
+  xml_graph_nodet sink = make_node("sink");
+
+  // The invariant of the target of the last edge, which is written after the
+  // edge. Its step number is 0 if there is none.
+  std::size_t invariant_step_nr = 0;
+  std::string invariant;
+  std::string invariant_scope;
+
+  // Write the nodes in order, each followed by its outgoing edge. The steps
+  // between the source of an edge and its target do not have edges of their
+  // own.
+  std::size_t edge_source_step_nr = 1;
+  step_nr = 1;
+  for(symex_target_equationt::SSA_stepst::const_iterator it =
+        equation.SSA_steps.begin();
+      it != equation.SSA_steps.end();
+      it++, step_nr++) // we cannot replace this by a ranged for
   {
-    const std::size_t from=step_to_node[step_nr];
-
-    if(from==sink)
+    if(!is_node[step_nr])
     {
-      ++it;
-      ++step_nr;
+      if(step_nr == edge_source_step_nr)
+        ++edge_source_step_nr;
       continue;
     }
 
+    const source_locationt &source_location = it->source.pc->source_location;
+
+    xml_graph_nodet node = make_node(node_name(*it, step_nr));
+    node.file = source_location.get_file();
+    node.line = source_location.get_line();
+    if(step_nr == invariant_step_nr)
+    {
+      node.has_invariant = true;
+      node.invariant = invariant;
+      node.invariant_scope = invariant_scope;
+    }
+    output.add_node(node);
+
+    if(step_nr != edge_source_step_nr)
+      continue;
+
     symex_target_equationt::SSA_stepst::const_iterator next=it;
     std::size_t next_step_nr=step_nr;
     for(++next, ++next_step_nr;
         next!=equation.SSA_steps.end() &&
-        (step_to_node[next_step_nr]==sink || it->source.pc==next->source.pc);
+        (!is_node[next_step_nr] || it->source.pc==next->source.pc);
         ++next, ++next_step_nr)
     {
       // advance
     }
-    const std::size_t to=
-      next==equation.SSA_steps.end()?
-      sink:step_to_node[next_step_nr];
+    edge_source_step_nr = next_step_nr;
+
+    const bool to_sink = next == equation.SSA_steps.end();
 
     switch(it->type)
     {
@@ -622,18 +726,18 @@ void graphml_witnesst::operator()(const symex_target_equationt &equation)
     {
       xmlt edge(
         "edge",
-        {{"source", graphml[from].node_name},
-         {"target", graphml[to].node_name}},
+        {{"source", node.node_name},
+         {"target", to_sink ? sink.node_name : node_name(*next, next_step_nr)}},
         {});
 
       {
         xmlt &data_f = edge.new_element("data");
         data_f.set_attribute("key", "originfile");
-        data_f.data = id2string(graphml[from].file);
+        data_f.data = id2string(node.file);
 
         xmlt &data_l = edge.new_element("data");
         data_l.set_attribute("key", "startline");
-        data_l.data = id2string(graphml[from].line);
+        data_l.data = id2string(node.line);
       }
 
       if(
@@ -642,14 +746,21 @@ void graphml_witnesst::operator()(const symex_target_equationt &equation)
       {
         irep_idt identifier = it->ssa_lhs.get_object_name();
 
-        graphml[to].has_invariant = true;
         code_assignt assign(it->ssa_lhs, it->ssa_rhs);
-        graphml[to].invariant = convert_assign_rec(identifier, assign);
-        graphml[to].invariant_scope = id2string(it->source.function_id);
+        invariant = convert_assign_rec(identifier, assign);
+        invariant_scope = id2string(it->source.function_id);
+
+        if(to_sink)
+        {
+          sink.has_invariant = true;
+          sink.invariant = invariant;
+          sink.invariant_scope = invariant_scope;
+        }
+        else
+          invariant_step_nr = next_step_nr;
       }
 
-      graphml[to].in[from].xml_node = edge;
-      graphml[from].out[to].xml_node = edge;
+      output.add_edge(edge);
 
       break;
     }
@@ -672,8 +783,7 @@ void graphml_witnesst::operator()(const symex_target_equationt &equation)
       // ignore
       break;
     }
-
-    it=next;
-    step_nr=next_step_nr;
   }
+
+  output.add_node(sink);
 }
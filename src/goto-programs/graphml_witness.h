@@ -23,14 +23,26 @@ class symex_target_equationt;
 class graphml_witnesst
 {
 public:
-  explicit graphml_witnesst(const namespacet &_ns)
-    : ns(_ns)
+  /// \param _ns: namespace
+  /// \param _compact_proof: whether a proof witness has a node per program
+  ///   location rather than one per step of the equation
+  explicit graphml_witnesst(const namespacet &_ns, bool _compact_proof = false)
+    : ns(_ns), compact_proof(_compact_proof)
   {
+    graphml.key_values["sourcecodelang"] = "C";
   }
 
+  /// Build the witness for a trace or an equation in \ref graph
   void operator()(const goto_tracet &goto_trace);
   void operator()(const symex_target_equationt &equation);
 
+  /// Pass the nodes and edges of the witness to \p output as they are
+  /// generated, without building \ref graph. The graph data to pass
+  /// to a \ref graphml_writert is that of \ref graph.
+  void operator()(const goto_tracet &goto_trace, graphml_outputt &output);
+  void
+  operator()(const symex_target_equationt &equation, graphml_outputt &output);
+
   const graphmlt &graph()
   {
     return graphml;
@@ -38,8 +50,12 @@ public:
 
 protected:
   const namespacet &ns;
+  bool compact_proof;
   graphmlt graphml;
 
+  void
+  convert_proof(const symex_target_equationt &equation, graphml_outputt &);
+
   void remove_l0_l1(exprt &expr);
   std::string convert_assign_rec(
     const irep_idt &identifier,
@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/config.h>
 #include <util/message.h>
 #include <util/options.h>
+#include <util/phase_profile.h>
 
 #ifdef _MSC_VER
 #  include <util/unicode.h>
@@ -26,6 +27,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <langapi/mode.h>
 
 #include <goto-programs/rebuild_goto_start_function.h>
+#include <linking/static_lifetime_init.h>
 #include <util/exception_utils.h>
 
 #include "goto_convert_functions.h"
@@ -119,6 +121,8 @@ goto_modelt initialize_goto_model(
 
       msg.status() << "Parsing " << filename << messaget::eom;
 
+      phase_profile_scopet phase_profile_scope("parse");
+
       if(language.parse(infile, filename))
       {
         throw invalid_source_file_exceptiont("PARSING ERROR");
@@ -129,22 +133,54 @@ goto_modelt initialize_goto_model(
 
     msg.status() << "Converting" << messaget::eom;
 
+    phase_profile_scopet phase_profile_scope("typecheck");
+
     if(language_files.typecheck(goto_model.symbol_table))
     {
       throw invalid_source_file_exceptiont("CONVERSION ERROR");
     }
   }
 
-  for(const auto &file : binaries)
+  // With --read-reachable-functions, only the bodies of functions reachable
+  // from the entry point are read from a single goto binary. The others are
+  // left without body.
+  std::unordered_set<irep_idt> entry_points;
+  if(
+    sources.empty() && binaries.size() == 1 &&
+    options.get_bool_option("read-reachable-functions"))
+  {
+    if(options.is_set("function"))
+      entry_points.insert(options.get_option("function"));
+    entry_points.insert(INITIALIZE_FUNCTION);
+    entry_points.insert(goto_functionst::entry_point());
+  }
+
+  if(!entry_points.empty())
   {
     msg.status() << "Reading GOTO program from file" << messaget::eom;
 
-    if(read_object_and_link(file, goto_model, message_handler))
+    phase_profile_scopet phase_profile_scope("read goto binaries");
+
+    const std::string &file = binaries.front();
+    if(read_object_and_link(file, goto_model, message_handler, entry_points))
     {
       throw invalid_source_file_exceptiont(
         "failed to read object or link in file '" + file + '\'');
     }
   }
+  else if(!binaries.empty())
+  {
+    msg.status() << "Reading GOTO program from file" << messaget::eom;
+
+    phase_profile_scopet phase_profile_scope("read goto binaries");
+
+    if(read_objects_and_link(
+         {binaries.begin(), binaries.end()}, goto_model, message_handler))
+    {
+      throw invalid_source_file_exceptiont(
+        "failed to read objects or link goto binaries");
+    }
+  }
 
   bool binaries_provided_start=
     goto_model.symbol_table.has_symbol(goto_functionst::entry_point());
@@ -199,10 +235,20 @@ goto_modelt initialize_goto_model(
 
   msg.status() << "Generating GOTO Program" << messaget::eom;
 
-  goto_convert(
-    goto_model.symbol_table,
-    goto_model.goto_functions,
-    message_handler);
+  phase_profile_scopet phase_profile_scope("goto convert");
+
+  // Functions that are not reachable from the entry point would be dropped
+  // later on, and are thus not converted in the first place.
+  if(options.get_bool_option("drop-unused-functions"))
+  {
+    goto_convert_reachable(
+      goto_model.symbol_table, goto_model.goto_functions, message_handler);
+  }
+  else
+  {
+    goto_convert(
+      goto_model.symbol_table, goto_model.goto_functions, message_handler);
+  }
 
   if(options.is_set("validate-goto-model"))
   {
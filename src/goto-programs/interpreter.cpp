@@ -56,6 +56,29 @@ void interpretert::operator()()
     command();
 }
 
+bool interpretert::run(std::mt19937_64 &random, std::size_t max_steps)
+{
+  show=false;
+  random_inputs=&random;
+
+  try
+  {
+    initialize(true);
+    while(!done && total_steps<max_steps)
+      step();
+  }
+  catch(const char *)
+  {
+    return true;
+  }
+  catch(const std::string &)
+  {
+    return true;
+  }
+
+  return !done;
+}
+
 /// Initializes the memory map of the interpreter and [optionally] runs up to
 /// the entry point (thus doing the cprover initialization)
 void interpretert::initialize(bool init)
@@ -145,6 +168,7 @@ void interpretert::command()
                     << "h: display this menu\n"
                     << "j: output json trace\n"
                     << "m: output memory dump\n"
+                    << "c: toggle compiled evaluation of expressions\n"
                     << "o: output goto trace\n"
                     << "q: quit\n"
                     << "r: run up to entry point\n"
@@ -172,6 +196,12 @@ void interpretert::command()
     }
     json_steps.output(output.result());
   }
+  else if(ch=='c')
+  {
+    compiled=!compiled;
+    output.status() << "compiled evaluation "
+                    << (compiled ? "enabled" : "disabled") << messaget::eom;
+  }
   else if(ch=='m')
   {
     ch=tolower(command[1]);
@@ -256,6 +286,7 @@ void interpretert::step()
   steps.add_step(goto_trace_stept());
   goto_trace_stept &trace_step=steps.get_last_step();
   trace_step.thread_nr=thread_id;
+  trace_step.function_id=function->first;
   trace_step.pc=pc;
   switch(pc->type)
   {
@@ -299,7 +330,7 @@ void interpretert::step()
     if(call_stack.top().return_value_address != 0)
     {
       mp_vectort rhs;
-      evaluate(pc->return_value(), rhs);
+      evaluate_instruction_expr(pc->return_value(), rhs);
       assign(call_stack.top().return_value_address, rhs);
     }
 
@@ -420,6 +451,73 @@ void interpretert::execute_other()
 void interpretert::execute_decl()
 {
   PRECONDITION(pc->get_code().get_statement() == ID_decl);
+
+  if(random_inputs!=nullptr)
+    assign_random_value(pc->decl_symbol());
+}
+
+/// \return a random value of the scalar type \p type, drawn from \p random,
+///   or nothing if \p type is not scalar
+static optionalt<mp_integer>
+random_value(const typet &type, std::mt19937_64 &random)
+{
+  if(type.id()==ID_bool || type.id()==ID_c_bool)
+    return mp_integer(random()%2);
+  else if(type.id()!=ID_signedbv && type.id()!=ID_unsignedbv)
+    return {};
+
+  const std::size_t width=to_bitvector_type(type).get_width();
+  const bool is_signed=type.id()==ID_signedbv;
+
+  // small values and the bounds of the type are likelier to make a
+  // difference than values drawn uniformly
+  mp_integer value;
+  switch(random()%4)
+  {
+  case 0:
+  case 1:
+    value=mp_integer(static_cast<long>(random()%17))-(is_signed ? 8 : 0);
+    break;
+  case 2:
+    if(random()%2==0)
+      value=to_integer_bitvector_type(type).largest();
+    else
+      value=to_integer_bitvector_type(type).smallest();
+    break;
+  default:
+    value=mp_integer(static_cast<unsigned long>(random()));
+  }
+
+  return bvrep2integer(integer2bvrep(value, width), width, is_signed);
+}
+
+bool interpretert::assign_random_value(const exprt &lhs)
+{
+  PRECONDITION(random_inputs!=nullptr);
+
+  const auto value=random_value(ns.follow(lhs.type()), *random_inputs);
+  if(!value.has_value())
+    return false;
+
+  const mp_integer address=evaluate_address(lhs);
+  mp_vectort rhs={*value};
+  assign(address, rhs);
+
+  goto_trace_stept &trace_step=steps.get_last_step();
+  if(!trace_step.is_function_call())
+  {
+    trace_step.full_lhs=lhs;
+    trace_step.full_lhs_value=get_value(lhs.type(), rhs);
+  }
+
+  // the variable is an input nonetheless
+  if(address<memory.size())
+  {
+    memory[numeric_cast_v<std::size_t>(address)].initialized=
+      memory_cellt::initializedt::READ_BEFORE_WRITTEN;
+  }
+
+  return true;
 }
 
 /// Retrieves the member at \p offset of an object of type \p object_type.
@@ -656,7 +754,7 @@ void interpretert::execute_assign()
   const code_assignt &code_assign = pc->get_assign();
 
   mp_vectort rhs;
-  evaluate(code_assign.rhs(), rhs);
+  evaluate_instruction_expr(code_assign.rhs(), rhs);
 
   if(!rhs.empty())
   {
@@ -678,7 +776,13 @@ void interpretert::execute_assign()
   else if(code_assign.rhs().id()==ID_side_effect)
   {
     side_effect_exprt side_effect=to_side_effect_expr(code_assign.rhs());
-    if(side_effect.get_statement()==ID_nondet)
+    if(
+      side_effect.get_statement()==ID_nondet && random_inputs!=nullptr &&
+      assign_random_value(code_assign.lhs()))
+    {
+      return;
+    }
+    else if(side_effect.get_statement()==ID_nondet)
     {
       mp_integer address =
         numeric_cast_v<std::size_t>(evaluate_address(code_assign.lhs()));
@@ -729,7 +833,13 @@ void interpretert::execute_assume()
 
 void interpretert::execute_assert()
 {
-  if(!evaluate_boolean(pc->get_condition()))
+  goto_trace_stept &trace_step=steps.get_last_step();
+  trace_step.property_id=pc->source_location.get_property_id();
+  trace_step.comment=id2string(pc->source_location.get_comment());
+  trace_step.cond_expr=pc->get_condition();
+  trace_step.cond_value=evaluate_boolean(pc->get_condition());
+
+  if(!trace_step.cond_value)
   {
     if(show)
       output.error() << "assertion failed at " << pc->location_number << "\n"
@@ -838,7 +948,9 @@ void interpretert::execute_function_call()
       return;
     }
 
-    if(show)
+    if(random_inputs!=nullptr && return_value_address>0)
+      assign_random_value(function_call.lhs());
+    else if(show)
       output.error() << "no body for " << identifier << messaget::eom;
   }
 }
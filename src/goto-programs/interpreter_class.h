@@ -12,6 +12,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_PROGRAMS_INTERPRETER_CLASS_H
 #define CPROVER_GOTO_PROGRAMS_INTERPRETER_CLASS_H
 
+#include <cstdint>
+#include <memory>
+#include <random>
 #include <stack>
 
 #include <util/arith_tools.h>
@@ -36,7 +39,11 @@ public:
       ns(_symbol_table),
       goto_functions(_goto_functions),
       stack_pointer(0),
-      done(false)
+      done(false),
+      num_dynamic_objects(0),
+      thread_id(0),
+      random_inputs(nullptr),
+      compiled(true)
   {
     show=true;
   }
@@ -44,6 +51,22 @@ public:
   void operator()();
   void print_memory(bool input_flags);
 
+  /// Execute the program from its entry point without interaction for at
+  /// most \p max_steps steps, taking the values of uninitialised scalar
+  /// variables, nondeterministic choices and functions without body from
+  /// \p random, which makes for random testing
+  /// \return false if the program ran to its end, true if it was stopped,
+  ///   or if it failed an assumption or cannot be executed; the trace of
+  ///   the steps executed is available either way
+  bool run(std::mt19937_64 &random, std::size_t max_steps);
+
+  /// The steps executed so far, where assertions carry their property ids
+  /// and whether they held
+  const goto_tracet &get_trace() const
+  {
+    return steps;
+  }
+
   // An assertion that identifier 'id' carries value in some particular context.
   // Used to record parameter (id) assignment (value) lists for function calls.
   struct function_assignmentt
@@ -225,6 +248,12 @@ protected:
   void execute_decl();
   void clear_input_flags();
 
+  /// With \ref random_inputs, assign a random value to \p lhs if that is
+  /// of scalar type, and record the assignment in the last step unless the
+  /// step is a function call
+  /// \return whether a value was assigned
+  bool assign_random_value(const exprt &lhs);
+
   void allocate(
     const mp_integer &address,
     const mp_integer &size);
@@ -272,15 +301,95 @@ protected:
   int num_dynamic_objects;
   unsigned thread_id;
 
+  /// The source of the values of nondeterministic choices, if any
+  std::mt19937_64 *random_inputs;
+
   bool evaluate_boolean(const exprt &expr)
   {
     mp_vectort v;
-    evaluate(expr, v);
+    evaluate_instruction_expr(expr, v);
     if(v.size()!=1)
       throw "invalid boolean value";
     return v.front()!=0;
   }
 
+  /// An expression lowered to code for a machine with 64-bit integer
+  /// registers, each instruction writing register `dest`, and jumps giving
+  /// the index of their target instruction in `value`
+  class compiled_exprt
+  {
+  public:
+    enum class opcodet
+    {
+      CONSTANT,
+      LOAD,
+      MOVE,
+      PLUS,
+      MINUS,
+      MULT,
+      DIV,
+      UNARY_MINUS,
+      NOT,
+      EQUAL,
+      NOTEQUAL,
+      LE,
+      LT,
+      SIGNED_CAST,
+      UNSIGNED_CAST,
+      BOOL_CAST,
+      JUMP,
+      JUMP_IF_ZERO,
+      JUMP_IF_NOT_ZERO
+    };
+
+    struct instructiont
+    {
+      opcodet opcode;
+      std::size_t dest, op0, op1;
+      /// The constant, the width of a cast, or the target of a jump
+      std::int64_t value;
+      /// The symbol to load
+      const symbol_exprt *symbol;
+    };
+
+    std::vector<instructiont> code;
+    std::size_t number_of_registers = 0;
+    std::size_t result = 0;
+
+    std::size_t add(
+      opcodet opcode,
+      std::size_t op0 = 0,
+      std::size_t op1 = 0,
+      std::int64_t value = 0)
+    {
+      code.push_back({opcode, number_of_registers, op0, op1, value, nullptr});
+      return number_of_registers++;
+    }
+  };
+
+  /// Evaluate \p expr of an instruction, which is compiled on its first
+  /// evaluation unless compiled evaluation is off; falls back to \ref evaluate
+  /// whenever the expression or its values are out of reach of the compiled
+  /// code
+  void evaluate_instruction_expr(const exprt &expr, mp_vectort &dest);
+
+  /// \return the code for \p expr, or nullptr if it cannot be compiled
+  const compiled_exprt *compile(const exprt &expr);
+  bool compile(const exprt &expr, compiled_exprt &dest, std::size_t &reg);
+
+  /// \return the value of \p compiled_expr, or nothing if the value or an
+  ///   intermediate one does not fit into 64 bits
+  optionalt<mp_integer> execute(const compiled_exprt &compiled_expr);
+
+  /// Whether to use compiled code for the expressions of instructions
+  bool compiled;
+
+  /// The compiled expressions of instructions, nullptr for those that cannot
+  /// be compiled
+  std::unordered_map<const exprt *, std::unique_ptr<compiled_exprt>>
+    compiled_exprs;
+  std::vector<std::int64_t> registers;
+
   bool count_type_leaves(
     const typet &source_type,
     mp_integer &result);
@@ -0,0 +1,411 @@
+/*******************************************************************\
+
+Module: Interpreter for GOTO Programs
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Compiled evaluation of the scalar expressions of instructions
+
+#include "interpreter_class.h"
+
+#include <util/c_types.h>
+#include <util/std_expr.h>
+
+#include <limits>
+
+/// \return whether the values of type \p type are single integers that
+///   the compiled code can compute with
+static bool is_compiled_type(const typet &type)
+{
+  if(type.id() == ID_signedbv || type.id() == ID_unsignedbv)
+    return to_bitvector_type(type).get_width() <= 64;
+  else
+    return type.id() == ID_bool || type.id() == ID_c_bool ||
+           type.id() == ID_pointer;
+}
+
+/// \return whether the values of type \p type are integers that the compiled
+///   code can do arithmetic with, which rules out pointers
+static bool is_arithmetic_type(const typet &type)
+{
+  return is_compiled_type(type) && type.id() != ID_pointer;
+}
+
+void interpretert::evaluate_instruction_expr(
+  const exprt &expr,
+  mp_vectort &dest)
+{
+  if(compiled)
+  {
+    const compiled_exprt *compiled_expr = compile(expr);
+    if(compiled_expr != nullptr)
+    {
+      const auto value = execute(*compiled_expr);
+      if(value.has_value())
+      {
+        dest.push_back(*value);
+        return;
+      }
+    }
+  }
+
+  evaluate(expr, dest);
+}
+
+const interpretert::compiled_exprt *interpretert::compile(const exprt &expr)
+{
+  // the expressions of instructions do not move, hence their addresses
+  // identify them
+  auto entry = compiled_exprs.emplace(&expr, nullptr);
+  if(!entry.second)
+    return entry.first->second.get();
+
+  std::unique_ptr<compiled_exprt> compiled_expr(new compiled_exprt());
+  if(!compile(expr, *compiled_expr, compiled_expr->result))
+    entry.first->second = std::move(compiled_expr);
+
+  return entry.first->second.get();
+}
+
+/// Append the code computing \p expr to \p dest
+/// \param expr: the expression to compile
+/// \param dest: the code to append to
+/// \param [out] reg: the register holding the value of \p expr
+/// \return true if \p expr cannot be compiled
+bool interpretert::compile(
+  const exprt &expr,
+  compiled_exprt &dest,
+  std::size_t &reg)
+{
+  typedef compiled_exprt::opcodet opcodet;
+
+  if(!is_compiled_type(expr.type()))
+    return true;
+
+  if(expr.id() == ID_constant)
+  {
+    optionalt<mp_integer> value;
+    if(expr.type().id() == ID_bool)
+      value = mp_integer(expr.is_true());
+    else if(expr.type().id() == ID_c_bool)
+    {
+      value = bvrep2integer(
+        to_constant_expr(expr).get_value(),
+        to_c_bool_type(expr.type()).get_width(),
+        false);
+    }
+    else if(expr.type().id() != ID_pointer)
+      value = numeric_cast<mp_integer>(expr);
+
+    if(!value.has_value() || !value->is_long())
+      return true;
+
+    reg = dest.add(opcodet::CONSTANT, 0, 0, value->to_long());
+    return false;
+  }
+  else if(expr.id() == ID_symbol)
+  {
+    reg = dest.add(opcodet::LOAD);
+    dest.code.back().symbol = &to_symbol_expr(expr);
+    return false;
+  }
+  else if(
+    (expr.id() == ID_plus || expr.id() == ID_mult) &&
+    is_arithmetic_type(expr.type()) && !expr.operands().empty())
+  {
+    const opcodet opcode =
+      expr.id() == ID_plus ? opcodet::PLUS : opcodet::MULT;
+
+    for(auto it = expr.operands().begin(); it != expr.operands().end(); ++it)
+    {
+      std::size_t op;
+      if(!is_arithmetic_type(it->type()) || compile(*it, dest, op))
+        return true;
+      reg = it == expr.operands().begin() ? op : dest.add(opcode, reg, op);
+    }
+    return false;
+  }
+  else if(
+    (expr.id() == ID_minus || expr.id() == ID_div || expr.id() == ID_equal ||
+     expr.id() == ID_notequal || expr.id() == ID_le || expr.id() == ID_ge ||
+     expr.id() == ID_lt || expr.id() == ID_gt) &&
+    expr.operands().size() == 2)
+  {
+    const exprt &op0 = to_binary_expr(expr).op0();
+    const exprt &op1 = to_binary_expr(expr).op1();
+
+    // only (in)equality is defined on pointers
+    const bool is_equality = expr.id() == ID_equal || expr.id() == ID_notequal;
+    if(
+      !is_equality && (!is_arithmetic_type(op0.type()) ||
+                       !is_arithmetic_type(op1.type())))
+    {
+      return true;
+    }
+
+    std::size_t reg0, reg1;
+    if(compile(op0, dest, reg0) || compile(op1, dest, reg1))
+      return true;
+
+    if(expr.id() == ID_minus || expr.id() == ID_div)
+    {
+      if(!is_arithmetic_type(expr.type()))
+        return true;
+      reg = dest.add(
+        expr.id() == ID_minus ? opcodet::MINUS : opcodet::DIV, reg0, reg1);
+    }
+    else if(expr.id() == ID_equal)
+      reg = dest.add(opcodet::EQUAL, reg0, reg1);
+    else if(expr.id() == ID_notequal)
+      reg = dest.add(opcodet::NOTEQUAL, reg0, reg1);
+    else if(expr.id() == ID_le)
+      reg = dest.add(opcodet::LE, reg0, reg1);
+    else if(expr.id() == ID_ge)
+      reg = dest.add(opcodet::LE, reg1, reg0);
+    else if(expr.id() == ID_lt)
+      reg = dest.add(opcodet::LT, reg0, reg1);
+    else
+      reg = dest.add(opcodet::LT, reg1, reg0);
+    return false;
+  }
+  else if(expr.id() == ID_unary_minus || expr.id() == ID_not)
+  {
+    const exprt &op = to_unary_expr(expr).op();
+    std::size_t op_reg;
+    if(!is_arithmetic_type(op.type()) || compile(op, dest, op_reg))
+      return true;
+
+    reg = dest.add(
+      expr.id() == ID_unary_minus ? opcodet::UNARY_MINUS : opcodet::NOT,
+      op_reg);
+    return false;
+  }
+  else if(
+    (expr.id() == ID_and || expr.id() == ID_or) && !expr.operands().empty())
+  {
+    // short-circuit evaluation, as the operands that are not evaluated are
+    // not read either
+    const opcodet jump = expr.id() == ID_and ? opcodet::JUMP_IF_ZERO
+                                             : opcodet::JUMP_IF_NOT_ZERO;
+    std::vector<std::size_t> exits;
+    for(const auto &op : expr.operands())
+    {
+      std::size_t op_reg;
+      if(compile(op, dest, op_reg))
+        return true;
+      exits.push_back(dest.code.size());
+      dest.add(jump, op_reg);
+    }
+
+    reg = dest.add(opcodet::CONSTANT, 0, 0, expr.id() == ID_and);
+    dest.add(opcodet::JUMP, 0, 0, dest.code.size() + 2);
+    for(const auto exit : exits)
+      dest.code[exit].value = dest.code.size();
+    dest.code.push_back(
+      {opcodet::CONSTANT, reg, 0, 0, expr.id() == ID_or, nullptr});
+    return false;
+  }
+  else if(expr.id() == ID_if)
+  {
+    const if_exprt &if_expr = to_if_expr(expr);
+    std::size_t cond, true_case, false_case;
+    if(compile(if_expr.cond(), dest, cond))
+      return true;
+    const std::size_t jump_to_false_case = dest.code.size();
+    dest.add(opcodet::JUMP_IF_ZERO, cond);
+    if(compile(if_expr.true_case(), dest, true_case))
+      return true;
+    reg = dest.add(opcodet::MOVE, true_case);
+    const std::size_t jump_to_end = dest.code.size();
+    dest.add(opcodet::JUMP);
+    dest.code[jump_to_false_case].value = dest.code.size();
+    if(compile(if_expr.false_case(), dest, false_case))
+      return true;
+    dest.code.push_back({opcodet::MOVE, reg, false_case, 0, 0, nullptr});
+    dest.code[jump_to_end].value = dest.code.size();
+    return false;
+  }
+  else if(expr.id() == ID_typecast)
+  {
+    const exprt &op = to_typecast_expr(expr).op();
+    std::size_t op_reg;
+    if(!is_compiled_type(op.type()) || compile(op, dest, op_reg))
+      return true;
+
+    if(expr.type().id() == ID_pointer)
+      reg = op_reg;
+    else if(expr.type().id() == ID_bool || expr.type().id() == ID_c_bool)
+      reg = dest.add(opcodet::BOOL_CAST, op_reg);
+    else
+    {
+      reg = dest.add(
+        expr.type().id() == ID_signedbv ? opcodet::SIGNED_CAST
+                                        : opcodet::UNSIGNED_CAST,
+        op_reg,
+        0,
+        to_bitvector_type(expr.type()).get_width());
+    }
+    return false;
+  }
+
+  return true;
+}
+
+optionalt<mp_integer>
+interpretert::execute(const compiled_exprt &compiled_expr)
+{
+  typedef compiled_exprt::opcodet opcodet;
+  typedef std::numeric_limits<std::int64_t> limitst;
+
+  registers.resize(compiled_expr.number_of_registers);
+  const auto &code = compiled_expr.code;
+
+  for(std::size_t pc = 0; pc < code.size(); ++pc)
+  {
+    const compiled_exprt::instructiont &instruction = code[pc];
+    std::int64_t &dest = registers[instruction.dest];
+    const std::int64_t op0 = registers[instruction.op0];
+    const std::int64_t op1 = registers[instruction.op1];
+
+    switch(instruction.opcode)
+    {
+    case opcodet::CONSTANT:
+      dest = instruction.value;
+      break;
+
+    case opcodet::LOAD:
+    {
+      const mp_integer address = evaluate_address(*instruction.symbol, true);
+      if(address.is_zero())
+        return {};
+      if(address < memory.size())
+      {
+        const memory_cellt &cell =
+          memory[numeric_cast_v<std::size_t>(address)];
+        if(!cell.value.is_long())
+          return {};
+        if(cell.initialized == memory_cellt::initializedt::UNKNOWN)
+          cell.initialized = memory_cellt::initializedt::READ_BEFORE_WRITTEN;
+        dest = cell.value.to_long();
+      }
+      else
+        dest = 0;
+      break;
+    }
+
+    case opcodet::MOVE:
+      dest = op0;
+      break;
+
+    case opcodet::PLUS:
+      if(
+        (op1 > 0 && op0 > limitst::max() - op1) ||
+        (op1 < 0 && op0 < limitst::min() - op1))
+      {
+        return {};
+      }
+      dest = op0 + op1;
+      break;
+
+    case opcodet::MINUS:
+      if(
+        (op1 < 0 && op0 > limitst::max() + op1) ||
+        (op1 > 0 && op0 < limitst::min() + op1))
+      {
+        return {};
+      }
+      dest = op0 - op1;
+      break;
+
+    case opcodet::MULT:
+      // products of 32-bit factors cannot overflow
+      if(
+        op0 < std::numeric_limits<std::int32_t>::min() ||
+        op0 > std::numeric_limits<std::int32_t>::max() ||
+        op1 < std::numeric_limits<std::int32_t>::min() ||
+        op1 > std::numeric_limits<std::int32_t>::max())
+      {
+        return {};
+      }
+      dest = op0 * op1;
+      break;
+
+    case opcodet::DIV:
+      if(op1 == 0 || (op0 == limitst::min() && op1 == -1))
+        return {};
+      dest = op0 / op1;
+      break;
+
+    case opcodet::UNARY_MINUS:
+      if(op0 == limitst::min())
+        return {};
+      dest = -op0;
+      break;
+
+    case opcodet::NOT:
+      dest = op0 == 0;
+      break;
+
+    case opcodet::EQUAL:
+      dest = op0 == op1;
+      break;
+
+    case opcodet::NOTEQUAL:
+      dest = op0 != op1;
+      break;
+
+    case opcodet::LE:
+      dest = op0 <= op1;
+      break;
+
+    case opcodet::LT:
+      dest = op0 < op1;
+      break;
+
+    case opcodet::SIGNED_CAST:
+    case opcodet::UNSIGNED_CAST:
+    {
+      const std::size_t width = static_cast<std::size_t>(instruction.value);
+      std::uint64_t bits = static_cast<std::uint64_t>(op0);
+      const std::uint64_t mask =
+        width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+      bits &= mask;
+      const bool negative = instruction.opcode == opcodet::SIGNED_CAST &&
+                            width != 0 && (bits >> (width - 1)) != 0;
+      if(negative)
+      {
+        // bits - 2^width, where 2^width - bits - 1 does fit into 63 bits
+        dest = -static_cast<std::int64_t>(~bits & mask) - 1;
+      }
+      else if(bits > static_cast<std::uint64_t>(limitst::max()))
+        return {};
+      else
+        dest = static_cast<std::int64_t>(bits);
+      break;
+    }
+
+    case opcodet::BOOL_CAST:
+      dest = op0 != 0;
+      break;
+
+    case opcodet::JUMP:
+      pc = static_cast<std::size_t>(instruction.value) - 1;
+      break;
+
+    case opcodet::JUMP_IF_ZERO:
+      if(op0 == 0)
+        pc = static_cast<std::size_t>(instruction.value) - 1;
+      break;
+
+    case opcodet::JUMP_IF_NOT_ZERO:
+      if(op0 != 0)
+        pc = static_cast<std::size_t>(instruction.value) - 1;
+      break;
+    }
+  }
+
+  return mp_integer(registers[compiled_expr.result]);
+}
@@ -72,7 +72,7 @@ bool is_osx_fat_header(char header_bytes[8])
 }
 
 osx_fat_readert::osx_fat_readert(
-  std::ifstream &in,
+  std::istream &in,
   message_handlert &message_handler)
   : log(message_handler), has_gb_arch(false)
 {
@@ -24,7 +24,7 @@ Author:
 class osx_fat_readert
 {
 public:
-  osx_fat_readert(std::ifstream &, message_handlert &);
+  osx_fat_readert(std::istream &, message_handlert &);
 
   bool has_gb() const { return has_gb_arch; }
 
@@ -27,7 +27,9 @@ Author: Martin Brain, martin.brain@cs.ox.ac.uk
 #include <goto-programs/string_instrumentation.h>
 
 #include <util/message.h>
+#include <util/namespace.h>
 #include <util/options.h>
+#include <util/phase_profile.h>
 
 bool process_goto_program(
   goto_modelt &goto_model,
@@ -40,10 +42,13 @@ bool process_goto_program(
   // remove function pointers
   log.status() << "Removal of function pointers and virtual functions"
                << messaget::eom;
-  remove_function_pointers(
-    log.get_message_handler(),
-    goto_model,
-    options.get_bool_option("pointer-check"));
+  {
+    phase_profile_scopet phase_profile_scope("remove function pointers");
+    remove_function_pointers(
+      log.get_message_handler(),
+      goto_model,
+      options.get_bool_option("pointer-check"));
+  }
 
   mm_io(goto_model);
 
@@ -54,26 +59,49 @@ bool process_goto_program(
   if(options.get_bool_option("partial-inline"))
   {
     log.status() << "Partial Inlining" << messaget::eom;
+    phase_profile_scopet phase_profile_scope("partial inlining");
     goto_partial_inline(goto_model, log.get_message_handler());
   }
 
   // remove returns, gcc vectors, complex
-  remove_returns(goto_model);
-  remove_vector(goto_model);
-  remove_complex(goto_model);
-  if(options.get_bool_option("rewrite-union"))
-    rewrite_union(goto_model);
+  {
+    phase_profile_scopet phase_profile_scope("remove returns");
+    remove_returns(goto_model);
+  }
+  {
+    phase_profile_scopet phase_profile_scope("remove vectors and complex");
+    remove_vector(goto_model);
+    remove_complex(goto_model);
+  }
+
+  // The following passes are local to each function, and are run on one
+  // function after the other rather than one pass after the other, for a
+  // single traversal of all the functions.
+  const namespacet ns(goto_model.symbol_table);
+  const bool rewrite_unions = options.get_bool_option("rewrite-union");
 
   // add generic checks
   log.status() << "Generic Property Instrumentation" << messaget::eom;
-  goto_check(options, goto_model);
-
-  // checks don't know about adjusted float expressions
-  adjust_float_expressions(goto_model);
+  {
+    phase_profile_scopet phase_profile_scope("property instrumentation");
+    goto_check(
+      ns,
+      options,
+      goto_model.goto_functions,
+      [rewrite_unions](goto_functionst::goto_functiont &goto_function) {
+        if(rewrite_unions)
+          rewrite_union(goto_function);
+      },
+      [&ns](goto_functionst::goto_functiont &goto_function) {
+        // checks don't know about adjusted float expressions
+        adjust_float_expressions(goto_function, ns);
+      });
+  }
 
   if(options.get_bool_option("string-abstraction"))
   {
     log.status() << "String Abstraction" << messaget::eom;
+    phase_profile_scopet phase_profile_scope("string abstraction");
     string_abstraction(goto_model, log.get_message_handler());
   }
 
@@ -0,0 +1,70 @@
+/*******************************************************************\
+
+Module: Functions and Symbols Reachable from the Entry Point
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Functions and Symbols Reachable from the Entry Point
+
+#include "reachability_index.h"
+
+#include <linking/static_lifetime_init.h>
+
+#include "goto_functions.h"
+
+#include <vector>
+
+reachability_indext::reachability_indext(
+  const goto_functionst &goto_functions,
+  const irep_idt &start)
+{
+  std::vector<irep_idt> worklist;
+
+  if(goto_functions.function_map.count(start) != 0)
+  {
+    functions.insert(start);
+    worklist.push_back(start);
+  }
+
+  while(!worklist.empty())
+  {
+    const irep_idt function = worklist.back();
+    worklist.pop_back();
+
+    find_symbols_sett referred;
+    for(const auto &instruction :
+        goto_functions.function_map.at(function).body.instructions)
+    {
+      instruction.apply([&referred](const exprt &expr) {
+        find_symbols(expr, referred, true, false);
+      });
+
+      // not visited by apply
+      if(instruction.is_function_call())
+      {
+        find_symbols(
+          instruction.get_function_call().function(), referred, true, false);
+      }
+    }
+
+    // both the functions called and those whose address is taken
+    for(const auto &symbol : referred)
+    {
+      if(
+        goto_functions.function_map.count(symbol) != 0 &&
+        functions.insert(symbol).second)
+      {
+        worklist.push_back(symbol);
+      }
+    }
+
+    // The initialization refers to all static objects, and thus to the
+    // functions whose addresses are stored in them, but an object is only
+    // used if some other function refers to it.
+    if(function != INITIALIZE_FUNCTION)
+      symbols.insert(referred.begin(), referred.end());
+  }
+}
@@ -0,0 +1,51 @@
+/*******************************************************************\
+
+Module: Functions and Symbols Reachable from the Entry Point
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Functions and Symbols Reachable from the Entry Point
+
+#ifndef CPROVER_GOTO_PROGRAMS_REACHABILITY_INDEX_H
+#define CPROVER_GOTO_PROGRAMS_REACHABILITY_INDEX_H
+
+#include <util/find_symbols.h>
+
+class goto_functionst;
+
+/// The functions reachable from a function, by calling them or by taking
+/// their address, and the symbols that these functions refer to. The index
+/// is computed in one pass over the reachable functions, and can be given to
+/// both \ref remove_unused_functions and \ref slice_global_inits when no
+/// calls are changed in between.
+class reachability_indext
+{
+public:
+  /// Compute the index of \p goto_functions starting from \p start
+  reachability_indext(
+    const goto_functionst &goto_functions,
+    const irep_idt &start);
+
+  /// The reachable functions that have an entry in the function map
+  find_symbols_sett functions;
+
+  /// The symbols, including functions, referred to by the reachable
+  /// functions other than the initialization of static objects, which
+  /// refers to all of them
+  find_symbols_sett symbols;
+
+  bool is_reachable(const irep_idt &function) const
+  {
+    return functions.find(function) != functions.end();
+  }
+
+  bool is_used(const irep_idt &symbol) const
+  {
+    return symbols.find(symbol) != symbols.end();
+  }
+};
+
+#endif // CPROVER_GOTO_PROGRAMS_REACHABILITY_INDEX_H
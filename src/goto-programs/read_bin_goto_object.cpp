@@ -13,21 +13,109 @@ Date: June 2006
 
 #include "read_bin_goto_object.h"
 
+#include <util/find_symbols.h>
 #include <util/message.h>
 #include <util/symbol_table.h>
 #include <util/irep_serialization.h>
 
+#include <unordered_map>
+#include <vector>
+
 #include "goto_functions.h"
 #include "write_goto_binary.h"
 
+/// read the instructions of a single goto function
+static void read_goto_function(
+  std::istream &in,
+  goto_functionst::goto_functiont &f,
+  irep_serializationt &irepconverter)
+{
+  typedef std::map<goto_programt::targett, std::list<unsigned> > target_mapt;
+  target_mapt target_map;
+  typedef std::map<unsigned, goto_programt::targett> rev_target_mapt;
+  rev_target_mapt rev_target_map;
+
+  bool hidden=false;
+
+  std::size_t ins_count = irepconverter.read_gb_word(in); // # of instructions
+  for(std::size_t ins_index = 0; ins_index < ins_count; ++ins_index)
+  {
+    goto_programt::targett itarget = f.body.add_instruction();
+    goto_programt::instructiont &instruction=*itarget;
+
+    instruction.code_nonconst() =
+      static_cast<const codet &>(irepconverter.reference_convert(in));
+    instruction.source_location = static_cast<const source_locationt &>(
+      irepconverter.reference_convert(in));
+    instruction.type = (goto_program_instruction_typet)
+                            irepconverter.read_gb_word(in);
+    instruction.guard =
+      static_cast<const exprt &>(irepconverter.reference_convert(in));
+    instruction.target_number = irepconverter.read_gb_word(in);
+    if(instruction.is_target() &&
+       rev_target_map.insert(
+         rev_target_map.end(),
+         std::make_pair(instruction.target_number, itarget))->second!=itarget)
+      UNREACHABLE;
+
+    std::size_t t_count = irepconverter.read_gb_word(in); // # of targets
+    for(std::size_t i=0; i<t_count; i++)
+      // just save the target numbers
+      target_map[itarget].push_back(irepconverter.read_gb_word(in));
+
+    std::size_t l_count = irepconverter.read_gb_word(in); // # of labels
+
+    for(std::size_t i=0; i<l_count; i++)
+    {
+      irep_idt label=irepconverter.read_string_ref(in);
+      instruction.labels.push_back(label);
+      if(label == CPROVER_PREFIX "HIDE")
+        hidden=true;
+      // The above info is also held in the goto_functiont object, and could
+      // be stored in the binary.
+    }
+  }
+
+  // Resolve targets
+  for(target_mapt::iterator tit = target_map.begin();
+      tit!=target_map.end();
+      tit++)
+  {
+    goto_programt::targett ins = tit->first;
+
+    for(std::list<unsigned>::iterator nit = tit->second.begin();
+        nit!=tit->second.end();
+        nit++)
+    {
+      unsigned n=*nit;
+      rev_target_mapt::const_iterator entry=rev_target_map.find(n);
+      INVARIANT(
+        entry != rev_target_map.end(),
+        "something from the target map should also be in the reverse target "
+        "map");
+      ins->targets.push_back(entry->second);
+    }
+  }
+
+  f.body.update();
+
+  if(hidden)
+    f.make_hidden();
+}
+
 /// read goto binary format
-/// \par parameters: input stream, symbol_table, functions
+/// \par parameters: input stream, symbol_table, functions, entry points
+///   restricting the function bodies to decode (all if empty), and if not
+///   nullptr, the fingerprints of the bodies to read instead of any body
 /// \return true on error, false otherwise
 static bool read_bin_goto_object(
   std::istream &in,
   symbol_tablet &symbol_table,
   goto_functionst &functions,
-  irep_serializationt &irepconverter)
+  irep_serializationt &irepconverter,
+  const std::unordered_set<irep_idt> &entry_points,
+  goto_program_fingerprintst *fingerprints,
+  messaget &message)
 {
   std::size_t count = irepconverter.read_gb_word(in); // # of symbols
 
@@ -79,84 +167,111 @@ static bool read_bin_goto_object(
     symbol_table.add(sym);
   }
 
+  // Since version 6, the function bodies are preceded by an index giving
+  // the size of each body, and none refers to the ireps of another. Since
+  // version 7, the index also gives the fingerprint of each body. Since
+  // version 8, the bodies share the ireps of the symbols.
   count=irepconverter.read_gb_word(in); // # of functions
 
+  std::vector<std::pair<irep_idt, std::size_t>> index;
+  index.reserve(count);
+
   for(std::size_t fct_index = 0; fct_index < count; ++fct_index)
   {
-    irep_idt fname=irepconverter.read_gb_string(in);
-    goto_functionst::goto_functiont &f = functions.function_map[fname];
+    irep_idt fname = irepconverter.read_gb_string(in);
+    std::size_t size = irepconverter.read_gb_word(in); // # bytes
+    const std::size_t fingerprint = irepconverter.read_gb_word(in);
+    index.emplace_back(fname, size);
+    if(fingerprints != nullptr)
+      fingerprints->emplace(fname, fingerprint);
+  }
 
-    typedef std::map<goto_programt::targett, std::list<unsigned> > target_mapt;
-    target_mapt target_map;
-    typedef std::map<unsigned, goto_programt::targett> rev_target_mapt;
-    rev_target_mapt rev_target_map;
+  if(fingerprints != nullptr)
+  {
+    // skip all bodies, leaving the stream at the end of the goto binary
+    std::streamoff size = 0;
+    for(const auto &entry : index)
+      size += static_cast<std::streamoff>(entry.second);
+    in.seekg(size, std::ios::cur);
+    return false;
+  }
 
-    bool hidden=false;
+  irepconverter.checkpoint();
 
-    std::size_t ins_count = irepconverter.read_gb_word(in); // # of instructions
-    for(std::size_t ins_index = 0; ins_index < ins_count; ++ins_index)
+  if(entry_points.empty())
+  {
+    for(const auto &entry : index)
     {
-      goto_programt::targett itarget = f.body.add_instruction();
-      goto_programt::instructiont &instruction=*itarget;
-
-      instruction.code_nonconst() =
-        static_cast<const codet &>(irepconverter.reference_convert(in));
-      instruction.source_location = static_cast<const source_locationt &>(
-        irepconverter.reference_convert(in));
-      instruction.type = (goto_program_instruction_typet)
-                              irepconverter.read_gb_word(in);
-      instruction.guard =
-        static_cast<const exprt &>(irepconverter.reference_convert(in));
-      instruction.target_number = irepconverter.read_gb_word(in);
-      if(instruction.is_target() &&
-         rev_target_map.insert(
-           rev_target_map.end(),
-           std::make_pair(instruction.target_number, itarget))->second!=itarget)
-        UNREACHABLE;
-
-      std::size_t t_count = irepconverter.read_gb_word(in); // # of targets
-      for(std::size_t i=0; i<t_count; i++)
-        // just save the target numbers
-        target_map[itarget].push_back(irepconverter.read_gb_word(in));
-
-      std::size_t l_count = irepconverter.read_gb_word(in); // # of labels
-
-      for(std::size_t i=0; i<l_count; i++)
+      read_goto_function(
+        in, functions.function_map[entry.first], irepconverter);
+      irepconverter.restore_checkpoint();
+    }
+  }
+  else
+  {
+    // Decode the bodies of the functions reachable from the entry points
+    // only, seeking to their sections as required.
+    std::unordered_map<irep_idt, std::streampos> sections;
+    std::streampos offset = in.tellg();
+    for(const auto &entry : index)
+    {
+      sections.emplace(entry.first, offset);
+      offset += static_cast<std::streamoff>(entry.second);
+    }
+
+    std::vector<irep_idt> worklist(entry_points.begin(), entry_points.end());
+
+    // functions may also be referenced from the initial values of objects
+    for(const auto &symbol_pair : symbol_table.symbols)
+    {
+      const symbolt &symbol = symbol_pair.second;
+      if(!symbol.is_type && symbol.type.id() != ID_code)
       {
-        irep_idt label=irepconverter.read_string_ref(in);
-        instruction.labels.push_back(label);
-        if(label == CPROVER_PREFIX "HIDE")
-          hidden=true;
-        // The above info is also held in the goto_functiont object, and could
-        // be stored in the binary.
+        for(const auto &identifier : find_symbol_identifiers(symbol.value))
+          worklist.push_back(identifier);
       }
     }
 
-    // Resolve targets
-    for(target_mapt::iterator tit = target_map.begin();
-        tit!=target_map.end();
-        tit++)
+    std::unordered_set<irep_idt> decoded;
+
+    while(!worklist.empty())
     {
-      goto_programt::targett ins = tit->first;
+      const irep_idt fname = worklist.back();
+      worklist.pop_back();
+
+      const auto section = sections.find(fname);
+      if(section == sections.end() || !decoded.insert(fname).second)
+        continue;
 
-      for(std::list<unsigned>::iterator nit = tit->second.begin();
-          nit!=tit->second.end();
-          nit++)
+      in.seekg(section->second);
+
+      goto_functionst::goto_functiont &f = functions.function_map[fname];
+      read_goto_function(in, f, irepconverter);
+      irepconverter.restore_checkpoint();
+
+      find_symbols_sett referenced;
+      for(const auto &instruction : f.body.instructions)
+      {
+        find_symbols(instruction.get_code(), referenced, true, false);
+        find_symbols(instruction.guard, referenced, true, false);
+      }
+
+      for(const auto &identifier : referenced)
       {
-        unsigned n=*nit;
-        rev_target_mapt::const_iterator entry=rev_target_map.find(n);
-        INVARIANT(
-          entry != rev_target_map.end(),
-          "something from the target map should also be in the reverse target "
-          "map");
-        ins->targets.push_back(entry->second);
+        if(sections.find(identifier) != sections.end())
+          worklist.push_back(identifier);
       }
     }
 
-    f.body.update();
+    if(decoded.size() != index.size())
+    {
+      message.statistics() << "Decoded " << decoded.size() << " of "
+                           << index.size() << " function bodies"
+                           << messaget::eom;
+    }
 
-    if(hidden)
-      f.make_hidden();
+    // leave the stream at the end of the goto binary
+    in.seekg(offset);
   }
 
   functions.compute_location_numbers();
@@ -164,6 +279,15 @@ static bool read_bin_goto_object(
   return false;
 }
 
+static bool read_bin_goto_object(
+  std::istream &in,
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  goto_functionst &functions,
+  message_handlert &message_handler,
+  const std::unordered_set<irep_idt> &entry_points,
+  goto_program_fingerprintst *fingerprints);
+
 /// reads a goto binary file back into a symbol and a function table
 /// \par parameters: input stream, symbol table, functions
 /// \return true on error, false otherwise
@@ -173,6 +297,66 @@ bool read_bin_goto_object(
   symbol_tablet &symbol_table,
   goto_functionst &functions,
   message_handlert &message_handler)
+{
+  return read_bin_goto_object(
+    in, filename, symbol_table, functions, message_handler, {});
+}
+
+/// reads a goto binary file back into a symbol and a function table, but
+/// decodes only the bodies of functions reachable from \p entry_points (or
+/// all function bodies if \p entry_points is empty); the other functions
+/// are left without body
+/// \par parameters: seekable input stream, symbol table, functions, entry
+///   points
+/// \return true on error, false otherwise
+bool read_bin_goto_object(
+  std::istream &in,
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  goto_functionst &functions,
+  message_handlert &message_handler,
+  const std::unordered_set<irep_idt> &entry_points)
+{
+  return read_bin_goto_object(
+    in,
+    filename,
+    symbol_table,
+    functions,
+    message_handler,
+    entry_points,
+    nullptr);
+}
+
+/// reads the symbols of a goto binary file and the fingerprints of its
+/// function bodies, as per \ref goto_program_fingerprint, into \p
+/// fingerprints; the bodies themselves are skipped without being decoded,
+/// which leaves all functions without body
+/// \par parameters: seekable input stream, symbol table, functions,
+///   message handler, fingerprints
+/// \return true on error, false otherwise
+bool read_bin_goto_object_fingerprints(
+  std::istream &in,
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  goto_functionst &functions,
+  message_handlert &message_handler,
+  goto_program_fingerprintst &fingerprints)
+{
+  return read_bin_goto_object(
+    in, filename, symbol_table, functions, message_handler, {}, &fingerprints);
+}
+
+/// reads a goto binary file, decoding the bodies of the functions reachable
+/// from \p entry_points only, or all of them if \p entry_points is empty,
+/// or instead collecting their fingerprints if \p fingerprints is not nullptr
+static bool read_bin_goto_object(
+  std::istream &in,
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  goto_functionst &functions,
+  message_handlert &message_handler,
+  const std::unordered_set<irep_idt> &entry_points,
+  goto_program_fingerprintst *fingerprints)
 {
   messaget message(message_handler);
 
@@ -229,7 +413,14 @@ bool read_bin_goto_object(
     }
     else if(version == GOTO_BINARY_VERSION)
     {
-      return read_bin_goto_object(in, symbol_table, functions, irepconverter);
+      return read_bin_goto_object(
+        in,
+        symbol_table,
+        functions,
+        irepconverter,
+        entry_points,
+        fingerprints,
+        message);
     }
     else
     {
@@ -16,11 +16,18 @@ Date: May 2007
 
 #include <iosfwd>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <util/irep.h>
 
 class symbol_tablet;
 class goto_functionst;
 class message_handlert;
 
+/// The fingerprints of the function bodies in a goto binary
+typedef std::unordered_map<irep_idt, std::size_t> goto_program_fingerprintst;
+
 bool read_bin_goto_object(
   std::istream &in,
   const std::string &filename,
@@ -28,4 +35,20 @@ bool read_bin_goto_object(
   goto_functionst &goto_functions,
   message_handlert &message_handler);
 
+bool read_bin_goto_object(
+  std::istream &in,
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  goto_functionst &goto_functions,
+  message_handlert &message_handler,
+  const std::unordered_set<irep_idt> &entry_points);
+
+bool read_bin_goto_object_fingerprints(
+  std::istream &in,
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  goto_functionst &goto_functions,
+  message_handlert &message_handler,
+  goto_program_fingerprintst &fingerprints);
+
 #endif // CPROVER_GOTO_PROGRAMS_READ_BIN_GOTO_OBJECT_H
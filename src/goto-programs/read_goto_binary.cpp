@@ -11,7 +11,12 @@ Author:
 
 #include "read_goto_binary.h"
 
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 #include <util/config.h>
 #include <util/message.h>
@@ -31,7 +36,16 @@ static bool read_goto_binary(
   const std::string &filename,
   symbol_tablet &,
   goto_functionst &,
-  message_handlert &);
+  message_handlert &,
+  const std::unordered_set<irep_idt> &entry_points);
+
+static bool read_goto_binary(
+  std::istream &,
+  const std::string &filename,
+  symbol_tablet &,
+  goto_functionst &,
+  message_handlert &,
+  const std::unordered_set<irep_idt> &entry_points);
 
 /// \brief Read a goto binary from a file, but do not update \ref config
 /// \param filename: the file name of the goto binary
@@ -39,11 +53,30 @@ static bool read_goto_binary(
 /// \return goto model on success, {} on failure
 optionalt<goto_modelt>
 read_goto_binary(const std::string &filename, message_handlert &message_handler)
+{
+  return read_goto_binary(filename, message_handler, {});
+}
+
+/// \brief Read a goto binary from a file, but do not update \ref config;
+///   only the bodies of functions reachable from \p entry_points are decoded
+/// \param filename: the file name of the goto binary
+/// \param message_handler: for diagnostics
+/// \param entry_points: functions whose bodies and those of all functions
+///   they refer to are to be read; all bodies are read if empty
+/// \return goto model on success, {} on failure
+optionalt<goto_modelt> read_goto_binary(
+  const std::string &filename,
+  message_handlert &message_handler,
+  const std::unordered_set<irep_idt> &entry_points)
 {
   goto_modelt dest;
 
   if(read_goto_binary(
-       filename, dest.symbol_table, dest.goto_functions, message_handler))
+       filename,
+       dest.symbol_table,
+       dest.goto_functions,
+       message_handler,
+       entry_points))
   {
     return {};
   }
@@ -56,12 +89,15 @@ read_goto_binary(const std::string &filename, message_handlert &message_handler)
 /// \param symbol_table: the symbol table from the goto binary
 /// \param goto_functions: the goto functions from the goto binary
 /// \param message_handler: for diagnostics
+/// \param entry_points: restrict the function bodies read to those reachable
+///   from these functions, unless empty
 /// \return true on failure, false on success
 static bool read_goto_binary(
   const std::string &filename,
   symbol_tablet &symbol_table,
   goto_functionst &goto_functions,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  const std::unordered_set<irep_idt> &entry_points)
 {
   #ifdef _MSC_VER
   std::ifstream in(widen(filename), std::ios::binary);
@@ -69,14 +105,36 @@ static bool read_goto_binary(
   std::ifstream in(filename, std::ios::binary);
   #endif
 
-  messaget message(message_handler);
-
   if(!in)
   {
+    messaget message(message_handler);
     message.error() << "Failed to open '" << filename << "'" << messaget::eom;
     return true;
   }
 
+  return read_goto_binary(
+    in, filename, symbol_table, goto_functions, message_handler, entry_points);
+}
+
+/// \brief Read a goto binary from a stream, but do not update \ref config
+/// \param in: seekable stream holding the contents of \p filename
+/// \param filename: the file name of the goto binary
+/// \param symbol_table: the symbol table from the goto binary
+/// \param goto_functions: the goto functions from the goto binary
+/// \param message_handler: for diagnostics
+/// \param entry_points: restrict the function bodies read to those reachable
+///   from these functions, unless empty
+/// \return true on failure, false on success
+static bool read_goto_binary(
+  std::istream &in,
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  goto_functionst &goto_functions,
+  message_handlert &message_handler,
+  const std::unordered_set<irep_idt> &entry_points)
+{
+  messaget message(message_handler);
+
   char hdr[8];
   in.read(hdr, 8);
   if(!in)
@@ -91,7 +149,12 @@ static bool read_goto_binary(
   if(hdr[0]==0x7f && hdr[1]=='G' && hdr[2]=='B' && hdr[3]=='F')
   {
     return read_bin_goto_object(
-      in, filename, symbol_table, goto_functions, message_handler);
+      in,
+      filename,
+      symbol_table,
+      goto_functions,
+      message_handler,
+      entry_points);
   }
   else if(hdr[0]==0x7f && hdr[1]=='E' && hdr[2]=='L' && hdr[3]=='F')
   {
@@ -106,7 +169,12 @@ static bool read_goto_binary(
         {
           in.seekg(elf_reader.section_offset(i));
           return read_bin_goto_object(
-            in, filename, symbol_table, goto_functions, message_handler);
+            in,
+            filename,
+            symbol_table,
+            goto_functions,
+            message_handler,
+            entry_points);
         }
 
       // section not found
@@ -141,7 +209,12 @@ static bool read_goto_binary(
         message.error() << "failed to read temp binary" << messaget::eom;
 
       const bool read_err = read_bin_goto_object(
-        temp_in, filename, symbol_table, goto_functions, message_handler);
+        temp_in,
+        filename,
+        symbol_table,
+        goto_functions,
+        message_handler,
+        entry_points);
       temp_in.close();
 
       return read_err;
@@ -166,7 +239,12 @@ static bool read_goto_binary(
       {
         in.seekg(entry->second.offset);
         return read_bin_goto_object(
-          in, filename, symbol_table, goto_functions, message_handler);
+          in,
+          filename,
+          symbol_table,
+          goto_functions,
+          message_handler,
+          entry_points);
       }
 
       // section not found
@@ -270,17 +348,20 @@ bool is_goto_binary(
 /// \param file_name: file name of the goto binary
 /// \param dest: the goto model returned
 /// \param message_handler: for diagnostics
+/// \param entry_points: restrict the function bodies read to those reachable
+///   from these functions, unless empty
 /// \return true on error, false otherwise
 bool read_object_and_link(
   const std::string &file_name,
   goto_modelt &dest,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  const std::unordered_set<irep_idt> &entry_points)
 {
   messaget(message_handler).statistics() << "Reading: "
                                          << file_name << messaget::eom;
 
   // we read into a temporary model
-  auto temp_model = read_goto_binary(file_name, message_handler);
+  auto temp_model = read_goto_binary(file_name, message_handler, entry_points);
   if(!temp_model.has_value())
     return true;
 
@@ -299,6 +380,156 @@ bool read_object_and_link(
   return false;
 }
 
+/// \brief reads object files, and links them in the given order; the files
+///   are read from disc by a pool of threads, while decoding and linking is
+///   done by the calling thread, as \ref irept reference counting is not
+///   thread-safe
+/// \param file_names: file names of the goto binaries
+/// \param dest: the goto model returned
+/// \param message_handler: for diagnostics
+/// \param number_of_threads: the number of threads reading files; 0 selects
+///   the number of hardware threads
+/// \return true on error, false otherwise
+bool read_objects_and_link(
+  const std::list<std::string> &file_names,
+  goto_modelt &dest,
+  message_handlert &message_handler,
+  std::size_t number_of_threads)
+{
+  if(number_of_threads == 0)
+    number_of_threads = std::thread::hardware_concurrency();
+
+  if(number_of_threads <= 1 || file_names.size() <= 1)
+  {
+    for(const auto &file_name : file_names)
+    {
+      if(read_object_and_link(file_name, dest, message_handler))
+        return true;
+    }
+
+    return false;
+  }
+
+  struct filet
+  {
+    std::string name;
+    std::string contents;
+    bool failed = false;
+    bool done = false;
+  };
+
+  std::vector<filet> files(file_names.size());
+  {
+    std::size_t i = 0;
+    for(const auto &file_name : file_names)
+      files[i++].name = file_name;
+  }
+
+  // Bound the number of files held in memory at any time.
+  const std::size_t window = 4 * number_of_threads;
+
+  std::mutex mutex;
+  std::condition_variable file_done, file_consumed;
+  std::size_t next_to_read = 0;
+  std::size_t next_to_link = 0;
+  bool aborted = false;
+
+  auto reader = [&]() {
+    while(true)
+    {
+      std::size_t i;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        file_consumed.wait(lock, [&]() {
+          return aborted || next_to_read >= files.size() ||
+                 next_to_read < next_to_link + window;
+        });
+        if(aborted || next_to_read >= files.size())
+          return;
+        i = next_to_read++;
+      }
+
+      #ifdef _MSC_VER
+      std::ifstream in(widen(files[i].name), std::ios::binary);
+      #else
+      std::ifstream in(files[i].name, std::ios::binary);
+      #endif
+
+      std::ostringstream contents;
+      bool failed = !in || !(contents << in.rdbuf());
+
+      std::lock_guard<std::mutex> lock(mutex);
+      files[i].contents = contents.str();
+      files[i].failed = failed;
+      files[i].done = true;
+      file_done.notify_all();
+    }
+  };
+
+  std::vector<std::thread> readers;
+  for(std::size_t t = 0; t < number_of_threads; ++t)
+    readers.emplace_back(reader);
+
+  bool error = false;
+
+  for(auto &file : files)
+  {
+    std::istringstream in;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      file_done.wait(lock, [&]() { return file.done; });
+      in.str(std::move(file.contents));
+    }
+
+    messaget(message_handler).statistics() << "Reading: " << file.name
+                                           << messaget::eom;
+
+    goto_modelt temp_model;
+
+    if(file.failed)
+    {
+      messaget(message_handler).error()
+        << "Failed to open '" << file.name << "'" << messaget::eom;
+      error = true;
+    }
+    else if(read_goto_binary(
+              in,
+              file.name,
+              temp_model.symbol_table,
+              temp_model.goto_functions,
+              message_handler,
+              {}))
+    {
+      error = true;
+    }
+    else
+    {
+      try
+      {
+        link_goto_model(dest, temp_model, message_handler);
+        config.set_from_symbol_table(dest.symbol_table);
+      }
+      catch(...)
+      {
+        error = true;
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ++next_to_link;
+    aborted = error;
+    file_consumed.notify_all();
+
+    if(error)
+      break;
+  }
+
+  for(auto &thread : readers)
+    thread.join();
+
+  return error;
+}
+
 /// \brief reads an object file, and also updates the config
 /// \param file_name: file name of the goto binary
 /// \param dest_symbol_table: symbol table to update
@@ -12,8 +12,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_PROGRAMS_READ_GOTO_BINARY_H
 #define CPROVER_GOTO_PROGRAMS_READ_GOTO_BINARY_H
 
+#include <list>
 #include <string>
+#include <unordered_set>
 
+#include <util/irep.h>
 #include <util/optional.h>
 
 class goto_functionst;
@@ -24,6 +27,11 @@ class symbol_tablet;
 optionalt<goto_modelt>
 read_goto_binary(const std::string &filename, message_handlert &);
 
+optionalt<goto_modelt> read_goto_binary(
+  const std::string &filename,
+  message_handlert &,
+  const std::unordered_set<irep_idt> &entry_points);
+
 bool is_goto_binary(const std::string &filename, message_handlert &);
 
 bool read_object_and_link(
@@ -35,6 +43,13 @@ bool read_object_and_link(
 bool read_object_and_link(
   const std::string &file_name,
   goto_modelt &,
-  message_handlert &);
+  message_handlert &,
+  const std::unordered_set<irep_idt> &entry_points = {});
+
+bool read_objects_and_link(
+  const std::list<std::string> &file_names,
+  goto_modelt &,
+  message_handlert &,
+  std::size_t number_of_threads = 0);
 
 #endif // CPROVER_GOTO_PROGRAMS_READ_GOTO_BINARY_H
@@ -27,6 +27,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "remove_const_function_pointers.h"
 #include "remove_skip.h"
 
+#include <algorithm>
+
 class remove_function_pointerst
 {
 public:
@@ -89,6 +91,26 @@ protected:
   typedef std::map<irep_idt, code_typet> type_mapt;
   type_mapt type_map;
 
+  /// The functions whose address is taken, by number of parameters, except
+  /// for those with an ellipsis only, which may be called with any number
+  /// of arguments
+  std::map<std::size_t, std::vector<type_mapt::const_iterator>>
+    address_taken_by_arity;
+  std::vector<type_mapt::const_iterator> address_taken_variadic;
+
+  /// The type-compatible functions for the call types and uses of the return
+  /// value seen so far, as many calls share these
+  std::map<std::pair<bool, code_typet>, functionst> compatible_functions;
+
+  /// \return the functions whose address is taken that may be called with
+  ///   \p call_type
+  const functionst &
+  get_compatible_functions(bool return_value_used, const code_typet &call_type);
+
+  /// Whether the goto program whose function pointers are being removed has
+  /// a const-removing cast, and the location of the first one
+  std::pair<bool, source_locationt> removes_const;
+
   bool is_type_compatible(
     bool return_value_used,
     const code_typet &call_type,
@@ -128,6 +150,72 @@ remove_function_pointerst::remove_function_pointerst(
     type_map.emplace(
       gf_entry.first, to_code_type(ns.lookup(gf_entry.first).type));
   }
+
+  for(auto it = type_map.cbegin(); it != type_map.cend(); ++it)
+  {
+    if(
+      address_taken.find(it->first) == address_taken.end() ||
+      it->first == "pthread_mutex_cleanup")
+    {
+      continue;
+    }
+
+    if(it->second.has_ellipsis() && it->second.parameters().empty())
+      address_taken_variadic.push_back(it);
+    else
+      address_taken_by_arity[it->second.parameters().size()].push_back(it);
+  }
+}
+
+const remove_function_pointerst::functionst &
+remove_function_pointerst::get_compatible_functions(
+  bool return_value_used,
+  const code_typet &call_type)
+{
+  const auto entry = compatible_functions.emplace(
+    std::make_pair(return_value_used, call_type), functionst());
+  functionst &functions = entry.first->second;
+  if(!entry.second)
+    return functions;
+
+  std::vector<type_mapt::const_iterator> compatible;
+  auto add_compatible =
+    [&](const std::vector<type_mapt::const_iterator> &candidates) {
+      for(const auto &t : candidates)
+      {
+        if(is_type_compatible(return_value_used, call_type, t->second))
+          compatible.push_back(t);
+      }
+    };
+
+  // A call with an ellipsis only may go to a function with any number of
+  // parameters, all others need the same number of arguments and parameters.
+  add_compatible(address_taken_variadic);
+  if(call_type.has_ellipsis() && call_type.parameters().empty())
+  {
+    for(const auto &arity_entry : address_taken_by_arity)
+      add_compatible(arity_entry.second);
+  }
+  else
+  {
+    const auto arity_entry =
+      address_taken_by_arity.find(call_type.parameters().size());
+    if(arity_entry != address_taken_by_arity.end())
+      add_compatible(arity_entry->second);
+  }
+
+  // insert in the order of the type map, which determines the order of the
+  // cases of the calls
+  std::sort(
+    compatible.begin(),
+    compatible.end(),
+    [](type_mapt::const_iterator a, type_mapt::const_iterator b) {
+      return a->first < b->first;
+    });
+  for(const auto &t : compatible)
+    functions.insert(symbol_exprt(t->first, t->second));
+
+  return functions;
 }
 
 bool remove_function_pointerst::arg_is_type_compatible(
@@ -292,11 +380,9 @@ void remove_function_pointerst::remove_function_pointer(
 
   const exprt &pointer = function.pointer();
   remove_const_function_pointerst::functionst functions;
-  does_remove_constt const_removal_check(goto_program, ns);
-  const auto does_remove_const = const_removal_check();
-  if(does_remove_const.first)
+  if(removes_const.first)
   {
-    log.warning().source_location = does_remove_const.second;
+    log.warning().source_location = removes_const.second;
     log.warning() << "cast from const to non-const pointer found, "
                   << "only worst case function pointer removal will be done."
                   << messaget::eom;
@@ -341,22 +427,7 @@ void remove_function_pointerst::remove_function_pointer(
 
     // get all type-compatible functions
     // whose address is ever taken
-    for(const auto &t : type_map)
-    {
-      // address taken?
-      if(address_taken.find(t.first)==address_taken.end())
-        continue;
-
-      // type-compatible?
-      if(!is_type_compatible(return_value_used, call_type, t.second))
-        continue;
-
-      if(t.first=="pthread_mutex_cleanup")
-        continue;
-
-      symbol_exprt expr(t.first, t.second);
-      functions.insert(expr);
-    }
+    functions = get_compatible_functions(return_value_used, call_type);
   }
 
   remove_function_pointer(goto_program, function_id, target, functions);
@@ -442,6 +513,10 @@ void remove_function_pointerst::remove_function_pointer(
       source_location.set_comment(comment);
   }
 
+  // the new code may add const-removing casts when fixing the return type
+  if(!removes_const.first)
+    removes_const = does_remove_constt(new_code, ns)();
+
   goto_programt::targett next_target=target;
   next_target++;
 
@@ -491,6 +566,10 @@ bool remove_function_pointerst::remove_function_pointers(
 
       if(code.function().id()==ID_dereference)
       {
+        // checked once, and then updated as code is added
+        if(!did_something)
+          removes_const = does_remove_constt(goto_program, ns)();
+
         remove_function_pointer(goto_program, function_id, target);
         did_something=true;
       }
@@ -504,8 +583,6 @@ bool remove_function_pointerst::remove_function_pointers(
 
 void remove_function_pointerst::operator()(goto_functionst &functions)
 {
-  bool did_something=false;
-
   for(goto_functionst::function_mapt::iterator f_it=
       functions.function_map.begin();
       f_it!=functions.function_map.end();
@@ -513,12 +590,10 @@ void remove_function_pointerst::operator()(goto_functionst &functions)
   {
     goto_programt &goto_program=f_it->second.body;
 
+    // renumber just the functions that changed
     if(remove_function_pointers(goto_program, f_it->first))
-      did_something=true;
+      functions.compute_location_numbers(goto_program);
   }
-
-  if(did_something)
-    functions.compute_location_numbers();
 }
 
 bool remove_function_pointers(
@@ -14,6 +14,7 @@ Author: CM Wintersteiger
 #include <util/message.h>
 
 #include "goto_model.h"
+#include "reachability_index.h"
 
 void remove_unused_functions(
   goto_modelt &goto_model,
@@ -26,17 +27,25 @@ void remove_unused_functions(
   goto_functionst &functions,
   message_handlert &message_handler)
 {
-  std::set<irep_idt> used_functions;
+  remove_unused_functions(
+    functions,
+    reachability_indext(functions, goto_functionst::entry_point()),
+    message_handler);
+}
+
+void remove_unused_functions(
+  goto_functionst &functions,
+  const reachability_indext &reachability_index,
+  message_handlert &message_handler)
+{
   std::list<goto_functionst::function_mapt::iterator> unused_functions;
-  find_used_functions(
-    goto_functionst::entry_point(), functions, used_functions);
 
   for(goto_functionst::function_mapt::iterator it=
         functions.function_map.begin();
       it!=functions.function_map.end();
       it++)
   {
-    if(used_functions.find(it->first)==used_functions.end())
+    if(!reachability_index.is_reachable(it->first))
       unused_functions.push_back(it);
   }
 
@@ -47,7 +56,7 @@ void remove_unused_functions(
     message.statistics()
       << "Dropping " << unused_functions.size() << " of " <<
       functions.function_map.size() << " functions (" <<
-      used_functions.size() << " used)" << messaget::eom;
+      reachability_index.functions.size() << " used)" << messaget::eom;
   }
 
   for(const auto &f : unused_functions)
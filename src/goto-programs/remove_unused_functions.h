@@ -19,6 +19,7 @@ Author: CM Wintersteiger
 class goto_functionst;
 class goto_modelt;
 class message_handlert;
+class reachability_indext;
 
 void remove_unused_functions(
   goto_functionst &,
@@ -28,6 +29,14 @@ void remove_unused_functions(
   goto_modelt &,
   message_handlert &);
 
+/// Remove the functions that are not reachable according to
+/// \p reachability_index, which must have been computed from the entry
+/// point of \p functions, and stays valid for the remaining functions
+void remove_unused_functions(
+  goto_functionst &functions,
+  const reachability_indext &reachability_index,
+  message_handlert &);
+
 void find_used_functions(
   const irep_idt &current,
   goto_functionst &functions,
@@ -701,8 +701,6 @@ bool remove_virtual_functionst::remove_virtual_functions(
 /// list and replace them with their most derived implementations
 void remove_virtual_functionst::operator()(goto_functionst &functions)
 {
-  bool did_something=false;
-
   for(goto_functionst::function_mapt::iterator f_it=
       functions.function_map.begin();
       f_it!=functions.function_map.end();
@@ -711,12 +709,10 @@ void remove_virtual_functionst::operator()(goto_functionst &functions)
     const irep_idt &function_id = f_it->first;
     goto_programt &goto_program=f_it->second.body;
 
+    // renumber just the functions that changed
     if(remove_virtual_functions(function_id, goto_program))
-      did_something=true;
+      functions.compute_location_numbers(goto_program);
   }
-
-  if(did_something)
-    functions.compute_location_numbers();
 }
 
 /// Remove virtual function calls from all functions in the specified
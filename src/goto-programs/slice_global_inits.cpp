@@ -13,8 +13,6 @@ Date:   December 2016
 
 #include "slice_global_inits.h"
 
-#include <analyses/call_graph.h>
-
 #include <util/find_symbols.h>
 #include <util/std_expr.h>
 #include <util/cprover_prefix.h>
@@ -24,50 +22,35 @@ Date:   December 2016
 
 #include <goto-programs/goto_functions.h>
 #include <goto-programs/goto_model.h>
+#include <goto-programs/reachability_index.h>
 #include <goto-programs/remove_skip.h>
 
 #include <linking/static_lifetime_init.h>
 
 void slice_global_inits(goto_modelt &goto_model)
 {
-  // gather all functions reachable from the entry point
   const irep_idt entry_point=goto_functionst::entry_point();
-  goto_functionst &goto_functions=goto_model.goto_functions;
 
-  if(goto_functions.function_map.count(entry_point) == 0)
+  if(goto_model.goto_functions.function_map.count(entry_point) == 0)
     throw user_input_error_exceptiont("entry point not found");
 
-  // Get the call graph restricted to functions reachable from
-  // the entry point:
-  call_grapht call_graph =
-    call_grapht::create_from_root_function(goto_model, entry_point, false);
-  const auto directed_graph = call_graph.get_directed_graph();
-  INVARIANT(
-    !directed_graph.empty(),
-    "at least " + id2string(entry_point) + " should be reachable");
-
-  // gather all symbols used by reachable functions
-
-  find_symbols_sett symbols_to_keep;
+  slice_global_inits(
+    goto_model, reachability_indext(goto_model.goto_functions, entry_point));
+}
 
-  for(std::size_t node_idx = 0; node_idx < directed_graph.size(); ++node_idx)
-  {
-    const irep_idt &id = directed_graph[node_idx].function;
-    if(id == INITIALIZE_FUNCTION)
-      continue;
+void slice_global_inits(
+  goto_modelt &goto_model,
+  const reachability_indext &reachability_index)
+{
+  goto_functionst &goto_functions=goto_model.goto_functions;
 
-    // assume function has no body if it is not in the function map
-    const auto &it = goto_functions.function_map.find(id);
-    if(it == goto_functions.function_map.end())
-      continue;
+  INVARIANT(
+    reachability_index.is_reachable(goto_functionst::entry_point()),
+    "the reachability index starts from the entry point");
 
-    for(const auto &i : it->second.body.instructions)
-    {
-      i.apply([&symbols_to_keep](const exprt &expr) {
-        find_symbols(expr, symbols_to_keep, true, false);
-      });
-    }
-  }
+  // the symbols used by reachable functions, to which the symbols used to
+  // initialize them are added below
+  find_symbols_sett symbols_to_keep = reachability_index.symbols;
 
   goto_functionst::function_mapt::iterator f_it;
   f_it=goto_functions.function_map.find(INITIALIZE_FUNCTION);
@@ -17,6 +17,7 @@ Date:   December 2016
 #include <util/exception_utils.h>
 
 class goto_modelt;
+class reachability_indext;
 
 class user_input_error_exceptiont : public cprover_exception_baset
 {
@@ -37,4 +38,11 @@ private:
 
 void slice_global_inits(goto_modelt &);
 
+/// Remove the initializations of the global variables that the functions
+/// reachable according to \p reachability_index, which must have been
+/// computed from the entry point of \p goto_model, do not use
+void slice_global_inits(
+  goto_modelt &goto_model,
+  const reachability_indext &reachability_index);
+
 #endif
@@ -0,0 +1,104 @@
+/*******************************************************************\
+
+Module: Cache of Symbol Tables in Goto Binaries
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Cache of Symbol Tables in Goto Binaries
+
+#include "symbol_table_cache.h"
+
+#include <util/file_util.h>
+#include <util/message.h>
+#include <util/symbol_table.h>
+#include <util/version.h>
+
+#include "goto_functions.h"
+#include "read_bin_goto_object.h"
+#include "write_goto_binary.h"
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <random>
+
+/// \return \p key together with the versions the cached symbols depend on
+static std::string versioned_key(const std::string &key)
+{
+  return std::string(CBMC_VERSION) + ' ' + std::to_string(GOTO_BINARY_VERSION) +
+         '\n' + key;
+}
+
+std::string symbol_table_cache_file(
+  const std::string &directory,
+  const std::string &prefix,
+  const std::string &key)
+{
+  const std::size_t hash = std::hash<std::string>{}(versioned_key(key));
+  return concat_dir_file(directory, prefix + "-" + std::to_string(hash) + ".gb");
+}
+
+bool read_symbol_table_cache(
+  const std::string &file_name,
+  const std::string &key,
+  symbol_tablet &symbol_table)
+{
+  std::ifstream in(file_name, std::ios::binary);
+  if(!in)
+    return true;
+
+  const std::string full_key = versioned_key(key);
+
+  std::size_t key_size;
+  if(!(in >> key_size) || in.get() != '\n' || key_size != full_key.size())
+    return true;
+
+  std::string cached_key(key_size, '\0');
+  if(!in.read(&cached_key[0], key_size) || cached_key != full_key)
+    return true;
+
+  null_message_handlert null_message_handler;
+  goto_functionst goto_functions;
+  if(read_bin_goto_object(
+       in, file_name, symbol_table, goto_functions, null_message_handler))
+  {
+    symbol_table.clear();
+    return true;
+  }
+
+  return false;
+}
+
+void write_symbol_table_cache(
+  const std::string &file_name,
+  const std::string &key,
+  const symbol_tablet &symbol_table,
+  message_handlert &message_handler)
+{
+  std::random_device random;
+  const std::string tmp_file_name =
+    file_name + "." + std::to_string(random()) + ".tmp";
+
+  const std::string full_key = versioned_key(key);
+
+  {
+    std::ofstream out(tmp_file_name, std::ios::binary);
+    out << full_key.size() << '\n' << full_key;
+    if(!out || write_goto_binary(out, symbol_table, goto_functionst{}))
+    {
+      out.close();
+      std::remove(tmp_file_name.c_str());
+      return;
+    }
+  }
+
+  if(std::rename(tmp_file_name.c_str(), file_name.c_str()) != 0)
+  {
+    std::remove(tmp_file_name.c_str());
+    messaget log(message_handler);
+    log.debug() << "failed to write cache file " << file_name << messaget::eom;
+  }
+}
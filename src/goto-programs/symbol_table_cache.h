@@ -0,0 +1,45 @@
+/*******************************************************************\
+
+Module: Cache of Symbol Tables in Goto Binaries
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Cache of Symbol Tables in Goto Binaries
+
+#ifndef CPROVER_GOTO_PROGRAMS_SYMBOL_TABLE_CACHE_H
+#define CPROVER_GOTO_PROGRAMS_SYMBOL_TABLE_CACHE_H
+
+#include <string>
+
+class message_handlert;
+class symbol_tablet;
+
+/// \return the name of the file in \p directory that caches the symbols for
+///   \p key, starting with \p prefix
+std::string symbol_table_cache_file(
+  const std::string &directory,
+  const std::string &prefix,
+  const std::string &key);
+
+/// Read the symbols from the cache file \p file_name, if it was written for
+/// \p key by this version of CBMC
+/// \return true if there is no such file or it is for a different key
+bool read_symbol_table_cache(
+  const std::string &file_name,
+  const std::string &key,
+  symbol_tablet &symbol_table);
+
+/// Write \p symbol_table to the cache file \p file_name, along with \p key
+/// in full so that hash collisions and stale files are detected. The file is
+/// written to a temporary file in the same directory that is then renamed,
+/// so that concurrent readers never see a partial file.
+void write_symbol_table_cache(
+  const std::string &file_name,
+  const std::string &key,
+  const symbol_tablet &symbol_table,
+  message_handlert &message_handler);
+
+#endif // CPROVER_GOTO_PROGRAMS_SYMBOL_TABLE_CACHE_H
@@ -12,6 +12,8 @@ Author: CM Wintersteiger
 #include "write_goto_binary.h"
 
 #include <fstream>
+#include <sstream>
+#include <vector>
 
 #include <util/exception_utils.h>
 #include <util/irep_serialization.h>
@@ -19,6 +21,38 @@ Author: CM Wintersteiger
 #include <util/symbol_table.h>
 
 #include <goto-programs/goto_model.h>
+#include <goto-programs/goto_program_fingerprint.h>
+
+/// Writes the instructions of a single goto function
+static void write_goto_function(
+  std::ostream &out,
+  const goto_functionst::goto_functiont &function,
+  irep_serializationt &irepconverter)
+{
+  // Since version 2, goto functions are not converted to ireps,
+  // instead they are saved in a custom binary format
+
+  write_gb_word(out, function.body.instructions.size()); // # instructions
+
+  for(const auto &instruction : function.body.instructions)
+  {
+    irepconverter.reference_convert(instruction.get_code(), out);
+    irepconverter.reference_convert(instruction.source_location, out);
+    write_gb_word(out, (long)instruction.type);
+    irepconverter.reference_convert(instruction.guard, out);
+    write_gb_word(out, instruction.target_number);
+
+    write_gb_word(out, instruction.targets.size());
+
+    for(const auto &t_it : instruction.targets)
+      write_gb_word(out, t_it->target_number);
+
+    write_gb_word(out, instruction.labels.size());
+
+    for(const auto &l_it : instruction.labels)
+      irepconverter.write_string_ref(out, l_it);
+  }
+}
 
 /// Writes a goto program to disc, using goto binary format
 bool write_goto_binary(
@@ -72,48 +106,43 @@ bool write_goto_binary(
     write_gb_word(out, flags);
   }
 
-  // now write functions, but only those with body
+  // Now write functions, but only those with body. Since version 6, the
+  // bodies are preceded by an index of their sizes, and none refers to the
+  // ireps of another, which permits readers to decode individual functions
+  // on demand. Since version 7, the index also gives the fingerprint of each
+  // body, which permits comparing functions without decoding them. Since
+  // version 8, the bodies share the ireps of the symbols.
 
-  unsigned cnt=0;
-  for(const auto &gf_entry : goto_functions.function_map)
-  {
-    if(gf_entry.second.body_available())
-      cnt++;
-  }
+  std::vector<std::pair<irep_idt, std::string>> bodies;
 
-  write_gb_word(out, cnt);
+  irepconverter.checkpoint();
 
   for(const auto &fct : goto_functions.function_map)
   {
     if(fct.second.body_available())
     {
-      // Since version 2, goto functions are not converted to ireps,
-      // instead they are saved in a custom binary format
-
-      write_gb_string(out, id2string(fct.first)); // name
-      write_gb_word(out, fct.second.body.instructions.size()); // # instructions
-
-      for(const auto &instruction : fct.second.body.instructions)
-      {
-        irepconverter.reference_convert(instruction.get_code(), out);
-        irepconverter.reference_convert(instruction.source_location, out);
-        write_gb_word(out, (long)instruction.type);
-        irepconverter.reference_convert(instruction.guard, out);
-        write_gb_word(out, instruction.target_number);
-
-        write_gb_word(out, instruction.targets.size());
-
-        for(const auto &t_it : instruction.targets)
-          write_gb_word(out, t_it->target_number);
+      std::ostringstream body_out;
+      write_goto_function(body_out, fct.second, irepconverter);
+      irepconverter.restore_checkpoint();
+      bodies.emplace_back(fct.first, body_out.str());
+    }
+  }
 
-        write_gb_word(out, instruction.labels.size());
+  write_gb_word(out, bodies.size());
 
-        for(const auto &l_it : instruction.labels)
-          irepconverter.write_string_ref(out, l_it);
-      }
-    }
+  for(const auto &body : bodies)
+  {
+    write_gb_string(out, id2string(body.first)); // name
+    write_gb_word(out, body.second.size());      // # bytes
+    write_gb_word(
+      out,
+      goto_program_fingerprint(
+        goto_functions.function_map.at(body.first).body));
   }
 
+  for(const auto &body : bodies)
+    out.write(body.second.data(), body.second.size());
+
   // irepconverter.output_map(f);
   // irepconverter.output_string_map(f);
 
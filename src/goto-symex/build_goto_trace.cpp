@@ -15,6 +15,7 @@ Author: Daniel Kroening
 
 #include <util/arith_tools.h>
 #include <util/byte_operators.h>
+#include <util/phase_profile.h>
 #include <util/simplify_expr.h>
 
 #include <goto-programs/goto_functions.h>
@@ -200,6 +201,30 @@ replace_nondet_in_type(exprt &expr, const decision_proceduret &solver)
     replace_nondet_in_type(sub, solver);
 }
 
+/// Append the expressions whose values \ref build_goto_trace takes from the
+/// decision procedure for \p SSA_step to \p exprs, in the order in which they
+/// are used
+static void
+values_of_step(const SSA_stept &SSA_step, std::vector<exprt> &exprs)
+{
+  exprs.insert(
+    exprs.end(),
+    SSA_step.converted_function_arguments.begin(),
+    SSA_step.converted_function_arguments.end());
+
+  if(SSA_step.ssa_full_lhs.is_not_nil())
+    exprs.push_back(SSA_step.ssa_full_lhs);
+
+  for(const auto &j : SSA_step.converted_io_args)
+  {
+    if(!j.is_constant() && j.id() != ID_string_constant)
+      exprs.push_back(j);
+  }
+
+  if(SSA_step.is_assert() || SSA_step.is_assume() || SSA_step.is_goto())
+    exprs.push_back(SSA_step.cond_handle);
+}
+
 void build_goto_trace(
   const symex_target_equationt &target,
   ssa_step_predicatet is_last_step_to_keep,
@@ -207,6 +232,8 @@ void build_goto_trace(
   const namespacet &ns,
   goto_tracet &goto_trace)
 {
+  phase_profile_scopet phase_profile_scope("build trace");
+
   // We need to re-sort the steps according to their clock.
   // Furthermore, read-events need to occur before write
   // events with the same clock.
@@ -220,12 +247,22 @@ void build_goto_trace(
   ssa_step_iteratort last_step_to_keep = target.SSA_steps.end();
   bool last_step_was_kept = false;
 
+  // the values are obtained from the decision procedure in bulk
+  const std::vector<exprt> guard_values = [&] {
+    std::vector<exprt> guards;
+    guards.reserve(target.SSA_steps.size());
+    for(const SSA_stept &SSA_step : target.SSA_steps)
+      guards.push_back(SSA_step.guard_handle);
+    return decision_procedure.get(guards);
+  }();
+  auto guard_value = guard_values.begin();
+
   // First sort the SSA steps by time, in the process dropping steps
   // we definitely don't want to retain in the final trace:
 
   for(ssa_step_iteratort it = target.SSA_steps.begin();
       it != target.SSA_steps.end();
-      it++)
+      it++, guard_value++)
   {
     if(
       last_step_to_keep == target.SSA_steps.end() &&
@@ -236,7 +273,7 @@ void build_goto_trace(
 
     const SSA_stept &SSA_step = *it;
 
-    if(!decision_procedure.get(SSA_step.guard_handle).is_true())
+    if(!guard_value->is_true())
       continue;
 
     if(it->is_constraint() ||
@@ -323,6 +360,21 @@ void build_goto_trace(
 
   // Now build the GOTO trace, ordered by time, then by SSA trace order.
 
+  const std::vector<exprt> values = [&] {
+    std::vector<exprt> exprs;
+    for(const auto &time_and_ssa_steps : time_map)
+    {
+      for(const auto &ssa_step_it : time_and_ssa_steps.second)
+      {
+        values_of_step(*ssa_step_it, exprs);
+        if(ssa_step_it == last_step_to_keep)
+          return decision_procedure.get(exprs);
+      }
+    }
+    return decision_procedure.get(exprs);
+  }();
+  auto value = values.begin();
+
   // produce the step numbers
   unsigned step_nr = 0;
 
@@ -353,7 +405,7 @@ void build_goto_trace(
       goto_trace_step.function_arguments = SSA_step.converted_function_arguments;
 
       for(auto &arg : goto_trace_step.function_arguments)
-        arg = decision_procedure.get(arg);
+        arg = *value++;
 
       // update internal field for specific variables in the counterexample
       update_internal_field(SSA_step, goto_trace_step, ns);
@@ -381,8 +433,7 @@ void build_goto_trace(
 
       if(SSA_step.ssa_full_lhs.is_not_nil())
       {
-        goto_trace_step.full_lhs_value =
-          decision_procedure.get(SSA_step.ssa_full_lhs);
+        goto_trace_step.full_lhs_value = *value++;
         simplify(goto_trace_step.full_lhs_value, ns);
         replace_nondet_in_type(
           goto_trace_step.full_lhs_value, decision_procedure);
@@ -395,18 +446,14 @@ void build_goto_trace(
           goto_trace_step.io_args.push_back(j);
         }
         else
-        {
-          exprt tmp = decision_procedure.get(j);
-          goto_trace_step.io_args.push_back(tmp);
-        }
+          goto_trace_step.io_args.push_back(*value++);
       }
 
       if(SSA_step.is_assert() || SSA_step.is_assume() || SSA_step.is_goto())
       {
         goto_trace_step.cond_expr = SSA_step.cond_expr;
 
-        goto_trace_step.cond_value =
-          decision_procedure.get(SSA_step.cond_handle).is_true();
+        goto_trace_step.cond_value = (value++)->is_true();
       }
 
       if(ssa_step_it == last_step_to_keep)
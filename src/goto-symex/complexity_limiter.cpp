@@ -8,6 +8,7 @@ Author: John Dumbell
 
 #include "complexity_limiter.h"
 #include "goto_symex_state.h"
+#include <algorithm>
 #include <cmath>
 
 complexity_limitert::complexity_limitert(
@@ -37,6 +38,9 @@ complexity_limitert::complexity_limitert(
       max_loops_complexity = std::max(static_cast<int>(floor(unwind / 3)), 1);
     else
       max_loops_complexity = limit;
+
+    adaptive_loop_budgets =
+      options.get_bool_option("symex-complexity-adaptive");
   }
 }
 
@@ -130,21 +134,103 @@ bool complexity_limitert::are_loop_children_too_complicated(
   return !loop_to_blacklist;
 }
 
+bool complexity_limitert::is_loop_growth_too_large(
+  const goto_symex_statet &state,
+  framet::active_loop_infot &active_loop)
+{
+  const std::size_t steps = state.symex_target->SSA_steps.size();
+
+  if(!active_loop.iteration_started)
+  {
+    active_loop.iteration_started = true;
+    active_loop.checked_iterations = active_loop.iterations;
+    active_loop.iteration_start_steps = steps;
+    active_loop.iteration_reached_new = false;
+    return false;
+  }
+
+  if(active_loop.iterations == active_loop.checked_iterations)
+    return false;
+
+  const std::size_t growth = steps - active_loop.iteration_start_steps;
+  const bool reached_new = active_loop.iteration_reached_new;
+
+  active_loop.checked_iterations = active_loop.iterations;
+  active_loop.iteration_start_steps = steps;
+  active_loop.iteration_reached_new = false;
+
+  std::size_t &budget =
+    loop_budgets.emplace(&active_loop.loop, max_complexity).first->second;
+
+  // Iterations that make progress may grow the equation further.
+  if(reached_new)
+  {
+    budget = std::max(budget, 2 * growth);
+    return false;
+  }
+
+  if(growth > budget)
+    return true;
+
+  // Loops whose iterations keep growing the equation without reaching new
+  // instructions soon exceed a budget that follows their growth.
+  budget = (budget + growth) / 2;
+  return false;
+}
+
 complexity_violationt
 complexity_limitert::check_complexity(goto_symex_statet &state)
 {
   if(!complexity_limits_active() || !state.reachable)
     return complexity_violationt::NONE;
 
+  auto &current_call_stack = state.call_stack();
+  auto active_loop = get_current_active_loop(current_call_stack);
+
+  if(adaptive_loop_budgets)
+  {
+    if(reached_instructions.insert(state.source.pc).second)
+    {
+      for(auto &frame : current_call_stack)
+      {
+        for(auto &loop_info : frame.active_loops)
+          loop_info.iteration_reached_new = true;
+      }
+    }
+
+    if(
+      active_loop != nullptr &&
+      is_loop_growth_too_large(state, *active_loop))
+    {
+      // Make the enclosing loops skip this loop in their remaining iterations.
+      for(auto &frame : current_call_stack)
+      {
+        for(auto &loop_info : frame.active_loops)
+        {
+          if(&loop_info != active_loop)
+            loop_info.blacklisted_loops.emplace_back(active_loop->loop);
+        }
+      }
+
+      log.warning()
+        << "[symex-complexity] Loop iterations grow the equation without "
+        << "reaching new instructions"
+        << (state.source.pc->source_location.is_not_nil()
+              ? " at: " + state.source.pc->source_location.as_string()
+              : ", location number: " +
+                  std::to_string(state.source.pc->location_number) + ".")
+        << messaget::eom;
+
+      return complexity_violationt::LOOP;
+    }
+  }
+
   std::size_t complexity =
     bounded_expr_size(state.guard.as_expr(), max_complexity);
   if(complexity == 1)
     return complexity_violationt::NONE;
 
-  auto &current_call_stack = state.call_stack();
-
   // Check if this branch is too complicated to continue.
-  auto active_loop = get_current_active_loop(current_call_stack);
   if(complexity >= max_complexity)
   {
     // If we're too complex, add a counter to the current loop we're in and
@@ -12,6 +12,9 @@ Author: John Dumbell
 #ifndef CPROVER_GOTO_SYMEX_COMPLEXITY_LIMITER_H
 #define CPROVER_GOTO_SYMEX_COMPLEXITY_LIMITER_H
 
+#include <unordered_map>
+#include <unordered_set>
+
 #include "complexity_violation.h"
 #include "symex_complexity_limit_exceeded_action.h"
 
@@ -43,6 +46,14 @@ class optionst;
 /// In the above loop B will be blacklisted if we have a complexity limitation
 /// < 5000, but loop A and C will still be run, because when loop B is removed
 /// the complexity of the loop as a whole is acceptable.
+///
+/// With adaptive limits each loop additionally gets a budget on how many
+/// steps one of its iterations may add to the equation. An iteration that
+/// reaches an instruction that symex has not reached before relaxes the
+/// budget of its loop, any other iteration tightens it towards its own
+/// growth. A loop whose iterations grow the equation beyond the budget
+/// without reaching new instructions is cancelled and blacklisted like a
+/// loop with too many complex branches.
 class complexity_limitert
 {
 public:
@@ -100,6 +111,24 @@ protected:
   /// before the entire loop is abandoned.
   std::size_t max_loops_complexity = 0;
 
+  /// Are the per-loop budgets on the growth of the equation active?
+  bool adaptive_loop_budgets = false;
+
+  /// Instructions that symex has reached, when adaptive budgets are active.
+  std::unordered_set<goto_programt::const_targett, const_target_hash>
+    reached_instructions;
+
+  /// The current number of steps that an iteration of each loop that does
+  /// not reach new instructions may add to the equation.
+  std::unordered_map<const lexical_loopst::loopt *, std::size_t> loop_budgets;
+
+  /// Checks whether the last iteration of \p active_loop, which must be the
+  /// inner-most active loop of \p state, has violated its budget, and adapts
+  /// the budget to the growth of the equation in that iteration.
+  bool is_loop_growth_too_large(
+    const goto_symex_statet &state,
+    framet::active_loop_infot &active_loop);
+
   /// Checks whether the current loop execution stack has violated
   /// max_loops_complexity.
   bool are_loop_children_too_complicated(call_stackt &current_call_stack);
@@ -15,6 +15,7 @@ Author: Romain Brenguier, romain.brenguier@diffblue.com
 #include "goto_state.h"
 #include "symex_target.h"
 #include <analyses/lexical_loops.h>
+#include <util/optional.h>
 
 /// Stack frames -- these are used for function calls and for exceptions
 struct framet
@@ -37,6 +38,12 @@ struct framet
 
   std::set<irep_idt> local_objects;
 
+  /// The constant arguments of the call if its result is to be recorded as
+  /// a function summary, see \ref symex_function_summariest
+  optionalt<exprt::operandst> summary_arguments;
+  /// Number of SSA steps of the equation when the function was entered
+  std::size_t summary_first_step = 0;
+
   // exceptions
   std::map<irep_idt, goto_programt::targett> catch_map;
 
@@ -61,6 +68,18 @@ struct framet
     std::vector<std::reference_wrapper<lexical_loopst::loopt>>
       blacklisted_loops;
 
+    /// Number of times a backwards goto has returned to the start of this
+    /// loop.
+    std::size_t iterations = 0;
+
+    /// Used by the adaptive complexity limits: the number of iterations, the
+    /// size of the equation and whether a new instruction has been reached,
+    /// as of the last time the limits were checked in this loop.
+    std::size_t checked_iterations = 0;
+    std::size_t iteration_start_steps = 0;
+    bool iteration_started = false;
+    bool iteration_reached_new = false;
+
     // Loop information.
     lexical_loopst::loopt &loop;
   };
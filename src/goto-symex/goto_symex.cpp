@@ -33,7 +33,7 @@ unsigned goto_symext::dynamic_counter=0;
 void goto_symext::do_simplify(exprt &expr)
 {
   if(symex_config.simplify_opt)
-    simplify(expr, ns);
+    simplifier.simplify(expr);
 }
 
 void goto_symext::symex_assign(
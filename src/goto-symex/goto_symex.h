@@ -12,10 +12,17 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_SYMEX_GOTO_SYMEX_H
 #define CPROVER_GOTO_SYMEX_GOTO_SYMEX_H
 
+#include <util/magic.h>
 #include <util/message.h>
+#include <util/simplify_expr_class.h>
 
 #include "complexity_limiter.h"
 #include "symex_config.h"
+#include "symex_dereference_cache.h"
+#include "symex_function_summaries.h"
+
+#include <chrono>
+#include <unordered_set>
 
 class address_of_exprt;
 class code_function_callt;
@@ -57,16 +64,20 @@ public:
       symex_config(options),
       outer_symbol_table(outer_symbol_table),
       ns(outer_symbol_table),
+      simplifier(ns),
       guard_manager(guard_manager),
       target(_target),
       atomic_section_counter(0),
       log(mh),
+      value_set_dereference_cache(
+        symex_config.cache_dereferences ? SYMEX_DEREFERENCE_CACHE_SIZE : 0),
       path_storage(path_storage),
       path_segment_vccs(0),
       _total_vccs(std::numeric_limits<unsigned>::max()),
       _remaining_vccs(std::numeric_limits<unsigned>::max()),
       complexity_module(mh, options)
   {
+    simplifier.set_cache_size(symex_config.simplify_cache_size);
   }
 
   /// A virtual destructor allowing derived classes to be cleaned up correctly
@@ -155,6 +166,12 @@ public:
   /// by the symbolic executions.
   bool ignore_assertions = false;
 
+  /// Properties whose status is already known, such as properties that have
+  /// been found to fail on an earlier path or in an earlier unwinding. Their
+  /// assertions are not recorded in the equation, so that slicing removes all
+  /// the steps that only these assertions depend on.
+  std::unordered_set<irep_idt> decided_properties;
+
   /// \brief Defines condition for interrupting symbolic execution for a
   ///   specific loop
   ///
@@ -242,6 +259,10 @@ protected:
   /// goto-program, and the names of dynamically-created objects.
   namespacet ns;
 
+  /// Simplifier used by \ref do_simplify. It refers to \ref ns and is kept
+  /// alive across instructions so that its results can be memoized.
+  simplify_exprt simplifier;
+
   /// Used to create guards. Guards created with different guard managers cannot
   /// be combined together, so guards created by goto-symex should not escape
   /// the scope of this manager.
@@ -407,6 +428,57 @@ protected:
   /// \param dest_state: Symbolic execution state to be updated
   void phi_function(const goto_statet &goto_state, statet &dest_state);
 
+  /// Statistics of merging states, accumulated by \ref merge_gotos and
+  /// \ref phi_function and reported once symbolic execution finishes
+  struct merge_statisticst
+  {
+    /// Number of states merged into another one
+    std::size_t merges = 0;
+    /// Number of names in the parts of the renaming maps of merged states
+    /// that are not shared
+    std::size_t merged_names = 0;
+    std::chrono::duration<double> runtime{0};
+  };
+
+  merge_statisticst merge_statistics;
+
+  /// Results of calls recorded with `--symex-function-summaries`
+  symex_function_summariest function_summaries;
+
+  /// Results of value-set dereferencing reused by \ref dereference_rec with
+  /// `--symex-cache-dereferences`. Unlike goto_statet::dereference_cache this
+  /// is not part of any state: entries are validated against the value sets
+  /// of the state they are looked up in, so they survive merges and loop
+  /// iterations until one of the pointers involved is assigned to.
+  symex_dereference_cachet value_set_dereference_cache;
+
+  /// Statistics of \ref dereference, reported once symbolic execution
+  /// finishes
+  struct dereference_statisticst
+  {
+    /// Number of pointers dereferenced
+    std::size_t dereferences = 0;
+    std::chrono::duration<double> runtime{0};
+  };
+
+  dereference_statisticst dereference_statistics;
+
+  /// \return the arguments of a call of \p function_id if the call can be
+  ///   replaced by or recorded as a summary, i.e., the function can be
+  ///   summarised and all of \p arguments are constant
+  optionalt<exprt::operandst> get_summary_arguments(
+    const statet &state,
+    const irep_idt &function_id,
+    const goto_functionst::goto_functiont &goto_function,
+    const code_function_callt &call,
+    const std::vector<renamedt<exprt, L2>> &arguments);
+
+  /// Record the return value of the function of the top frame of \p state
+  /// as its summary if the frame was created for recording one and the
+  /// function has not added any assertions, assumptions or other
+  /// constraints
+  void record_function_summary(statet &state);
+
   /// Determine whether to unwind a loop
   /// \param source
   /// \param context
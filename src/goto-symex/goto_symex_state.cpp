@@ -14,6 +14,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <iostream>
 
+#include <util/arith_tools.h>
 #include <util/as_const.h>
 #include <util/base_exceptions.h>
 #include <util/byte_operators.h>
@@ -22,6 +23,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/expr_util.h>
 #include <util/find_symbols.h>
 #include <util/invariant.h>
+#include <util/mathematical_types.h>
 #include <util/std_expr.h>
 
 #include <analyses/dirty.h>
@@ -59,15 +61,36 @@ template <>
 renamedt<ssa_exprt, L1>
 goto_symex_statet::set_indices<L1>(ssa_exprt ssa_expr, const namespacet &ns)
 {
-  return level1(symex_level0(std::move(ssa_expr), ns, source.thread_nr));
+  renamedt<ssa_exprt, L0> l0_expr =
+    symex_level0(std::move(ssa_expr), ns, source.thread_nr);
+
+  if(
+    rename_dependencies != nullptr && l0_expr.get().get_level_1().empty() &&
+    l0_expr.get().get_level_2().empty())
+  {
+    const irep_idt l0_name = l0_expr.get().get_l1_object_identifier();
+    rename_dependencies->level1.emplace_back(
+      l0_name, level1.get_index(l0_name).value_or(rename_dependenciest::npos));
+  }
+
+  return level1(std::move(l0_expr));
 }
 
 template <>
 renamedt<ssa_exprt, L2>
 goto_symex_statet::set_indices<L2>(ssa_exprt ssa_expr, const namespacet &ns)
 {
-  return level2(
-    level1(symex_level0(std::move(ssa_expr), ns, source.thread_nr)));
+  renamedt<ssa_exprt, L1> l1_expr =
+    level1(symex_level0(std::move(ssa_expr), ns, source.thread_nr));
+
+  if(rename_dependencies != nullptr && l1_expr.get().get_level_2().empty())
+  {
+    const irep_idt &l1_name = l1_expr.get().get_identifier();
+    rename_dependencies->level2.emplace_back(
+      l1_name, level2.latest_index(l1_name));
+  }
+
+  return level2(std::move(l1_expr));
 }
 
 renamedt<ssa_exprt, L2> goto_symex_statet::assignment(
@@ -91,6 +114,7 @@ renamedt<ssa_exprt, L2> goto_symex_statet::assignment(
   }
 
   // do the l2 renaming
+  const unsigned previous_generation = level2.latest_index(l1_identifier);
   level2.increase_generation(l1_identifier, lhs, fresh_l2_name_provider);
   renamedt<ssa_exprt, L2> l2_lhs = set_indices<L2>(std::move(lhs), ns);
   lhs = l2_lhs.get();
@@ -117,10 +141,25 @@ renamedt<ssa_exprt, L2> goto_symex_statet::assignment(
       propagation.insert(l1_identifier, rhs);
     else if(propagation_entry->get() != rhs)
       propagation.replace(l1_identifier, rhs);
+
+    if(lhs.type().id() == ID_array)
+      erase_propagated_elements(l1_identifier);
   }
   else
+  {
     propagation.erase_if_exists(l1_identifier);
 
+    // arrays subject to field sensitivity are propagated per element anyway
+    if(lhs.type().id() == ID_array && !field_sensitivity.is_divisible(lhs))
+    {
+      propagate_elements(
+        l1_identifier,
+        previous_generation,
+        rhs,
+        !is_shared && record_value && threads.size() <= 1);
+    }
+  }
+
   {
     // update value sets
     exprt l1_rhs(rhs);
@@ -175,6 +214,14 @@ goto_symex_statet::rename(exprt expr, const namespacet &ns)
       level == L2,
     "must handle all renaming levels");
 
+  // other threads may change the values read, see l2_thread_read_encoding
+  if(
+    level == L2 && rename_cache.enabled() && rename_dependencies == nullptr &&
+    expr.has_operands() && threads.size() == 1)
+  {
+    return renamedt<exprt, level>{rename_cached(std::move(expr), ns)};
+  }
+
   if(is_ssa_expr(expr))
   {
     exprt original_expr = expr;
@@ -214,6 +261,12 @@ goto_symex_statet::rename(exprt expr, const namespacet &ns)
         // L1 identifiers are used for propagation!
         auto p_it = propagation.find(ssa.get_identifier());
 
+        if(rename_dependencies != nullptr)
+        {
+          rename_dependencies->propagation.emplace_back(
+            ssa.get_identifier(), p_it.has_value() ? p_it->get() : nil_exprt());
+        }
+
         if(p_it.has_value())
         {
           return renamedt<exprt, level>(*p_it); // already L2
@@ -271,12 +324,239 @@ goto_symex_statet::rename(exprt expr, const namespacet &ns)
       "if_exprt");
 
     if(level == L2)
+    {
       expr = field_sensitivity.apply(ns, *this, std::move(expr), false);
 
+      if(expr.id() == ID_index && threads.size() <= 1)
+        expr = get_propagated_element(std::move(expr));
+    }
+
     return renamedt<exprt, level>{std::move(expr)};
   }
 }
 
+exprt goto_symex_statet::rename_cached(exprt expr, const namespacet &ns)
+{
+  const rename_cachet::entryt *entry = rename_cache.find(expr);
+
+  if(entry != nullptr && dependencies_hold(entry->dependencies))
+  {
+    ++rename_cache.hits;
+    return entry->result;
+  }
+
+  ++rename_cache.misses;
+
+  const exprt original_expr = expr;
+  rename_dependenciest dependencies;
+  rename_dependencies = &dependencies;
+
+  exprt result;
+  try
+  {
+    result = rename(std::move(expr), ns).get();
+  }
+  catch(...)
+  {
+    rename_dependencies = nullptr;
+    throw;
+  }
+
+  rename_dependencies = nullptr;
+
+  if(dependencies.cacheable)
+    rename_cache.insert(original_expr, result, std::move(dependencies));
+
+  return result;
+}
+
+bool goto_symex_statet::dependencies_hold(
+  const rename_dependenciest &dependencies) const
+{
+  for(const auto &dependency : dependencies.level1)
+  {
+    const std::size_t index =
+      level1.get_index(dependency.first).value_or(rename_dependenciest::npos);
+    if(index != dependency.second)
+      return false;
+  }
+
+  for(const auto &dependency : dependencies.propagation)
+  {
+    const auto entry = propagation.find(dependency.first);
+    if(entry.has_value() != dependency.second.is_not_nil())
+      return false;
+    if(entry.has_value() && entry->get() != dependency.second)
+      return false;
+  }
+
+  for(const auto &dependency : dependencies.level2)
+  {
+    if(level2.latest_index(dependency.first) != dependency.second)
+      return false;
+  }
+
+  return true;
+}
+
+/// \return the key in the propagation map of the epoch of the elements of
+///   the array \p l1_identifier, which is the level-2 index of the array when
+///   the elements started to be recorded
+static irep_idt element_epoch_key(const irep_idt &l1_identifier)
+{
+  return id2string(l1_identifier) + "[[epoch]]";
+}
+
+/// \return the key in the propagation map of the constant value that the
+///   array \p l1_identifier had when the elements of \p epoch started to be
+///   recorded
+static irep_idt element_base_key(
+  const irep_idt &l1_identifier,
+  const exprt &epoch)
+{
+  return id2string(l1_identifier) + "[[" +
+         id2string(to_constant_expr(epoch).get_value()) + "]]";
+}
+
+/// \return the key in the propagation map of the element \p index of the
+///   array \p l1_identifier in \p epoch
+static irep_idt element_key(
+  const irep_idt &l1_identifier,
+  const exprt &epoch,
+  const mp_integer &index)
+{
+  return id2string(l1_identifier) + "[[" +
+         id2string(to_constant_expr(epoch).get_value()) + "][" +
+         integer2string(index) + "]]";
+}
+
+void goto_symex_statet::erase_propagated_elements(
+  const irep_idt &l1_identifier)
+{
+  // The elements of earlier epochs remain in the map, but can no longer be
+  // found.
+  propagation.erase_if_exists(element_epoch_key(l1_identifier));
+}
+
+void goto_symex_statet::propagate_elements(
+  const irep_idt &l1_identifier,
+  const unsigned previous_generation,
+  const exprt &rhs,
+  bool record_value)
+{
+  const irep_idt epoch_key = element_epoch_key(l1_identifier);
+  const auto epoch_entry = propagation.find(epoch_key);
+  exprt epoch = epoch_entry.has_value() ? epoch_entry->get() : nil_exprt{};
+  propagation.erase_if_exists(epoch_key);
+
+  if(!record_value)
+    return;
+
+  // The updates of the previous value of the array, innermost first
+  std::vector<std::reference_wrapper<const with_exprt>> updates;
+  const exprt *old = &rhs;
+  while(old->id() == ID_with && old->operands().size() == 3)
+  {
+    updates.emplace_back(to_with_expr(*old));
+    old = &to_with_expr(*old).old();
+  }
+
+  const exprt new_epoch =
+    from_integer(level2.latest_index(l1_identifier), integer_typet{});
+  bool has_base;
+
+  if(
+    is_ssa_expr(*old) &&
+    remove_level_2(to_ssa_expr(*old)).get_identifier() == l1_identifier &&
+    to_ssa_expr(*old).get_level_2() == std::to_string(previous_generation))
+  {
+    // The elements recorded for the previous value remain valid.
+    if(epoch.is_nil())
+    {
+      epoch = new_epoch;
+      has_base = false;
+    }
+    else
+      has_base = propagation.has_key(element_base_key(l1_identifier, epoch));
+  }
+  else if(!updates.empty() && goto_symex_is_constantt()(*old))
+  {
+    // The array was constant before some of its elements changed.
+    epoch = new_epoch;
+    propagation.insert(element_base_key(l1_identifier, epoch), *old);
+    has_base = true;
+  }
+  else
+    return;
+
+  for(auto it = updates.rbegin(); it != updates.rend(); ++it)
+  {
+    const with_exprt &update = *it;
+    const auto index = numeric_cast<mp_integer>(update.where());
+
+    // any element may have changed
+    if(!index.has_value())
+      return;
+
+    const irep_idt key = element_key(l1_identifier, epoch, *index);
+    if(goto_symex_is_constantt()(update.new_value()))
+      propagation.insert_or_replace(key, update.new_value());
+    else if(has_base)
+      propagation.insert_or_replace(key, exprt{ID_unknown});
+    else
+      propagation.erase_if_exists(key);
+  }
+
+  propagation.insert(epoch_key, std::move(epoch));
+}
+
+exprt goto_symex_statet::get_propagated_element(exprt expr)
+{
+  const index_exprt &index_expr = to_index_expr(expr);
+
+  if(!is_ssa_expr(index_expr.array()))
+    return expr;
+
+  const auto index = numeric_cast<mp_integer>(index_expr.index());
+  if(!index.has_value())
+    return expr;
+
+  const ssa_exprt &array = to_ssa_expr(index_expr.array());
+  const irep_idt l1_identifier = remove_level_2(array).get_identifier();
+  const unsigned generation = level2.latest_index(l1_identifier);
+
+  if(rename_dependencies != nullptr)
+    rename_dependencies->level2.emplace_back(l1_identifier, generation);
+
+  // only the current value of the array is recorded
+  if(array.get_level_2() != std::to_string(generation))
+    return expr;
+
+  auto find = [this](const irep_idt &key) {
+    const auto entry = propagation.find(key);
+    if(rename_dependencies != nullptr)
+    {
+      rename_dependencies->propagation.emplace_back(
+        key, entry.has_value() ? entry->get() : nil_exprt{});
+    }
+    return entry;
+  };
+
+  const auto epoch = find(element_epoch_key(l1_identifier));
+  if(!epoch.has_value())
+    return expr;
+
+  const auto element = find(element_key(l1_identifier, *epoch, *index));
+  if(element.has_value())
+    return element->get().id() == ID_unknown ? expr : element->get();
+
+  const auto base = find(element_base_key(l1_identifier, *epoch));
+  if(base.has_value())
+    return index_exprt{base->get(), index_expr.index()};
+
+  return expr;
+}
+
 // Explicitly instantiate the one version of this function without an explicit
 // caller in this file:
 template renamedt<exprt, L1_WITH_CONSTANT_PROPAGATION>
@@ -687,6 +967,10 @@ void goto_symex_statet::rename(
   if(!requires_renaming(type, ns))
     return; // no action
 
+  // the renaming depends on the types recorded in l1_types
+  if(rename_dependencies != nullptr)
+    rename_dependencies->cacheable = false;
+
   // rename all the symbols with their last known value
   // to the given level
 
@@ -843,6 +1127,7 @@ ssa_exprt goto_symex_statet::declare(ssa_exprt ssa, const namespacet &ns)
     const std::size_t field_generation = level2.increase_generation(
       l1_symbol.get_identifier(), field_ssa, fresh_l2_name_provider);
     CHECK_RETURN(field_generation == 1);
+    erase_propagated_elements(l1_symbol.get_identifier());
   }
 
   record_events.push(false);
@@ -25,6 +25,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "call_stack.h"
 #include "field_sensitivity.h"
 #include "goto_state.h"
+#include "rename_cache.h"
 #include "renaming_level.h"
 #include "symex_target_equation.h"
 
@@ -117,12 +118,48 @@ public:
     bool record_value,
     bool allow_pointer_unsoundness = false);
 
+  /// Forget the values of individual elements of the array \p l1_identifier
+  /// that constant propagation has recorded
+  void erase_propagated_elements(const irep_idt &l1_identifier);
+
   field_sensitivityt field_sensitivity;
 
+  /// Level-2 renamings of compound expressions, which \ref rename reuses
+  /// while the renaming levels and the constant propagator agree on all the
+  /// symbols involved; disabled unless given a size
+  rename_cachet rename_cache{0};
+
 protected:
   template <levelt>
   void rename_address(exprt &expr, const namespacet &ns);
 
+  /// Rename \p expr to level 2 using \ref rename_cache
+  exprt rename_cached(exprt expr, const namespacet &ns);
+
+  /// Record in \ref propagation the values of the elements of the array
+  /// \p l1_identifier that are known after assigning \p rhs to it, where
+  /// \p previous_generation is the level-2 index of the array before the
+  /// assignment. This keeps constant elements of arrays that are too large
+  /// for field sensitivity, or that are not entirely constant, available to
+  /// \ref get_propagated_element.
+  void propagate_elements(
+    const irep_idt &l1_identifier,
+    unsigned previous_generation,
+    const exprt &rhs,
+    bool record_value);
+
+  /// \return the value that constant propagation has recorded for the
+  ///   element read by \p index_expr (L2), or \p index_expr if there is none
+  exprt get_propagated_element(exprt index_expr);
+
+  /// \return true if the lookups in \p dependencies still yield the same
+  ///   values
+  bool dependencies_hold(const rename_dependenciest &dependencies) const;
+
+  /// The lookups of the renaming currently recorded for \ref rename_cache,
+  /// or null if none is being recorded
+  rename_dependenciest *rename_dependencies = nullptr;
+
   /// Update values up to \c level.
   template <levelt level>
   NODISCARD renamedt<ssa_exprt, level>
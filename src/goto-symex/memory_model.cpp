@@ -11,6 +11,8 @@ Author: Michael Tautschnig, michael.tautschnig@cs.ox.ac.uk
 
 #include "memory_model.h"
 
+#include <util/message.h>
+#include <util/simplify_expr.h>
 #include <util/std_expr.h>
 
 memory_model_baset::memory_model_baset(const namespacet &_ns)
@@ -28,6 +30,23 @@ symbol_exprt memory_model_baset::nondet_bool_symbol(const std::string &prefix)
     "memory_model::choice_" + prefix + std::to_string(var_cnt++), bool_typet());
 }
 
+void memory_model_baset::add_memory_model_constraint(
+  symex_target_equationt &equation,
+  const exprt &cond,
+  const std::string &msg,
+  const symex_targett::sourcet &source)
+{
+  if(!lazy)
+  {
+    add_constraint(equation, cond, msg, source);
+    return;
+  }
+
+  exprt tmp = simplify_expr(cond, ns);
+  if(!tmp.is_true())
+    equation.lazy_constraints.push_back(std::move(tmp));
+}
+
 bool memory_model_baset::po(event_it e1, event_it e2)
 {
   // within same thread
@@ -40,12 +59,16 @@ bool memory_model_baset::po(event_it e1, event_it e2)
   }
 }
 
-void memory_model_baset::read_from(symex_target_equationt &equation)
+void memory_model_baset::read_from(
+  symex_target_equationt &equation,
+  message_handlert &message_handler)
 {
   // We iterate over all the reads, and
   // make them match at least one
   // (internal or external) write.
 
+  std::size_t pruned_read_from_pairs = 0;
+
   for(const auto &address : address_map)
   {
     for(const auto &read_event : address.second.reads)
@@ -53,15 +76,26 @@ void memory_model_baset::read_from(symex_target_equationt &equation)
       exprt::operandst rf_choice_symbols;
       rf_choice_symbols.reserve(address.second.writes.size());
 
+      const optionalt<event_it> shadowing_write =
+        prune_read_from
+          ? get_shadowing_write(read_event, address.second.writes)
+          : optionalt<event_it>{};
+
       // this is quadratic in #events per address
       for(const auto &write_event : address.second.writes)
       {
         // rf cannot contradict program order
-        if(!po(read_event, write_event))
+        if(po(read_event, write_event))
+          continue;
+
+        if(shadowing_write.has_value() && po(write_event, *shadowing_write))
         {
-          rf_choice_symbols.push_back(register_read_from_choice_symbol(
-            read_event, write_event, equation));
+          ++pruned_read_from_pairs;
+          continue;
         }
+
+        rf_choice_symbols.push_back(
+          register_read_from_choice_symbol(read_event, write_event, equation));
       }
 
       // uninitialised global symbol like symex_dynamic::dynamic_object*
@@ -70,7 +104,7 @@ void memory_model_baset::read_from(symex_target_equationt &equation)
       {
         // Add the read's guard, each of the writes' guards is implied
         // by each entry in rf_some
-        add_constraint(
+        add_memory_model_constraint(
           equation,
           implies_exprt{read_event->guard, disjunction(rf_choice_symbols)},
           "rf-some",
@@ -78,6 +112,42 @@ void memory_model_baset::read_from(symex_target_equationt &equation)
       }
     }
   }
+
+  if(pruned_read_from_pairs != 0)
+  {
+    messaget log{message_handler};
+    log.statistics() << "Pruned " << pruned_read_from_pairs
+                     << " read-from pairs" << messaget::eom;
+  }
+}
+
+optionalt<partial_order_concurrencyt::event_it>
+memory_model_baset::get_shadowing_write(
+  event_it read_event,
+  const event_listt &writes)
+{
+  optionalt<event_it> shadowing_write;
+
+  for(const auto &write_event : writes)
+  {
+    if(
+      po(write_event, read_event) && write_event->guard == read_event->guard &&
+      (!shadowing_write.has_value() || po(*shadowing_write, write_event)))
+    {
+      shadowing_write = write_event;
+    }
+  }
+
+  return shadowing_write;
+}
+
+const std::vector<memory_model_baset::choice_symbolst::const_iterator> &
+memory_model_baset::choice_symbols_for(event_it w) const
+{
+  static const std::vector<choice_symbolst::const_iterator> none;
+
+  const auto entry = choice_symbols_by_write.find(w);
+  return entry == choice_symbols_by_write.end() ? none : entry->second;
 }
 
 symbol_exprt memory_model_baset::register_read_from_choice_symbol(
@@ -88,12 +158,13 @@ symbol_exprt memory_model_baset::register_read_from_choice_symbol(
   symbol_exprt s = nondet_bool_symbol("rf");
 
   // record the symbol
-  choice_symbols.emplace(std::make_pair(r, w), s);
+  const auto entry = choice_symbols.emplace(std::make_pair(r, w), s).first;
+  choice_symbols_by_write[w].push_back(entry);
 
   bool is_rfi = w->source.thread_nr == r->source.thread_nr;
   // Uses only the write's guard as precondition, read's guard
   // follows from rf_some
-  add_constraint(
+  add_memory_model_constraint(
     equation,
     // We rely on the fact that there is at least
     // one write event that has guard 'true'.
@@ -104,7 +175,7 @@ symbol_exprt memory_model_baset::register_read_from_choice_symbol(
   if(!is_rfi)
   {
     // if r reads from w, then w must have happened before r
-    add_constraint(
+    add_memory_model_constraint(
       equation, implies_exprt{s, before(w, r)}, "rf-order", r->source);
   }
 
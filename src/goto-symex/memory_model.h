@@ -12,6 +12,8 @@ Author: Michael Tautschnig, michael.tautschnig@cs.ox.ac.uk
 #ifndef CPROVER_GOTO_SYMEX_MEMORY_MODEL_H
 #define CPROVER_GOTO_SYMEX_MEMORY_MODEL_H
 
+#include <util/optional.h>
+
 #include "partial_order_concurrency.h"
 
 class memory_model_baset : public partial_order_concurrencyt
@@ -22,7 +24,33 @@ public:
 
   virtual void operator()(symex_target_equationt &, message_handlert &) = 0;
 
+  /// If \p lazy is true then only add the program-order constraints to the
+  /// equation, and record the read-from, write-serialisation and from-read
+  /// constraints in symex_target_equationt::lazy_constraints instead
+  void set_lazy(bool lazy)
+  {
+    this->lazy = lazy;
+  }
+
+  /// If \p prune_read_from is true then \ref read_from does not pair reads
+  /// with writes ruled out by \ref get_shadowing_write
+  void set_prune_read_from(bool prune_read_from)
+  {
+    this->prune_read_from = prune_read_from;
+  }
+
 protected:
+  bool lazy = false;
+  bool prune_read_from = false;
+
+  /// Add \p cond to the equation as \ref add_constraint does, or to the lazy
+  /// constraints of the equation when \ref set_lazy has been enabled
+  void add_memory_model_constraint(
+    symex_target_equationt &equation,
+    const exprt &cond,
+    const std::string &msg,
+    const symex_targett::sourcet &source);
+
   /// In-thread program order
   /// \param e1: preceding event
   /// \param e2: following event
@@ -38,11 +66,34 @@ protected:
   typedef std::map<std::pair<event_it, event_it>, symbol_exprt> choice_symbolst;
   choice_symbolst choice_symbols;
 
+  /// The entries of \ref choice_symbols for each write event
+  std::map<event_it, std::vector<choice_symbolst::const_iterator>>
+    choice_symbols_by_write;
+
+  /// \return the entries of \ref choice_symbols with write event \p w
+  const std::vector<choice_symbolst::const_iterator> &
+  choice_symbols_for(event_it w) const;
+
+  /// Accesses to the same address remain in program order within a thread in
+  /// all memory models implemented here. Hence \p read_event cannot read from
+  /// any write of its own thread that precedes, in program order, a later
+  /// write of that thread to the same address that has the same guard as
+  /// \p read_event, as that write is executed whenever the read is.
+  /// \param read_event: read event
+  /// \param writes: write events to the address that \p read_event reads
+  /// \return the latest such write in program order, if any
+  optionalt<event_it>
+  get_shadowing_write(event_it read_event, const event_listt &writes);
+
   /// For each read `r` from every address we collect the choice symbols `S`
   ///   via \ref register_read_from_choice_symbol (for potential read-write
   ///   pairs) and add a constraint r.guard => \/S.
   /// \param equation: symex equation where the new constraint should be added
-  void read_from(symex_target_equationt &equation);
+  /// \param message_handler: reporting the number of pairs pruned as per
+  ///   \ref set_prune_read_from
+  void read_from(
+    symex_target_equationt &equation,
+    message_handlert &message_handler);
 
   /// Introduce a new choice symbol `s` for the pair (\p r, \p w)
   /// add constraint s => (w.guard /\ r.lhs=w.lhs)
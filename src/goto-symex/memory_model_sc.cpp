@@ -22,7 +22,7 @@ operator()(symex_target_equationt &equation, message_handlert &message_handler)
   build_event_lists(equation, message_handler);
   build_clock_type();
 
-  read_from(equation);
+  read_from(equation, message_handler);
   write_serialization_external(equation);
   program_order(equation);
   from_read(equation);
@@ -231,13 +231,13 @@ void memory_model_sct::write_serialization_external(
         symbol_exprt s=nondet_bool_symbol("ws-ext");
 
         // write-to-write edge
-        add_constraint(
+        add_memory_model_constraint(
           equation,
           implies_exprt(s, before(*w_it1, *w_it2)),
           "ws-ext",
           (*w_it1)->source);
 
-        add_constraint(
+        add_memory_model_constraint(
           equation,
           implies_exprt(not_exprt(s), before(*w_it2, *w_it1)),
           "ws-ext",
@@ -291,45 +291,45 @@ void memory_model_sct::from_read(symex_target_equationt &equation)
           ws2=before(*w, *w_prime);
         }
 
-        // smells like cubic
-        for(choice_symbolst::const_iterator
-            c_it=choice_symbols.begin();
-            c_it!=choice_symbols.end();
-            c_it++)
+        // reads from w_prime that may be followed by w
+        if(!ws1.is_false())
         {
-          event_it r=c_it->first.first;
-          exprt rf=c_it->second;
-          exprt cond;
-          cond.make_nil();
-
-          if(c_it->first.second==*w_prime && !ws1.is_false())
+          for(const auto &c_it : choice_symbols_for(*w_prime))
           {
-            exprt fr=before(r, *w);
+            event_it r = c_it->first.first;
+            exprt fr = before(r, *w);
 
             // the guard of w_prime follows from rf; with rfi
             // optimisation such as the previous write_symbol_primed
             // it would even be wrong to add this guard
-            cond=
+            add_memory_model_constraint(
+              equation,
               implies_exprt(
-                and_exprt(r->guard, (*w)->guard, ws1, rf),
-                fr);
+                and_exprt(r->guard, (*w)->guard, ws1, c_it->second), fr),
+              "fr",
+              r->source);
           }
-          else if(c_it->first.second==*w && !ws2.is_false())
+        }
+
+        // reads from w that may be followed by w_prime
+        if(!ws2.is_false())
+        {
+          for(const auto &c_it : choice_symbols_for(*w))
           {
-            exprt fr=before(r, *w_prime);
+            event_it r = c_it->first.first;
+            exprt fr = before(r, *w_prime);
 
             // the guard of w follows from rf; with rfi
             // optimisation such as the previous write_symbol_primed
             // it would even be wrong to add this guard
-            cond=
+            add_memory_model_constraint(
+              equation,
               implies_exprt(
-                and_exprt(r->guard, (*w_prime)->guard, ws2, rf),
-                fr);
+                and_exprt(r->guard, (*w_prime)->guard, ws2, c_it->second),
+                fr),
+              "fr",
+              r->source);
           }
-
-          if(cond.is_not_nil())
-            add_constraint(equation,
-              cond, "fr", r->source);
         }
       }
     }
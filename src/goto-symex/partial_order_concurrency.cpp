@@ -15,6 +15,8 @@ Author: Michael Tautschnig, michael.tautschnig@cs.ox.ac.uk
 #include <util/bitvector_types.h>
 #include <util/simplify_expr.h>
 
+#include <iterator>
+
 partial_order_concurrencyt::partial_order_concurrencyt(
   const namespacet &_ns):ns(_ns)
 {
@@ -68,7 +70,10 @@ void partial_order_concurrencyt::add_init_writes(
     init_done.insert(a);
   }
 
-  equation.SSA_steps.splice(equation.SSA_steps.begin(), init_steps);
+  init_steps.append(
+    std::make_move_iterator(equation.SSA_steps.begin()),
+    std::make_move_iterator(equation.SSA_steps.end()));
+  equation.SSA_steps.swap(init_steps);
 }
 
 void partial_order_concurrencyt::build_event_lists(
@@ -8,11 +8,13 @@ Author: Kareem Khazem <karkhaz@karkhaz.com>
 
 #include "path_storage.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include <util/cmdline.h>
 #include <util/exit_codes.h>
 #include <util/make_unique.h>
+#include <util/string2int.h>
 
 nondet_symbol_exprt symex_nondet_generatort::
 operator()(typet type, source_locationt location)
@@ -82,6 +84,159 @@ void path_fifot::clear()
   paths.clear();
 }
 
+// _____________________________________________________________________________
+// path_priorityt
+
+path_storaget::patht &path_priorityt::private_peek()
+{
+  if(!peeked)
+  {
+    std::pop_heap(paths.begin(), paths.end());
+    peeked = std::move(paths.back().path);
+    paths.pop_back();
+  }
+
+  return *peeked;
+}
+
+void path_priorityt::push(const path_storaget::patht &path)
+{
+  auto saved = util_make_unique<patht>(path);
+  const double saved_score = score(*saved);
+  paths.push_back(entryt{saved_score, pushed++, std::move(saved)});
+  std::push_heap(paths.begin(), paths.end());
+}
+
+void path_priorityt::private_pop()
+{
+  if(!peeked)
+    private_peek();
+
+  popped(*peeked);
+  peeked.reset();
+}
+
+std::size_t path_priorityt::size() const
+{
+  return paths.size() + (peeked ? 1 : 0);
+}
+
+void path_priorityt::clear()
+{
+  paths.clear();
+  peeked.reset();
+}
+
+void path_priorityt::rescore()
+{
+  for(auto &entry : paths)
+    entry.score = score(*entry.path);
+
+  std::make_heap(paths.begin(), paths.end());
+}
+
+double path_shallowt::score(const patht &path)
+{
+  return -static_cast<double>(path.state.depth);
+}
+
+double path_smallt::score(const patht &path)
+{
+  return -static_cast<double>(path.equation.SSA_steps.size());
+}
+
+/// \return the instruction that symbolic execution of \p state resumes from
+static goto_programt::const_targett
+resume_location(const goto_symex_statet &state)
+{
+  if(state.has_saved_jump_target || state.has_saved_next_instruction)
+    return state.saved_target;
+
+  return state.source.pc;
+}
+
+const std::vector<irep_idt> &
+path_uncoveredt::reachable_properties(goto_programt::const_targett start)
+{
+  auto entry = reachable.emplace(start, std::vector<irep_idt>{});
+  if(!entry.second)
+    return entry.first->second;
+
+  std::unordered_set<goto_programt::const_targett, const_target_hash> seen;
+  std::vector<goto_programt::const_targett> queue{start};
+  seen.insert(start);
+
+  while(!queue.empty())
+  {
+    const goto_programt::const_targett pc = queue.back();
+    queue.pop_back();
+
+    if(pc->is_assert())
+      entry.first->second.push_back(pc->source_location.get_property_id());
+
+    // the end of the function is the last instruction of its body
+    if(pc->is_end_function())
+      continue;
+
+    std::vector<goto_programt::const_targett> successors;
+    if(pc->is_goto())
+    {
+      successors.assign(pc->targets.begin(), pc->targets.end());
+      if(!pc->get_condition().is_true())
+        successors.push_back(std::next(pc));
+    }
+    else
+      successors.push_back(std::next(pc));
+
+    for(const auto &successor : successors)
+    {
+      if(seen.insert(successor).second)
+        queue.push_back(successor);
+    }
+  }
+
+  return entry.first->second;
+}
+
+double path_uncoveredt::score(const patht &path)
+{
+  std::unordered_set<irep_idt> uncovered;
+
+  auto add_uncovered = [this, &uncovered](goto_programt::const_targett pc) {
+    for(const auto &property_id : reachable_properties(pc))
+    {
+      if(covered.find(property_id) == covered.end())
+        uncovered.insert(property_id);
+    }
+  };
+
+  add_uncovered(resume_location(path.state));
+
+  // Execution continues after the calls on the call stack; the bottom frame
+  // refers to the end of the entry point.
+  for(const auto &frame : path.state.call_stack())
+  {
+    if(frame.calling_location.pc->is_function_call())
+      add_uncovered(std::next(frame.calling_location.pc));
+  }
+
+  return static_cast<double>(uncovered.size());
+}
+
+void path_uncoveredt::popped(const patht &path)
+{
+  bool changed = false;
+
+  for(const auto &step : path.equation.SSA_steps)
+  {
+    if(step.is_assert() && covered.insert(step.get_property_id()).second)
+      changed = true;
+  }
+
+  if(changed)
+    rescore();
+}
+
 // _____________________________________________________________________________
 // path_strategy_choosert
 
@@ -106,6 +261,32 @@ static const std::map<
        "                              the program tree breadth-first.\n",
        []() { // NOLINT(whitespace/braces)
          return util_make_unique<path_fifot>();
+       }}},
+     {"shallow",
+      {" shallow                      paths are popped in order of the\n"
+       "                              number of branches taken on them,\n"
+       "                              fewest first; ties are broken in\n"
+       "                              last-in, first-out order.\n",
+       []() { // NOLINT(whitespace/braces)
+         return util_make_unique<path_shallowt>();
+       }}},
+     {"small",
+      {" small                        paths are popped in order of the\n"
+       "                              size of their equation, smallest\n"
+       "                              first; ties are broken in last-in,\n"
+       "                              first-out order.\n",
+       []() { // NOLINT(whitespace/braces)
+         return util_make_unique<path_smallt>();
+       }}},
+     {"uncovered",
+      {" uncovered                    paths are popped in order of the\n"
+       "                              number of assertions they can reach\n"
+       "                              that no path popped so far has\n"
+       "                              reached, most first. Finds failing\n"
+       "                              assertions in large state spaces\n"
+       "                              early.\n",
+       []() { // NOLINT(whitespace/braces)
+         return util_make_unique<path_uncoveredt>();
        }}}});
 
 std::string show_path_strategies()
@@ -158,4 +339,20 @@ void parse_path_strategy_options(
   {
     options.set_option("exploration-strategy", default_path_strategy());
   }
+
+  if(cmdline.isset("paths-jobs"))
+  {
+    const auto jobs = string2optional_unsigned(cmdline.get_value("paths-jobs"));
+    if(!jobs.has_value() || *jobs == 0)
+    {
+      log.error() << "--paths-jobs expects a positive number" << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    if(!cmdline.isset("paths"))
+      log.warning() << "--paths-jobs has no effect without --paths"
+                    << messaget::eom;
+
+    options.set_option("paths-jobs", *jobs);
+  }
 }
@@ -11,6 +11,8 @@
 #include <analyses/local_safe_pointers.h>
 
 #include <memory>
+#include <unordered_set>
+#include <vector>
 
 #include "goto_symex_state.h"
 #include "symex_target_equation.h"
@@ -195,6 +197,99 @@ private:
   void private_pop() override;
 };
 
+/// \brief Priority save queue: the path with the highest score is resumed
+/// first, and among paths with the same score the one saved last
+///
+/// Subtypes implement the score, which is computed when a path is saved.
+class path_priorityt : public path_storaget
+{
+public:
+  void push(const patht &) override;
+  std::size_t size() const override;
+  void clear() override;
+
+protected:
+  struct entryt
+  {
+    double score;
+    std::size_t number;
+    std::unique_ptr<patht> path;
+
+    bool operator<(const entryt &other) const
+    {
+      return score < other.score ||
+             (score == other.score && number < other.number);
+    }
+  };
+
+  /// Binary max-heap of the saved paths
+  std::vector<entryt> paths;
+
+  /// The path returned by the last peek, which has already been removed from
+  /// \ref paths so that paths saved while it is resumed are ordered correctly
+  std::unique_ptr<patht> peeked;
+
+  std::size_t pushed = 0;
+
+  /// \return the priority of \p path, higher scores are resumed first
+  virtual double score(const patht &path) = 0;
+
+  /// Called when the execution of \p path has been resumed and the path is
+  /// removed from the storage
+  virtual void popped(const patht &)
+  {
+  }
+
+  /// Recompute the scores of all saved paths, for subtypes whose scores
+  /// depend on the paths explored so far
+  void rescore();
+
+private:
+  patht &private_peek() override;
+  void private_pop() override;
+};
+
+/// \brief Resume the path with the fewest nested branches first
+class path_shallowt : public path_priorityt
+{
+protected:
+  double score(const patht &path) override;
+};
+
+/// \brief Resume the path with the smallest equation first
+class path_smallt : public path_priorityt
+{
+protected:
+  double score(const patht &path) override;
+};
+
+/// \brief Resume the path from which the most assertions that no explored
+/// path has reached so far can be reached
+///
+/// Reachability is decided on the control flow graph of the function that
+/// the path resumes in and the remainder of its callers, ignoring the bodies
+/// of functions called from there.
+class path_uncoveredt : public path_priorityt
+{
+protected:
+  double score(const patht &path) override;
+  void popped(const patht &path) override;
+
+  /// \return the property identifiers of the assertions that can be reached
+  ///   from \p start without leaving its function
+  const std::vector<irep_idt> &
+  reachable_properties(goto_programt::const_targett start);
+
+  std::unordered_map<
+    goto_programt::const_targett,
+    std::vector<irep_idt>,
+    const_target_hash>
+    reachable;
+
+  /// Properties with assertions that an explored path has reached
+  std::unordered_set<irep_idt> covered;
+};
+
 /// \brief suitable for displaying as a front-end help message
 std::string show_path_strategies();
 
@@ -0,0 +1,61 @@
+/*******************************************************************\
+
+Module: Symbolic Execution
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Memoization of level-2 renaming
+
+#include "rename_cache.h"
+
+const std::size_t rename_dependenciest::npos;
+
+const rename_cachet::entryt *rename_cachet::find(const exprt &expr)
+{
+  auto it = current.find(expr);
+  if(it != current.end())
+    return &it->second;
+
+  auto previous_it = previous.find(expr);
+  if(previous_it == previous.end())
+    return nullptr;
+
+  // promote to the current generation so that the entry survives the next
+  // generation change
+  exprt key = previous_it->first;
+  entryt entry = std::move(previous_it->second);
+  previous.erase(previous_it);
+  insert(key, std::move(entry.result), std::move(entry.dependencies));
+
+  return &current.at(key);
+}
+
+void rename_cachet::insert(
+  const exprt &expr,
+  exprt result,
+  rename_dependenciest dependencies)
+{
+  if(!enabled())
+    return;
+
+  if(current.size() >= (max_entries + 1) / 2)
+  {
+    evictions += previous.size();
+    previous = std::move(current);
+    current.clear();
+  }
+
+  entryt &entry = current[expr];
+  entry.result = std::move(result);
+  entry.dependencies = std::move(dependencies);
+}
+
+void rename_cachet::set_max_entries(std::size_t _max_entries)
+{
+  max_entries = _max_entries;
+  current.clear();
+  previous.clear();
+}
@@ -0,0 +1,93 @@
+/*******************************************************************\
+
+Module: Symbolic Execution
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Memoization of level-2 renaming
+
+#ifndef CPROVER_GOTO_SYMEX_RENAME_CACHE_H
+#define CPROVER_GOTO_SYMEX_RENAME_CACHE_H
+
+#include <util/expr.h>
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// What the level-2 renaming of an expression looked up in the renaming
+/// levels and the constant propagator. Renaming the expression again yields
+/// the same result as long as all lookups yield the same values.
+struct rename_dependenciest
+{
+  /// L0 object identifiers and the L1 index they were renamed to, or
+  /// `npos` if they had none
+  std::vector<std::pair<irep_idt, std::size_t>> level1;
+  /// L1 identifiers and the L2 index they were renamed to
+  std::vector<std::pair<irep_idt, std::size_t>> level2;
+  /// L1 identifiers and their constant value, or nil if they had none
+  std::vector<std::pair<irep_idt, exprt>> propagation;
+  /// False if the renaming depended on anything else, such as the type of an
+  /// object with non-constant size
+  bool cacheable = true;
+
+  static const std::size_t npos = static_cast<std::size_t>(-1);
+};
+
+/// A size-bounded cache mapping expressions to their level-2 renaming,
+/// together with the lookups the renaming depended on.
+///
+/// Entries are held in two generations, as in simplify_expr_cachet. The
+/// cache does not check the dependencies itself; goto_symex_statet only
+/// uses an entry if its dependencies still hold.
+class rename_cachet
+{
+public:
+  struct entryt
+  {
+    exprt result;
+    rename_dependenciest dependencies;
+  };
+
+  /// \param max_entries: maximum number of cached expressions; 0 disables
+  ///   the cache
+  explicit rename_cachet(std::size_t max_entries) : max_entries(max_entries)
+  {
+  }
+
+  bool enabled() const
+  {
+    return max_entries != 0;
+  }
+
+  /// Look up the renaming of \p expr
+  /// \return nullptr if not cached
+  const entryt *find(const exprt &expr);
+
+  /// Record that renaming \p expr yields \p result, computed with the
+  /// lookups \p dependencies
+  void insert(
+    const exprt &expr,
+    exprt result,
+    rename_dependenciest dependencies);
+
+  /// Change the maximum number of entries, dropping all entries.
+  void set_max_entries(std::size_t);
+
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  std::size_t evictions = 0;
+
+protected:
+  using containert =
+    std::unordered_map<exprt, entryt, irep_hash, irep_full_eq>;
+
+  std::size_t max_entries;
+  containert current;
+  containert previous;
+};
+
+#endif // CPROVER_GOTO_SYMEX_RENAME_CACHE_H
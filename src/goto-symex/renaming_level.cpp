@@ -73,6 +73,15 @@ bool symex_level1t::has(const renamedt<ssa_exprt, L0> &ssa) const
   return current_names.has_key(ssa.get().get_identifier());
 }
 
+optionalt<std::size_t>
+symex_level1t::get_index(const irep_idt &l0_name) const
+{
+  const auto r_opt = current_names.find(l0_name);
+  if(!r_opt)
+    return {};
+  return r_opt->get().second;
+}
+
 renamedt<ssa_exprt, L1> symex_level1t::
 operator()(renamedt<ssa_exprt, L0> l0_expr) const
 {
@@ -108,23 +117,17 @@ operator()(renamedt<ssa_exprt, L1> l1_expr) const
 
 void symex_level1t::restore_from(const symex_level1t &other)
 {
-  symex_renaming_levelt::delta_viewt delta_view;
-  other.current_names.get_delta_view(current_names, delta_view, false);
-
-  for(const auto &delta_item : delta_view)
-  {
-    if(!delta_item.is_in_both_maps())
-    {
-      current_names.insert(delta_item.k, delta_item.m);
-    }
-    else
-    {
-      if(delta_item.m != delta_item.get_other_map_value())
-      {
-        current_names.replace(delta_item.k, delta_item.m);
-      }
-    }
-  }
+  current_names.merge_with(
+    other.current_names,
+    [](
+      const irep_idt &,
+      const std::pair<ssa_exprt, std::size_t> &current,
+      const std::pair<ssa_exprt, std::size_t> &other_current)
+      -> optionalt<std::pair<ssa_exprt, std::size_t>> {
+      if(current == other_current)
+        return {};
+      return other_current;
+    });
 }
 
 unsigned symex_level2t::latest_index(const irep_idt &identifier) const
@@ -13,7 +13,9 @@ Author: Romain Brenguier, romain.brenguier@diffblue.com
 #define CPROVER_GOTO_SYMEX_RENAMING_LEVEL_H
 
 #include <util/irep.h>
+#include <util/persistent_dense_map.h>
 #include <util/sharing_map.h>
+#include <util/string_container.h>
 
 #include "renamed.h"
 
@@ -50,6 +52,10 @@ struct symex_level1t
   /// \return true if \p ssa has an associated index
   bool has(const renamedt<ssa_exprt, L0> &ssa) const;
 
+  /// \return the index associated with the L1 object identifier \p l0_name
+  ///   of an L0 expression, if any
+  optionalt<std::size_t> get_index(const irep_idt &l0_name) const;
+
   /// \return an SSA expression similar to \p l0_expr where the L1 tag has been
   ///   set to the value in \ref current_names of the l1 object identifier of
   ///   \p l0_expr
@@ -62,12 +68,35 @@ private:
   symex_renaming_levelt current_names;
 };
 
+/// Maps an identifier to its number in the string table, which is dense
+/// across all identifiers
+struct irep_id_to_dense_integert
+{
+  std::size_t operator()(const irep_idt &identifier) const
+  {
+#ifdef USE_DSTRING
+    return identifier.get_no();
+#else
+    return get_string_container()[id2string(identifier)];
+#endif
+  }
+};
+
 /// Functor to set the level 2 renaming of SSA expressions.
 /// Level 2 corresponds to SSA.
 /// This is to ensure each variable is only assigned once.
 struct symex_level2t
 {
-  symex_renaming_levelt current_names;
+  /// The L2 renaming is looked up for every symbol that symex reads and is
+  /// copied for every goto state, so it is keyed by the number of the L1
+  /// identifier, which takes fewer nodes to reach than a hash in a
+  /// \ref symex_renaming_levelt.
+  using current_namest = persistent_dense_mapt<
+    irep_idt,
+    std::pair<ssa_exprt, std::size_t>,
+    irep_id_to_dense_integert>;
+
+  current_namest current_names;
 
   /// Set L2 tag to correspond to the current count of the identifier of
   /// \p l1_expr's
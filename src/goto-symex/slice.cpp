@@ -258,6 +258,42 @@ void simple_slice(symex_target_equationt &equation)
   }
 }
 
+std::size_t deduplicate_SSA_steps(symex_target_equationt &equation)
+{
+  // Assignments and constraints are added to the formula unconditionally,
+  // hence their order does not matter. Assumptions only constrain later
+  // assertions, which an earlier equal assumption constrains as well, but
+  // they must not be confused with constraints.
+  std::unordered_set<exprt, irep_hash> constraints;
+  std::unordered_set<exprt, irep_hash> assumptions;
+
+  std::size_t count = 0;
+
+  for(auto &step : equation.SSA_steps)
+  {
+    if(step.ignore)
+      continue;
+
+    bool inserted;
+
+    if(step.is_assignment() || step.is_constraint())
+      inserted = constraints.insert(step.cond_expr).second;
+    else if(step.is_assume())
+      inserted = assumptions.insert(implies_exprt(step.guard, step.cond_expr))
+                   .second;
+    else
+      continue;
+
+    if(!inserted && !step.converted)
+    {
+      step.ignore = true;
+      ++count;
+    }
+  }
+
+  return count;
+}
+
 void revert_slice(symex_target_equationt &equation)
 {
   // set ignore to false
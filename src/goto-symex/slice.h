@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_SYMEX_SLICE_H
 #define CPROVER_GOTO_SYMEX_SLICE_H
 
+#include <cstddef>
 #include <list>
 #include <unordered_set>
 
@@ -34,6 +35,12 @@ void slice(
   symex_target_equationt &equation,
   const std::list<exprt> &expressions);
 
+/// Ignore assignments, assumptions and constraints that are equal to an
+/// earlier step of the \p equation, as converting them adds nothing to the
+/// formula. Such steps are typically produced on merged branches.
+/// \return the number of steps that are now ignored
+std::size_t deduplicate_SSA_steps(symex_target_equationt &equation);
+
 // Collects "open" variables that are used but not assigned
 
 typedef std::unordered_set<irep_idt> symbol_sett;
@@ -49,6 +49,10 @@ public:
   symex_targett::sourcet source;
   goto_trace_stept::typet type;
 
+  // for ASSIGNMENT and DECL; members smaller than a pointer are declared in
+  // pairs or groups to avoid padding, as equations hold many steps
+  symex_targett::assignment_typet assignment_type;
+
   bool is_assert() const
   {
     return type == goto_trace_stept::typet::ASSERT;
@@ -133,9 +137,6 @@ public:
   /// builds a unique name for an unwinding assertion.
   irep_idt get_property_id() const;
 
-  // we may choose to hide
-  bool hidden = false;
-
   exprt guard;
   exprt guard_handle;
 
@@ -143,7 +144,6 @@ public:
   ssa_exprt ssa_lhs;
   exprt ssa_full_lhs, original_full_lhs;
   exprt ssa_rhs;
-  symex_targett::assignment_typet assignment_type;
 
   // for ASSUME/ASSERT/GOTO/CONSTRAINT
   exprt cond_expr;
@@ -157,42 +157,53 @@ public:
 
   // for INPUT/OUTPUT
   irep_idt format_string, io_id;
-  bool formatted = false;
-  std::list<exprt> io_args;
-  std::list<exprt> converted_io_args;
 
   // for function calls: the function that is called
   irep_idt called_function;
 
-  // for function calls
-  std::vector<exprt> ssa_function_arguments, converted_function_arguments;
-
   // for SHARED_READ/SHARED_WRITE and ATOMIC_BEGIN/ATOMIC_END
   unsigned atomic_section_id = 0;
 
+  // we may choose to hide
+  bool hidden = false;
+
+  // for INPUT/OUTPUT
+  bool formatted = false;
+
   // for slicing
   bool ignore = false;
 
   // for incremental conversion
   bool converted = false;
 
+  // the expressions only needed for traces have been written to disk, see
+  // symex_target_equationt::spill_converted_steps
+  bool spilled = false;
+
+  // for INPUT/OUTPUT
+  std::list<exprt> io_args;
+  std::list<exprt> converted_io_args;
+
+  // for function calls
+  std::vector<exprt> ssa_function_arguments, converted_function_arguments;
+
   SSA_stept(
     const symex_targett::sourcet &_source,
     goto_trace_stept::typet _type)
     : source(_source),
       type(_type),
-      hidden(false),
+      assignment_type(symex_targett::assignment_typet::STATE),
       guard(static_cast<const exprt &>(get_nil_irep())),
       guard_handle(false_exprt()),
       ssa_lhs(static_cast<const ssa_exprt &>(get_nil_irep())),
       ssa_full_lhs(static_cast<const exprt &>(get_nil_irep())),
       original_full_lhs(static_cast<const exprt &>(get_nil_irep())),
       ssa_rhs(static_cast<const exprt &>(get_nil_irep())),
-      assignment_type(symex_targett::assignment_typet::STATE),
       cond_expr(static_cast<const exprt &>(get_nil_irep())),
       cond_handle(false_exprt()),
-      formatted(false),
       atomic_section_id(0),
+      hidden(false),
+      formatted(false),
       ignore(false)
   {
   }
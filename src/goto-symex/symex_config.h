@@ -63,6 +63,19 @@ struct symex_configt final
   ///   Used in goto_symext::dereference_rec
   bool cache_dereferences;
 
+  /// \brief Maximum number of expressions whose simplified form is
+  ///   memoized during symex; 0 disables memoization.
+  std::size_t simplify_cache_size;
+
+  /// \brief Maximum number of compound expressions whose level-2 renaming
+  ///   is memoized during symex; 0 disables memoization.
+  std::size_t rename_cache_size;
+
+  /// \brief Whether to replace calls of functions without side effects on
+  ///   constant arguments by the result of an earlier such call.
+  ///   See \ref symex_function_summariest
+  bool function_summaries;
+
   /// \brief Construct a symex_configt using options specified in an
   /// \ref optionst
   explicit symex_configt(const optionst &options);
@@ -38,6 +38,7 @@ void goto_symext::symex_dead(statet &state, const symbol_exprt &symbol_expr)
     // instance can no longer appear.
     state.value_set.values.erase_if_exists(l1_identifier);
     state.propagation.erase_if_exists(l1_identifier);
+    state.erase_propagated_elements(l1_identifier);
     // Remove from the local L2 renaming map; this means any reads from the dead
     // identifier will use generation 0 (e.g. x!N@M#0, where N and M are
     // positive integers), which is never defined by any write, and will be
@@ -27,6 +27,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "symex_assign.h"
 #include "symex_dereference_state.h"
 
+#include <algorithm>
+
 /// Transforms an lvalue expression by replacing any dereference operations it
 /// contains with explicit references to the objects they may point to (using
 /// \ref goto_symext::dereference_rec), and translates `byte_extract,` `member`
@@ -318,18 +320,67 @@ void goto_symext::dereference_rec(
     // we need to set up some elaborate call-backs
     symex_dereference_statet symex_dereference_state(state, ns);
 
-    value_set_dereferencet dereference(
-      ns,
-      state.symbol_table,
-      symex_dereference_state,
-      language_mode,
-      expr_is_not_null,
-      log);
+    ++dereference_statistics.dereferences;
+
+    // With dereference caching, reuse the result of an earlier dereference of
+    // the same pointer when all the value sets it was computed from are
+    // unchanged, as is typically the case in later iterations of a loop.
+    const bool use_cache = value_set_dereference_cache.enabled() &&
+                           !symex_config.show_points_to_sets;
+    const symex_dereference_cachet::entryt *cached =
+      use_cache ? value_set_dereference_cache.find(tmp1, expr_is_not_null)
+                : nullptr;
+
+    exprt tmp2;
 
-    // std::cout << "**** " << format(tmp1) << '\n';
-    exprt tmp2 =
-      dereference.dereference(tmp1, symex_config.show_points_to_sets);
-    // std::cout << "**** " << format(tmp2) << '\n';
+    if(
+      cached != nullptr &&
+      symex_dereference_state.dependencies_hold(cached->dependencies))
+    {
+      ++value_set_dereference_cache.hits;
+      tmp2 = cached->result;
+    }
+    else
+    {
+      if(use_cache)
+        ++value_set_dereference_cache.misses;
+
+      dereference_dependenciest dependencies;
+      if(use_cache)
+        symex_dereference_state.record_dependencies(&dependencies);
+
+      value_set_dereferencet dereference(
+        ns,
+        state.symbol_table,
+        symex_dereference_state,
+        language_mode,
+        expr_is_not_null,
+        log);
+
+      // std::cout << "**** " << format(tmp1) << '\n';
+      tmp2 = dereference.dereference(tmp1, symex_config.show_points_to_sets);
+      // std::cout << "**** " << format(tmp2) << '\n';
+
+      symex_dereference_state.record_dependencies(nullptr);
+
+      // Results that introduced fresh symbols (let binders or failed objects
+      // created by value_set_dereferencet) must not be shared between
+      // dereferences.
+      const bool fresh_symbols =
+        has_subexpr(tmp2, ID_let) ||
+        std::any_of(
+          dependencies.failed_symbols.begin(),
+          dependencies.failed_symbols.end(),
+          [](const std::pair<exprt, irep_idt> &failed_symbol) {
+            return failed_symbol.second.empty();
+          });
+
+      if(use_cache && !fresh_symbols)
+      {
+        value_set_dereference_cache.insert(
+          tmp1, expr_is_not_null, tmp2, std::move(dependencies));
+      }
+    }
 
 
     // this may yield a new auto-object
@@ -489,7 +540,10 @@ void goto_symext::dereference(exprt &expr, statet &state, bool write)
   });
 
   // start the recursion!
+  const auto dereference_start = std::chrono::steady_clock::now();
   dereference_rec(expr, state, write, false);
+  dereference_statistics.runtime +=
+    std::chrono::steady_clock::now() - dereference_start;
   // dereferencing may introduce new symbol_exprt
   // (like __CPROVER_memory)
   expr = state.rename<L1>(std::move(expr), ns).get();
@@ -0,0 +1,59 @@
+/*******************************************************************\
+
+Module: Symbolic Execution
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Memoization of value-set dereferencing
+
+#include "symex_dereference_cache.h"
+
+const symex_dereference_cachet::entryt *
+symex_dereference_cachet::find(const exprt &pointer, bool is_not_null)
+{
+  const keyt key{pointer, is_not_null};
+
+  auto it = current.find(key);
+  if(it != current.end())
+    return &it->second;
+
+  auto previous_it = previous.find(key);
+  if(previous_it == previous.end())
+    return nullptr;
+
+  // promote to the current generation so that the entry survives the next
+  // generation change
+  entryt entry = std::move(previous_it->second);
+  previous.erase(previous_it);
+  insert(
+    pointer,
+    is_not_null,
+    std::move(entry.result),
+    std::move(entry.dependencies));
+
+  return &current.at(key);
+}
+
+void symex_dereference_cachet::insert(
+  const exprt &pointer,
+  bool is_not_null,
+  exprt result,
+  dereference_dependenciest dependencies)
+{
+  if(!enabled())
+    return;
+
+  if(current.size() >= (max_entries + 1) / 2)
+  {
+    evictions += previous.size();
+    previous = std::move(current);
+    current.clear();
+  }
+
+  entryt &entry = current[keyt{pointer, is_not_null}];
+  entry.result = std::move(result);
+  entry.dependencies = std::move(dependencies);
+}
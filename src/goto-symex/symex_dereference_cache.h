@@ -0,0 +1,105 @@
+/*******************************************************************\
+
+Module: Symbolic Execution
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Memoization of value-set dereferencing
+
+#ifndef CPROVER_GOTO_SYMEX_SYMEX_DEREFERENCE_CACHE_H
+#define CPROVER_GOTO_SYMEX_SYMEX_DEREFERENCE_CACHE_H
+
+#include <util/expr.h>
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// What value_set_dereferencet looked up in the state of symex while
+/// dereferencing a pointer. Dereferencing the same pointer again yields the
+/// same result as long as all lookups yield the same values.
+struct dereference_dependenciest
+{
+  /// Pointer expressions (L1) and their value sets
+  std::vector<std::pair<exprt, std::vector<exprt>>> value_sets;
+  /// Pointer expressions and the names of their failed symbols, or empty if
+  /// they had none
+  std::vector<std::pair<exprt, irep_idt>> failed_symbols;
+};
+
+/// A size-bounded cache mapping pointers (L1) to the result of dereferencing
+/// them with value_set_dereferencet, together with the lookups the result
+/// depended on.
+///
+/// Entries are held in two generations, as in rename_cachet. As the
+/// dependencies include the value sets of all pointers involved, an entry
+/// remains usable across merges of states and across loop iterations for as
+/// long as these pointers are not written to.
+class symex_dereference_cachet
+{
+public:
+  struct entryt
+  {
+    exprt result;
+    dereference_dependenciest dependencies;
+  };
+
+  /// \param max_entries: maximum number of cached pointers; 0 disables the
+  ///   cache
+  explicit symex_dereference_cachet(std::size_t max_entries)
+    : max_entries(max_entries)
+  {
+  }
+
+  bool enabled() const
+  {
+    return max_entries != 0;
+  }
+
+  /// Look up the dereference of \p pointer, where \p is_not_null states
+  /// whether the pointer is known not to be null
+  /// \return nullptr if not cached
+  const entryt *find(const exprt &pointer, bool is_not_null);
+
+  /// Record that dereferencing \p pointer yields \p result, computed with the
+  /// lookups \p dependencies
+  void insert(
+    const exprt &pointer,
+    bool is_not_null,
+    exprt result,
+    dereference_dependenciest dependencies);
+
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  std::size_t evictions = 0;
+
+protected:
+  typedef std::pair<exprt, bool> keyt;
+
+  struct key_hasht
+  {
+    std::size_t operator()(const keyt &key) const
+    {
+      return key.first.hash() * 2 + (key.second ? 1 : 0);
+    }
+  };
+
+  struct key_equalt
+  {
+    bool operator()(const keyt &a, const keyt &b) const
+    {
+      return a.second == b.second && a.first.full_eq(b.first);
+    }
+  };
+
+  using containert = std::unordered_map<keyt, entryt, key_hasht, key_equalt>;
+
+  std::size_t max_entries;
+  containert current;
+  containert previous;
+};
+
+#endif // CPROVER_GOTO_SYMEX_SYMEX_DEREFERENCE_CACHE_H
@@ -29,6 +29,20 @@ Author: Daniel Kroening, kroening@kroening.com
 /// \return pointer to the failed symbol for \p expr, or nullptr if none
 const symbolt *
 symex_dereference_statet::get_or_create_failed_symbol(const exprt &expr)
+{
+  const symbolt *symbol = lookup_failed_symbol(expr);
+
+  if(recorded_dependencies != nullptr)
+  {
+    recorded_dependencies->failed_symbols.emplace_back(
+      expr, symbol == nullptr ? irep_idt() : symbol->name);
+  }
+
+  return symbol;
+}
+
+/// Implements \ref get_or_create_failed_symbol without recording
+const symbolt *symex_dereference_statet::lookup_failed_symbol(const exprt &expr)
 {
   if(is_ssa_expr(expr))
   {
@@ -76,9 +90,33 @@ symex_dereference_statet::get_or_create_failed_symbol(const exprt &expr)
   return nullptr;
 }
 
-/// Just forwards a value-set query to `state.value_set`
+/// Forwards a value-set query to `state.value_set`, recording it if requested
 std::vector<exprt>
 symex_dereference_statet::get_value_set(const exprt &expr) const
 {
-  return state.value_set.get_value_set(expr, ns);
+  std::vector<exprt> value_set = state.value_set.get_value_set(expr, ns);
+
+  if(recorded_dependencies != nullptr)
+    recorded_dependencies->value_sets.emplace_back(expr, value_set);
+
+  return value_set;
+}
+
+bool symex_dereference_statet::dependencies_hold(
+  const dereference_dependenciest &dependencies)
+{
+  for(const auto &entry : dependencies.value_sets)
+  {
+    if(state.value_set.get_value_set(entry.first, ns) != entry.second)
+      return false;
+  }
+
+  for(const auto &entry : dependencies.failed_symbols)
+  {
+    const symbolt *symbol = lookup_failed_symbol(entry.first);
+    if((symbol == nullptr ? irep_idt() : symbol->name) != entry.second)
+      return false;
+  }
+
+  return true;
 }
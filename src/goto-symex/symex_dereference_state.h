@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <pointer-analysis/dereference_callback.h>
 
 #include "goto_symex.h"
+#include "symex_dereference_cache.h"
 
 /// Callback object that \ref goto_symext::dereference_rec provides to
 /// \ref value_set_dereferencet to provide value sets (from goto-symex's
@@ -30,13 +31,27 @@ public:
   {
   }
 
+  /// Record all value-set and failed-symbol lookups in \p dependencies from
+  /// now on, or stop recording if \p dependencies is nullptr
+  void record_dependencies(dereference_dependenciest *dependencies)
+  {
+    recorded_dependencies = dependencies;
+  }
+
+  /// \return true if all lookups in \p dependencies yield the same results
+  ///   in the current state
+  bool dependencies_hold(const dereference_dependenciest &dependencies);
+
 protected:
   goto_symext::statet &state;
   const namespacet &ns;
+  dereference_dependenciest *recorded_dependencies = nullptr;
 
   std::vector<exprt> get_value_set(const exprt &expr) const override;
 
   const symbolt *get_or_create_failed_symbol(const exprt &expr) override;
+
+  const symbolt *lookup_failed_symbol(const exprt &expr);
 };
 
 #endif // CPROVER_GOTO_SYMEX_SYMEX_DEREFERENCE_STATE_H
@@ -20,6 +20,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/prefix.h>
 #include <util/range.h>
 
+#include <goto-programs/remove_returns.h>
+
 #include "expr_skeleton.h"
 #include "path_storage.h"
 #include "symex_assign.h"
@@ -309,6 +311,30 @@ void goto_symext::symex_function_call_code(
     return;
   }
 
+  optionalt<exprt::operandst> summary_arguments = get_summary_arguments(
+    state, identifier, goto_function, call, renamed_arguments);
+
+  if(summary_arguments.has_value())
+  {
+    const exprt *return_value =
+      function_summaries.find(identifier, *summary_arguments);
+
+    if(return_value != nullptr)
+    {
+      target.function_return(
+        state.guard.as_expr(), identifier, state.source, hidden);
+
+      if(return_value->is_not_nil())
+      {
+        symex_assign(
+          state, return_value_symbol(identifier, ns), *return_value);
+      }
+
+      symex_transition(state);
+      return;
+    }
+  }
+
   // produce a new frame
   PRECONDITION(!state.call_stack().empty());
   framet &frame = state.call_stack().new_frame(state.source, state.guard);
@@ -331,6 +357,8 @@ void goto_symext::symex_function_call_code(
   frame.return_value=call.lhs();
   frame.function_identifier=identifier;
   frame.hidden_function = goto_function.is_hidden();
+  frame.summary_arguments = std::move(summary_arguments);
+  frame.summary_first_step = target.SSA_steps.size();
 
   const framet &p_frame = state.call_stack().previous_frame();
   for(const auto &pair : p_frame.loop_iterations)
@@ -347,6 +375,82 @@ void goto_symext::symex_function_call_code(
   symex_transition(state, goto_function.body.instructions.begin(), false);
 }
 
+optionalt<exprt::operandst> goto_symext::get_summary_arguments(
+  const statet &state,
+  const irep_idt &function_id,
+  const goto_functionst::goto_functiont &goto_function,
+  const code_function_callt &call,
+  const std::vector<renamedt<exprt, L2>> &arguments)
+{
+  // other threads may change what the callee computes
+  if(
+    !symex_config.function_summaries || state.threads.size() != 1 ||
+    call.lhs().is_not_nil() ||
+    arguments.size() != goto_function.parameter_identifiers.size())
+  {
+    return {};
+  }
+
+  exprt::operandst constant_arguments;
+  constant_arguments.reserve(arguments.size());
+
+  for(const auto &argument : arguments)
+  {
+    if(!argument.get().is_constant())
+      return {};
+
+    constant_arguments.push_back(argument.get());
+  }
+
+  if(!function_summaries.can_summarise(function_id, goto_function))
+    return {};
+
+  return std::move(constant_arguments);
+}
+
+void goto_symext::record_function_summary(statet &state)
+{
+  const framet &frame = state.call_stack().top();
+
+  if(
+    !frame.summary_arguments.has_value() || !state.reachable ||
+    state.guard.as_expr() != frame.guard_at_function_start.as_expr())
+  {
+    return;
+  }
+
+  // the summary only replaces assignments; any other step, such as a
+  // failed unwinding of a loop, makes the call depend on its context
+  for(auto step_it = target.get_SSA_step(frame.summary_first_step);
+      step_it != target.SSA_steps.end();
+      ++step_it)
+  {
+    if(
+      !step_it->is_assignment() && !step_it->is_location() &&
+      !step_it->is_decl() && !step_it->is_function_call() &&
+      !step_it->is_function_return())
+    {
+      return;
+    }
+  }
+
+  exprt return_value = nil_exprt();
+
+  const symbolt *symbol;
+  if(!ns.lookup(return_value_identifier(frame.function_identifier), symbol))
+  {
+    return_value = state.rename(symbol->symbol_expr(), ns).get();
+
+    if(!return_value.is_constant())
+      return;
+  }
+
+  function_summaries.insert(
+    frame.function_identifier,
+    *frame.summary_arguments,
+    std::move(return_value));
+}
+
 /// pop one call frame
 static void pop_frame(
   goto_symext::statet &state,
@@ -406,6 +510,8 @@ void goto_symext::symex_end_of_function(statet &state)
   target.function_return(
     state.guard.as_expr(), state.source.function_id, state.source, hidden);
 
+  record_function_summary(state);
+
   // then get rid of the frame
   pop_frame(state, path_storage, symex_config.doing_path_exploration);
 }
@@ -0,0 +1,132 @@
+/*******************************************************************\
+
+Module: Symbolic Execution
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Summaries of Function Calls
+
+#include "symex_function_summaries.h"
+
+#include <unordered_set>
+
+#include <util/expr_iterator.h>
+#include <util/std_expr.h>
+
+#include <goto-programs/remove_returns.h>
+
+/// \return true if \p expr only refers to the objects \p locals, and has
+///   none of the constructs that make the value of an expression depend on
+///   more than the values of these objects
+static bool refers_to_locals_only(
+  const exprt &expr,
+  const std::unordered_set<irep_idt> &locals)
+{
+  for(auto it = expr.depth_cbegin(); it != expr.depth_cend(); ++it)
+  {
+    if(it->id() == ID_symbol)
+    {
+      if(locals.find(to_symbol_expr(*it).get_identifier()) == locals.end())
+        return false;
+    }
+    else if(
+      it->id() == ID_dereference || it->id() == ID_address_of ||
+      it->id() == ID_side_effect || it->id() == ID_nondet_symbol)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool symex_function_summariest::can_summarise(
+  const irep_idt &function_id,
+  const goto_functiont &goto_function)
+{
+  auto entry = summarisable.emplace(function_id, false);
+  if(!entry.second)
+    return entry.first->second;
+
+  std::unordered_set<irep_idt> locals(
+    goto_function.parameter_identifiers.begin(),
+    goto_function.parameter_identifiers.end());
+  locals.insert(return_value_identifier(function_id));
+
+  for(const auto &instruction : goto_function.body.instructions)
+  {
+    if(instruction.is_decl())
+      locals.insert(instruction.decl_symbol().get_identifier());
+  }
+
+  for(const auto &instruction : goto_function.body.instructions)
+  {
+    switch(instruction.type)
+    {
+    case SKIP:
+    case LOCATION:
+    case END_FUNCTION:
+    case GOTO:
+    case ASSIGN:
+    case DECL:
+    case DEAD:
+    case ASSERT:
+    case ASSUME:
+      break;
+
+    case NO_INSTRUCTION_TYPE:
+    case OTHER:
+    case START_THREAD:
+    case END_THREAD:
+    case ATOMIC_BEGIN:
+    case ATOMIC_END:
+    case RETURN:
+    case FUNCTION_CALL:
+    case THROW:
+    case CATCH:
+    case INCOMPLETE_GOTO:
+      return false;
+    }
+
+    bool local = true;
+    instruction.apply([&local, &locals](const exprt &expr) {
+      local = local && refers_to_locals_only(expr, locals);
+    });
+
+    if(!local)
+      return false;
+  }
+
+  entry.first->second = true;
+  return true;
+}
+
+const exprt *symex_function_summariest::find(
+  const irep_idt &function_id,
+  const exprt::operandst &arguments)
+{
+  const auto summary_it = summaries.find(function_id);
+  if(summary_it != summaries.end())
+  {
+    const auto entry = summary_it->second.find(arguments);
+    if(entry != summary_it->second.end())
+    {
+      ++hits;
+      return &entry->second;
+    }
+  }
+
+  ++misses;
+  return nullptr;
+}
+
+void symex_function_summariest::insert(
+  const irep_idt &function_id,
+  exprt::operandst arguments,
+  exprt return_value)
+{
+  summaries[function_id].emplace(std::move(arguments), std::move(return_value));
+}
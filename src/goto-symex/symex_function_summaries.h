@@ -0,0 +1,64 @@
+/*******************************************************************\
+
+Module: Symbolic Execution
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Summaries of Function Calls
+
+#ifndef CPROVER_GOTO_SYMEX_SYMEX_FUNCTION_SUMMARIES_H
+#define CPROVER_GOTO_SYMEX_SYMEX_FUNCTION_SUMMARIES_H
+
+#include <goto-programs/goto_function.h>
+
+#include <map>
+#include <unordered_map>
+
+/// Results of calls of functions without side effects on constant arguments.
+///
+/// A function can be summarised if all it does is compute its return value
+/// from its parameters and local variables: it must not call functions,
+/// dereference pointers, take addresses, use side effects such as
+/// nondeterministic values or allocation, or refer to any object other than
+/// its parameters, its locals and its return value. When such a function is
+/// called on constant arguments, symbolic execution of its body with
+/// constant propagation yields the same steps and the same return value at
+/// every call site, so the return value of the first call can be assigned
+/// directly at the later ones.
+class symex_function_summariest
+{
+public:
+  /// \return true if calls of the function \p function_id with body
+  ///   \p goto_function can be summarised
+  bool can_summarise(
+    const irep_idt &function_id,
+    const goto_functiont &goto_function);
+
+  /// \return the return value recorded for a call of \p function_id on
+  ///   \p arguments, which is nil for functions without return value, or
+  ///   nullptr if there is none
+  const exprt *
+  find(const irep_idt &function_id, const exprt::operandst &arguments);
+
+  /// Record that a call of \p function_id on \p arguments yields
+  /// \p return_value, which must be constant or nil
+  void insert(
+    const irep_idt &function_id,
+    exprt::operandst arguments,
+    exprt return_value);
+
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+
+protected:
+  /// Whether the functions analysed so far can be summarised
+  std::unordered_map<irep_idt, bool> summarisable;
+
+  typedef std::map<exprt::operandst, exprt> summaryt;
+  std::unordered_map<irep_idt, summaryt> summaries;
+};
+
+#endif // CPROVER_GOTO_SYMEX_SYMEX_FUNCTION_SUMMARIES_H
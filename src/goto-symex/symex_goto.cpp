@@ -624,12 +624,17 @@ void goto_symext::merge_gotos(statet &state)
   // we need to merge
   framet::goto_state_listt &state_list = state_map_it->second;
 
+  const auto merge_start = std::chrono::steady_clock::now();
+
   for(auto list_it = state_list.rbegin(); list_it != state_list.rend();
       ++list_it)
   {
     merge_goto(list_it->first, std::move(list_it->second), state);
   }
 
+  merge_statistics.merges += state_list.size();
+  merge_statistics.runtime += std::chrono::steady_clock::now() - merge_start;
+
   // clean up to save some memory
   frame.goto_state_map.erase(state_map_it);
 }
@@ -856,9 +861,16 @@ void goto_symext::phi_function(
   // this gets the diff between the guards
   diff_guard -= dest_state.guard;
 
-  symex_renaming_levelt::delta_viewt delta_view;
-  goto_state.get_level2().current_names.get_delta_view(
-    dest_state.get_level2().current_names, delta_view, false);
+  // A single traversal of both renaming maps yields the names whose counters
+  // may differ; subtrees shared between the maps are skipped entirely, and
+  // so are names with the same counter in both.
+  symex_level2t::current_namest::delta_viewt delta_view;
+  symex_level2t::current_namest::delta_viewt dest_only_delta_view;
+  goto_state.get_level2().current_names.get_symmetric_delta_view(
+    dest_state.get_level2().current_names, delta_view, dest_only_delta_view);
+
+  merge_statistics.merged_names +=
+    delta_view.size() + dest_only_delta_view.size();
 
   for(const auto &delta_item : delta_view)
   {
@@ -882,15 +894,8 @@ void goto_symext::phi_function(
       dest_count);
   }
 
-  delta_view.clear();
-  dest_state.get_level2().current_names.get_delta_view(
-    goto_state.get_level2().current_names, delta_view, false);
-
-  for(const auto &delta_item : delta_view)
+  for(const auto &delta_item : dest_only_delta_view)
   {
-    if(delta_item.is_in_both_maps())
-      continue;
-
     const ssa_exprt &ssa = delta_item.m.first;
     unsigned goto_count = 0;
     unsigned dest_count = delta_item.m.second;
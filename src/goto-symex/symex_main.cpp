@@ -21,7 +21,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/format.h>
 #include <util/format_expr.h>
 #include <util/invariant.h>
+#include <util/magic.h>
 #include <util/make_unique.h>
+#include <util/phase_profile.h>
 #include <util/mathematical_expr.h>
 #include <util/replace_symbol.h>
 #include <util/std_expr.h>
@@ -56,7 +58,16 @@ symex_configt::symex_configt(const optionst &options)
             : DEFAULT_MAX_FIELD_SENSITIVITY_ARRAY_SIZE),
     complexity_limits_active(
       options.get_signed_int_option("symex-complexity-limit") > 0),
-    cache_dereferences{options.get_bool_option("symex-cache-dereferences")}
+    cache_dereferences{options.get_bool_option("symex-cache-dereferences")},
+    simplify_cache_size(
+      options.is_set("symex-simplify-cache-size")
+        ? options.get_unsigned_int_option("symex-simplify-cache-size")
+        : DEFAULT_SYMEX_SIMPLIFY_CACHE_SIZE),
+    rename_cache_size(
+      options.is_set("symex-rename-cache-size")
+        ? options.get_unsigned_int_option("symex-rename-cache-size")
+        : DEFAULT_SYMEX_RENAME_CACHE_SIZE),
+    function_summaries(options.get_bool_option("symex-function-summaries"))
 {
 }
 
@@ -120,6 +131,10 @@ void symex_transition(
     // Only do this if we have active loop analysis going.
     if(!frame.active_loops.empty())
     {
+      // Count the iterations of the innermost loop.
+      if(is_backwards_goto && frame.active_loops.back().loop.contains(to))
+        ++frame.active_loops.back().iterations;
+
       // Otherwise if we find we're transitioning out of a loop, make sure
       // to remove any loops we're not currently iterating over.
 
@@ -327,6 +342,8 @@ void goto_symext::symex_with_state(
   const get_goto_functiont &get_goto_function,
   symbol_tablet &new_symbol_table)
 {
+  phase_profile_scopet phase_profile_scope("symex");
+
   // resets the namespace to only wrap a single symbol table, and does so upon
   // destruction of an object of this type; instantiating the type is thus all
   // that's needed to achieve a reset upon exiting this method
@@ -358,6 +375,10 @@ void goto_symext::symex_with_state(
   // as state.symbol_table might go out of scope
   reset_namespacet reset_ns(ns);
 
+  // results memoized for a previous state may refer to symbols that are not
+  // part of this state's symbol table
+  simplifier.clear_cache();
+
   PRECONDITION(state.call_stack().top().end_of_function->is_end_function());
 
   symex_threaded_step(state, get_goto_function);
@@ -372,6 +393,51 @@ void goto_symext::symex_with_state(
       return;
   }
 
+  const simplify_expr_cachet &simplifier_cache = simplifier.get_cache();
+  if(simplifier_cache.enabled() && simplifier_cache.hits != 0)
+  {
+    log.statistics() << "Simplifier cache: " << simplifier_cache.hits
+                     << " hits, " << simplifier_cache.misses << " misses, "
+                     << simplifier_cache.evictions << " evictions"
+                     << messaget::eom;
+  }
+
+  if(state.rename_cache.enabled())
+  {
+    const rename_cachet &cache = state.rename_cache;
+    log.debug() << "Rename cache: " << cache.hits << " hits, " << cache.misses
+                << " misses, " << cache.evictions << " evictions"
+                << messaget::eom;
+  }
+
+  if(symex_config.function_summaries)
+  {
+    log.statistics() << "Function summaries: " << function_summaries.hits
+                     << " hits, " << function_summaries.misses << " misses"
+                     << messaget::eom;
+  }
+
+  if(dereference_statistics.dereferences != 0)
+  {
+    log.statistics() << "Dereferenced " << dereference_statistics.dereferences
+                     << " pointers";
+    if(value_set_dereference_cache.enabled())
+    {
+      log.statistics() << " (" << value_set_dereference_cache.hits
+                       << " from the cache)";
+    }
+    log.statistics() << " in " << dereference_statistics.runtime.count()
+                     << "s" << messaget::eom;
+  }
+
+  if(merge_statistics.merges != 0)
+  {
+    log.statistics() << "Merged " << merge_statistics.merges << " states ("
+                     << merge_statistics.merged_names << " names) in "
+                     << merge_statistics.runtime.count() << "s"
+                     << messaget::eom;
+  }
+
   // Clients may need to construct a namespace with both the names in
   // the original goto-program and the names generated during symbolic
   // execution, so return the names generated through symbolic execution
@@ -440,6 +506,7 @@ std::unique_ptr<goto_symext::statet> goto_symext::initialize_entry_point_state(
   state->symex_target = &target;
 
   state->run_validation_checks = symex_config.run_validation_checks;
+  state->rename_cache.set_max_entries(symex_config.rename_cache_size);
 
   // initialize support analyses
   auto emplace_safe_pointers_result =
@@ -655,8 +722,13 @@ void goto_symext::execute_next_instruction(
     break;
 
   case ASSERT:
-    if(state.reachable && !ignore_assertions)
+    if(
+      state.reachable && !ignore_assertions &&
+      decided_properties.find(instruction.source_location.get_property_id()) ==
+        decided_properties.end())
+    {
       symex_assert(instruction, state);
+    }
     symex_transition(state);
     break;
 
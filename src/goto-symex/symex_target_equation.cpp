@@ -13,8 +13,13 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "symex_target_equation.h"
 
 #include <chrono>
+#include <fstream>
 
+#include <util/exception_utils.h>
+#include <util/irep_serialization.h>
+#include <util/memory_info.h>
 #include <util/std_expr.h>
+#include <util/tempfile.h>
 
 #include <solvers/decision_procedure.h>
 #include <solvers/hardness_collector.h>
@@ -42,7 +47,7 @@ void symex_target_equationt::shared_read(
   SSA_step.ssa_lhs=ssa_object;
   SSA_step.atomic_section_id=atomic_section_id;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::shared_write(
@@ -58,7 +63,7 @@ void symex_target_equationt::shared_write(
   SSA_step.ssa_lhs=ssa_object;
   SSA_step.atomic_section_id=atomic_section_id;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 /// spawn a new thread
@@ -70,7 +75,7 @@ void symex_target_equationt::spawn(
   SSA_stept &SSA_step=SSA_steps.back();
   SSA_step.guard=guard;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::memory_barrier(
@@ -81,7 +86,7 @@ void symex_target_equationt::memory_barrier(
   SSA_stept &SSA_step=SSA_steps.back();
   SSA_step.guard=guard;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 /// start an atomic section
@@ -95,7 +100,7 @@ void symex_target_equationt::atomic_begin(
   SSA_step.guard=guard;
   SSA_step.atomic_section_id=atomic_section_id;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 /// end an atomic section
@@ -109,7 +114,7 @@ void symex_target_equationt::atomic_end(
   SSA_step.guard=guard;
   SSA_step.atomic_section_id=atomic_section_id;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::assignment(
@@ -131,7 +136,7 @@ void symex_target_equationt::assignment(
                                               ssa_rhs,
                                               assignment_type});
 
-  merge_ireps(SSA_steps.back());
+  step_added(SSA_steps.back());
 }
 
 void symex_target_equationt::decl(
@@ -156,7 +161,7 @@ void symex_target_equationt::decl(
   // there so we see the symbols
   SSA_step.cond_expr=equal_exprt(SSA_step.ssa_lhs, SSA_step.ssa_lhs);
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 /// declare a fresh variable
@@ -177,7 +182,7 @@ void symex_target_equationt::location(
 
   SSA_step.guard=guard;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::function_call(
@@ -196,7 +201,7 @@ void symex_target_equationt::function_call(
     SSA_step.ssa_function_arguments.emplace_back(arg.get());
   SSA_step.hidden = hidden;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::function_return(
@@ -212,7 +217,7 @@ void symex_target_equationt::function_return(
   SSA_step.called_function = function_id;
   SSA_step.hidden = hidden;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::output(
@@ -229,7 +234,7 @@ void symex_target_equationt::output(
     SSA_step.io_args.emplace_back(arg.get());
   SSA_step.io_id=output_id;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::output_fmt(
@@ -248,7 +253,7 @@ void symex_target_equationt::output_fmt(
   SSA_step.formatted=true;
   SSA_step.format_string=fmt;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::input(
@@ -264,7 +269,7 @@ void symex_target_equationt::input(
   SSA_step.io_args=args;
   SSA_step.io_id=input_id;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::assumption(
@@ -278,7 +283,7 @@ void symex_target_equationt::assumption(
   SSA_step.guard=guard;
   SSA_step.cond_expr=cond;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::assertion(
@@ -294,7 +299,7 @@ void symex_target_equationt::assertion(
   SSA_step.cond_expr=cond;
   SSA_step.comment=msg;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::goto_instruction(
@@ -308,7 +313,7 @@ void symex_target_equationt::goto_instruction(
   SSA_step.guard=guard;
   SSA_step.cond_expr = cond.get();
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::constraint(
@@ -324,7 +329,7 @@ void symex_target_equationt::constraint(
   SSA_step.cond_expr=cond;
   SSA_step.comment=msg;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::convert_without_assertions(
@@ -405,7 +410,11 @@ void symex_target_equationt::convert_guards(
   std::size_t step_index = 0;
   for(auto &step : SSA_steps)
   {
-    if(step.ignore)
+    if(step.converted)
+    {
+      // the guard was converted along with the step
+    }
+    else if(step.ignore)
       step.guard_handle = false_exprt();
     else
     {
@@ -428,7 +437,7 @@ void symex_target_equationt::convert_assumptions(
   std::size_t step_index = 0;
   for(auto &step : SSA_steps)
   {
-    if(step.is_assume())
+    if(step.is_assume() && !step.converted)
     {
       if(step.ignore)
         step.cond_handle = true_exprt();
@@ -456,7 +465,7 @@ void symex_target_equationt::convert_goto_instructions(
   std::size_t step_index = 0;
   for(auto &step : SSA_steps)
   {
-    if(step.is_goto())
+    if(step.is_goto() && !step.converted)
     {
       if(step.ignore)
         step.cond_handle = true_exprt();
@@ -618,29 +627,10 @@ void symex_target_equationt::convert_function_calls(
   std::size_t step_index = 0;
   for(auto &step : SSA_steps)
   {
-    if(!step.ignore)
+    if(!step.ignore && !step.converted)
     {
-      and_exprt::operandst conjuncts;
-      step.converted_function_arguments.reserve(step.ssa_function_arguments.size());
-
-      for(const auto &arg : step.ssa_function_arguments)
-      {
-        if(arg.is_constant() ||
-           arg.id()==ID_string_constant)
-          step.converted_function_arguments.push_back(arg);
-        else
-        {
-          const irep_idt identifier="symex::args::"+std::to_string(argument_count++);
-          symbol_exprt symbol(identifier, arg.type());
-
-          equal_exprt eq(arg, symbol);
-          merge_irep(eq);
-
-          decision_procedure.set_to(eq, true);
-          conjuncts.push_back(eq);
-          step.converted_function_arguments.push_back(symbol);
-        }
-      }
+      const and_exprt::operandst conjuncts =
+        convert_function_call_arguments(decision_procedure, step);
       with_solver_hardness(
         decision_procedure,
         [step_index, &conjuncts, &step](solver_hardnesst &hardness) {
@@ -657,28 +647,10 @@ void symex_target_equationt::convert_io(decision_proceduret &decision_procedure)
   std::size_t step_index = 0;
   for(auto &step : SSA_steps)
   {
-    if(!step.ignore)
+    if(!step.ignore && !step.converted)
     {
-      and_exprt::operandst conjuncts;
-      for(const auto &arg : step.io_args)
-      {
-        if(arg.is_constant() ||
-           arg.id()==ID_string_constant)
-          step.converted_io_args.push_back(arg);
-        else
-        {
-          const irep_idt identifier =
-            "symex::io::" + std::to_string(io_count++);
-          symbol_exprt symbol(identifier, arg.type());
-
-          equal_exprt eq(arg, symbol);
-          merge_irep(eq);
-
-          decision_procedure.set_to(eq, true);
-          conjuncts.push_back(eq);
-          step.converted_io_args.push_back(symbol);
-        }
-      }
+      const and_exprt::operandst conjuncts =
+        convert_io_arguments(decision_procedure, step);
       with_solver_hardness(
         decision_procedure,
         [step_index, &conjuncts, &step](solver_hardnesst &hardness) {
@@ -690,6 +662,131 @@ void symex_target_equationt::convert_io(decision_proceduret &decision_procedure)
   }
 }
 
+exprt::operandst symex_target_equationt::convert_function_call_arguments(
+  decision_proceduret &decision_procedure,
+  SSA_stept &step)
+{
+  exprt::operandst conjuncts;
+  step.converted_function_arguments.reserve(step.ssa_function_arguments.size());
+
+  for(const auto &arg : step.ssa_function_arguments)
+  {
+    if(arg.is_constant() || arg.id() == ID_string_constant)
+      step.converted_function_arguments.push_back(arg);
+    else
+    {
+      const irep_idt identifier =
+        "symex::args::" + std::to_string(argument_count++);
+      symbol_exprt symbol(identifier, arg.type());
+
+      equal_exprt eq(arg, symbol);
+      merge_irep(eq);
+
+      decision_procedure.set_to(eq, true);
+      conjuncts.push_back(eq);
+      step.converted_function_arguments.push_back(symbol);
+    }
+  }
+
+  return conjuncts;
+}
+
+exprt::operandst symex_target_equationt::convert_io_arguments(
+  decision_proceduret &decision_procedure,
+  SSA_stept &step)
+{
+  exprt::operandst conjuncts;
+
+  for(const auto &arg : step.io_args)
+  {
+    if(arg.is_constant() || arg.id() == ID_string_constant)
+      step.converted_io_args.push_back(arg);
+    else
+    {
+      const irep_idt identifier = "symex::io::" + std::to_string(io_count++);
+      symbol_exprt symbol(identifier, arg.type());
+
+      equal_exprt eq(arg, symbol);
+      merge_irep(eq);
+
+      decision_procedure.set_to(eq, true);
+      conjuncts.push_back(eq);
+      step.converted_io_args.push_back(symbol);
+    }
+  }
+
+  return conjuncts;
+}
+
+void symex_target_equationt::stream_to(decision_proceduret &decision_procedure)
+{
+  streaming_decision_procedure = &decision_procedure;
+
+  std::size_t step_index = 0;
+  for(auto &step : SSA_steps)
+  {
+    if(!step.is_assert() && !step.ignore && !step.converted)
+      convert_step(decision_procedure, step, step_index);
+    ++step_index;
+  }
+}
+
+void symex_target_equationt::step_added(SSA_stept &SSA_step)
+{
+  // When streaming, the expressions of the step are released once
+  // converted, which merging would prevent, as merge_irep keeps a copy.
+  if(streaming_decision_procedure == nullptr)
+    merge_ireps(SSA_step);
+  else if(!SSA_step.is_assert())
+  {
+    convert_step(
+      *streaming_decision_procedure, SSA_step, SSA_steps.size() - 1);
+
+    // reading the resident set size is cheap, but not free
+    if(memory_budget != 0 && SSA_steps.size() % 1024 == 0)
+      spill_if_over_budget();
+  }
+}
+
+void symex_target_equationt::convert_step(
+  decision_proceduret &decision_procedure,
+  SSA_stept &step,
+  std::size_t step_index)
+{
+  PRECONDITION(!step.is_assert());
+
+  log.conditional_output(log.debug(), [&step](messaget::mstreamt &mstream) {
+    step.output(mstream);
+    mstream << messaget::eom;
+  });
+
+  step.guard_handle = decision_procedure.handle(step.guard);
+
+  if(step.is_assignment() || step.is_constraint())
+    decision_procedure.set_to_true(step.cond_expr);
+  else if(step.is_decl())
+    decision_procedure.handle(step.cond_expr);
+  else if(step.is_assume() || step.is_goto())
+    step.cond_handle = decision_procedure.handle(step.cond_expr);
+
+  convert_function_call_arguments(decision_procedure, step);
+  convert_io_arguments(decision_procedure, step);
+
+  with_solver_hardness(
+    decision_procedure, hardness_register_ssa(step_index, step));
+
+  step.converted = true;
+
+  // The handle is equivalent to the guard in any model of the decision
+  // procedure. The condition of assignments, declarations and constraints
+  // now holds, while those of assumptions and gotos are shown in traces.
+  step.guard = step.guard_handle;
+  if(step.is_assignment() || step.is_decl() || step.is_constraint())
+    step.cond_expr = true_exprt();
+  step.ssa_function_arguments.clear();
+  step.io_args.clear();
+}
+
 /// Merging causes identical ireps to be shared.
 /// This is only enabled if the definition SHARING is defined.
 /// \param SSA_step The step you want to have shared values.
@@ -721,3 +818,113 @@ void symex_target_equationt::output(std::ostream &out) const
     out << "--------------\n";
   }
 }
+
+void symex_target_equationt::spill_if_over_budget()
+{
+  if(memory_budget == 0)
+    return;
+
+  const std::size_t rss = current_rss();
+  if(rss > memory_budget / 5 * 4)
+  {
+    log.status() << "Resident set of " << rss / (1024 * 1024)
+                 << " MiB approaches the memory budget" << messaget::eom;
+    spill_converted_steps();
+  }
+}
+
+void symex_target_equationt::spill_converted_steps()
+{
+  const std::size_t begin = spill_scan_begin;
+  const std::size_t end = SSA_steps.size();
+  spill_scan_begin = end;
+
+  if(!spill_file)
+    spill_file = std::make_shared<temporary_filet>("cbmc_ssa_", ".bin");
+
+  std::ofstream out(
+    (*spill_file)(), std::ios::binary | std::ios::out | std::ios::app);
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt irepconverter(ireps_container);
+
+  std::size_t number_of_spilled_steps = 0;
+  for(auto it = get_SSA_step(begin); it != SSA_steps.end(); ++it)
+  {
+    SSA_stept &step = *it;
+
+    // the handles must be there to solve without the expressions
+    if(
+      step.spilled || step.guard_handle.is_nil() ||
+      (step.is_assert() && !step.converted))
+    {
+      continue;
+    }
+
+    irepconverter.reference_convert(step.guard, out);
+    irepconverter.reference_convert(step.ssa_full_lhs, out);
+    irepconverter.reference_convert(step.original_full_lhs, out);
+    irepconverter.reference_convert(step.ssa_rhs, out);
+    irepconverter.reference_convert(step.cond_expr, out);
+
+    step.guard = nil_exprt();
+    step.ssa_full_lhs = nil_exprt();
+    step.original_full_lhs = nil_exprt();
+    step.ssa_rhs = nil_exprt();
+    step.cond_expr = nil_exprt();
+    step.spilled = true;
+    ++number_of_spilled_steps;
+  }
+
+  if(!out)
+    throw system_exceptiont("failed to write to " + (*spill_file)());
+
+  if(number_of_spilled_steps != 0)
+    spilled_ranges.emplace_back(begin, end);
+
+  log.status() << "Spilled " << number_of_spilled_steps
+               << " steps of the equation to disk" << messaget::eom;
+}
+
+void symex_target_equationt::restore_spilled_steps()
+{
+  if(spilled_ranges.empty())
+    return;
+
+  std::ifstream in((*spill_file)(), std::ios::binary);
+
+  for(const auto &range : spilled_ranges)
+  {
+    // each range has been written by a serialization of its own
+    irep_serializationt::ireps_containert ireps_container;
+    irep_serializationt irepconverter(ireps_container);
+
+    const auto end = get_SSA_step(range.second);
+    for(auto it = get_SSA_step(range.first); it != end; ++it)
+    {
+      SSA_stept &step = *it;
+      if(!step.spilled)
+        continue;
+
+      step.guard =
+        static_cast<const exprt &>(irepconverter.reference_convert(in));
+      step.ssa_full_lhs =
+        static_cast<const exprt &>(irepconverter.reference_convert(in));
+      step.original_full_lhs =
+        static_cast<const exprt &>(irepconverter.reference_convert(in));
+      step.ssa_rhs =
+        static_cast<const exprt &>(irepconverter.reference_convert(in));
+      step.cond_expr =
+        static_cast<const exprt &>(irepconverter.reference_convert(in));
+      step.spilled = false;
+    }
+  }
+
+  if(!in)
+    throw deserialization_exceptiont("failed to read " + (*spill_file)());
+  in.close();
+
+  // the steps may be spilled again, into a new file
+  spilled_ranges.clear();
+  spill_file.reset();
+  spill_scan_begin = 0;
+}
@@ -15,7 +15,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <algorithm>
 #include <iosfwd>
 #include <list>
+#include <memory>
 
+#include <util/chunked_vector.h>
 #include <util/invariant.h>
 #include <util/merge_irep.h>
 #include <util/message.h>
@@ -26,6 +28,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 class decision_proceduret;
 class namespacet;
+class temporary_filet;
 
 /// Inheriting the interface of symex_targett this class represents the SSA
 /// form of the input program as a list of \ref SSA_stept. It further extends
@@ -228,6 +231,50 @@ public:
   /// \param decision_procedure: A handle to a decision procedure interface
   void convert_io(decision_proceduret &decision_procedure);
 
+  /// Convert each step other than assertions to \p decision_procedure as
+  /// soon as it is added to the equation, rather than when calling
+  /// \ref convert, which then only converts the remaining steps. Steps already
+  /// in the equation are converted right away. Once converted, the guard of a
+  /// step is replaced by its handle, and the expressions that are not needed
+  /// to build a trace are released. The equation must not be sliced
+  /// afterwards, as the conversion of steps cannot be undone.
+  /// \param decision_procedure: A handle to a decision procedure interface,
+  ///   which must outlive the equation
+  void stream_to(decision_proceduret &decision_procedure);
+
+  /// \return true if steps are converted as soon as they are added
+  bool is_streaming() const
+  {
+    return streaming_decision_procedure != nullptr;
+  }
+
+  /// Let \ref spill_if_over_budget spill the steps once the resident set
+  /// size of the process exceeds 80% of \p budget bytes. When streaming, this
+  /// is also checked while steps are added.
+  void set_memory_budget(std::size_t budget)
+  {
+    memory_budget = budget;
+  }
+
+  /// Call \ref spill_converted_steps if the resident set size exceeds 80%
+  /// of the memory budget, if any
+  void spill_if_over_budget();
+
+  /// Write the expressions that are only needed to build traces, i.e., the
+  /// guards, left-hand sides, right-hand sides and conditions, of the steps
+  /// added since the last call that have been converted to a temporary file
+  /// and release them. The steps must not be inspected other than through
+  /// their handles until \ref restore_spilled_steps has been called.
+  void spill_converted_steps();
+
+  /// Read back the expressions written by \ref spill_converted_steps
+  void restore_spilled_steps();
+
+  bool has_spilled_steps() const
+  {
+    return !spilled_ranges.empty();
+  }
+
   exprt make_expression() const;
 
   std::size_t count_assertions() const
@@ -246,18 +293,22 @@ public:
       }));
   }
 
-  typedef std::list<SSA_stept> SSA_stepst;
+  /// The steps are stored in chunks rather than a list: they are only ever
+  /// appended, references to steps thus remain valid, and traversals of the
+  /// equation, such as its conversion, do not chase a pointer per step.
+  typedef chunked_vectort<SSA_stept> SSA_stepst;
   SSA_stepst SSA_steps;
 
+  /// Constraints that hold in every execution but are not converted with the
+  /// equation. The decision procedure only adds those that a model violates,
+  /// solving again until the model satisfies all of them. This is used for
+  /// the constraints of the memory model with `--mm-lazy`.
+  std::vector<exprt> lazy_constraints;
+
   SSA_stepst::iterator get_SSA_step(std::size_t s)
   {
-    SSA_stepst::iterator it=SSA_steps.begin();
-    for(; s!=0; s--)
-    {
-      PRECONDITION(it != SSA_steps.end());
-      it++;
-    }
-    return it;
+    PRECONDITION(s <= SSA_steps.size());
+    return SSA_steps.begin() + narrow_cast<std::ptrdiff_t>(s);
   }
 
   void output(std::ostream &out) const;
@@ -265,6 +316,7 @@ public:
   void clear()
   {
     SSA_steps.clear();
+    lazy_constraints.clear();
   }
 
   bool has_threads() const
@@ -288,6 +340,45 @@ protected:
   merge_irept merge_irep;
   void merge_ireps(SSA_stept &SSA_step);
 
+  /// The decision procedure that steps are converted to as they are added,
+  /// see \ref stream_to
+  decision_proceduret *streaming_decision_procedure = nullptr;
+
+  /// The memory budget in bytes, or 0 for none, see \ref set_memory_budget
+  std::size_t memory_budget = 0;
+
+  /// The steps before this one have been considered for spilling
+  std::size_t spill_scan_begin = 0;
+
+  /// The file holding the spilled expressions, one irep_serializationt
+  /// stream per range in \ref spilled_ranges, in the same order
+  std::shared_ptr<temporary_filet> spill_file;
+  std::vector<std::pair<std::size_t, std::size_t>> spilled_ranges;
+
+  /// Called once \p SSA_step has been added to the equation: the step is
+  /// converted when streaming, and its expressions are merged otherwise
+  void step_added(SSA_stept &SSA_step);
+
+  /// Convert the step \p step, which is not an assertion, at position
+  /// \p step_index, and release the expressions that are no longer needed
+  void convert_step(
+    decision_proceduret &decision_procedure,
+    SSA_stept &step,
+    std::size_t step_index);
+
+  /// Introduce a symbol for each non-constant argument of the function call
+  /// \p step
+  /// \return the equalities between arguments and symbols
+  exprt::operandst convert_function_call_arguments(
+    decision_proceduret &decision_procedure,
+    SSA_stept &step);
+
+  /// Introduce a symbol for each non-constant argument of the I/O \p step
+  /// \return the equalities between arguments and symbols
+  exprt::operandst convert_io_arguments(
+    decision_proceduret &decision_procedure,
+    SSA_stept &step);
+
   // for unique I/O identifiers
   std::size_t io_count = 0;
 
@@ -295,11 +386,4 @@ protected:
   std::size_t argument_count = 0;
 };
 
-inline bool operator<(
-  const symex_target_equationt::SSA_stepst::const_iterator a,
-  const symex_target_equationt::SSA_stepst::const_iterator b)
-{
-  return &(*a)<&(*b);
-}
-
 #endif // CPROVER_GOTO_SYMEX_SYMEX_TARGET_EQUATION_H
@@ -0,0 +1,281 @@
+/*******************************************************************\
+
+Module: Symmetry Breaking for Arrays in Symex Traces
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Symmetry Breaking for Arrays in Symex Traces
+
+#include "symmetry_breaking.h"
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/std_expr.h>
+#include <util/union_find.h>
+
+#include "symex_target_equation.h"
+
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+static bool is_integer_bv(const typet &type)
+{
+  return type.id() == ID_signedbv || type.id() == ID_unsignedbv;
+}
+
+/// \return whether \p expr is an array that the SSA equation does not
+///   define in terms of anything else, which is where its elements could be
+///   interchangeable
+static bool is_array_symbol(const exprt &expr)
+{
+  return (expr.id() == ID_symbol || expr.id() == ID_nondet_symbol) &&
+         expr.type().id() == ID_array;
+}
+
+/// \return the integer symbol that \p expr is, once conversions to types
+///   with at least as many bits are removed: these preserve the values from
+///   0 to the size of any array, and map any other value to another one
+static optionalt<exprt> index_symbol(const exprt &expr)
+{
+  if(!is_integer_bv(expr.type()))
+    return {};
+
+  if(expr.id() == ID_symbol || expr.id() == ID_nondet_symbol)
+    return expr;
+
+  if(expr.id() == ID_typecast)
+  {
+    const exprt &op = to_typecast_expr(expr).op();
+    if(
+      is_integer_bv(op.type()) && to_bitvector_type(expr.type()).get_width() >=
+                                    to_bitvector_type(op.type()).get_width())
+    {
+      return index_symbol(op);
+    }
+  }
+
+  return {};
+}
+
+namespace
+{
+/// Gathers the arrays and index symbols that must be permuted together,
+/// and those that occur in a way that is not invariant under permutations
+class symmetry_detectort
+{
+public:
+  void operator()(const exprt &expr);
+
+  /// Groups of array and index symbols, joined by the reads and equalities
+  /// that they occur in
+  union_find<exprt, irep_hash> groups;
+
+  /// Symbols that occur other than in reads and equalities of a group
+  std::unordered_set<exprt, irep_hash> rejected;
+
+  /// The values that the index symbols are compared with: comparing `i < b`
+  /// or `i >= b` is invariant if b is 0 or the size of the arrays
+  std::vector<std::pair<exprt, mp_integer>> boundaries;
+
+protected:
+  bool add_comparison(
+    const exprt &index,
+    const exprt &constant,
+    bool is_boundary_itself);
+};
+} // namespace
+
+bool symmetry_detectort::add_comparison(
+  const exprt &index,
+  const exprt &constant,
+  bool is_boundary_itself)
+{
+  const auto i = index_symbol(index);
+  if(!i.has_value() || constant.id() != ID_constant)
+    return false;
+
+  const auto value = numeric_cast<mp_integer>(constant);
+  if(!value.has_value())
+    return false;
+
+  // `i <= c` and `i > c` partition the integers where `i < c + 1` does
+  groups.number(*i);
+  boundaries.emplace_back(*i, is_boundary_itself ? *value : *value + 1);
+  return true;
+}
+
+void symmetry_detectort::operator()(const exprt &expr)
+{
+  if(expr.id() == ID_index)
+  {
+    const index_exprt &index_expr = to_index_expr(expr);
+    const auto i = index_symbol(index_expr.index());
+    if(is_array_symbol(index_expr.array()) && i.has_value())
+    {
+      groups.make_union(index_expr.array(), *i);
+      return;
+    }
+  }
+  else if(expr.id() == ID_equal || expr.id() == ID_notequal)
+  {
+    const binary_relation_exprt &relation = to_binary_relation_expr(expr);
+    if(is_array_symbol(relation.lhs()) && is_array_symbol(relation.rhs()))
+    {
+      groups.make_union(relation.lhs(), relation.rhs());
+      return;
+    }
+
+    const auto lhs = index_symbol(relation.lhs());
+    const auto rhs = index_symbol(relation.rhs());
+    if(lhs.has_value() && rhs.has_value())
+    {
+      groups.make_union(*lhs, *rhs);
+      return;
+    }
+  }
+  else if(expr.id() == ID_lt || expr.id() == ID_ge)
+  {
+    const binary_relation_exprt &relation = to_binary_relation_expr(expr);
+    if(
+      add_comparison(relation.lhs(), relation.rhs(), true) ||
+      add_comparison(relation.rhs(), relation.lhs(), false))
+    {
+      return;
+    }
+  }
+  else if(expr.id() == ID_le || expr.id() == ID_gt)
+  {
+    const binary_relation_exprt &relation = to_binary_relation_expr(expr);
+    if(
+      add_comparison(relation.lhs(), relation.rhs(), false) ||
+      add_comparison(relation.rhs(), relation.lhs(), true))
+    {
+      return;
+    }
+  }
+  else if(expr.id() == ID_symbol || expr.id() == ID_nondet_symbol)
+  {
+    rejected.insert(expr);
+    return;
+  }
+
+  for(const auto &op : expr.operands())
+    (*this)(op);
+}
+
+std::size_t break_array_symmetries(symex_target_equationt &equation)
+{
+  symmetry_detectort detector;
+
+  // the step at which each array first occurs, to attribute the constraint
+  std::unordered_map<exprt, const SSA_stept *, irep_hash> first_steps;
+
+  for(const auto &step : equation.SSA_steps)
+  {
+    if(step.ignore)
+      continue;
+
+    const std::size_t known = detector.groups.size();
+
+    detector(step.guard);
+    if(
+      step.is_assignment() || step.is_assume() || step.is_assert() ||
+      step.is_goto() || step.is_constraint())
+    {
+      detector(step.cond_expr);
+    }
+
+    for(std::size_t i = known; i < detector.groups.size(); ++i)
+      first_steps.emplace(detector.groups[i], &step);
+  }
+
+  for(const auto &constraint : equation.lazy_constraints)
+    detector(constraint);
+
+  struct groupt
+  {
+    bool symmetric = true;
+    optionalt<mp_integer> size;
+    std::vector<exprt> arrays;
+  };
+
+  // ordered by the number of the root, for the constraints to be added in
+  // the same order every time
+  std::map<std::size_t, groupt> groups;
+
+  for(std::size_t i = 0; i < detector.groups.size(); ++i)
+  {
+    const exprt &expr = detector.groups[i];
+    groupt &group = groups[detector.groups.find_number(i)];
+
+    if(detector.rejected.count(expr) != 0)
+      group.symmetric = false;
+
+    if(expr.type().id() != ID_array)
+      continue;
+
+    const auto size =
+      numeric_cast<mp_integer>(to_array_type(expr.type()).size());
+    if(!size.has_value() || (group.size.has_value() && *group.size != *size))
+      group.symmetric = false;
+    else
+      group.size = size;
+
+    group.arrays.push_back(expr);
+  }
+
+  for(const auto &boundary : detector.boundaries)
+  {
+    groupt &group = groups[detector.groups.find_number(boundary.first)];
+    if(
+      boundary.second != 0 &&
+      (!group.size.has_value() || boundary.second != *group.size))
+    {
+      group.symmetric = false;
+    }
+  }
+
+  std::size_t count = 0;
+
+  for(const auto &group_pair : groups)
+  {
+    const groupt &group = group_pair.second;
+    if(!group.symmetric || !group.size.has_value() || *group.size < 2)
+      continue;
+
+    // the elements of any array in the group can be ordered, as long as
+    // their type is totally ordered
+    for(const exprt &array : group.arrays)
+    {
+      const typet &element_type = to_array_type(array.type()).subtype();
+      const auto first_step = first_steps.find(array);
+      if(
+        array.id() != ID_symbol || !is_integer_bv(element_type) ||
+        first_step == first_steps.end())
+      {
+        continue;
+      }
+
+      const typet &index_type = to_array_type(array.type()).size().type();
+      exprt::operandst ordered;
+      for(mp_integer i = 1; i < *group.size; ++i)
+      {
+        ordered.push_back(binary_relation_exprt(
+          index_exprt(array, from_integer(i - 1, index_type)),
+          ID_le,
+          index_exprt(array, from_integer(i, index_type))));
+      }
+
+      equation.constraint(
+        conjunction(ordered), "symmetry breaking", first_step->second->source);
+      ++count;
+      break;
+    }
+  }
+
+  return count;
+}
@@ -0,0 +1,37 @@
+/*******************************************************************\
+
+Module: Symmetry Breaking for Arrays in Symex Traces
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Symmetry Breaking for Arrays in Symex Traces
+
+#ifndef CPROVER_GOTO_SYMEX_SYMMETRY_BREAKING_H
+#define CPROVER_GOTO_SYMEX_SYMMETRY_BREAKING_H
+
+#include <cstddef>
+
+class symex_target_equationt;
+
+/// Find the arrays of the \p equation whose elements are interchangeable,
+/// and constrain the elements of one of them in each group that must be
+/// permuted together to be in ascending order.
+///
+/// Elements are interchangeable when the equation reads the arrays only at
+/// indices that are symbols, and uses these symbols only as such indices, in
+/// equalities with each other, and in comparisons with 0 and the size of
+/// the arrays. Then any permutation of the elements of the arrays, applied
+/// to the values of the index symbols as well, turns a model of the equation
+/// into another one, hence it suffices to consider the models in which one
+/// of the arrays is sorted. Arrays that are assigned to element-wise, or
+/// that are read at constant indices, are not interchangeable.
+///
+/// The equation must be complete, as later steps may break the symmetry,
+/// and the values in a trace will be permuted.
+/// \return the number of arrays that were constrained
+std::size_t break_array_symmetries(symex_target_equationt &equation);
+
+#endif // CPROVER_GOTO_SYMEX_SYMMETRY_BREAKING_H
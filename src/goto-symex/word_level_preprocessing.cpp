@@ -0,0 +1,114 @@
+/*******************************************************************\
+
+Module: Word-Level Preprocessing of Symex Traces
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Word-Level Preprocessing of Symex Traces
+
+#include "word_level_preprocessing.h"
+
+#include <util/replace_symbol.h>
+#include <util/simplify_expr.h>
+
+#include "symex_target_equation.h"
+
+#include <unordered_set>
+
+/// \return true if \p rhs may replace the symbol \p lhs, which is the case
+///   for scalar constants and other symbols of the same type
+static bool is_definition(const exprt &lhs, const exprt &rhs)
+{
+  if(lhs.id() != ID_symbol || lhs.type() != rhs.type())
+    return false;
+
+  if(rhs.id() == ID_symbol)
+    return rhs != lhs;
+
+  // compound constants would be copied into every use
+  return rhs.id() == ID_constant && rhs.type().id() != ID_array &&
+         rhs.type().id() != ID_struct && rhs.type().id() != ID_struct_tag &&
+         rhs.type().id() != ID_union && rhs.type().id() != ID_union_tag;
+}
+
+std::size_t word_level_preprocessing(
+  symex_target_equationt &equation,
+  const namespacet &ns)
+{
+  address_of_aware_replace_symbolt definitions;
+
+  // record expr if it is a definition
+  const auto add_definition = [&definitions](const exprt &expr) {
+    if(expr.id() != ID_equal)
+      return false;
+
+    const equal_exprt &equal = to_equal_expr(expr);
+    if(is_definition(equal.lhs(), equal.rhs()))
+      definitions.insert(to_symbol_expr(equal.lhs()), equal.rhs());
+    else if(is_definition(equal.rhs(), equal.lhs()))
+      definitions.insert(to_symbol_expr(equal.rhs()), equal.lhs());
+    else
+      return false;
+
+    return true;
+  };
+
+  // Constraints hold unconditionally, hence also in the steps before them.
+  // Assumptions only constrain the assertions after them and are not used.
+  std::unordered_set<const SSA_stept *> defining_constraints;
+  for(const auto &step : equation.SSA_steps)
+  {
+    if(step.is_constraint() && !step.ignore && add_definition(step.cond_expr))
+      defining_constraints.insert(&step);
+  }
+
+  std::size_t count = 0;
+
+  const auto rewrite = [&definitions, &ns](exprt &expr) {
+    if(definitions.replace(expr))
+      return false;
+
+    expr = simplify_expr(std::move(expr), ns);
+    return true;
+  };
+
+  // The definition of an SSA symbol precedes its uses, hence a single pass
+  // propagates along chains of definitions.
+  for(auto &step : equation.SSA_steps)
+  {
+    if(step.ignore)
+      continue;
+
+    if(!step.converted && !definitions.empty())
+    {
+      bool changed = rewrite(step.guard);
+
+      if(step.is_assignment() && step.cond_expr.id() == ID_equal)
+      {
+        // the left-hand side stays, which keeps its value in the trace
+        if(rewrite(to_equal_expr(step.cond_expr).rhs()))
+          changed = true;
+      }
+      else if(
+        step.is_assume() || step.is_assert() || step.is_goto() ||
+        (step.is_constraint() && defining_constraints.count(&step) == 0))
+      {
+        // defining constraints stay, as do assignments, to keep the values
+        // of the symbols they define
+        if(rewrite(step.cond_expr))
+          changed = true;
+      }
+
+      if(changed)
+        ++count;
+    }
+
+    if(step.is_assignment())
+      add_definition(step.cond_expr);
+  }
+
+  return count;
+}
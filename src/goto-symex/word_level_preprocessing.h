@@ -0,0 +1,29 @@
+/*******************************************************************\
+
+Module: Word-Level Preprocessing of Symex Traces
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Word-Level Preprocessing of Symex Traces
+
+#ifndef CPROVER_GOTO_SYMEX_WORD_LEVEL_PREPROCESSING_H
+#define CPROVER_GOTO_SYMEX_WORD_LEVEL_PREPROCESSING_H
+
+#include <cstddef>
+
+class namespacet;
+class symex_target_equationt;
+
+/// Substitute the symbols that assignments and constraints of the
+/// \p equation define to be a constant or another symbol into the steps
+/// that have not been converted yet, and simplify those steps at word
+/// level, which folds operations, conditions and extracts that become
+/// constant. The defining steps are kept, hence traces are unchanged.
+/// \return the number of steps that were changed
+std::size_t
+word_level_preprocessing(symex_target_equationt &equation, const namespacet &);
+
+#endif // CPROVER_GOTO_SYMEX_WORD_LEVEL_PREPROCESSING_H
@@ -13,6 +13,20 @@ Author: Chris Smowton, chris.smowton@diffblue.com
 #include <util/json.h>
 #include <util/symbol_table.h>
 
+#include <json/json_parser.h>
+
+/// Convert \p json_symbol and add it to \p symbol_table
+static void
+add_symbol_from_json(const jsont &json_symbol, symbol_tablet &symbol_table)
+{
+  symbolt symbol = symbol_from_json(json_symbol);
+
+  if(symbol_table.add(symbol))
+    throw deserialization_exceptiont(
+      "symbol_table_from_json: duplicate symbol name `" +
+      id2string(symbol.name) + "`");
+}
+
 void symbol_table_from_json(const jsont &in, symbol_tablet &symbol_table)
 {
   if(!in.is_object())
@@ -39,16 +53,64 @@ void symbol_table_from_json(const jsont &in, symbol_tablet &symbol_table)
   const json_objectt &json_symbol_table = to_json_object(it->second);
 
   for(const auto &pair : json_symbol_table)
-  {
-    const jsont &json_symbol = pair.second;
+    add_symbol_from_json(pair.second, symbol_table);
+
+  symbol_table.validate(validation_modet::EXCEPTION);
+}
+
+bool parse_json_symbol_table(
+  std::istream &in,
+  const std::string &filename,
+  message_handlert &message_handler,
+  symbol_tablet &symbol_table)
+{
+  bool has_symbol_table = false;
+
+  const auto member_handler =
+    [&](const std::vector<std::string> &keys, jsont &value) {
+      if(keys.front() != "symbolTable")
+        return false;
 
-    symbolt symbol = symbol_from_json(json_symbol);
+      // a member of the symbol table
+      if(keys.size() == 2)
+      {
+        add_symbol_from_json(value, symbol_table);
+        return true;
+      }
 
-    if(symbol_table.add(symbol))
-      throw deserialization_exceptiont(
-        "symbol_table_from_json: duplicate symbol name `" +
-        id2string(symbol.name) + "`");
+      // the symbol table, all of whose members have been dropped
+      if(keys.size() == 1)
+      {
+        if(!value.is_object())
+        {
+          throw deserialization_exceptiont(
+            "symbol_table_from_json: JSON symbol table must be an object");
+        }
+
+        has_symbol_table = true;
+        return true;
+      }
+
+      return false;
+    };
+
+  jsont json;
+  if(parse_json(in, filename, message_handler, member_handler, json))
+    return true;
+
+  if(!json.is_object())
+  {
+    throw deserialization_exceptiont(
+      "symbol_table_from_json: JSON input must be an object");
+  }
+
+  if(!has_symbol_table)
+  {
+    throw deserialization_exceptiont(
+      "symbol_table_from_json: JSON object must have key `symbolTable`");
   }
 
   symbol_table.validate(validation_modet::EXCEPTION);
+
+  return false;
 }
@@ -9,9 +9,24 @@ Author: Chris Smowton, chris.smowton@diffblue.com
 #ifndef CPROVER_JSON_SYMTAB_LANGUAGE_JSON_SYMBOL_TABLE_H
 #define CPROVER_JSON_SYMTAB_LANGUAGE_JSON_SYMBOL_TABLE_H
 
+#include <iosfwd>
+#include <string>
+
 class jsont;
+class message_handlert;
 class symbol_tablet;
 
 void symbol_table_from_json(const jsont &, symbol_tablet &);
 
+/// Parse the JSON symbol table in \p in, of the form read by
+/// \ref symbol_table_from_json, into \p symbol_table. Each symbol is
+/// converted as soon as it has been parsed and then dropped, rather than
+/// first building the JSON value of the whole symbol table.
+/// \return true if \p in is not valid JSON
+bool parse_json_symbol_table(
+  std::istream &in,
+  const std::string &filename,
+  message_handlert &message_handler,
+  symbol_tablet &symbol_table);
+
 #endif
@@ -10,11 +10,13 @@ Author: Chris Smowton, chris.smowton@diffblue.com
 
 #include "json_symtab_language.h"
 #include "json_symbol_table.h"
-#include <json/json_parser.h>
+
+#include <util/exception_utils.h>
 
 #include <linking/linking.h>
 
-/// Parse a goto program in json form.
+/// Parse a goto program in json form, converting the symbols as they are
+/// parsed.
 /// \param instream: The input stream
 /// \param path: A file path
 /// \return boolean signifying success or failure of the parsing
@@ -22,7 +24,16 @@ bool json_symtab_languaget::parse(
   std::istream &instream,
   const std::string &path)
 {
-  return parse_json(instream, path, get_message_handler(), parsed_json_file);
+  try
+  {
+    return parse_json_symbol_table(
+      instream, path, get_message_handler(), parsed_symbol_table);
+  }
+  catch(const deserialization_exceptiont &e)
+  {
+    error() << "parse: " << e.what() << eom;
+    return true;
+  }
 }
 
 /// Typecheck a goto program in json form.
@@ -35,12 +46,9 @@ bool json_symtab_languaget::typecheck(
 {
   (void)module; // unused parameter
 
-  symbol_tablet new_symbol_table;
-
   try
   {
-    symbol_table_from_json(parsed_json_file, new_symbol_table);
-    return linking(symbol_table, new_symbol_table, get_message_handler());
+    return linking(symbol_table, parsed_symbol_table, get_message_handler());
   }
   catch(const std::string &str)
   {
@@ -49,10 +57,10 @@ bool json_symtab_languaget::typecheck(
   }
 }
 
-/// Output the result of the parsed json file to the output stream
+/// Output the symbols of the parsed json file to the output stream
 /// passed as a parameter to this function.
-/// \param out: The stream to use to output the parsed_json_file.
+/// \param out: The stream to use to output the parsed symbols.
 void json_symtab_languaget::show_parse(std::ostream &out)
 {
-  parsed_json_file.output(out);
+  parsed_symbol_table.show(out);
 }
@@ -20,28 +20,8 @@ Author: Peter Schrammel
 
 #include <iostream>
 
-/// Parse commandline options from \p json into \p cmdline
-static void get_json_options(const json_objectt &json, cmdlinet &cmdline)
+void get_json_options(const jsont &options, cmdlinet &cmdline)
 {
-  const jsont &arguments = json["arguments"];
-  if(!arguments.is_array())
-  {
-    throw invalid_command_line_argument_exceptiont(
-      "array expected", "'arguments'");
-  }
-
-  for(const auto &argument : to_json_array(arguments))
-  {
-    if(!argument.is_string())
-    {
-      throw invalid_command_line_argument_exceptiont(
-        "string expected", "argument");
-    }
-
-    cmdline.args.push_back(argument.value);
-  }
-
-  const jsont &options = json["options"];
   if(!options.is_object())
   {
     throw invalid_command_line_argument_exceptiont(
@@ -50,6 +30,9 @@ static void get_json_options(const json_objectt &json, cmdlinet &cmdline)
 
   for(const auto &option_pair : to_json_object(options))
   {
+    if(cmdline.has_option(option_pair.first))
+      cmdline.unset(option_pair.first);
+
     if(option_pair.second.is_string() || option_pair.second.is_number())
     {
       // e.g. --option x
@@ -85,6 +68,54 @@ static void get_json_options(const json_objectt &json, cmdlinet &cmdline)
   }
 }
 
+/// Parse commandline arguments and options from \p json into \p cmdline
+static void get_json_command_line(const json_objectt &json, cmdlinet &cmdline)
+{
+  const jsont &arguments = json["arguments"];
+  if(!arguments.is_array())
+  {
+    throw invalid_command_line_argument_exceptiont(
+      "array expected", "'arguments'");
+  }
+
+  for(const auto &argument : to_json_array(arguments))
+  {
+    if(!argument.is_string())
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "string expected", "argument");
+    }
+
+    cmdline.args.push_back(argument.value);
+  }
+
+  get_json_options(json["options"], cmdline);
+}
+
+json_objectt json_command_line(const cmdlinet &cmdline)
+{
+  json_arrayt arguments;
+  for(const auto &argument : cmdline.args)
+    arguments.push_back(json_stringt{argument});
+
+  json_objectt options;
+  for(const auto &option : cmdline.option_names())
+  {
+    const auto &values = cmdline.get_values(option);
+    if(values.empty())
+      options[option] = json_truet();
+    else
+    {
+      json_arrayt &json_values = options[option].make_array();
+      for(const auto &value : values)
+        json_values.push_back(json_stringt{value});
+    }
+  }
+
+  return json_objectt{{"arguments", std::move(arguments)},
+                      {"options", std::move(options)}};
+}
+
 void json_interface(cmdlinet &cmdline, message_handlert &message_handler)
 {
   if(cmdline.isset("json-interface"))
@@ -101,7 +132,7 @@ void json_interface(cmdlinet &cmdline, message_handlert &message_handler)
           "JSON object expected at top-level", "command-line JSON input");
       }
 
-      get_json_options(to_json_object(json), cmdline);
+      get_json_command_line(to_json_object(json), cmdline);
 
       // Add this so that it gets propagated into optionst;
       // the ui_message_handlert::uit has already been set on the basis
@@ -13,8 +13,19 @@ Author: Peter Schrammel
 #define CPROVER_JSON_JSON_INTERFACE_H
 
 class cmdlinet;
+class json_objectt;
+class jsont;
 class message_handlert;
 
+/// Set the options in the JSON object \p options, in the format of the
+/// `"options"` member shown for \ref json_interface, in \p cmdline,
+/// replacing any values they had
+void get_json_options(const jsont &options, cmdlinet &cmdline);
+
+/// \return the arguments and long options of \p cmdline in the format read
+///   by \ref json_interface
+json_objectt json_command_line(const cmdlinet &cmdline);
+
 /// Parses the JSON-formatted command line from stdin
 ///
 /// Example:
@@ -18,13 +18,35 @@ bool parse_json(
   const std::string &filename,
   message_handlert &message_handler,
   jsont &dest)
+{
+  return parse_json(in, filename, message_handler, nullptr, dest);
+}
+
+bool parse_json(
+  std::istream &in,
+  const std::string &filename,
+  message_handlert &message_handler,
+  json_parsert::member_handlert member_handler,
+  jsont &dest)
 {
   json_parser.clear();
   json_parser.set_file(filename);
   json_parser.in=&in;
   json_parser.set_message_handler(message_handler);
+  json_parser.member_handler = std::move(member_handler);
+
+  bool result;
 
-  bool result=json_parser.parse();
+  try
+  {
+    result = json_parser.parse();
+  }
+  catch(...)
+  {
+    // don't keep what has been parsed so far
+    json_parser.clear();
+    throw;
+  }
 
   // save result
   if(json_parser.stack.size()==1)
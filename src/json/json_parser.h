@@ -10,7 +10,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_JSON_JSON_PARSER_H
 #define CPROVER_JSON_JSON_PARSER_H
 
+#include <functional>
 #include <stack>
+#include <string>
+#include <vector>
 
 #include <util/parser.h>
 #include <util/json.h>
@@ -43,9 +46,32 @@ public:
     stack.pop();
   }
 
+  /// The keys of the members being parsed, of the outermost object first
+  std::vector<std::string> keys;
+
+  /// Called with \ref keys and the value of each member of an object once
+  /// the value has been parsed. Returning true drops the member from its
+  /// object, which allows processing large documents as they are parsed.
+  typedef std::function<bool(const std::vector<std::string> &, jsont &)>
+    member_handlert;
+  member_handlert member_handler;
+
+  /// Add the member whose value has just been parsed to its object
+  void add_member()
+  {
+    jsont value;
+    pop(value);
+    if(!member_handler || !member_handler(keys, value))
+      to_json_object(top())[keys.back()].swap(value);
+    keys.pop_back();
+  }
+
   virtual void clear() override
   {
+    parsert::clear();
     stack=stackt();
+    keys.clear();
+    member_handler = nullptr;
     yyjsonrestart(nullptr);
   }
 };
@@ -61,6 +87,16 @@ bool parse_json(
   message_handlert &message_handler,
   jsont &dest);
 
+/// Parse \p in into \p dest like \ref parse_json, passing the members of
+/// objects to \p member_handler as they are parsed, see
+/// json_parsert::member_handler
+bool parse_json(
+  std::istream &in,
+  const std::string &filename,
+  message_handlert &message_handler,
+  json_parsert::member_handlert member_handler,
+  jsont &dest);
+
 bool parse_json(
   const std::string &filename,
   message_handlert &message_handler,
@@ -106,15 +106,11 @@ key_value_sequence:
 key_value_pair:
           TOK_STRING
         {
-          // we abuse the 'value' to temporarily store the key
-          json_parser.top().value=convert_TOK_STRING();
+          json_parser.keys.push_back(convert_TOK_STRING());
         }
           ':' value
         {
-          jsont tmp;
-          json_parser.pop(tmp);
-          to_json_object(json_parser.top())[json_parser.top().value].swap(tmp);
-          json_parser.top().value.clear(); // end abuse
+          json_parser.add_member();
         }
         ;
 
@@ -405,18 +405,38 @@ bool gdb_apit::run_gdb_to_breakpoint(const std::string &breakpoint)
 
 std::string gdb_apit::eval_expr(const std::string &expr)
 {
+  PRECONDITION(gdb_state == gdb_statet::STOPPED);
+
+  const auto cached = expression_values.find(expr);
+  if(cached != expression_values.end())
+  {
+    if(!cached->second.has_value())
+    {
+      throw gdb_interaction_exceptiont(
+        "could not create variable for expression `" + expr + "`");
+    }
+
+    return *cached->second;
+  }
+
+  // send all commands before reading any reply, which saves waiting for gdb
+  // in between; gdb replies to each command in turn
   write_to_gdb("-var-create tmp * " + expr);
+  write_to_gdb("-var-evaluate-expression tmp");
+  write_to_gdb("-var-delete tmp");
 
   if(!was_command_accepted())
   {
+    // the evaluation and deletion of the variable failed as well
+    read_most_recent_line();
+    read_most_recent_line();
+
+    expression_values.emplace(expr, nullopt);
     throw gdb_interaction_exceptiont(
       "could not create variable for expression `" + expr + "`");
   }
 
-  write_to_gdb("-var-evaluate-expression tmp");
   gdb_output_recordt record = get_most_recent_record("^done", true);
-
-  write_to_gdb("-var-delete tmp");
   check_command_accepted();
 
   const auto it = record.find("value");
@@ -430,6 +450,7 @@ std::string gdb_apit::eval_expr(const std::string &expr)
     "quotes should have been stripped off from value");
   INVARIANT(value.back() != '\n', "value should not end in a newline");
 
+  expression_values.emplace(expr, value);
   return value;
 }
 
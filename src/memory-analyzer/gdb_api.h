@@ -162,6 +162,10 @@ protected:
   /// maps hexadecimal address to the number of bytes
   std::map<std::string, size_t> allocated_memory;
 
+  /// the values of the expressions evaluated so far, or nothing if gdb could
+  /// not evaluate them, which stay the same as long as the program is stopped
+  std::map<std::string, optionalt<std::string>> expression_values;
+
   typedef std::map<std::string, std::string> gdb_output_recordt;
   static gdb_output_recordt parse_gdb_output_record(const std::string &s);
 
@@ -21,10 +21,12 @@ Author: Malte Mues <mail.mues@gmail.com>
 #include <goto-programs/goto_model.h>
 #include <goto-programs/read_goto_binary.h>
 #include <goto-programs/show_symbol_table.h>
+#include <goto-programs/write_goto_binary.h>
 
 #include <langapi/mode.h>
 
 #include <util/config.h>
+#include <util/exception_utils.h>
 #include <util/exit_codes.h>
 #include <util/message.h>
 #include <util/string_utils.h>
@@ -84,13 +86,6 @@ int memory_analyzer_parse_optionst::doit()
   const bool output_file = cmdline.isset("output-file");
   const bool symtab_snapshot = cmdline.isset("symtab-snapshot");
 
-  if(symtab_snapshot && output_file)
-  {
-    throw invalid_command_line_argument_exceptiont(
-      "printing to a file is not supported for symbol table snapshot output",
-      "--symtab-snapshot");
-  }
-
   register_language(new_ansi_c_language);
 
   std::string binary = cmdline.args.front();
@@ -134,13 +129,27 @@ int memory_analyzer_parse_optionst::doit()
 
   if(output_file)
   {
-    file.open(cmdline.get_value("output-file"));
+    file.open(
+      cmdline.get_value("output-file"),
+      symtab_snapshot ? std::ios::binary : std::ios::out);
   }
 
   std::ostream &out =
     output_file ? (std::ostream &)file : (std::ostream &)message.result();
 
-  if(symtab_snapshot)
+  if(symtab_snapshot && output_file)
+  {
+    // a goto binary without any functions, which is much smaller and faster
+    // to read than the symbol table in JSON
+    symbol_tablet snapshot = gdb_value_extractor.get_snapshot_as_symbol_table();
+    if(write_goto_binary(file, snapshot, goto_functionst{}) || !file.flush())
+    {
+      throw system_exceptiont(
+        "failed to write snapshot to '" + cmdline.get_value("output-file") +
+        "'");
+    }
+  }
+  else if(symtab_snapshot)
   {
     symbol_tablet snapshot = gdb_value_extractor.get_snapshot_as_symbol_table();
     show_symbol_table(snapshot, ui_message_handler);
@@ -184,7 +193,8 @@ void memory_analyzer_parse_optionst::help()
     << " --breakpoint <breakpoint>    analyze from breakpoint\n"
     << " --symbols <symbol-list>      list of symbols to analyze\n"
     << " --symtab-snapshot            output snapshot as symbol table\n"
-    << " --output-file <file>         write snapshot to file\n"
+    << " --output-file <file>         write snapshot to file, a goto binary\n"
+    << "                              with --symtab-snapshot\n"
     << " --json-ui                    output snapshot in JSON format\n"
     << messaget::eom;
 }
@@ -0,0 +1,578 @@
+/*******************************************************************\
+
+Module: Field-Insensitive Points-To Analysis with Inclusion Constraints
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Field-Insensitive Points-To Analysis with Inclusion Constraints
+
+#include "andersen_points_to.h"
+
+#include <util/byte_operators.h>
+#include <util/namespace.h>
+#include <util/pointer_expr.h>
+#include <util/std_code.h>
+#include <util/std_expr.h>
+
+#include <algorithm>
+#include <unordered_set>
+
+void andersen_points_tot::operator()(const goto_functionst &goto_functions)
+{
+  for(const auto &gf_entry : goto_functions.function_map)
+    add_function(gf_entry.first, gf_entry.second);
+
+  solve();
+}
+
+void andersen_points_tot::add_function(
+  const irep_idt &function_id,
+  const goto_functionst::goto_functiont &goto_function)
+{
+  if(!goto_function.body_available())
+    return;
+
+  // create the nodes calls are connected to now, as no nodes may be created
+  // while solving
+  for(const auto &identifier : goto_function.parameter_identifiers)
+  {
+    if(!identifier.empty())
+      symbol_node(identifier);
+  }
+  return_node(function_id);
+  parameters[function_id] = goto_function.parameter_identifiers;
+
+  for(const auto &instruction : goto_function.body.instructions)
+    add_instruction(function_id, instruction);
+
+  auto pending = pending_calls.find(function_id);
+  if(pending != pending_calls.end())
+  {
+    const std::vector<std::size_t> calls = std::move(pending->second);
+    pending_calls.erase(pending);
+    for(const auto call_site : calls)
+      connect(call_site, function_id);
+  }
+}
+
+std::vector<exprt> andersen_points_tot::get_values(const exprt &pointer)
+{
+  const node_indext node = value_node(pointer);
+  solve();
+
+  std::vector<exprt> result;
+  for(const auto object : nodes[find(node)].points_to)
+  {
+    if(nodes[object].object.is_not_nil())
+      result.push_back(nodes[object].object);
+  }
+
+  return result;
+}
+
+andersen_points_tot::node_indext andersen_points_tot::new_node(exprt object)
+{
+  nodes.emplace_back(std::move(object), nodes.size());
+  return nodes.size() - 1;
+}
+
+andersen_points_tot::node_indext andersen_points_tot::find(node_indext node)
+{
+  node_indext root = node;
+  while(nodes[root].parent != root)
+    root = nodes[root].parent;
+
+  // path compression
+  while(nodes[node].parent != root)
+  {
+    const node_indext next = nodes[node].parent;
+    nodes[node].parent = root;
+    node = next;
+  }
+
+  return root;
+}
+
+andersen_points_tot::node_indext
+andersen_points_tot::symbol_node(const symbol_exprt &symbol_expr)
+{
+  auto entry = symbol_nodes.find(symbol_expr.get_identifier());
+  if(entry != symbol_nodes.end())
+    return entry->second;
+
+  const node_indext node = new_node(symbol_expr);
+  symbol_nodes.emplace(symbol_expr.get_identifier(), node);
+  return node;
+}
+
+andersen_points_tot::node_indext
+andersen_points_tot::symbol_node(const irep_idt &identifier)
+{
+  auto entry = symbol_nodes.find(identifier);
+  if(entry != symbol_nodes.end())
+    return entry->second;
+
+  const symbolt *symbol;
+  if(!ns.lookup(identifier, symbol))
+    return symbol_node(symbol->symbol_expr());
+  else
+    return symbol_node(symbol_exprt(identifier, typet()));
+}
+
+andersen_points_tot::node_indext
+andersen_points_tot::return_node(const irep_idt &function_id)
+{
+  auto entry = return_nodes.find(function_id);
+  if(entry != return_nodes.end())
+    return entry->second;
+
+  const node_indext node = new_node(nil_exprt());
+  return_nodes.emplace(function_id, node);
+  return node;
+}
+
+void andersen_points_tot::add_rvalue(const exprt &expr, node_indext dest)
+{
+  // Booleans do not carry pointers, not even comparisons of pointers. All
+  // other expressions, including integers that pointers were cast to, may
+  // point to whatever any of their operands point to.
+  if(expr.type().id() == ID_bool)
+    return;
+
+  if(expr.id() == ID_symbol)
+  {
+    // a function designator denotes the function
+    if(expr.type().id() == ID_code)
+      add_object(symbol_node(to_symbol_expr(expr)), dest);
+    else
+      add_edge(symbol_node(to_symbol_expr(expr)), dest);
+  }
+  else if(expr.id() == ID_address_of)
+    add_address(to_address_of_expr(expr).object(), dest);
+  else if(expr.id() == ID_dereference)
+    add_load(value_node(to_dereference_expr(expr).pointer()), dest);
+  else if(expr.id() == ID_member)
+    add_rvalue(to_member_expr(expr).compound(), dest);
+  else if(expr.id() == ID_index)
+    add_rvalue(to_index_expr(expr).array(), dest);
+  else if(expr.id() == ID_if)
+  {
+    add_rvalue(to_if_expr(expr).true_case(), dest);
+    add_rvalue(to_if_expr(expr).false_case(), dest);
+  }
+  else if(
+    expr.id() == ID_side_effect &&
+    to_side_effect_expr(expr).get_statement() == ID_allocate)
+  {
+    // one object for each allocation site
+    dynamic_object_exprt dynamic_object(
+      expr.type().id() == ID_pointer ? to_pointer_type(expr.type()).subtype()
+                                     : typet());
+    dynamic_object.set_instance(++dynamic_objects);
+    add_object(new_node(std::move(dynamic_object)), dest);
+  }
+  else
+  {
+    for(const auto &op : expr.operands())
+      add_rvalue(op, dest);
+  }
+}
+
+void andersen_points_tot::add_address(const exprt &object, node_indext dest)
+{
+  if(object.id() == ID_symbol)
+    add_object(symbol_node(to_symbol_expr(object)), dest);
+  else if(object.id() == ID_member)
+    add_address(to_member_expr(object).compound(), dest);
+  else if(object.id() == ID_index)
+    add_address(to_index_expr(object).array(), dest);
+  else if(object.id() == ID_dereference)
+    add_rvalue(to_dereference_expr(object).pointer(), dest);
+  else if(object.id() == ID_if)
+  {
+    add_address(to_if_expr(object).true_case(), dest);
+    add_address(to_if_expr(object).false_case(), dest);
+  }
+  else if(object.id() == ID_typecast)
+    add_address(to_typecast_expr(object).op(), dest);
+  else if(
+    object.id() == ID_byte_extract_little_endian ||
+    object.id() == ID_byte_extract_big_endian)
+  {
+    add_address(to_byte_extract_expr(object).op(), dest);
+  }
+  else
+  {
+    // constants such as string literals: one object per occurrence
+    add_object(new_node(object), dest);
+  }
+}
+
+void andersen_points_tot::add_lvalue(const exprt &lhs, node_indext src)
+{
+  if(lhs.id() == ID_symbol)
+    add_edge(src, symbol_node(to_symbol_expr(lhs)));
+  else if(lhs.id() == ID_member)
+    add_lvalue(to_member_expr(lhs).compound(), src);
+  else if(lhs.id() == ID_index)
+    add_lvalue(to_index_expr(lhs).array(), src);
+  else if(lhs.id() == ID_dereference)
+    add_store(value_node(to_dereference_expr(lhs).pointer()), src);
+  else if(lhs.id() == ID_if)
+  {
+    add_lvalue(to_if_expr(lhs).true_case(), src);
+    add_lvalue(to_if_expr(lhs).false_case(), src);
+  }
+  else if(lhs.id() == ID_typecast)
+    add_lvalue(to_typecast_expr(lhs).op(), src);
+  else if(
+    lhs.id() == ID_byte_extract_little_endian ||
+    lhs.id() == ID_byte_extract_big_endian)
+  {
+    add_lvalue(to_byte_extract_expr(lhs).op(), src);
+  }
+}
+
+andersen_points_tot::node_indext
+andersen_points_tot::value_node(const exprt &expr)
+{
+  if(expr.id() == ID_symbol && expr.type().id() != ID_code)
+    return symbol_node(to_symbol_expr(expr));
+
+  const node_indext node = new_node(nil_exprt());
+  add_rvalue(expr, node);
+  return node;
+}
+
+void andersen_points_tot::add_instruction(
+  const irep_idt &function_id,
+  const goto_programt::instructiont &instruction)
+{
+  if(instruction.is_assign())
+  {
+    add_lvalue(
+      instruction.assign_lhs(), value_node(instruction.assign_rhs()));
+  }
+  else if(instruction.is_function_call())
+    add_call(instruction);
+  else if(instruction.is_return())
+  {
+    if(instruction.return_value().is_not_nil())
+    {
+      add_edge(
+        value_node(instruction.return_value()), return_node(function_id));
+    }
+  }
+}
+
+void andersen_points_tot::add_call(
+  const goto_programt::instructiont &instruction)
+{
+  const code_function_callt &call = instruction.get_function_call();
+
+  call_sitet call_site;
+  for(const auto &argument : call.arguments())
+    call_site.arguments.push_back(value_node(argument));
+
+  if(call.lhs().is_not_nil())
+  {
+    call_site.result = new_node(nil_exprt());
+    add_lvalue(call.lhs(), *call_site.result);
+  }
+
+  const std::size_t index = call_sites.size();
+  call_sites.push_back(std::move(call_site));
+
+  const exprt &function = call.function();
+  if(function.id() == ID_symbol)
+    connect(index, to_symbol_expr(function).get_identifier());
+  else if(function.id() == ID_dereference)
+  {
+    const node_indext pointer =
+      find(value_node(to_dereference_expr(function).pointer()));
+    nodes[pointer].calls.push_back(index);
+
+    const sparse_bitsett objects = nodes[pointer].points_to;
+    for(const auto object : objects)
+      connect_object(index, object);
+  }
+}
+
+void andersen_points_tot::connect_object(
+  std::size_t call_site,
+  node_indext object)
+{
+  const exprt &function = nodes[object].object;
+  if(function.id() == ID_symbol && function.type().id() == ID_code)
+    connect(call_site, to_symbol_expr(function).get_identifier());
+}
+
+void andersen_points_tot::connect(
+  std::size_t call_site,
+  const irep_idt &function_id)
+{
+  auto entry = parameters.find(function_id);
+  if(entry == parameters.end())
+  {
+    pending_calls[function_id].push_back(call_site);
+    return;
+  }
+
+  // copy, as nodes may be created
+  const call_sitet call = call_sites[call_site];
+  const std::vector<irep_idt> &parameter_identifiers = entry->second;
+
+  for(std::size_t i = 0;
+      i < call.arguments.size() && i < parameter_identifiers.size();
+      ++i)
+  {
+    if(!parameter_identifiers[i].empty())
+      add_edge(call.arguments[i], symbol_node(parameter_identifiers[i]));
+  }
+
+  if(call.result.has_value())
+    add_edge(return_node(function_id), *call.result);
+}
+
+void andersen_points_tot::add_object(node_indext object, node_indext dest)
+{
+  const node_indext node = find(dest);
+  if(nodes[node].points_to.insert(object))
+  {
+    nodes[node].delta.insert(object);
+    enqueue(node);
+  }
+}
+
+void andersen_points_tot::add_edge(node_indext from, node_indext to)
+{
+  from = find(from);
+  to = find(to);
+  if(from == to || !nodes[from].successors.insert(to))
+    return;
+
+  if(!nodes[from].points_to.empty())
+    propagate(from, to, nodes[from].points_to);
+}
+
+void andersen_points_tot::add_load(node_indext pointer, node_indext dest)
+{
+  pointer = find(pointer);
+  nodes[pointer].loads.push_back(dest);
+
+  const sparse_bitsett objects = nodes[pointer].points_to;
+  for(const auto object : objects)
+    add_edge(object, dest);
+}
+
+void andersen_points_tot::add_store(node_indext pointer, node_indext src)
+{
+  pointer = find(pointer);
+  nodes[pointer].stores.push_back(src);
+
+  const sparse_bitsett objects = nodes[pointer].points_to;
+  for(const auto object : objects)
+    add_edge(src, object);
+}
+
+void andersen_points_tot::propagate(
+  node_indext from,
+  node_indext to,
+  const sparse_bitsett &objects)
+{
+  nodet &target = nodes[to];
+
+  sparse_bitsett added = objects;
+  added.erase(target.points_to);
+  if(!added.empty())
+  {
+    target.points_to.insert(added);
+    target.delta.insert(added);
+    enqueue(to);
+  }
+
+  // Nodes on a cycle end up with the same points-to set. Check whether
+  // there is one through this edge once, when that is the case.
+  if(
+    target.points_to == nodes[from].points_to &&
+    checked_edges.insert({from, to}).second)
+  {
+    cycle_candidates.emplace_back(from, to);
+  }
+}
+
+void andersen_points_tot::enqueue(node_indext node)
+{
+  if(!nodes[node].queued)
+  {
+    nodes[node].queued = true;
+    worklist.push_back(node);
+  }
+}
+
+void andersen_points_tot::solve()
+{
+  detect_cycles();
+
+  while(!worklist.empty())
+  {
+    const node_indext queued = worklist.front();
+    worklist.pop_front();
+    nodes[queued].queued = false;
+
+    // a collapsed node has passed its delta to its representative
+    const node_indext node = find(queued);
+    if(node != queued)
+      continue;
+
+    sparse_bitsett delta;
+    delta.swap(nodes[node].delta);
+    if(delta.empty())
+      continue;
+
+    // the complex constraints, for the objects new to this node
+    for(const auto object : delta)
+    {
+      for(std::size_t i = 0; i < nodes[node].loads.size(); ++i)
+        add_edge(object, nodes[node].loads[i]);
+      for(std::size_t i = 0; i < nodes[node].stores.size(); ++i)
+        add_edge(nodes[node].stores[i], object);
+      for(std::size_t i = 0; i < nodes[node].calls.size(); ++i)
+        connect_object(nodes[node].calls[i], object);
+    }
+
+    const sparse_bitsett successors = nodes[node].successors;
+    for(const auto successor : successors)
+    {
+      const node_indext to = find(successor);
+      if(to != node)
+        propagate(node, to, delta);
+    }
+
+    detect_cycles();
+  }
+}
+
+void andersen_points_tot::detect_cycles()
+{
+  std::vector<std::pair<node_indext, node_indext>> candidates;
+  candidates.swap(cycle_candidates);
+
+  for(const auto &edge : candidates)
+  {
+    const node_indext root = find(edge.second);
+    if(find(edge.first) == root)
+      continue;
+
+    // Tarjan's algorithm, from the target of the edge, without recursion
+    std::unordered_map<node_indext, std::size_t> number, lowlink;
+    std::vector<node_indext> stack;
+    std::unordered_set<node_indext> on_stack;
+    std::vector<std::vector<node_indext>> cycles;
+
+    struct framet
+    {
+      node_indext node;
+      std::vector<node_indext> successors;
+      std::size_t next;
+    };
+    std::vector<framet> frames;
+    std::size_t next_number = 0;
+
+    auto visit = [&](node_indext node) {
+      number[node] = next_number;
+      lowlink[node] = next_number;
+      ++next_number;
+      stack.push_back(node);
+      on_stack.insert(node);
+      framet frame{node, {}, 0};
+      for(const auto successor : nodes[node].successors)
+      {
+        const node_indext to = find(successor);
+        if(to != node)
+          frame.successors.push_back(to);
+      }
+      frames.push_back(std::move(frame));
+    };
+
+    visit(root);
+    while(!frames.empty())
+    {
+      framet &frame = frames.back();
+      if(frame.next < frame.successors.size())
+      {
+        const node_indext to = frame.successors[frame.next++];
+        const auto to_number = number.find(to);
+        if(to_number == number.end())
+          visit(to);
+        else if(on_stack.count(to) != 0)
+        {
+          std::size_t &low = lowlink[frame.node];
+          low = std::min(low, to_number->second);
+        }
+        continue;
+      }
+
+      const node_indext node = frame.node;
+      frames.pop_back();
+      if(!frames.empty())
+      {
+        const node_indext parent = frames.back().node;
+        lowlink[parent] = std::min(lowlink[parent], lowlink[node]);
+      }
+
+      if(lowlink[node] == number[node])
+      {
+        std::vector<node_indext> cycle;
+        node_indext member;
+        do
+        {
+          member = stack.back();
+          stack.pop_back();
+          on_stack.erase(member);
+          cycle.push_back(member);
+        } while(member != node);
+
+        if(cycle.size() > 1)
+          cycles.push_back(std::move(cycle));
+      }
+    }
+
+    for(const auto &cycle : cycles)
+      collapse(cycle);
+  }
+}
+
+void andersen_points_tot::collapse(const std::vector<node_indext> &cycle)
+{
+  const node_indext representative = cycle.front();
+  nodet &r = nodes[representative];
+
+  for(auto it = std::next(cycle.begin()); it != cycle.end(); ++it)
+  {
+    nodet &n = nodes[*it];
+    n.parent = representative;
+    r.points_to.insert(n.points_to);
+    r.successors.insert(n.successors);
+    r.loads.insert(r.loads.end(), n.loads.begin(), n.loads.end());
+    r.stores.insert(r.stores.end(), n.stores.begin(), n.stores.end());
+    r.calls.insert(r.calls.end(), n.calls.begin(), n.calls.end());
+
+    // the object the node stands for stays
+    n.points_to.clear();
+    n.delta.clear();
+    n.successors.clear();
+    n.loads.clear();
+    n.stores.clear();
+    n.calls.clear();
+    ++collapsed_nodes;
+  }
+
+  // The other nodes may not have propagated all of their objects, and the
+  // representative not to their successors, so propagate them all again.
+  r.delta = r.points_to;
+  enqueue(representative);
+}
@@ -0,0 +1,207 @@
+/*******************************************************************\
+
+Module: Field-Insensitive Points-To Analysis with Inclusion Constraints
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Field-Insensitive Points-To Analysis with Inclusion Constraints
+
+#ifndef CPROVER_POINTER_ANALYSIS_ANDERSEN_POINTS_TO_H
+#define CPROVER_POINTER_ANALYSIS_ANDERSEN_POINTS_TO_H
+
+#include <util/expr.h>
+#include <util/optional.h>
+#include <util/sparse_bitset.h>
+
+#include <goto-programs/goto_functions.h>
+
+#include <deque>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class namespacet;
+
+/// Andersen-style points-to analysis, which is flow and context insensitive,
+/// and does not distinguish the fields of structs or the elements of arrays.
+/// Each variable, function, allocation site and function return value is a
+/// node of a constraint graph, and each assignment adds a constraint on the
+/// sets of objects the nodes may point to:
+///
+///     p = &x    { x } is a subset of pts(p)
+///     p = q     pts(q) is a subset of pts(p), an edge from q to p
+///     p = *q    for all o in pts(q): pts(o) is a subset of pts(p)
+///     *p = q    for all o in pts(p): pts(q) is a subset of pts(o)
+///
+/// Calls pass the arguments to the parameters and the return value to the
+/// result; those through a function pointer are connected to each function
+/// it may point to once that is known. The constraints are solved by
+/// propagating along the edges only the objects that are new to a node (its
+/// delta), and nodes on a cycle of edges, which have the same points-to set
+/// in any solution, are collapsed into one as soon as propagation along an
+/// edge does not change the points-to set of its target.
+///
+/// Constraints may be added after solving, and solving again only
+/// propagates what they change.
+class andersen_points_tot
+{
+public:
+  explicit andersen_points_tot(const namespacet &ns) : ns(ns)
+  {
+  }
+
+  /// Add the constraints of all functions in \p goto_functions and solve
+  void operator()(const goto_functionst &goto_functions);
+
+  /// Add the constraints of the body of \p function_id
+  void add_function(
+    const irep_idt &function_id,
+    const goto_functionst::goto_functiont &goto_function);
+
+  /// Propagate until all constraints hold
+  void solve();
+
+  /// \return the objects \p pointer may point to: the symbols of variables
+  ///   and functions, and a dynamic_object_exprt for each allocation site
+  std::vector<exprt> get_values(const exprt &pointer);
+
+  /// \return the number of nodes of the constraint graph, for statistics
+  std::size_t number_of_nodes() const
+  {
+    return nodes.size();
+  }
+
+  /// \return the number of nodes that were collapsed into others because
+  ///   they were on a cycle, for statistics
+  std::size_t number_of_collapsed_nodes() const
+  {
+    return collapsed_nodes;
+  }
+
+protected:
+  typedef std::size_t node_indext;
+
+  const namespacet &ns;
+
+  struct nodet
+  {
+    /// The object the node stands for, or nil for the return value of a
+    /// function and for intermediate values
+    exprt object;
+
+    /// The representative of the nodes on a cycle collapsed with this one,
+    /// which holds all of the following
+    node_indext parent;
+
+    sparse_bitsett points_to;
+
+    /// The part of points_to not yet propagated
+    sparse_bitsett delta;
+
+    /// Nodes whose points-to set includes this one's
+    sparse_bitsett successors;
+
+    /// Nodes that include the points-to sets of all objects in this one's
+    std::vector<node_indext> loads;
+
+    /// Nodes whose points-to sets are included in those of all objects in
+    /// this one's
+    std::vector<node_indext> stores;
+
+    /// Calls through this function pointer, as index into call_sites
+    std::vector<std::size_t> calls;
+
+    /// Whether the node is in the worklist
+    bool queued = false;
+
+    nodet(exprt object, node_indext parent)
+      : object(std::move(object)), parent(parent)
+    {
+    }
+  };
+
+  std::vector<nodet> nodes;
+
+  struct call_sitet
+  {
+    std::vector<node_indext> arguments;
+    optionalt<node_indext> result;
+  };
+
+  std::vector<call_sitet> call_sites;
+
+  /// The parameters of the functions whose constraints have been added
+  std::unordered_map<irep_idt, std::vector<irep_idt>> parameters;
+
+  /// Calls of functions whose constraints have not been added yet, to be
+  /// connected once they are
+  std::unordered_map<irep_idt, std::vector<std::size_t>> pending_calls;
+
+  std::unordered_map<irep_idt, node_indext> symbol_nodes;
+  std::unordered_map<irep_idt, node_indext> return_nodes;
+  unsigned dynamic_objects = 0;
+  std::size_t collapsed_nodes = 0;
+
+  std::deque<node_indext> worklist;
+
+  /// Edges along which propagation left the points-to set of the target
+  /// unchanged, to be checked for a cycle
+  std::vector<std::pair<node_indext, node_indext>> cycle_candidates;
+
+  /// The edges checked for a cycle already, each only once
+  std::set<std::pair<node_indext, node_indext>> checked_edges;
+
+  node_indext new_node(exprt object);
+  node_indext find(node_indext node);
+  node_indext symbol_node(const symbol_exprt &symbol_expr);
+  node_indext symbol_node(const irep_idt &identifier);
+  node_indext return_node(const irep_idt &function_id);
+
+  /// Add the constraints of assigning \p expr to \p dest
+  void add_rvalue(const exprt &expr, node_indext dest);
+
+  /// Add the constraints of assigning the address of \p object to \p dest
+  void add_address(const exprt &object, node_indext dest);
+
+  /// Add the constraints of assigning \p src to \p lhs
+  void add_lvalue(const exprt &lhs, node_indext src);
+
+  /// \return a node that may point to all objects \p expr may point to
+  node_indext value_node(const exprt &expr);
+
+  void add_instruction(
+    const irep_idt &function_id,
+    const goto_programt::instructiont &instruction);
+  void add_call(const goto_programt::instructiont &instruction);
+
+  /// Connect \p call_site to \p object if that is a function
+  void connect_object(std::size_t call_site, node_indext object);
+
+  void add_object(node_indext object, node_indext dest);
+  void add_edge(node_indext from, node_indext to);
+  void add_load(node_indext pointer, node_indext dest);
+  void add_store(node_indext pointer, node_indext src);
+
+  /// Pass the arguments and the result of \p call_site to and from the
+  /// function \p function_id
+  void connect(std::size_t call_site, const irep_idt &function_id);
+
+  /// Add \p objects to the points-to set of \p to, which an edge from \p from
+  /// leads to
+  void
+  propagate(node_indext from, node_indext to, const sparse_bitsett &objects);
+
+  void enqueue(node_indext node);
+
+  /// Collapse the cycles through the given edges
+  void detect_cycles();
+
+  /// Collapse the nodes in \p cycle into the first of them
+  void collapse(const std::vector<node_indext> &cycle);
+};
+
+#endif // CPROVER_POINTER_ANALYSIS_ANDERSEN_POINTS_TO_H
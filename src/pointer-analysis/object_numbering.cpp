@@ -0,0 +1,84 @@
+/*******************************************************************\
+
+Module: Object Numbering
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Object Numbering
+
+#include "object_numbering.h"
+
+/// \return the slot to start probing at for \p hash in a table of
+///   \p table_size slots
+static std::size_t first_slot(std::size_t hash, std::size_t table_size)
+{
+  // spread the high bits, as the table only looks at the low ones
+  hash ^= hash >> (sizeof(std::size_t) * 4);
+  return hash & (table_size - 1);
+}
+
+std::size_t
+object_numberingt::find_slot(const key_type &a, std::size_t hash) const
+{
+  std::size_t slot = first_slot(hash, table.size());
+
+  while(table[slot] != 0)
+  {
+    const number_type n = table[slot] - 1;
+    if(hashes[n] == hash && data[n] == a)
+      break;
+    slot = (slot + 1) & (table.size() - 1);
+  }
+
+  return slot;
+}
+
+object_numberingt::number_type object_numberingt::number(const key_type &a)
+{
+  // keep the table at most half full
+  if((data.size() + 1) * 2 > table.size())
+    grow();
+
+  const std::size_t hash = a.hash();
+  const std::size_t slot = find_slot(a, hash);
+
+  if(table[slot] != 0)
+    return table[slot] - 1;
+
+  const number_type n = data.size();
+  data.push_back(a);
+  hashes.push_back(hash);
+  table[slot] = n + 1;
+
+  return n;
+}
+
+optionalt<object_numberingt::number_type>
+object_numberingt::get_number(const key_type &a) const
+{
+  if(table.empty())
+    return {};
+
+  const std::size_t slot = find_slot(a, a.hash());
+
+  if(table[slot] == 0)
+    return {};
+
+  return table[slot] - 1;
+}
+
+void object_numberingt::grow()
+{
+  table.assign(table.empty() ? 64 : table.size() * 2, 0);
+
+  for(number_type n = 0; n < data.size(); ++n)
+  {
+    std::size_t slot = first_slot(hashes[n], table.size());
+    while(table[slot] != 0)
+      slot = (slot + 1) & (table.size() - 1);
+    table[slot] = n + 1;
+  }
+}
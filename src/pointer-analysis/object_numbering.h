@@ -23,8 +23,81 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_POINTER_ANALYSIS_OBJECT_NUMBERING_H
 
 #include <util/expr.h>
-#include <util/numbering.h>
+#include <util/optional.h>
 
-typedef numberingt<exprt, irep_hash> object_numberingt;
+#include <vector>
+
+/// A numbering of expressions in the manner of \ref numberingt, but with an
+/// open-addressing hash table of the numbers. The table stores the (cached)
+/// hash of each expression next to its number, so a lookup makes a full
+/// comparison of expressions only when the hashes are equal, and growing the
+/// table does not hash any expression again.
+class object_numberingt final
+{
+public:
+  using number_type = std::size_t; // NOLINT
+  using key_type = exprt;          // NOLINT
+
+private:
+  using data_typet = std::vector<key_type>; // NOLINT
+
+public:
+  using size_type = data_typet::size_type;           // NOLINT
+  using const_iterator = data_typet::const_iterator; // NOLINT
+
+  /// \return the number of \p a, which is numbered if it was not yet
+  number_type number(const key_type &a);
+
+  optionalt<number_type> get_number(const key_type &a) const;
+
+  void clear()
+  {
+    data.clear();
+    hashes.clear();
+    table.clear();
+  }
+
+  size_type size() const
+  {
+    return data.size();
+  }
+
+  const key_type &at(size_type t) const
+  {
+    return data.at(t);
+  }
+
+  const key_type &operator[](size_type t) const
+  {
+    return data[t];
+  }
+
+  const_iterator begin() const
+  {
+    return data.begin();
+  }
+
+  const_iterator end() const
+  {
+    return data.end();
+  }
+
+private:
+  data_typet data;
+
+  /// The hash of each numbered expression
+  std::vector<std::size_t> hashes;
+
+  /// One more than the number of an expression for each slot in use, 0 for
+  /// the empty ones; the size is 0 or a power of two
+  std::vector<number_type> table;
+
+  /// \return the slot holding \p a with hash \p hash, or the empty slot
+  ///   where it belongs
+  std::size_t find_slot(const key_type &a, std::size_t hash) const;
+
+  /// Double the size of the table
+  void grow();
+};
 
 #endif // CPROVER_POINTER_ANALYSIS_OBJECT_NUMBERING_H
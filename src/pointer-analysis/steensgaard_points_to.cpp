@@ -0,0 +1,357 @@
+/*******************************************************************\
+
+Module: Unification-Based Points-To Analysis
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Unification-Based Points-To Analysis
+
+#include "steensgaard_points_to.h"
+
+#include <util/byte_operators.h>
+#include <util/namespace.h>
+#include <util/pointer_expr.h>
+#include <util/std_code.h>
+#include <util/std_expr.h>
+
+#include <utility>
+
+void steensgaard_points_tot::operator()(const goto_functionst &goto_functions)
+{
+  for(const auto &gf_entry : goto_functions.function_map)
+    add_function(gf_entry.first, gf_entry.second);
+}
+
+void steensgaard_points_tot::add_function(
+  const irep_idt &function_id,
+  const goto_functionst::goto_functiont &goto_function)
+{
+  if(!goto_function.body_available())
+    return;
+
+  // the signature of the class of the function, which calls pass the
+  // arguments and the return value through
+  const std::vector<irep_idt> &parameter_identifiers =
+    goto_function.parameter_identifiers;
+  const std::vector<node_indext> locations =
+    signature(symbol_node(function_id), parameter_identifiers.size() + 1);
+
+  join(locations[0], return_node(function_id));
+  for(std::size_t i = 0; i < parameter_identifiers.size(); ++i)
+  {
+    if(!parameter_identifiers[i].empty())
+      join(locations[i + 1], symbol_node(parameter_identifiers[i]));
+  }
+
+  for(const auto &instruction : goto_function.body.instructions)
+    add_instruction(function_id, instruction);
+}
+
+std::vector<exprt> steensgaard_points_tot::get_values(const exprt &pointer)
+{
+  std::vector<exprt> result;
+
+  const auto values = rvalue(pointer);
+  if(!values.has_value())
+    return result;
+
+  const node_indext root = classes.find(*values);
+  node_indext node = root;
+  do
+  {
+    if(nodes[node].object.is_not_nil())
+      result.push_back(nodes[node].object);
+    node = nodes[node].next;
+  } while(node != root);
+
+  return result;
+}
+
+std::unordered_set<irep_idt>
+steensgaard_points_tot::get_pointed_to_symbols() const
+{
+  std::unordered_set<node_indext> pointees;
+  for(node_indext node = 0; node < nodes.size(); ++node)
+  {
+    if(classes.is_root(node) && nodes[node].pointee.has_value())
+      pointees.insert(classes.find(*nodes[node].pointee));
+  }
+
+  std::unordered_set<irep_idt> result;
+  for(node_indext node = 0; node < nodes.size(); ++node)
+  {
+    const exprt &object = nodes[node].object;
+    if(
+      object.id() == ID_symbol && object.type().id() != ID_code &&
+      pointees.count(classes.find(node)) != 0)
+    {
+      result.insert(to_symbol_expr(object).get_identifier());
+    }
+  }
+
+  return result;
+}
+
+steensgaard_points_tot::node_indext
+steensgaard_points_tot::new_node(exprt object)
+{
+  const node_indext node = nodes.size();
+  nodes.emplace_back(std::move(object), node);
+  classes.check_index(node);
+  return node;
+}
+
+steensgaard_points_tot::node_indext
+steensgaard_points_tot::symbol_node(const symbol_exprt &symbol_expr)
+{
+  auto entry = symbol_nodes.find(symbol_expr.get_identifier());
+  if(entry != symbol_nodes.end())
+    return entry->second;
+
+  const node_indext node = new_node(symbol_expr);
+  symbol_nodes.emplace(symbol_expr.get_identifier(), node);
+  return node;
+}
+
+steensgaard_points_tot::node_indext
+steensgaard_points_tot::symbol_node(const irep_idt &identifier)
+{
+  auto entry = symbol_nodes.find(identifier);
+  if(entry != symbol_nodes.end())
+    return entry->second;
+
+  const symbolt *symbol;
+  if(!ns.lookup(identifier, symbol))
+    return symbol_node(symbol->symbol_expr());
+  else
+    return symbol_node(symbol_exprt(identifier, typet()));
+}
+
+steensgaard_points_tot::node_indext
+steensgaard_points_tot::return_node(const irep_idt &function_id)
+{
+  auto entry = return_nodes.find(function_id);
+  if(entry != return_nodes.end())
+    return entry->second;
+
+  const node_indext node = new_node(nil_exprt());
+  return_nodes.emplace(function_id, node);
+  return node;
+}
+
+steensgaard_points_tot::node_indext
+steensgaard_points_tot::pointee(node_indext node)
+{
+  const node_indext root = classes.find(node);
+  if(nodes[root].pointee.has_value())
+    return *nodes[root].pointee;
+
+  const node_indext result = new_node(nil_exprt());
+  nodes[root].pointee = result;
+  return result;
+}
+
+std::vector<steensgaard_points_tot::node_indext>
+steensgaard_points_tot::signature(node_indext node, std::size_t size)
+{
+  const node_indext root = classes.find(node);
+  while(nodes[root].signature.size() < size)
+  {
+    const node_indext location = new_node(nil_exprt());
+    nodes[root].signature.push_back(location);
+  }
+
+  return nodes[root].signature;
+}
+
+void steensgaard_points_tot::join(node_indext a, node_indext b)
+{
+  // a worklist rather than recursion, as chains of pointees may be long
+  std::vector<std::pair<node_indext, node_indext>> pending{{a, b}};
+
+  while(!pending.empty())
+  {
+    a = classes.find(pending.back().first);
+    b = classes.find(pending.back().second);
+    pending.pop_back();
+
+    if(a == b)
+      continue;
+
+    const optionalt<node_indext> a_pointee = nodes[a].pointee;
+    const optionalt<node_indext> b_pointee = nodes[b].pointee;
+    std::vector<node_indext> a_signature = std::move(nodes[a].signature);
+    std::vector<node_indext> b_signature = std::move(nodes[b].signature);
+    nodes[a].signature.clear();
+    nodes[b].signature.clear();
+
+    classes.make_union(a, b);
+    const node_indext root = classes.find(a);
+
+    // splice the circular lists of members
+    std::swap(nodes[a].next, nodes[b].next);
+
+    if(a_pointee.has_value() && b_pointee.has_value())
+      pending.emplace_back(*a_pointee, *b_pointee);
+    nodes[root].pointee = a_pointee.has_value() ? a_pointee : b_pointee;
+
+    if(a_signature.size() < b_signature.size())
+      a_signature.swap(b_signature);
+    for(std::size_t i = 0; i < b_signature.size(); ++i)
+      pending.emplace_back(a_signature[i], b_signature[i]);
+    nodes[root].signature = std::move(a_signature);
+  }
+}
+
+optionalt<steensgaard_points_tot::node_indext>
+steensgaard_points_tot::rvalue(const exprt &expr)
+{
+  // Booleans do not carry pointers, not even comparisons of pointers. All
+  // other expressions, including integers that pointers were cast to, may
+  // point to whatever any of their operands point to.
+  if(expr.type().id() == ID_bool)
+    return {};
+
+  if(expr.id() == ID_symbol)
+  {
+    // a function designator denotes the function
+    if(expr.type().id() == ID_code)
+      return symbol_node(to_symbol_expr(expr));
+    else
+      return pointee(symbol_node(to_symbol_expr(expr)));
+  }
+  else if(expr.id() == ID_address_of)
+    return address(to_address_of_expr(expr).object());
+  else if(expr.id() == ID_dereference)
+  {
+    const auto pointer = rvalue(to_dereference_expr(expr).pointer());
+    if(!pointer.has_value())
+      return {};
+    return pointee(*pointer);
+  }
+  else if(expr.id() == ID_member)
+    return rvalue(to_member_expr(expr).compound());
+  else if(expr.id() == ID_index)
+    return rvalue(to_index_expr(expr).array());
+  else if(
+    expr.id() == ID_side_effect &&
+    to_side_effect_expr(expr).get_statement() == ID_allocate)
+  {
+    // one object for each allocation site
+    dynamic_object_exprt dynamic_object(
+      expr.type().id() == ID_pointer ? to_pointer_type(expr.type()).subtype()
+                                     : typet());
+    dynamic_object.set_instance(++dynamic_objects);
+    return new_node(std::move(dynamic_object));
+  }
+
+  // the conditional operator and all others
+  optionalt<node_indext> result;
+  for(const auto &op : expr.operands())
+  {
+    const auto values = rvalue(op);
+    if(!values.has_value())
+      continue;
+    else if(result.has_value())
+      join(*result, *values);
+    else
+      result = values;
+  }
+
+  return result;
+}
+
+optionalt<steensgaard_points_tot::node_indext>
+steensgaard_points_tot::address(const exprt &object)
+{
+  if(object.id() == ID_symbol)
+    return symbol_node(to_symbol_expr(object));
+  else if(object.id() == ID_member)
+    return address(to_member_expr(object).compound());
+  else if(object.id() == ID_index)
+    return address(to_index_expr(object).array());
+  else if(object.id() == ID_dereference)
+    return rvalue(to_dereference_expr(object).pointer());
+  else if(object.id() == ID_if)
+  {
+    const auto true_case = address(to_if_expr(object).true_case());
+    const auto false_case = address(to_if_expr(object).false_case());
+    if(true_case.has_value() && false_case.has_value())
+      join(*true_case, *false_case);
+    return true_case.has_value() ? true_case : false_case;
+  }
+  else if(object.id() == ID_typecast)
+    return address(to_typecast_expr(object).op());
+  else if(
+    object.id() == ID_byte_extract_little_endian ||
+    object.id() == ID_byte_extract_big_endian)
+  {
+    return address(to_byte_extract_expr(object).op());
+  }
+  else
+  {
+    // constants such as string literals: one object per occurrence
+    return new_node(object);
+  }
+}
+
+void steensgaard_points_tot::add_instruction(
+  const irep_idt &function_id,
+  const goto_programt::instructiont &instruction)
+{
+  if(instruction.is_assign())
+  {
+    const auto values = rvalue(instruction.assign_rhs());
+    if(!values.has_value())
+      return;
+    const auto lhs = address(instruction.assign_lhs());
+    if(lhs.has_value())
+      join(pointee(*lhs), *values);
+  }
+  else if(instruction.is_function_call())
+    add_call(instruction);
+  else if(instruction.is_return())
+  {
+    if(instruction.return_value().is_not_nil())
+    {
+      const auto values = rvalue(instruction.return_value());
+      if(values.has_value())
+        join(pointee(return_node(function_id)), *values);
+    }
+  }
+}
+
+void steensgaard_points_tot::add_call(
+  const goto_programt::instructiont &instruction)
+{
+  const code_function_callt &call = instruction.get_function_call();
+
+  // the class of the functions that may be called
+  const exprt &function = call.function();
+  const auto functions =
+    function.id() == ID_dereference
+      ? rvalue(to_dereference_expr(function).pointer())
+      : rvalue(function);
+  if(!functions.has_value())
+    return;
+
+  const std::vector<node_indext> locations =
+    signature(*functions, call.arguments().size() + 1);
+
+  for(std::size_t i = 0; i < call.arguments().size(); ++i)
+  {
+    const auto values = rvalue(call.arguments()[i]);
+    if(values.has_value())
+      join(pointee(locations[i + 1]), *values);
+  }
+
+  if(call.lhs().is_not_nil())
+  {
+    const auto lhs = address(call.lhs());
+    if(lhs.has_value())
+      join(pointee(*lhs), pointee(locations[0]));
+  }
+}
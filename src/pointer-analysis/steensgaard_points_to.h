@@ -0,0 +1,150 @@
+/*******************************************************************\
+
+Module: Unification-Based Points-To Analysis
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Unification-Based Points-To Analysis
+
+#ifndef CPROVER_POINTER_ANALYSIS_STEENSGAARD_POINTS_TO_H
+#define CPROVER_POINTER_ANALYSIS_STEENSGAARD_POINTS_TO_H
+
+#include <util/expr.h>
+#include <util/optional.h>
+#include <util/union_find.h>
+
+#include <goto-programs/goto_functions.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class namespacet;
+
+/// Steensgaard-style points-to analysis, which is flow and context
+/// insensitive, and does not distinguish the fields of structs or the
+/// elements of arrays. Each variable, function, allocation site and function
+/// return value is a location, and the locations are partitioned into
+/// classes such that all locations any location in a class may point to are
+/// in one class, its pointee. An assignment `p = q` unifies the pointees of
+/// the classes of `p` and `q`, and unifying two classes unifies their
+/// pointees in turn:
+///
+///     p = &x    unify pointee(p) with x
+///     p = q     unify pointee(p) with pointee(q)
+///     p = *q    unify pointee(p) with pointee(pointee(q))
+///     *p = q    unify pointee(pointee(p)) with pointee(q)
+///
+/// A class of functions also has a signature, the locations of the return
+/// value and the parameters, which calls, direct or through a pointer to the
+/// class, pass the result and the arguments to and from. Each instruction is
+/// thus processed once, in almost linear time overall, at the price of
+/// less precise results than \ref andersen_points_tot: the targets of two
+/// pointers that are ever assigned to each other become indistinguishable.
+///
+/// Functions may be added in any order, and the results are available at any
+/// time.
+class steensgaard_points_tot
+{
+public:
+  explicit steensgaard_points_tot(const namespacet &ns) : ns(ns)
+  {
+  }
+
+  /// Add the constraints of all functions in \p goto_functions
+  void operator()(const goto_functionst &goto_functions);
+
+  /// Add the constraints of the body of \p function_id
+  void add_function(
+    const irep_idt &function_id,
+    const goto_functionst::goto_functiont &goto_function);
+
+  /// \return the objects \p pointer may point to: the symbols of variables
+  ///   and functions, and a dynamic_object_exprt for each allocation site
+  std::vector<exprt> get_values(const exprt &pointer);
+
+  /// \return the identifiers of the variables some pointer may point to,
+  ///   a superset of the ones whose address is taken as per \ref dirtyt
+  std::unordered_set<irep_idt> get_pointed_to_symbols() const;
+
+  /// \return the number of locations, for statistics
+  std::size_t number_of_nodes() const
+  {
+    return nodes.size();
+  }
+
+  /// \return the number of classes of locations, for statistics
+  std::size_t number_of_classes() const
+  {
+    return classes.count_roots();
+  }
+
+protected:
+  typedef std::size_t node_indext;
+
+  const namespacet &ns;
+
+  struct nodet
+  {
+    /// The object the location stands for, or nil for the return value of a
+    /// function and for the locations only a pointee stands for
+    exprt object;
+
+    /// The next location in the same class, the classes being circular lists
+    node_indext next;
+
+    /// The class the locations in this one may point to, valid at the root
+    optionalt<node_indext> pointee;
+
+    /// The location of the return value followed by those of the parameters
+    /// if this is a class of functions, valid at the root
+    std::vector<node_indext> signature;
+
+    nodet(exprt object, node_indext index)
+      : object(std::move(object)), next(index)
+    {
+    }
+  };
+
+  std::vector<nodet> nodes;
+  unsigned_union_find classes;
+
+  std::unordered_map<irep_idt, node_indext> symbol_nodes;
+  std::unordered_map<irep_idt, node_indext> return_nodes;
+  unsigned dynamic_objects = 0;
+
+  node_indext new_node(exprt object);
+  node_indext symbol_node(const symbol_exprt &symbol_expr);
+  node_indext symbol_node(const irep_idt &identifier);
+  node_indext return_node(const irep_idt &function_id);
+
+  /// \return the class the class of \p node may point to, created if
+  ///   there is none yet
+  node_indext pointee(node_indext node);
+
+  /// \return the signature of the class of \p node, with at least \p size
+  ///   entries
+  std::vector<node_indext> signature(node_indext node, std::size_t size);
+
+  /// Unify the classes of \p a and \p b, and then their pointees and
+  /// signatures
+  void join(node_indext a, node_indext b);
+
+  /// \return a location of the class of the objects \p expr may point to, or
+  ///   nothing if it cannot point to any
+  optionalt<node_indext> rvalue(const exprt &expr);
+
+  /// \return a location of the class of \p object, or nothing if it is not
+  ///   an object
+  optionalt<node_indext> address(const exprt &object);
+
+  void add_instruction(
+    const irep_idt &function_id,
+    const goto_programt::instructiont &instruction);
+  void add_call(const goto_programt::instructiont &instruction);
+};
+
+#endif // CPROVER_POINTER_ANALYSIS_STEENSGAARD_POINTS_TO_H
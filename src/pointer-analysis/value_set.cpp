@@ -234,48 +234,49 @@ exprt value_sett::to_expr(const object_map_dt::value_type &it) const
 
 bool value_sett::make_union(const value_sett::valuest &new_values)
 {
-  bool result=false;
-
-  value_sett::valuest::delta_viewt delta_view;
-
-  new_values.get_delta_view(values, delta_view, false);
-
-  for(const auto &delta_entry : delta_view)
-  {
-    if(delta_entry.is_in_both_maps())
-    {
-      if(make_union_would_change(
-           delta_entry.get_other_map_value().object_map,
-           delta_entry.m.object_map))
+  bool result = false;
+  const std::size_t old_size = values.size();
+
+  values.merge_with(
+    new_values,
+    [&](const irep_idt &, const entryt &existing_entry, const entryt &new_entry)
+      -> optionalt<entryt> {
+      if(!make_union_would_change(
+           existing_entry.object_map, new_entry.object_map))
       {
-        values.update(delta_entry.k, [&](entryt &existing_entry) {
-          make_union(existing_entry.object_map, delta_entry.m.object_map);
-        });
-        result = true;
+        return {};
       }
-    }
-    else
-    {
-      values.insert(delta_entry.k, delta_entry.m);
+
+      entryt merged_entry = existing_entry;
+      make_union(merged_entry.object_map, new_entry.object_map);
       result = true;
-    }
-  }
+      return std::move(merged_entry);
+    });
 
-  return result;
+  return result || values.size() != old_size;
 }
 
 bool value_sett::make_union_would_change(
   const object_mapt &dest,
   const object_mapt &src) const
 {
+  const object_map_dt &dest_map = dest.read();
+  auto dest_it = dest_map.begin();
+
+  // both maps are sorted by object number
   for(const auto &number_and_offset : src.read())
   {
-    if(
-      get_insert_action(
-        dest, number_and_offset.first, number_and_offset.second) !=
-      insert_actiont::NONE)
+    while(dest_it != dest_map.end() && dest_it->first < number_and_offset.first)
+      ++dest_it;
+
+    if(dest_it == dest_map.end() || number_and_offset.first < dest_it->first)
+      return true; // new object
+    else if(
+      dest_it->second &&
+      (!number_and_offset.second ||
+       *dest_it->second != *number_and_offset.second))
     {
-      return true;
+      return true; // the offset becomes unknown
     }
   }
 
@@ -284,17 +285,26 @@ bool value_sett::make_union_would_change(
 
 bool value_sett::make_union(object_mapt &dest, const object_mapt &src) const
 {
-  bool result=false;
+  // Checking first saves copying maps shared with other value sets when
+  // nothing changes, as in most merges once the analysis nears its fixed
+  // point.
+  if(!make_union_would_change(dest, src))
+    return false;
 
-  for(object_map_dt::const_iterator it=src.read().begin();
-      it!=src.read().end();
-      it++)
+  if(dest.read().empty())
   {
-    if(insert(dest, *it))
-      result=true;
+    dest = src;
+    return true;
   }
 
-  return result;
+  dest.write().merge(src.read(), [](offsett &offset, const offsett &other) {
+    // as in insert, the offset of an object in both becomes unknown unless
+    // they agree
+    if(offset && (!other || *offset != *other))
+      offset.reset();
+  });
+
+  return true;
 }
 
 bool value_sett::eval_pointer_offset(
@@ -17,6 +17,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/mp_arith.h>
 #include <util/reference_counting.h>
 #include <util/sharing_map.h>
+#include <util/sorted_vector_map.h>
 
 #include "object_numbering.h"
 #include "value_sets.h"
@@ -83,8 +84,12 @@ public:
   /// offsets (`offsett` instances). This is the RHS set of a single row of
   /// the enclosing `value_sett`, such as `{ null, dynamic_object1 }`.
   /// The set is represented as a map from numbered `exprt`s to `offsett`
-  /// instead of a set of pairs to make lookup by `exprt` easier.
-  using object_map_dt = std::map<object_numberingt::number_type, offsett>;
+  /// instead of a set of pairs to make lookup by `exprt` easier. Most such
+  /// sets are small, and are merged far more often than they are built up
+  /// one element at a time, so the map is a sorted vector: union is then a
+  /// linear merge, see \ref make_union.
+  using object_map_dt =
+    sorted_vector_mapt<object_numberingt::number_type, offsett>;
 
   static const object_map_dt empty_object_map;
 
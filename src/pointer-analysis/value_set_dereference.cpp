@@ -30,6 +30,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/pointer_predicates.h>
 #include <util/range.h>
 #include <util/simplify_expr.h>
+#include <util/symbol_table.h>
 
 #include <deque>
 
@@ -210,6 +211,18 @@ exprt value_set_dereferencet::handle_dereference_base_case(
   const std::vector<exprt> points_to_set =
     dereference_callback.get_value_set(pointer);
 
+  // Reuse the result of an earlier dereference with the same points-to set,
+  // unless the points-to set is to be shown.
+  memo_keyt memo_key{pointer, points_to_set};
+  if(!display_points_to_sets)
+  {
+    const auto memo_entry = memo.find(memo_key);
+    if(memo_entry != memo.end())
+      return memo_entry->second;
+  }
+
+  const std::size_t symbols_before = new_symbol_table.symbols.size();
+
   // get the values of these
   const std::vector<exprt> retained_values =
     make_range(points_to_set).filter([&](const exprt &value) {
@@ -274,6 +287,15 @@ exprt value_set_dereferencet::handle_dereference_base_case(
       pointer, points_to_set, retained_values, result_value);
   }
 
+  // results with fresh symbols, binders or invalid objects, must not be
+  // shared between dereferences
+  if(new_symbol_table.symbols.size() == symbols_before)
+  {
+    if(memo.size() >= max_memo_entries)
+      memo.clear();
+    memo.emplace(std::move(memo_key), result_value);
+  }
+
   return result_value;
 }
 
@@ -12,8 +12,14 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_POINTER_ANALYSIS_VALUE_SET_DEREFERENCE_H
 #define CPROVER_POINTER_ANALYSIS_VALUE_SET_DEREFERENCE_H
 
+#include <util/irep_hash.h>
 #include <util/std_expr.h>
 
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 class dereference_callbackt;
 class messaget;
 class symbol_tablet;
@@ -112,6 +118,41 @@ private:
   /// disregard an apparent attempt to dereference NULL
   const bool exclude_null_derefs;
   const messaget &log;
+  /// A pointer and the objects it may point to
+  typedef std::pair<exprt, std::vector<exprt>> memo_keyt;
+
+  struct memo_key_hasht
+  {
+    std::size_t operator()(const memo_keyt &key) const
+    {
+      std::size_t result = key.first.hash();
+      for(const auto &object : key.second)
+        result = hash_combine(result, object.hash());
+      return result;
+    }
+  };
+
+  struct memo_key_equalt
+  {
+    bool operator()(const memo_keyt &a, const memo_keyt &b) const
+    {
+      return a.first.full_eq(b.first) && a.second.size() == b.second.size() &&
+             std::equal(
+               a.second.begin(),
+               a.second.end(),
+               b.second.begin(),
+               [](const exprt &x, const exprt &y) { return x.full_eq(y); });
+    }
+  };
+
+  static const std::size_t max_memo_entries = 1 << 14;
+
+  /// The results of \ref handle_dereference_base_case that do not contain
+  /// fresh symbols, reused when the same pointer (with the same type, and thus
+  /// access type) is dereferenced with the same points-to set again, as in
+  /// unrolled loops
+  std::unordered_map<memo_keyt, exprt, memo_key_hasht, memo_key_equalt> memo;
+
   valuet get_failure_value(const exprt &pointer, const typet &type);
   exprt handle_dereference_base_case(
     const exprt &pointer,
@@ -19,6 +19,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <unordered_set>
 
 #include <util/mp_arith.h>
+#include <util/numbering.h>
 #include <util/reference_counting.h>
 
 #include "object_numbering.h"
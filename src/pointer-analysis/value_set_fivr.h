@@ -18,6 +18,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <unordered_set>
 
 #include <util/mp_arith.h>
+#include <util/numbering.h>
 #include <util/namespace.h>
 #include <util/reference_counting.h>
 #include <util/invariant.h>
@@ -14,7 +14,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "miniBDD.h"
 
 #include <util/invariant.h>
+#include <util/magic.h>
 
+#include <algorithm>
 #include <iostream>
 
 void mini_bdd_nodet::remove_reference()
@@ -31,6 +33,7 @@ void mini_bdd_nodet::remove_reference()
     low.clear();
     high.clear();
     mgr->free.push(this);
+    mgr->stats.collected_nodes++;
   }
 }
 
@@ -184,7 +187,8 @@ void mini_bdd_mgrt::DumpTikZ(
 class mini_bdd_applyt
 {
 public:
-  inline explicit mini_bdd_applyt(bool (*_fkt)(bool, bool)) : fkt(_fkt)
+  inline explicit mini_bdd_applyt(bool (*_fkt)(bool, bool))
+    : fkt(_fkt), commutative(fkt(false, true) == fkt(true, false))
   {
   }
 
@@ -195,13 +199,62 @@ public:
 
 protected:
   bool (*fkt)(bool, bool);
+  bool commutative;
   mini_bddt APP_rec(const mini_bddt &x, const mini_bddt &y);
   mini_bddt APP_non_rec(const mini_bddt &x, const mini_bddt &y);
 
+  /// \return true if the cache of the manager has the result of applying
+  ///   \ref fkt to \p x and \p y, which is then stored in \p result
+  bool
+  cache_lookup(const mini_bddt &x, const mini_bddt &y, mini_bddt &result) const;
+
+  void cache_insert(
+    const mini_bddt &x,
+    const mini_bddt &y,
+    const mini_bddt &result) const;
+
   typedef std::map<std::pair<unsigned, unsigned>, mini_bddt> Gt;
   Gt G;
 };
 
+bool mini_bdd_applyt::cache_lookup(
+  const mini_bddt &_x,
+  const mini_bddt &_y,
+  mini_bddt &result) const
+{
+  // the operands of commutative operators are ordered to share entries
+  const bool swap = commutative && _y.node_number() < _x.node_number();
+  const mini_bddt &x = swap ? _y : _x;
+  const mini_bddt &y = swap ? _x : _y;
+
+  mini_bdd_mgrt &mgr = *x.node->mgr;
+  mgr.stats.cache_lookups++;
+
+  const auto &entry = mgr.cache_entry(fkt, x, y);
+  if(entry.fkt != fkt || entry.x.node != x.node || entry.y.node != y.node)
+    return false;
+
+  mgr.stats.cache_hits++;
+  result = entry.result;
+  return true;
+}
+
+void mini_bdd_applyt::cache_insert(
+  const mini_bddt &_x,
+  const mini_bddt &_y,
+  const mini_bddt &result) const
+{
+  const bool swap = commutative && _y.node_number() < _x.node_number();
+  const mini_bddt &x = swap ? _y : _x;
+  const mini_bddt &y = swap ? _x : _y;
+
+  auto &entry = x.node->mgr->cache_entry(fkt, x, y);
+  entry.fkt = fkt;
+  entry.x = x;
+  entry.y = y;
+  entry.result = result;
+}
+
 mini_bddt mini_bdd_applyt::APP_rec(const mini_bddt &x, const mini_bddt &y)
 {
   PRECONDITION_WITH_DIAGNOSTICS(
@@ -288,6 +341,12 @@ mini_bddt mini_bdd_applyt::APP_non_rec(const mini_bddt &_x, const mini_bddt &_y)
         t.result = G_it->second;
         stack.pop();
       }
+      else if(
+        !(x.is_constant() && y.is_constant()) && cache_lookup(x, y, t.result))
+      {
+        G[t.key] = t.result;
+        stack.pop();
+      }
       else
       {
         if(x.is_constant() && y.is_constant())
@@ -349,6 +408,7 @@ mini_bddt mini_bdd_applyt::APP_non_rec(const mini_bddt &_x, const mini_bddt &_y)
       mini_bdd_mgrt *mgr = x.node->mgr;
       t.result = mgr->mk(t.var, t.lr, t.hr);
       G[t.key] = t.result;
+      cache_insert(x, y, t.result);
       stack.pop();
     }
     break;
@@ -458,29 +518,48 @@ mini_bdd_mgrt::mk(unsigned var, const mini_bddt &low, const mini_bddt &high)
         n->var = var;
         n->low = low;
         n->high = high;
+        stats.reused_nodes++;
       }
 
       reverse_map[reverse_key] = n;
+      stats.peak_nodes = std::max(stats.peak_nodes, number_of_nodes());
       return mini_bddt(n);
     }
   }
 }
 
 bool mini_bdd_mgrt::reverse_keyt::
-operator<(const mini_bdd_mgrt::reverse_keyt &y) const
+operator==(const mini_bdd_mgrt::reverse_keyt &y) const
 {
-  const reverse_keyt &x = *this;
+  return var == y.var && low == y.low && high == y.high;
+}
 
-  if(x.var < y.var)
-    return true;
-  else if(x.var > y.var)
-    return false;
-  else if(x.low < y.low)
-    return true;
-  else if(x.low > y.low)
-    return false;
-  else
-    return x.high < y.high;
+std::size_t mini_bdd_mgrt::reverse_key_hasht::
+operator()(const mini_bdd_mgrt::reverse_keyt &key) const
+{
+  std::size_t result = key.var;
+  result = result * 0x9e3779b1 + key.low;
+  result = result * 0x9e3779b1 + key.high;
+  return result;
+}
+
+mini_bdd_mgrt::cache_entryt &mini_bdd_mgrt::cache_entry(
+  bool (*fkt)(bool, bool),
+  const mini_bddt &x,
+  const mini_bddt &y)
+{
+  if(cache.empty())
+    cache.resize(MINI_BDD_CACHE_SIZE);
+
+  std::size_t hash = reinterpret_cast<std::size_t>(fkt);
+  hash = hash * 0x9e3779b1 + x.node_number();
+  hash = hash * 0x9e3779b1 + y.node_number();
+  return cache[(hash ^ (hash >> 16)) % cache.size()];
+}
+
+void mini_bdd_mgrt::clear_cache()
+{
+  cache.clear();
 }
 
 void mini_bdd_mgrt::DumpTable(std::ostream &out) const
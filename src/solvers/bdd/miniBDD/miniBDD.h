@@ -25,6 +25,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <map>
 #include <stack>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class mini_bddt
@@ -107,6 +108,27 @@ public:
 
   std::size_t number_of_nodes();
 
+  struct statisticst
+  {
+    /// Largest number of nodes in use at the same time
+    std::size_t peak_nodes = 0;
+    /// Nodes that were freed as they were no longer referenced
+    std::size_t collected_nodes = 0;
+    /// Nodes that were created by reusing a freed node
+    std::size_t reused_nodes = 0;
+    std::size_t cache_lookups = 0;
+    std::size_t cache_hits = 0;
+  };
+
+  const statisticst &statistics() const
+  {
+    return stats;
+  }
+
+  /// Release the results of operations kept in the cache, such that the nodes
+  /// only referenced by the cache are freed
+  void clear_cache();
+
   struct var_table_entryt
   {
     std::string label;
@@ -121,20 +143,49 @@ protected:
   nodest nodes;
   mini_bddt true_bdd, false_bdd;
 
-  // this is our reverse-map for nodes
+  // this is our reverse-map for nodes, a hash table that grows with the
+  // number of nodes
   struct reverse_keyt
   {
     unsigned var, low, high;
     reverse_keyt(unsigned _var, const mini_bddt &_low, const mini_bddt &_high);
 
-    bool operator<(const reverse_keyt &) const;
+    bool operator==(const reverse_keyt &) const;
   };
 
-  typedef std::map<reverse_keyt, mini_bdd_nodet *> reverse_mapt;
+  struct reverse_key_hasht
+  {
+    std::size_t operator()(const reverse_keyt &) const;
+  };
+
+  typedef std::unordered_map<reverse_keyt, mini_bdd_nodet *, reverse_key_hasht>
+    reverse_mapt;
   reverse_mapt reverse_map;
 
   typedef std::stack<mini_bdd_nodet *> freet;
   freet free;
+
+  statisticst stats;
+
+  /// The results of applying Boolean operators, which are kept across
+  /// operations. The cache is direct-mapped, i.e., an entry is replaced by a
+  /// later one with the same hash, which bounds the number of nodes kept
+  /// alive by the cache. It is declared last as it refers to the nodes.
+  struct cache_entryt
+  {
+    bool (*fkt)(bool, bool) = nullptr;
+    mini_bddt x, y, result;
+  };
+
+  std::vector<cache_entryt> cache;
+
+  friend class mini_bdd_applyt;
+
+  /// \return the cached entry for applying \p fkt to \p x and \p y,
+  ///   which is a hit if its \c fkt is \p fkt and its operands are \p x and
+  ///   \p y
+  cache_entryt &
+  cache_entry(bool (*fkt)(bool, bool), const mini_bddt &x, const mini_bddt &y);
 };
 
 mini_bddt restrict(const mini_bddt &u, unsigned var, const bool value);
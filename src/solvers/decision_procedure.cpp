@@ -11,6 +11,10 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "decision_procedure.h"
 
+#include <util/expr.h>
+
+#include <unordered_map>
+
 decision_proceduret::~decision_proceduret()
 {
 }
@@ -29,3 +33,23 @@ void decision_proceduret::set_to_false(const exprt &expr)
 {
   set_to(expr, false);
 }
+
+std::vector<exprt>
+decision_proceduret::get_values(const std::vector<exprt> &exprs) const
+{
+  // traces refer to the same guards and symbols many times
+  std::unordered_map<exprt, exprt, irep_hash> values;
+
+  std::vector<exprt> result;
+  result.reserve(exprs.size());
+
+  for(const auto &expr : exprs)
+  {
+    auto entry = values.find(expr);
+    if(entry == values.end())
+      entry = values.emplace(expr, get(expr)).first;
+    result.push_back(entry->second);
+  }
+
+  return result;
+}
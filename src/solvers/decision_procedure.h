@@ -14,6 +14,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <iosfwd>
 #include <string>
+#include <vector>
 
 class exprt;
 
@@ -55,6 +56,14 @@ public:
   /// Return `nil` if not available
   virtual exprt get(const exprt &expr) const = 0;
 
+  /// Return the values of \p exprs as \ref get does, in the same order, for
+  /// decision procedures that obtain the values of many expressions at once
+  /// more efficiently
+  std::vector<exprt> get(const std::vector<exprt> &exprs) const
+  {
+    return get_values(exprs);
+  }
+
   /// Print satisfying assignment to \p out
   virtual void print_assignment(std::ostream &out) const = 0;
 
@@ -69,6 +78,10 @@ public:
 protected:
   /// Run the decision procedure to solve the problem
   virtual resultt dec_solve() = 0;
+
+  /// See \ref get(const std::vector<exprt> &) const, which by default calls
+  /// \ref get once for each distinct expression
+  virtual std::vector<exprt> get_values(const std::vector<exprt> &exprs) const;
 };
 
 /// Add Boolean constraint \p src to decision procedure \p dest
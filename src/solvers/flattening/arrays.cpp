@@ -247,7 +247,14 @@ void arrayst::collect_arrays(const exprt &a)
 /// adds array constraints (refine=true...lazily for the refinement loop)
 void arrayst::add_array_constraint(const lazy_constraintt &lazy, bool refine)
 {
-  if(lazy_arrays && refine)
+  if(model_guided_arrays)
+  {
+    // converting the reads may add indices and arrays, which must be known
+    // before post-processing ends
+    convert_atoms(lazy.lazy);
+    lazy_array_constraints.push_back(lazy);
+  }
+  else if(lazy_arrays && refine)
   {
     // lazily add the constraint
     if(incremental_cache)
@@ -270,6 +277,124 @@ void arrayst::add_array_constraint(const lazy_constraintt &lazy, bool refine)
   }
 }
 
+decision_proceduret::resultt arrayst::dec_solve()
+{
+  if(!model_guided_arrays)
+    return SUB::dec_solve();
+
+  while(true)
+  {
+    const resultt result = SUB::dec_solve();
+    if(result != resultt::D_SATISFIABLE)
+      return result;
+
+    const std::size_t number_of_pending = lazy_array_constraints.size();
+    const std::size_t number_of_added = add_violated_array_constraints();
+
+    log.statistics() << "Added " << number_of_added << " of "
+                     << number_of_pending
+                     << " array constraints violated by the model"
+                     << messaget::eom;
+
+    if(number_of_added == 0)
+      return result;
+  }
+}
+
+std::size_t arrayst::add_violated_array_constraints()
+{
+  std::size_t number_of_added = 0;
+
+  for(auto it = lazy_array_constraints.begin();
+      it != lazy_array_constraints.end();)
+  {
+    if(holds_in_model(it->lazy))
+      ++it;
+    else
+    {
+      prop.l_set_to_true(convert(it->lazy));
+      ++number_of_added;
+      it = lazy_array_constraints.erase(it);
+    }
+  }
+
+  return number_of_added;
+}
+
+/// \return true if \p constraint is an equality of operands that are
+///   encoded as bit vectors
+static bool is_bit_vector_equality(const exprt &constraint)
+{
+  return constraint.id() == ID_equal &&
+         to_equal_expr(constraint).lhs().type().id() != ID_bool &&
+         to_equal_expr(constraint).lhs().type().id() != ID_array;
+}
+
+void arrayst::convert_atoms(const exprt &constraint)
+{
+  if(
+    constraint.id() == ID_and || constraint.id() == ID_or ||
+    constraint.id() == ID_not || constraint.id() == ID_implies)
+  {
+    for(const auto &op : constraint.operands())
+      convert_atoms(op);
+  }
+  else if(is_bit_vector_equality(constraint))
+  {
+    convert_bv(to_equal_expr(constraint).lhs());
+    convert_bv(to_equal_expr(constraint).rhs());
+  }
+  else
+    convert(constraint);
+}
+
+bool arrayst::holds_in_model(const exprt &constraint)
+{
+  if(constraint.id() == ID_and)
+  {
+    for(const auto &op : constraint.operands())
+    {
+      if(!holds_in_model(op))
+        return false;
+    }
+    return true;
+  }
+  else if(constraint.id() == ID_or)
+  {
+    for(const auto &op : constraint.operands())
+    {
+      if(holds_in_model(op))
+        return true;
+    }
+    return false;
+  }
+  else if(constraint.id() == ID_not)
+    return !holds_in_model(to_not_expr(constraint).op());
+  else if(constraint.id() == ID_implies)
+  {
+    const implies_exprt &implies = to_implies_expr(constraint);
+    return !holds_in_model(implies.op0()) || holds_in_model(implies.op1());
+  }
+  else if(is_bit_vector_equality(constraint))
+  {
+    // compare the bits of the operands, which \ref convert_atoms converted
+    const bvt lhs = convert_bv(to_equal_expr(constraint).lhs());
+    const bvt &rhs = convert_bv(to_equal_expr(constraint).rhs());
+    if(lhs.size() != rhs.size())
+      return false;
+
+    for(std::size_t i = 0; i < lhs.size(); ++i)
+    {
+      const tvt value = prop.l_get(lhs[i]);
+      if(!value.is_known() || value != prop.l_get(rhs[i]))
+        return false;
+    }
+    return true;
+  }
+
+  return prop.l_get(convert(constraint)).is_true();
+}
+
 void arrayst::add_array_constraints()
 {
   collect_indices();
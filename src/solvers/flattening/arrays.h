@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <set>
 #include <unordered_set>
 
+#include <util/optional.h>
 #include <util/union_find.h>
 
 #include "equality.h"
@@ -50,6 +51,18 @@ public:
   literalt record_array_equality(const equal_exprt &expr);
   void record_array_index(const index_exprt &expr);
 
+  /// Add the array constraints to the formula only once they are violated
+  /// by a satisfying assignment, solving again until no constraint is
+  /// violated. Constraints are checked against the values of their atoms,
+  /// which avoids encoding those that are satisfied anyway. Constraints are
+  /// added after solving, hence the SAT solver must not eliminate variables.
+  void enable_lazy_array_constraints()
+  {
+    model_guided_arrays = true;
+  }
+
+  decision_proceduret::resultt dec_solve() override;
+
 protected:
   const namespacet &ns;
   messaget log;
@@ -107,12 +120,26 @@ protected:
   };
 
   bool lazy_arrays;
+  bool model_guided_arrays = false;
   bool incremental_cache;
   bool get_array_constraints;
   std::list<lazy_constraintt> lazy_array_constraints;
   void add_array_constraint(const lazy_constraintt &lazy, bool refine = true);
   std::map<exprt, bool> expr_map;
 
+  /// Add the lazy array constraints that do not hold in the current
+  /// satisfying assignment
+  /// \return the number of constraints added
+  std::size_t add_violated_array_constraints();
+
+  /// Convert the operands of the equalities in \p constraint, but not the
+  /// equalities themselves, leaving their values to \ref holds_in_model
+  void convert_atoms(const exprt &constraint);
+
+  /// \return true if \p constraint holds in the current satisfying
+  ///   assignment
+  bool holds_in_model(const exprt &constraint);
+
   enum class constraint_typet
   {
     ARRAY_ACKERMANN,
@@ -162,6 +189,10 @@ protected:
 
   virtual bool is_unbounded_array(const typet &type) const=0;
     // (maybe this function should be partially moved here from boolbv)
+
+  virtual const bvt &convert_bv(
+    const exprt &expr,
+    const optionalt<std::size_t> expected_width = nullopt) = 0;
 };
 
 #endif // CPROVER_SOLVERS_FLATTENING_ARRAYS_H
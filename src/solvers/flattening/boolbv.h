@@ -14,11 +14,15 @@ Author: Daniel Kroening, kroening@kroening.com
 // convert expression to boolean formula
 //
 
+#include <map>
+#include <tuple>
+
 #include <util/endianness_map.h>
 #include <util/expr.h>
 #include <util/mp_arith.h>
 #include <util/optional.h>
 
+#include <solvers/lowering/expr_lowering.h>
 #include <solvers/lowering/functions.h>
 
 #include "bv_utils.h"
@@ -55,9 +59,9 @@ public:
   {
   }
 
-  virtual const bvt &convert_bv( // check cache
+  const bvt &convert_bv( // check cache
     const exprt &expr,
-    const optionalt<std::size_t> expected_width = nullopt);
+    const optionalt<std::size_t> expected_width = nullopt) override;
 
   virtual bvt convert_bitvector(const exprt &expr); // no cache
 
@@ -70,6 +74,8 @@ public:
   {
     SUB::clear_cache();
     bv_cache.clear();
+    float_op_cache.clear();
+    byte_operator_lowering_cache.clear();
   }
 
   void post_process() override
@@ -77,11 +83,28 @@ public:
     post_process_quantifiers();
     functions.post_process();
     SUB::post_process();
+
+    if(bv_utils.number_of_avoided_gates != 0)
+    {
+      log.statistics() << "Constant or repeated inputs simplified "
+                       << bv_utils.number_of_avoided_gates
+                       << " full adders and carries" << messaget::eom;
+    }
+    if(number_of_cached_float_ops != 0)
+    {
+      log.statistics() << "Reused " << number_of_cached_float_ops
+                       << " floating-point operations" << messaget::eom;
+    }
   }
 
   enum class unbounded_arrayt { U_NONE, U_ALL, U_AUTO };
   unbounded_arrayt unbounded_array;
 
+  void set_multiplier_encoding(bv_utilst::multiplier_encodingt encoding)
+  {
+    bv_utils.multiplier_encoding = encoding;
+  }
+
   mp_integer get_value(const bvt &bv)
   {
     return get_value(bv, 0, bv.size());
@@ -129,6 +152,18 @@ protected:
   typedef std::unordered_map<const exprt, bvt, irep_hash> bv_cachet;
   bv_cachet bv_cache;
 
+  /// Lowerings of the expressions over unbounded arrays that contain byte
+  /// operators, which many such expressions share
+  byte_operator_lowering_cachet byte_operator_lowering_cache;
+
+  /// Results of floating-point operations by operator, format, rounding mode
+  /// and operands, which lets different expressions over the same literals,
+  /// as in unrolled loops, share a single circuit
+  typedef std::tuple<irep_idt, std::size_t, std::size_t, bvt, bvt, bvt>
+    float_op_keyt;
+  std::map<float_op_keyt, bvt> float_op_cache;
+  std::size_t number_of_cached_float_ops = 0;
+
   bool type_conversion(
     const typet &src_type, const bvt &src,
     const typet &dest_type, bvt &dest);
@@ -200,6 +235,11 @@ protected:
     const bvt &prev_bv,
     bvt &next_bv);
 
+  /// Convert nested updates of a bounded array in one go, without
+  /// converting the intermediate arrays, and skipping the updates of an
+  /// element that are overwritten by later ones
+  bvt convert_with_array_chain(const with_exprt &expr);
+
   void convert_with_bv(
     const exprt &op1,
     const exprt &op2,
@@ -99,22 +99,54 @@ bvt boolbvt::convert_floatbv_op(const ieee_float_op_exprt &expr)
 
   float_utils.set_rounding_mode(rounding_mode_as_bv);
 
+  // build each circuit once for the same operands, in either order for the
+  // commutative operators
+  const auto float_op = [&](bvt lhs_bv, bvt rhs_bv) {
+    if(
+      (expr.id() == ID_floatbv_plus || expr.id() == ID_floatbv_mult) &&
+      rhs_bv < lhs_bv)
+    {
+      std::swap(lhs_bv, rhs_bv);
+    }
+
+    float_op_keyt key{expr.id(),
+                      float_utils.spec.width(),
+                      float_utils.spec.f,
+                      rounding_mode_as_bv,
+                      std::move(lhs_bv),
+                      std::move(rhs_bv)};
+    const auto entry = float_op_cache.find(key);
+    if(entry != float_op_cache.end())
+    {
+      ++number_of_cached_float_ops;
+      return entry->second;
+    }
+
+    const bvt &lhs_key = std::get<4>(key);
+    const bvt &rhs_key = std::get<5>(key);
+    bvt result;
+    if(expr.id() == ID_floatbv_plus)
+      result = float_utils.add_sub(lhs_key, rhs_key, false);
+    else if(expr.id() == ID_floatbv_minus)
+      result = float_utils.add_sub(lhs_key, rhs_key, true);
+    else if(expr.id() == ID_floatbv_mult)
+      result = float_utils.mul(lhs_key, rhs_key);
+    else if(expr.id() == ID_floatbv_div)
+      result = float_utils.div(lhs_key, rhs_key);
+    else if(expr.id() == ID_floatbv_rem)
+      result = float_utils.rem(lhs_key, rhs_key);
+    else
+      UNREACHABLE;
+
+    float_op_cache.emplace(std::move(key), result);
+    return result;
+  };
+
   if(expr.type().id() == ID_floatbv)
   {
     float_utils.spec=ieee_float_spect(to_floatbv_type(expr.type()));
 
-    if(expr.id()==ID_floatbv_plus)
-      return float_utils.add_sub(lhs_as_bv, rhs_as_bv, false);
-    else if(expr.id()==ID_floatbv_minus)
-      return float_utils.add_sub(lhs_as_bv, rhs_as_bv, true);
-    else if(expr.id()==ID_floatbv_mult)
-      return float_utils.mul(lhs_as_bv, rhs_as_bv);
-    else if(expr.id()==ID_floatbv_div)
-      return float_utils.div(lhs_as_bv, rhs_as_bv);
-    else if(expr.id()==ID_floatbv_rem)
-      return float_utils.rem(lhs_as_bv, rhs_as_bv);
-    else
-      UNREACHABLE;
+    return float_op(lhs_as_bv, rhs_as_bv);
   }
   else if(expr.type().id() == ID_vector || expr.type().id() == ID_complex)
   {
@@ -147,16 +179,8 @@ bvt boolbvt::convert_floatbv_op(const ieee_float_op_exprt &expr)
           rhs_as_bv.begin() + i * sub_width,
           rhs_as_bv.begin() + (i + 1) * sub_width);
 
-        if(expr.id()==ID_floatbv_plus)
-          sub_result_bv = float_utils.add_sub(lhs_sub_bv, rhs_sub_bv, false);
-        else if(expr.id()==ID_floatbv_minus)
-          sub_result_bv = float_utils.add_sub(lhs_sub_bv, rhs_sub_bv, true);
-        else if(expr.id()==ID_floatbv_mult)
-          sub_result_bv = float_utils.mul(lhs_sub_bv, rhs_sub_bv);
-        else if(expr.id()==ID_floatbv_div)
-          sub_result_bv = float_utils.div(lhs_sub_bv, rhs_sub_bv);
-        else
-          UNREACHABLE;
+        PRECONDITION(expr.id() != ID_floatbv_rem);
+        sub_result_bv = float_op(lhs_sub_bv, rhs_sub_bv);
 
         INVARIANT(
           sub_result_bv.size() == sub_width,
@@ -16,6 +16,48 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "boolbv_type.h"
 
+using model_wordt = mp_integer::ullong_t;
+static const std::size_t model_word_bits = sizeof(model_wordt) * 8;
+
+/// \return the values of the literals `bv[offset]` to
+///   `bv[offset + width - 1]` in the model of \p prop, where unknown ones are
+///   false, packed into machine words, the least significant first
+static std::vector<model_wordt> get_model_words(
+  const propt &prop,
+  const bvt &bv,
+  std::size_t offset,
+  std::size_t width)
+{
+  PRECONDITION(bv.size() >= offset + width);
+
+  std::vector<model_wordt> words(
+    (width + model_word_bits - 1) / model_word_bits, 0);
+
+  for(std::size_t i = 0; i < width; i++)
+  {
+    if(prop.l_get(bv[offset + i]).is_true())
+      words[i / model_word_bits] |= model_wordt(1) << (i % model_word_bits);
+  }
+
+  return words;
+}
+
+static mp_integer model_words2integer(const std::vector<model_wordt> &words)
+{
+  if(words.size() == 1)
+    return words.front();
+
+  const mp_integer word_base = power(2, model_word_bits);
+  mp_integer value = 0;
+  for(auto it = words.rbegin(); it != words.rend(); ++it)
+  {
+    value *= word_base;
+    value += *it;
+  }
+
+  return value;
+}
+
 exprt boolbvt::get(const exprt &expr) const
 {
   if(expr.id()==ID_symbol ||
@@ -191,23 +233,8 @@ exprt boolbvt::bv_get_rec(
     }
   }
 
-  // most significant bit first
-  std::string value;
-
-  for(std::size_t bit_nr=offset; bit_nr<offset+width; bit_nr++)
-  {
-    char ch = '0';
-    // clang-format off
-    switch(prop.l_get(bv[bit_nr]).get_value())
-    {
-    case tvt::tv_enumt::TV_FALSE: ch = '0'; break;
-    case tvt::tv_enumt::TV_TRUE: ch = '1'; break;
-    case tvt::tv_enumt::TV_UNKNOWN: ch = '0'; break;
-    }
-    // clang-format on
-
-    value=ch+value;
-  }
+  const std::vector<model_wordt> words =
+    get_model_words(prop, bv, offset, width);
 
   switch(bvtype)
   {
@@ -215,7 +242,7 @@ exprt boolbvt::bv_get_rec(
     PRECONDITION(type.id() == ID_string || type.id() == ID_empty);
     if(type.id()==ID_string)
     {
-      mp_integer int_value=binary2integer(value, false);
+      mp_integer int_value = model_words2integer(words);
       irep_idt s;
       if(int_value>=string_numbering.size())
         s=irep_idt();
@@ -232,7 +259,7 @@ exprt boolbvt::bv_get_rec(
 
   case bvtypet::IS_RANGE:
   {
-    mp_integer int_value = binary2integer(value, false);
+    mp_integer int_value = model_words2integer(words);
     mp_integer from = string2integer(type.get_string(ID_from));
 
     return constant_exprt(integer2string(int_value + from), type);
@@ -250,8 +277,15 @@ exprt boolbvt::bv_get_rec(
   case bvtypet::IS_BV:
   case bvtypet::IS_C_ENUM:
   {
-    const irep_idt bvrep = make_bvrep(
-      width, [&value](size_t i) { return value[value.size() - i - 1] == '1'; });
+    if(width <= model_word_bits)
+    {
+      return constant_exprt(
+        integer2bvrep(model_words2integer(words), width), type);
+    }
+
+    const irep_idt bvrep = make_bvrep(width, [&words](std::size_t i) {
+      return ((words[i / model_word_bits] >> (i % model_word_bits)) & 1) != 0;
+    });
     return constant_exprt(bvrep, type);
   }
   }
@@ -378,22 +412,5 @@ mp_integer boolbvt::get_value(
   std::size_t offset,
   std::size_t width)
 {
-  mp_integer value=0;
-  mp_integer weight=1;
-
-  for(std::size_t bit_nr=offset; bit_nr<offset+width; bit_nr++)
-  {
-    assert(bit_nr<bv.size());
-    switch(prop.l_get(bv[bit_nr]).get_value())
-    {
-     case tvt::tv_enumt::TV_FALSE:   break;
-     case tvt::tv_enumt::TV_TRUE:    value+=weight; break;
-     case tvt::tv_enumt::TV_UNKNOWN: break;
-     default: assert(false);
-    }
-
-    weight*=2;
-  }
-
-  return value;
+  return model_words2integer(get_model_words(prop, bv, offset, width));
 }
@@ -48,7 +48,8 @@ bvt boolbvt::convert_index(const index_exprt &expr)
       if(has_byte_operator(expr))
       {
         const index_exprt final_expr =
-          to_index_expr(lower_byte_operators(expr, ns));
+          to_index_expr(
+            lower_byte_operators(expr, ns, byte_operator_lowering_cache));
         CHECK_RETURN(final_expr != expr);
         bv = convert_bv(final_expr);
 
@@ -12,8 +12,17 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/c_types.h>
 #include <util/std_expr.h>
 
+#include <unordered_set>
+
 bvt boolbvt::convert_with(const with_exprt &expr)
 {
+  if(
+    expr.type().id() == ID_array && expr.old().id() == ID_with &&
+    boolbv_width(expr.type()) != 0)
+  {
+    return convert_with_array_chain(expr);
+  }
+
   bvt bv = convert_bv(expr.old());
 
   std::size_t width=boolbv_width(expr.type());
@@ -47,6 +56,119 @@ bvt boolbvt::convert_with(const with_exprt &expr)
   return bv;
 }
 
+bvt boolbvt::convert_with_array_chain(const with_exprt &expr)
+{
+  const array_typet &type = to_array_type(expr.type());
+
+  DATA_INVARIANT_WITH_DIAGNOSTICS(
+    !is_unbounded_array(type),
+    "convert_with_array_chain called for unbounded array",
+    irep_pretty_diagnosticst{type});
+
+  const auto size = numeric_cast<mp_integer>(type.size());
+
+  DATA_INVARIANT_WITH_DIAGNOSTICS(
+    size.has_value(),
+    "convert_with_array_chain expects constant array size",
+    irep_pretty_diagnosticst{type});
+
+  // collect the updates, the last one first, down to an array that is not
+  // an update or has been converted already
+  std::vector<std::pair<const exprt *, const exprt *>> updates;
+  const exprt *array = &expr;
+  do
+  {
+    const exprt::operandst &ops = array->operands();
+    for(std::size_t op_no = ops.size() - 1; op_no > 1; op_no -= 2)
+      updates.emplace_back(&ops[op_no - 1], &ops[op_no]);
+    array = &to_with_expr(*array).old();
+  } while(array->id() == ID_with && bv_cache.find(*array) == bv_cache.end());
+
+  bvt bv = convert_bv(*array);
+
+  DATA_INVARIANT_WITH_DIAGNOSTICS(
+    bv.size() == boolbv_width(type),
+    "unexpected operand 0 width",
+    irep_pretty_diagnosticst{expr});
+
+  const std::size_t number_of_elements = numeric_cast_v<std::size_t>(*size);
+  const std::size_t element_width = bv.size() / number_of_elements;
+
+  // For each element, the position of the last update with that constant
+  // index, which makes all earlier updates of the element irrelevant. An
+  // update with the same index as a later one is irrelevant altogether.
+  std::vector<std::size_t> last_constant_update(
+    number_of_elements, updates.size());
+  std::vector<bool> overwritten(updates.size(), false);
+  std::unordered_set<exprt, irep_hash> later_indices;
+
+  for(std::size_t position = 0; position < updates.size(); ++position)
+  {
+    const exprt &index = *updates[position].first;
+
+    if(!later_indices.insert(index).second)
+    {
+      overwritten[position] = true;
+      continue;
+    }
+
+    const auto index_value = numeric_cast<mp_integer>(index);
+    if(index_value.has_value())
+    {
+      if(*index_value >= 0 && *index_value < *size) // bounds check
+      {
+        const std::size_t element = numeric_cast_v<std::size_t>(*index_value);
+        if(last_constant_update[element] == updates.size())
+          last_constant_update[element] = position;
+      }
+      else
+        overwritten[position] = true;
+    }
+  }
+
+  // apply the updates, the first one first
+  for(std::size_t position = updates.size(); position-- > 0;)
+  {
+    if(overwritten[position])
+      continue;
+
+    const exprt &index = *updates[position].first;
+    const bvt &value_bv = convert_bv(*updates[position].second);
+
+    DATA_INVARIANT_WITH_DIAGNOSTICS(
+      value_bv.size() == element_width,
+      "convert_with_array_chain: unexpected update width",
+      irep_pretty_diagnosticst{expr});
+
+    if(const auto index_value = numeric_cast<mp_integer>(index))
+    {
+      const std::size_t offset =
+        numeric_cast_v<std::size_t>(*index_value) * element_width;
+
+      for(std::size_t j = 0; j < element_width; j++)
+        bv[offset + j] = value_bv[j];
+
+      continue;
+    }
+
+    for(std::size_t element = 0; element < number_of_elements; ++element)
+    {
+      if(last_constant_update[element] < position)
+        continue;
+
+      literalt eq_lit =
+        convert(equal_exprt(index, from_integer(element, index.type())));
+
+      const std::size_t offset = element * element_width;
+
+      for(std::size_t j = 0; j < element_width; j++)
+        bv[offset + j] = prop.lselect(eq_lit, value_bv[j], bv[offset + j]);
+    }
+  }
+
+  return bv;
+}
+
 void boolbvt::convert_with(
   const typet &type,
   const exprt &op1,
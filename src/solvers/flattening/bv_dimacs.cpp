@@ -34,6 +34,16 @@ bool bv_dimacst::write_dimacs()
 
 bool bv_dimacst::write_dimacs(std::ostream &out)
 {
+  // the variables in the mapping below must keep their meaning when the
+  // clauses are simplified
+  for(const auto &s : get_symbols())
+    prop.set_frozen(s.second);
+  for(const auto &m : get_map().get_mapping())
+  {
+    for(const auto &lit : m.second.literal_map)
+      prop.set_frozen(lit);
+  }
+
   dynamic_cast<dimacs_cnft &>(prop).write_dimacs_cnf(out);
 
   // we dump the mapping variable<->literals
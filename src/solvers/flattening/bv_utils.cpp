@@ -10,6 +10,24 @@ Author: Daniel Kroening, kroening@kroening.com
 
 bvt bv_utilst::build_constant(const mp_integer &n, std::size_t width)
 {
+  // Take the bits of values that fit into a machine word directly rather
+  // than from a binary string.
+  const bool is_word = !n.is_negative() && n.is_ulong();
+  if(is_word || n.is_long())
+  {
+    const mp_integer::ullong_t word =
+      is_word ? n.to_ulong() : mp_integer::ullong_t(n.to_long());
+    const std::size_t word_bits = sizeof(word) * 8;
+    bvt result;
+    result.reserve(width);
+    for(std::size_t i = 0; i < width; i++)
+    {
+      result.push_back(const_literal(
+        i < word_bits ? ((word >> i) & 1) != 0 : n.is_negative()));
+    }
+    return result;
+  }
+
   std::string n_str=integer2binary(n, width);
   CHECK_RETURN(n_str.size() == width);
   bvt result;
@@ -139,76 +157,81 @@ literalt bv_utilst::full_adder(
   const literalt carry_in,
   literalt &carry_out)
 {
-  #ifdef OPTIMAL_FULL_ADDER
-  if(prop.has_set_to() && prop.cnf_handled_well())
+  // constant or repeated inputs reduce the full adder to at most two gates
+  const literalt inputs[3] = {a, b, carry_in};
+  for(std::size_t i = 0; i < 3; ++i)
   {
-    literalt x;
-    literalt y;
-    int constantProp = -1;
-
-    if(a.is_constant())
+    if(inputs[i].is_constant())
     {
-      x = b;
-      y = carry_in;
-      constantProp = (a.is_true()) ? 1 : 0;
-    }
-    else if(b.is_constant())
-    {
-      x = a;
-      y = carry_in;
-      constantProp = (b.is_true()) ? 1 : 0;
-    }
-    else if(carry_in.is_constant())
-    {
-      x = a;
-      y = b;
-      constantProp = (carry_in.is_true()) ? 1 : 0;
+      const literalt x = inputs[(i + 1) % 3];
+      const literalt y = inputs[(i + 2) % 3];
+      ++number_of_avoided_gates;
+
+      // Rely on prop.l* to do further constant propagation
+      if(inputs[i].is_true())
+      {
+        carry_out = prop.lor(x, y);
+        return prop.lequal(x, y);
+      }
+      else
+      {
+        carry_out = prop.land(x, y);
+        return prop.lxor(x, y);
+      }
     }
+  }
 
-    literalt sum;
+  for(std::size_t i = 0; i < 3; ++i)
+  {
+    const literalt x = inputs[(i + 1) % 3];
+    const literalt y = inputs[(i + 2) % 3];
 
-    // Rely on prop.l* to do further constant propagation
-    if(constantProp == 1)
-    {
-      // At least one input bit is 1
-      carry_out = prop.lor(x, y);
-      sum = prop.lequal(x, y);
-    }
-    else if(constantProp == 0)
+    // x+x+z = 2x+z
+    if(x == y)
     {
-      // At least one input bit is 0
-      carry_out = prop.land(x, y);
-      sum = prop.lxor(x, y);
+      ++number_of_avoided_gates;
+      carry_out = x;
+      return inputs[i];
     }
-    else
+
+    // x+x'+z = 1+z
+    if(x == !y)
     {
-      carry_out = prop.new_variable();
-      sum = prop.new_variable();
-
-      // Any two inputs 1 will set the carry_out to 1
-      prop.lcnf(!a,        !b, carry_out);
-      prop.lcnf(!a, !carry_in, carry_out);
-      prop.lcnf(!b, !carry_in, carry_out);
-
-      // Any two inputs 0 will set the carry_out to 0
-      prop.lcnf(a,        b, !carry_out);
-      prop.lcnf(a, carry_in, !carry_out);
-      prop.lcnf(b, carry_in, !carry_out);
-
-      // If both carry out and sum are 1 then all inputs are 1
-      prop.lcnf(a, !sum, !carry_out);
-      prop.lcnf(b, !sum, !carry_out);
-      prop.lcnf(carry_in, !sum, !carry_out);
-
-      // If both carry out and sum are 0 then all inputs are 0
-      prop.lcnf(!a, sum, carry_out);
-      prop.lcnf(!b, sum, carry_out);
-      prop.lcnf(!carry_in, sum, carry_out);
-
-      // If all of the inputs are 1 or all are 0 it sets the sum
-      prop.lcnf(!a, !b, !carry_in,  sum);
-      prop.lcnf(a,  b,  carry_in, !sum);
+      ++number_of_avoided_gates;
+      carry_out = inputs[i];
+      return !inputs[i];
     }
+  }
+
+  #ifdef OPTIMAL_FULL_ADDER
+  if(prop.has_set_to() && prop.cnf_handled_well())
+  {
+    carry_out = prop.new_variable();
+    literalt sum = prop.new_variable();
+
+    // Any two inputs 1 will set the carry_out to 1
+    prop.lcnf(!a,        !b, carry_out);
+    prop.lcnf(!a, !carry_in, carry_out);
+    prop.lcnf(!b, !carry_in, carry_out);
+
+    // Any two inputs 0 will set the carry_out to 0
+    prop.lcnf(a,        b, !carry_out);
+    prop.lcnf(a, carry_in, !carry_out);
+    prop.lcnf(b, carry_in, !carry_out);
+
+    // If both carry out and sum are 1 then all inputs are 1
+    prop.lcnf(a, !sum, !carry_out);
+    prop.lcnf(b, !sum, !carry_out);
+    prop.lcnf(carry_in, !sum, !carry_out);
+
+    // If both carry out and sum are 0 then all inputs are 0
+    prop.lcnf(!a, sum, carry_out);
+    prop.lcnf(!b, sum, carry_out);
+    prop.lcnf(!carry_in, sum, carry_out);
+
+    // If all of the inputs are 1 or all are 0 it sets the sum
+    prop.lcnf(!a, !b, !carry_in,  sum);
+    prop.lcnf(a,  b,  carry_in, !sum);
 
     return sum;
   }
@@ -226,28 +249,33 @@ literalt bv_utilst::full_adder(
 
 literalt bv_utilst::carry(literalt a, literalt b, literalt c)
 {
+  // constant or repeated inputs reduce the carry to at most one gate
+  const literalt inputs[3] = {a, b, c};
+  for(std::size_t i = 0; i < 3; ++i)
+  {
+    const literalt x = inputs[(i + 1) % 3];
+    const literalt y = inputs[(i + 2) % 3];
+
+    if(inputs[i].is_constant())
+    {
+      ++number_of_avoided_gates;
+      return inputs[i].is_true() ? prop.lor(x, y) : prop.land(x, y);
+    }
+    else if(x == y)
+    {
+      ++number_of_avoided_gates;
+      return x;
+    }
+    else if(x == !y)
+    {
+      ++number_of_avoided_gates;
+      return inputs[i];
+    }
+  }
+
   #ifdef COMPACT_CARRY
   if(prop.has_set_to() && prop.cnf_handled_well())
   {
-    // propagation possible?
-    const auto const_count =
-      a.is_constant() + b.is_constant() + c.is_constant();
-
-    // propagation is possible if two or three inputs are constant
-    if(const_count>=2)
-      return prop.lor(prop.lor(
-          prop.land(a, b),
-          prop.land(a, c)),
-          prop.land(b, c));
-
-    // it's also possible if two of a,b,c are the same
-    if(a==b)
-      return a;
-    else if(a==c)
-      return a;
-    else if(b==c)
-      return b;
-
     // the below yields fewer clauses and variables,
     // but doesn't propagate anything at all
 
@@ -628,48 +656,98 @@ bvt bv_utilst::wallace_tree(const std::vector<bvt> &pps)
   }
 }
 
-bvt bv_utilst::unsigned_multiplier(const bvt &_op0, const bvt &_op1)
+bvt bv_utilst::dadda_tree(const std::vector<bvt> &pps)
 {
-  #if 1
-  bvt op0=_op0, op1=_op1;
-
-  if(is_constant(op1))
-    std::swap(op0, op1);
+  PRECONDITION(!pps.empty());
 
-  bvt product;
-  product.resize(op0.size());
+  const std::size_t width = pps.front().size();
 
-  for(std::size_t i=0; i<product.size(); i++)
-    product[i]=const_literal(false);
-
-  for(std::size_t sum=0; sum<op0.size(); sum++)
-    if(op0[sum]!=const_literal(false))
+  // the bits of the partial products by weight
+  std::vector<bvt> columns(width);
+  for(const auto &pp : pps)
+  {
+    INVARIANT(pp.size() == width, "partial products should be of equal size");
+    for(std::size_t bit = 0; bit < width; bit++)
     {
-      bvt tmpop;
+      if(!pp[bit].is_false())
+        columns[bit].push_back(pp[bit]);
+    }
+  }
 
-      tmpop.reserve(op0.size());
+  std::size_t max_height = 0;
+  for(const auto &column : columns)
+    max_height = std::max(max_height, column.size());
 
-      for(std::size_t idx=0; idx<sum; idx++)
-        tmpop.push_back(const_literal(false));
-
-      for(std::size_t idx=sum; idx<op0.size(); idx++)
-        tmpop.push_back(prop.land(op1[idx-sum], op0[sum]));
+  // Dadda's sequence of column heights: 2, 3, 4, 6, 9, 13, ...
+  std::vector<std::size_t> heights{2};
+  while(heights.back() * 3 / 2 < max_height)
+    heights.push_back(heights.back() * 3 / 2);
 
-      product=add(product, tmpop);
+  // reduce the columns to each height in turn, using as few adders as
+  // possible; carries out of the most significant column are dropped
+  for(auto height_it = heights.rbegin(); height_it != heights.rend();
+      ++height_it)
+  {
+    for(std::size_t bit = 0; bit < width; bit++)
+    {
+      bvt &column = columns[bit];
+      while(column.size() > *height_it)
+      {
+        literalt sum, carry;
+        if(column.size() == *height_it + 1)
+        {
+          // half adder
+          const literalt a = column.back();
+          column.pop_back();
+          const literalt b = column.back();
+          column.pop_back();
+          sum = prop.lxor(a, b);
+          carry = prop.land(a, b);
+        }
+        else
+        {
+          const literalt a = column.back();
+          column.pop_back();
+          const literalt b = column.back();
+          column.pop_back();
+          const literalt c = column.back();
+          column.pop_back();
+          sum = full_adder(a, b, c, carry);
+        }
+
+        // new bits go to the bottom, such that the remaining original bits
+        // are reduced first
+        column.insert(column.begin(), sum);
+        if(bit + 1 < width)
+          columns[bit + 1].insert(columns[bit + 1].begin(), carry);
+      }
     }
+  }
 
-  return product;
-  #else
-  // Wallace tree multiplier. This is disabled, as runtimes have
-  // been observed to go up by 5%-10%, and on some models even by 20%.
+  bvt a = zeros(width), b = zeros(width);
+  for(std::size_t bit = 0; bit < width; bit++)
+  {
+    if(!columns[bit].empty())
+      a[bit] = columns[bit][0];
+    if(columns[bit].size() > 1)
+      b[bit] = columns[bit][1];
+  }
 
-  // build the usual quadratic number of partial products
+  return add(a, b);
+}
 
-  bvt op0=_op0, op1=_op1;
+bvt bv_utilst::adder_tree(const std::vector<bvt> &pps)
+{
+  PRECONDITION(!pps.empty());
 
-  if(is_constant(op1))
-    std::swap(op0, op1);
+  if(multiplier_encoding == multiplier_encodingt::DADDA_TREE)
+    return dadda_tree(pps);
+  else
+    return wallace_tree(pps);
+}
 
+std::vector<bvt> bv_utilst::partial_products(const bvt &op0, const bvt &op1)
+{
   std::vector<bvt> pps;
   pps.reserve(op0.size());
 
@@ -690,12 +768,178 @@ bvt bv_utilst::unsigned_multiplier(const bvt &_op0, const bvt &_op1)
       pps.push_back(pp);
     }
 
+  return pps;
+}
+
+std::vector<bvt>
+bv_utilst::constant_partial_products(const bvt &op, const bvt &constant)
+{
+  PRECONDITION(is_constant(constant));
+
+  const std::size_t width = op.size();
+  std::vector<bvt> pps;
+  std::size_t negative_digits = 0;
+
+  // Compute the digits of the non-adjacent form from the least significant
+  // bit, replacing each run of ones by +2^(i+1) - 2^j. Digits beyond the
+  // width do not affect the product.
+  bool carry = false;
+  for(std::size_t bit = 0; bit < width; bit++)
+  {
+    const bool current = constant[bit].is_true();
+    const bool next = bit + 1 < width && constant[bit + 1].is_true();
+
+    if(current == carry)
+    {
+      // a digit of 0, and the carry (if any) moves on
+      continue;
+    }
+
+    // the sum of the bit and the carry is odd
+    const bvt shifted = shift(op, shiftt::SHIFT_LEFT, bit);
+    if(next)
+    {
+      // digit -1: -x = ~x + 1
+      pps.push_back(inverted(shifted));
+      ++negative_digits;
+      carry = true;
+    }
+    else
+    {
+      pps.push_back(shifted);
+      carry = false;
+    }
+  }
+
+  if(negative_digits != 0)
+    pps.push_back(build_constant(negative_digits, width));
+
+  return pps;
+}
+
+bvt bv_utilst::unsigned_karatsuba_full_multiplier(
+  const bvt &op0,
+  const bvt &op1)
+{
+  PRECONDITION(op0.size() == op1.size());
+
+  const std::size_t op_size = op0.size();
+
+  if(op_size <= 8 || op_size % 2 != 0)
+  {
+    bvt ext0 = zero_extension(op0, op_size * 2);
+    bvt ext1 = zero_extension(op1, op_size * 2);
+    std::vector<bvt> pps = partial_products(ext0, ext1);
+    return pps.empty() ? zeros(op_size * 2) : wallace_tree(pps);
+  }
+
+  // With op0 = a1 * 2^h + a0 and op1 = b1 * 2^h + b0, the product is
+  // z2 * 2^(2h) + z1 * 2^h + z0 for z2 = a1 * b1, z0 = a0 * b0 and
+  // z1 = a1 * b0 + a0 * b1 = (a0 - a1) * (b1 - b0) + z0 + z2, which takes
+  // three multiplications of half the width instead of four.
+  const std::size_t half = op_size / 2;
+  const bvt a0 = extract_lsb(op0, half), a1 = extract_msb(op0, half);
+  const bvt b0 = extract_lsb(op1, half), b1 = extract_msb(op1, half);
+
+  const bvt z0 = unsigned_karatsuba_full_multiplier(a0, b0);
+  const bvt z2 = unsigned_karatsuba_full_multiplier(a1, b1);
+
+  // the differences take an extra bit for their sign
+  const bvt diff_a =
+    sub(zero_extension(a0, half + 1), zero_extension(a1, half + 1));
+  const bvt diff_b =
+    sub(zero_extension(b1, half + 1), zero_extension(b0, half + 1));
+  const literalt diff_negative = prop.lxor(diff_a[half], diff_b[half]);
+  const bvt diff_product = unsigned_karatsuba_full_multiplier(
+    extract_lsb(absolute_value(diff_a), half),
+    extract_lsb(absolute_value(diff_b), half));
+
+  // all sums are computed modulo 2^(2 * op_size), which is exact, as is the
+  // product
+  const std::size_t width = op_size * 2;
+  const bvt z1 = add(
+    cond_negate(zero_extension(diff_product, width), diff_negative),
+    add(zero_extension(z0, width), zero_extension(z2, width)));
+
+  return add(
+    add(zero_extension(z0, width), shift(z1, shiftt::SHIFT_LEFT, half)),
+    shift(zero_extension(z2, width), shiftt::SHIFT_LEFT, half * 2));
+}
+
+bvt bv_utilst::unsigned_karatsuba_multiplier(const bvt &op0, const bvt &op1)
+{
+  const std::size_t op_size = op0.size();
+
+  if(op1.size() != op_size || op_size <= 8 || op_size % 2 != 0)
+  {
+    std::vector<bvt> pps = partial_products(op0, op1);
+    return pps.empty() ? zeros(op_size) : wallace_tree(pps);
+  }
+
+  // Only the least significant half of the cross terms a0 * b1 and a1 * b0
+  // and none of a1 * b1 contribute to the product modulo 2^op_size, hence
+  // just the product of the least significant halves takes Karatsuba's
+  // method.
+  const std::size_t half = op_size / 2;
+  const bvt a0 = extract_lsb(op0, half), a1 = extract_msb(op0, half);
+  const bvt b0 = extract_lsb(op1, half), b1 = extract_msb(op1, half);
+
+  const bvt z0 = unsigned_karatsuba_full_multiplier(a0, b0);
+  const bvt z1 = add(
+    unsigned_karatsuba_multiplier(a0, b1),
+    unsigned_karatsuba_multiplier(a1, b0));
+
+  return add(z0, concatenate(zeros(half), z1));
+}
+
+bvt bv_utilst::unsigned_multiplier(const bvt &_op0, const bvt &_op1)
+{
+  bvt op0=_op0, op1=_op1;
+
+  if(is_constant(op1))
+    std::swap(op0, op1);
+
+  if(multiplier_encoding == multiplier_encodingt::SHIFT_ADD)
+  {
+    bvt product;
+    product.resize(op0.size());
+
+    for(std::size_t i=0; i<product.size(); i++)
+      product[i]=const_literal(false);
+
+    for(std::size_t sum=0; sum<op0.size(); sum++)
+      if(op0[sum]!=const_literal(false))
+      {
+        bvt tmpop;
+
+        tmpop.reserve(op0.size());
+
+        for(std::size_t idx=0; idx<sum; idx++)
+          tmpop.push_back(const_literal(false));
+
+        for(std::size_t idx=sum; idx<op0.size(); idx++)
+          tmpop.push_back(prop.land(op1[idx-sum], op0[sum]));
+
+        product=add(product, tmpop);
+      }
+
+    return product;
+  }
+
+  // Wallace tree multipliers have been observed to increase runtimes by
+  // 5%-10%, and on some models even by 20%, hence they are not the default.
+  std::vector<bvt> pps;
+  if(is_constant(op0) && op0.size() == op1.size())
+    pps = constant_partial_products(op1, op0);
+  else if(multiplier_encoding == multiplier_encodingt::KARATSUBA)
+    return unsigned_karatsuba_multiplier(op0, op1);
+  else
+    pps = partial_products(op0, op1);
+
   if(pps.empty())
     return zeros(op0.size());
   else
-    return wallace_tree(pps);
-
-  #endif
+    return adder_tree(pps);
 }
 
 bvt bv_utilst::unsigned_multiplier_no_overflow(
@@ -27,6 +27,24 @@ public:
 
   enum class representationt { SIGNED, UNSIGNED };
 
+  /// Encodings of the unsigned multiplier: the sum of the shifted partial
+  /// products by a chain of adders, by a Wallace or Dadda tree of carry-save
+  /// adders, or by Karatsuba's method on top of Wallace trees. All encodings
+  /// except the first one recode constant operands into canonical signed
+  /// digits, which minimises the number of partial products.
+  enum class multiplier_encodingt
+  {
+    SHIFT_ADD,
+    WALLACE_TREE,
+    DADDA_TREE,
+    KARATSUBA
+  };
+  multiplier_encodingt multiplier_encoding = multiplier_encodingt::SHIFT_ADD;
+
+  /// Number of full adders and carries that constant or repeated inputs
+  /// reduced to fewer gates
+  std::size_t number_of_avoided_gates = 0;
+
   static bvt build_constant(const mp_integer &i, std::size_t width);
 
   bvt incrementer(const bvt &op, literalt carry_in);
@@ -241,6 +259,24 @@ protected:
   bvt cond_negate_no_overflow(const bvt &bv, const literalt cond);
 
   bvt wallace_tree(const std::vector<bvt> &pps);
+  bvt dadda_tree(const std::vector<bvt> &pps);
+
+  /// Sum \p pps with the tree selected by \ref multiplier_encoding
+  bvt adder_tree(const std::vector<bvt> &pps);
+
+  /// \return the partial products of \p op0 and \p op1
+  std::vector<bvt> partial_products(const bvt &op0, const bvt &op1);
+
+  /// \return partial products whose sum is the product of \p op and the
+  ///   constant \p constant, using its canonical signed digit representation
+  std::vector<bvt>
+  constant_partial_products(const bvt &op, const bvt &constant);
+
+  bvt unsigned_karatsuba_multiplier(const bvt &op0, const bvt &op1);
+
+  /// \return the product of \p op0 and \p op1, which are of the same width,
+  ///   with twice that width
+  bvt unsigned_karatsuba_full_multiplier(const bvt &op0, const bvt &op1);
 };
 
 #endif // CPROVER_SOLVERS_FLATTENING_BV_UTILS_H
@@ -2314,22 +2314,41 @@ bool has_byte_operator(const exprt &src)
   return false;
 }
 
-exprt lower_byte_operators(const exprt &src, const namespacet &ns)
+exprt lower_byte_operators(
+  const exprt &src,
+  const namespacet &ns,
+  byte_operator_lowering_cachet &cache)
 {
+  if(!src.has_operands())
+    return src;
+
+  const auto entry = cache.find(src);
+  if(entry != cache.end())
+    return entry->second;
+
   exprt tmp=src;
 
-  // destroys any sharing, should use hash table
   Forall_operands(it, tmp)
   {
-    *it = lower_byte_operators(*it, ns);
+    *it = lower_byte_operators(*it, ns, cache);
   }
 
+  exprt result;
   if(src.id()==ID_byte_update_little_endian ||
      src.id()==ID_byte_update_big_endian)
-    return lower_byte_update(to_byte_update_expr(tmp), ns);
+    result = lower_byte_update(to_byte_update_expr(tmp), ns);
   else if(src.id()==ID_byte_extract_little_endian ||
           src.id()==ID_byte_extract_big_endian)
-    return lower_byte_extract(to_byte_extract_expr(tmp), ns);
+    result = lower_byte_extract(to_byte_extract_expr(tmp), ns);
   else
-    return tmp;
+    result = std::move(tmp);
+
+  cache.emplace(src, result);
+  return result;
+}
+
+exprt lower_byte_operators(const exprt &src, const namespacet &ns)
+{
+  byte_operator_lowering_cachet cache;
+  return lower_byte_operators(src, ns, cache);
 }
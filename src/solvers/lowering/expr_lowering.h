@@ -11,6 +11,8 @@ Author: Michael Tautschnig
 
 #include <util/expr.h>
 
+#include <unordered_map>
+
 class byte_extract_exprt;
 class byte_update_exprt;
 class namespacet;
@@ -41,6 +43,26 @@ exprt lower_byte_update(const byte_update_exprt &src, const namespacet &ns);
 ///   byte_extract_exprt or \ref byte_update_exprt.
 exprt lower_byte_operators(const exprt &src, const namespacet &ns);
 
+/// Lowered expressions by the expressions they were lowered from, see
+/// \ref lower_byte_operators
+typedef std::unordered_map<exprt, exprt, irep_hash>
+  byte_operator_lowering_cachet;
+
+/// Rewrite an expression possibly containing byte-extract or -update
+/// expressions to more fundamental operations, looking up and storing the
+/// lowering of each subexpression in \p cache. Subexpressions that occur
+/// several times, such as the chains of byte updates that arise from
+/// \c memcpy, are thus lowered only once, and their lowerings are shared.
+/// \param src: Input expression
+/// \param ns: Namespace
+/// \param cache: Lowerings of expressions seen before
+/// \return Semantically equivalent expression that does not contain any \ref
+///   byte_extract_exprt or \ref byte_update_exprt.
+exprt lower_byte_operators(
+  const exprt &src,
+  const namespacet &ns,
+  byte_operator_lowering_cachet &cache);
+
 bool has_byte_operator(const exprt &src);
 
 #endif /* CPROVER_SOLVERS_LOWERING_EXPR_LOWERING_H */
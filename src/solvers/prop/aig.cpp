@@ -0,0 +1,154 @@
+/*******************************************************************\
+
+Module: And-Inverter Graph
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// And-Inverter Graph
+
+#include "aig.h"
+
+#include <util/narrow.h>
+
+literalt aigt::new_input()
+{
+  literalt l(narrow_cast<literalt::var_not>(nodes.size()), false);
+  nodes.emplace_back();
+  fanouts.push_back(0);
+  return l;
+}
+
+literalt aigt::new_and(literalt a, literalt b)
+{
+  if(a.is_false() || b.is_false())
+    return const_literal(false);
+  if(a.is_true())
+    return b;
+  if(b.is_true())
+    return a;
+  if(a == b)
+    return a;
+  if(a == !b)
+    return const_literal(false);
+
+  literalt result;
+  if(
+    (is_and(a) && rewrite(a, b, result)) ||
+    (is_and(b) && rewrite(b, a, result)))
+  {
+    ++rewrites;
+    return result;
+  }
+
+  if(b < a)
+    std::swap(a, b);
+
+  const std::uint64_t key = (std::uint64_t(a.get()) << 32) | b.get();
+  const auto entry = hash_table.find(key);
+  if(entry != hash_table.end())
+    return entry->second;
+
+  result = literalt(narrow_cast<literalt::var_not>(nodes.size()), false);
+  aig_nodet node;
+  node.a = a;
+  node.b = b;
+  nodes.push_back(node);
+  fanouts.push_back(0);
+  ++fanouts[a.var_no()];
+  ++fanouts[b.var_no()];
+  hash_table.emplace(key, result);
+
+  return result;
+}
+
+bool aigt::rewrite(literalt a, literalt b, literalt &result)
+{
+  const aig_nodet &node = get_node(a);
+  const literalt x = node.a;
+  const literalt y = node.b;
+
+  if(!a.sign())
+  {
+    // idempotence: (x*y)*x = x*y
+    if(b == x || b == y)
+    {
+      result = a;
+      return true;
+    }
+
+    // contradiction: (x*y)*x' = 0
+    if(b == !x || b == !y)
+    {
+      result = const_literal(false);
+      return true;
+    }
+
+    // contradiction: (x*y)*(x'*v) = 0
+    if(is_and(b) && !b.sign())
+    {
+      const aig_nodet &other = get_node(b);
+      if(
+        x == !other.a || x == !other.b || y == !other.a || y == !other.b)
+      {
+        result = const_literal(false);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  // subsumption: (x*y)'*x' = x'
+  if(b == !x || b == !y)
+  {
+    result = b;
+    return true;
+  }
+
+  // substitution: (x*y)'*x = x*y'
+  if(b == x)
+  {
+    result = new_and(b, !y);
+    return true;
+  }
+  if(b == y)
+  {
+    result = new_and(b, !x);
+    return true;
+  }
+
+  if(is_and(b))
+  {
+    const aig_nodet &other = get_node(b);
+
+    if(!b.sign())
+    {
+      // subsumption: (x*y)'*(x'*v) = x'*v
+      if(
+        x == !other.a || x == !other.b || y == !other.a || y == !other.b)
+      {
+        result = b;
+        return true;
+      }
+    }
+    else
+    {
+      // resolution: (x*y)'*(x*y')' = x'
+      if((x == other.a && y == !other.b) || (x == other.b && y == !other.a))
+      {
+        result = !x;
+        return true;
+      }
+      if((y == other.a && x == !other.b) || (y == other.b && x == !other.a))
+      {
+        result = !y;
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
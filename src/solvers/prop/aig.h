@@ -0,0 +1,100 @@
+/*******************************************************************\
+
+Module: And-Inverter Graph
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// And-Inverter Graph
+
+#ifndef CPROVER_SOLVERS_PROP_AIG_H
+#define CPROVER_SOLVERS_PROP_AIG_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "literal.h"
+
+/// A node of an And-Inverter Graph, which is either an input or the
+/// conjunction of two possibly negated nodes
+class aig_nodet
+{
+public:
+  /// The operands of a conjunction, or unused literals for an input
+  literalt a, b;
+
+  bool is_and() const
+  {
+    return a.var_no() != literalt::unused_var_no();
+  }
+
+  bool is_input() const
+  {
+    return !is_and();
+  }
+};
+
+/// And-Inverter Graph, in which a literal denotes the node with its variable
+/// number, possibly negated. Conjunctions are hashed structurally and
+/// simplified by local rewriting with the two-level rules of Brummayer and
+/// Biere, "Local Two-Level And-Inverter Graph Minimization without
+/// Blowup", MEMICS 2006.
+class aigt
+{
+public:
+  literalt new_input();
+
+  /// \return a literal for the conjunction of \p a and \p b, which is an
+  ///   existing literal when an equivalent node is found by hashing or
+  ///   rewriting
+  literalt new_and(literalt a, literalt b);
+
+  const aig_nodet &get_node(literalt l) const
+  {
+    return nodes[l.var_no()];
+  }
+
+  std::size_t number_of_nodes() const
+  {
+    return nodes.size();
+  }
+
+  /// \return the number of conjunctions of the node of \p l within the graph
+  std::size_t fanout(literalt l) const
+  {
+    return fanouts[l.var_no()];
+  }
+
+  /// \return the number of conjunctions simplified by local rewriting
+  std::size_t number_of_rewrites() const
+  {
+    return rewrites;
+  }
+
+protected:
+  std::vector<aig_nodet> nodes;
+  std::vector<std::size_t> fanouts;
+  std::size_t rewrites = 0;
+
+  /// Maps the operands of a conjunction, ordered and combined into a single
+  /// key, to its node
+  std::unordered_map<std::uint64_t, literalt> hash_table;
+
+  bool is_and(literalt l) const
+  {
+    return !l.is_constant() && get_node(l).is_and();
+  }
+
+  /// Apply the rewriting rules for the conjunction of \p a and \p b, in that
+  /// order, where \p a is the output of a conjunction
+  /// \param a: output of a conjunction
+  /// \param b: the other operand
+  /// \param [out] result: the simplified conjunction
+  /// \return true if a rule applies
+  bool rewrite(literalt a, literalt b, literalt &result);
+};
+
+#endif // CPROVER_SOLVERS_PROP_AIG_H
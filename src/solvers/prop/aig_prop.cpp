@@ -0,0 +1,336 @@
+/*******************************************************************\
+
+Module: Propositional Encoding via And-Inverter Graphs
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Propositional Encoding via And-Inverter Graphs
+
+#include "aig_prop.h"
+
+#include <unordered_set>
+
+#include <util/invariant.h>
+
+literalt aig_prop_solvert::land(literalt a, literalt b)
+{
+  return aig.new_and(a, b);
+}
+
+literalt aig_prop_solvert::lor(literalt a, literalt b)
+{
+  return !aig.new_and(!a, !b);
+}
+
+literalt aig_prop_solvert::land(const bvt &bv)
+{
+  if(bv.empty())
+    return const_literal(true);
+
+  // build a balanced tree to keep the graph shallow
+  bvt level = bv;
+  while(level.size() > 1)
+  {
+    bvt next;
+    next.reserve((level.size() + 1) / 2);
+    for(std::size_t i = 0; i + 1 < level.size(); i += 2)
+      next.push_back(aig.new_and(level[i], level[i + 1]));
+    if(level.size() % 2 != 0)
+      next.push_back(level.back());
+    level.swap(next);
+  }
+
+  return level.front();
+}
+
+literalt aig_prop_solvert::lor(const bvt &bv)
+{
+  bvt negated;
+  negated.reserve(bv.size());
+  for(const auto &l : bv)
+    negated.push_back(!l);
+
+  return !land(negated);
+}
+
+literalt aig_prop_solvert::lxor(literalt a, literalt b)
+{
+  if(a.is_constant())
+    return a.is_true() ? !b : b;
+  if(b.is_constant())
+    return b.is_true() ? !a : a;
+
+  // a^b = (|a|^|b|)^sign(a)^sign(b), which makes equivalent gates share nodes
+  const bool sign = a.sign() != b.sign();
+  if(a.sign())
+    a.invert();
+  if(b.sign())
+    b.invert();
+
+  // a^b = (a*b)'*(a'*b')'
+  return aig.new_and(!aig.new_and(a, b), !aig.new_and(!a, !b)) ^ sign;
+}
+
+literalt aig_prop_solvert::lxor(const bvt &bv)
+{
+  literalt literal = const_literal(false);
+
+  for(const auto &l : bv)
+    literal = lxor(l, literal);
+
+  return literal;
+}
+
+literalt aig_prop_solvert::lnand(literalt a, literalt b)
+{
+  return !land(a, b);
+}
+
+literalt aig_prop_solvert::lnor(literalt a, literalt b)
+{
+  return !lor(a, b);
+}
+
+literalt aig_prop_solvert::lequal(literalt a, literalt b)
+{
+  return !lxor(a, b);
+}
+
+literalt aig_prop_solvert::limplies(literalt a, literalt b)
+{
+  return lor(!a, b);
+}
+
+literalt aig_prop_solvert::lselect(literalt a, literalt b, literalt c)
+{
+  // a?b:c = (a*b)+(a'*c)
+  return lor(land(a, b), land(!a, c));
+}
+
+void aig_prop_solvert::set_equal(literalt a, literalt b)
+{
+  l_set_to(lequal(a, b), true);
+}
+
+void aig_prop_solvert::l_set_to(literalt a, bool value)
+{
+  constraints.push_back(a ^ !value);
+}
+
+void aig_prop_solvert::lcnf(const bvt &clause)
+{
+  l_set_to(lor(clause), true);
+}
+
+bvt aig_prop_solvert::conjuncts(literalt l) const
+{
+  const aig_nodet &node = aig.get_node(l);
+  PRECONDITION(node.is_and());
+
+  bvt result;
+  std::vector<literalt> stack{node.b, node.a};
+  while(!stack.empty())
+  {
+    const literalt operand = stack.back();
+    stack.pop_back();
+
+    const aig_nodet &operand_node = aig.get_node(operand);
+    if(
+      !operand.sign() && operand_node.is_and() && aig.fanout(operand) == 1 &&
+      !is_converted(operand))
+    {
+      stack.push_back(operand_node.b);
+      stack.push_back(operand_node.a);
+    }
+    else
+      result.push_back(operand);
+  }
+
+  return result;
+}
+
+literalt aig_prop_solvert::convert(literalt l)
+{
+  if(l.is_constant())
+    return l;
+
+  solver_literals.resize(aig.number_of_nodes());
+
+  std::vector<literalt> stack{literalt(l.var_no(), false)};
+  while(!stack.empty())
+  {
+    const literalt n = stack.back();
+
+    if(is_converted(n))
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    if(aig.get_node(n).is_input())
+    {
+      solver_literals[n.var_no()] = solver->new_variable();
+      ++number_of_converted_nodes;
+      stack.pop_back();
+      continue;
+    }
+
+    const bvt operands = conjuncts(n);
+
+    bool operands_converted = true;
+    for(const auto &operand : operands)
+    {
+      if(!is_converted(operand))
+      {
+        stack.push_back(literalt(operand.var_no(), false));
+        operands_converted = false;
+      }
+    }
+
+    if(!operands_converted)
+      continue;
+
+    bvt solver_operands;
+    solver_operands.reserve(operands.size());
+    for(const auto &operand : operands)
+      solver_operands.push_back(solver_literal(operand));
+
+    solver_literals[n.var_no()] = solver->land(solver_operands);
+    ++number_of_converted_nodes;
+    stack.pop_back();
+  }
+
+  return solver_literal(l);
+}
+
+void aig_prop_solvert::convert_constraint(literalt l)
+{
+  std::unordered_set<literalt::var_not> seen;
+  std::vector<literalt> stack{l};
+
+  while(!stack.empty())
+  {
+    const literalt constraint = stack.back();
+    stack.pop_back();
+
+    if(constraint.is_true())
+      continue;
+
+    if(constraint.is_false() || aig.get_node(constraint).is_input())
+    {
+      solver->l_set_to_true(convert(constraint));
+    }
+    else if(!constraint.sign())
+    {
+      // each operand of a conjunction is a constraint
+      const aig_nodet &node = aig.get_node(constraint);
+      for(const literalt &operand : {node.a, node.b})
+      {
+        if(seen.insert(operand.get()).second)
+          stack.push_back(operand);
+      }
+    }
+    else
+    {
+      // a negated conjunction is a clause
+      bvt clause;
+      for(const auto &operand : conjuncts(constraint))
+        clause.push_back(!convert(operand));
+      solver->lcnf(clause);
+    }
+  }
+}
+
+propt::resultt aig_prop_solvert::do_prop_solve()
+{
+  for(const auto &constraint : constraints)
+    convert_constraint(constraint);
+  constraints.clear();
+
+  bvt solver_assumptions;
+  solver_assumptions.reserve(assumptions.size());
+  for(const auto &assumption : assumptions)
+    solver_assumptions.push_back(convert(assumption));
+  solver->set_assumptions(solver_assumptions);
+
+  log.statistics() << "AIG has " << aig.number_of_nodes() << " nodes after "
+                   << aig.number_of_rewrites() << " rewrites, "
+                   << number_of_converted_nodes << " of them passed to "
+                   << solver->solver_text() << messaget::eom;
+
+  return solver->prop_solve();
+}
+
+tvt aig_prop_solvert::l_get(literalt a) const
+{
+  if(a.is_constant())
+    return tvt(a.is_true());
+
+  if(values_solver_calls != number_of_solver_calls)
+  {
+    has_value.clear();
+    values_solver_calls = number_of_solver_calls;
+  }
+
+  values.resize(aig.number_of_nodes());
+  has_value.resize(aig.number_of_nodes(), false);
+
+  const auto value = [this](literalt l) {
+    return l.sign() ? !values[l.var_no()] : values[l.var_no()];
+  };
+
+  std::vector<literalt::var_not> stack{a.var_no()};
+  while(!stack.empty())
+  {
+    const literalt::var_not n = stack.back();
+
+    if(has_value[n])
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    const aig_nodet &node = aig.get_node(literalt(n, false));
+    if(is_converted(literalt(n, false)))
+      values[n] = solver->l_get(solver_literals[n]);
+    else if(node.is_input())
+    {
+      // inputs outside the cone of influence of the constraints can take any
+      // value
+      values[n] = tvt(false);
+    }
+    else if(!has_value[node.a.var_no()] || !has_value[node.b.var_no()])
+    {
+      if(!has_value[node.a.var_no()])
+        stack.push_back(node.a.var_no());
+      if(!has_value[node.b.var_no()])
+        stack.push_back(node.b.var_no());
+      continue;
+    }
+    else
+      values[n] = value(node.a) && value(node.b);
+
+    has_value[n] = true;
+    stack.pop_back();
+  }
+
+  return value(a);
+}
+
+void aig_prop_solvert::set_assignment(literalt a, bool value)
+{
+  if(a.is_constant() || !is_converted(a))
+    return;
+
+  solver->set_assignment(solver_literal(a), value);
+  has_value.clear();
+}
+
+bool aig_prop_solvert::is_in_conflict(literalt l) const
+{
+  PRECONDITION(l.is_constant() || is_converted(l));
+  return solver->is_in_conflict(solver_literal(l));
+}
@@ -0,0 +1,144 @@
+/*******************************************************************\
+
+Module: Propositional Encoding via And-Inverter Graphs
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Propositional Encoding via And-Inverter Graphs
+
+#ifndef CPROVER_SOLVERS_PROP_AIG_PROP_H
+#define CPROVER_SOLVERS_PROP_AIG_PROP_H
+
+#include <memory>
+
+#include "aig.h"
+#include "prop.h"
+
+/// Builds the formula as an And-Inverter Graph, which shares and rewrites
+/// gates (see \ref aigt), and passes the cone of influence of the constraints
+/// to a SAT solver when solving. Chains of conjunctions without further
+/// fanout are encoded as a single multi-input gate, and constraints that are
+/// conjunctions or negated conjunctions are split into units or clauses.
+/// Gates added to the SAT solver are reused by later calls, hence the SAT
+/// solver must not eliminate variables.
+class aig_prop_solvert : public propt
+{
+public:
+  aig_prop_solvert(
+    std::unique_ptr<propt> _solver,
+    message_handlert &message_handler)
+    : propt(message_handler), solver(std::move(_solver))
+  {
+  }
+
+  literalt land(literalt a, literalt b) override;
+  literalt lor(literalt a, literalt b) override;
+  literalt land(const bvt &bv) override;
+  literalt lor(const bvt &bv) override;
+  literalt lxor(literalt a, literalt b) override;
+  literalt lxor(const bvt &bv) override;
+  literalt lnand(literalt a, literalt b) override;
+  literalt lnor(literalt a, literalt b) override;
+  literalt lequal(literalt a, literalt b) override;
+  literalt limplies(literalt a, literalt b) override;
+  literalt lselect(literalt a, literalt b, literalt c) override;
+  void set_equal(literalt a, literalt b) override;
+  void l_set_to(literalt a, bool value) override;
+  void lcnf(const bvt &clause) override;
+
+  // conjunctions are cheaper than clauses
+  bool cnf_handled_well() const override
+  {
+    return false;
+  }
+
+  void set_assumptions(const bvt &_assumptions) override
+  {
+    assumptions = _assumptions;
+  }
+
+  bool has_set_assumptions() const override
+  {
+    return solver->has_set_assumptions();
+  }
+
+  literalt new_variable() override
+  {
+    return aig.new_input();
+  }
+
+  size_t no_variables() const override
+  {
+    return aig.number_of_nodes();
+  }
+
+  const std::string solver_text() override
+  {
+    return "AIG with " + solver->solver_text();
+  }
+
+  tvt l_get(literalt a) const override;
+  void set_assignment(literalt a, bool value) override;
+  bool is_in_conflict(literalt l) const override;
+
+  bool has_is_in_conflict() const override
+  {
+    return solver->has_is_in_conflict();
+  }
+
+  void set_time_limit_seconds(uint32_t limit) override
+  {
+    solver->set_time_limit_seconds(limit);
+  }
+
+protected:
+  resultt do_prop_solve() override;
+
+  aigt aig;
+  std::unique_ptr<propt> solver;
+
+  /// Constraints not yet passed to the SAT solver
+  bvt constraints;
+  bvt assumptions;
+
+  /// The literal of the SAT solver for each node passed to it, or an unused
+  /// literal
+  std::vector<literalt> solver_literals;
+  std::size_t number_of_converted_nodes = 0;
+
+  /// Values of the nodes in the last satisfying assignment, computed on
+  /// demand by \ref l_get
+  mutable std::vector<tvt> values;
+  mutable std::vector<bool> has_value;
+  mutable std::size_t values_solver_calls = 0;
+
+  bool is_converted(literalt l) const
+  {
+    return l.var_no() < solver_literals.size() &&
+           solver_literals[l.var_no()].var_no() != literalt::unused_var_no();
+  }
+
+  /// \return the literal of the SAT solver for \p l, which must have been
+  ///   converted
+  literalt solver_literal(literalt l) const
+  {
+    return l.is_constant() ? l : solver_literals[l.var_no()] ^ l.sign();
+  }
+
+  /// Add the gates of \p l to the SAT solver
+  /// \return the literal of the SAT solver for \p l
+  literalt convert(literalt l);
+
+  /// Add \p l to the SAT solver as a constraint
+  void convert_constraint(literalt l);
+
+  /// \return the operands of the multi-input conjunction that has the node of
+  ///   \p l as output, which includes the operands of conjunctions that have
+  ///   no further fanout and have not been converted
+  bvt conjuncts(literalt l) const;
+};
+
+#endif // CPROVER_SOLVERS_PROP_AIG_PROP_H
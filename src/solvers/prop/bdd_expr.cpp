@@ -15,14 +15,22 @@ Author: Michael Tautschnig, michael.tautschnig@qmul.ac.uk
 #include <util/invariant.h>
 #include <util/std_expr.h>
 
-bddt bdd_exprt::from_expr_rec(const exprt &expr)
+#include <iterator>
+
+bddt bdd_exprt::from_expr_rec(const exprt &expr, from_expr_cachet &cache)
 {
   PRECONDITION(expr.type().id() == ID_bool);
 
+  const auto cached = cache.find(&expr.read());
+  if(cached != cache.end())
+    return cached->second;
+
+  bddt result = bdd_mgr.bdd_true();
+
   if(expr.is_constant())
-    return expr.is_false() ? bdd_mgr.bdd_false() : bdd_mgr.bdd_true();
+    result = expr.is_false() ? bdd_mgr.bdd_false() : bdd_mgr.bdd_true();
   else if(expr.id()==ID_not)
-    return from_expr_rec(to_not_expr(expr).op()).bdd_not();
+    result = from_expr_rec(to_not_expr(expr).op(), cache).bdd_not();
   else if(expr.id()==ID_and ||
           expr.id()==ID_or ||
           expr.id()==ID_xor)
@@ -30,43 +38,53 @@ bddt bdd_exprt::from_expr_rec(const exprt &expr)
     DATA_INVARIANT(
       expr.operands().size() >= 2,
       "logical and, or, and xor expressions have at least two operands");
-    exprt bin_expr=make_binary(expr);
 
-    bddt lhs = from_expr_rec(to_binary_expr(bin_expr).lhs());
-    bddt rhs = from_expr_rec(to_binary_expr(bin_expr).rhs());
+    // fold the operands rather than making the expression binary, as the
+    // cache refers to the subexpressions of expr
+    result = from_expr_rec(expr.operands().front(), cache);
 
-    return expr.id() == ID_and
-             ? lhs.bdd_and(rhs)
-             : (expr.id() == ID_or ? lhs.bdd_or(rhs) : lhs.bdd_xor(rhs));
+    for(auto it = std::next(expr.operands().begin());
+        it != expr.operands().end();
+        ++it)
+    {
+      bddt op = from_expr_rec(*it, cache);
+
+      if(expr.id() == ID_and)
+        result = result.bdd_and(op);
+      else if(expr.id() == ID_or)
+        result = result.bdd_or(op);
+      else
+        result = result.bdd_xor(op);
+    }
   }
   else if(expr.id()==ID_implies)
   {
     const implies_exprt &imp_expr=to_implies_expr(expr);
 
-    bddt n_lhs = from_expr_rec(imp_expr.lhs()).bdd_not();
-    bddt rhs = from_expr_rec(imp_expr.rhs());
+    bddt n_lhs = from_expr_rec(imp_expr.lhs(), cache).bdd_not();
+    bddt rhs = from_expr_rec(imp_expr.rhs(), cache);
 
-    return n_lhs.bdd_or(rhs);
+    result = n_lhs.bdd_or(rhs);
   }
   else if(
     expr.id() == ID_equal && to_equal_expr(expr).lhs().type().id() == ID_bool)
   {
     const equal_exprt &eq_expr=to_equal_expr(expr);
 
-    bddt op0 = from_expr_rec(eq_expr.op0());
-    bddt op1 = from_expr_rec(eq_expr.op1());
+    bddt op0 = from_expr_rec(eq_expr.op0(), cache);
+    bddt op1 = from_expr_rec(eq_expr.op1(), cache);
 
-    return op0.bdd_xor(op1).bdd_not();
+    result = op0.bdd_xor(op1).bdd_not();
   }
   else if(expr.id()==ID_if)
   {
     const if_exprt &if_expr=to_if_expr(expr);
 
-    bddt cond = from_expr_rec(if_expr.cond());
-    bddt t_case = from_expr_rec(if_expr.true_case());
-    bddt f_case = from_expr_rec(if_expr.false_case());
+    bddt cond = from_expr_rec(if_expr.cond(), cache);
+    bddt t_case = from_expr_rec(if_expr.true_case(), cache);
+    bddt f_case = from_expr_rec(if_expr.false_case(), cache);
 
-    return bddt::bdd_ite(cond, t_case, f_case);
+    result = bddt::bdd_ite(cond, t_case, f_case);
   }
   else
   {
@@ -80,13 +98,17 @@ bddt bdd_exprt::from_expr_rec(const exprt &expr)
       entry.first->second = bdd_mgr.bdd_variable(index);
     }
 
-    return entry.first->second;
+    result = entry.first->second;
   }
+
+  cache.emplace(&expr.read(), result);
+  return result;
 }
 
 bddt bdd_exprt::from_expr(const exprt &expr)
 {
-  return from_expr_rec(expr);
+  from_expr_cachet cache;
+  return from_expr_rec(expr, cache);
 }
 
 /// Disjunction of two expressions. If the second is already an `or_exprt`
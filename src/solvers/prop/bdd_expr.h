@@ -47,7 +47,12 @@ protected:
   /// of \p node_map corresponds to the i-th variable
   std::vector<exprt> node_map;
 
-  bddt from_expr_rec(const exprt &expr);
+  /// Results of \ref from_expr_rec for the subexpressions already converted,
+  /// such that expressions with shared subexpressions, as returned by
+  /// \ref as_expr, are converted in time linear in their number of nodes
+  typedef std::unordered_map<const void *, bddt> from_expr_cachet;
+
+  bddt from_expr_rec(const exprt &expr, from_expr_cachet &cache);
   exprt as_expr(
     const bdd_nodet &r,
     std::unordered_map<bdd_nodet::idt, exprt> &cache) const;
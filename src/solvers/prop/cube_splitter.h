@@ -0,0 +1,29 @@
+/*******************************************************************\
+
+Module: Capability to split a formula into cubes
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Capability to split a formula into cubes
+
+#ifndef CPROVER_SOLVERS_PROP_CUBE_SPLITTER_H
+#define CPROVER_SOLVERS_PROP_CUBE_SPLITTER_H
+
+#include "literal.h"
+
+/// A SAT solver that splits the search into cubes, i.e., the assignments to a
+/// few splitting variables, which are solved independently
+class cube_splittert
+{
+public:
+  /// Set the literals the splitting variables are chosen from, such as the
+  /// guards of branches, which decide much of the formula
+  virtual void set_split_candidates(const bvt &candidates) = 0;
+
+  virtual ~cube_splittert() = default;
+};
+
+#endif // CPROVER_SOLVERS_PROP_CUBE_SPLITTER_H
@@ -117,6 +117,24 @@ public:
     log.warning() << "CPU limit ignored (not implemented)" << messaget::eom;
   }
 
+  /// Limit the number of conflicts of each of the following calls to
+  /// \p limit, or lift the limit if \p limit is 0. A call that reaches the
+  /// limit returns P_ERROR, and the solver can be called again.
+  virtual void set_conflict_limit(std::size_t)
+  {
+  }
+  virtual bool has_conflict_limit() const
+  {
+    return false;
+  }
+
+  /// \return true if the last call returned P_ERROR as it reached the limit
+  ///   set by \ref set_conflict_limit
+  virtual bool reached_conflict_limit() const
+  {
+    return false;
+  }
+
   std::size_t get_number_of_solver_calls() const;
 
 protected:
@@ -55,6 +55,12 @@ public:
   literalt convert(const exprt &expr) override;
   bool is_in_conflict(const exprt &expr) const override;
 
+  /// \return true if the propositional solver supports \ref is_in_conflict
+  bool has_is_in_conflict() const
+  {
+    return prop.has_is_in_conflict();
+  }
+
   /// For a Boolean expression \p expr, add the constraint
   /// 'current_context => expr' if \p value is `true`,
   /// otherwise add 'current_context => not expr'
@@ -13,8 +13,10 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/threeval.h>
 
+#include <algorithm>
+
 #include "literal_expr.h"
-#include "prop_conv.h"
+#include "prop_conv_solver.h"
 
 prop_minimizet::prop_minimizet(
   prop_convt &_prop_conv,
@@ -93,6 +95,199 @@ literalt prop_minimizet::constraint()
   }
 }
 
+bool prop_minimizet::linear_search(bool &last_was_SAT)
+{
+  decision_proceduret::resultt dec_result;
+  do
+  {
+    // We want to improve on one of the objectives, please!
+    literalt c = constraint();
+
+    if(c.is_false())
+      dec_result = decision_proceduret::resultt::D_UNSATISFIABLE;
+    else
+    {
+      _iterations++;
+
+      prop_conv.push({literal_exprt{c}});
+      dec_result = prop_conv();
+
+      switch(dec_result)
+      {
+      case decision_proceduret::resultt::D_UNSATISFIABLE:
+        last_was_SAT = false;
+        break;
+
+      case decision_proceduret::resultt::D_SATISFIABLE:
+        last_was_SAT = true;
+        fix_objectives(); // fix the ones we got
+        break;
+
+      case decision_proceduret::resultt::D_ERROR:
+        log.error() << "decision procedure failed" << messaget::eom;
+        last_was_SAT = false;
+        return false;
+      }
+    }
+  } while(dec_result != decision_proceduret::resultt::D_UNSATISFIABLE);
+
+  return true;
+}
+
+bvt prop_minimizet::totalizer(const bvt &inputs)
+{
+  if(inputs.size() <= 1)
+    return inputs;
+
+  const bvt left =
+    totalizer(bvt(inputs.begin(), inputs.begin() + inputs.size() / 2));
+  const bvt right =
+    totalizer(bvt(inputs.begin() + inputs.size() / 2, inputs.end()));
+
+  // more than j inputs are true iff more than i - 1 of the left ones and more
+  // than j - i of the right ones are, for some i
+  bvt outputs;
+  outputs.reserve(inputs.size());
+  for(std::size_t j = 0; j < inputs.size(); ++j)
+  {
+    exprt::operandst disjuncts;
+    for(std::size_t i = 0; i <= std::min(j + 1, left.size()); ++i)
+    {
+      const std::size_t from_right = j + 1 - i;
+      if(from_right > right.size())
+        continue;
+
+      exprt::operandst conjuncts;
+      if(i != 0)
+        conjuncts.push_back(literal_exprt(left[i - 1]));
+      if(from_right != 0)
+        conjuncts.push_back(literal_exprt(right[from_right - 1]));
+      disjuncts.push_back(conjunction(conjuncts));
+    }
+
+    outputs.push_back(prop_conv.convert(disjunction(disjuncts)));
+  }
+
+  return outputs;
+}
+
+bool prop_minimizet::core_guided_search(bool &last_was_SAT)
+{
+  auto &conflict_provider = dynamic_cast<conflict_providert &>(prop_conv);
+
+  // An objective, or a bound on the number of objectives missed, that is
+  // assumed to be met: the literal at index `bound` of `outputs` is false.
+  struct softt
+  {
+    bvt outputs;
+    std::size_t bound;
+  };
+
+  std::vector<softt> soft;
+  for(const auto &objective : current->second)
+  {
+    if(!objective.fixed && !objective.condition.is_constant())
+      soft.push_back({{objective.condition}, 0});
+  }
+
+  std::size_t lower_bound = 0;
+  bool solved = false;
+
+  while(!soft.empty() && !solved)
+  {
+    std::vector<exprt> assumptions;
+    assumptions.reserve(soft.size());
+    for(const auto &s : soft)
+      assumptions.push_back(literal_exprt(!s.outputs[s.bound]));
+
+    _iterations++;
+
+    // the solution remains available after dropping the assumptions
+    prop_conv.push(assumptions);
+    const decision_proceduret::resultt dec_result = prop_conv();
+
+    if(dec_result == decision_proceduret::resultt::D_SATISFIABLE)
+    {
+      prop_conv.pop();
+      solved = true;
+      break;
+    }
+    else if(dec_result == decision_proceduret::resultt::D_ERROR)
+    {
+      prop_conv.pop();
+      log.error() << "decision procedure failed" << messaget::eom;
+      last_was_SAT = false;
+      return false;
+    }
+
+    // relax the assumptions in the core, and bound the number of them missed
+    bvt missed;
+    std::vector<softt> relaxed;
+    for(std::size_t i = 0; i < soft.size(); ++i)
+    {
+      softt &s = soft[i];
+      if(!conflict_provider.is_in_conflict(assumptions[i]))
+        relaxed.push_back(std::move(s));
+      else
+      {
+        missed.push_back(s.outputs[s.bound]);
+        if(s.bound + 1 < s.outputs.size())
+          relaxed.push_back({std::move(s.outputs), s.bound + 1});
+      }
+    }
+
+    prop_conv.pop();
+
+    // the conflict does not depend on the objectives
+    if(missed.empty())
+      break;
+
+    ++lower_bound;
+
+    if(missed.size() >= 2)
+      relaxed.push_back({totalizer(missed), 1});
+
+    // bounds that are constant need not be assumed
+    soft.clear();
+    for(auto &s : relaxed)
+    {
+      if(!s.outputs[s.bound].is_constant())
+        soft.push_back(std::move(s));
+    }
+  }
+
+  log.statistics() << "Missed " << lower_bound << " objectives of weight "
+                   << current->first << messaget::eom;
+
+  if(!solved)
+  {
+    // the objectives still assumed would make the formula unsatisfiable
+    _iterations++;
+    if(prop_conv() != decision_proceduret::resultt::D_SATISFIABLE)
+    {
+      log.error() << "decision procedure failed" << messaget::eom;
+      last_was_SAT = false;
+      return false;
+    }
+  }
+
+  last_was_SAT = true;
+
+  // fix the ones we got
+  for(auto &objective : current->second)
+  {
+    if(!objective.fixed && prop_conv.l_get(objective.condition).is_false())
+    {
+      _number_satisfied++;
+      _value += current->first;
+      prop_conv.set_to(literal_exprt(objective.condition), false);
+      objective.fixed = true;
+    }
+  }
+
+  return true;
+}
+
 /// Try to cover all objectives
 void prop_minimizet::operator()()
 {
@@ -101,44 +296,22 @@ void prop_minimizet::operator()()
   _value = 0;
   bool last_was_SAT = false;
 
+  auto prop_conv_solver = dynamic_cast<prop_conv_solvert *>(&prop_conv);
+  const bool use_cores =
+    prop_conv_solver != nullptr && prop_conv_solver->has_is_in_conflict();
+
   // go from high weights to low ones
   for(current = objectives.rbegin(); current != objectives.rend(); current++)
   {
     log.status() << "weight " << current->first << messaget::eom;
 
-    decision_proceduret::resultt dec_result;
-    do
+    if(use_cores)
     {
-      // We want to improve on one of the objectives, please!
-      literalt c = constraint();
-
-      if(c.is_false())
-        dec_result = decision_proceduret::resultt::D_UNSATISFIABLE;
-      else
-      {
-        _iterations++;
-
-        prop_conv.push({literal_exprt{c}});
-        dec_result = prop_conv();
-
-        switch(dec_result)
-        {
-        case decision_proceduret::resultt::D_UNSATISFIABLE:
-          last_was_SAT = false;
-          break;
-
-        case decision_proceduret::resultt::D_SATISFIABLE:
-          last_was_SAT = true;
-          fix_objectives(); // fix the ones we got
-          break;
-
-        case decision_proceduret::resultt::D_ERROR:
-          log.error() << "decision procedure failed" << messaget::eom;
-          last_was_SAT = false;
-          return;
-        }
-      }
-    } while(dec_result != decision_proceduret::resultt::D_UNSATISFIABLE);
+      if(!core_guided_search(last_was_SAT))
+        return;
+    }
+    else if(!linear_search(last_was_SAT))
+      return;
   }
 
   if(!last_was_SAT)
@@ -146,7 +319,8 @@ void prop_minimizet::operator()()
     // We don't have a satisfying assignment to work with.
     // Run solver again to get one.
 
-    prop_conv.pop();
+    if(!use_cores)
+      prop_conv.pop();
     (void)prop_conv();
   }
 }
@@ -20,8 +20,14 @@ Author: Daniel Kroening, kroening@kroening.com
 
 class prop_convt;
 
-/// Computes a satisfying assignment of minimal cost according to a const
-/// function using incremental SAT
+/// Computes a satisfying assignment of minimal cost according to a cost
+/// function using incremental SAT. The objectives are minimised by weight,
+/// the highest first. If the solver provides final conflicts, each weight is
+/// minimised by core-guided search (OLL, as in Morgado et al., "Core-Guided
+/// MaxSAT with Soft Cardinality Constraints", CP 2014): all objectives are
+/// assumed to be met, and the unsatisfiable cores found are relaxed by
+/// totalizers that count the objectives missed. Otherwise each solver call
+/// has to improve on one more objective.
 class prop_minimizet
 {
 public:
@@ -79,6 +85,20 @@ protected:
   literalt constraint();
   void fix_objectives();
 
+  /// Minimise the objectives of \ref current by improving on at least one of
+  /// them in each call of the solver
+  /// \return false if the solver failed
+  bool linear_search(bool &last_was_SAT);
+
+  /// Minimise the objectives of \ref current by core-guided search, see
+  /// \ref prop_minimizet
+  /// \return false if the solver failed
+  bool core_guided_search(bool &last_was_SAT);
+
+  /// \return literals the i-th of which is true iff more than i of
+  ///   \p inputs are true
+  bvt totalizer(const bvt &inputs);
+
   objectivest::reverse_iterator current;
 };
 
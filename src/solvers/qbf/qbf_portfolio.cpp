@@ -0,0 +1,164 @@
+/*******************************************************************\
+
+Module: Portfolio of External QBF Solvers
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Portfolio of External QBF Solvers
+
+#include "qbf_portfolio.h"
+
+#include <util/invariant.h>
+#include <util/process_pool.h>
+#include <util/tempfile.h>
+
+#include "qbf_quantor.h"
+#include "qbf_qube.h"
+#include "qbf_skizzo.h"
+
+#include <fstream>
+
+#ifdef _WIN32
+#  include <cstdlib>
+#else
+#  include <unistd.h>
+#endif
+
+qbf_portfoliot::qbf_portfoliot(message_handlert &message_handler)
+  : qdimacs_cnft(message_handler),
+    solvers{{"Quantor", qbf_quantort::command, qbf_quantort::read_result},
+            {"QuBE", qbf_qubet::command, qbf_qubet::read_result},
+            {"Skizzo", qbf_skizzot::command, qbf_skizzot::read_result}}
+{
+  // skizzo crashes on broken lines
+  break_lines=false;
+}
+
+tvt qbf_portfoliot::l_get(literalt) const
+{
+  UNREACHABLE;
+}
+
+const std::string qbf_portfoliot::solver_text()
+{
+  return "QBF portfolio";
+}
+
+propt::resultt qbf_portfoliot::do_prop_solve()
+{
+  // sKizzo and QuBE crash on empty instances
+  if(no_clauses()==0)
+    return resultt::P_SATISFIABLE;
+
+  log.status() << "QBF portfolio: " << no_variables() << " variables, "
+               << no_clauses() << " clauses, " << solvers.size() << " solvers"
+               << messaget::eom;
+
+  temporary_filet qbf_tmp_file("qbf_portfolio_", ".qdimacs");
+
+  {
+    std::ofstream out(qbf_tmp_file());
+
+    // write it once for all solvers
+    write_qdimacs_cnf(out);
+  }
+
+  const tvt result=solve(qbf_tmp_file());
+
+  if(result.is_unknown())
+  {
+    log.error() << "QBF portfolio failed: no solver gave a result"
+                << messaget::eom;
+    return resultt::P_ERROR;
+  }
+
+  if(result.is_true())
+  {
+    log.status() << "QBF portfolio: TRUE" << messaget::eom;
+    return resultt::P_SATISFIABLE;
+  }
+  else
+  {
+    log.status() << "QBF portfolio: FALSE" << messaget::eom;
+    return resultt::P_UNSATISFIABLE;
+  }
+}
+
+#ifdef _WIN32
+tvt qbf_portfoliot::solve(const std::string &qdimacs_file)
+{
+  for(const auto &solver : solvers)
+  {
+    temporary_filet result_file("qbf_portfolio_", ".out");
+
+    if(system(solver.command(qdimacs_file, result_file()).c_str())!=0)
+      continue;
+
+    std::ifstream in(result_file());
+    const tvt result=solver.read_result(in);
+    if(!result.is_unknown())
+    {
+      log.status() << solver.name << " answered first" << messaget::eom;
+      return result;
+    }
+  }
+
+  return tvt::unknown();
+}
+#else
+tvt qbf_portfoliot::solve(const std::string &qdimacs_file)
+{
+  std::vector<temporary_filet> result_files;
+  result_files.reserve(solvers.size());
+
+  // each solver runs in a process group of its own, as the shell may start
+  // it in a process of its own, which is to be stopped together with the
+  // shell; the index of the solver identifies its process
+  process_poolt running;
+
+  for(std::size_t i = 0; i < solvers.size(); ++i)
+  {
+    result_files.emplace_back("qbf_portfolio_", ".out");
+    const std::string command =
+      solvers[i].command(qdimacs_file, result_files.back()());
+
+    const auto run_solver = [&command]() {
+      execl(
+        "/bin/sh", "sh", "-c", command.c_str(), static_cast<char *>(nullptr));
+      return 127;
+    };
+
+    if(running.start(i, run_solver, false, true))
+      log.warning() << "failed to start " << solvers[i].name << messaget::eom;
+  }
+
+  while(running.running() != 0)
+  {
+    const auto finished = running.wait_for_any();
+    if(!finished.has_value())
+    {
+      log.error() << "failed to wait for the QBF solvers" << messaget::eom;
+      break;
+    }
+
+    // all of the solver's processes have finished
+    const solvert &solver = solvers[finished->id];
+    std::ifstream in(result_files[finished->id]());
+    const tvt result = solver.read_result(in);
+
+    if(!result.is_unknown())
+    {
+      // the solvers that have not answered yet are stopped with the pool
+      log.status() << solver.name << " answered first" << messaget::eom;
+      return result;
+    }
+
+    log.status() << solver.name << " gave no result" << messaget::eom;
+  }
+
+  return tvt::unknown();
+}
+#endif
@@ -0,0 +1,52 @@
+/*******************************************************************\
+
+Module: Portfolio of External QBF Solvers
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Portfolio of External QBF Solvers
+
+#ifndef CPROVER_SOLVERS_QBF_QBF_PORTFOLIO_H
+#define CPROVER_SOLVERS_QBF_QBF_PORTFOLIO_H
+
+#include "qdimacs_cnf.h"
+
+#include <vector>
+
+/// Runs the external QBF solvers (Quantor, QuBE and sKizzo) in parallel on
+/// the same QDIMACS file and takes the first answer, stopping the others.
+/// Solvers that are not installed or fail do not give an answer; the result
+/// is an error only if none does. On Windows the solvers are run one after
+/// the other until one answers.
+class qbf_portfoliot:public qdimacs_cnft
+{
+public:
+  explicit qbf_portfoliot(message_handlert &message_handler);
+
+  const std::string solver_text() override;
+  tvt l_get(literalt a) const override;
+
+  struct solvert
+  {
+    std::string name;
+    std::string (*command)(
+      const std::string &qdimacs_file,
+      const std::string &result_file);
+    tvt (*read_result)(std::istream &in);
+  };
+
+  /// The solvers to run, initially all external ones
+  std::vector<solvert> solvers;
+
+protected:
+  resultt do_prop_solve() override;
+
+  /// \return the solver's answer for \p qdimacs_file: true if the formula
+  ///   holds, false if it does not, unknown if none of the solvers answers
+  tvt solve(const std::string &qdimacs_file);
+};
+
+#endif // CPROVER_SOLVERS_QBF_QBF_PORTFOLIO_H
@@ -50,48 +50,24 @@ propt::resultt qbf_quantort::prop_solve()
   }
 
   // solve it
-  int res=system((
-    "quantor "+qbf_tmp_file+" -o "+result_tmp_file).c_str());
+  int res=system(command(qbf_tmp_file, result_tmp_file).c_str());
   CHECK_RETURN(0==res);
 
-  bool result=false;
+  tvt result=tvt::unknown();
 
   // read result
   {
     std::ifstream in(result_tmp_file.c_str());
+    result=read_result(in);
+  }
 
-    bool result_found=false;
-    while(in)
-    {
-      std::string line;
-
-      std::getline(in, line);
-
-      if(!line.empty() && line[line.size() - 1] == '\r')
-        line.resize(line.size()-1);
-
-      if(line=="s TRUE")
-      {
-        result=true;
-        result_found=true;
-        break;
-      }
-      else if(line=="s FALSE")
-      {
-        result=false;
-        result_found=true;
-        break;
-      }
-    }
-
-    if(!result_found)
-    {
-      log.error() << "Quantor failed: unknown result" << messaget::eom;
-      return resultt::P_ERROR;
-    }
+  if(result.is_unknown())
+  {
+    log.error() << "Quantor failed: unknown result" << messaget::eom;
+    return resultt::P_ERROR;
   }
 
-  if(result)
+  if(result.is_true())
   {
     log.status() << "Quantor: TRUE" << messaget::eom;
     return resultt::P_SATISFIABLE;
@@ -104,3 +80,30 @@ propt::resultt qbf_quantort::prop_solve()
 
   return resultt::P_ERROR;
 }
+
+std::string qbf_quantort::command(
+  const std::string &qdimacs_file,
+  const std::string &result_file)
+{
+  return "quantor "+qdimacs_file+" -o "+result_file;
+}
+
+tvt qbf_quantort::read_result(std::istream &in)
+{
+  while(in)
+  {
+    std::string line;
+
+    std::getline(in, line);
+
+    if(!line.empty() && line[line.size() - 1] == '\r')
+      line.resize(line.size()-1);
+
+    if(line=="s TRUE")
+      return tvt(true);
+    else if(line=="s FALSE")
+      return tvt(false);
+  }
+
+  return tvt::unknown();
+}
@@ -21,6 +21,15 @@ public:
   virtual const std::string solver_text();
   virtual resultt prop_solve();
   virtual tvt l_get(literalt a) const;
+
+  /// \return the shell command that solves \p qdimacs_file and writes
+  ///   the result to \p result_file
+  static std::string
+  command(const std::string &qdimacs_file, const std::string &result_file);
+
+  /// \return the result given in the output \p in of the solver: true if
+  ///   the formula holds, false if it does not, unknown if there is none
+  static tvt read_result(std::istream &in);
 };
 
 #endif // CPROVER_SOLVERS_QBF_QBF_QUBE_H
@@ -55,51 +55,25 @@ propt::resultt qbf_skizzot::prop_solve()
     write_qdimacs_cnf(out);
   }
 
-  std::string options;
-
   // solve it
-  int res=system((
-    "sKizzo "+qbf_tmp_file+options+" > "+result_tmp_file).c_str());
+  int res=system(command(qbf_tmp_file, result_tmp_file).c_str());
   CHECK_RETURN(0==res);
 
-  bool result=false;
+  tvt result=tvt::unknown();
 
   // read result
   {
     std::ifstream in(result_tmp_file.c_str());
+    result=read_result(in);
+  }
 
-    bool result_found=false;
-    while(in)
-    {
-      std::string line;
-
-      std::getline(in, line);
-
-      if(!line.empty() && line[line.size() - 1] == '\r')
-        line.resize(line.size()-1);
-
-      if(line=="The instance evaluates to TRUE.")
-      {
-        result=true;
-        result_found=true;
-        break;
-      }
-      else if(line=="The instance evaluates to FALSE.")
-      {
-        result=false;
-        result_found=true;
-        break;
-      }
-    }
-
-    if(!result_found)
-    {
-      log.error() << "Skizzo failed: unknown result" << messaget::eom;
-      return resultt::P_ERROR;
-    }
+  if(result.is_unknown())
+  {
+    log.error() << "Skizzo failed: unknown result" << messaget::eom;
+    return resultt::P_ERROR;
   }
 
-  if(result)
+  if(result.is_true())
   {
     log.status() << "Skizzo: TRUE" << messaget::eom;
     return resultt::P_SATISFIABLE;
@@ -112,3 +86,30 @@ propt::resultt qbf_skizzot::prop_solve()
 
   return resultt::P_ERROR;
 }
+
+std::string qbf_skizzot::command(
+  const std::string &qdimacs_file,
+  const std::string &result_file)
+{
+  return "sKizzo "+qdimacs_file+" > "+result_file;
+}
+
+tvt qbf_skizzot::read_result(std::istream &in)
+{
+  while(in)
+  {
+    std::string line;
+
+    std::getline(in, line);
+
+    if(!line.empty() && line[line.size() - 1] == '\r')
+      line.resize(line.size()-1);
+
+    if(line=="The instance evaluates to TRUE.")
+      return tvt(true);
+    else if(line=="The instance evaluates to FALSE.")
+      return tvt(false);
+  }
+
+  return tvt::unknown();
+}
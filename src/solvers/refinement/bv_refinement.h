@@ -66,6 +66,8 @@ private:
       no_operands(0),
       under_state(0),
       over_state(0),
+      over_width(0),
+      no_refinements(0),
       id_nr(_id_nr)
     {
     }
@@ -82,6 +84,13 @@ private:
     // the kind of under- or over-approximation
     unsigned under_state, over_state;
 
+    /// Number of least-significant bits of the result of a multiplication
+    /// that are constrained to be those of the product
+    std::size_t over_width;
+
+    /// Number of times the approximation has been refined
+    std::size_t no_refinements;
+
     std::string as_string() const;
 
     void add_over_assumption(literalt l);
@@ -101,6 +110,7 @@ private:
   void check_UNSAT();
   void arrays_overapproximated();
   void freeze_lazy_constraints();
+  void output_refinement_statistics();
 
   // MEMBERS
 
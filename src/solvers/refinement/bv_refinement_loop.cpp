@@ -55,6 +55,7 @@ decision_proceduret::resultt bv_refinementt::dec_solve()
         log.status() << "BV-Refinement: got SAT, and it simulates => SAT"
                      << messaget::eom;
         log.status() << "Total iterations: " << iteration << messaget::eom;
+        output_refinement_statistics();
         return resultt::D_SATISFIABLE;
       }
       else
@@ -70,6 +71,7 @@ decision_proceduret::resultt bv_refinementt::dec_solve()
           << "BV-Refinement: got UNSAT, and the proof passes => UNSAT"
           << messaget::eom;
         log.status() << "Total iterations: " << iteration << messaget::eom;
+        output_refinement_statistics();
         return resultt::D_UNSATISFIABLE;
       }
       else
@@ -138,3 +140,17 @@ void bv_refinementt::check_UNSAT()
   for(approximationt &approximation : this->approximations)
     check_UNSAT(approximation);
 }
+
+void bv_refinementt::output_refinement_statistics()
+{
+  for(const approximationt &approximation : approximations)
+  {
+    if(approximation.no_refinements != 0)
+    {
+      log.statistics() << "BV-Refinement: refined '"
+                       << approximation.as_string() << "' "
+                       << approximation.no_refinements << " times"
+                       << messaget::eom;
+    }
+  }
+}
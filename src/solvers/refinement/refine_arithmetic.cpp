@@ -8,12 +8,15 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "bv_refinement.h"
 
+#include <algorithm>
+
 #include <util/arith_tools.h>
 #include <util/bitvector_types.h>
 #include <util/bv_arithmetic.h>
 #include <util/expr_util.h>
 #include <util/floatbv_expr.h>
 #include <util/ieee_float.h>
+#include <util/mp_arith.h>
 
 #include <solvers/floatbv/float_utils.h>
 #include <solvers/prop/literal_expr.h>
@@ -281,7 +284,7 @@ void bv_refinementt::check_SAT(approximationt &a)
       a.expr.operands().size() == 2, "all (un)signedbv typed exprs are binary");
 
     // already full interpretation?
-    if(a.over_state>0)
+    if(a.over_state==MAX_STATE)
       return;
 
     bv_spect spec(type);
@@ -307,9 +310,36 @@ void bv_refinementt::check_SAT(approximationt &a)
     if(o0.pack()==a.result_value) // ok
       return;
 
-    if(a.over_state==0)
+    if(a.expr.id()==ID_mult && a.over_state<config_.max_node_refinement)
+    {
+      // The n least-significant bits of a product only depend on the n
+      // least-significant bits of the operands, no matter the signedness.
+      // We thus constrain the bits of the result up to the lowest wrong one,
+      // which only needs the partial products of these bits.
+      const std::size_t width=a.result_bv.size();
+      const std::string expected=integer2binary(o0.pack(), width);
+      const std::string actual=integer2binary(a.result_value, width);
+      std::size_t wrong_bit=0;
+      while(expected[width-wrong_bit-1]==actual[width-wrong_bit-1])
+        wrong_bit++;
+
+      const std::size_t bits=
+        std::min(width, std::max(2*a.over_width, wrong_bit+1));
+      const bvt r=bv_utils.multiplier(
+        bv_utilst::extract_lsb(a.op0_bv, bits),
+        bv_utilst::extract_lsb(a.op1_bv, bits),
+        bv_utilst::representationt::UNSIGNED);
+      bv_utils.set_equal(r, bv_utilst::extract_lsb(a.result_bv, bits));
+      a.over_width=bits;
+
+      if(bits==width)
+        a.over_state=MAX_STATE;
+    }
+    else
     {
-      // we give up right away and add the full interpretation
+      // give up and add the full interpretation
+      a.over_state=MAX_STATE;
+
       bvt r;
       if(a.expr.id()==ID_mult)
       {
@@ -340,8 +370,6 @@ void bv_refinementt::check_SAT(approximationt &a)
 
       bv_utils.set_equal(r, a.result_bv);
     }
-    else
-      UNREACHABLE;
   }
   else if(type.id()==ID_fixedbv)
   {
@@ -357,6 +385,7 @@ void bv_refinementt::check_SAT(approximationt &a)
                << a.over_state << ")" << messaget::eom;
 
   progress=true;
+  a.no_refinements++;
   if(a.over_state<MAX_STATE)
     a.over_state++;
 }
@@ -412,16 +441,13 @@ void bv_refinementt::check_UNSAT(approximationt &a)
       }
       else
       {
-        // set x bits of both exponent and mantissa free
-        // need to start with most-significant bits
-
-        #if 0
+        // set the x most-significant bits of the fraction free, i.e., use
+        // a reduced mantissa, and keep the others zero
         for(std::size_t i=x; i<fraction0.size(); i++)
           a.add_under_assumption(!fraction0[fraction0.size()-i-1]);
 
         for(std::size_t i=x; i<fraction1.size(); i++)
           a.add_under_assumption(!fraction1[fraction1.size()-i-1]);
-        #endif
       }
     }
   }
@@ -447,6 +473,7 @@ void bv_refinementt::check_UNSAT(approximationt &a)
   }
 
   a.under_state++;
+  a.no_refinements++;
   progress=true;
 }
 
@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <set>
 
 #include <util/invariant.h>
+#include <util/irep_hash.h>
 
 // #define VERBOSE
 
@@ -174,9 +175,19 @@ literalt cnft::land(const bvt &bv)
 
   bvt new_bv=eliminate_duplicates(bv);
 
+  literalt *entry = nullptr;
+  if(structural_hashing)
+  {
+    entry = &gate_output(gate_kindt::AND, new_bv);
+    if(entry->var_no() != literalt::unused_var_no())
+      return *entry;
+  }
+
   bvt lits(2);
   literalt literal=new_variable();
   lits[1]=neg(literal);
+  if(entry != nullptr)
+    *entry = literal;
 
   for(const auto &l : new_bv)
   {
@@ -217,9 +228,24 @@ literalt cnft::lor(const bvt &bv)
 
   bvt new_bv=eliminate_duplicates(bv);
 
+  literalt *entry = nullptr;
+  if(structural_hashing)
+  {
+    // as in lor(a, b), store the negation of the AND over the negated inputs
+    bvt negated_bv;
+    negated_bv.reserve(new_bv.size());
+    for(const auto &l : new_bv)
+      negated_bv.push_back(!l);
+    entry = &gate_output(gate_kindt::AND, eliminate_duplicates(negated_bv));
+    if(entry->var_no() != literalt::unused_var_no())
+      return !*entry;
+  }
+
   bvt lits(2);
   literalt literal=new_variable();
   lits[1]=pos(literal);
+  if(entry != nullptr)
+    *entry = !literal;
 
   for(const auto &l : new_bv)
   {
@@ -270,6 +296,18 @@ literalt cnft::land(literalt a, literalt b)
   if(a==b)
     return a;
 
+  if(structural_hashing)
+  {
+    literalt &o =
+      gate_output(gate_kindt::AND, {std::min(a, b), std::max(a, b)});
+    if(o.var_no() == literalt::unused_var_no())
+    {
+      o = new_variable();
+      gate_and(a, b, o);
+    }
+    return o;
+  }
+
   literalt o=new_variable();
   gate_and(a, b, o);
   return o;
@@ -286,6 +324,19 @@ literalt cnft::lor(literalt a, literalt b)
   if(a==b)
     return a;
 
+  if(structural_hashing)
+  {
+    // a+b = (a'*b')'
+    literalt &o =
+      gate_output(gate_kindt::AND, {std::min(!a, !b), std::max(!a, !b)});
+    if(o.var_no() == literalt::unused_var_no())
+    {
+      o = new_variable();
+      gate_and(!a, !b, o);
+    }
+    return !o;
+  }
+
   literalt o=new_variable();
   gate_or(a, b, o);
   return o;
@@ -308,6 +359,21 @@ literalt cnft::lxor(literalt a, literalt b)
   if(a==!b)
     return const_literal(true);
 
+  if(structural_hashing)
+  {
+    // a^b = (|a|^|b|)^sign(a)^sign(b)
+    const literalt pa = a.sign() ? !a : a;
+    const literalt pb = b.sign() ? !b : b;
+    literalt &o =
+      gate_output(gate_kindt::XOR, {std::min(pa, pb), std::max(pa, pb)});
+    if(o.var_no() == literalt::unused_var_no())
+    {
+      o = new_variable();
+      gate_xor(pa, pb, o);
+    }
+    return o ^ (a.sign() != b.sign());
+  }
+
   literalt o=new_variable();
   gate_xor(a, b, o);
   return o;
@@ -357,9 +423,26 @@ literalt cnft::lselect(literalt a, literalt b, literalt c)
 
   #ifdef COMPACT_ITE
 
+  if(structural_hashing && a.sign())
+  {
+    // a?b:c = a'?c:b
+    a.invert();
+    std::swap(b, c);
+  }
+
+  literalt *entry = nullptr;
+  if(structural_hashing)
+  {
+    entry = &gate_output(gate_kindt::ITE, {a, b, c});
+    if(entry->var_no() != literalt::unused_var_no())
+      return *entry;
+  }
+
   // (a+c'+o) (a+c+o') (a'+b'+o) (a'+b+o')
 
   literalt o=new_variable();
+  if(entry != nullptr)
+    *entry = o;
 
   bvt lits;
 
@@ -381,6 +464,31 @@ literalt cnft::lselect(literalt a, literalt b, literalt c)
   #endif
 }
 
+std::size_t cnft::gate_key_hasht::operator()(const gate_keyt &key) const
+{
+  std::size_t hash = static_cast<std::size_t>(key.kind);
+  for(const auto &l : key.inputs)
+    hash = hash_combine(hash, l.get());
+  return hash_finalize(hash, key.inputs.size() + 1);
+}
+
+literalt &cnft::gate_output(gate_kindt kind, bvt inputs)
+{
+  // A solver that simplifies the formula may have eliminated the outputs of
+  // the gates built before it was last run, which therefore must not be
+  // shared with any constraints added from now on.
+  if(gates_solver_calls != number_of_solver_calls)
+  {
+    gates.clear();
+    gates_solver_calls = number_of_solver_calls;
+  }
+
+  literalt &output = gates[gate_keyt{kind, std::move(inputs)}];
+  if(output.var_no() != literalt::unused_var_no())
+    ++number_of_shared_gates;
+  return output;
+}
+
 /// Generate a new variable and return it as a literal
 /// \return New variable as literal
 literalt cnft::new_variable()
@@ -14,6 +14,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <solvers/prop/prop.h>
 
+#include <unordered_map>
+
 class cnft:public propt
 {
 public:
@@ -43,6 +45,19 @@ public:
   virtual void set_no_variables(size_t no) { _no_variables=no; }
   virtual size_t no_clauses() const=0;
 
+  /// Make requests for a gate that has been built before over the same inputs
+  /// return the output of the existing gate instead of adding fresh clauses.
+  void enable_structural_hashing()
+  {
+    structural_hashing = true;
+  }
+
+  /// \return the number of gates that structural hashing did not build again
+  std::size_t get_number_of_shared_gates() const
+  {
+    return number_of_shared_gates;
+  }
+
 protected:
   void gate_and(literalt a, literalt b, literalt o);
   void gate_or(literalt a, literalt b, literalt o);
@@ -56,6 +71,42 @@ protected:
 
   size_t _no_variables;
 
+  /// Gates are normalised before looking them up: an OR gate is stored as the
+  /// negation of the AND gate over the negated inputs, the inputs of an XOR
+  /// gate are unsigned and the condition of an if-then-else is positive.
+  enum class gate_kindt
+  {
+    AND,
+    XOR,
+    ITE
+  };
+
+  struct gate_keyt
+  {
+    gate_kindt kind;
+    bvt inputs;
+
+    bool operator==(const gate_keyt &other) const
+    {
+      return kind == other.kind && inputs == other.inputs;
+    }
+  };
+
+  struct gate_key_hasht
+  {
+    std::size_t operator()(const gate_keyt &key) const;
+  };
+
+  bool structural_hashing = false;
+  std::size_t number_of_shared_gates = 0;
+  std::unordered_map<gate_keyt, literalt, gate_key_hasht> gates;
+  std::size_t gates_solver_calls = 0;
+
+  /// Look up the gate of kind \p kind over the normalised \p inputs.
+  /// \return the table entry for the output of the gate, which is an unused
+  ///   literal that the caller is to set if there is no such gate yet
+  literalt &gate_output(gate_kindt kind, bvt inputs);
+
   bool process_clause(const bvt &bv, bvt &dest) const;
 
   static bool is_all(const bvt &bv, literalt l)
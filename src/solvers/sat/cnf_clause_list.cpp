@@ -13,6 +13,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <ostream>
 
+#include "cnf_simplifier.h"
+
 void cnf_clause_listt::lcnf(const bvt &bv)
 {
   bvt new_bv;
@@ -23,6 +25,35 @@ void cnf_clause_listt::lcnf(const bvt &bv)
   clauses.push_back(new_bv);
 }
 
+cnf_simplifiert cnf_clause_listt::get_simplifier(const bvt &assumptions) const
+{
+  std::vector<bool> keep = frozen;
+  keep.resize(no_variables(), false);
+  for(const auto &l : assumptions)
+  {
+    if(!l.is_constant())
+      keep[l.var_no()] = true;
+  }
+
+  return cnf_simplifiert(no_variables(), std::move(keep));
+}
+
+cnf_clause_listt::clausest
+cnf_clause_listt::simplify(cnf_simplifiert &simplifier)
+{
+  clausest result = simplifier.simplify(clauses);
+
+  log.statistics() << "Simplified " << clauses.size() << " clauses to "
+                   << result.size() << ": "
+                   << simplifier.number_of_fixed_variables << " fixed and "
+                   << simplifier.number_of_eliminated_variables
+                   << " eliminated variables, "
+                   << simplifier.number_of_subsumed_clauses
+                   << " subsumed clauses" << messaget::eom;
+
+  return result;
+}
+
 void cnf_clause_list_assignmentt::print_assignment(std::ostream &out) const
 {
   for(unsigned v=1; v<assignment.size(); v++)
@@ -18,6 +18,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "cnf.h"
 
+class cnf_simplifiert;
+
 // CNF given as a list of clauses
 
 class cnf_clause_listt:public cnft
@@ -48,6 +50,22 @@ public:
 
   clausest &get_clauses() { return clauses; }
 
+  /// Simplify the clauses (see \ref cnf_simplifiert) before they are written
+  /// or passed on, keeping the frozen variables
+  void enable_simplification()
+  {
+    simplification = true;
+  }
+
+  void set_frozen(literalt l) override
+  {
+    if(l.is_constant())
+      return;
+    if(frozen.size() <= l.var_no())
+      frozen.resize(l.var_no() + 1, false);
+    frozen[l.var_no()] = true;
+  }
+
   void copy_to(cnft &cnf) const
   {
     cnf.set_no_variables(_no_variables);
@@ -83,6 +101,16 @@ protected:
   }
 
   clausest clauses;
+
+  bool simplification = false;
+  std::vector<bool> frozen;
+
+  /// \return a simplifier that keeps the frozen variables and those of
+  ///   \p assumptions
+  cnf_simplifiert get_simplifier(const bvt &assumptions) const;
+
+  /// \return the clauses as simplified by \p simplifier
+  clausest simplify(cnf_simplifiert &simplifier);
 };
 
 // CNF given as a list of clauses
@@ -0,0 +1,340 @@
+/*******************************************************************\
+
+Module: CNF Simplification
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// CNF Simplification
+
+#include "cnf_simplifier.h"
+
+#include <util/invariant.h>
+#include <util/magic.h>
+
+#include <algorithm>
+
+cnf_simplifiert::cnf_simplifiert(
+  std::size_t no_variables,
+  std::vector<bool> _frozen)
+  : frozen(std::move(_frozen))
+{
+  frozen.resize(no_variables, false);
+  removed.resize(no_variables, false);
+  values.resize(no_variables);
+  occurrences.resize(no_variables * 2);
+}
+
+void cnf_simplifiert::add_clause(bvt literals)
+{
+  if(literals.empty())
+  {
+    conflict = true;
+    return;
+  }
+
+  const std::size_t index = clauses.size();
+  for(const auto &l : literals)
+    occurrences[l.get()].push_back(index);
+
+  clauses.emplace_back();
+  clauses.back().literals = std::move(literals);
+}
+
+void cnf_simplifiert::delete_clause(std::size_t index)
+{
+  clauses[index].deleted = true;
+}
+
+void cnf_simplifiert::propagate_units()
+{
+  bvt units;
+  for(const auto &clause : clauses)
+  {
+    if(!clause.deleted && clause.literals.size() == 1)
+      units.push_back(clause.literals.front());
+  }
+
+  while(!units.empty() && !conflict)
+  {
+    const literalt unit = units.back();
+    units.pop_back();
+
+    tvt &value = values[unit.var_no()];
+    if(value.is_known())
+    {
+      if(value.is_true() == unit.sign())
+        conflict = true;
+      continue;
+    }
+    value = tvt(!unit.sign());
+
+    // clauses are not changed in place, which keeps the occurrence lists
+    // valid
+    for(const auto index : occurrences_of(unit))
+      delete_clause(index);
+
+    for(const auto index : occurrences_of(!unit))
+    {
+      if(clauses[index].deleted)
+        continue;
+
+      delete_clause(index);
+      bvt literals;
+      for(const auto &l : clauses[index].literals)
+      {
+        if(l != !unit)
+          literals.push_back(l);
+      }
+
+      if(literals.size() == 1)
+        units.push_back(literals.front());
+      add_clause(std::move(literals));
+    }
+  }
+}
+
+void cnf_simplifiert::subsume()
+{
+  for(std::size_t index = 0; index < clauses.size(); ++index)
+  {
+    if(clauses[index].deleted)
+      continue;
+
+    const bvt &literals = clauses[index].literals;
+
+    // any clause subsumed by this one contains its least frequent literal
+    literalt rarest = literals.front();
+    for(const auto &l : literals)
+    {
+      if(occurrences_of(l).size() < occurrences_of(rarest).size())
+        rarest = l;
+    }
+
+    if(occurrences_of(rarest).size() > CNF_SUBSUMPTION_MAX_OCCURRENCES)
+      continue;
+
+    for(const auto other : occurrences_of(rarest))
+    {
+      const clauset &clause = clauses[other];
+      if(
+        other != index && !clause.deleted &&
+        clause.literals.size() >= literals.size() &&
+        std::includes(
+          clause.literals.begin(),
+          clause.literals.end(),
+          literals.begin(),
+          literals.end()))
+      {
+        delete_clause(other);
+        ++number_of_subsumed_clauses;
+      }
+    }
+  }
+}
+
+bool cnf_simplifiert::eliminate(literalt::var_not v)
+{
+  const literalt positive(v, false);
+
+  std::vector<std::size_t> positive_clauses, negative_clauses;
+  for(const auto index : occurrences_of(positive))
+  {
+    if(!clauses[index].deleted)
+      positive_clauses.push_back(index);
+  }
+  for(const auto index : occurrences_of(!positive))
+  {
+    if(!clauses[index].deleted)
+      negative_clauses.push_back(index);
+  }
+
+  const std::size_t number_of_clauses =
+    positive_clauses.size() + negative_clauses.size();
+  if(
+    number_of_clauses == 0 ||
+    number_of_clauses > CNF_ELIMINATION_MAX_OCCURRENCES)
+  {
+    return false;
+  }
+
+  // Resolve each clause with v with each clause with v' as long as this
+  // does not increase the number of clauses. Units and empty resolvents are
+  // left to the SAT solver.
+  std::vector<bvt> resolvents;
+  for(const auto p : positive_clauses)
+  {
+    for(const auto n : negative_clauses)
+    {
+      bvt resolvent;
+      std::merge(
+        clauses[p].literals.begin(),
+        clauses[p].literals.end(),
+        clauses[n].literals.begin(),
+        clauses[n].literals.end(),
+        std::back_inserter(resolvent));
+      resolvent.erase(
+        std::unique(resolvent.begin(), resolvent.end()), resolvent.end());
+
+      // literals of the same variable are adjacent
+      bool tautology = false;
+      bvt literals;
+      for(std::size_t i = 0; i < resolvent.size(); ++i)
+      {
+        if(resolvent[i].var_no() == v)
+          continue;
+        if(
+          i + 1 < resolvent.size() &&
+          resolvent[i].var_no() == resolvent[i + 1].var_no())
+        {
+          tautology = true;
+          break;
+        }
+        literals.push_back(resolvent[i]);
+      }
+
+      if(tautology)
+        continue;
+
+      if(
+        literals.size() <= 1 ||
+        literals.size() > CNF_ELIMINATION_MAX_RESOLVENT_SIZE)
+      {
+        return false;
+      }
+
+      resolvents.push_back(std::move(literals));
+      if(resolvents.size() > number_of_clauses)
+        return false;
+    }
+  }
+
+  eliminations.emplace_back();
+  eliminations.back().variable = v;
+  for(const auto &index_list : {positive_clauses, negative_clauses})
+  {
+    for(const auto index : index_list)
+    {
+      eliminations.back().clauses.push_back(clauses[index].literals);
+      delete_clause(index);
+    }
+  }
+
+  for(auto &resolvent : resolvents)
+    add_clause(std::move(resolvent));
+
+  ++number_of_eliminated_variables;
+  return true;
+}
+
+void cnf_simplifiert::eliminate_variables()
+{
+  // try the variables that occur in few clauses first
+  std::vector<std::pair<std::size_t, literalt::var_not>> candidates;
+  for(literalt::var_not v = 1; v < frozen.size(); ++v)
+  {
+    if(frozen[v] || values[v].is_known())
+      continue;
+
+    const literalt positive(v, false);
+    candidates.emplace_back(
+      occurrences_of(positive).size() * occurrences_of(!positive).size(), v);
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  for(const auto &candidate : candidates)
+    eliminate(candidate.second);
+}
+
+cnf_clause_listt::clausest
+cnf_simplifiert::simplify(const cnf_clause_listt::clausest &input)
+{
+  for(const auto &clause : input)
+    add_clause(clause);
+
+  propagate_units();
+
+  if(!conflict)
+  {
+    subsume();
+    eliminate_variables();
+    subsume();
+  }
+
+  cnf_clause_listt::clausest result;
+
+  if(conflict)
+  {
+    result.emplace_back();
+    return result;
+  }
+
+  std::vector<bool> occurs(frozen.size(), false);
+  for(const auto &clause : clauses)
+  {
+    if(clause.deleted)
+      continue;
+
+    result.push_back(clause.literals);
+    for(const auto &l : clause.literals)
+      occurs[l.var_no()] = true;
+  }
+
+  for(literalt::var_not v = 1; v < frozen.size(); ++v)
+  {
+    if(values[v].is_known())
+    {
+      ++number_of_fixed_variables;
+      if(frozen[v])
+        result.push_back({literalt(v, values[v].is_false())});
+    }
+
+    removed[v] = !frozen[v] && !occurs[v];
+  }
+
+  return result;
+}
+
+void cnf_simplifiert::reconstruct(std::vector<tvt> &assignment) const
+{
+  PRECONDITION(!conflict);
+
+  assignment.resize(frozen.size());
+
+  for(literalt::var_not v = 1; v < frozen.size(); ++v)
+  {
+    if(removed[v])
+      assignment[v] = values[v].is_known() ? values[v] : tvt(false);
+  }
+
+  const auto value = [&assignment](literalt l) {
+    return l.sign() ? !assignment[l.var_no()] : assignment[l.var_no()];
+  };
+
+  // In reverse order of elimination, the clauses of an eliminated variable
+  // are satisfied either by the other literals of all clauses with v or by
+  // those of all clauses with v', as the resolvents hold.
+  for(auto it = eliminations.rbegin(); it != eliminations.rend(); ++it)
+  {
+    assignment[it->variable] = tvt(false);
+    for(const auto &clause : it->clauses)
+    {
+      const bool satisfied = std::any_of(
+        clause.begin(), clause.end(), [&value](literalt l) {
+          return value(l).is_true();
+        });
+
+      if(!satisfied)
+      {
+        const auto witness = std::find_if(
+          clause.begin(), clause.end(), [&it](literalt l) {
+            return l.var_no() == it->variable;
+          });
+        INVARIANT(witness != clause.end(), "clause contains the variable");
+        assignment[it->variable] = tvt(!witness->sign());
+      }
+    }
+  }
+}
@@ -0,0 +1,94 @@
+/*******************************************************************\
+
+Module: CNF Simplification
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// CNF Simplification
+
+#ifndef CPROVER_SOLVERS_SAT_CNF_SIMPLIFIER_H
+#define CPROVER_SOLVERS_SAT_CNF_SIMPLIFIER_H
+
+#include <util/threeval.h>
+
+#include "cnf_clause_list.h"
+
+/// Simplifies a list of clauses by unit propagation, subsumption and bounded
+/// variable elimination, as in Eén and Biere, "Effective Preprocessing in SAT
+/// through Variable and Clause Elimination", SAT 2005. Frozen variables keep
+/// their meaning, all others may be removed from the clauses, in which case
+/// \ref reconstruct extends a satisfying assignment of the simplified clauses
+/// to them. Variables keep their numbers.
+class cnf_simplifiert
+{
+public:
+  /// \param no_variables: number of variables, including the unused
+  ///   variable 0
+  /// \param frozen: for each variable whether it must be kept
+  cnf_simplifiert(std::size_t no_variables, std::vector<bool> frozen);
+
+  /// \return the simplified \p input, which is satisfiable iff \p input is,
+  ///   and which is a single empty clause if found to be unsatisfiable
+  cnf_clause_listt::clausest simplify(const cnf_clause_listt::clausest &input);
+
+  /// \return true if variable \p v does not occur in the simplified clauses
+  ///   and is not frozen, which leaves its value to \ref reconstruct
+  bool is_removed(literalt::var_not v) const
+  {
+    return removed[v];
+  }
+
+  /// Extend \p assignment, a satisfying assignment of the simplified clauses
+  /// indexed by variable, to the removed variables
+  void reconstruct(std::vector<tvt> &assignment) const;
+
+  std::size_t number_of_fixed_variables = 0;
+  std::size_t number_of_subsumed_clauses = 0;
+  std::size_t number_of_eliminated_variables = 0;
+
+protected:
+  std::vector<bool> frozen;
+  std::vector<bool> removed;
+
+  /// Values of the variables fixed by unit propagation
+  std::vector<tvt> values;
+
+  struct clauset
+  {
+    bvt literals;
+    bool deleted = false;
+  };
+  std::vector<clauset> clauses;
+
+  /// Indices of the clauses that contain a literal, by literal
+  std::vector<std::vector<std::size_t>> occurrences;
+
+  /// The clauses a variable was eliminated from, for \ref reconstruct
+  struct eliminationt
+  {
+    literalt::var_not variable;
+    std::vector<bvt> clauses;
+  };
+  std::vector<eliminationt> eliminations;
+
+  bool conflict = false;
+
+  void add_clause(bvt literals);
+  void delete_clause(std::size_t index);
+  void propagate_units();
+  void subsume();
+  void eliminate_variables();
+
+  /// \return true if \p v was eliminated
+  bool eliminate(literalt::var_not v);
+
+  const std::vector<std::size_t> &occurrences_of(literalt l) const
+  {
+    return occurrences[l.get()];
+  }
+};
+
+#endif // CPROVER_SOLVERS_SAT_CNF_SIMPLIFIER_H
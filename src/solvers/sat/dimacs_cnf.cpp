@@ -14,6 +14,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <iostream>
 
+#include "cnf_simplifier.h"
+
 dimacs_cnft::dimacs_cnft(message_handlert &message_handler)
   : cnf_clause_listt(message_handler), break_lines(false)
 {
@@ -39,8 +41,20 @@ dimacs_cnf_dumpt::dimacs_cnf_dumpt(
 
 void dimacs_cnft::write_dimacs_cnf(std::ostream &out)
 {
+  if(!simplification)
+  {
+    write_problem_line(out);
+    write_clauses(out);
+    return;
+  }
+
+  // write the simplified clauses in place of the original ones
+  cnf_simplifiert simplifier = get_simplifier(bvt());
+  clausest simplified = simplify(simplifier);
+  clauses.swap(simplified);
   write_problem_line(out);
   write_clauses(out);
+  clauses.swap(simplified);
 }
 
 void dimacs_cnft::write_problem_line(std::ostream &out)
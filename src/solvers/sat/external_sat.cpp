@@ -7,6 +7,7 @@
 
 #include "dimacs_cnf.h"
 
+#include <util/make_unique.h>
 #include <util/run.h>
 #include <util/string_utils.h>
 #include <util/tempfile.h>
@@ -41,12 +42,24 @@ void external_satt::write_cnf_file(std::string cnf_file)
   log.status() << "Writing temporary CNF" << messaget::eom;
   std::ofstream out(cnf_file);
 
+  clausest simplified;
+  if(simplification)
+  {
+    simplifier =
+      util_make_unique<cnf_simplifiert>(get_simplifier(assumptions));
+    simplified = simplify(*simplifier);
+  }
+  else
+    simplifier.reset();
+
+  const clausest &problem = simplifier ? simplified : clauses;
+
   // We start counting at 1, thus there is one variable fewer.
   out << "p cnf " << (no_variables() - 1) << ' '
-      << no_clauses() + assumptions.size() << '\n';
+      << problem.size() + assumptions.size() << '\n';
 
   // output the problem clauses
-  for(auto &c : clauses)
+  for(auto &c : problem)
     dimacs_cnft::write_dimacs_clause(c, out, false);
 
   // output the assumption clauses
@@ -149,13 +162,20 @@ external_satt::resultt external_satt::parse_result(std::string solver_output)
     // We don't need to check zero
     for(size_t index = 1; index < no_variables(); index++)
     {
-      if(!assigned_variables[index])
+      // variables removed by the simplifier need not be assigned
+      if(
+        !assigned_variables[index] &&
+        !(simplifier && simplifier->is_removed(index)))
       {
         log.error() << "No assignment was found for literal: " << index
                     << messaget::eom;
         return resultt::P_ERROR;
       }
     }
+
+    if(simplifier)
+      simplifier->reconstruct(assignment);
+
     return resultt::P_SATISFIABLE;
   }
 
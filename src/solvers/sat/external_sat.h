@@ -6,7 +6,11 @@
 #ifndef CPROVER_SOLVERS_SAT_EXTERNAL_SAT_H
 #define CPROVER_SOLVERS_SAT_EXTERNAL_SAT_H
 
+#include <memory>
+
 #include "cnf_clause_list.h"
+#include "cnf_simplifier.h"
+
 class external_satt : public cnf_clause_list_assignmentt
 {
 public:
@@ -36,6 +40,9 @@ protected:
   std::string solver_cmd;
   bvt assumptions;
 
+  /// The simplifier of the clauses passed to the solver last, if any
+  std::unique_ptr<cnf_simplifiert> simplifier;
+
   resultt do_prop_solve() override;
   void write_cnf_file(std::string);
   std::string execute_solver(std::string);
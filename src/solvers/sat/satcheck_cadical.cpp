@@ -17,6 +17,31 @@ Author: Michael Tautschnig
 
 #include <cadical.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+/// Stops CaDiCaL once a deadline has passed
+class cadical_deadlinet : public CaDiCaL::Terminator
+{
+public:
+  explicit cadical_deadlinet(uint32_t seconds)
+    : deadline(std::chrono::steady_clock::now() + std::chrono::seconds(seconds))
+  {
+  }
+
+  bool terminate() override
+  {
+    timed_out = std::chrono::steady_clock::now() >= deadline;
+    return timed_out;
+  }
+
+  bool timed_out = false;
+
+protected:
+  std::chrono::steady_clock::time_point deadline;
+};
+
 tvt satcheck_cadicalt::l_get(literalt a) const
 {
   if(a.is_constant())
@@ -24,8 +49,12 @@ tvt satcheck_cadicalt::l_get(literalt a) const
 
   tvt result;
 
-  if(a.var_no() > narrow<unsigned>(solver->vars()))
+  // CaDiCaL has a model only until clauses or assumptions are added
+  if(
+    solver->status() != 10 || a.var_no() > narrow<unsigned>(solver->vars()))
+  {
     return tvt(tvt::tv_enumt::TV_UNKNOWN);
+  }
 
   const int val = solver->val(a.dimacs());
   if(val>0)
@@ -64,6 +93,13 @@ void satcheck_cadicalt::lcnf(const bvt &bv)
   solver->add(0); // terminate clause
 
   with_solver_hardness([this, &bv](solver_hardnesst &hardness) {
+    // only the clauses and literals are counted
+    if(hardness.is_aggregated())
+    {
+      hardness.register_clause(bv, bv, 0, false);
+      return;
+    }
+
     // To map clauses to lines of program code, track clause indices in the
     // dimacs cnf output. Dimacs output is generated after processing
     // clauses to remove duplicates and clauses that are trivially true.
@@ -102,10 +138,32 @@ propt::resultt satcheck_cadicalt::do_prop_solve()
     }
   }
 
+  // CaDiCaL drops the assumptions after each call
   for(const auto &a : assumptions)
     solver->assume(a.dimacs());
 
-  switch(solver->solve())
+  optionalt<cadical_deadlinet> deadline;
+  if(time_limit_seconds != 0)
+  {
+    deadline.emplace(time_limit_seconds);
+    solver->connect_terminator(&deadline.value());
+  }
+
+  // CaDiCaL drops the limit after each call as well
+  conflict_limit_reached = false;
+  if(conflict_limit != 0)
+  {
+    const std::size_t max_limit = std::numeric_limits<int>::max();
+    solver->limit(
+      "conflicts", narrow_cast<int>(std::min(conflict_limit, max_limit)));
+  }
+
+  const int solver_result = solver->solve();
+
+  if(deadline.has_value())
+    solver->disconnect_terminator();
+
+  switch(solver_result)
   {
   case 10:
     log.status() << "SAT checker: instance is SATISFIABLE" << messaget::eom;
@@ -115,6 +173,22 @@ propt::resultt satcheck_cadicalt::do_prop_solve()
     log.status() << "SAT checker: instance is UNSATISFIABLE" << messaget::eom;
     break;
   default:
+    if(deadline.has_value() && deadline->timed_out)
+    {
+      log.status() << "SAT checker: timed out" << messaget::eom;
+      status = statust::ERROR;
+      return resultt::P_ERROR;
+    }
+
+    // the solver remains usable after reaching the conflict limit
+    if(conflict_limit != 0)
+    {
+      log.status() << "SAT checker: conflict limit reached" << messaget::eom;
+      status = statust::INIT;
+      conflict_limit_reached = true;
+      return resultt::P_ERROR;
+    }
+
     log.status() << "SAT checker: solving returned without solution"
                  << messaget::eom;
     throw analysis_exceptiont(
@@ -157,7 +231,18 @@ void satcheck_cadicalt::set_assumptions(const bvt &bv)
 
 bool satcheck_cadicalt::is_in_conflict(literalt a) const
 {
-  return solver->failed(a.dimacs());
+  // CaDiCaL has a conflict only until clauses or assumptions are added
+  if(a.is_constant() || solver->status() != 20)
+    return false;
+
+  // as with MiniSat, the conflict is by variable
+  return solver->failed(a.dimacs()) || solver->failed(-a.dimacs());
+}
+
+void satcheck_cadicalt::set_frozen(literalt a)
+{
+  if(!a.is_constant())
+    solver->freeze(a.dimacs());
 }
 
 #endif
@@ -42,6 +42,28 @@ public:
   }
   bool is_in_conflict(literalt a) const override;
 
+  /// Keep CaDiCaL from eliminating the variable of \p a, which is to be used
+  /// in clauses or assumptions of later calls
+  void set_frozen(literalt a) override;
+
+  void set_time_limit_seconds(uint32_t lim) override
+  {
+    time_limit_seconds = lim;
+  }
+
+  void set_conflict_limit(std::size_t limit) override
+  {
+    conflict_limit = limit;
+  }
+  bool has_conflict_limit() const override
+  {
+    return true;
+  }
+  bool reached_conflict_limit() const override
+  {
+    return conflict_limit_reached;
+  }
+
   void
   with_solver_hardness(std::function<void(solver_hardnesst &)> handler) override
   {
@@ -64,6 +86,10 @@ protected:
 
   bvt assumptions;
 
+  uint32_t time_limit_seconds = 0;
+  std::size_t conflict_limit = 0;
+  bool conflict_limit_reached = false;
+
   optionalt<solver_hardnesst> solver_hardness;
 };
 
@@ -124,6 +124,13 @@ void satcheck_glucose_baset<T>::lcnf(const bvt &bv)
     solver->addClause_(c);
 
     with_solver_hardness([this, &bv](solver_hardnesst &hardness) {
+      // only the clauses and literals are counted
+      if(hardness.is_aggregated())
+      {
+        hardness.register_clause(bv, bv, 0, false);
+        return;
+      }
+
       // To map clauses to lines of program code, track clause indices in the
       // dimacs cnf output. Dimacs output is generated after processing
       // clauses to remove duplicates and clauses that are trivially true.
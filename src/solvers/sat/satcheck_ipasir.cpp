@@ -89,6 +89,13 @@ void satcheck_ipasirt::lcnf(const bvt &bv)
   ipasir_add(solver, 0); // terminate clause
 
   with_solver_hardness([this, &bv](solver_hardnesst &hardness) {
+    // only the clauses and literals are counted
+    if(hardness.is_aggregated())
+    {
+      hardness.register_clause(bv, bv, 0, false);
+      return;
+    }
+
     // To map clauses to lines of program code, track clause indices in the
     // dimacs cnf output. Dimacs output is generated after processing
     // clauses to remove duplicates and clauses that are trivially true.
@@ -13,10 +13,19 @@ Author: Daniel Kroening, kroening@kroening.com
 #  include <unistd.h>
 #endif
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <limits>
+#include <mutex>
+#include <thread>
 
 #include <util/invariant.h>
+#include <util/magic.h>
 #include <util/make_unique.h>
+#include <util/narrow.h>
+#include <util/optional.h>
 #include <util/threeval.h>
 
 #include <minisat/core/Solver.h>
@@ -145,6 +154,13 @@ void satcheck_minisat2_baset<T>::lcnf(const bvt &bv)
     solver->addClause_(c);
 
     with_solver_hardness([this, &bv](solver_hardnesst &hardness) {
+      // only the clauses and literals are counted
+      if(hardness.is_aggregated())
+      {
+        hardness.register_clause(bv, bv, 0, false);
+        return;
+      }
+
       // To map clauses to lines of program code, track clause indices in the
       // dimacs cnf output. Dimacs output is generated after processing
       // clauses to remove duplicates and clauses that are trivially true.
@@ -220,6 +236,14 @@ propt::resultt satcheck_minisat2_baset<T>::do_prop_solve()
 
     using Minisat::lbool;
 
+    // the budget is relative to the conflicts of earlier calls
+    const uint64_t conflicts_before = solver->conflicts;
+    conflict_limit_reached = false;
+    if(conflict_limit != 0)
+      solver->setConfBudget(narrow_cast<int64_t>(conflict_limit));
+    else
+      solver->budgetOff();
+
 #ifndef _WIN32
 
     void (*old_handler)(int) = SIG_ERR;
@@ -251,7 +275,7 @@ propt::resultt satcheck_minisat2_baset<T>::do_prop_solve()
                     << messaget::eom;
     }
 
-    lbool solver_result = solver->solve(solver_assumptions) ? l_True : l_False;
+    lbool solver_result = solver->solveLimited(solver_assumptions);
 
 #endif
 
@@ -270,6 +294,17 @@ propt::resultt satcheck_minisat2_baset<T>::do_prop_solve()
       return resultt::P_UNSATISFIABLE;
     }
 
+    // the solver remains usable after reaching the conflict limit
+    if(
+      conflict_limit != 0 &&
+      solver->conflicts - conflicts_before >= conflict_limit)
+    {
+      log.status() << "SAT checker: conflict limit reached" << messaget::eom;
+      status = statust::INIT;
+      conflict_limit_reached = true;
+      return resultt::P_ERROR;
+    }
+
     log.status() << "SAT checker: timed out or other error" << messaget::eom;
     status = statust::ERROR;
     return resultt::P_ERROR;
@@ -371,3 +406,456 @@ bool satcheck_minisat_simplifiert::is_eliminated(literalt a) const
 
   return solver->isEliminated(a.var_no());
 }
+
+satcheck_minisat_portfoliot::satcheck_minisat_portfoliot(
+  message_handlert &message_handler,
+  std::size_t number_of_solvers,
+  std::size_t _number_of_split_variables)
+  : cnf_solvert(message_handler),
+    number_of_split_variables(_number_of_split_variables),
+    number_of_shared_units(number_of_solvers, 0)
+{
+  PRECONDITION(number_of_solvers >= 1);
+
+  for(std::size_t i = 0; i < number_of_solvers; ++i)
+  {
+    solvers.push_back(util_make_unique<Minisat::Solver>());
+
+    if(i != 0)
+    {
+      // as MiniSat's -rnd-seed, -rnd-init and -rnd-freq
+      solvers.back()->random_seed += static_cast<double>(i);
+      solvers.back()->rnd_init_act = true;
+      solvers.back()->random_var_freq = 0.02;
+    }
+  }
+}
+
+satcheck_minisat_portfoliot::~satcheck_minisat_portfoliot() = default;
+
+const std::string satcheck_minisat_portfoliot::solver_text()
+{
+  return "portfolio of " + std::to_string(solvers.size()) +
+         " MiniSAT 2.2.1 without simplifier";
+}
+
+void satcheck_minisat_portfoliot::add_variables()
+{
+  for(auto &solver : solvers)
+  {
+    while((unsigned)solver->nVars() < no_variables())
+      solver->newVar();
+  }
+}
+
+tvt satcheck_minisat_portfoliot::l_get(literalt a) const
+{
+  if(a.is_true())
+    return tvt(true);
+  else if(a.is_false())
+    return tvt(false);
+
+  const auto &model = solvers[winner]->model;
+
+  if(a.var_no() >= (unsigned)model.size())
+    return tvt::unknown();
+
+  using Minisat::lbool;
+
+  tvt result;
+  if(model[a.var_no()] == l_True)
+    result = tvt(true);
+  else if(model[a.var_no()] == l_False)
+    result = tvt(false);
+  else
+    return tvt::unknown();
+
+  return a.sign() ? !result : result;
+}
+
+void satcheck_minisat_portfoliot::lcnf(const bvt &bv)
+{
+  try
+  {
+    add_variables();
+
+    for(const auto &literal : bv)
+    {
+      if(literal.is_true())
+        return;
+      else if(!literal.is_false())
+      {
+        INVARIANT(literal.var_no() < no_variables(), "variable not added yet");
+      }
+    }
+
+    // each instance gets a copy, as MiniSat modifies the clause
+    for(auto &solver : solvers)
+    {
+      Minisat::vec<Minisat::Lit> c;
+      convert(bv, c);
+      solver->addClause_(c);
+    }
+
+    clause_counter++;
+  }
+  catch(const Minisat::OutOfMemoryException &)
+  {
+    log.error() << "SAT checker ran out of memory" << messaget::eom;
+    status = statust::ERROR;
+    throw std::bad_alloc();
+  }
+}
+
+/// \return the number of literals propagated by assuming \p l in \p solver,
+///   or an empty optional if that yields a conflict, which makes !l a unit
+static optionalt<std::uint64_t>
+look_ahead(Minisat::Solver &solver, literalt l)
+{
+  Minisat::vec<Minisat::Lit> assumption;
+  convert({l}, assumption);
+
+  // the search stops once the assumption is propagated
+  const std::uint64_t propagations = solver.propagations;
+  solver.setPropBudget(1);
+  const Minisat::lbool result = solver.solveLimited(assumption);
+  solver.budgetOff();
+
+  using Minisat::lbool;
+  if(result == l_False)
+    return {};
+
+  return solver.propagations - propagations;
+}
+
+void satcheck_minisat_portfoliot::choose_split_variables()
+{
+  using scoret = std::pair<std::uint64_t, literalt::var_not>;
+  std::vector<scoret> scores;
+  std::vector<bool> seen(no_variables(), false);
+  bvt failed;
+
+  for(const auto &candidate : split_candidates)
+  {
+    if(scores.size() == SAT_LOOK_AHEAD_CANDIDATES)
+      break;
+
+    if(candidate.is_constant() || seen[candidate.var_no()])
+      continue;
+    seen[candidate.var_no()] = true;
+
+    const literalt positive(candidate.var_no(), false);
+    const auto positive_propagations = look_ahead(*solvers.front(), positive);
+    const auto negative_propagations = look_ahead(*solvers.front(), !positive);
+
+    if(!positive_propagations.has_value())
+      failed.push_back(!positive);
+    else if(!negative_propagations.has_value())
+      failed.push_back(positive);
+    else
+    {
+      // as in march, a variable that decides much either way splits well
+      scores.emplace_back(
+        *positive_propagations * *negative_propagations, positive.var_no());
+    }
+  }
+
+  for(const auto &unit : failed)
+    lcnf({unit});
+
+  const std::size_t number_of_chosen =
+    std::min(number_of_split_variables, scores.size());
+  std::partial_sort(
+    scores.begin(),
+    scores.begin() + number_of_chosen,
+    scores.end(),
+    std::greater<scoret>());
+
+  split_variables.clear();
+  for(std::size_t i = 0; i < number_of_chosen; ++i)
+    split_variables.push_back(scores[i].second);
+
+  log.statistics() << "Splitting on " << split_variables.size() << " of "
+                   << split_candidates.size() << " candidates, "
+                   << failed.size() << " failed literals" << messaget::eom;
+}
+
+void satcheck_minisat_portfoliot::share_units(const Minisat::Solver &solver)
+{
+  using Minisat::lbool;
+
+  // learnt units are assigned at decision level 0 once the search returns
+  if(solver.nAssigns() == 0)
+    return;
+
+  is_shared_unit.resize(no_variables(), false);
+  for(literalt::var_not v = 1; v < no_variables(); ++v)
+  {
+    const lbool value = solver.value(static_cast<Minisat::Var>(v));
+    if(!is_shared_unit[v] && value != l_Undef)
+    {
+      is_shared_unit[v] = true;
+      shared_units.push_back(literalt(v, value == l_False));
+    }
+  }
+}
+
+propt::resultt satcheck_minisat_portfoliot::do_prop_solve()
+{
+  PRECONDITION(status != statust::ERROR);
+
+  log.statistics() << (no_variables() - 1) << " variables, "
+                   << solvers.front()->nClauses() << " clauses, "
+                   << solvers.size() << " solver threads" << messaget::eom;
+
+  conflict_variables.clear();
+
+  try
+  {
+    add_variables();
+
+    if(!split_candidates.empty())
+    {
+      if(number_of_split_variables != 0)
+        choose_split_variables();
+      split_candidates.clear();
+    }
+  }
+  catch(const Minisat::OutOfMemoryException &)
+  {
+    log.error() << "SAT checker ran out of memory" << messaget::eom;
+    status = statust::ERROR;
+    return resultt::P_ERROR;
+  }
+
+  // all instances have the same clauses, hence agree on this
+  if(!solvers.front()->okay())
+  {
+    log.status() << "SAT checker inconsistent: instance is UNSATISFIABLE"
+                 << messaget::eom;
+    status = statust::UNSAT;
+    return resultt::P_UNSATISFIABLE;
+  }
+
+  // if assumptions contains false, we need this to be UNSAT
+  for(const auto &assumption : assumptions)
+  {
+    if(assumption.is_false())
+    {
+      log.status() << "got FALSE as assumption: instance is UNSATISFIABLE"
+                   << messaget::eom;
+      status = statust::UNSAT;
+      return resultt::P_UNSATISFIABLE;
+    }
+  }
+
+  conflict_variables.resize(no_variables(), false);
+  std::vector<bool> is_assumption_variable(no_variables(), false);
+  for(const auto &assumption : assumptions)
+    is_assumption_variable[assumption.var_no()] = true;
+
+  using Minisat::lbool;
+
+  // Without splitting variables, each instance solves the whole formula,
+  // otherwise each takes the next cube until there are no more.
+  const std::size_t number_of_cubes =
+    split_variables.empty() ? 0 : std::size_t(1) << split_variables.size();
+  std::size_t next_cube = 0;
+  std::size_t number_of_unsat_cubes = 0;
+
+  std::mutex mutex;
+  std::condition_variable finished;
+  optionalt<std::size_t> first;
+  lbool first_result = l_Undef;
+  bool interrupted = false;
+  std::size_t number_of_finished = 0;
+
+  const auto interrupt_all = [this, &interrupted]() {
+    interrupted = true;
+    for(auto &solver : solvers)
+      solver->interrupt();
+  };
+
+  const auto worker = [&](std::size_t i) {
+    Minisat::Solver &solver = *solvers[i];
+    bool has_job = true;
+
+    while(has_job)
+    {
+      bvt job_assumptions = assumptions;
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if(number_of_cubes == 0)
+          has_job = false;
+        else if(next_cube == number_of_cubes || interrupted)
+          break;
+        else
+        {
+          const std::size_t cube = next_cube++;
+          for(std::size_t bit = 0; bit < split_variables.size(); ++bit)
+          {
+            job_assumptions.push_back(
+              literalt(split_variables[bit], ((cube >> bit) & 1) != 0));
+          }
+        }
+
+        try
+        {
+          for(; number_of_shared_units[i] < shared_units.size();
+              ++number_of_shared_units[i])
+          {
+            Minisat::vec<Minisat::Lit> c;
+            convert({shared_units[number_of_shared_units[i]]}, c);
+            solver.addClause_(c);
+          }
+        }
+        catch(const Minisat::OutOfMemoryException &)
+        {
+          break;
+        }
+      }
+
+      Minisat::vec<Minisat::Lit> solver_assumptions;
+      convert(job_assumptions, solver_assumptions);
+
+      lbool result = l_Undef;
+      try
+      {
+        result = solver.solveLimited(solver_assumptions);
+      }
+      catch(const Minisat::OutOfMemoryException &)
+      {
+        // the others may still succeed
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      share_units(solver);
+
+      if(result == l_Undef || first.has_value())
+        break;
+
+      if(result == l_False)
+      {
+        // the conflict with the cube literals left out is a conflict of the
+        // whole formula, as the cubes cover all assignments
+        for(int j = 0; j < solver.conflict.size(); ++j)
+        {
+          const auto v =
+            static_cast<literalt::var_not>(var(solver.conflict[j]));
+          if(is_assumption_variable[v])
+            conflict_variables[v] = true;
+        }
+      }
+
+      if(
+        result == l_True ||
+        (number_of_cubes == 0 || ++number_of_unsat_cubes == number_of_cubes))
+      {
+        first = i;
+        first_result = result;
+        interrupt_all();
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ++number_of_finished;
+    finished.notify_one();
+  };
+
+  std::vector<std::thread> threads;
+  for(std::size_t i = 0; i < solvers.size(); ++i)
+    threads.emplace_back(worker, i);
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    const auto done = [&]() {
+      return first.has_value() || number_of_finished == solvers.size();
+    };
+
+    if(time_limit_seconds == 0)
+      finished.wait(lock, done);
+    else if(!finished.wait_for(
+              lock, std::chrono::seconds(time_limit_seconds), done))
+    {
+      interrupt_all();
+    }
+  }
+
+  for(auto &thread : threads)
+    thread.join();
+
+  for(auto &solver : solvers)
+    solver->clearInterrupt();
+
+  if(number_of_cubes != 0)
+  {
+    log.statistics() << "SAT checker: " << number_of_unsat_cubes << " of "
+                     << number_of_cubes << " cubes unsatisfiable"
+                     << messaget::eom;
+  }
+
+  if(first.has_value())
+  {
+    log.statistics() << "SAT checker: solver thread " << *first
+                     << " finished first" << messaget::eom;
+
+    if(first_result == l_True)
+    {
+      winner = *first;
+      log.status() << "SAT checker: instance is SATISFIABLE" << messaget::eom;
+      CHECK_RETURN(solvers[winner]->model.size() > 0);
+      status = statust::SAT;
+      return resultt::P_SATISFIABLE;
+    }
+
+    log.status() << "SAT checker: instance is UNSATISFIABLE" << messaget::eom;
+    status = statust::UNSAT;
+    return resultt::P_UNSATISFIABLE;
+  }
+
+  log.status() << "SAT checker: timed out or other error" << messaget::eom;
+  status = statust::ERROR;
+  return resultt::P_ERROR;
+}
+
+void satcheck_minisat_portfoliot::set_assignment(literalt a, bool value)
+{
+  PRECONDITION(!a.is_constant());
+
+  try
+  {
+    const unsigned v = a.var_no();
+
+    // MiniSat2 kills the model in case of UNSAT
+    auto &model = solvers[winner]->model;
+    model.growTo(v + 1);
+    model[v] = Minisat::lbool(value != a.sign());
+  }
+  catch(const Minisat::OutOfMemoryException &)
+  {
+    log.error() << "SAT checker ran out of memory" << messaget::eom;
+    status = statust::ERROR;
+    throw std::bad_alloc();
+  }
+}
+
+void satcheck_minisat_portfoliot::set_assumptions(const bvt &bv)
+{
+  // We filter out 'true' assumptions which cause an assertion violation
+  // in Minisat2.
+  assumptions.clear();
+  for(const auto &assumption : bv)
+  {
+    if(!assumption.is_true())
+      assumptions.push_back(assumption);
+  }
+}
+
+bool satcheck_minisat_portfoliot::is_in_conflict(literalt a) const
+{
+  return a.var_no() < conflict_variables.size() &&
+         conflict_variables[a.var_no()];
+}
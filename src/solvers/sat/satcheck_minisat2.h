@@ -13,8 +13,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "cnf.h"
 
 #include <solvers/hardness_collector.h>
+#include <solvers/prop/cube_splitter.h>
 
 #include <memory>
+#include <vector>
 
 // Select one: basic solver or with simplification.
 // Note that the solver with simplifier isn't really robust
@@ -68,6 +70,19 @@ public:
     time_limit_seconds=lim;
   }
 
+  void set_conflict_limit(std::size_t limit) override
+  {
+    conflict_limit = limit;
+  }
+  bool has_conflict_limit() const override
+  {
+    return true;
+  }
+  bool reached_conflict_limit() const override
+  {
+    return conflict_limit_reached;
+  }
+
   void
   with_solver_hardness(std::function<void(solver_hardnesst &)> handler) override
   {
@@ -87,6 +102,8 @@ protected:
 
   std::unique_ptr<T> solver;
   uint32_t time_limit_seconds;
+  std::size_t conflict_limit = 0;
+  bool conflict_limit_reached = false;
 
   void add_variables();
   bvt assumptions;
@@ -112,4 +129,91 @@ public:
   bool is_eliminated(literalt a) const;
 };
 
+/// Runs several instances of MiniSat without simplifier on the same clauses
+/// in parallel threads and uses the result of the first to finish, which
+/// interrupts the others. The instances differ in their random seeds and
+/// initial activities only, the first one uses the defaults of MiniSat. They
+/// share the units they learn, and each keeps its learnt clauses across
+/// incremental calls.
+///
+/// With splitting variables, the formula is instead split into the cubes
+/// over these variables, which the instances take in turn and solve under
+/// assumptions (cube-and-conquer). The splitting variables are chosen from
+/// the candidates by look-ahead: the variables whose literals both propagate
+/// the most are preferred, and failed literals become units.
+class satcheck_minisat_portfoliot : public cnf_solvert, public cube_splittert
+{
+public:
+  /// \param message_handler: for status output
+  /// \param number_of_solvers: the number of instances and threads
+  /// \param number_of_split_variables: the number of variables the formula
+  ///   is split on, provided there are enough candidates
+  satcheck_minisat_portfoliot(
+    message_handlert &message_handler,
+    std::size_t number_of_solvers,
+    std::size_t number_of_split_variables = 0);
+  ~satcheck_minisat_portfoliot() override;
+
+  const std::string solver_text() override;
+  tvt l_get(literalt a) const override;
+
+  void lcnf(const bvt &bv) override;
+  void set_assignment(literalt a, bool value) override;
+
+  void set_assumptions(const bvt &_assumptions) override;
+  bool is_in_conflict(literalt a) const override;
+  bool has_set_assumptions() const override
+  {
+    return true;
+  }
+  bool has_is_in_conflict() const override
+  {
+    return true;
+  }
+
+  void set_time_limit_seconds(uint32_t lim) override
+  {
+    time_limit_seconds = lim;
+  }
+
+  void set_split_candidates(const bvt &candidates) override
+  {
+    split_candidates = candidates;
+  }
+
+protected:
+  resultt do_prop_solve() override;
+
+  std::vector<std::unique_ptr<Minisat::Solver>> solvers;
+
+  /// The instance that satisfied the formula last, which has the model
+  std::size_t winner = 0;
+
+  /// For each variable whether it is in the conflict of the last call
+  std::vector<bool> conflict_variables;
+
+  uint32_t time_limit_seconds = 0;
+  bvt assumptions;
+
+  const std::size_t number_of_split_variables;
+  bvt split_candidates;
+  std::vector<literalt::var_not> split_variables;
+
+  /// The units learnt by any instance, and for each instance how many of
+  /// them it has been given
+  bvt shared_units;
+  std::vector<bool> is_shared_unit;
+  std::vector<std::size_t> number_of_shared_units;
+
+  void add_variables();
+
+  /// Choose the splitting variables among the candidates by look-ahead with
+  /// the first instance
+  void choose_split_variables();
+
+  /// Share the units that \p solver has learnt, which requires the mutex of
+  /// the solver threads
+  void share_units(const Minisat::Solver &solver);
+};
+
 #endif // CPROVER_SOLVERS_SAT_SATCHECK_MINISAT2_H
@@ -62,6 +62,7 @@ smt2_convt::smt2_convt(
     use_check_sat_assuming(false),
     use_datatypes(false),
     use_lambda_for_array(false),
+    use_shared_terms(false),
     emit_set_logic(true),
     ns(_ns),
     out(_out),
@@ -185,6 +186,16 @@ void smt2_convt::write_footer()
   for(const auto &object : object_sizes)
     define_object_size(object.second, object.first);
 
+  write_check_sat();
+
+  out << "(exit)\n";
+
+  out << "; end of SMT2 file"
+      << "\n";
+}
+
+void smt2_convt::write_check_sat()
+{
   if(use_check_sat_assuming && !assumptions.empty())
   {
     out << "(check-sat-assuming (";
@@ -213,7 +224,14 @@ void smt2_convt::write_footer()
 
   out << "\n";
 
-  if(solver!=solvert::BOOLECTOR)
+  if(number_of_get_values() == 1)
+  {
+    out << "(get-value (";
+    for(const auto &id : smt2_identifiers)
+      out << "\n  |" << id << "|";
+    out << "))\n";
+  }
+  else if(number_of_get_values() != 0)
   {
     for(const auto &id : smt2_identifiers)
       out << "(get-value (|" << id << "|))"
@@ -221,11 +239,16 @@ void smt2_convt::write_footer()
   }
 
   out << "\n";
+}
 
-  out << "(exit)\n";
-
-  out << "; end of SMT2 file"
-      << "\n";
+std::size_t smt2_convt::number_of_get_values() const
+{
+  if(solver == solvert::BOOLECTOR || smt2_identifiers.empty())
+    return 0;
+  else if(has_quantifiers)
+    return smt2_identifiers.size();
+  else
+    return 1;
 }
 
 void smt2_convt::define_object_size(
@@ -857,19 +880,33 @@ void smt2_convt::convert_literal(const literalt l)
 
 void smt2_convt::push()
 {
-  UNIMPLEMENTED;
+  // We create a new context literal.
+  literalt context_literal(no_boolean_variables, false);
+  no_boolean_variables++;
+
+  out << "\n; context\n(declare-fun ";
+  convert_literal(context_literal);
+  out << " () Bool)\n";
+
+  assumptions.push_back(literal_exprt(context_literal));
+  context_size_stack.push_back(1);
 }
 
 void smt2_convt::push(const std::vector<exprt> &_assumptions)
 {
-  INVARIANT(assumptions.empty(), "nested contexts are not supported");
-
-  assumptions = _assumptions;
+  // We push the given assumptions as a single context onto the stack.
+  assumptions.insert(
+    assumptions.end(), _assumptions.begin(), _assumptions.end());
+  context_size_stack.push_back(_assumptions.size());
 }
 
 void smt2_convt::pop()
 {
-  assumptions.clear();
+  PRECONDITION(!context_size_stack.empty());
+
+  // We remove the context from the stack.
+  assumptions.resize(assumptions.size() - context_size_stack.back());
+  context_size_stack.pop_back();
 }
 
 std::string smt2_convt::convert_identifier(const irep_idt &identifier)
@@ -983,6 +1020,16 @@ void smt2_convt::convert_floatbv(const exprt &expr)
 
 void smt2_convt::convert_expr(const exprt &expr)
 {
+  if(use_shared_terms && binding_depth == 0 && !expr.operands().empty())
+  {
+    const auto shared_term = shared_terms.find(expr);
+    if(shared_term != shared_terms.end())
+    {
+      out << shared_term->second;
+      return;
+    }
+  }
+
   // huge monster case split over expression id
   if(expr.id()==ID_symbol)
   {
@@ -1410,6 +1457,7 @@ void smt2_convt::convert_expr(const exprt &expr)
 
     if(use_lambda_for_array)
     {
+      ++binding_depth;
       out << "(lambda ((";
       convert_expr(array_comprehension.arg());
       out << " ";
@@ -1417,6 +1465,7 @@ void smt2_convt::convert_expr(const exprt &expr)
       out << ")) ";
       convert_expr(array_comprehension.body());
       out << ")";
+      --binding_depth;
     }
     else
     {
@@ -1955,6 +2004,7 @@ void smt2_convt::convert_expr(const exprt &expr)
           expr.id()==ID_exists)
   {
     const quantifier_exprt &quantifier_expr = to_quantifier_expr(expr);
+    has_quantifiers = true;
 
     if(solver==solvert::MATHSAT)
       // NOLINTNEXTLINE(readability/throw)
@@ -1967,6 +2017,7 @@ void smt2_convt::convert_expr(const exprt &expr)
 
     exprt bound = quantifier_expr.symbol();
 
+    ++binding_depth;
     out << "((";
     convert_expr(bound);
     out << " ";
@@ -1976,6 +2027,7 @@ void smt2_convt::convert_expr(const exprt &expr)
     convert_expr(quantifier_expr.where());
 
     out << ")";
+    --binding_depth;
   }
   else if(expr.id()==ID_vector)
   {
@@ -2016,6 +2068,7 @@ void smt2_convt::convert_expr(const exprt &expr)
     const auto &variables = let_expr.variables();
     const auto &values = let_expr.values();
 
+    ++binding_depth;
     out << "(let (";
     bool first = true;
 
@@ -2037,6 +2090,7 @@ void smt2_convt::convert_expr(const exprt &expr)
 
     convert_expr(let_expr.where());
     out << ')'; // let
+    --binding_depth;
   }
   else if(expr.id()==ID_constraint_select_one)
   {
@@ -4333,6 +4387,23 @@ void smt2_convt::set_to(const exprt &expr, bool value)
 {
   PRECONDITION(expr.type().id() == ID_bool);
 
+  if(!assumptions.empty())
+  {
+    // We have a child context. We add context_literal ==> expr to the formula.
+    const exprt prepared_expr = prepare_for_convert_expr(expr);
+    out << "\n; set_to " << (value ? "true" : "false") << " in context\n"
+        << "(assert (or ";
+    convert_literal(!to_literal_expr(assumptions.back()).get_literal());
+    out << " ";
+    if(!value)
+      out << "(not ";
+    convert_expr(prepared_expr);
+    if(!value)
+      out << ")";
+    out << "))\n";
+    return;
+  }
+
   if(expr.id()==ID_and && value)
   {
     forall_operands(it, expr)
@@ -4429,6 +4500,24 @@ void smt2_convt::set_to(const exprt &expr, bool value)
   return;
 }
 
+/// Lower the byte operator \p expr, which expressions over the same objects
+/// often share, unless it has been lowered before
+exprt smt2_convt::lower_byte_operator(const exprt &expr)
+{
+  const auto entry = byte_operator_lowering_cache.find(expr);
+  if(entry != byte_operator_lowering_cache.end())
+    return entry->second;
+
+  exprt lowered_expr =
+    expr.id() == ID_byte_extract_little_endian ||
+        expr.id() == ID_byte_extract_big_endian
+      ? lower_byte_extract(to_byte_extract_expr(expr), ns)
+      : lower_byte_update(to_byte_update_expr(expr), ns);
+
+  return byte_operator_lowering_cache.emplace(expr, std::move(lowered_expr))
+    .first->second;
+}
+
 /// Lower byte_update and byte_extract operations within \p expr. Return an
 /// equivalent expression that doesn't use byte operators.
 /// Note this replaces operators post-order (compare \ref lower_byte_operators,
@@ -4447,13 +4536,13 @@ exprt smt2_convt::lower_byte_operators(const exprt &expr)
       it->id() == ID_byte_extract_little_endian ||
       it->id() == ID_byte_extract_big_endian)
     {
-      it.mutate() = lower_byte_extract(to_byte_extract_expr(*it), ns);
+      it.mutate() = lower_byte_operator(*it);
     }
     else if(
       it->id() == ID_byte_update_little_endian ||
       it->id() == ID_byte_update_big_endian)
     {
-      it.mutate() = lower_byte_update(to_byte_update_expr(*it), ns);
+      it.mutate() = lower_byte_operator(*it);
     }
   }
 
@@ -4479,9 +4568,60 @@ exprt smt2_convt::prepare_for_convert_expr(const exprt &expr)
   // Now create symbols for all composite expressions present in lowered_expr:
   find_symbols(lowered_expr);
 
+  if(use_shared_terms)
+    define_shared_terms(lowered_expr);
+
   return lowered_expr;
 }
 
+/// \return whether the SMT2 sort of terms of type \p type is the one of
+///   \ref smt2_convt::convert_type, and hence whether such terms can be
+///   defined by `define-fun`
+static bool is_shareable_type(const typet &type)
+{
+  return type.id() == ID_bool || type.id() == ID_signedbv ||
+         type.id() == ID_unsignedbv || type.id() == ID_bv ||
+         type.id() == ID_floatbv || type.id() == ID_pointer;
+}
+
+void smt2_convt::define_shared_terms(const exprt &expr)
+{
+  std::vector<const exprt *> stack{&expr};
+  while(!stack.empty())
+  {
+    const exprt &term = *stack.back();
+    stack.pop_back();
+
+    // terms with bound symbols cannot be defined outside the binder
+    if(
+      term.operands().empty() || term.id() == ID_forall ||
+      term.id() == ID_exists || term.id() == ID_let ||
+      term.id() == ID_array_comprehension ||
+      shared_terms.find(term) != shared_terms.end())
+    {
+      continue;
+    }
+
+    // The first occurrence is written as is, any further ones refer to a
+    // definition. The operands then need not be looked at again.
+    if(++term_occurrences[term] > 1 && is_shareable_type(term.type()))
+    {
+      const std::string name =
+        "|share." + std::to_string(shared_terms.size()) + "|";
+      out << "(define-fun " << name << " () ";
+      convert_type(term.type());
+      out << ' ';
+      convert_expr(term);
+      out << ")\n";
+      shared_terms.emplace(term, name);
+      continue;
+    }
+
+    for(const auto &op : term.operands())
+      stack.push_back(&op);
+  }
+}
+
 void smt2_convt::find_symbols(const exprt &expr)
 {
   // recursive call on type
@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <map>
 #include <set>
 #include <sstream>
+#include <unordered_map>
 
 #include <util/std_expr.h>
 #include <util/threeval.h>
@@ -63,6 +64,7 @@ public:
   bool use_check_sat_assuming;
   bool use_datatypes;
   bool use_lambda_for_array;
+  bool use_shared_terms;
   bool emit_set_logic;
 
   exprt handle(const exprt &expr) override;
@@ -71,13 +73,13 @@ public:
   std::string decision_procedure_text() const override;
   void print_assignment(std::ostream &out) const override;
 
-  /// Unimplemented
+  /// Push a new context, in which \ref set_to asserts its expression only
+  /// under a fresh Boolean that is assumed until the context is popped
   void push() override;
 
-  /// Currently, only implements a single stack element (no nested contexts)
+  /// Push \p _assumptions as a new context of assumptions
   void push(const std::vector<exprt> &_assumptions) override;
 
-  /// Currently, only implements a single stack element (no nested contexts)
   void pop() override;
 
   std::size_t get_number_of_solver_calls() const override;
@@ -90,7 +92,9 @@ protected:
   std::string benchmark, notes, logic;
   solvert solver;
 
+  /// The assumptions of all contexts, segmented by `context_size_stack`
   std::vector<exprt> assumptions;
+  std::vector<std::size_t> context_size_stack;
   boolbv_widtht boolbv_width;
 
   std::size_t number_of_solver_calls = 0;
@@ -104,10 +108,21 @@ protected:
   ///  * The object size definitions.
   ///  * The assertions based on the `assumptions` member variable.
   ///  * The `(check-sat)` or `check-sat-assuming` command.
-  ///  * A `(get-value |identifier|)` command for each of the identifiers in
-  ///    `smt2_convt::smt2_identifiers`.
+  ///  * A `(get-value ...)` command for the identifiers in
+  ///    `smt2_convt::smt2_identifiers`, see \ref number_of_get_values.
   ///  * An `(exit)` command.
   void write_footer();
+  /// Writes the `(check-sat)` or `check-sat-assuming` command for the
+  /// `assumptions` and the `(get-value ...)` commands to the
+  /// `smt_convt::out` stream, as part of \ref write_footer
+  void write_check_sat();
+  /// \return the number of `get-value` commands \ref write_check_sat writes,
+  ///   which is one for all identifiers at once unless the problem contains
+  ///   quantifiers, as then the solver may fail to give some values
+  std::size_t number_of_get_values() const;
+
+  /// Whether a quantifier has been converted
+  bool has_quantifiers = false;
 
   // tweaks for arrays
   bool use_array_theory(const exprt &);
@@ -148,6 +163,8 @@ protected:
   // auxiliary methods
   exprt prepare_for_convert_expr(const exprt &expr);
   exprt lower_byte_operators(const exprt &expr);
+  exprt lower_byte_operator(const exprt &expr);
+  std::unordered_map<exprt, exprt, irep_hash> byte_operator_lowering_cache;
   void find_symbols(const exprt &expr);
   void find_symbols(const typet &type);
   void find_symbols_rec(const typet &type, std::set<irep_idt> &recstack);
@@ -248,6 +265,15 @@ protected:
   // ID_array
   // ID_string_constant
 
+  /// Terms outside of binders that occur more than once in the problem are
+  /// defined by `define-fun` upon their second occurrence and then referred
+  /// to by the name in `shared_terms`.
+  void define_shared_terms(const exprt &);
+  std::unordered_map<exprt, std::size_t, irep_hash> term_occurrences;
+  std::unordered_map<exprt, std::string, irep_hash> shared_terms;
+  /// The number of binders the expression being converted is in
+  std::size_t binding_depth = 0;
+
   typedef std::map<exprt, irep_idt> defined_expressionst;
   defined_expressionst defined_expressions;
   /// The values which boolean identifiers have been `smt2_convt::set_to` or
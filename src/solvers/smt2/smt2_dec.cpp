@@ -8,13 +8,77 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "smt2_dec.h"
 
+#include <algorithm>
+
 #include <util/invariant.h>
+#include <util/magic.h>
 #include <util/message.h>
 #include <util/run.h>
-#include <util/tempfile.h>
 
 #include "smt2irep.h"
 
+smt2_file_buffert::smt2_file_buffert() : buffer(SMT2_OUTPUT_BUFFER_SIZE)
+{
+  setp(buffer.data(), buffer.data() + buffer.size());
+}
+
+void smt2_file_buffert::open(const std::string &filename)
+{
+  // we write in large chunks already
+  file.rdbuf()->pubsetbuf(nullptr, 0);
+  file.open(filename, std::ios_base::out | std::ios_base::binary);
+}
+
+smt2_file_buffert::int_type smt2_file_buffert::overflow(int_type c)
+{
+  if(sync() == -1)
+    return traits_type::eof();
+
+  if(!traits_type::eq_int_type(c, traits_type::eof()))
+  {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+
+  return traits_type::not_eof(c);
+}
+
+int smt2_file_buffert::sync()
+{
+  const std::size_t size = pptr() - pbase();
+  if(size == 0)
+    return 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  file.write(pbase(), size);
+  file.flush();
+  write_time += std::chrono::steady_clock::now() - start;
+
+  bytes_written += size;
+  file_position += size;
+  setp(buffer.data(), buffer.data() + buffer.size());
+
+  return file ? 0 : -1;
+}
+
+void smt2_file_buffert::rewind(std::size_t _position)
+{
+  PRECONDITION(_position <= position());
+
+  sync();
+  file.seekp(_position);
+  file_position = _position;
+}
+
+smt2_problem_filet::smt2_problem_filet(bool open) : problem_out(&problem_buffer)
+{
+  if(open)
+  {
+    problem_file.emplace("smt2_dec_problem_", "");
+    problem_buffer.open((*problem_file)());
+  }
+}
+
 std::string smt2_dect::decision_procedure_text() const
 {
   // clang-format off
@@ -35,19 +99,34 @@ decision_proceduret::resultt smt2_dect::dec_solve()
 {
   ++number_of_solver_calls;
 
-  temporary_filet temp_file_problem("smt2_dec_problem_", ""),
-    temp_file_stdout("smt2_dec_stdout_", ""),
+  PRECONDITION(problem_file.has_value());
+  const temporary_filet &temp_file_problem = *problem_file;
+  temporary_filet temp_file_stdout("smt2_dec_stdout_", ""),
     temp_file_stderr("smt2_dec_stderr_", "");
 
-  const auto write_problem_to_file = [&](std::ofstream problem_out) {
-    cached_output << stringstream.str();
-    stringstream.str(std::string{});
-    write_footer();
-    problem_out << cached_output.str() << stringstream.str();
-    stringstream.str(std::string{});
-  };
-  write_problem_to_file(std::ofstream(
-    temp_file_problem(), std::ios_base::out | std::ios_base::trunc));
+  // The footer is written after the problem converted so far, and is
+  // overwritten by anything converted later. Any rest of a longer footer
+  // written before is blanked out.
+  const std::size_t footer_position = problem_buffer.position();
+  write_footer();
+  if(problem_buffer.position() < problem_end)
+    problem_out << std::string(problem_end - problem_buffer.position(), ' ');
+  problem_end = problem_buffer.position();
+  problem_out.flush();
+
+  messaget log{message_handler};
+  log.statistics() << "Wrote " << problem_buffer.bytes_written
+                   << " bytes of SMT2 in "
+                   << problem_buffer.write_time.count() << 's'
+                   << messaget::eom;
+
+  problem_buffer.rewind(footer_position);
+
+  if(!problem_out)
+  {
+    log.error() << "error writing SMT2 problem" << messaget::eom;
+    return decision_proceduret::resultt::D_ERROR;
+  }
 
   std::vector<std::string> argv;
   std::string stdin_filename;
@@ -121,16 +200,21 @@ decision_proceduret::resultt smt2_dect::dec_solve()
 
   if(res<0)
   {
-    messaget log{message_handler};
     log.error() << "error running SMT2 solver" << messaget::eom;
     return decision_proceduret::resultt::D_ERROR;
   }
 
-  std::ifstream in(temp_file_stdout());
+  // the tokenizer reads what is buffered at once
+  std::vector<char> buffer(SMT2_TOKENIZER_BUFFER_SIZE);
+  std::ifstream in;
+  in.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+  in.open(temp_file_stdout());
   return read_result(in);
 }
 
-decision_proceduret::resultt smt2_dect::read_result(std::istream &in)
+decision_proceduret::resultt smt2_dect::read_result(
+  std::istream &in,
+  optionalt<std::size_t> number_of_responses)
 {
   std::string line;
   decision_proceduret::resultt res=resultt::D_ERROR;
@@ -141,7 +225,10 @@ decision_proceduret::resultt smt2_dect::read_result(std::istream &in)
   typedef std::unordered_map<irep_idt, irept> valuest;
   valuest parsed_values;
 
-  while(in)
+  for(std::size_t responses = 0;
+      in && (!number_of_responses.has_value() ||
+             responses < *number_of_responses);
+      ++responses)
   {
     auto parsed_opt = smt2irep(in, message_handler);
 
@@ -161,19 +248,19 @@ decision_proceduret::resultt smt2_dect::read_result(std::istream &in)
       return decision_proceduret::resultt::D_ERROR;
     }
     else if(
-      parsed.id().empty() && parsed.get_sub().size() == 1 &&
-      parsed.get_sub().front().get_sub().size() == 2)
+      parsed.id().empty() && !parsed.get_sub().empty() &&
+      std::all_of(
+        parsed.get_sub().begin(),
+        parsed.get_sub().end(),
+        [](const irept &pair) { return pair.get_sub().size() == 2; }))
     {
-      const irept &s0=parsed.get_sub().front().get_sub()[0];
-      const irept &s1=parsed.get_sub().front().get_sub()[1];
-
       // Examples:
       // ( (B0 true) )
       // ( (|__CPROVER_pipe_count#1| (_ bv0 32)) )
-      // ( (|some_integer| 0) )
-      // ( (|some_integer| (- 10)) )
+      // ( (|some_integer| 0) (|other_integer| (- 10)) )
 
-      parsed_values[s0.id()] = s1;
+      for(const irept &pair : parsed.get_sub())
+        parsed_values[pair.get_sub()[0].id()] = pair.get_sub()[1];
     }
     else if(
       parsed.id().empty() && parsed.get_sub().size() == 2 &&
@@ -10,21 +10,72 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_SOLVERS_SMT2_SMT2_DEC_H
 #define CPROVER_SOLVERS_SMT2_SMT2_DEC_H
 
+#include <util/optional.h>
+#include <util/tempfile.h>
+
 #include "smt2_conv.h"
 
+#include <chrono>
 #include <fstream>
 
 class message_handlert;
 
-class smt2_stringstreamt
+/// A stream buffer that writes to a file in large chunks, and counts the
+/// bytes written and the time spent writing them. Writing can restart at an
+/// earlier position, which lets \ref smt2_dect replace the footer of the
+/// problem.
+class smt2_file_buffert : public std::streambuf
+{
+public:
+  smt2_file_buffert();
+
+  void open(const std::string &filename);
+
+  /// \return the position in the file of the next character written
+  std::size_t position() const
+  {
+    return file_position + (pptr() - pbase());
+  }
+
+  /// Write the next characters from \p _position on, which must not be
+  /// after \ref position
+  void rewind(std::size_t _position);
+
+  std::size_t bytes_written = 0;
+  std::chrono::duration<double> write_time{0};
+
+protected:
+  std::ofstream file;
+  std::vector<char> buffer;
+
+  /// The position in the file of the first character in the buffer
+  std::size_t file_position = 0;
+
+  int_type overflow(int_type c) override;
+  int sync() override;
+};
+
+/// The temporary file that \ref smt2_dect writes the problem to while
+/// converting it, so that the problem is not kept in memory
+class smt2_problem_filet
 {
 protected:
-  std::stringstream stringstream;
+  /// \param open: whether to create the file, otherwise the problem is
+  ///   written elsewhere
+  explicit smt2_problem_filet(bool open);
+
+  optionalt<temporary_filet> problem_file;
+  smt2_file_buffert problem_buffer;
+  std::ostream problem_out;
+
+  /// The end of the problem written so far, which may be after the footer
+  /// of the last call to the solver
+  std::size_t problem_end = 0;
 };
 
 /*! \brief Decision procedure interface for various SMT 2.x solvers
 */
-class smt2_dect : protected smt2_stringstreamt, public smt2_convt
+class smt2_dect : protected smt2_problem_filet, public smt2_convt
 {
 public:
   smt2_dect(
@@ -34,7 +85,8 @@ public:
     const std::string &_logic,
     solvert _solver,
     message_handlert &_message_handler)
-    : smt2_convt(_ns, _benchmark, _notes, _logic, _solver, stringstream),
+    : smt2_problem_filet(true),
+      smt2_convt(_ns, _benchmark, _notes, _logic, _solver, problem_out),
       message_handler(_message_handler)
   {
   }
@@ -43,13 +95,29 @@ public:
   std::string decision_procedure_text() const override;
 
 protected:
-  message_handlert &message_handler;
+  /// Write the problem to \p _out instead of a file, for a derived class
+  /// that overrides \ref dec_solve
+  smt2_dect(
+    const namespacet &_ns,
+    const std::string &_benchmark,
+    const std::string &_notes,
+    const std::string &_logic,
+    solvert _solver,
+    message_handlert &_message_handler,
+    std::ostream &_out)
+    : smt2_problem_filet(false),
+      smt2_convt(_ns, _benchmark, _notes, _logic, _solver, _out),
+      message_handler(_message_handler)
+  {
+  }
 
-  /// Everything except the footer is cached, so that output files can be
-  /// rewritten with varying footers.
-  std::stringstream cached_output;
+  message_handlert &message_handler;
 
-  resultt read_result(std::istream &in);
+  /// Read the responses of the solver from \p in, up to the end of the
+  /// stream or, if given, \p number_of_responses of them
+  resultt read_result(
+    std::istream &in,
+    optionalt<std::size_t> number_of_responses = {});
 };
 
 #endif // CPROVER_SOLVERS_SMT2_SMT2_DEC_H
@@ -8,6 +8,84 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "smt2_tokenizer.h"
 
+#include <util/magic.h>
+
+#include <algorithm>
+#include <cstring>
+
+smt2_tokenizert::~smt2_tokenizert()
+{
+  // return what was read but not consumed
+  while(input_end != input_next &&
+        in->rdbuf()->sputbackc(*(input_end - 1)) !=
+          std::char_traits<char>::eof())
+  {
+    --input_end;
+  }
+}
+
+bool smt2_tokenizert::read_input()
+{
+  if(!*in)
+    return false;
+
+  std::streambuf &streambuf = *in->rdbuf();
+
+  // this waits for input only if none is available
+  if(streambuf.sgetc() == std::char_traits<char>::eof())
+  {
+    in->setstate(std::ios_base::eofbit | std::ios_base::failbit);
+    return false;
+  }
+
+  // Now the available characters are in the get area of the stream buffer,
+  // which is what keeps them there to be put back on destruction.
+  if(input.empty())
+    input.resize(SMT2_TOKENIZER_BUFFER_SIZE);
+  const std::streamsize available = std::min<std::streamsize>(
+    std::max<std::streamsize>(streambuf.in_avail(), 1), input.size());
+
+  input_next = input.data();
+  input_end = input_next + streambuf.sgetn(input.data(), available);
+  return input_next != input_end;
+}
+
+void smt2_tokenizert::append_while(bool (*predicate)(char))
+{
+  while(input_next != input_end || read_input())
+  {
+    const char *first = input_next;
+    while(input_next != input_end && predicate(*input_next))
+      ++input_next;
+    buffer.append(first, input_next);
+
+    if(input_next != input_end)
+      return;
+  }
+}
+
+bool smt2_tokenizert::append_until(char delimiter)
+{
+  while(input_next != input_end || read_input())
+  {
+    const char *first = input_next;
+    const char *found = static_cast<const char *>(
+      std::memchr(first, delimiter, input_end - first));
+
+    if(found != nullptr)
+    {
+      buffer.append(first, found);
+      input_next = found + 1;
+      return true;
+    }
+
+    buffer.append(first, input_end);
+    input_next = input_end;
+  }
+
+  return false;
+}
+
 bool smt2_tokenizert::is_simple_symbol_character(char ch)
 {
   // any non-empty sequence of letters, digits and the characters
@@ -28,21 +106,7 @@ smt2_tokenizert::tokent smt2_tokenizert::get_simple_symbol()
   // that does not start with a digit and is not a reserved word.
 
   buffer.clear();
-
-  char ch;
-  while(in->get(ch))
-  {
-    if(is_simple_symbol_character(ch))
-    {
-      buffer+=ch;
-    }
-    else
-    {
-      in->unget(); // put back
-      quoted_symbol = false;
-      return SYMBOL;
-    }
-  }
+  append_while(is_simple_symbol_character);
 
   // eof -- this is ok here
   if(buffer.empty())
@@ -59,20 +123,7 @@ smt2_tokenizert::tokent smt2_tokenizert::get_decimal_numeral()
   // we accept any sequence of digits and dots
 
   buffer.clear();
-
-  char ch;
-  while(in->get(ch))
-  {
-    if(isdigit(ch) || ch=='.')
-    {
-      buffer+=ch;
-    }
-    else
-    {
-      in->unget(); // put back
-      return NUMERAL;
-    }
-  }
+  append_while([](char ch) { return isdigit(ch) || ch == '.'; });
 
   // eof -- this is ok here
   if(buffer.empty())
@@ -88,26 +139,9 @@ smt2_tokenizert::tokent smt2_tokenizert::get_bin_numeral()
   buffer.clear();
   buffer+='#';
   buffer+='b';
+  append_while([](char ch) { return ch == '0' || ch == '1'; });
 
-  char ch;
-  while(in->get(ch))
-  {
-    if(ch=='0' || ch=='1')
-    {
-      buffer+=ch;
-    }
-    else
-    {
-      in->unget(); // put back
-      return NUMERAL;
-    }
-  }
-
-  // eof -- this is ok here
-  if(buffer.empty())
-    return END_OF_FILE;
-  else
-    return NUMERAL;
+  return NUMERAL;
 }
 
 smt2_tokenizert::tokent smt2_tokenizert::get_hex_numeral()
@@ -117,26 +151,9 @@ smt2_tokenizert::tokent smt2_tokenizert::get_hex_numeral()
   buffer.clear();
   buffer+='#';
   buffer+='x';
+  append_while([](char ch) { return isxdigit(ch) != 0; });
 
-  char ch;
-  while(in->get(ch))
-  {
-    if(isxdigit(ch))
-    {
-      buffer+=ch;
-    }
-    else
-    {
-      in->unget(); // put back
-      return NUMERAL;
-    }
-  }
-
-  // eof -- this is ok here
-  if(buffer.empty())
-    return END_OF_FILE;
-  else
-    return NUMERAL;
+  return NUMERAL;
 }
 
 smt2_tokenizert::tokent smt2_tokenizert::get_quoted_symbol()
@@ -147,20 +164,13 @@ smt2_tokenizert::tokent smt2_tokenizert::get_quoted_symbol()
   // contain |
 
   buffer.clear();
+  const bool closed = append_until('|');
+  line_no += std::count(buffer.begin(), buffer.end(), '\n');
 
-  char ch;
-  while(in->get(ch))
+  if(closed)
   {
-    if(ch=='|')
-    {
-      quoted_symbol = true;
-      return SYMBOL; // done
-    }
-
-    buffer+=ch;
-
-    if(ch=='\n')
-      line_no++;
+    quoted_symbol = true;
+    return SYMBOL; // done
   }
 
   // Hmpf. Eof before end of quoted symbol. This is an error.
@@ -171,27 +181,21 @@ smt2_tokenizert::tokent smt2_tokenizert::get_string_literal()
 {
   buffer.clear();
 
-  char ch;
-  while(in->get(ch))
+  while(append_until('"'))
   {
-    if(ch=='"')
+    // quotes may be escaped by repeating
+    char ch;
+    if(get(ch))
     {
-      // quotes may be escaped by repeating
-      if(in->get(ch))
+      if(ch != '"')
       {
-        if(ch=='"')
-        {
-        }
-        else
-        {
-          in->unget();
-          return STRING_LITERAL; // done
-        }
-      }
-      else
+        unget();
         return STRING_LITERAL; // done
+      }
+      buffer += ch;
     }
-    buffer+=ch;
+    else
+      return STRING_LITERAL; // done
   }
 
   // Hmpf. Eof before end of string literal. This is an error.
@@ -212,7 +216,7 @@ void smt2_tokenizert::get_token_from_stream()
 {
   char ch;
 
-  while(in->get(ch))
+  while(get(ch))
   {
     switch(ch)
     {
@@ -229,13 +233,17 @@ void smt2_tokenizert::get_token_from_stream()
 
     case ';': // comment
       // skip until newline
-      while(in->get(ch))
+      while(input_next != input_end || read_input())
       {
-        if(ch=='\n')
+        const char *newline = static_cast<const char *>(
+          std::memchr(input_next, '\n', input_end - input_next));
+        if(newline != nullptr)
         {
+          input_next = newline + 1;
           line_no++;
           break;
         }
+        input_next = input_end;
       }
       break;
 
@@ -268,7 +276,7 @@ void smt2_tokenizert::get_token_from_stream()
         throw error("expecting symbol after colon");
 
     case '#':
-      if(in->get(ch))
+      if(get(ch))
       {
         if(ch=='b')
         {
@@ -290,13 +298,13 @@ void smt2_tokenizert::get_token_from_stream()
     default: // likely a simple symbol or a numeral
       if(isdigit(ch))
       {
-        in->unget();
+        unget();
         token = get_decimal_numeral();
         return;
       }
       else if(is_simple_symbol_character(ch))
       {
-        in->unget();
+        unget();
         token = get_simple_symbol();
         return;
       }
@@ -13,7 +13,13 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <sstream>
 #include <string>
+#include <vector>
 
+/// Splits SMT-LIB2 input into tokens. The input is read from the stream
+/// buffer in chunks of what is available, which are scanned in memory. The
+/// characters read but not consumed are returned to the stream on
+/// destruction, hence tokenizers can read one after the other from the same
+/// stream, and reading does not wait for input beyond the current token.
 class smt2_tokenizert
 {
 public:
@@ -23,6 +29,11 @@ public:
     line_no=1;
   }
 
+  smt2_tokenizert(const smt2_tokenizert &) = delete;
+  smt2_tokenizert &operator=(const smt2_tokenizert &) = delete;
+
+  ~smt2_tokenizert();
+
   class smt2_errort : public cprover_exception_baset
   {
   public:
@@ -111,6 +122,12 @@ protected:
   bool peeked;
   tokent token;
 
+  /// The chunk of input read from \ref in, of which the characters from
+  /// \ref input_next on are not yet consumed
+  std::vector<char> input;
+  const char *input_next = nullptr;
+  const char *input_end = nullptr;
+
   /// skip any tokens until all parentheses are closed
   /// or the end of file is reached
   void skip_to_end_of_list();
@@ -124,6 +141,33 @@ private:
   tokent get_string_literal();
   static bool is_simple_symbol_character(char);
 
+  /// Read the next chunk of input once all of the previous one is consumed
+  /// \return false at the end of the input
+  bool read_input();
+
+  bool get(char &ch)
+  {
+    if(input_next == input_end && !read_input())
+      return false;
+    ch = *input_next++;
+    return true;
+  }
+
+  /// put back the last character got
+  void unget()
+  {
+    --input_next;
+  }
+
+  /// Append the characters up to the first one not satisfying \p predicate
+  /// to the buffer
+  void append_while(bool (*predicate)(char));
+
+  /// Append the characters up to the first \p delimiter to the buffer, and
+  /// consume the delimiter
+  /// \return false if the input ends before a delimiter
+  bool append_until(char delimiter);
+
   /// read a token from the input stream and store it in 'token'
   void get_token_from_stream();
 };
@@ -137,4 +181,4 @@ operator<<(smt2_tokenizert::smt2_errort &&e, const T &message)
   return std::move(e);
 }
 
-#endif // CPROVER_SOLVERS_SMT2_SMT2_PARSER_H
+#endif // CPROVER_SOLVERS_SMT2_SMT2_TOKENIZER_H
@@ -2,28 +2,55 @@
 
 #include "smt2_incremental_decision_procedure.h"
 
-#include <util/expr.h>
+#include <util/get_base_name.h>
+#include <util/message.h>
+#include <util/string_utils.h>
 
-smt2_incremental_decision_proceduret::smt2_incremental_decision_proceduret(
-  std::string solver_command)
-  : solver_command{std::move(solver_command)}, number_of_solver_calls{0}
+/// \return the solver that \p solver_command invokes as far as known, which
+///   determines the features of SMT-LIB that are used
+static smt2_convt::solvert solver_of_command(const std::string &solver_command)
 {
+  const std::vector<std::string> argv =
+    split_string(solver_command, ' ', false, true);
+  if(argv.empty())
+    return smt2_convt::solvert::GENERIC;
+
+  const std::string executable = get_base_name(argv.front(), true);
+  if(executable == "z3")
+    return smt2_convt::solvert::Z3;
+  else if(executable == "cvc4")
+    return smt2_convt::solvert::CVC4;
+  else
+    return smt2_convt::solvert::GENERIC;
 }
 
-exprt smt2_incremental_decision_proceduret::handle(const exprt &expr)
+smt2_solver_processt::smt2_solver_processt(const std::string &solver_command)
+  : solver_process{split_string(solver_command, ' ', false, true)}
 {
-  return expr;
 }
 
-exprt smt2_incremental_decision_proceduret::get(const exprt &expr) const
+smt2_incremental_decision_proceduret::smt2_incremental_decision_proceduret(
+  const namespacet &_ns,
+  std::string _solver_command,
+  message_handlert &_message_handler)
+  : smt2_solver_processt(_solver_command),
+    smt2_dect(
+      _ns,
+      "cbmc",
+      "Generated by CBMC",
+      "QF_AUFBV",
+      solver_of_command(_solver_command),
+      _message_handler,
+      solver_process.input()),
+    solver_command{std::move(_solver_command)}
 {
-  UNIMPLEMENTED_FEATURE("`get` of:\n  " + expr.pretty(2, 0));
+  // assumptions must not be asserted, as they would persist
+  use_check_sat_assuming = true;
 }
 
-void smt2_incremental_decision_proceduret::print_assignment(
-  std::ostream &out) const
+smt2_incremental_decision_proceduret::~smt2_incremental_decision_proceduret()
 {
-  UNIMPLEMENTED_FEATURE("printing of assignments.");
+  solver_process.input() << "(exit)\n" << std::flush;
 }
 
 std::string
@@ -32,42 +59,43 @@ smt2_incremental_decision_proceduret::decision_procedure_text() const
   return "incremental SMT2 solving via \"" + solver_command + "\"";
 }
 
-std::size_t
-smt2_incremental_decision_proceduret::get_number_of_solver_calls() const
+decision_proceduret::resultt smt2_incremental_decision_proceduret::dec_solve()
 {
-  return number_of_solver_calls;
-}
+  ++number_of_solver_calls;
 
-void smt2_incremental_decision_proceduret::set_to(const exprt &expr, bool value)
-{
-  UNIMPLEMENTED_FEATURE(
-    "`set_to` (" + std::string{value ? "true" : "false"} + "):\n  " +
-    expr.pretty(2, 0));
-}
+  // The object sizes depend on the objects, hence are defined anew once there
+  // are more of either.
+  if(
+    object_sizes.size() != number_of_object_sizes ||
+    pointer_logic.objects.size() != number_of_objects)
+  {
+    for(const auto &object : object_sizes)
+      define_object_size(object.second, object.first);
 
-void smt2_incremental_decision_proceduret::push(
-  const std::vector<exprt> &assumptions)
-{
-  for(const auto &assumption : assumptions)
+    number_of_object_sizes = object_sizes.size();
+    number_of_objects = pointer_logic.objects.size();
+  }
+
+  write_check_sat();
+
+  messaget log{message_handler};
+
+  if(!solver_process.is_running())
   {
-    UNIMPLEMENTED_FEATURE(
-      "pushing of assumption:\n  " + assumption.pretty(2, 0));
+    log.error() << "error running SMT2 solver" << messaget::eom;
+    return resultt::D_ERROR;
   }
-  UNIMPLEMENTED_FEATURE("`push` of empty assumptions.");
-}
 
-void smt2_incremental_decision_proceduret::push()
-{
-  UNIMPLEMENTED_FEATURE("`push`.");
-}
+  solver_process.input().flush();
 
-void smt2_incremental_decision_proceduret::pop()
-{
-  UNIMPLEMENTED_FEATURE("`pop`.");
-}
+  if(!solver_process.input())
+  {
+    log.error() << "error writing to SMT2 solver" << messaget::eom;
+    return resultt::D_ERROR;
+  }
 
-decision_proceduret::resultt smt2_incremental_decision_proceduret::dec_solve()
-{
-  ++number_of_solver_calls;
-  UNIMPLEMENTED_FEATURE("solving.");
+  // one response to the check-sat and one to each get-value
+  const std::size_t number_of_responses = 1 + number_of_get_values();
+
+  return read_result(solver_process.output(), number_of_responses);
 }
@@ -6,36 +6,55 @@
 #ifndef CPROVER_SOLVERS_SMT2_INCREMENTAL_SMT2_INCREMENTAL_DECISION_PROCEDURE_H
 #define CPROVER_SOLVERS_SMT2_INCREMENTAL_SMT2_INCREMENTAL_DECISION_PROCEDURE_H
 
-#include <solvers/stack_decision_procedure.h>
+#include <util/piped_process.h>
 
+#include <solvers/smt2/smt2_dec.h>
+
+/// The solver process, which is a base class of
+/// \ref smt2_incremental_decision_proceduret so that it is started before the
+/// problem is written to it
+struct smt2_solver_processt
+{
+  explicit smt2_solver_processt(const std::string &solver_command);
+
+  piped_processt solver_process;
+};
+
+/// Passes the problem to a single SMT2 solver process, which is started once
+/// and then reads commands from a pipe. Each call to the solver sends the
+/// commands converted since the previous one, which are written to the pipe
+/// as they are converted, followed by a `check-sat-assuming` with the
+/// assumptions of the contexts pushed, and reads the responses from a pipe.
+/// The solver thus neither is restarted nor has to parse the problem anew.
 class smt2_incremental_decision_proceduret final
-  : public stack_decision_proceduret
+  : protected smt2_solver_processt,
+    public smt2_dect
 {
 public:
+  /// \param _ns: The namespace for the conversion of expressions.
   /// \param solver_command: The command and arguments for invoking the smt2
-  ///                        solver.
-  explicit smt2_incremental_decision_proceduret(std::string solver_command);
+  ///                        solver, which must read commands from its
+  ///                        standard input.
+  /// \param _message_handler: Errors of the solver are reported to this.
+  smt2_incremental_decision_proceduret(
+    const namespacet &_ns,
+    std::string solver_command,
+    message_handlert &_message_handler);
 
-  // Implementation of public decision_proceduret member functions.
-  exprt handle(const exprt &expr) override;
-  exprt get(const exprt &expr) const override;
-  void print_assignment(std::ostream &out) const override;
-  std::string decision_procedure_text() const override;
-  std::size_t get_number_of_solver_calls() const override;
-  void set_to(const exprt &expr, bool value) override;
+  ~smt2_incremental_decision_proceduret() override;
 
-  // Implementation of public stack_decision_proceduret member functions.
-  void push(const std::vector<exprt> &assumptions) override;
-  void push() override;
-  void pop() override;
+  std::string decision_procedure_text() const override;
 
 protected:
-  // Implementation of protected decision_proceduret member function.
   resultt dec_solve() override;
 
   /// This is where we store the solver command for reporting the solver used.
   std::string solver_command;
-  size_t number_of_solver_calls;
+
+  /// The number of objects and object sizes when the object sizes were last
+  /// defined
+  std::size_t number_of_objects = 0;
+  std::size_t number_of_object_sizes = 0;
 };
 
 #endif // CPROVER_SOLVERS_SMT2_INCREMENTAL_SMT2_INCREMENTAL_DECISION_PROCEDURE_H
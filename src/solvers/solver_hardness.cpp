@@ -47,6 +47,12 @@ void solver_hardnesst::register_ssa(
 {
   PRECONDITION(ssa_index < hardness_stats.size());
 
+  if(is_aggregated())
+  {
+    aggregate(pc, 1);
+    return;
+  }
+
   current_ssa_key.ssa_expression = expr2string(ssa_expression);
   current_ssa_key.pc = pc;
   auto pre_existing =
@@ -74,6 +80,14 @@ void solver_hardnesst::register_assertion_ssas(
   const exprt ssa_expression,
   const std::vector<goto_programt::const_targett> &pcs)
 {
+  if(is_aggregated())
+  {
+    // the disjunction is charged to the first assertion
+    if(!pcs.empty())
+      aggregate(pcs.front(), pcs.size());
+    return;
+  }
+
   if(assertion_stats.empty())
     return;
 
@@ -93,6 +107,9 @@ void solver_hardnesst::register_clause(
   current_hardness.clauses++;
   current_hardness.literals += bv.size();
 
+  if(is_aggregated())
+    return;
+
   for(const auto &literal : bv)
   {
     current_hardness.variables.insert(literal.var_no());
@@ -115,10 +132,84 @@ void solver_hardnesst::set_outfile(const std::string &file_name)
   outfile = file_name;
 }
 
+void solver_hardnesst::set_aggregation(aggregationt _aggregation)
+{
+  aggregation = _aggregation;
+}
+
+void solver_hardnesst::aggregate(
+  goto_programt::const_targett pc,
+  std::size_t ssa_steps)
+{
+  const source_locationt &source_location = pc->source_location;
+
+  auto entry = aggregated_stats.emplace(
+    aggregation_key(source_location, aggregation), aggregated_hardnesst{});
+  aggregated_hardnesst &stats = entry.first->second;
+  if(entry.second)
+  {
+    if(aggregation == aggregationt::SOURCE_LINE)
+    {
+      stats.source_location.set_file(source_location.get_file());
+      stats.source_location.set_line(source_location.get_line());
+    }
+    stats.source_location.set_function(source_location.get_function());
+  }
+
+  stats.ssa_steps += ssa_steps;
+  stats.clauses += current_hardness.clauses;
+  stats.literals += current_hardness.literals;
+  current_hardness = {};
+}
+
+std::string solver_hardnesst::aggregation_key(
+  const source_locationt &source_location,
+  aggregationt aggregation)
+{
+  if(aggregation == aggregationt::SOURCE_LINE)
+  {
+    return id2string(source_location.get_file()) + ':' +
+           id2string(source_location.get_line()) + ':' +
+           id2string(source_location.get_function());
+  }
+  else
+    return id2string(source_location.get_function());
+}
+
+void solver_hardnesst::produce_aggregated_report(std::ostream &out) const
+{
+  json_stream_arrayt json_stream_array{out};
+
+  for(const auto &entry : aggregated_stats)
+  {
+    const aggregated_hardnesst &stats = entry.second;
+
+    auto stats_json = json_objectt{};
+    stats_json["Source"] = json(stats.source_location);
+
+    auto sat_hardness_json = json_objectt{};
+    sat_hardness_json["SSA_steps"] =
+      json_numbert{std::to_string(stats.ssa_steps)};
+    sat_hardness_json["Clauses"] = json_numbert{std::to_string(stats.clauses)};
+    sat_hardness_json["Literals"] =
+      json_numbert{std::to_string(stats.literals)};
+    stats_json["SAT_hardness"] = sat_hardness_json;
+
+    json_stream_array.push_back(stats_json);
+  }
+}
+
 void solver_hardnesst::produce_report()
 {
   PRECONDITION(!outfile.empty());
 
+  if(is_aggregated())
+  {
+    std::ofstream out{outfile};
+    produce_aggregated_report(out);
+    return;
+  }
+
   // The SSA steps and indexed internally (by the position in the SSA equation)
   // but if the `--paths` option is used, there are multiple equations, some
   // sharing SSA steps. We only store the unique ones in a set but now we want
@@ -12,6 +12,7 @@ Author: Diffblue Ltd.
 #include <solvers/prop/literal.h>
 
 #include <fstream>
+#include <map>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -76,6 +77,26 @@ struct solver_hardnesst
     bool empty() const;
   };
 
+  /// What the statistics are collected for: each SSA step, with the
+  /// variables and the clauses of its queries, or just the number of SSA
+  /// steps, clauses and literals for each source line or each function. The
+  /// latter is cheap enough to leave on in production runs.
+  enum class aggregationt
+  {
+    SSA_STEP,
+    SOURCE_LINE,
+    FUNCTION
+  };
+
+  // The counters collected for a source line or a function
+  struct aggregated_hardnesst
+  {
+    source_locationt source_location;
+    std::size_t ssa_steps = 0;
+    std::size_t clauses = 0;
+    std::size_t literals = 0;
+  };
+
   /// Called from the `symtex_target_equationt::convert_*`, this function
   ///   associates an SSA step to all the solver queries collected since the
   ///   last call.
@@ -115,6 +136,28 @@ struct solver_hardnesst
 
   void set_outfile(const std::string &file_name);
 
+  void set_aggregation(aggregationt);
+
+  /// \return true if only counters are collected, which means that the
+  ///   clauses need not be processed for their indices in the dimacs output
+  bool is_aggregated() const
+  {
+    return aggregation != aggregationt::SSA_STEP;
+  }
+
+  /// \return the key of the entry for \p source_location in
+  ///   \ref get_aggregated_stats under \p aggregation
+  static std::string
+  aggregation_key(const source_locationt &source_location, aggregationt);
+
+  /// The counters collected for each source line or function, by
+  /// \ref aggregation_key
+  const std::map<std::string, aggregated_hardnesst> &
+  get_aggregated_stats() const
+  {
+    return aggregated_stats;
+  }
+
   /// Print the statistics to a JSON file (specified via command-line option).
   void produce_report();
 
@@ -141,6 +184,15 @@ private:
   sat_hardnesst current_hardness;
   assertion_statst assertion_stats;
   std::size_t max_ssa_set_size;
+
+  aggregationt aggregation = aggregationt::SSA_STEP;
+  std::map<std::string, aggregated_hardnesst> aggregated_stats;
+
+  /// Add \ref current_hardness to the entry of \p pc in
+  /// \ref aggregated_stats, counting \p ssa_steps steps
+  void aggregate(goto_programt::const_targett pc, std::size_t ssa_steps);
+
+  void produce_aggregated_report(std::ostream &) const;
 };
 
 // NOLINTNEXTLINE(readability/namespace)
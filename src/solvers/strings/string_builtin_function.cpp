@@ -6,6 +6,8 @@
 #include <algorithm>
 #include <iterator>
 
+#include <util/unicode.h>
+
 #include "string_constraint_generator.h"
 
 string_transformation_builtin_functiont::
@@ -370,6 +372,59 @@ string_creation_builtin_functiont::string_creation_builtin_functiont(
   arg = fun_args[2];
 }
 
+optionalt<exprt> string_literal_builtin_functiont::eval(
+  const std::function<exprt(const exprt &)> &get_value) const
+{
+  const auto constant = expr_try_dynamic_cast<constant_exprt>(arg);
+  if(!constant)
+    return {};
+
+  const std::wstring str = widen(id2string(constant->get_value()));
+  std::vector<mp_integer> characters(str.begin(), str.end());
+  const auto length = from_integer(characters.size(), result.length_type());
+  const array_typet type(result.type().subtype(), length);
+  return make_string(characters, type);
+}
+
+string_constraintst string_literal_builtin_functiont::constraints(
+  string_constraint_generatort &generator) const
+{
+  auto pair =
+    generator.add_axioms_for_cprover_string(result, arg, true_exprt());
+  pair.second.existential.push_back(equal_exprt(pair.first, return_code));
+  return pair.second;
+}
+
+/// \return the length of the literal \p arg, if it is made of string
+///   constants
+static optionalt<exprt> literal_length(const exprt &arg, const typet &type)
+{
+  if(const auto if_expr = expr_try_dynamic_cast<if_exprt>(arg))
+  {
+    const auto true_length = literal_length(if_expr->true_case(), type);
+    const auto false_length = literal_length(if_expr->false_case(), type);
+    if(!true_length || !false_length)
+      return {};
+    return if_exprt(if_expr->cond(), *true_length, *false_length);
+  }
+  else if(const auto constant = expr_try_dynamic_cast<constant_exprt>(arg))
+    return from_integer(widen(id2string(constant->get_value())).size(), type);
+  else
+    return {};
+}
+
+exprt string_literal_builtin_functiont::length_constraint() const
+{
+  // as add_axioms_for_cprover_string, which fails on anything else
+  const auto length = literal_length(arg, result.length_type());
+  if(!length)
+    return equal_exprt(return_code, from_integer(1, return_code.type()));
+
+  return and_exprt(
+    equal_exprt(array_pool.get_or_create_length(result), *length),
+    equal_exprt(return_code, from_integer(0, return_code.type())));
+}
+
 optionalt<exprt> string_of_int_builtin_functiont::eval(
   const std::function<exprt(const exprt &)> &get_value) const
 {
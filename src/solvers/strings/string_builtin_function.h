@@ -388,6 +388,42 @@ private:
   exprt radix;
 };
 
+/// String literal, given by a string constant or an if expression over string
+/// constants
+class string_literal_builtin_functiont
+  : public string_creation_builtin_functiont
+{
+public:
+  string_literal_builtin_functiont(
+    const exprt &return_code,
+    const std::vector<exprt> &fun_args,
+    array_poolt &array_pool)
+    : string_creation_builtin_functiont(return_code, fun_args, array_pool)
+  {
+    PRECONDITION(fun_args.size() == 3);
+  }
+
+  optionalt<exprt>
+  eval(const std::function<exprt(const exprt &)> &get_value) const override;
+
+  std::string name() const override
+  {
+    return "string_literal";
+  }
+
+  string_constraintst
+  constraints(string_constraint_generatort &generator) const override;
+
+  exprt length_constraint() const override;
+
+  /// Unlike for other string creations, the constraints are always added, as
+  /// the program may access the content of the literal directly
+  bool maybe_testing_function() const override
+  {
+    return true;
+  }
+};
+
 /// String test
 class string_test_builtin_functiont : public string_builtin_functiont
 {
@@ -11,6 +11,7 @@ Author: Jesse Sigal, jesse.sigal@diffblue.com
 
 #include "string_constraint_instantiation.h"
 #include <algorithm>
+#include <list>
 #include <unordered_set>
 
 #include <util/arith_tools.h>
@@ -170,13 +171,27 @@ std::string linear_functiont::format()
   return stream.str();
 }
 
+std::unordered_set<exprt, irep_hash>
+find_indexes(const string_constraintt &axiom, const exprt &str)
+{
+  return find_indexes(axiom.body, str, axiom.univ_var);
+}
+
 exprt instantiate(
   const string_constraintt &axiom,
   const exprt &str,
   const exprt &val)
+{
+  return instantiate(axiom, find_indexes(axiom, str), val);
+}
+
+exprt instantiate(
+  const string_constraintt &axiom,
+  const std::unordered_set<exprt, irep_hash> &indexes,
+  const exprt &val)
 {
   exprt::operandst conjuncts;
-  for(const auto &index : find_indexes(axiom.body, str, axiom.univ_var))
+  for(const auto &index : indexes)
   {
     const exprt univ_var_value =
       linear_functiont::solve(linear_functiont{index}, axiom.univ_var, val);
@@ -13,6 +13,7 @@ Author: Jesse Sigal, jesse.sigal@diffblue.com
 #define CPROVER_SOLVERS_REFINEMENT_STRING_CONSTRAINT_INSTANTIATION_H
 
 #include <set>
+#include <unordered_set>
 
 #include <util/std_expr.h>
 
@@ -39,6 +40,27 @@ exprt instantiate(
   const exprt &str,
   const exprt &val);
 
+/// Find the indexes of \p str in the body of \p axiom that contain its
+/// universally quantified variable, which are the indexes
+/// \ref instantiate substitutes the variable in. As these only depend on the
+/// axiom and the string, they can be reused for each value instantiated.
+/// \param axiom: a universally quantified formula
+/// \param str: an array of characters
+/// \return index expressions on \p str containing the quantified variable
+std::unordered_set<exprt, irep_hash>
+find_indexes(const string_constraintt &axiom, const exprt &str);
+
+/// Instantiates \p axiom like \ref instantiate, for the \p indexes of a
+/// string found by \ref find_indexes
+/// \param axiom: a universally quantified formula
+/// \param indexes: the indexes of a string in \p axiom
+/// \param val: an index expression
+/// \return `axiom` with substitued `qvar`, or true if \p indexes is empty
+exprt instantiate(
+  const string_constraintt &axiom,
+  const std::unordered_set<exprt, irep_hash> &indexes,
+  const exprt &val);
+
 std::vector<exprt> instantiate_not_contains(
   const string_not_contains_constraintt &axiom,
   const std::set<std::pair<exprt, exprt>> &index_pairs,
@@ -65,6 +65,10 @@ static std::unique_ptr<string_builtin_functiont> to_string_builtin_function(
     return util_make_unique<string_to_upper_case_builtin_functiont>(
       return_code, fun_app.arguments(), array_pool);
 
+  if(id == ID_cprover_string_literal_func)
+    return util_make_unique<string_literal_builtin_functiont>(
+      return_code, fun_app.arguments(), array_pool);
+
   return util_make_unique<string_builtin_function_with_no_evalt>(
     return_code, fun_app, array_pool);
 }
@@ -345,6 +349,34 @@ void string_dependenciest::output_dot(std::ostream &stream) const
   stream << '}' << std::endl;
 }
 
+/// Evaluate \p builtin if it creates a string from constants and the contents
+/// of strings in \p constant_contents only
+/// \return the content of the resulting string
+static optionalt<array_exprt> eval_constant(
+  const string_builtin_functiont &builtin,
+  const std::unordered_map<exprt, exprt, irep_hash> &constant_contents)
+{
+  const auto string_result = builtin.string_result();
+  if(!string_result || string_result->id() == ID_if)
+    return {};
+
+  bool is_constant = true;
+  const auto get_value = [&](const exprt &expr) -> exprt {
+    if(expr.is_constant())
+      return expr;
+    const auto entry = constant_contents.find(expr);
+    if(entry != constant_contents.end())
+      return entry->second;
+    is_constant = false;
+    return exprt(ID_unknown, expr.type());
+  };
+
+  const auto value = builtin.eval(get_value);
+  if(!is_constant || !value || value->id() != ID_array)
+    return {};
+  return to_array_expr(*value);
+}
+
 string_constraintst
 string_dependenciest::add_constraints(string_constraint_generatort &generator)
 {
@@ -363,10 +395,30 @@ string_dependenciest::add_constraints(string_constraint_generatort &generator)
       for_each_successor(n, f);
     });
 
+  // contents of the strings found to be constant so far, builtin functions
+  // being in the order of the equations they come from
+  std::unordered_map<exprt, exprt, irep_hash> constant_contents;
+
   string_constraintst constraints;
   for(const auto &node : builtin_function_nodes)
   {
-    if(test_dependencies.count(nodet(node)))
+    const auto value = eval_constant(*node.data, constant_contents);
+    if(value)
+      constant_contents.emplace(node.data->string_result()->content(), *value);
+
+    if(test_dependencies.count(nodet(node)) && value)
+    {
+      // the value replaces the quantified constraints
+      const array_string_exprt result = *node.data->string_result();
+      const typet &index_type = result.length_type();
+      for(std::size_t i = 0; i < value->operands().size(); ++i)
+      {
+        constraints.existential.push_back(equal_exprt(
+          result[from_integer(i, index_type)], value->operands()[i]));
+      }
+      constraints.existential.push_back(node.data->length_constraint());
+    }
+    else if(test_dependencies.count(nodet(node)))
     {
       const auto &builtin = builtin_function_nodes[node.index];
       merge(constraints, builtin.data->constraints(generator));
@@ -20,6 +20,7 @@ Author: Alberto Griggio, alberto.griggio@gmail.com
 #include "string_refinement.h"
 
 #include <solvers/sat/satcheck.h>
+#include <chrono>
 #include <stack>
 #include <unordered_set>
 
@@ -95,6 +96,11 @@ static void update_index_set(
   const namespacet &ns,
   const std::vector<exprt> &current_constraints);
 
+static void add_indexes_below(
+  index_set_pairt &index_set,
+  const namespacet &ns,
+  std::size_t length);
+
 static void update_index_set(
   index_set_pairt &index_set,
   const namespacet &ns,
@@ -217,19 +223,33 @@ display_index_set(messaget::mstreamt &stream, const index_set_pairt &index_set)
 ///      const index_set_pairt&,
 ///      const std::map<string_not_contains_constraintt, symbol_exprt>&)</tt>
 ///      for details.)
+///
+/// The indexes of each array in the universal axioms are looked up in, and
+/// added to, \p universal_axiom_indexes, so that the axioms are only searched
+/// once for each array rather than for each new index, and axioms that do not
+/// access an array are skipped.
 static std::vector<exprt> generate_instantiations(
   const index_set_pairt &index_set,
   const string_axiomst &axioms,
   const std::unordered_map<string_not_contains_constraintt, symbol_exprt>
-    &not_contain_witnesses)
+    &not_contain_witnesses,
+  universal_axiom_indexest &universal_axiom_indexes)
 {
   std::vector<exprt> lemmas;
   for(const auto &i : index_set.current)
   {
-    for(const auto &univ_axiom : axioms.universal)
+    // axioms are only ever appended
+    auto &indexes = universal_axiom_indexes[i.first];
+    for(std::size_t n = indexes.size(); n < axioms.universal.size(); ++n)
+      indexes.push_back(find_indexes(axioms.universal[n], i.first));
+
+    for(std::size_t n = 0; n < axioms.universal.size(); ++n)
     {
+      if(indexes[n].empty())
+        continue;
+
       for(const auto &j : i.second)
-        lemmas.push_back(instantiate(univ_axiom, i.first, j));
+        lemmas.push_back(instantiate(axioms.universal[n], indexes[n], j));
     }
   }
   for(const auto &nc_axiom : axioms.not_contains)
@@ -777,7 +797,26 @@ decision_proceduret::resultt string_refinementt::dec_solve()
       binary_relation_exprt{length, ID_ge, from_integer(0, length.type())});
   }
 
-  // Initial try without index set
+  const auto instantiate_initial_index_set = [&] {
+    initial_index_set(index_sets, ns, axioms);
+    update_index_set(index_sets, ns, current_constraints);
+    if(config_.eager_instantiation_length != 0)
+      add_indexes_below(index_sets, ns, config_.eager_instantiation_length);
+    current_constraints.clear();
+    const auto initial_instances = generate_instantiations(
+      index_sets, axioms, not_contain_witnesses, universal_axiom_indexes);
+    for(const auto &instance : initial_instances)
+    {
+      add_lemma(
+        substitute_array_access(instance, generator.fresh_symbol, true));
+    }
+  };
+
+  // Short strings are constrained completely from the start, otherwise we
+  // make an initial try without index set
+  if(config_.eager_instantiation_length != 0)
+    instantiate_initial_index_set();
+
   const auto get = [this](const exprt &expr) { return this->get(expr); };
   dependencies.clean_cache();
   const decision_proceduret::resultt initial_result = supert::dec_solve();
@@ -808,20 +847,26 @@ decision_proceduret::resultt string_refinementt::dec_solve()
     return initial_result;
   }
 
-  initial_index_set(index_sets, ns, axioms);
-  update_index_set(index_sets, ns, current_constraints);
-  current_constraints.clear();
-  const auto initial_instances =
-    generate_instantiations(index_sets, axioms, not_contain_witnesses);
-  for(const auto &instance : initial_instances)
-  {
-    add_lemma(substitute_array_access(instance, generator.fresh_symbol, true));
-  }
+  if(config_.eager_instantiation_length == 0)
+    instantiate_initial_index_set();
+
+  using clockt = std::chrono::steady_clock;
+  const auto seconds = [](clockt::time_point start, clockt::time_point stop) {
+    return std::chrono::duration<double>(stop - start).count();
+  };
 
+  std::size_t iteration = 0;
   while((loop_bound_--) > 0)
   {
+    ++iteration;
+    const auto solver_start = clockt::now();
     dependencies.clean_cache();
     const decision_proceduret::resultt refined_result = supert::dec_solve();
+    const auto solver_stop = clockt::now();
+
+    log.statistics() << "String refinement iteration " << iteration
+                     << ": solver " << seconds(solver_start, solver_stop)
+                     << "s" << messaget::eom;
 
     if(refined_result == resultt::D_SATISFIABLE)
     {
@@ -836,6 +881,12 @@ decision_proceduret::resultt string_refinementt::dec_solve()
         config_.use_counter_example,
         symbol_resolve,
         not_contain_witnesses);
+      const auto check_stop = clockt::now();
+      log.statistics() << "String refinement iteration " << iteration
+                       << ": checking axioms "
+                       << seconds(solver_stop, check_stop) << "s"
+                       << messaget::eom;
+
       if(satisfied)
       {
         log.debug() << "check_SAT: the model is correct" << messaget::eom;
@@ -872,11 +923,16 @@ decision_proceduret::resultt string_refinementt::dec_solve()
         }
       }
       current_constraints.clear();
-      const auto instances =
-        generate_instantiations(index_sets, axioms, not_contain_witnesses);
+      const auto instances = generate_instantiations(
+        index_sets, axioms, not_contain_witnesses, universal_axiom_indexes);
       for(const auto &instance : instances)
         add_lemma(
           substitute_array_access(instance, generator.fresh_symbol, true));
+
+      log.statistics() << "String refinement iteration " << iteration
+                       << ": instantiating " << instances.size()
+                       << " lemmas " << seconds(check_stop, clockt::now())
+                       << "s" << messaget::eom;
     }
     else
     {
@@ -1584,6 +1640,36 @@ static void add_to_index_set(
   }
 }
 
+/// Add the indexes from 0 to \p length - 1 to the index set of each array
+/// that is already in \p index_set, so that the universal axioms are
+/// instantiated for all characters of strings of at most \p length
+/// characters at once
+/// \param index_set: set of indexes
+/// \param ns: namespace
+/// \param length: number of indexes to add
+static void add_indexes_below(
+  index_set_pairt &index_set,
+  const namespacet &ns,
+  std::size_t length)
+{
+  // adding indexes may add sub-arrays to the index set
+  std::vector<std::pair<exprt, typet>> arrays;
+  for(const auto &pair : index_set.cumulative)
+  {
+    if(!pair.second.empty())
+      arrays.emplace_back(pair.first, pair.second.begin()->type());
+  }
+
+  for(const auto &array : arrays)
+  {
+    for(std::size_t i = 0; i < length; ++i)
+    {
+      add_to_index_set(
+        index_set, ns, array.first, from_integer(i, array.second));
+    }
+  }
+}
+
 /// Given an array access of the form \a s[i] assumed to be part of a formula
 /// \f$ \forall q < u. charconstraint \f$, initialize the index set of \a s
 /// so that:
@@ -68,6 +68,10 @@ private:
   {
     std::size_t refinement_bound = 0;
     bool use_counter_example = true;
+    /// If not zero, the universal axioms are instantiated for all indexes
+    /// below this length before the first call to the solver, which avoids
+    /// the refinement loop for strings of at most this many characters
+    std::size_t eager_instantiation_length = 0;
   };
 
 public:
@@ -109,6 +113,11 @@ private:
   // Warning: this is indexed by array_expressions and not string expressions
 
   index_set_pairt index_sets;
+
+  /// For each array, the indexes of the array in each axiom of
+  /// `axioms.universal`, which stay the same over the iterations
+  universal_axiom_indexest universal_axiom_indexes;
+
   union_find_replacet symbol_resolve;
 
   std::vector<exprt> equations;
@@ -13,6 +13,9 @@ Author: Diffblue Ltd.
 
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 /// For now, any unsigned bitvector type of width smaller or equal to 16 is
 /// considered a character.
@@ -62,6 +65,14 @@ struct index_set_pairt
   std::map<exprt, std::set<exprt>> current;
 };
 
+/// For each array, the indexes of the array in each of a list of universal
+/// axioms, see \ref find_indexes
+typedef std::unordered_map<
+  exprt,
+  std::vector<std::unordered_set<exprt, irep_hash>>,
+  irep_hash>
+  universal_axiom_indexest;
+
 struct string_axiomst
 {
   std::vector<string_constraintt> universal;
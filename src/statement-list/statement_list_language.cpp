@@ -22,6 +22,8 @@ Author: Matthias Weiss, matthias.weiss@diffblue.com
 #include <util/make_unique.h>
 #include <util/symbol_table.h>
 
+#include <chrono>
+
 void statement_list_languaget::set_language_options(const optionst &options)
 {
   params = object_factory_parameterst{options};
@@ -33,6 +35,14 @@ bool statement_list_languaget::generate_support_functions(
   return statement_list_entry_point(symbol_table, get_message_handler());
 }
 
+/// Function blocks typechecked so far. This is shared by all files of a
+/// project, each of which is handled by a language instance of its own.
+static statement_list_typecheck_cachet &typecheck_cache()
+{
+  static statement_list_typecheck_cachet cache;
+  return cache;
+}
+
 bool statement_list_languaget::typecheck(
   symbol_tablet &symbol_table,
   const std::string &module,
@@ -40,16 +50,38 @@ bool statement_list_languaget::typecheck(
 {
   symbol_tablet new_symbol_table;
 
+  statement_list_typecheck_cachet &cache = typecheck_cache();
+  const std::size_t hits = cache.hits;
+  const std::size_t misses = cache.misses;
+
+  const auto typecheck_start = std::chrono::steady_clock::now();
+
   if(statement_list_typecheck(
-       parse_tree, new_symbol_table, module, get_message_handler()))
+       parse_tree, new_symbol_table, module, get_message_handler(), cache))
     return true;
 
+  const auto typecheck_stop = std::chrono::steady_clock::now();
+  const std::chrono::duration<double> typecheck_runtime =
+    typecheck_stop - typecheck_start;
+  statistics() << "Runtime Typecheck " << module << ": "
+               << typecheck_runtime.count() << "s, "
+               << cache.misses - misses << " function blocks typechecked, "
+               << cache.hits - hits << " taken from the cache" << eom;
+
   remove_internal_symbols(
     new_symbol_table, get_message_handler(), keep_file_local);
 
+  const auto linking_start = std::chrono::steady_clock::now();
+
   if(linking(symbol_table, new_symbol_table, get_message_handler()))
     return true;
 
+  const auto linking_stop = std::chrono::steady_clock::now();
+  const std::chrono::duration<double> linking_runtime =
+    linking_stop - linking_start;
+  statistics() << "Runtime Linking " << module << ": "
+               << linking_runtime.count() << "s" << eom;
+
   return false;
 }
 
@@ -63,7 +95,13 @@ bool statement_list_languaget::parse(
   statement_list_parser.set_file(path);
   statement_list_parser.in = &instream;
   statement_list_scanner_init();
+
+  const auto parse_start = std::chrono::steady_clock::now();
   bool result = statement_list_parser.parse();
+  const auto parse_stop = std::chrono::steady_clock::now();
+  const std::chrono::duration<double> parse_runtime = parse_stop - parse_start;
+  statistics() << "Runtime Parse " << path << ": " << parse_runtime.count()
+               << "s" << eom;
 
   // store result
   statement_list_parser.swap_tree(parse_tree);
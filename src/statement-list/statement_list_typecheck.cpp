@@ -88,6 +88,105 @@ bool statement_list_typecheck(
   return stl_typecheck.typecheck_main();
 }
 
+bool statement_list_typecheck(
+  const statement_list_parse_treet &parse_tree,
+  symbol_tablet &symbol_table,
+  const std::string &module,
+  message_handlert &message_handler,
+  statement_list_typecheck_cachet &cache)
+{
+  statement_list_typecheckt stl_typecheck(
+    parse_tree, symbol_table, module, message_handler, &cache);
+
+  return stl_typecheck.typecheck_main();
+}
+
+/// Converts a variable declaration list into an irep, for comparison.
+/// \param var_decls: List of declarations to convert.
+/// \return Irep with the variables and their default values as operands.
+static irept
+var_decls_irep(const statement_list_parse_treet::var_declarationst &var_decls)
+{
+  irept result;
+  for(const statement_list_parse_treet::var_declarationt &declaration :
+      var_decls)
+  {
+    result.get_sub().push_back(declaration.variable);
+    result.get_sub().push_back(
+      declaration.default_value.value_or(static_cast<exprt>(nil_exprt())));
+  }
+  return result;
+}
+
+/// Converts the interface of a TIA module into an irep, for comparison.
+/// \param tia_module: Module whose interface shall be converted.
+/// \return Irep with the name, version and variable declarations of the
+///   module.
+static irept
+interface_irep(const statement_list_parse_treet::tia_modulet &tia_module)
+{
+  irept result{tia_module.name};
+  result.get_sub().push_back(irept{tia_module.version});
+  result.get_sub().push_back(var_decls_irep(tia_module.var_input));
+  result.get_sub().push_back(var_decls_irep(tia_module.var_inout));
+  result.get_sub().push_back(var_decls_irep(tia_module.var_output));
+  result.get_sub().push_back(var_decls_irep(tia_module.var_temp));
+  result.get_sub().push_back(var_decls_irep(tia_module.var_constant));
+  return result;
+}
+
+/// Converts the networks of a TIA module into an irep, for comparison.
+/// \param networks: Networks which shall be converted.
+/// \return Irep with an operand per network, which holds an operand per
+///   instruction.
+static irept
+networks_irep(const statement_list_parse_treet::networkst &networks)
+{
+  irept result;
+  for(const statement_list_parse_treet::networkt &network : networks)
+  {
+    irept network_irep;
+    for(const statement_list_parse_treet::instructiont &instruction :
+        network.instructions)
+    {
+      irept instruction_irep;
+      for(const codet &token : instruction.tokens)
+        instruction_irep.get_sub().push_back(token);
+      network_irep.get_sub().push_back(instruction_irep);
+    }
+    result.get_sub().push_back(network_irep);
+  }
+  return result;
+}
+
+/// Converts the declarations of a parse tree into an irep, for comparison.
+/// \param parse_tree: Parse tree whose declarations shall be converted.
+/// \return Irep with the tags and the interfaces of all functions and
+///   function blocks.
+static irept declarations_irep(const statement_list_parse_treet &parse_tree)
+{
+  irept result;
+
+  irept tags;
+  for(const symbol_exprt &tag : parse_tree.tags)
+    tags.get_sub().push_back(tag);
+  result.get_sub().push_back(tags);
+
+  for(const statement_list_parse_treet::functiont &fc : parse_tree.functions)
+  {
+    result.get_sub().push_back(interface_irep(fc));
+    result.get_sub().push_back(fc.return_type);
+  }
+  for(const statement_list_parse_treet::function_blockt &fb :
+      parse_tree.function_blocks)
+  {
+    result.get_sub().push_back(interface_irep(fb));
+    result.get_sub().push_back(var_decls_irep(fb.var_static));
+  }
+
+  return result;
+}
+
 statement_list_typecheckt::nesting_stack_entryt::nesting_stack_entryt(
   exprt rlo_bit,
   bool or_bit,
@@ -116,9 +215,11 @@ statement_list_typecheckt::statement_list_typecheckt(
   const statement_list_parse_treet &parse_tree,
   symbol_tablet &symbol_table,
   const std::string &module,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  statement_list_typecheck_cachet *cache)
   : typecheckt(message_handler),
     parse_tree(parse_tree),
+    cache(cache),
     symbol_table(symbol_table),
     module(module)
 {
@@ -138,11 +239,16 @@ void statement_list_typecheckt::typecheck()
   add_temp_rlo();
 
   // Iterate through all networks to generate the function bodies.
+  const irept declarations =
+    cache == nullptr ? irept{} : declarations_irep(parse_tree);
   for(const statement_list_parse_treet::function_blockt &fb :
       parse_tree.function_blocks)
   {
     symbolt &fb_sym{symbol_table.get_writeable_ref(fb.name)};
-    typecheck_statement_list_networks(fb, fb_sym);
+    if(cache == nullptr)
+      typecheck_statement_list_networks(fb, fb_sym);
+    else
+      typecheck_cached_function_block(fb, fb_sym, declarations);
   }
   for(const statement_list_parse_treet::functiont &fc : parse_tree.functions)
   {
@@ -355,6 +461,49 @@ void statement_list_typecheckt::typecheck_statement_list_networks(
   typecheck_label_references();
 }
 
+void statement_list_typecheckt::typecheck_cached_function_block(
+  const statement_list_parse_treet::function_blockt &function_block,
+  symbolt &function_block_sym,
+  const irept &declarations)
+{
+  irept key;
+  key.get_sub().push_back(declarations);
+  key.get_sub().push_back(interface_irep(function_block));
+  key.get_sub().push_back(var_decls_irep(function_block.var_static));
+  key.get_sub().push_back(networks_irep(function_block.networks));
+
+  if(const auto entry = cache->find(key))
+  {
+    ++cache->hits;
+    function_block_sym.value = entry->value;
+    for(symbolt temp_sym : entry->temp_symbols)
+    {
+      temp_sym.module = module;
+      symbol_table.add(temp_sym);
+    }
+    return;
+  }
+
+  ++cache->misses;
+  typecheck_statement_list_networks(function_block, function_block_sym);
+
+  statement_list_typecheck_cachet::entryt entry;
+  entry.value = function_block_sym.value;
+  // The temp variables are only added if there are networks, see
+  // typecheck_statement_list_networks().
+  if(!function_block.networks.empty())
+  {
+    for(const statement_list_parse_treet::var_declarationt &declaration :
+        function_block.var_temp)
+    {
+      entry.temp_symbols.push_back(symbol_table.lookup_ref(
+        id2string(function_block.name) +
+        "::" + id2string(declaration.variable.get_identifier())));
+    }
+  }
+  cache->insert(key, std::move(entry));
+}
+
 void statement_list_typecheckt::typecheck_label_references()
 {
   if(!label_references.empty())
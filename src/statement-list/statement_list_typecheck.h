@@ -12,12 +12,51 @@ Author: Matthias Weiss, matthias.weiss@diffblue.com
 #ifndef CPROVER_STATEMENT_LIST_STATEMENT_LIST_TYPECHECK_H
 #define CPROVER_STATEMENT_LIST_STATEMENT_LIST_TYPECHECK_H
 
+#include <util/symbol.h>
 #include <util/typecheck.h>
 
 #include "statement_list_parse_tree.h"
 
+#include <unordered_map>
+
 class symbol_tablet;
-class symbolt;
+
+/// Function blocks that have been typechecked, together with the results, so
+/// that a function block that is part of many files is typechecked only once.
+/// An entry is only used for a function block of the same contents in a file
+/// with the same tags, functions and function blocks, as the typecheck of a
+/// function block only depends on these.
+class statement_list_typecheck_cachet
+{
+public:
+  struct entryt
+  {
+    /// Body of the function block.
+    exprt value;
+    /// Symbols of the temp variables of the function block.
+    std::vector<symbolt> temp_symbols;
+  };
+
+  /// Returns the entry for \p key, or nullptr if there is none.
+  const entryt *find(const irept &key) const
+  {
+    const auto it = entries.find(key);
+    return it == entries.end() ? nullptr : &it->second;
+  }
+
+  void insert(const irept &key, entryt entry)
+  {
+    entries.emplace(key, std::move(entry));
+  }
+
+  /// Number of function blocks that were found in the cache.
+  std::size_t hits = 0;
+  /// Number of function blocks that were typechecked and added to the cache.
+  std::size_t misses = 0;
+
+private:
+  std::unordered_map<irept, entryt, irep_hash> entries;
+};
 
 /// Create a new statement_list_typecheckt object and perform a type check to
 /// fill the symbol table.
@@ -35,6 +74,15 @@ bool statement_list_typecheck(
   const std::string &module,
   message_handlert &message_handler);
 
+/// Like \ref statement_list_typecheck, but takes the bodies of function blocks
+/// from \p cache where possible, and adds the others to it.
+bool statement_list_typecheck(
+  const statement_list_parse_treet &parse_tree,
+  symbol_tablet &symbol_table,
+  const std::string &module,
+  message_handlert &message_handler,
+  statement_list_typecheck_cachet &cache);
+
 /// Class for encapsulating the current state of the type check.
 class statement_list_typecheckt : public typecheckt
 {
@@ -47,11 +95,14 @@ public:
   /// \param module: Name of the file that has been parsed.
   /// \param message_handler: Used to provide debug information and error
   ///   messages.
+  /// \param cache: Function blocks typechecked before, or nullptr if none
+  ///   shall be used.
   statement_list_typecheckt(
     const statement_list_parse_treet &parse_tree,
     symbol_tablet &symbol_table,
     const std::string &module,
-    message_handlert &message_handler);
+    message_handlert &message_handler,
+    statement_list_typecheck_cachet *cache = nullptr);
 
   /// Performs the actual typecheck by using the parse tree with which the
   /// object was initialized and modifies the referenced symbol table.
@@ -61,6 +112,9 @@ private:
   /// Parse tree which is used to fill the symbol table.
   const statement_list_parse_treet &parse_tree;
 
+  /// Function blocks typechecked before, or nullptr if none shall be used.
+  statement_list_typecheck_cachet *const cache;
+
   /// Reference to the symbol table that should be filled during the typecheck.
   symbol_tablet &symbol_table;
 
@@ -236,6 +290,19 @@ private:
     const statement_list_parse_treet::tia_modulet &tia_module,
     symbolt &tia_symbol);
 
+  /// Performs a typecheck on the networks of a function block, or takes the
+  /// result from the cache if the function block has been typechecked before,
+  /// and saves the result to the given symbol.
+  /// \param function_block: Function block whose networks shall be checked.
+  /// \param [out] function_block_sym: Symbol representation of the function
+  ///   block.
+  /// \param declarations: Tags, functions and function blocks of the parse
+  ///   tree, on which the result depends.
+  void typecheck_cached_function_block(
+    const statement_list_parse_treet::function_blockt &function_block,
+    symbolt &function_block_sym,
+    const irept &declarations);
+
   /// Performs a typecheck on the networks of a TIA module and saves the
   /// result to the given symbol.
   /// \param tia_module: Module containing the networks that shall be checked.
@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "fixedbv.h"
 #include "ieee_float.h"
 #include "invariant.h"
+#include "irep_hash_consing.h"
 #include "std_expr.h"
 
 #include <algorithm>
@@ -96,7 +97,7 @@ bool to_integer(const constant_exprt &expr, mp_integer &int_value)
   return true;
 }
 
-constant_exprt from_integer(
+static constant_exprt integer_constant(
   const mp_integer &int_value,
   const typet &type)
 {
@@ -172,6 +173,15 @@ constant_exprt from_integer(
     PRECONDITION(false);
 }
 
+constant_exprt from_integer(
+  const mp_integer &int_value,
+  const typet &type)
+{
+  constant_exprt result = integer_constant(int_value, type);
+  hash_cons(result);
+  return result;
+}
+
 /// ceil(log2(size))
 std::size_t address_bits(const mp_integer &size)
 {
@@ -373,11 +383,56 @@ irep_idt bvrep_bitwise_op(
   });
 }
 
+/// \return the bit-vector representation of the lower \p width bits of \p word
+static irep_idt word2bvrep(mp_integer::ullong_t word, std::size_t width)
+{
+  const std::size_t word_bits = sizeof(word) * 8;
+  if(width < word_bits)
+    word &= (mp_integer::ullong_t(1) << width) - 1;
+
+  if(word == 0)
+    return ID_0;
+
+  char buffer[sizeof(word) * 2];
+  char *p = buffer + sizeof(buffer);
+  for(; word != 0; word >>= 4)
+    *--p = nibble2hex(word & 0xf);
+
+  return std::string(p, buffer + sizeof(buffer));
+}
+
+/// \return true when the bit-vector representation \p src fits into \p word,
+///   which is then set to its value
+static bool bvrep2word(const irep_idt &src, mp_integer::ullong_t &word)
+{
+  if(src.size() > sizeof(word) * 2)
+    return false;
+
+  word = 0;
+  for(const char nibble : id2string(src))
+  {
+    DATA_INVARIANT(
+      isdigit(nibble) || (nibble >= 'A' && nibble <= 'F'),
+      "bvrep is hexadecimal, upper-case");
+    word <<= 4;
+    word |= isdigit(nibble) ? nibble - '0' : nibble - 'A' + 10;
+  }
+
+  return true;
+}
+
 /// convert an integer to bit-vector representation with given width
 /// This uses two's complement for negative numbers.
 /// If the value is out of range, it is 'wrapped around'.
 irep_idt integer2bvrep(const mp_integer &src, std::size_t width)
 {
+  // Values that fit into a machine word are wrapped around by masking.
+  const std::size_t word_bits = sizeof(mp_integer::ullong_t) * 8;
+  if(!src.is_negative() && src.is_ulong())
+    return word2bvrep(src.to_ulong(), width);
+  else if(src.is_long() && width <= word_bits)
+    return word2bvrep(mp_integer::ullong_t(src.to_long()), width);
+
   const mp_integer p = power(2, width);
 
   if(src.is_negative())
@@ -400,6 +455,28 @@ irep_idt integer2bvrep(const mp_integer &src, std::size_t width)
 /// convert a bit-vector representation (possibly signed) to integer
 mp_integer bvrep2integer(const irep_idt &src, std::size_t width, bool is_signed)
 {
+  // Most constants fit into a machine word, which saves parsing them as
+  // arbitrary-precision numbers.
+  const std::size_t word_bits = sizeof(mp_integer::ullong_t) * 8;
+  mp_integer::ullong_t word;
+  if(
+    width != 0 && width <= word_bits && bvrep2word(src, word) &&
+    (width == word_bits || (word >> width) == 0))
+  {
+    const mp_integer::ullong_t sign_bit = mp_integer::ullong_t(1)
+                                          << (width - 1);
+    if(is_signed && (word & sign_bit) != 0)
+    {
+      // the two's complement of the number, which does not overflow
+      const mp_integer::ullong_t magnitude = (~word & (sign_bit - 1)) + 1;
+      mp_integer result = magnitude;
+      result.negate();
+      return result;
+    }
+
+    return word;
+  }
+
   if(is_signed)
   {
     PRECONDITION(width >= 1);
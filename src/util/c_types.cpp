@@ -10,6 +10,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "config.h"
 #include "invariant.h"
+#include "irep_hash_consing.h"
 #include "pointer_offset_size.h"
 #include "std_types.h"
 
@@ -31,6 +32,7 @@ signedbv_typet signed_int_type()
 {
   signedbv_typet result(config.ansi_c.int_width);
   result.set(ID_C_c_type, ID_signed_int);
+  hash_cons(result);
   return result;
 }
 
@@ -38,6 +40,7 @@ signedbv_typet signed_short_int_type()
 {
   signedbv_typet result(config.ansi_c.short_int_width);
   result.set(ID_C_c_type, ID_signed_short_int);
+  hash_cons(result);
   return result;
 }
 
@@ -45,6 +48,7 @@ unsignedbv_typet unsigned_int_type()
 {
   unsignedbv_typet result(config.ansi_c.int_width);
   result.set(ID_C_c_type, ID_unsigned_int);
+  hash_cons(result);
   return result;
 }
 
@@ -52,6 +56,7 @@ unsignedbv_typet unsigned_short_int_type()
 {
   unsignedbv_typet result(config.ansi_c.short_int_width);
   result.set(ID_C_c_type, ID_unsigned_short_int);
+  hash_cons(result);
   return result;
 }
 
@@ -81,6 +86,7 @@ signedbv_typet signed_long_int_type()
 {
   signedbv_typet result(config.ansi_c.long_int_width);
   result.set(ID_C_c_type, ID_signed_long_int);
+  hash_cons(result);
   return result;
 }
 
@@ -88,6 +94,7 @@ signedbv_typet signed_long_long_int_type()
 {
   signedbv_typet result(config.ansi_c.long_long_int_width);
   result.set(ID_C_c_type, ID_signed_long_long_int);
+  hash_cons(result);
   return result;
 }
 
@@ -95,6 +102,7 @@ unsignedbv_typet unsigned_long_int_type()
 {
   unsignedbv_typet result(config.ansi_c.long_int_width);
   result.set(ID_C_c_type, ID_unsigned_long_int);
+  hash_cons(result);
   return result;
 }
 
@@ -102,6 +110,7 @@ unsignedbv_typet unsigned_long_long_int_type()
 {
   unsignedbv_typet result(config.ansi_c.long_long_int_width);
   result.set(ID_C_c_type, ID_unsigned_long_long_int);
+  hash_cons(result);
   return result;
 }
 
@@ -136,6 +145,7 @@ unsignedbv_typet unsigned_char_type()
 {
   unsignedbv_typet result(config.ansi_c.char_width);
   result.set(ID_C_c_type, ID_unsigned_char);
+  hash_cons(result);
   return result;
 }
 
@@ -143,6 +153,7 @@ signedbv_typet signed_char_type()
 {
   signedbv_typet result(config.ansi_c.char_width);
   result.set(ID_C_c_type, ID_signed_char);
+  hash_cons(result);
   return result;
 }
 
@@ -169,6 +180,7 @@ unsignedbv_typet char16_t_type()
   // respectively, in <stdint.h>, called the underlying types.
   unsignedbv_typet result(16);
   result.set(ID_C_c_type, ID_char16_t);
+  hash_cons(result);
   return result;
 }
 
@@ -179,6 +191,7 @@ unsignedbv_typet char32_t_type()
   // respectively, in <stdint.h>, called the underlying types.
   unsignedbv_typet result(32);
   result.set(ID_C_c_type, ID_char32_t);
+  hash_cons(result);
   return result;
 }
 
@@ -187,6 +200,7 @@ floatbv_typet float_type()
   floatbv_typet result=
     ieee_float_spect::single_precision().to_type();
   result.set(ID_C_c_type, ID_float);
+  hash_cons(result);
   return result;
 }
 
@@ -195,6 +209,7 @@ floatbv_typet double_type()
   floatbv_typet result=
     ieee_float_spect::double_precision().to_type();
   result.set(ID_C_c_type, ID_double);
+  hash_cons(result);
   return result;
 }
 
@@ -237,7 +237,7 @@ public:
     }
   };
 
-  typedef std::vector<c_enum_membert> memberst;
+  typedef irep_sub_containert<c_enum_membert> memberst;
 
   const memberst &members() const
   {
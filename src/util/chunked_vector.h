@@ -0,0 +1,438 @@
+/*******************************************************************\
+
+Module: Vector storing its elements in fixed-size chunks
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Vector storing its elements in fixed-size chunks
+
+#ifndef CPROVER_UTIL_CHUNKED_VECTOR_H
+#define CPROVER_UTIL_CHUNKED_VECTOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "invariant.h"
+
+template <typename T, std::size_t chunk_size>
+class chunked_vectort;
+
+/// A random-access iterator into a chunked_vectort, consisting of the
+/// container and the position of the element in it. Iterators thus remain
+/// valid when elements are appended to the container, and the end iterator
+/// then refers to the first element appended.
+template <typename T, typename containert>
+class chunked_vector_iteratort
+{
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = typename std::remove_const<T>::type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T *;
+  using reference = T &;
+
+  chunked_vector_iteratort() = default;
+
+  chunked_vector_iteratort(containert *container, std::size_t index)
+    : container(container), index(index)
+  {
+  }
+
+  /// Conversion from iterator to const_iterator
+  template <
+    typename U,
+    typename other_containert,
+    typename = typename std::enable_if<
+      std::is_same<const U, T>::value && !std::is_same<U, T>::value>::type>
+  // NOLINTNEXTLINE(runtime/explicit)
+  chunked_vector_iteratort(
+    const chunked_vector_iteratort<U, other_containert> &other)
+    : container(other.get_container()), index(other.get_index())
+  {
+  }
+
+  containert *get_container() const
+  {
+    return container;
+  }
+
+  std::size_t get_index() const
+  {
+    return index;
+  }
+
+  reference operator*() const
+  {
+    return (*container)[index];
+  }
+
+  pointer operator->() const
+  {
+    return &(*container)[index];
+  }
+
+  reference operator[](difference_type n) const
+  {
+    return (*container)[index + n];
+  }
+
+  chunked_vector_iteratort &operator++()
+  {
+    ++index;
+    return *this;
+  }
+
+  chunked_vector_iteratort operator++(int)
+  {
+    return chunked_vector_iteratort(container, index++);
+  }
+
+  chunked_vector_iteratort &operator--()
+  {
+    --index;
+    return *this;
+  }
+
+  chunked_vector_iteratort operator--(int)
+  {
+    return chunked_vector_iteratort(container, index--);
+  }
+
+  chunked_vector_iteratort &operator+=(difference_type n)
+  {
+    index += n;
+    return *this;
+  }
+
+  chunked_vector_iteratort &operator-=(difference_type n)
+  {
+    index -= n;
+    return *this;
+  }
+
+  chunked_vector_iteratort operator+(difference_type n) const
+  {
+    return chunked_vector_iteratort(container, index + n);
+  }
+
+  friend chunked_vector_iteratort
+  operator+(difference_type n, const chunked_vector_iteratort &it)
+  {
+    return it + n;
+  }
+
+  chunked_vector_iteratort operator-(difference_type n) const
+  {
+    return chunked_vector_iteratort(container, index - n);
+  }
+
+  template <typename U, typename other_containert>
+  difference_type
+  operator-(const chunked_vector_iteratort<U, other_containert> &other) const
+  {
+    return static_cast<difference_type>(index) -
+           static_cast<difference_type>(other.get_index());
+  }
+
+  template <typename U, typename other_containert>
+  bool
+  operator==(const chunked_vector_iteratort<U, other_containert> &other) const
+  {
+    return index == other.get_index() && container == other.get_container();
+  }
+
+  template <typename U, typename other_containert>
+  bool
+  operator!=(const chunked_vector_iteratort<U, other_containert> &other) const
+  {
+    return !(*this == other);
+  }
+
+  template <typename U, typename other_containert>
+  bool
+  operator<(const chunked_vector_iteratort<U, other_containert> &other) const
+  {
+    return index < other.get_index();
+  }
+
+  template <typename U, typename other_containert>
+  bool
+  operator>(const chunked_vector_iteratort<U, other_containert> &other) const
+  {
+    return index > other.get_index();
+  }
+
+  template <typename U, typename other_containert>
+  bool
+  operator<=(const chunked_vector_iteratort<U, other_containert> &other) const
+  {
+    return index <= other.get_index();
+  }
+
+  template <typename U, typename other_containert>
+  bool
+  operator>=(const chunked_vector_iteratort<U, other_containert> &other) const
+  {
+    return index >= other.get_index();
+  }
+
+private:
+  containert *container = nullptr;
+  std::size_t index = 0;
+};
+
+/// A sequence container that stores its elements in chunks of \p chunk_size
+/// elements each. Unlike `std::vector`, appending never moves elements, so
+/// references to elements remain valid until the element is removed; unlike
+/// `std::list`, each element requires no allocation of its own and
+/// consecutive elements are adjacent in memory, which makes traversals
+/// cheap.
+///
+/// Iterators remain valid when appending, but refer to the container, and
+/// are thus invalidated by moving or swapping containers, even though
+/// references to elements remain valid in that case.
+///
+/// \tparam T: element type
+/// \tparam chunk_size: number of elements per chunk, a power of two
+template <typename T, std::size_t chunk_size = 256>
+class chunked_vectort
+{
+  static_assert(
+    chunk_size > 0 && (chunk_size & (chunk_size - 1)) == 0,
+    "chunk size must be a power of two");
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = chunked_vector_iteratort<T, chunked_vectort>;
+  using const_iterator =
+    chunked_vector_iteratort<const T, const chunked_vectort>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  chunked_vectort() = default;
+
+  chunked_vectort(const chunked_vectort &other)
+  {
+    reserve(other.size());
+    for(const T &element : other)
+      push_back(element);
+  }
+
+  chunked_vectort(chunked_vectort &&other) noexcept
+    : chunks(std::move(other.chunks)), number_of_elements(other.size())
+  {
+    other.chunks.clear();
+    other.number_of_elements = 0;
+  }
+
+  chunked_vectort &operator=(const chunked_vectort &other)
+  {
+    if(this != &other)
+    {
+      chunked_vectort copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  chunked_vectort &operator=(chunked_vectort &&other) noexcept
+  {
+    if(this != &other)
+    {
+      clear();
+      chunks.swap(other.chunks);
+      std::swap(number_of_elements, other.number_of_elements);
+    }
+    return *this;
+  }
+
+  ~chunked_vectort()
+  {
+    clear();
+  }
+
+  size_type size() const
+  {
+    return number_of_elements;
+  }
+
+  bool empty() const
+  {
+    return number_of_elements == 0;
+  }
+
+  /// Allocate chunks for at least \p n elements
+  void reserve(size_type n)
+  {
+    while(chunks.size() * chunk_size < n)
+      chunks.emplace_back(new chunkt);
+  }
+
+  T &operator[](size_type n)
+  {
+    return *slot(n);
+  }
+
+  const T &operator[](size_type n) const
+  {
+    return *slot(n);
+  }
+
+  T &front()
+  {
+    PRECONDITION(!empty());
+    return *slot(0);
+  }
+
+  const T &front() const
+  {
+    PRECONDITION(!empty());
+    return *slot(0);
+  }
+
+  T &back()
+  {
+    PRECONDITION(!empty());
+    return *slot(number_of_elements - 1);
+  }
+
+  const T &back() const
+  {
+    PRECONDITION(!empty());
+    return *slot(number_of_elements - 1);
+  }
+
+  template <typename... Args>
+  T &emplace_back(Args &&... args)
+  {
+    reserve(number_of_elements + 1);
+    T *p = new(slot(number_of_elements)) T(std::forward<Args>(args)...);
+    ++number_of_elements;
+    return *p;
+  }
+
+  void push_back(const T &value)
+  {
+    emplace_back(value);
+  }
+
+  void push_back(T &&value)
+  {
+    emplace_back(std::move(value));
+  }
+
+  /// Append the elements in [\p first, \p last)
+  template <typename Iterator>
+  void append(Iterator first, Iterator last)
+  {
+    for(; first != last; ++first)
+      emplace_back(*first);
+  }
+
+  void pop_back()
+  {
+    PRECONDITION(!empty());
+    --number_of_elements;
+    slot(number_of_elements)->~T();
+  }
+
+  /// Destroy all elements; the memory of the chunks is released as well
+  void clear()
+  {
+    while(!empty())
+      pop_back();
+    chunks.clear();
+  }
+
+  void swap(chunked_vectort &other)
+  {
+    chunks.swap(other.chunks);
+    std::swap(number_of_elements, other.number_of_elements);
+  }
+
+  iterator begin()
+  {
+    return iterator(this, 0);
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(this, 0);
+  }
+
+  const_iterator cbegin() const
+  {
+    return begin();
+  }
+
+  iterator end()
+  {
+    return iterator(this, number_of_elements);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(this, number_of_elements);
+  }
+
+  const_iterator cend() const
+  {
+    return end();
+  }
+
+  reverse_iterator rbegin()
+  {
+    return reverse_iterator(end());
+  }
+
+  const_reverse_iterator rbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend()
+  {
+    return reverse_iterator(begin());
+  }
+
+  const_reverse_iterator rend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+private:
+  struct chunkt
+  {
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type
+      slots[chunk_size];
+  };
+
+  std::vector<std::unique_ptr<chunkt>> chunks;
+  size_type number_of_elements = 0;
+
+  T *slot(size_type n)
+  {
+    return reinterpret_cast<T *>(
+      &chunks[n / chunk_size]->slots[n % chunk_size]);
+  }
+
+  const T *slot(size_type n) const
+  {
+    return reinterpret_cast<const T *>(
+      &chunks[n / chunk_size]->slots[n % chunk_size]);
+  }
+};
+
+#endif // CPROVER_UTIL_CHUNKED_VECTOR_H
@@ -83,6 +83,22 @@ void cmdlinet::set(const std::string &option, const std::string &value)
   }
 }
 
+void cmdlinet::unset(const std::string &option)
+{
+  auto i = getoptnr(option);
+
+  if(i.has_value())
+  {
+    options[*i].isset = false;
+    options[*i].values.clear();
+  }
+  else
+  {
+    throw invalid_command_line_argument_exceptiont(
+      "unknown command line option", option);
+  }
+}
+
 static std::list<std::string> immutable_empty_list;
 
 const std::list<std::string> &cmdlinet::get_values(char option) const
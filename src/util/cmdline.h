@@ -91,6 +91,8 @@ public:
   {
     set(option, std::string{value});
   }
+  /// Unset option \p option and discard the values it has been given.
+  void unset(const std::string &option);
 
   virtual void clear();
 
@@ -0,0 +1,317 @@
+/*******************************************************************\
+
+Module: Immutable Graphs in Compressed Sparse Row Layout
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Immutable Graphs in Compressed Sparse Row Layout
+
+#include "csr_graph.h"
+
+#include <algorithm>
+
+const csr_grapht::node_indext csr_grapht::no_node;
+
+csr_grapht::csr_grapht(
+  std::size_t number_of_nodes,
+  const std::vector<edget> &edges)
+  : out_offsets(number_of_nodes + 1, 0),
+    targets(edges.size()),
+    in_offsets(number_of_nodes + 1, 0),
+    sources(edges.size())
+{
+  // count the edges of each node, then turn the counts into offsets
+  for(const auto &edge : edges)
+  {
+    PRECONDITION(edge.first < number_of_nodes);
+    PRECONDITION(edge.second < number_of_nodes);
+    ++out_offsets[edge.first + 1];
+    ++in_offsets[edge.second + 1];
+  }
+
+  for(std::size_t n = 0; n < number_of_nodes; ++n)
+  {
+    out_offsets[n + 1] += out_offsets[n];
+    in_offsets[n + 1] += in_offsets[n];
+  }
+
+  std::vector<std::size_t> out_next(out_offsets.begin(), out_offsets.end() - 1);
+  std::vector<std::size_t> in_next(in_offsets.begin(), in_offsets.end() - 1);
+
+  for(const auto &edge : edges)
+  {
+    targets[out_next[edge.first]++] = edge.second;
+    sources[in_next[edge.second]++] = edge.first;
+  }
+}
+
+std::size_t csr_grapht::SCCs(std::vector<node_indext> &subgraph_nr) const
+{
+  const std::size_t unvisited = no_node;
+  std::vector<std::size_t> depth(size(), unvisited);
+  std::vector<std::size_t> lowlink(size(), 0);
+  std::vector<bool> in_scc(size(), false);
+  std::vector<node_indext> scc_stack;
+  subgraph_nr.resize(size(), 0);
+
+  // the nodes being visited, with the position of the next successor in
+  // targets
+  std::vector<std::pair<node_indext, std::size_t>> dfs_stack;
+  std::size_t scc_count = 0;
+  std::size_t max_dfs = 0;
+
+  const auto visit = [&](node_indext v) {
+    depth[v] = lowlink[v] = max_dfs++;
+    scc_stack.push_back(v);
+    in_scc[v] = true;
+    dfs_stack.emplace_back(v, out_offsets[v]);
+  };
+
+  for(node_indext v0 = 0; v0 < size(); ++v0)
+  {
+    if(depth[v0] != unvisited)
+      continue;
+
+    visit(v0);
+
+    while(!dfs_stack.empty())
+    {
+      const node_indext v = dfs_stack.back().first;
+
+      if(dfs_stack.back().second < out_offsets[v + 1])
+      {
+        const node_indext vp = targets[dfs_stack.back().second++];
+        if(depth[vp] == unvisited)
+          visit(vp);
+        else if(in_scc[vp])
+          lowlink[v] = std::min(lowlink[v], depth[vp]);
+        continue;
+      }
+
+      dfs_stack.pop_back();
+
+      // check if root of SCC
+      if(lowlink[v] == depth[v])
+      {
+        while(true)
+        {
+          INVARIANT(
+            !scc_stack.empty(),
+            "stack of strongly connected components should have another "
+            "component");
+          const node_indext vp = scc_stack.back();
+          scc_stack.pop_back();
+          in_scc[vp] = false;
+          subgraph_nr[vp] = scc_count;
+          if(vp == v)
+            break;
+        }
+
+        scc_count++;
+      }
+
+      if(!dfs_stack.empty())
+      {
+        const node_indext parent = dfs_stack.back().first;
+        lowlink[parent] = std::min(lowlink[parent], lowlink[v]);
+      }
+    }
+  }
+
+  return scc_count;
+}
+
+std::vector<csr_grapht::node_indext> csr_grapht::breadth_first_search(
+  const std::vector<node_indext> &src,
+  std::size_t limit,
+  bool forwards) const
+{
+  const std::vector<std::size_t> &offsets = forwards ? out_offsets : in_offsets;
+  const std::vector<node_indext> &neighbours = forwards ? targets : sources;
+
+  std::vector<bool> visited(size(), false);
+  std::vector<node_indext> result;
+
+  for(const auto n : src)
+  {
+    if(!visited[n])
+    {
+      visited[n] = true;
+      result.push_back(n);
+    }
+  }
+
+  // result[ring_begin] to result[ring_end - 1] are at the current distance
+  std::size_t ring_begin = 0;
+  for(std::size_t distance = 0; distance < limit; ++distance)
+  {
+    const std::size_t ring_end = result.size();
+    if(ring_begin == ring_end)
+      break;
+
+    for(std::size_t i = ring_begin; i < ring_end; ++i)
+    {
+      const node_indext n = result[i];
+      for(std::size_t j = offsets[n]; j < offsets[n + 1]; ++j)
+      {
+        const node_indext next = neighbours[j];
+        if(!visited[next])
+        {
+          visited[next] = true;
+          result.push_back(next);
+        }
+      }
+    }
+
+    ring_begin = ring_end;
+  }
+
+  return result;
+}
+
+std::vector<csr_grapht::node_indext> csr_grapht::get_reachable(
+  const std::vector<node_indext> &src,
+  bool forwards) const
+{
+  return breadth_first_search(src, no_node, forwards);
+}
+
+std::vector<csr_grapht::node_indext> csr_grapht::depth_limited_search(
+  const std::vector<node_indext> &src,
+  std::size_t limit) const
+{
+  return breadth_first_search(src, limit, true);
+}
+
+std::vector<std::size_t> csr_grapht::distances(node_indext src) const
+{
+  std::vector<std::size_t> result(size(), no_node);
+  std::vector<node_indext> queue{src};
+  result[src] = 0;
+
+  for(std::size_t i = 0; i < queue.size(); ++i)
+  {
+    const node_indext n = queue[i];
+    for(const auto next : successors(n))
+    {
+      if(result[next] == no_node)
+      {
+        result[next] = result[n] + 1;
+        queue.push_back(next);
+      }
+    }
+  }
+
+  return result;
+}
+
+/// Kahn's algorithm, as in grapht::topsort
+std::vector<csr_grapht::node_indext> csr_grapht::topsort() const
+{
+  std::vector<std::size_t> in_deg(size());
+  std::vector<node_indext> result;
+  result.reserve(size());
+
+  for(node_indext n = 0; n < size(); ++n)
+  {
+    in_deg[n] = in_offsets[n + 1] - in_offsets[n];
+    if(in_deg[n] == 0)
+      result.push_back(n);
+  }
+
+  // the nodes in result from position i onwards are the working set
+  for(std::size_t i = 0; i < result.size(); ++i)
+  {
+    for(const auto target : successors(result[i]))
+    {
+      INVARIANT(in_deg[target] != 0, "in-degree of node cannot be zero here");
+      if(--in_deg[target] == 0)
+        result.push_back(target);
+    }
+  }
+
+  // if all nodes are sorted, the graph is acyclic
+  if(result.size() != size())
+    result.clear();
+  return result;
+}
+
+std::vector<csr_grapht::node_indext>
+csr_grapht::immediate_dominators(node_indext root) const
+{
+  // number the nodes reachable from root in postorder
+  std::vector<std::size_t> postorder_nr(size(), no_node);
+  std::vector<node_indext> postorder;
+  {
+    std::vector<bool> visited(size(), false);
+    std::vector<std::pair<node_indext, std::size_t>> dfs_stack;
+    visited[root] = true;
+    dfs_stack.emplace_back(root, out_offsets[root]);
+
+    while(!dfs_stack.empty())
+    {
+      const node_indext n = dfs_stack.back().first;
+      if(dfs_stack.back().second < out_offsets[n + 1])
+      {
+        const node_indext next = targets[dfs_stack.back().second++];
+        if(!visited[next])
+        {
+          visited[next] = true;
+          dfs_stack.emplace_back(next, out_offsets[next]);
+        }
+      }
+      else
+      {
+        postorder_nr[n] = postorder.size();
+        postorder.push_back(n);
+        dfs_stack.pop_back();
+      }
+    }
+  }
+
+  std::vector<node_indext> idom(size(), no_node);
+  idom[root] = root;
+
+  const auto intersect = [&](node_indext a, node_indext b) {
+    while(a != b)
+    {
+      while(postorder_nr[a] < postorder_nr[b])
+        a = idom[a];
+      while(postorder_nr[b] < postorder_nr[a])
+        b = idom[b];
+    }
+    return a;
+  };
+
+  // iterate in reverse postorder until the dominators are stable
+  for(bool changed = true; changed;)
+  {
+    changed = false;
+
+    for(auto it = postorder.rbegin(); it != postorder.rend(); ++it)
+    {
+      const node_indext n = *it;
+      if(n == root)
+        continue;
+
+      node_indext new_idom = no_node;
+      for(const auto pred : predecessors(n))
+      {
+        if(idom[pred] == no_node)
+          continue;
+        new_idom = new_idom == no_node ? pred : intersect(pred, new_idom);
+      }
+
+      if(idom[n] != new_idom)
+      {
+        idom[n] = new_idom;
+        changed = true;
+      }
+    }
+  }
+
+  return idom;
+}
@@ -0,0 +1,131 @@
+/*******************************************************************\
+
+Module: Immutable Graphs in Compressed Sparse Row Layout
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Immutable Graphs in Compressed Sparse Row Layout
+
+#ifndef CPROVER_UTIL_CSR_GRAPH_H
+#define CPROVER_UTIL_CSR_GRAPH_H
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+#include "range.h"
+
+/// A directed graph without payloads whose edges cannot change after
+/// construction. The successors of all nodes are stored in one vector, with
+/// those of node `n` at positions `out_offsets[n]` to `out_offsets[n+1]`, and
+/// likewise for the predecessors. Traversals thus touch contiguous memory
+/// instead of the `std::map` per node of \ref grapht, and the algorithms
+/// below use explicit stacks rather than recursion. Use \ref from_graph to
+/// run them on a \ref grapht that is no longer modified.
+class csr_grapht
+{
+public:
+  typedef std::size_t node_indext;
+  typedef std::pair<node_indext, node_indext> edget;
+  typedef ranget<std::vector<node_indext>::const_iterator> nodest;
+
+  /// Marks nodes without an immediate dominator
+  static const node_indext no_node = std::numeric_limits<node_indext>::max();
+
+  csr_grapht() = default;
+
+  /// Graph on the nodes `0` to `number_of_nodes - 1` with the given
+  /// \p edges, where the successors and predecessors of each node keep the
+  /// order of \p edges
+  csr_grapht(std::size_t number_of_nodes, const std::vector<edget> &edges);
+
+  /// \return the graph with the nodes and edges of \p graph, with the
+  ///   successors and predecessors in the order of \p graph
+  template <class N>
+  static csr_grapht from_graph(const grapht<N> &graph)
+  {
+    std::vector<edget> edges;
+    for(node_indext n = 0; n < graph.size(); ++n)
+    {
+      for(const auto &out : graph.out(n))
+        edges.emplace_back(n, out.first);
+    }
+    return csr_grapht(graph.size(), edges);
+  }
+
+  std::size_t size() const
+  {
+    return out_offsets.empty() ? 0 : out_offsets.size() - 1;
+  }
+
+  bool empty() const
+  {
+    return size() == 0;
+  }
+
+  std::size_t number_of_edges() const
+  {
+    return targets.size();
+  }
+
+  nodest successors(node_indext n) const
+  {
+    return make_range(
+      targets.begin() + out_offsets[n], targets.begin() + out_offsets[n + 1]);
+  }
+
+  nodest predecessors(node_indext n) const
+  {
+    return make_range(
+      sources.begin() + in_offsets[n], sources.begin() + in_offsets[n + 1]);
+  }
+
+  /// Computes the strongly connected components, numbered like
+  /// \ref grapht::SCCs does: lower-numbered SCCs are closer to the leaves.
+  /// \param [out] subgraph_nr: the SCC of each node
+  /// \return the number of SCCs
+  std::size_t SCCs(std::vector<node_indext> &subgraph_nr) const;
+
+  /// \return the nodes reachable from any of \p src, including those, in
+  ///   breadth-first order, following the edges backwards unless \p forwards
+  std::vector<node_indext>
+  get_reachable(const std::vector<node_indext> &src, bool forwards) const;
+
+  /// \return the nodes reachable from any of \p src in at most \p limit
+  ///   steps, including those, in breadth-first order
+  std::vector<node_indext>
+  depth_limited_search(const std::vector<node_indext> &src, std::size_t limit)
+    const;
+
+  /// \return the distance of each node from \p src in steps, or
+  ///   \ref no_node for the nodes that cannot be reached
+  std::vector<std::size_t> distances(node_indext src) const;
+
+  /// \return a topological order of the nodes, or an empty vector if the
+  ///   graph has a cycle
+  std::vector<node_indext> topsort() const;
+
+  /// Computes the dominator tree with the algorithm of Cooper, Harvey and
+  /// Kennedy, "A Simple, Fast Dominance Algorithm".
+  /// \return the immediate dominator of each node, which is \p root for
+  ///   \p root itself and \ref no_node for the nodes not reachable from
+  ///   \p root
+  std::vector<node_indext> immediate_dominators(node_indext root) const;
+
+protected:
+  std::vector<std::size_t> out_offsets;
+  std::vector<node_indext> targets;
+  std::vector<std::size_t> in_offsets;
+  std::vector<node_indext> sources;
+
+  std::vector<node_indext> breadth_first_search(
+    const std::vector<node_indext> &src,
+    std::size_t limit,
+    bool forwards) const;
+};
+
+#endif // CPROVER_UTIL_CSR_GRAPH_H
@@ -53,7 +53,7 @@ class const_unique_depth_iteratort;
 class exprt:public irept
 {
 public:
-  typedef std::vector<exprt> operandst;
+  typedef irep_sub_containert<exprt> operandst;
 
   // constructors
   exprt() { }
@@ -11,17 +11,23 @@ Author: Romain Brenguier, romain.brenguier@diffblue.com
 
 #include <algorithm>
 #include <forward_list>
+#include <memory>
 
 #include "as_const.h"
 #include "narrow.h"
 
 /// Implementation of map-like interface using a forward list
-template <typename keyt, typename mappedt>
+template <
+  typename keyt,
+  typename mappedt,
+  typename allocatort = std::allocator<std::pair<keyt, mappedt>>>
 //  requires DefaultConstructible<mappedt>
-class forward_list_as_mapt : public std::forward_list<std::pair<keyt, mappedt>>
+class forward_list_as_mapt
+  : public std::forward_list<std::pair<keyt, mappedt>, allocatort>
 {
 public:
-  using implementationt = typename std::forward_list<std::pair<keyt, mappedt>>;
+  using implementationt =
+    typename std::forward_list<std::pair<keyt, mappedt>, allocatort>;
   using const_iterator = typename implementationt::const_iterator;
   using iterator = typename implementationt::iterator;
 
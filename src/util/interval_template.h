@@ -103,9 +103,10 @@ public:
   }
 
   // Union or disjunction
-  void join(const interval_templatet<T> &i)
+  // Returns true if this interval changed
+  bool join(const interval_templatet<T> &i)
   {
-    approx_union_with(i);
+    return approx_union_with(i);
   }
 
   // Intersection or conjunction
@@ -184,17 +185,41 @@ public:
       return false;
   }
 
-  void approx_union_with(const interval_templatet &i)
+  // Returns true if this interval changed. Bounds are only assigned when
+  // they change, as copying them may be costly.
+  bool approx_union_with(const interval_templatet &i)
   {
-    if(i.lower_set && lower_set)
-      lower=std::min(lower, i.lower);
-    else if(!i.lower_set && lower_set)
-      lower_set=false;
-
-    if(i.upper_set && upper_set)
-      upper=std::max(upper, i.upper);
-    else if(!i.upper_set && upper_set)
-      upper_set=false;
+    bool changed=false;
+
+    if(lower_set)
+    {
+      if(!i.lower_set)
+      {
+        lower_set=false;
+        changed=true;
+      }
+      else if(i.lower<lower)
+      {
+        lower=i.lower;
+        changed=true;
+      }
+    }
+
+    if(upper_set)
+    {
+      if(!i.upper_set)
+      {
+        upper_set=false;
+        changed=true;
+      }
+      else if(upper<i.upper)
+      {
+        upper=i.upper;
+        changed=true;
+      }
+    }
+
+    return changed;
   }
 };
 
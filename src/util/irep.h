@@ -33,6 +33,40 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <map>
 #endif
 
+// Opt-in: take tree nodes and named-sub list cells from size-class pools (see
+// pool_allocator.h) instead of allocating each one individually on the heap.
+// #define IREP_USE_NODE_POOL
+#ifdef IREP_USE_NODE_POOL
+#  include "pool_allocator.h"
+#endif
+
+// Opt-in: store up to two subtrees within each tree node (see
+// small_vector.h) instead of in a separately allocated std::vector.
+// #define IREP_USE_SMALL_SUB
+#ifdef IREP_USE_SMALL_SUB
+#  include "small_vector.h"
+#endif
+
+// Opt-in: count allocations and copy-on-write operations of tree nodes (see
+// irep_statistics.h).
+// #define IREP_STATS
+#ifdef IREP_STATS
+#  include "irep_statistics.h"
+#endif
+
+/// The container holding the subtrees of a tree node. Typed views of these
+/// subtrees, such as `exprt::operandst`, are obtained by casting, and thus
+/// must use the same container.
+#ifdef IREP_USE_SMALL_SUB
+// The slot size is fixed, as tree nodes (and thus subtrees) are just a
+// pointer, and the element type is incomplete where this is used.
+template <typename T>
+using irep_sub_containert = small_vectort<T, 2, sizeof(void *)>;
+#else
+template <typename T>
+using irep_sub_containert = std::vector<T>;
+#endif
+
 #ifdef USE_DSTRING
 typedef dstringt irep_idt;
 typedef dstringt irep_namet;
@@ -109,7 +143,7 @@ class tree_nodet : public ref_count_ift<sharing>
 {
 public:
   // These are not stable.
-  typedef std::vector<treet> subt;
+  typedef irep_sub_containert<treet> subt;
 
   // named_subt has to provide stable references; we can
   // use std::forward_list or std::vector< unique_ptr<T> > to save
@@ -160,6 +194,19 @@ public:
       sub(std::move(_sub))
   {
   }
+
+#ifdef IREP_USE_NODE_POOL
+  static void *operator new(std::size_t size)
+  {
+    PRECONDITION(size == sizeof(tree_nodet));
+    return size_class_pool<sizeof(tree_nodet)>().allocate();
+  }
+
+  static void operator delete(void *p)
+  {
+    size_class_pool<sizeof(tree_nodet)>().deallocate(p);
+  }
+#endif
 };
 
 /// Base class for tree-like data structures with sharing
@@ -176,11 +223,17 @@ public:
 
   explicit sharing_treet(irep_idt _id) : data(new dt(std::move(_id)))
   {
+#ifdef IREP_STATS
+    irep_statisticst::counters().allocations++;
+#endif
   }
 
   sharing_treet(irep_idt _id, named_subt _named_sub, subt _sub)
     : data(new dt(std::move(_id), std::move(_named_sub), std::move(_sub)))
   {
+#ifdef IREP_STATS
+    irep_statisticst::counters().allocations++;
+#endif
   }
 
   // constructor for blank irep
@@ -375,7 +428,12 @@ class irept
   : public non_sharing_treet<
       irept,
 #endif
-#if NAMED_SUB_IS_FORWARD_LIST
+#if NAMED_SUB_IS_FORWARD_LIST && defined(IREP_USE_NODE_POOL)
+      forward_list_as_mapt<
+        irep_namet,
+        irept,
+        pool_allocatort<std::pair<irep_namet, irept>>>>
+#elif NAMED_SUB_IS_FORWARD_LIST
       forward_list_as_mapt<irep_namet, irept>>
 #else
       std::map<irep_namet, irept>>
@@ -538,6 +596,9 @@ void sharing_treet<derivedt, named_subtreest>::detach()
 
 #ifdef IREP_DEBUG
     std::cout << "ALLOCATED " << data << '\n';
+#endif
+#ifdef IREP_STATS
+    irep_statisticst::counters().allocations++;
 #endif
   }
   else if(data->ref_count > 1)
@@ -548,6 +609,14 @@ void sharing_treet<derivedt, named_subtreest>::detach()
 #ifdef IREP_DEBUG
     std::cout << "ALLOCATED " << data << '\n';
 #endif
+#ifdef IREP_STATS
+    irep_counterst &counters = irep_statisticst::counters();
+    counters.allocations++;
+    counters.detaches++;
+    counters.detached_subtrees +=
+      data->sub.size() +
+      std::distance(data->named_sub.begin(), data->named_sub.end());
+#endif
 
     data->ref_count = 1;
     remove_ref(old_data);
@@ -589,6 +658,10 @@ void sharing_treet<derivedt, named_subtreest>::remove_ref(dt *old_data)
     // may cause recursive call
     delete old_data;
 
+#ifdef IREP_STATS
+    irep_statisticst::counters().deallocations++;
+#endif
+
 #ifdef IREP_DEBUG
     std::cout << "DONE\n";
 #endif
@@ -636,6 +709,10 @@ void sharing_treet<derivedt, named_subtreest>::nonrecursive_destructor(
 
       // now delete, won't do recursion
       delete d;
+
+#ifdef IREP_STATS
+      irep_statisticst::counters().deallocations++;
+#endif
     }
   }
 }
@@ -0,0 +1,34 @@
+/*******************************************************************\
+
+Module: Run-wide hash-consing of ireps
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Run-wide hash-consing of ireps
+
+#include "irep_hash_consing.h"
+
+#include "symbol_table_base.h"
+
+bool irep_hash_consingt::enabled = false;
+
+irep_hash_consingt &irep_hash_consingt::instance()
+{
+  // never destroyed, as ireps with static storage duration may still refer
+  // to entries of the table when other static objects are destroyed
+  static irep_hash_consingt *table = new irep_hash_consingt();
+  return *table;
+}
+
+void irep_hash_consingt::operator()(symbol_table_baset &symbol_table)
+{
+  for(auto it = symbol_table.begin(); it != symbol_table.end(); ++it)
+  {
+    symbolt &symbol = it.get_writeable_symbol();
+    merge_full_irep(symbol.type);
+    merge_full_irep(symbol.value);
+  }
+}
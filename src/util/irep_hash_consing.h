@@ -0,0 +1,73 @@
+/*******************************************************************\
+
+Module: Run-wide hash-consing of ireps
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Run-wide hash-consing of ireps
+
+#ifndef CPROVER_UTIL_IREP_HASH_CONSING_H
+#define CPROVER_UTIL_IREP_HASH_CONSING_H
+
+#include "merge_irep.h"
+
+class symbol_table_baset;
+
+/// Process-wide table of ireps that structurally identical ireps (including
+/// their comments) are mapped to, so that they share a single copy in memory
+/// and comparing them for equality amounts to comparing pointers.
+/// Hash-consing is disabled unless \ref enable has been called, in which case
+/// factories such as \ref from_integer intern the ireps they construct.
+class irep_hash_consingt
+{
+public:
+  static bool is_enabled()
+  {
+    return enabled;
+  }
+
+  static void enable()
+  {
+    enabled = true;
+  }
+
+  static irep_hash_consingt &instance();
+
+  /// Replace \p irep by the structurally identical irep held in the table,
+  /// adding it first if there is none.
+  void operator()(irept &irep)
+  {
+    merge_full_irep(irep);
+  }
+
+  /// Intern the types and values of all symbols in \p symbol_table.
+  void operator()(symbol_table_baset &symbol_table);
+
+  /// Number of irep nodes that were interned
+  std::size_t number_of_lookups() const
+  {
+    return merge_full_irep.number_of_lookups();
+  }
+
+  /// Number of distinct irep nodes held in the table
+  std::size_t size() const
+  {
+    return merge_full_irep.size();
+  }
+
+protected:
+  static bool enabled;
+  merge_full_irept merge_full_irep;
+};
+
+/// Intern \p irep if hash-consing has been enabled, do nothing otherwise.
+inline void hash_cons(irept &irep)
+{
+  if(irep_hash_consingt::is_enabled())
+    irep_hash_consingt::instance()(irep);
+}
+
+#endif // CPROVER_UTIL_IREP_HASH_CONSING_H
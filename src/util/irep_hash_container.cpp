@@ -13,6 +13,9 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "irep.h"
 #include "irep_hash.h"
+#include "optional.h"
+
+#include <algorithm>
 
 size_t irep_hash_container_baset::number(const irept &irep)
 {
@@ -23,25 +26,51 @@ size_t irep_hash_container_baset::number(const irept &irep)
   if(it!=ptr_hash.end())
     return it->second.number;
 
-  packedt packed;
-  pack(irep, packed);
-  size_t id=numbering.number(packed);
+  // Pack onto the end of the scratch stack; numbering the subtrees of irep
+  // pushes and pops their packed contents beyond this point.
+  const std::size_t begin = scratch.size();
+  pack(irep, scratch);
+  const std::size_t length = scratch.size() - begin;
+
+  std::size_t hash = length; // seed
+  for(std::size_t i = begin; i < scratch.size(); ++i)
+    hash = hash_combine(hash, scratch[i]);
+
+  optionalt<std::size_t> id;
+
+  const auto candidates = content_hash.equal_range(hash);
+  for(auto c_it = candidates.first; c_it != candidates.second; ++c_it)
+  {
+    const std::size_t offset = content_offsets[c_it->second];
+    const std::size_t end = c_it->second + 1 < content_offsets.size()
+                              ? content_offsets[c_it->second + 1]
+                              : contents.size();
+    if(
+      end - offset == length &&
+      std::equal(
+        scratch.begin() + begin, scratch.end(), contents.begin() + offset))
+    {
+      id = c_it->second;
+      break;
+    }
+  }
+
+  if(!id.has_value())
+  {
+    id = content_offsets.size();
+    content_offsets.push_back(contents.size());
+    contents.insert(contents.end(), scratch.begin() + begin, scratch.end());
+    content_hash.emplace(hash, *id);
+  }
+
+  scratch.resize(begin);
 
   ptr_hash.emplace(
     std::piecewise_construct,
     std::forward_as_tuple(&irep.read()),
-    std::forward_as_tuple(id, irep));
-
-  return id;
-}
+    std::forward_as_tuple(*id, irep));
 
-size_t irep_hash_container_baset::vector_hasht::operator()(
-  const packedt &p) const
-{
-  size_t result=p.size(); // seed
-  for(auto elem : p)
-    result=hash_combine(result, elem);
-  return result;
+  return *id;
 }
 
 void irep_hash_container_baset::pack(
@@ -61,8 +90,6 @@ void irep_hash_container_baset::pack(
 #else
     const std::size_t named_sub_size = named_sub.size();
 #endif
-    packed.reserve(1 + 1 + sub.size() + 1 + named_sub_size * 2);
-
     packed.push_back(irep_id_hash()(irep.id()));
 
     packed.push_back(sub.size());
@@ -83,8 +110,6 @@ void irep_hash_container_baset::pack(
 
     // we pack: the irep id, the sub size, the subs, the named-sub size, and
     // each of the non-comment named subs with their ids
-    packed.reserve(1 + 1 + sub.size() + 1 + non_comment_count * 2);
-
     packed.push_back(irep_id_hash()(irep.id()));
 
     packed.push_back(sub.size());
@@ -16,7 +16,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <vector>
 
 #include "irep.h"
-#include "numbering.h"
+
+#include <unordered_map>
 
 class irep_hash_container_baset
 {
@@ -29,7 +30,16 @@ public:
 
   void clear()
   {
-    numbering.clear();
+    ptr_hash.clear();
+    content_hash.clear();
+    contents.clear();
+    content_offsets.clear();
+  }
+
+  /// \return number of distinct ireps numbered so far
+  std::size_t size() const
+  {
+    return content_offsets.size();
   }
 
 protected:
@@ -61,19 +71,22 @@ protected:
     ptr_hasht;
   ptr_hasht ptr_hash;
 
-  // this is the second level: content
-
+  // This is the second level: content. The content of an irep is packed into
+  // its id and the numbers of its subtrees, so that comparing contents does
+  // not require traversing trees. The packed contents of all numbered ireps
+  // are stored back-to-back in a single vector, and are indexed by their
+  // hash, which is computed from the numbers of the subtrees.
   typedef std::vector<std::size_t> packedt;
 
-  struct vector_hasht
-  {
-    std::size_t operator()(const packedt &p) const;
-  };
+  packedt contents;
+  std::vector<std::size_t> content_offsets; // start in contents, per number
+  std::unordered_multimap<std::size_t, std::size_t> content_hash;
 
-  numberingt<packedt, vector_hasht> numbering;
+  // packed contents of the ireps currently being numbered; as numbering an
+  // irep numbers its subtrees first, this is used as a stack
+  packedt scratch;
 
   void pack(const irept &irep, packedt &);
-
   bool full;
 };
 
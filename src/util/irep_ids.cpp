@@ -51,10 +51,10 @@ enum class idt:unsigned
 
 #include "irep_ids.def" // NOLINT(build/include)
 
-string_containert::string_containert()
+string_containert::string_containert() : chunks(max_chunks)
 {
   // pre-allocate empty string -- this gets index 0
-  get("");
+  get(string_ptrt(""));
 
   // allocate strings
   for(unsigned i=0; irep_ids_table[i]!=nullptr; i++)
@@ -17,6 +17,7 @@ Date: May 2007
 #include <iostream>
 
 #include "exception_utils.h"
+#include "invariant.h"
 
 void irep_serializationt::write_irep(
   std::ostream &out,
@@ -58,6 +59,8 @@ const irept &irep_serializationt::reference_convert(std::istream &in)
       throw deserialization_exceptiont("irep id read twice.");
 
     ireps_container.ireps_on_read[id] = {true, std::move(irep)};
+    if(ireps_container.checkpoint)
+      ireps_container.ireps_log.push_back(id);
   }
 
   return ireps_container.ireps_on_read[id].second;
@@ -124,7 +127,43 @@ void irep_serializationt::reference_convert(
 
   write_gb_word(out, res.first->second);
   if(res.second)
+  {
+    if(ireps_container.checkpoint)
+      ireps_container.ireps_log.push_back(h);
     write_irep(out, irep);
+  }
+}
+
+void irep_serializationt::checkpoint()
+{
+  ireps_container.checkpoint = true;
+  ireps_container.ireps_log.clear();
+  ireps_container.strings_log.clear();
+}
+
+void irep_serializationt::restore_checkpoint()
+{
+  PRECONDITION(ireps_container.checkpoint);
+
+  // Ireps are logged by their id when read, and by their hash number when
+  // written. Erasing the latter makes the ids of the ireps written next
+  // start from where they started after the checkpoint once more.
+  for(const std::size_t irep : ireps_container.ireps_log)
+  {
+    if(irep < ireps_container.ireps_on_read.size())
+      ireps_container.ireps_on_read[irep] = {false, get_nil_irep()};
+    ireps_container.ireps_on_write.erase(irep);
+  }
+  ireps_container.ireps_log.clear();
+
+  for(const std::size_t string : ireps_container.strings_log)
+  {
+    if(string < ireps_container.string_map.size())
+      ireps_container.string_map[string] = false;
+    if(string < ireps_container.string_rev_map.size())
+      ireps_container.string_rev_map[string] = {false, irep_idt()};
+  }
+  ireps_container.strings_log.clear();
 }
 
 /// Write 7 bits of `u` each time, least-significant byte first, until we have
@@ -233,6 +272,8 @@ void irep_serializationt::write_string_ref(
   else
   {
     ireps_container.string_map[id]=true;
+    if(ireps_container.checkpoint)
+      ireps_container.strings_log.push_back(id);
     write_gb_word(out, id);
     write_gb_string(out, id2string(s));
   }
@@ -254,6 +295,8 @@ irep_idt irep_serializationt::read_string_ref(std::istream &in)
     irep_idt s=read_gb_string(in);
     ireps_container.string_rev_map[id]=
       std::pair<bool, irep_idt>(true, s);
+    if(ireps_container.checkpoint)
+      ireps_container.strings_log.push_back(id);
   }
 
   return ireps_container.string_rev_map[id].second;
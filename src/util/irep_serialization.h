@@ -44,6 +44,12 @@ public:
     typedef std::vector<std::pair<bool, irep_idt> > string_rev_mapt;
     string_rev_mapt string_rev_map;
 
+    /// True if the ireps and strings converted are logged below, to be
+    /// forgotten by \ref irep_serializationt::restore_checkpoint
+    bool checkpoint = false;
+    std::vector<std::size_t> ireps_log;
+    std::vector<std::size_t> strings_log;
+
     void clear()
     {
       irep_full_hash_container.clear();
@@ -51,6 +57,9 @@ public:
       ireps_on_read.clear();
       string_map.clear();
       string_rev_map.clear();
+      checkpoint = false;
+      ireps_log.clear();
+      strings_log.clear();
     }
   };
 
@@ -69,6 +78,17 @@ public:
 
   void clear() { ireps_container.clear(); }
 
+  /// Record the ireps and strings converted so far, such that
+  /// \ref restore_checkpoint forgets the ones converted later. Several parts
+  /// of a stream written after a checkpoint can thus refer to what precedes
+  /// them, but each of them can be read without reading the others, provided
+  /// that they are both written and read with the checkpoint restored after
+  /// each part.
+  void checkpoint();
+
+  /// Forget the ireps and strings converted since \ref checkpoint
+  void restore_checkpoint();
+
   static std::size_t read_gb_word(std::istream &);
   irep_idt read_gb_string(std::istream &);
 
@@ -0,0 +1,71 @@
+/*******************************************************************\
+
+Module: Statistics on allocation and copy-on-write of ireps
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Statistics on allocation and copy-on-write of ireps
+
+#include "irep_statistics.h"
+
+#ifdef IREP_STATS
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace
+{
+/// The counters of all scopes; a std::map, as counters must not move once
+/// handed out. This is never destroyed, as ireps with static storage
+/// duration may be destroyed after any other object.
+std::map<std::string, irep_counterst> &get_scopes()
+{
+  static auto scopes = new std::map<std::string, irep_counterst>;
+  return *scopes;
+}
+
+struct output_at_exitt
+{
+  ~output_at_exitt()
+  {
+    irep_statisticst::output(std::cerr);
+  }
+} output_at_exit;
+} // namespace
+
+irep_counterst *irep_statisticst::current = nullptr;
+
+irep_counterst &irep_statisticst::scope(const char *name)
+{
+  return get_scopes()[name];
+}
+
+irep_counterst &irep_statisticst::other()
+{
+  static irep_counterst &other = scope("other");
+  return other;
+}
+
+void irep_statisticst::output(std::ostream &out)
+{
+  out << "irep statistics:\n";
+  out << std::setw(32) << std::left << "scope" << std::right << std::setw(14)
+      << "allocations" << std::setw(14) << "deallocations" << std::setw(14)
+      << "detaches" << std::setw(18) << "detached subtrees" << '\n';
+
+  for(const auto &entry : get_scopes())
+  {
+    const irep_counterst &counters = entry.second;
+    out << std::setw(32) << std::left << entry.first << std::right
+        << std::setw(14) << counters.allocations << std::setw(14)
+        << counters.deallocations << std::setw(14) << counters.detaches
+        << std::setw(18) << counters.detached_subtrees << '\n';
+  }
+}
+
+#endif // IREP_STATS
@@ -0,0 +1,98 @@
+/*******************************************************************\
+
+Module: Statistics on allocation and copy-on-write of ireps
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Statistics on allocation and copy-on-write of ireps
+///
+/// When compiled with `IREP_STATS`, the tree nodes of ireps count how many
+/// nodes are allocated, how many shared nodes are copied as they are written
+/// to (see sharing_treet::detach), and how many subtrees these copies share
+/// with the original. The counts are attributed to the innermost active
+/// irep_statistics_scopet, such as the one of each phase_profile_scopet, and
+/// a profile is written to the standard error stream at exit. Without
+/// `IREP_STATS`, scopes have no effect.
+
+#ifndef CPROVER_UTIL_IREP_STATISTICS_H
+#define CPROVER_UTIL_IREP_STATISTICS_H
+
+#include <cstddef>
+#include <iosfwd>
+
+/// Counts of operations on irep tree nodes
+struct irep_counterst
+{
+  /// tree nodes created
+  std::size_t allocations = 0;
+  /// tree nodes destroyed
+  std::size_t deallocations = 0;
+  /// shared tree nodes copied in order to be written to
+  std::size_t detaches = 0;
+  /// subtrees of the nodes copied by a detach, which have thus become shared
+  std::size_t detached_subtrees = 0;
+};
+
+#ifdef IREP_STATS
+
+class irep_statisticst
+{
+public:
+  /// Counters of the innermost active scope, if any
+  static irep_counterst *current;
+
+  /// \return the counters of the innermost active scope
+  static irep_counterst &counters()
+  {
+    return current != nullptr ? *current : other();
+  }
+
+  /// \return the counters for the scope with the given name
+  static irep_counterst &scope(const char *name);
+
+  /// \return the counters for operations outside any scope
+  static irep_counterst &other();
+
+  /// Write a profile of all scopes
+  static void output(std::ostream &);
+};
+
+/// Attribute the operations on ireps to the scope \p name while this object
+/// is alive
+class irep_statistics_scopet
+{
+public:
+  explicit irep_statistics_scopet(const char *name)
+    : previous(irep_statisticst::current)
+  {
+    irep_statisticst::current = &irep_statisticst::scope(name);
+  }
+
+  irep_statistics_scopet(const irep_statistics_scopet &) = delete;
+  irep_statistics_scopet &operator=(const irep_statistics_scopet &) = delete;
+
+  ~irep_statistics_scopet()
+  {
+    irep_statisticst::current = previous;
+  }
+
+private:
+  irep_counterst *previous;
+};
+
+#else
+
+class irep_statistics_scopet
+{
+public:
+  explicit irep_statistics_scopet(const char *)
+  {
+  }
+};
+
+#endif // IREP_STATS
+
+#endif // CPROVER_UTIL_IREP_STATISTICS_H
@@ -0,0 +1,184 @@
+/*******************************************************************\
+
+Module: Compact Binary Encoding of JSON Values
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Compact Binary Encoding of JSON Values
+
+#include "json_binary.h"
+
+#include "exception_utils.h"
+#include "irep_serialization.h"
+#include "json.h"
+
+#include <istream>
+#include <ostream>
+
+enum json_binary_tagt : int
+{
+  JB_NULL = 0,
+  JB_TRUE = 1,
+  JB_FALSE = 2,
+  JB_WORD = 3, // a number that is a non-negative integer
+  JB_NUMBER = 4,
+  JB_STRING = 5,
+  JB_ARRAY = 6,
+  JB_OBJECT = 7
+};
+
+/// \return true if \p number is the canonical decimal representation of a
+///   value that fits into a std::size_t
+static bool is_word(const std::string &number)
+{
+  if(number.empty() || number.size() > 18)
+    return false;
+
+  if(number[0] == '0' && number.size() > 1)
+    return false;
+
+  for(const char ch : number)
+  {
+    if(ch < '0' || ch > '9')
+      return false;
+  }
+
+  return true;
+}
+
+void binary_json_writert::write_string(const std::string &s)
+{
+  const auto entry = strings.emplace(s, strings.size());
+  write_gb_word(out, entry.first->second);
+
+  // a new string follows its index
+  if(entry.second)
+  {
+    write_gb_word(out, s.size());
+    out.write(s.data(), s.size());
+  }
+}
+
+void binary_json_writert::write(const jsont &json)
+{
+  if(json.is_null())
+    out.put(JB_NULL);
+  else if(json.is_true())
+    out.put(JB_TRUE);
+  else if(json.is_false())
+    out.put(JB_FALSE);
+  else if(json.is_number())
+  {
+    if(is_word(json.value))
+    {
+      out.put(JB_WORD);
+      write_gb_word(out, std::stoull(json.value));
+    }
+    else
+    {
+      out.put(JB_NUMBER);
+      write_string(json.value);
+    }
+  }
+  else if(json.is_string())
+  {
+    out.put(JB_STRING);
+    write_string(json.value);
+  }
+  else if(json.is_array())
+  {
+    const json_arrayt &array = to_json_array(json);
+    out.put(JB_ARRAY);
+    write_gb_word(out, array.size());
+    for(const auto &element : array)
+      write(element);
+  }
+  else
+  {
+    const json_objectt &object = to_json_object(json);
+    out.put(JB_OBJECT);
+    write_gb_word(out, object.size());
+    for(const auto &entry : object)
+    {
+      write_string(entry.first);
+      write(entry.second);
+    }
+  }
+}
+
+std::size_t binary_json_readert::read_word()
+{
+  return irep_serializationt::read_gb_word(in);
+}
+
+const std::string &binary_json_readert::read_string()
+{
+  const std::size_t index = read_word();
+
+  if(index < strings.size())
+    return strings[index];
+  else if(index > strings.size())
+    throw deserialization_exceptiont("string index out of range");
+
+  const std::size_t size = read_word();
+  std::string s(size, '\0');
+  if(size != 0 && !in.read(&s[0], size))
+    throw deserialization_exceptiont("unexpected end of input stream");
+
+  strings.push_back(std::move(s));
+  return strings.back();
+}
+
+jsont binary_json_readert::read_value(int tag)
+{
+  switch(tag)
+  {
+  case JB_NULL:
+    return json_nullt();
+  case JB_TRUE:
+    return json_truet();
+  case JB_FALSE:
+    return json_falset();
+  case JB_WORD:
+    return json_numbert(std::to_string(read_word()));
+  case JB_NUMBER:
+    return json_numbert(read_string());
+  case JB_STRING:
+    return json_stringt(read_string());
+  case JB_ARRAY:
+  {
+    json_arrayt array;
+    for(std::size_t size = read_word(); size != 0; --size)
+      array.push_back(read_value(in.get()));
+    return std::move(array);
+  }
+  case JB_OBJECT:
+  {
+    json_objectt object;
+    for(std::size_t size = read_word(); size != 0; --size)
+    {
+      const std::string key = read_string();
+      object[key] = read_value(in.get());
+    }
+    return std::move(object);
+  }
+  }
+
+  if(in.eof())
+    throw deserialization_exceptiont("unexpected end of input stream");
+  else
+    throw deserialization_exceptiont("unknown JSON value tag");
+}
+
+bool binary_json_readert::read(jsont &dest)
+{
+  const int tag = in.get();
+  if(tag == std::istream::traits_type::eof())
+    return false;
+
+  dest = read_value(tag);
+  return true;
+}
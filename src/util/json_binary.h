@@ -0,0 +1,67 @@
+/*******************************************************************\
+
+Module: Compact Binary Encoding of JSON Values
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Compact Binary Encoding of JSON Values
+
+#ifndef CPROVER_UTIL_JSON_BINARY_H
+#define CPROVER_UTIL_JSON_BINARY_H
+
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class jsont;
+
+/// Writes a sequence of JSON values in a compact binary encoding: each
+/// value is a tag byte followed by its contents, numbers that are
+/// non-negative integers are variable-length words, and each string, be it
+/// a key or a value, is written in full only the first time and referred to
+/// by its index afterwards. The strings are shared by all values written to
+/// the same stream, which makes repeated keys, file and function names
+/// almost free.
+class binary_json_writert
+{
+public:
+  explicit binary_json_writert(std::ostream &out) : out(out)
+  {
+  }
+
+  void write(const jsont &);
+
+protected:
+  std::ostream &out;
+  std::unordered_map<std::string, std::size_t> strings;
+
+  void write_string(const std::string &);
+};
+
+/// Reads the values written by \ref binary_json_writert
+class binary_json_readert
+{
+public:
+  explicit binary_json_readert(std::istream &in) : in(in)
+  {
+  }
+
+  /// Read the next value into \p dest
+  /// \return false if the end of the input has been reached
+  /// \throws deserialization_exceptiont if the input is malformed
+  bool read(jsont &dest);
+
+protected:
+  std::istream &in;
+  std::vector<std::string> strings;
+
+  jsont read_value(int tag);
+  std::size_t read_word();
+  const std::string &read_string();
+};
+
+#endif // CPROVER_UTIL_JSON_BINARY_H
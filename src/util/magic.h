@@ -20,4 +20,57 @@ constexpr std::size_t DSTRING_NUMBERS_MAX = 64;
 /// Necessary because large constant arrays slow-down the process.
 constexpr std::size_t DEFAULT_MAX_FIELD_SENSITIVITY_ARRAY_SIZE = 64;
 
+/// Default number of expressions for which symex memoizes the result of
+/// simplification.
+constexpr std::size_t DEFAULT_SYMEX_SIMPLIFY_CACHE_SIZE = 1 << 16;
+
+/// Default number of compound expressions for which symex memoizes the result
+/// of level-2 renaming.
+constexpr std::size_t DEFAULT_SYMEX_RENAME_CACHE_SIZE = 1 << 16;
+
+/// Number of pointers for which symex memoizes the result of value-set
+/// dereferencing when caching dereferences.
+constexpr std::size_t SYMEX_DEREFERENCE_CACHE_SIZE = 1 << 14;
+
+/// Bounds for variable elimination in CNF simplification: the number of
+/// clauses a variable may occur in and the size of the resolvents.
+constexpr std::size_t CNF_ELIMINATION_MAX_OCCURRENCES = 16;
+constexpr std::size_t CNF_ELIMINATION_MAX_RESOLVENT_SIZE = 20;
+
+/// Literals that occur in more clauses are not used to find clauses that are
+/// subsumed in CNF simplification.
+constexpr std::size_t CNF_SUBSUMPTION_MAX_OCCURRENCES = 1000;
+
+/// The number of candidates for splitting variables that are tried by
+/// look-ahead when splitting a SAT problem into cubes.
+constexpr std::size_t SAT_LOOK_AHEAD_CANDIDATES = 256;
+
+/// Size of the buffers for the communication with a child process via pipes.
+constexpr std::size_t PIPE_BUFFER_SIZE = 1 << 16;
+
+/// Size of the chunks in which SMT2 problems are written to files.
+constexpr std::size_t SMT2_OUTPUT_BUFFER_SIZE = 1 << 20;
+
+/// Size of the chunks in which SMT2 input is read for tokenizing.
+constexpr std::size_t SMT2_TOKENIZER_BUFFER_SIZE = 1 << 16;
+
+/// Largest bound on the length of nondet strings for which the string solver
+/// instantiates the universal string axioms for all characters at once.
+constexpr std::size_t STRING_REFINEMENT_MAX_EAGER_LENGTH = 16;
+
+/// Largest number of atoms of the guards of symbolic execution that are
+/// merged using BDDs rather than by building a disjunction.
+constexpr std::size_t GUARD_MAX_BDD_ATOMS = 32;
+
+/// Number of entries of the cache of Boolean operations on miniBDD BDDs.
+constexpr std::size_t MINI_BDD_CACHE_SIZE = 1 << 14;
+
+/// Number of times a property is tried with a budget of conflicts with
+/// `--property-conflict-budget` before it is decided without a limit.
+constexpr std::size_t PROPERTY_BUDGET_MAX_ATTEMPTS = 15;
+
+/// Largest number of transformers applied to recompute an abstract state
+/// that the sparse abstract interpreter does not store.
+constexpr std::size_t AI_SPARSE_MAX_PATH_LENGTH = 32;
+
 #endif
@@ -18,6 +18,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <malloc.h>
 #endif
 
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
 #ifdef _WIN32
 #include <util/pragma_push.def>
 #ifdef _MSC_VER
@@ -31,6 +36,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/pragma_pop.def>
 #endif
 
+#include <fstream>
 #include <ostream>
 
 void memory_info(std::ostream &out)
@@ -72,3 +78,57 @@ void memory_info(std::ostream &out)
       << static_cast<double>(t.size_allocated)/1000000 << "m\n";
 #endif
 }
+
+std::size_t current_rss()
+{
+#if defined(__linux__)
+  // the second field is the number of resident pages
+  std::ifstream statm("/proc/self/statm");
+  std::size_t size, resident;
+  if(statm >> size >> resident)
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  return 0;
+#elif defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS pmc;
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    return pmc.WorkingSetSize;
+  return 0;
+#elif defined(__APPLE__)
+  // NOLINTNEXTLINE(readability/identifiers)
+  struct task_basic_info t_info;
+  mach_msg_type_number_t t_info_count = TASK_BASIC_INFO_COUNT;
+  if(
+    task_info(
+      current_task(), TASK_BASIC_INFO, (task_info_t)&t_info, &t_info_count) !=
+    KERN_SUCCESS)
+  {
+    return 0;
+  }
+  return t_info.resident_size;
+#else
+  return 0;
+#endif
+}
+
+std::size_t peak_rss()
+{
+#if defined(__linux__) || defined(__APPLE__)
+  // NOLINTNEXTLINE(readability/identifiers)
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#  ifdef __APPLE__
+  return static_cast<std::size_t>(usage.ru_maxrss);
+#  else
+  // in kilobytes
+  return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#  endif
+#elif defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS pmc;
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    return pmc.PeakWorkingSetSize;
+  return 0;
+#else
+  return 0;
+#endif
+}
@@ -10,8 +10,16 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_UTIL_MEMORY_INFO_H
 #define CPROVER_UTIL_MEMORY_INFO_H
 
+#include <cstddef>
 #include <iosfwd>
 
 void memory_info(std::ostream &);
 
+/// \return the resident set size of the process in bytes, or 0 if unknown
+std::size_t current_rss();
+
+/// \return the largest resident set size of the process so far in bytes, or
+///   0 if unknown
+std::size_t peak_rss();
+
 #endif // CPROVER_UTIL_MEMORY_INFO_H
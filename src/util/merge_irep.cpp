@@ -196,6 +196,8 @@ void merge_full_irept::operator()(irept &irep)
 
 const irept &merge_full_irept::merged(const irept &irep)
 {
+  ++lookups;
+
   irep_storet::const_iterator entry=irep_store.find(irep);
   if(entry!=irep_store.end())
     return *entry;
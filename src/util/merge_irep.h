@@ -119,9 +119,28 @@ class merge_full_irept
 public:
   void operator()(irept &);
 
+  /// Number of distinct ireps held
+  std::size_t size() const
+  {
+    return irep_store.size();
+  }
+
+  /// Number of irep nodes looked up so far, whether or not a structurally
+  /// identical irep was already held
+  std::size_t number_of_lookups() const
+  {
+    return lookups;
+  }
+
+  void clear()
+  {
+    irep_store.clear();
+  }
+
 protected:
   typedef std::unordered_set<irept, irep_full_hash, irep_full_eq> irep_storet;
   irep_storet irep_store;
+  std::size_t lookups = 0;
 
   const irept &merged(const irept &irep);
 };
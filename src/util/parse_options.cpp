@@ -24,7 +24,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "config.h"
 #include "exception_utils.h"
 #include "exit_codes.h"
+#include "json_stream.h"
+#include "phase_profile.h"
 #include "signal_catcher.h"
+#include "simplify_expr_class.h"
 #include "string_utils.h"
 #include "version.h"
 
@@ -52,6 +55,43 @@ void parse_options_baset::usage_error()
   help();
 }
 
+void parse_options_baset::output_profile()
+{
+  json_objectt profile = phase_profilert::to_json();
+
+  if(ui_message_handler.get_ui() == ui_message_handlert::uit::JSON_UI)
+  {
+    json_objectt json{{"profile", std::move(profile)}};
+    ui_message_handler.get_json_stream().push_back(std::move(json));
+  }
+  else
+    log.status() << "Profile: " << profile << messaget::eom;
+}
+
+void parse_options_baset::output_simplifier_statistics()
+{
+  json_arrayt statistics = simplify_exprt::get_rule_statistics();
+
+  if(ui_message_handler.get_ui() == ui_message_handlert::uit::JSON_UI)
+  {
+    json_objectt json{{"simplifierStatistics", std::move(statistics)}};
+    ui_message_handler.get_json_stream().push_back(std::move(json));
+    return;
+  }
+
+  log.status() << "Simplifier rules:";
+  for(const auto &rule : statistics)
+  {
+    const json_objectt &object = to_json_object(rule);
+    log.status() << '\n'
+                 << "  " << object["rule"].value << ": "
+                 << object["calls"].value << " calls, "
+                 << object["rewrites"].value << " rewrites, "
+                 << object["seconds"].value << "s";
+  }
+  log.status() << messaget::eom;
+}
+
 /// Print an error message mentioning the option that was not recognized when
 /// parsing the command line.
 void parse_options_baset::unknown_option_msg()
@@ -97,7 +137,19 @@ int parse_options_baset::main()
     // install signal catcher
     install_signal_catcher();
 
-    return doit();
+    if(cmdline.isset("profile-json"))
+      phase_profilert::enable();
+    if(cmdline.isset("simplifier-stats"))
+      simplify_exprt::enable_rule_statistics();
+
+    const int exit_code = doit();
+
+    if(phase_profilert::is_enabled())
+      output_profile();
+    if(simplify_exprt::is_rule_statistics_enabled())
+      output_simplifier_statistics();
+
+    return exit_code;
   }
 
   // CPROVER style exceptions in order of decreasing happiness
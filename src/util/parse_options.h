@@ -47,6 +47,14 @@ protected:
 
 private:
   void unknown_option_msg();
+
+  /// Report the profile of the phases of the run recorded with
+  /// `--profile-json`, on the JSON UI stream when using it
+  void output_profile();
+
+  /// Report the statistics of the simplifier rules recorded with
+  /// `--simplifier-stats`, on the JSON UI stream when using it
+  void output_simplifier_statistics();
 };
 
 std::string
@@ -9,6 +9,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "parser.h"
 
+#include <istream>
+
 #ifdef _WIN32
 int isatty(int)
 {
@@ -16,6 +18,19 @@ int isatty(int)
 }
 #endif
 
+bool parsert::fill_buffer()
+{
+  // any characters left over from another stream are dropped
+  buffered_in=in;
+  buffer_pos=buffer_end=0;
+
+  buffer.resize(1 << 16);
+  in->read(buffer.data(), buffer.size());
+  buffer_end=static_cast<std::size_t>(in->gcount());
+
+  return buffer_end!=0;
+}
+
 exprt &_newstack(parsert &parser, unsigned &x)
 {
   x=(unsigned)parser.stack.size();
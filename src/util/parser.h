@@ -37,6 +37,8 @@ public:
     stack.clear();
     source_location.clear();
     last_line.clear();
+    buffered_in=nullptr;
+    buffer_pos=buffer_end=0;
   }
 
   parsert():in(nullptr) { clear(); }
@@ -46,8 +48,15 @@ public:
 
   bool read(char &ch)
   {
-    if(!in->read(&ch, 1))
-      return false;
+    // the input is read in blocks, as reading single characters from a
+    // stream is slow
+    if(buffer_pos==buffer_end || in!=buffered_in)
+    {
+      if(!fill_buffer())
+        return false;
+    }
+
+    ch=buffer[buffer_pos++];
 
     if(ch=='\n')
     {
@@ -64,7 +73,7 @@ public:
 
   bool eof()
   {
-    return in->eof();
+    return (buffer_pos==buffer_end || in!=buffered_in) && in->eof();
   }
 
   void parse_error(
@@ -135,6 +144,16 @@ protected:
   source_locationt source_location;
   unsigned line_no, previous_line_no;
   unsigned column;
+
+private:
+  /// The stream the characters in the buffer were read from
+  std::istream *buffered_in;
+  std::vector<char> buffer;
+  std::size_t buffer_pos, buffer_end;
+
+  /// Replace the contents of the buffer by the next block of input
+  /// \return false when there is no more input
+  bool fill_buffer();
 };
 
 exprt &_newstack(parsert &parser, unsigned &x);
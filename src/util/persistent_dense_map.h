@@ -0,0 +1,504 @@
+/*******************************************************************\
+
+Module: Persistent map with dense integer keys
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Persistent map with dense integer keys
+
+#ifndef CPROVER_UTIL_PERSISTENT_DENSE_MAP_H
+#define CPROVER_UTIL_PERSISTENT_DENSE_MAP_H
+
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <util/dense_integer_map.h>
+#include <util/invariant.h>
+#include <util/optional.h>
+
+/// A map whose keys are mapped onto integers by KeyToDenseInteger, as in
+/// \ref dense_integer_mapt, stored as a persistent vector: a tree of nodes
+/// with 32 slots each, indexed by successive groups of five bits of the
+/// integer, whose leaves hold the key-value pairs. The nodes are shared
+/// between copies of the map, so that a copy takes constant time, and are
+/// copied on the path to a change only. Unlike \ref dense_integer_mapt, the
+/// keys need not be known in advance, and only the slots in use take memory.
+/// A lookup follows as many nodes as there are groups of five bits in the
+/// largest integer in the map.
+///
+/// The interface follows the part of \ref sharing_mapt that is needed to
+/// use the map as a renaming map in symbolic execution: keys are inserted
+/// with \ref insert only if they are not yet in the map, and \ref replace and
+/// \ref erase require the key to be in the map.
+template <class K, class V, class KeyToDenseInteger = identity_functort>
+class persistent_dense_mapt
+{
+public:
+  typedef K key_type;
+  typedef V mapped_type;
+
+  persistent_dense_mapt() = default;
+
+  persistent_dense_mapt(const persistent_dense_mapt &other)
+    : root(other.root), height(other.height), count(other.count)
+  {
+    if(root != nullptr)
+      ++root->ref_count;
+  }
+
+  persistent_dense_mapt(persistent_dense_mapt &&other) noexcept
+    : root(other.root), height(other.height), count(other.count)
+  {
+    other.root = nullptr;
+    other.height = 0;
+    other.count = 0;
+  }
+
+  persistent_dense_mapt &operator=(persistent_dense_mapt other) noexcept
+  {
+    swap(other);
+    return *this;
+  }
+
+  ~persistent_dense_mapt()
+  {
+    release(root);
+  }
+
+  void swap(persistent_dense_mapt &other) noexcept
+  {
+    std::swap(root, other.root);
+    std::swap(height, other.height);
+    std::swap(count, other.count);
+  }
+
+  std::size_t size() const
+  {
+    return count;
+  }
+
+  bool empty() const
+  {
+    return count == 0;
+  }
+
+  void clear()
+  {
+    release(root);
+    root = nullptr;
+    height = 0;
+    count = 0;
+  }
+
+  optionalt<std::reference_wrapper<const mapped_type>>
+  find(const key_type &k) const
+  {
+    const std::size_t index = KeyToDenseInteger{}(k);
+    if(root == nullptr || (index >> (bits * height)) >= width)
+      return {};
+
+    const nodet *node = root;
+    for(std::size_t level = height; level > 0; --level)
+    {
+      const std::size_t slot = (index >> (bits * level)) & mask;
+      if(!node->has_slot(slot))
+        return {};
+      node = node->children[node->position(slot)];
+    }
+
+    const std::size_t slot = index & mask;
+    if(!node->has_slot(slot))
+      return {};
+    return std::cref(node->entries[node->position(slot)].second);
+  }
+
+  bool has_key(const key_type &k) const
+  {
+    return find(k).has_value();
+  }
+
+  /// Insert \p m for \p k, which must not be in the map yet
+  template <class valueU>
+  void insert(const key_type &k, valueU &&m)
+  {
+    const std::size_t index = KeyToDenseInteger{}(k);
+
+    // grow the tree until the index fits in, keeping the nodes so far as
+    // the first child of each new root
+    if(root == nullptr)
+    {
+      root = new nodet();
+      height = 0;
+    }
+    while((index >> (bits * height)) >= width)
+    {
+      nodet *new_root = new nodet();
+      if(!root->empty())
+      {
+        new_root->bitmap = 1;
+        new_root->children.push_back(root);
+      }
+      else
+        release(root);
+      root = new_root;
+      ++height;
+    }
+
+    nodet *node = writeable(root);
+    for(std::size_t level = height; level > 0; --level)
+    {
+      const std::size_t slot = (index >> (bits * level)) & mask;
+      const std::size_t position = node->position(slot);
+      if(!node->has_slot(slot))
+      {
+        node->bitmap |= std::uint32_t(1) << slot;
+        node->children.insert(
+          node->children.begin() + position, new nodet());
+      }
+      node = writeable(node->children[position]);
+    }
+
+    const std::size_t slot = index & mask;
+    PRECONDITION(!node->has_slot(slot));
+    node->bitmap |= std::uint32_t(1) << slot;
+    node->entries.emplace(
+      node->entries.begin() + node->position(slot),
+      k,
+      std::forward<valueU>(m));
+    ++count;
+  }
+
+  /// Replace the value of \p k, which must be in the map, by \p m
+  template <class valueU>
+  void replace(const key_type &k, valueU &&m)
+  {
+    writeable_entry(k).second = std::forward<valueU>(m);
+  }
+
+  /// Apply \p mutator to the value of \p k, which must be in the map
+  void update(const key_type &k, std::function<void(mapped_type &)> mutator)
+  {
+    mutator(writeable_entry(k).second);
+  }
+
+  /// Erase \p k, which must be in the map
+  void erase(const key_type &k)
+  {
+    PRECONDITION(has_key(k));
+    erase_rec(root, KeyToDenseInteger{}(k), height);
+    --count;
+
+    if(root->empty())
+      clear();
+  }
+
+  void erase_if_exists(const key_type &k)
+  {
+    if(has_key(k))
+      erase(k);
+  }
+
+  typedef std::pair<const key_type &, const mapped_type &> view_itemt;
+
+  /// View of the key-value pairs in the map, in the order of their integers
+  typedef std::vector<view_itemt> viewt;
+
+  void get_view(viewt &view) const
+  {
+    iterate(root, [&view](const key_type &k, const mapped_type &m) {
+      view.push_back(view_itemt(k, m));
+    });
+  }
+
+  class delta_view_itemt
+  {
+  public:
+    delta_view_itemt(
+      const key_type &k,
+      const mapped_type &m,
+      const mapped_type &other_m)
+      : k(k), m(m), other_m(&other_m)
+    {
+    }
+
+    delta_view_itemt(const key_type &k, const mapped_type &m)
+      : k(k), m(m), other_m(nullptr)
+    {
+    }
+
+    const key_type &k;
+    const mapped_type &m;
+
+    bool is_in_both_maps() const
+    {
+      return other_m != nullptr;
+    }
+
+    const mapped_type &get_other_map_value() const
+    {
+      PRECONDITION(is_in_both_maps());
+      return *other_m;
+    }
+
+  private:
+    const mapped_type *other_m;
+  };
+
+  typedef std::vector<delta_view_itemt> delta_viewt;
+
+  /// Get the key-value pairs of the map whose key is not in \p other or
+  /// whose value differs from the one in \p other, in \p delta_view, and
+  /// those of \p other whose key is not in the map, in \p other_delta_view.
+  /// Nodes shared between the maps are skipped without looking into them.
+  void get_symmetric_delta_view(
+    const persistent_dense_mapt &other,
+    delta_viewt &delta_view,
+    delta_viewt &other_delta_view) const
+  {
+    const nodet *node = root;
+    const nodet *other_node = other.root;
+
+    // the nodes of the smaller tree are the first children of the larger
+    for(std::size_t level = height; level > other.height; --level)
+      node = first_child_and_gather_rest(node, level, delta_view);
+    for(std::size_t level = other.height; level > height; --level)
+    {
+      other_node =
+        first_child_and_gather_rest(other_node, level, other_delta_view);
+    }
+
+    delta_rec(
+      node,
+      other_node,
+      std::min(height, other.height),
+      delta_view,
+      other_delta_view);
+  }
+
+private:
+  static const std::size_t bits = 5;
+  static const std::size_t width = std::size_t(1) << bits;
+  static const std::size_t mask = width - 1;
+
+  /// A node of the tree: an inner node with a child for each used slot, or
+  /// a leaf with a key-value pair for each used slot, in the order of the
+  /// slots
+  struct nodet
+  {
+    std::size_t ref_count = 1;
+    std::uint32_t bitmap = 0;
+    std::vector<nodet *> children;
+    std::vector<std::pair<key_type, mapped_type>> entries;
+
+    bool has_slot(std::size_t slot) const
+    {
+      return (bitmap & (std::uint32_t(1) << slot)) != 0;
+    }
+
+    /// \return the position among the children or entries at which the one
+    ///   for \p slot is, or would be
+    std::size_t position(std::size_t slot) const
+    {
+      return std::bitset<width>(bitmap & ((std::uint32_t(1) << slot) - 1))
+        .count();
+    }
+
+    bool empty() const
+    {
+      return bitmap == 0;
+    }
+  };
+
+  nodet *root = nullptr;
+
+  /// Number of levels of inner nodes above the leaves
+  std::size_t height = 0;
+
+  std::size_t count = 0;
+
+  static void release(nodet *node)
+  {
+    if(node == nullptr || --node->ref_count != 0)
+      return;
+
+    for(nodet *child : node->children)
+      release(child);
+    delete node;
+  }
+
+  /// Make \p node a node of this map only, copying it if it is shared
+  /// \return \p node
+  static nodet *writeable(nodet *&node)
+  {
+    if(node->ref_count != 1)
+    {
+      nodet *copy = new nodet(*node);
+      copy->ref_count = 1;
+      for(nodet *child : copy->children)
+        ++child->ref_count;
+      --node->ref_count;
+      node = copy;
+    }
+
+    return node;
+  }
+
+  std::pair<key_type, mapped_type> &writeable_entry(const key_type &k)
+  {
+    PRECONDITION(has_key(k));
+    const std::size_t index = KeyToDenseInteger{}(k);
+
+    nodet *node = writeable(root);
+    for(std::size_t level = height; level > 0; --level)
+    {
+      const std::size_t slot = (index >> (bits * level)) & mask;
+      node = writeable(node->children[node->position(slot)]);
+    }
+
+    return node->entries[node->position(index & mask)];
+  }
+
+  static void erase_rec(nodet *&node, std::size_t index, std::size_t level)
+  {
+    nodet *writeable_node = writeable(node);
+    const std::size_t slot = (index >> (bits * level)) & mask;
+    const std::size_t position = writeable_node->position(slot);
+
+    if(level == 0)
+      writeable_node->entries.erase(writeable_node->entries.begin() + position);
+    else
+    {
+      nodet *&child = writeable_node->children[position];
+      erase_rec(child, index, level - 1);
+      if(!child->empty())
+        return;
+      release(child);
+      writeable_node->children.erase(
+        writeable_node->children.begin() + position);
+    }
+
+    writeable_node->bitmap &= ~(std::uint32_t(1) << slot);
+  }
+
+  static void iterate(
+    const nodet *node,
+    const std::function<void(const key_type &, const mapped_type &)> &f)
+  {
+    if(node == nullptr)
+      return;
+
+    for(const nodet *child : node->children)
+      iterate(child, f);
+    for(const auto &entry : node->entries)
+      f(entry.first, entry.second);
+  }
+
+  static void gather_all(const nodet *node, delta_viewt &delta_view)
+  {
+    iterate(node, [&delta_view](const key_type &k, const mapped_type &m) {
+      delta_view.push_back(delta_view_itemt(k, m));
+    });
+  }
+
+  /// Add the key-value pairs below the children of \p node other than the
+  /// one for slot 0 to \p delta_view
+  /// \return the child for slot 0, or nullptr if there is none
+  static const nodet *first_child_and_gather_rest(
+    const nodet *node,
+    std::size_t level,
+    delta_viewt &delta_view)
+  {
+    PRECONDITION(level > 0);
+    if(node == nullptr)
+      return nullptr;
+
+    const nodet *first = nullptr;
+    for(std::size_t slot = 0, position = 0; slot < width; ++slot)
+    {
+      if(!node->has_slot(slot))
+        continue;
+      if(slot == 0)
+        first = node->children[position];
+      else
+        gather_all(node->children[position], delta_view);
+      ++position;
+    }
+
+    return first;
+  }
+
+  static void delta_rec(
+    const nodet *node,
+    const nodet *other_node,
+    std::size_t level,
+    delta_viewt &delta_view,
+    delta_viewt &other_delta_view)
+  {
+    if(node == other_node)
+      return;
+
+    if(node == nullptr)
+    {
+      gather_all(other_node, other_delta_view);
+      return;
+    }
+
+    if(other_node == nullptr)
+    {
+      gather_all(node, delta_view);
+      return;
+    }
+
+    std::size_t position = 0;
+    std::size_t other_position = 0;
+    for(std::size_t slot = 0; slot < width; ++slot)
+    {
+      const bool in_node = node->has_slot(slot);
+      const bool in_other_node = other_node->has_slot(slot);
+
+      if(level > 0)
+      {
+        delta_rec(
+          in_node ? node->children[position] : nullptr,
+          in_other_node ? other_node->children[other_position] : nullptr,
+          level - 1,
+          delta_view,
+          other_delta_view);
+      }
+      else if(in_node && in_other_node)
+      {
+        const auto &entry = node->entries[position];
+        const auto &other_entry = other_node->entries[other_position];
+        if(!(entry.second == other_entry.second))
+        {
+          delta_view.push_back(
+            delta_view_itemt(entry.first, entry.second, other_entry.second));
+        }
+      }
+      else if(in_node)
+      {
+        const auto &entry = node->entries[position];
+        delta_view.push_back(delta_view_itemt(entry.first, entry.second));
+      }
+      else if(in_other_node)
+      {
+        const auto &entry = other_node->entries[other_position];
+        other_delta_view.push_back(
+          delta_view_itemt(entry.first, entry.second));
+      }
+
+      if(in_node)
+        ++position;
+      if(in_other_node)
+        ++other_position;
+    }
+  }
+};
+
+#endif // CPROVER_UTIL_PERSISTENT_DENSE_MAP_H
@@ -0,0 +1,144 @@
+/*******************************************************************\
+
+Module: Timing and Memory Profile of the Phases of a Run
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Timing and Memory Profile of the Phases of a Run
+
+#include "phase_profile.h"
+
+#include "invariant.h"
+#include "memory_info.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct phaset
+{
+  std::string name;
+  std::size_t calls = 0;
+  std::chrono::steady_clock::duration time{0};
+  std::chrono::steady_clock::time_point start;
+  std::size_t rss_on_entry = 0;
+  std::size_t rss_on_exit = 0;
+  std::size_t peak_rss_on_exit = 0;
+  std::vector<std::size_t> children;
+};
+
+/// All phases, the first being the run; indices rather than pointers, as
+/// the vector grows
+std::vector<phaset> phases;
+
+/// The indices of the active phases, the innermost last
+std::vector<std::size_t> active_phases;
+
+void start(phaset &phase)
+{
+  ++phase.calls;
+  phase.start = std::chrono::steady_clock::now();
+  if(phase.calls == 1)
+    phase.rss_on_entry = current_rss();
+}
+
+json_objectt phase_to_json(std::size_t index)
+{
+  const phaset &phase = phases[index];
+
+  bool active = false;
+  for(const auto active_index : active_phases)
+    active = active || active_index == index;
+
+  auto time = phase.time;
+  std::size_t rss_on_exit = phase.rss_on_exit;
+  std::size_t peak_rss_on_exit = phase.peak_rss_on_exit;
+  if(active)
+  {
+    time += std::chrono::steady_clock::now() - phase.start;
+    rss_on_exit = current_rss();
+    peak_rss_on_exit = peak_rss();
+  }
+
+  json_objectt result{
+    {"name", json_stringt{phase.name}},
+    {"calls", json_numbert{std::to_string(phase.calls)}},
+    {"seconds",
+     json_numbert{std::to_string(
+       std::chrono::duration<double>(time).count())}},
+    {"rssOnEntry", json_numbert{std::to_string(phase.rss_on_entry)}},
+    {"rssOnExit", json_numbert{std::to_string(rss_on_exit)}},
+    {"peakRss", json_numbert{std::to_string(peak_rss_on_exit)}}};
+
+  if(!phase.children.empty())
+  {
+    json_arrayt children;
+    for(const auto child : phase.children)
+      children.push_back(phase_to_json(child));
+    result["phases"] = std::move(children);
+  }
+
+  return result;
+}
+} // namespace
+
+bool phase_profilert::enabled = false;
+
+void phase_profilert::enable()
+{
+  if(enabled)
+    return;
+
+  enabled = true;
+  phases.emplace_back();
+  phases.back().name = "run";
+  start(phases.back());
+  active_phases.push_back(0);
+}
+
+void phase_profilert::enter(const char *name)
+{
+  PRECONDITION(enabled && !active_phases.empty());
+
+  const std::size_t parent = active_phases.back();
+
+  std::size_t index = phases.size();
+  for(const auto child : phases[parent].children)
+  {
+    if(phases[child].name == name)
+      index = child;
+  }
+
+  if(index == phases.size())
+  {
+    phases.emplace_back();
+    phases.back().name = name;
+    phases[parent].children.push_back(index);
+  }
+
+  start(phases[index]);
+  active_phases.push_back(index);
+}
+
+void phase_profilert::leave()
+{
+  // the run is never left
+  PRECONDITION(enabled && active_phases.size() > 1);
+
+  phaset &phase = phases[active_phases.back()];
+  phase.time += std::chrono::steady_clock::now() - phase.start;
+  phase.rss_on_exit = current_rss();
+  phase.peak_rss_on_exit = peak_rss();
+  active_phases.pop_back();
+}
+
+json_objectt phase_profilert::to_json()
+{
+  PRECONDITION(enabled);
+  return phase_to_json(0);
+}
@@ -0,0 +1,77 @@
+/*******************************************************************\
+
+Module: Timing and Memory Profile of the Phases of a Run
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Timing and Memory Profile of the Phases of a Run
+///
+/// Once enabled (see `--profile-json`), each phase_profile_scopet records the
+/// time spent in it and the resident set size of the process when entering
+/// and leaving it. Scopes nest: a scope is a child of the innermost active
+/// one, and repeated scopes of the same name under the same parent, e.g.
+/// the solver calls of an incremental check, are merged. When not enabled,
+/// scopes cost a test of a flag. Each scope also attributes the operations
+/// on ireps within it to the phase (see irep_statistics.h).
+
+#ifndef CPROVER_UTIL_PHASE_PROFILE_H
+#define CPROVER_UTIL_PHASE_PROFILE_H
+
+#include "irep_statistics.h"
+#include "json.h"
+
+class phase_profilert
+{
+public:
+  /// Start profiling, with the whole run as the outermost phase
+  static void enable();
+
+  static bool is_enabled()
+  {
+    return enabled;
+  }
+
+  /// Enter the phase \p name within the current phase
+  static void enter(const char *name);
+
+  /// Leave the current phase
+  static void leave();
+
+  /// \return the profile of the phases so far, where those still active,
+  ///   in particular the run, are timed until now
+  static json_objectt to_json();
+
+private:
+  static bool enabled;
+};
+
+/// Profile the phase \p name while this object is alive, and count the
+/// operations on ireps within it
+class phase_profile_scopet
+{
+public:
+  explicit phase_profile_scopet(const char *name)
+    : active(phase_profilert::is_enabled()), irep_statistics_scope(name)
+  {
+    if(active)
+      phase_profilert::enter(name);
+  }
+
+  phase_profile_scopet(const phase_profile_scopet &) = delete;
+  phase_profile_scopet &operator=(const phase_profile_scopet &) = delete;
+
+  ~phase_profile_scopet()
+  {
+    if(active)
+      phase_profilert::leave();
+  }
+
+private:
+  bool active;
+  irep_statistics_scopet irep_statistics_scope;
+};
+
+#endif // CPROVER_UTIL_PHASE_PROFILE_H
@@ -0,0 +1,227 @@
+/*******************************************************************\
+
+Module: Communication with a Child Process via Pipes
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Communication with a Child Process via Pipes
+
+#include "piped_process.h"
+
+#ifndef _WIN32
+#  include <cerrno>
+#  include <cstdio>
+#  include <cstring>
+
+#  include <fcntl.h>
+#  include <signal.h>
+#  include <unistd.h>
+
+#  include "signal_catcher.h"
+#endif
+
+#include "invariant.h"
+#include "magic.h"
+
+piped_processt::fd_streambuft::fd_streambuft() : buffer(PIPE_BUFFER_SIZE)
+{
+  setg(buffer.data(), buffer.data(), buffer.data());
+  setp(buffer.data(), buffer.data() + buffer.size());
+}
+
+piped_processt::fd_streambuft::~fd_streambuft()
+{
+  close();
+}
+
+void piped_processt::fd_streambuft::open(int _fd)
+{
+  fd = _fd;
+}
+
+void piped_processt::fd_streambuft::close()
+{
+#ifndef _WIN32
+  if(fd == -1)
+    return;
+
+  sync();
+  ::close(fd);
+  fd = -1;
+#endif
+}
+
+piped_processt::fd_streambuft::int_type
+piped_processt::fd_streambuft::underflow()
+{
+#ifndef _WIN32
+  if(gptr() < egptr())
+    return traits_type::to_int_type(*gptr());
+
+  if(fd == -1)
+    return traits_type::eof();
+
+  ssize_t count;
+  do
+    count = read(fd, buffer.data(), buffer.size());
+  while(count == -1 && errno == EINTR);
+
+  if(count <= 0)
+    return traits_type::eof();
+
+  setg(buffer.data(), buffer.data(), buffer.data() + count);
+  return traits_type::to_int_type(*gptr());
+#else
+  return traits_type::eof();
+#endif
+}
+
+piped_processt::fd_streambuft::int_type
+piped_processt::fd_streambuft::overflow(int_type c)
+{
+  if(sync() == -1)
+    return traits_type::eof();
+
+  if(!traits_type::eq_int_type(c, traits_type::eof()))
+  {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+
+  return traits_type::not_eof(c);
+}
+
+#ifndef _WIN32
+/// Write to \p fd with SIGPIPE blocked, such that writing to a child that
+/// has terminated fails with EPIPE instead of terminating this process
+static ssize_t write_without_sigpipe(int fd, const char *data, std::size_t size)
+{
+  sigset_t sigpipe_set, old_set, pending_set;
+  sigemptyset(&sigpipe_set);
+  sigaddset(&sigpipe_set, SIGPIPE);
+
+  sigpending(&pending_set);
+  const bool was_pending = sigismember(&pending_set, SIGPIPE);
+
+  sigprocmask(SIG_BLOCK, &sigpipe_set, &old_set);
+
+  const ssize_t count = write(fd, data, size);
+  const int write_errno = errno;
+
+  // discard the SIGPIPE that the write raised before unblocking it again
+  if(count == -1 && write_errno == EPIPE && !was_pending)
+  {
+    sigpending(&pending_set);
+    int signal_number;
+    if(sigismember(&pending_set, SIGPIPE))
+      sigwait(&sigpipe_set, &signal_number);
+  }
+
+  sigprocmask(SIG_SETMASK, &old_set, nullptr);
+
+  errno = write_errno;
+  return count;
+}
+#endif
+
+int piped_processt::fd_streambuft::sync()
+{
+#ifndef _WIN32
+  const char *data = pbase();
+  std::size_t size = pptr() - pbase();
+
+  while(size > 0)
+  {
+    if(fd == -1)
+      return -1;
+
+    const ssize_t count = write_without_sigpipe(fd, data, size);
+    if(count == -1)
+    {
+      if(errno == EINTR)
+        continue;
+      return -1;
+    }
+
+    data += count;
+    size -= count;
+  }
+
+  setp(buffer.data(), buffer.data() + buffer.size());
+  return 0;
+#else
+  return -1;
+#endif
+}
+
+piped_processt::piped_processt(const std::vector<std::string> &argv)
+  : to_child(&to_child_buffer), from_child(&from_child_buffer)
+{
+  PRECONDITION(!argv.empty());
+
+#ifdef _WIN32
+  UNIMPLEMENTED_FEATURE("communication with a child process via pipes");
+#else
+  int input_pipe[2], output_pipe[2];
+  if(pipe(input_pipe) == -1)
+    return;
+  if(pipe(output_pipe) == -1)
+  {
+    ::close(input_pipe[0]);
+    ::close(input_pipe[1]);
+    return;
+  }
+
+  // processes started later must not hold the ends of this process, lest
+  // the child never see the end of its input
+  fcntl(input_pipe[1], F_SETFD, FD_CLOEXEC);
+  fcntl(output_pipe[0], F_SETFD, FD_CLOEXEC);
+
+  const bool failed = process.start(0, [&]() {
+    remove_signal_catcher();
+
+    dup2(input_pipe[0], STDIN_FILENO);
+    dup2(output_pipe[1], STDOUT_FILENO);
+    ::close(input_pipe[0]);
+    ::close(output_pipe[1]);
+
+    std::vector<char *> _argv(argv.size() + 1);
+    for(std::size_t i = 0; i < argv.size(); i++)
+      _argv[i] = strdup(argv[i].c_str());
+    _argv[argv.size()] = nullptr;
+
+    execvp(argv.front().c_str(), _argv.data());
+
+    // usually no return
+    perror(std::string("execvp " + argv.front() + " failed").c_str());
+    return 1;
+  });
+
+  ::close(input_pipe[0]);
+  ::close(output_pipe[1]);
+
+  if(failed)
+  {
+    ::close(input_pipe[1]);
+    ::close(output_pipe[0]);
+    return;
+  }
+
+  to_child_buffer.open(input_pipe[1]);
+  from_child_buffer.open(output_pipe[0]);
+#endif
+}
+
+piped_processt::~piped_processt()
+{
+#ifndef _WIN32
+  to_child_buffer.close();
+  from_child_buffer.close();
+
+  // the child is expected to terminate now that its input is closed
+  process.wait_for_any();
+#endif
+}
@@ -0,0 +1,88 @@
+/*******************************************************************\
+
+Module: Communication with a Child Process via Pipes
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Communication with a Child Process via Pipes
+
+#ifndef CPROVER_UTIL_PIPED_PROCESS_H
+#define CPROVER_UTIL_PIPED_PROCESS_H
+
+#include "process_pool.h"
+
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/// A child process whose standard input and standard output are connected
+/// to the parent by pipes, for the interactive use of a tool such as an SMT
+/// solver, which then is started only once. Standard error is inherited.
+/// The standard input of the child process is closed upon destruction,
+/// upon which the child is expected to terminate.
+class piped_processt
+{
+public:
+  /// Start the executable \p argv[0], which is searched for in the PATH,
+  /// with arguments \p argv
+  explicit piped_processt(const std::vector<std::string> &argv);
+
+  piped_processt(const piped_processt &) = delete;
+  piped_processt &operator=(const piped_processt &) = delete;
+
+  ~piped_processt();
+
+  /// \return false if the child process could not be created; failing to
+  ///   run the executable instead shows as the end of \ref output
+  bool is_running() const
+  {
+    return process.running() != 0;
+  }
+
+  /// The standard input of the child process, which is written to the pipe
+  /// when flushed
+  std::ostream &input()
+  {
+    return to_child;
+  }
+
+  /// The standard output of the child process; reading blocks until the
+  /// child has written enough or terminated
+  std::istream &output()
+  {
+    return from_child;
+  }
+
+protected:
+  /// A stream buffer that reads from or writes to a file descriptor
+  class fd_streambuft : public std::streambuf
+  {
+  public:
+    fd_streambuft();
+    ~fd_streambuft() override;
+
+    /// Read from or write to \p _fd, which is closed upon destruction
+    void open(int _fd);
+    void close();
+
+  protected:
+    int fd = -1;
+    std::vector<char> buffer;
+
+    int_type underflow() override;
+    int_type overflow(int_type c) override;
+    int sync() override;
+  };
+
+  process_poolt process;
+  fd_streambuft to_child_buffer, from_child_buffer;
+  std::ostream to_child;
+  std::istream from_child;
+};
+
+#endif // CPROVER_UTIL_PIPED_PROCESS_H
@@ -21,6 +21,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "ssa_expr.h"
 #include "std_expr.h"
 
+#include <unordered_map>
+
 optionalt<mp_integer> member_offset(
   const struct_typet &type,
   const irep_idt &member,
@@ -97,12 +99,47 @@ pointer_offset_size(const typet &type, const namespacet &ns)
     return {};
 }
 
+/// The sizes of the struct and union tags seen during one call of
+/// pointer_offset_bits, as the symbol table cannot change in between
+typedef std::unordered_map<irep_idt, optionalt<mp_integer>> tag_sizest;
+
+static optionalt<mp_integer> pointer_offset_bits_rec(
+  const typet &type,
+  const namespacet &ns,
+  tag_sizest &tag_sizes);
+
+/// \return the size of the type the tag \p tag stands for, computed once per
+///   tag
+static optionalt<mp_integer> tag_size(
+  const tag_typet &tag,
+  const typet &followed,
+  const namespacet &ns,
+  tag_sizest &tag_sizes)
+{
+  auto entry = tag_sizes.find(tag.get_identifier());
+  if(entry != tag_sizes.end())
+    return entry->second;
+
+  auto size = pointer_offset_bits_rec(followed, ns, tag_sizes);
+  tag_sizes.emplace(tag.get_identifier(), size);
+  return size;
+}
+
 optionalt<mp_integer>
 pointer_offset_bits(const typet &type, const namespacet &ns)
+{
+  tag_sizest tag_sizes;
+  return pointer_offset_bits_rec(type, ns, tag_sizes);
+}
+
+static optionalt<mp_integer> pointer_offset_bits_rec(
+  const typet &type,
+  const namespacet &ns,
+  tag_sizest &tag_sizes)
 {
   if(type.id()==ID_array)
   {
-    auto sub = pointer_offset_bits(to_array_type(type).subtype(), ns);
+    auto sub = pointer_offset_bits_rec(to_array_type(type).subtype(), ns, tag_sizes);
     if(!sub.has_value())
       return {};
 
@@ -115,7 +152,7 @@ pointer_offset_bits(const typet &type, const namespacet &ns)
   }
   else if(type.id()==ID_vector)
   {
-    auto sub = pointer_offset_bits(to_vector_type(type).subtype(), ns);
+    auto sub = pointer_offset_bits_rec(to_vector_type(type).subtype(), ns, tag_sizes);
     if(!sub.has_value())
       return {};
 
@@ -127,7 +164,7 @@ pointer_offset_bits(const typet &type, const namespacet &ns)
   }
   else if(type.id()==ID_complex)
   {
-    auto sub = pointer_offset_bits(to_complex_type(type).subtype(), ns);
+    auto sub = pointer_offset_bits_rec(to_complex_type(type).subtype(), ns, tag_sizes);
 
     if(sub.has_value())
       return (*sub) * 2;
@@ -142,7 +179,7 @@ pointer_offset_bits(const typet &type, const namespacet &ns)
     for(const auto &c : struct_type.components())
     {
       const typet &subtype = c.type();
-      auto sub_size = pointer_offset_bits(subtype, ns);
+      auto sub_size = pointer_offset_bits_rec(subtype, ns, tag_sizes);
 
       if(!sub_size.has_value())
         return {};
@@ -182,7 +219,7 @@ pointer_offset_bits(const typet &type, const namespacet &ns)
   }
   else if(type.id()==ID_c_enum_tag)
   {
-    return pointer_offset_bits(ns.follow_tag(to_c_enum_tag_type(type)), ns);
+    return pointer_offset_bits_rec(ns.follow_tag(to_c_enum_tag_type(type)), ns, tag_sizes);
   }
   else if(type.id()==ID_bool)
   {
@@ -198,11 +235,13 @@ pointer_offset_bits(const typet &type, const namespacet &ns)
   }
   else if(type.id() == ID_union_tag)
   {
-    return pointer_offset_bits(ns.follow_tag(to_union_tag_type(type)), ns);
+    const union_tag_typet &union_tag = to_union_tag_type(type);
+    return tag_size(union_tag, ns.follow_tag(union_tag), ns, tag_sizes);
   }
   else if(type.id() == ID_struct_tag)
   {
-    return pointer_offset_bits(ns.follow_tag(to_struct_tag_type(type)), ns);
+    const struct_tag_typet &struct_tag = to_struct_tag_type(type);
+    return tag_size(struct_tag, ns.follow_tag(struct_tag), ns, tag_sizes);
   }
   else if(type.id()==ID_code)
   {
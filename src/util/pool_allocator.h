@@ -0,0 +1,172 @@
+/*******************************************************************\
+
+Module: Size-class pool allocation for small, frequently allocated objects
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Size-class pool allocation for small, frequently allocated objects
+
+#ifndef CPROVER_UTIL_POOL_ALLOCATOR_H
+#define CPROVER_UTIL_POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+/// A pool handing out memory blocks of a single size. Memory is obtained from
+/// the system in slabs of many blocks, and freed blocks are kept on a free
+/// list for re-use rather than being returned to the system. All slabs are
+/// released at once when the pool is destroyed.
+///
+/// The pool is not thread-safe, just like the reference counting of
+/// \ref irept.
+class fixed_size_poolt
+{
+public:
+  /// \param block_size: size of each block handed out, in bytes
+  /// \param blocks_per_slab: number of blocks obtained from the system at once
+  fixed_size_poolt(std::size_t block_size, std::size_t blocks_per_slab)
+    : block_size(round_up(block_size)), blocks_per_slab(blocks_per_slab)
+  {
+  }
+
+  fixed_size_poolt(const fixed_size_poolt &) = delete;
+  fixed_size_poolt &operator=(const fixed_size_poolt &) = delete;
+
+  ~fixed_size_poolt()
+  {
+    for(char *slab : slabs)
+      ::operator delete(slab);
+  }
+
+  void *allocate()
+  {
+    ++blocks_in_use;
+
+    if(free_list != nullptr)
+    {
+      free_blockt *block = free_list;
+      free_list = block->next;
+      return block;
+    }
+
+    if(next_in_slab == end_of_slab)
+    {
+      char *slab =
+        static_cast<char *>(::operator new(block_size * blocks_per_slab));
+      slabs.push_back(slab);
+      next_in_slab = slab;
+      end_of_slab = slab + block_size * blocks_per_slab;
+    }
+
+    void *result = next_in_slab;
+    next_in_slab += block_size;
+    return result;
+  }
+
+  void deallocate(void *p)
+  {
+    --blocks_in_use;
+    free_blockt *block = static_cast<free_blockt *>(p);
+    block->next = free_list;
+    free_list = block;
+  }
+
+  std::size_t get_block_size() const
+  {
+    return block_size;
+  }
+
+  std::size_t number_of_slabs() const
+  {
+    return slabs.size();
+  }
+
+  std::size_t get_blocks_in_use() const
+  {
+    return blocks_in_use;
+  }
+
+protected:
+  struct free_blockt
+  {
+    free_blockt *next;
+  };
+
+  static std::size_t round_up(std::size_t size)
+  {
+    const std::size_t alignment = alignof(std::max_align_t);
+    if(size < sizeof(free_blockt))
+      size = sizeof(free_blockt);
+    return (size + alignment - 1) / alignment * alignment;
+  }
+
+  const std::size_t block_size;
+  const std::size_t blocks_per_slab;
+  std::vector<char *> slabs;
+  free_blockt *free_list = nullptr;
+  char *next_in_slab = nullptr;
+  char *end_of_slab = nullptr;
+  std::size_t blocks_in_use = 0;
+};
+
+/// Return the process-wide pool for blocks of \p size bytes. The pool is
+/// intentionally never destroyed: objects with static storage duration may
+/// release blocks after all other static objects have been destroyed. Its
+/// slabs are reclaimed in bulk when the process terminates.
+template <std::size_t size>
+fixed_size_poolt &size_class_pool()
+{
+  static fixed_size_poolt *pool = new fixed_size_poolt(size, 4096);
+  return *pool;
+}
+
+/// Standard-library compatible allocator that takes single objects from the
+/// pool for their size class, and falls back to `operator new` for arrays.
+template <typename T>
+class pool_allocatort
+{
+public:
+  using value_type = T;
+
+  pool_allocatort() = default;
+
+  template <typename U>
+  // NOLINTNEXTLINE(runtime/explicit)
+  pool_allocatort(const pool_allocatort<U> &)
+  {
+  }
+
+  T *allocate(std::size_t n)
+  {
+    if(n == 1)
+      return static_cast<T *>(size_class_pool<sizeof(T)>().allocate());
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *p, std::size_t n)
+  {
+    if(n == 1)
+      size_class_pool<sizeof(T)>().deallocate(p);
+    else
+      ::operator delete(p);
+  }
+
+  template <typename U>
+  bool operator==(const pool_allocatort<U> &) const
+  {
+    return true;
+  }
+
+  template <typename U>
+  bool operator!=(const pool_allocatort<U> &) const
+  {
+    return false;
+  }
+};
+
+#endif // CPROVER_UTIL_POOL_ALLOCATOR_H
@@ -0,0 +1,171 @@
+/*******************************************************************\
+
+Module: Running Functions in Forked Processes
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Running Functions in Forked Processes
+
+#include "process_pool.h"
+
+#include "exit_codes.h"
+
+#ifndef _WIN32
+#  include <cerrno>
+#  include <csignal>
+#  include <iostream>
+#  include <vector>
+
+#  include <fcntl.h>
+#  include <poll.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+process_poolt::~process_poolt()
+{
+#ifndef _WIN32
+  for(const auto &process : processes)
+  {
+    kill(process.own_process_group ? -process.pid : process.pid, SIGKILL);
+    close(process.fd);
+    while(waitpid(process.pid, nullptr, 0) < 0 && errno == EINTR)
+    {
+    }
+  }
+#endif
+}
+
+bool process_poolt::start(
+  std::size_t id,
+  std::function<int()> run,
+  bool capture_output,
+  bool own_process_group)
+{
+#ifdef _WIN32
+  (void)id;                // unused parameter
+  (void)run;               // unused parameter
+  (void)capture_output;    // unused parameter
+  (void)own_process_group; // unused parameter
+
+  return true;
+#else
+  int fds[2];
+  if(pipe(fds) != 0)
+    return true;
+
+  // processes started later must not hold the read end
+  fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+
+  // the process must not write output buffered by this one once more
+  std::cout.flush();
+  std::cerr.flush();
+
+  const pid_t pid = fork();
+
+  if(pid < 0)
+  {
+    close(fds[0]);
+    close(fds[1]);
+    return true;
+  }
+
+  if(pid == 0)
+  {
+    if(own_process_group)
+      setpgid(0, 0);
+
+    close(fds[0]);
+
+    if(capture_output)
+    {
+      dup2(fds[1], STDOUT_FILENO);
+      close(fds[1]);
+    }
+
+    int exit_code;
+    try
+    {
+      exit_code = run();
+    }
+    catch(...)
+    {
+      exit_code = CPROVER_EXIT_EXCEPTION;
+    }
+
+    std::cout.flush();
+
+    // skip destructors and exit handlers, which belong to the parent process
+    _exit(exit_code);
+  }
+
+  // set it here as well, lest the group be killed before the child has
+  if(own_process_group)
+    setpgid(pid, pid);
+
+  close(fds[1]);
+  processes.push_back({id, pid, fds[0], own_process_group, std::string()});
+  return false;
+#endif
+}
+
+optionalt<process_poolt::finishedt> process_poolt::wait_for_any()
+{
+#ifndef _WIN32
+  while(!processes.empty())
+  {
+    std::vector<pollfd> pollfds;
+    for(const auto &process : processes)
+      pollfds.push_back({process.fd, POLLIN, 0});
+
+    while(poll(pollfds.data(), pollfds.size(), -1) < 0)
+    {
+      if(errno != EINTR)
+        return {};
+    }
+
+    auto process_it = processes.begin();
+    for(const auto &pollfd : pollfds)
+    {
+      processt &process = *process_it;
+
+      if(pollfd.revents == 0)
+      {
+        ++process_it;
+        continue;
+      }
+
+      char buffer[4096];
+      const ssize_t n = read(process.fd, buffer, sizeof(buffer));
+      if(n > 0 || (n < 0 && errno == EINTR))
+      {
+        if(n > 0)
+          process.output.append(buffer, static_cast<std::size_t>(n));
+        ++process_it;
+        continue;
+      }
+
+      // the process and all the ones it started have closed the pipe
+      close(process.fd);
+
+      int status = 0;
+      pid_t waited;
+      while((waited = waitpid(process.pid, &status, 0)) < 0 && errno == EINTR)
+      {
+      }
+
+      finishedt finished{process.id, {}, std::move(process.output)};
+      if(waited == process.pid && WIFEXITED(status))
+        finished.exit_code = WEXITSTATUS(status);
+
+      processes.erase(process_it);
+      return std::move(finished);
+    }
+  }
+#endif
+
+  return {};
+}
@@ -0,0 +1,97 @@
+/*******************************************************************\
+
+Module: Running Functions in Forked Processes
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Running Functions in Forked Processes
+
+#ifndef CPROVER_UTIL_PROCESS_POOL_H
+#define CPROVER_UTIL_PROCESS_POOL_H
+
+#include "optional.h"
+
+#include <functional>
+#include <list>
+#include <string>
+
+/// Processes forked from this one, each running a function on its own copy
+/// of the objects of this process, as ireps cannot be shared between threads.
+/// Each process is connected to this one by a pipe, which it and the
+/// processes that it starts hold until they terminate, and which can capture
+/// its standard output. A process has finished once all of them have. The
+/// processes that are still running upon destruction are killed. Processes
+/// cannot be forked on Windows, where \ref start always fails.
+class process_poolt
+{
+public:
+  process_poolt() = default;
+
+  process_poolt(const process_poolt &) = delete;
+  process_poolt &operator=(const process_poolt &) = delete;
+
+  /// Kills the processes that have not finished
+  ~process_poolt();
+
+  /// Start a process that runs \p run and exits with the exit code that it
+  /// returns, or CPROVER_EXIT_EXCEPTION if it throws. \p run may replace the
+  /// process by another program instead. Destructors and exit handlers are
+  /// not run in the process, as they belong to this one.
+  /// \param id: the identifier of the process, which \ref wait_for_any
+  ///   returns, such as the index of the task that the process performs
+  /// \param run: the function to run
+  /// \param capture_output: connect the standard output of the process to
+  ///   the pipe, to be returned by \ref wait_for_any; otherwise the standard
+  ///   output is inherited
+  /// \param own_process_group: make the process the leader of a process
+  ///   group of its own, so that the processes that it starts in turn, such
+  ///   as those of a shell command, are killed together with it
+  /// \return true if the process could not be started
+  bool start(
+    std::size_t id,
+    std::function<int()> run,
+    bool capture_output = false,
+    bool own_process_group = false);
+
+  struct finishedt
+  {
+    /// The identifier given to \ref start
+    std::size_t id;
+
+    /// The exit code of the process, no value if it was killed by a signal
+    optionalt<int> exit_code;
+
+    /// The standard output of the process, if captured
+    std::string output;
+  };
+
+  /// Wait for any of the running processes to finish, and collect the output
+  /// of all of them meanwhile
+  /// \return the process that finished; no value if no process is running,
+  ///   or if waiting failed
+  optionalt<finishedt> wait_for_any();
+
+  /// \return the number of processes that have been started, but not
+  ///   returned by \ref wait_for_any
+  std::size_t running() const
+  {
+    return processes.size();
+  }
+
+protected:
+  struct processt
+  {
+    std::size_t id;
+    int pid;
+    int fd;
+    bool own_process_group;
+    std::string output;
+  };
+
+  std::list<processt> processes;
+};
+
+#endif // CPROVER_UTIL_PROCESS_POOL_H
@@ -249,6 +249,98 @@ std::string get_last_error_as_string()
 }
 #endif
 
+#ifndef _WIN32
+/// Start \p what with the given file descriptors as its standard input,
+/// output and error, closing \p close_in_child, if not -1, in the child
+/// \return the process id of the child, or -1 if fork failed
+static pid_t start_child(
+  const std::string &what,
+  const std::vector<std::string> &argv,
+  int stdin_fd,
+  int stdout_fd,
+  int stderr_fd,
+  int close_in_child)
+{
+  // temporarily suspend all signals
+  sigset_t new_mask, old_mask;
+  sigemptyset(&new_mask);
+  sigprocmask(SIG_SETMASK, &new_mask, &old_mask);
+
+  /* now create new process */
+  pid_t childpid = fork();
+
+  if(childpid==0) /* fork() returns 0 to the child process */
+  {
+    // resume signals
+    remove_signal_catcher();
+    sigprocmask(SIG_SETMASK, &old_mask, nullptr);
+
+    std::vector<char *> _argv(argv.size()+1);
+    for(std::size_t i=0; i<argv.size(); i++)
+      _argv[i]=strdup(argv[i].c_str());
+
+    _argv[argv.size()]=nullptr;
+
+    if(close_in_child != -1)
+      close(close_in_child);
+
+    if(stdin_fd!=STDIN_FILENO)
+      dup2(stdin_fd, STDIN_FILENO);
+    if(stdout_fd!=STDOUT_FILENO)
+      dup2(stdout_fd, STDOUT_FILENO);
+    if(stderr_fd != STDERR_FILENO)
+      dup2(stderr_fd, STDERR_FILENO);
+
+    errno=0;
+    execvp(what.c_str(), _argv.data());
+
+    /* usually no return */
+    perror(std::string("execvp "+what+" failed").c_str());
+    exit(1);
+  }
+
+  // must do before resuming signals to avoid race
+  if(childpid > 0)
+    register_child(childpid);
+
+  // resume signals
+  sigprocmask(SIG_SETMASK, &old_mask, nullptr);
+
+  return childpid;
+}
+
+/// Wait for a child started by start_child to exit
+/// \return its exit status, or 1 if waiting failed
+static int wait_for_child(pid_t childpid)
+{
+  int status;     /* parent process: child's exit status */
+
+  /* wait for child to exit, and store its status */
+  while(waitpid(childpid, &status, 0)==-1)
+  {
+    if(errno==EINTR)
+      continue; // try again
+    else
+    {
+      unregister_child();
+
+      perror("Waiting for child process failed");
+      return 1;
+    }
+  }
+
+  unregister_child();
+
+  return WEXITSTATUS(status);
+}
+
+static void close_redirection(int fd, int std_fd)
+{
+  if(fd != std_fd)
+    close(fd);
+}
+#endif
+
 int run(
   const std::string &what,
   const std::vector<std::string> &argv,
@@ -352,98 +444,16 @@ int run(
   if(stdin_fd == -1 || stdout_fd == -1 || stderr_fd == -1)
     return 1;
 
-  // temporarily suspend all signals
-  sigset_t new_mask, old_mask;
-  sigemptyset(&new_mask);
-  sigprocmask(SIG_SETMASK, &new_mask, &old_mask);
-
-  /* now create new process */
-  pid_t childpid = fork();
-
-  if(childpid>=0) /* fork succeeded */
-  {
-    if(childpid==0) /* fork() returns 0 to the child process */
-    {
-      // resume signals
-      remove_signal_catcher();
-      sigprocmask(SIG_SETMASK, &old_mask, nullptr);
-
-      std::vector<char *> _argv(argv.size()+1);
-      for(std::size_t i=0; i<argv.size(); i++)
-        _argv[i]=strdup(argv[i].c_str());
-
-      _argv[argv.size()]=nullptr;
-
-      if(stdin_fd!=STDIN_FILENO)
-        dup2(stdin_fd, STDIN_FILENO);
-      if(stdout_fd!=STDOUT_FILENO)
-        dup2(stdout_fd, STDOUT_FILENO);
-      if(stderr_fd != STDERR_FILENO)
-        dup2(stderr_fd, STDERR_FILENO);
-
-      errno=0;
-      execvp(what.c_str(), _argv.data());
-
-      /* usually no return */
-      perror(std::string("execvp "+what+" failed").c_str());
-      exit(1);
-    }
-    else /* fork() returns new pid to the parent process */
-    {
-      // must do before resuming signals to avoid race
-      register_child(childpid);
-
-      // resume signals
-      sigprocmask(SIG_SETMASK, &old_mask, nullptr);
+  const pid_t childpid =
+    start_child(what, argv, stdin_fd, stdout_fd, stderr_fd, -1);
 
-      int status;     /* parent process: child's exit status */
+  const int result = childpid == -1 ? 1 : wait_for_child(childpid);
 
-      /* wait for child to exit, and store its status */
-      while(waitpid(childpid, &status, 0)==-1)
-      {
-        if(errno==EINTR)
-          continue; // try again
-        else
-        {
-          unregister_child();
-
-          perror("Waiting for child process failed");
-          if(stdin_fd!=STDIN_FILENO)
-            close(stdin_fd);
-          if(stdout_fd!=STDOUT_FILENO)
-            close(stdout_fd);
-          if(stderr_fd != STDERR_FILENO)
-            close(stderr_fd);
-          return 1;
-        }
-      }
-
-      unregister_child();
+  close_redirection(stdin_fd, STDIN_FILENO);
+  close_redirection(stdout_fd, STDOUT_FILENO);
+  close_redirection(stderr_fd, STDERR_FILENO);
 
-      if(stdin_fd!=STDIN_FILENO)
-        close(stdin_fd);
-      if(stdout_fd!=STDOUT_FILENO)
-        close(stdout_fd);
-      if(stderr_fd != STDERR_FILENO)
-        close(stderr_fd);
-
-      return WEXITSTATUS(status);
-    }
-  }
-  else /* fork returns -1 on failure */
-  {
-    // resume signals
-    sigprocmask(SIG_SETMASK, &old_mask, nullptr);
-
-    if(stdin_fd!=STDIN_FILENO)
-      close(stdin_fd);
-    if(stdout_fd!=STDOUT_FILENO)
-      close(stdout_fd);
-    if(stderr_fd != STDERR_FILENO)
-      close(stderr_fd);
-
-    return 1;
-  }
+  return result;
 #endif
 }
 
@@ -540,39 +550,53 @@ int run(
 
   return result;
   #else
-  std::string command;
+  // the output is read through a pipe, without a shell in between
+  int pipe_fds[2];
+  if(pipe(pipe_fds) == -1)
+    return -1;
 
-  bool first = true;
+  int stdin_fd = stdio_redirection(STDIN_FILENO, std_input);
+  int stderr_fd = stdio_redirection(STDERR_FILENO, std_error);
 
-  // note we use 'what' instead of 'argv[0]' as the name of the executable
-  for(const auto &arg : argv)
-  {
-    if(first) // this is argv[0]
-    {
-      command += shell_quote(what);
-      first = false;
-    }
-    else
-      command += " " + shell_quote(arg);
-  }
+  int result = -1;
 
-  if(!std_input.empty())
-    command += " < " + shell_quote(std_input);
+  if(stdin_fd != -1 && stderr_fd != -1)
+  {
+    const pid_t childpid =
+      start_child(what, argv, stdin_fd, pipe_fds[1], stderr_fd, pipe_fds[0]);
 
-  if(!std_error.empty())
-    command += " 2> " + shell_quote(std_error);
+    // the child has its own copy of the write end
+    close(pipe_fds[1]);
+    pipe_fds[1] = -1;
 
-  FILE *stream=popen(command.c_str(), "r");
+    if(childpid != -1)
+    {
+      char buffer[4096];
 
-  if(stream!=nullptr)
-  {
-    int ch;
-    while((ch=fgetc(stream))!=EOF)
-      std_output << (unsigned char)ch;
+      while(true)
+      {
+        const ssize_t size = read(pipe_fds[0], buffer, sizeof(buffer));
+
+        if(size == 0)
+          break;
+        else if(size > 0)
+          std_output.write(buffer, size);
+        else if(errno != EINTR)
+          break;
+      }
 
-    return pclose(stream);
+      result = wait_for_child(childpid);
+    }
   }
-  else
-    return -1;
+
+  close(pipe_fds[0]);
+  if(pipe_fds[1] != -1)
+    close(pipe_fds[1]);
+  if(stdin_fd != -1)
+    close_redirection(stdin_fd, STDIN_FILENO);
+  if(stderr_fd != -1)
+    close_redirection(stderr_fd, STDERR_FILENO);
+
+  return result;
   #endif
 }
@@ -325,6 +325,54 @@ public:
   ///   unsure if you need to make a change, use \ref find beforehand)
   void update(const key_type &k, std::function<void(mapped_type &)> mutator);
 
+  /// Insert the key-value pairs in the range [\p begin, \p end); the keys
+  /// must not exist in the map
+  ///
+  /// Complexity: O(n * (H * S + M)) for n elements in the range
+  ///
+  /// \param begin: iterator to the first pair to insert
+  /// \param end: iterator past the last pair to insert
+  template <class Iterator>
+  void insert_range(Iterator begin, Iterator end);
+
+  /// Erase all elements for which \p predicate holds
+  ///
+  /// The tree is traversed once; only the nodes on the paths to erased
+  /// elements are copied (if shared) or removed.
+  ///
+  /// Complexity: O(N * S + N * M) calls of \p predicate
+  ///
+  /// \param predicate: function applied to the key and value of each element
+  void erase_if(
+    std::function<bool(const key_type &k, const mapped_type &m)> predicate);
+
+  /// Function to merge the values of a key that is contained in two maps. It
+  /// is given the key, the value in this map and the value in the other map,
+  /// and returns the value to store in this map, or an empty optionalt to
+  /// keep the value of this map.
+  typedef std::function<optionalt<mapped_type>(
+    const key_type &k,
+    const mapped_type &m,
+    const mapped_type &other_m)>
+    combinert;
+
+  /// Merge \p other into this map: elements only in \p other are inserted,
+  /// and for elements in both maps the value is determined by \p combiner
+  ///
+  /// Both trees are traversed in lockstep, and the traversal stops at subtrees
+  /// shared between the maps. Subtrees of \p other that do not exist in this
+  /// map are shared rather than copied. Only nodes of this map on the paths
+  /// to changed elements are copied (if shared). The \p combiner is not
+  /// called for elements whose key-value pairs are shared between the maps.
+  ///
+  /// Complexity:
+  /// - Worst case: O(max(N1, N2) * (H * S + M1 * M2)) (no sharing)
+  /// - Best case: O(1) (maximum sharing)
+  ///
+  /// \param other: map to merge into this map
+  /// \param combiner: function to merge values of keys in both maps
+  void merge_with(const sharing_mapt &other, combinert combiner);
+
   /// Find element
   ///
   /// Complexity:
@@ -508,6 +556,24 @@ public:
     const sharing_mapt &other,
     const bool only_common = true) const;
 
+  /// Get the delta views of the map and \p other in both directions with a
+  /// single traversal of the two trees
+  ///
+  /// This has the same effect as calling `A.get_delta_view(B, dv, false)`
+  /// and collecting the items of `B.get_delta_view(A, dv2, false)` for which
+  /// the key is only contained in B, but subtrees shared between the maps are
+  /// visited only once and items in both maps are compared only once.
+  ///
+  /// \param other: other map
+  /// \param [out] delta_view: Empty delta view, receives the items of the
+  ///   map as `get_delta_view(other, delta_view, false)` does
+  /// \param [out] other_delta_view: Empty delta view, receives the items of
+  ///   \p other whose keys are not contained in the map
+  void get_symmetric_delta_view(
+    const sharing_mapt &other,
+    delta_viewt &delta_view,
+    delta_viewt &other_delta_view) const;
+
   /// Call a function for every key-value pair in the map.
   ///
   /// Complexity: as \ref sharing_mapt::get_view
@@ -630,6 +696,60 @@ protected:
 
   void gather_all(const nodet &n, delta_viewt &delta_view) const;
 
+  /// Find the leaf with key \p k in the subtree below \p inner
+  /// \param level: depth of \p inner in the map
+  /// \return the leaf, or nullptr if there is none
+  const nodet *find_leaf_below(
+    const nodet &inner,
+    const key_type &k,
+    const std::size_t level) const;
+
+  /// Common implementation of get_delta_view() and
+  /// get_symmetric_delta_view(); the items of \p other whose keys are not
+  /// contained in the map are only collected if \p other_delta_view is not
+  /// null
+  void get_delta_view(
+    const sharing_mapt &other,
+    delta_viewt &delta_view,
+    delta_viewt *other_delta_view,
+    const bool only_common) const;
+
+  /// Number of key-value pairs in the subtree \p n
+  std::size_t count_leafs(const nodet &n) const;
+
+  /// Check if the internal or container node \p n has no children
+  static bool has_no_children(const nodet &n);
+
+  /// Erase all elements in the subtree \p n for which \p predicate holds,
+  /// which must not include \p n itself. This method is called by
+  /// `erase_if()`.
+  ///
+  /// \param n: internal or container node; it may be shared with other
+  ///   maps, and is only written to (and thus copied) if an element is erased
+  /// \param predicate: as for `erase_if()`
+  /// \return true if an element was erased
+  bool erase_if(
+    nodet &n,
+    const std::function<bool(const key_type &k, const mapped_type &m)>
+      &predicate);
+
+  /// Merge the subtree \p n2 of the other map into the subtree \p n1 at the
+  /// same position in this map. This method is called by `merge_with()`.
+  /// Key-value pairs that cannot be merged structurally since their positions
+  /// in the trees differ, are added to \p pending.
+  ///
+  /// \param n1: node of this map; it may be shared with other maps, and is
+  ///   only written to (and thus copied) if the merge changes it
+  /// \param n2: node of the other map, not shared with \p n1
+  /// \param pending: view of key-value pairs of the other map still to merge
+  /// \param combiner: as for `merge_with()`
+  /// \return true if \p n1 was changed
+  bool merge_node(
+    nodet &n1,
+    const nodet &n2,
+    viewt &pending,
+    const combinert &combiner);
+
   std::size_t count_unmarked_nodes(
     bool leafs_only,
     std::set<const void *> &marked,
@@ -932,16 +1052,72 @@ SHARING_MAPT(void)::add_item_if_not_shared(
   }
 }
 
+SHARING_MAPT2(const, nodet *)::find_leaf_below(
+  const nodet &inner,
+  const key_type &k,
+  const std::size_t level) const
+{
+  std::size_t key = hash()(k);
+
+  key >>= level * chunk;
+
+  const nodet *ip = &inner;
+  SM_ASSERT(ip->is_defined_internal());
+
+  while(true)
+  {
+    std::size_t bit = key & mask;
+
+    ip = ip->find_child(bit);
+
+    if(ip == nullptr)
+      return nullptr;
+
+    if(ip->is_container())
+      return ip->find_leaf(k);
+
+    if(ip->is_leaf())
+      return equalT()(ip->get_key(), k) ? ip : nullptr;
+
+    key >>= chunk;
+  }
+}
+
 SHARING_MAPT(void)
 ::get_delta_view(
   const sharing_mapt &other,
   delta_viewt &delta_view,
   const bool only_common) const
+{
+  get_delta_view(other, delta_view, nullptr, only_common);
+}
+
+SHARING_MAPT(void)::get_symmetric_delta_view(
+  const sharing_mapt &other,
+  delta_viewt &delta_view,
+  delta_viewt &other_delta_view) const
+{
+  SM_ASSERT(other_delta_view.empty());
+
+  get_delta_view(other, delta_view, &other_delta_view, false);
+}
+
+SHARING_MAPT(void)::get_delta_view(
+  const sharing_mapt &other,
+  delta_viewt &delta_view,
+  delta_viewt *other_delta_view,
+  const bool only_common) const
 {
   SM_ASSERT(delta_view.empty());
+  SM_ASSERT(other_delta_view == nullptr || !only_common);
 
   if(empty())
+  {
+    if(other_delta_view != nullptr && !other.empty())
+      gather_all(other.map, *other_delta_view);
+
     return;
+  }
 
   if(other.empty())
   {
@@ -1014,11 +1190,30 @@ SHARING_MAPT(void)
             level_stack.push(level + 1);
           }
         }
+
+        if(other_delta_view != nullptr)
+        {
+          for(const auto item : ip2->get_to_map())
+          {
+            if(ip1->find_child(item.first) == nullptr)
+              gather_all(item.second, *other_delta_view);
+          }
+        }
       }
       else
       {
         SM_ASSERT(ip2->is_leaf());
 
+        // The leaf of the right map is compared against all children below,
+        // so we determine here whether its key is in the left map at all. In
+        // the traversal below we get here again only with a dummy level.
+        if(
+          other_delta_view != nullptr && level != dummy_level &&
+          find_leaf_below(*ip1, ip2->get_key(), level) == nullptr)
+        {
+          other_delta_view->push_back({ip2->get_key(), ip2->get_value()});
+        }
+
         for(const auto item : ip1->get_to_map())
         {
           const nodet &child = item.second;
@@ -1044,6 +1239,17 @@ SHARING_MAPT(void)
         SM_ASSERT(level != dummy_level);
 
         add_item_if_not_shared(*ip1, *ip2, level, delta_view, only_common);
+
+        if(other_delta_view != nullptr)
+        {
+          const key_type &k1 = ip1->get_key();
+          iterate(
+            *ip2,
+            [&k1, other_delta_view](const key_type &k, const mapped_type &m) {
+              if(!equalT()(k, k1))
+                other_delta_view->push_back({k, m});
+            });
+        }
       }
       else
       {
@@ -1054,9 +1260,13 @@ SHARING_MAPT(void)
           delta_view.push_back(
             {ip1->get_key(), ip1->get_value(), ip2->get_value()});
         }
-        else if(!only_common)
+        else
         {
-          delta_view.push_back({ip1->get_key(), ip1->get_value()});
+          if(!only_common)
+            delta_view.push_back({ip1->get_key(), ip1->get_value()});
+
+          if(other_delta_view != nullptr && level != dummy_level)
+            other_delta_view->push_back({ip2->get_key(), ip2->get_value()});
         }
       }
     }
@@ -1067,6 +1277,13 @@ SHARING_MAPT(void)
 
       if(ip2->is_leaf())
       {
+        if(
+          other_delta_view != nullptr && level != dummy_level &&
+          ip1->find_leaf(ip2->get_key()) == nullptr)
+        {
+          other_delta_view->push_back({ip2->get_key(), ip2->get_value()});
+        }
+
         for(const auto &l1 : ip1->get_container())
         {
           if(l1.shares_with(*ip2))
@@ -1111,6 +1328,15 @@ SHARING_MAPT(void)
             delta_view.push_back({k1, l1.get_value()});
           }
         }
+
+        if(other_delta_view != nullptr)
+        {
+          for(const auto &l2 : ip2->get_container())
+          {
+            if(ip1->find_leaf(l2.get_key()) == nullptr)
+              other_delta_view->push_back({l2.get_key(), l2.get_value()});
+          }
+        }
       }
     }
   }
@@ -1446,6 +1672,274 @@ SHARING_MAPT(void)
     "method to check if an update is needed beforehand");
 }
 
+SHARING_MAPT4(Iterator, void)::insert_range(Iterator begin, Iterator end)
+{
+  // Inserting into a map that is not shared copies each node at most once,
+  // hence there is no gain in building the tree in a different way.
+  for(Iterator it = begin; it != end; it++)
+    insert(it->first, it->second);
+}
+
+SHARING_MAPT(std::size_t)::count_leafs(const nodet &n) const
+{
+  std::size_t count = 0;
+  iterate(n, [&count](const key_type &, const mapped_type &) { count++; });
+  return count;
+}
+
+SHARING_MAPT(bool)::has_no_children(const nodet &n)
+{
+  SM_ASSERT(!n.empty());
+
+  if(n.is_internal())
+    return n.get_to_map().empty();
+
+  SM_ASSERT(n.is_container());
+  return n.get_container().empty();
+}
+
+SHARING_MAPT(void)::erase_if(
+  std::function<bool(const key_type &k, const mapped_type &m)> predicate)
+{
+  if(empty())
+    return;
+
+  erase_if(map, predicate);
+}
+
+SHARING_MAPT(bool)::erase_if(
+  nodet &n,
+  const std::function<bool(const key_type &k, const mapped_type &m)>
+    &predicate)
+{
+  SM_ASSERT(!n.empty());
+
+  bool changed = false;
+
+  if(n.is_container())
+  {
+    keyst erased;
+
+    for(const auto &leaf : as_const(n).get_container())
+    {
+      if(predicate(leaf.get_key(), leaf.get_value()))
+        erased.push_back(leaf.get_key());
+    }
+
+    for(const auto &k : erased)
+      n.remove_leaf(k);
+
+    num -= erased.size();
+
+    return !erased.empty();
+  }
+
+  SM_ASSERT(n.is_internal());
+
+  // n may be copied or modified below, hence we must not hold references into
+  // its map while doing so
+  std::vector<std::size_t> bits;
+  for(const auto item : as_const(n).get_to_map())
+    bits.push_back(item.first);
+
+  for(const std::size_t bit : bits)
+  {
+    const nodet &child = *as_const(n).find_child(bit);
+
+    if(child.is_leaf())
+    {
+      if(predicate(child.get_key(), child.get_value()))
+      {
+        n.remove_child(bit);
+        num--;
+        changed = true;
+      }
+    }
+    else if(n.use_count() == 1 && child.use_count() == 1)
+    {
+      // neither node is shared, hence we can work on the child in place
+      nodet &child_in_place = n.add_child(bit);
+
+      if(erase_if(child_in_place, predicate))
+      {
+        if(has_no_children(child_in_place))
+          n.remove_child(bit);
+
+        changed = true;
+      }
+    }
+    else
+    {
+      nodet child_copy(child);
+
+      if(erase_if(child_copy, predicate))
+      {
+        if(has_no_children(child_copy))
+          n.remove_child(bit);
+        else
+          n.add_child(bit).swap(child_copy);
+
+        changed = true;
+      }
+    }
+  }
+
+  return changed;
+}
+
+SHARING_MAPT(void)
+::merge_with(const sharing_mapt &other, combinert combiner)
+{
+  if(other.empty())
+    return;
+
+  if(empty())
+  {
+    *this = other;
+    return;
+  }
+
+  if(map.shares_with(other.map))
+    return;
+
+  viewt pending;
+  merge_node(map, other.map, pending, combiner);
+
+  for(const auto &item : pending)
+  {
+    const nodet *lp = as_const(*this).get_leaf_node(item.first);
+
+    if(lp == nullptr)
+    {
+      insert(item.first, item.second);
+    }
+    else if(&lp->get_value() != &item.second)
+    {
+      auto merged = combiner(item.first, lp->get_value(), item.second);
+
+      if(merged.has_value())
+        replace(item.first, std::move(*merged));
+    }
+  }
+}
+
+SHARING_MAPT(bool)::merge_node(
+  nodet &n1,
+  const nodet &n2,
+  viewt &pending,
+  const combinert &combiner)
+{
+  SM_ASSERT(!n1.empty());
+  SM_ASSERT(!n2.empty());
+  SM_ASSERT(!n1.shares_with(n2));
+
+  auto add_all = [&pending](const key_type &k, const mapped_type &m) {
+    pending.push_back(view_itemt(k, m));
+  };
+
+  if(n1.is_internal() && n2.is_internal())
+  {
+    bool changed = false;
+
+    for(const auto item : n2.get_to_map())
+    {
+      const std::size_t bit = item.first;
+      const nodet &child2 = item.second;
+      const nodet *child1 = as_const(n1).find_child(bit);
+
+      if(child1 == nullptr)
+      {
+        // share the subtree of the other map
+        n1.add_child(bit) = child2;
+        num += count_leafs(child2);
+        changed = true;
+      }
+      else if(child1->shares_with(child2))
+      {
+        continue;
+      }
+      else if(n1.use_count() == 1 && child1->use_count() == 1)
+      {
+        // neither node is shared, hence we can work on the child in place
+        if(merge_node(n1.add_child(bit), child2, pending, combiner))
+          changed = true;
+      }
+      else
+      {
+        nodet child_copy(*child1);
+
+        if(merge_node(child_copy, child2, pending, combiner))
+        {
+          n1.add_child(bit).swap(child_copy);
+          changed = true;
+        }
+      }
+    }
+
+    return changed;
+  }
+  else if(n1.is_leaf() && n2.is_leaf())
+  {
+    if(!equalT()(n1.get_key(), n2.get_key()))
+    {
+      pending.push_back(view_itemt(n2.get_key(), n2.get_value()));
+      return false;
+    }
+
+    auto merged = combiner(n1.get_key(), n1.get_value(), n2.get_value());
+
+    if(!merged.has_value())
+      return false;
+
+    INVARIANT(
+      !value_equalt()(n1.get_value(), *merged),
+      "values should not be replaced with equal values to maximize sharing");
+
+    n1.set_value(std::move(*merged));
+    return true;
+  }
+  else if(n1.is_container() && n2.is_container())
+  {
+    bool changed = false;
+
+    for(const auto &leaf2 : n2.get_container())
+    {
+      const key_type &k = leaf2.get_key();
+      const nodet *leaf1 = as_const(n1).find_leaf(k);
+
+      if(leaf1 == nullptr)
+      {
+        n1.place_leaf(k, leaf2.get_value());
+        num++;
+        changed = true;
+      }
+      else if(!leaf1->shares_with(leaf2))
+      {
+        auto merged = combiner(k, leaf1->get_value(), leaf2.get_value());
+
+        if(merged.has_value())
+        {
+          INVARIANT(
+            !value_equalt()(leaf1->get_value(), *merged),
+            "values should not be replaced with equal values to maximize "
+            "sharing");
+
+          n1.find_leaf(k)->set_value(std::move(*merged));
+          changed = true;
+        }
+      }
+    }
+
+    return changed;
+  }
+
+  // The positions of the elements in the trees differ, which happens when
+  // the maps were built by different sequences of insertions. Merge these
+  // elements one by one.
+  iterate(n2, add_all);
+  return false;
+}
+
 SHARING_MAPT2(optionalt<std::reference_wrapper<const, mapped_type>>)::find(
   const key_type &k) const
 {
@@ -9,6 +9,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "simplify_expr.h"
 
 #include <algorithm>
+#include <chrono>
 
 #include "bitvector_expr.h"
 #include "byte_operators.h"
@@ -18,6 +19,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "fixedbv.h"
 #include "floatbv_expr.h"
 #include "invariant.h"
+#include "json.h"
 #include "mathematical_expr.h"
 #include "namespace.h"
 #include "pointer_expr.h"
@@ -38,30 +40,6 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "simplify_expr_class.h"
 
-// #define USE_CACHE
-
-#ifdef USE_CACHE
-struct simplify_expr_cachet
-{
-public:
-  #if 1
-  typedef std::unordered_map<
-    exprt, exprt, irep_full_hash, irep_full_eq> containert;
-  #else
-  typedef std::unordered_map<exprt, exprt, irep_hash> containert;
-  #endif
-
-  containert container_normal;
-
-  containert &container()
-  {
-    return container_normal;
-  }
-};
-
-simplify_expr_cachet simplify_expr_cache;
-#endif
-
 simplify_exprt::resultt<> simplify_exprt::simplify_abs(const abs_exprt &expr)
 {
   if(expr.op().is_constant())
@@ -532,6 +510,138 @@ static simplify_exprt::resultt<> simplify_string_char_at(
   return c;
 }
 
+/// Parse the characters of a constant string as an integer with the same
+/// rules as Java's Integer.parseInt, without checking for an overflow
+/// \param string_data: the characters of the string
+/// \param radix: the radix, between 2 and 36
+/// \return the value of the integer, or nothing if the string is not an
+///   integer in \p radix
+static optionalt<mp_integer>
+parse_integer_string(const array_exprt &string_data, const mp_integer &radix)
+{
+  const auto &chars = string_data.operands();
+  bool negative = false;
+  std::size_t i = 0;
+  if(!chars.empty())
+  {
+    const auto first = numeric_cast<mp_integer>(chars[0]);
+    if(first.has_value() && (*first == '-' || *first == '+'))
+    {
+      negative = *first == '-';
+      ++i;
+    }
+  }
+
+  if(i >= chars.size())
+    return {};
+
+  mp_integer value = 0;
+  for(; i < chars.size(); ++i)
+  {
+    const auto c = numeric_cast<mp_integer>(chars[i]);
+    if(!c.has_value())
+      return {};
+
+    mp_integer digit;
+    if(*c >= '0' && *c <= '9')
+      digit = *c - '0';
+    else if(*c >= 'a' && *c <= 'z')
+      digit = *c - 'a' + 10;
+    else if(*c >= 'A' && *c <= 'Z')
+      digit = *c - 'A' + 10;
+    else
+      return {};
+
+    if(digit >= radix)
+      return {};
+
+    value = value * radix + digit;
+  }
+
+  return negative ? -value : value;
+}
+
+/// \return the constant radix of a call to parse an integer string, or
+///   nothing if the radix is not a constant between 2 and 36
+static optionalt<mp_integer>
+get_parse_integer_radix(const function_application_exprt &expr)
+{
+  if(expr.arguments().size() < 2)
+    return mp_integer(10);
+
+  const auto radix = numeric_cast<mp_integer>(expr.arguments()[1]);
+  if(!radix.has_value() || *radix < 2 || *radix > 36)
+    return {};
+
+  return radix;
+}
+
+/// Simplify Integer.parseInt and Long.parseLong functions when arguments are
+/// constant and the string is a valid integer
+///
+/// \param expr: the expression to simplify
+/// \param ns: namespace
+/// \return: the modified expression or an unchanged expression
+static simplify_exprt::resultt<> simplify_string_parse_int(
+  const function_application_exprt &expr,
+  const namespacet &ns)
+{
+  if(expr.type().id() != ID_signedbv)
+    return simplify_exprt::unchanged(expr);
+
+  const auto radix = get_parse_integer_radix(expr);
+  if(!radix.has_value())
+    return simplify_exprt::unchanged(expr);
+
+  const refined_string_exprt &s = to_string_expr(expr.arguments().at(0));
+  const auto char_seq_opt = try_get_string_data_array(s.content(), ns);
+  if(!char_seq_opt)
+    return simplify_exprt::unchanged(expr);
+
+  // the result of parsing an invalid or too large integer is left to the
+  // string solver, which does not constrain it
+  const auto value = parse_integer_string(char_seq_opt->get(), *radix);
+  const signedbv_typet &type = to_signedbv_type(expr.type());
+  if(!value.has_value() || *value < type.smallest() || *value > type.largest())
+    return simplify_exprt::unchanged(expr);
+
+  return from_integer(*value, expr.type());
+}
+
+/// Simplify the functions checking whether a string is a valid argument of
+/// Integer.parseInt or Long.parseLong when arguments are constant
+///
+/// \param expr: the expression to simplify
+/// \param ns: namespace
+/// \param width: the width of the integers, 32 or 64
+/// \return: the modified expression or an unchanged expression
+static simplify_exprt::resultt<> simplify_string_is_valid_int(
+  const function_application_exprt &expr,
+  const namespacet &ns,
+  std::size_t width)
+{
+  const auto radix = get_parse_integer_radix(expr);
+  if(!radix.has_value())
+    return simplify_exprt::unchanged(expr);
+
+  const refined_string_exprt &s = to_string_expr(expr.arguments().at(0));
+  const auto char_seq_opt = try_get_string_data_array(s.content(), ns);
+  if(!char_seq_opt)
+    return simplify_exprt::unchanged(expr);
+
+  const auto value = parse_integer_string(char_seq_opt->get(), *radix);
+  if(!value.has_value())
+    return from_integer(0, expr.type());
+
+  // the string solver only approximates the bounds by the number of digits,
+  // hence those integers that do not fit are left to it
+  const signedbv_typet type(width);
+  if(*value < type.smallest() || *value > type.largest())
+    return simplify_exprt::unchanged(expr);
+
+  return from_integer(1, expr.type());
+}
+
 /// Take the passed-in constant string array and lower-case every character.
 static bool lower_case_string_expression(array_exprt &string_data)
 {
@@ -724,6 +834,18 @@ simplify_exprt::resultt<> simplify_exprt::simplify_function_application(
   {
     return simplify_string_equals_ignore_case(expr, ns);
   }
+  else if(func_id == ID_cprover_string_parse_int_func)
+  {
+    return simplify_string_parse_int(expr, ns);
+  }
+  else if(func_id == ID_cprover_string_is_valid_int_func)
+  {
+    return simplify_string_is_valid_int(expr, ns, 32);
+  }
+  else if(func_id == ID_cprover_string_is_valid_long_func)
+  {
+    return simplify_string_is_valid_int(expr, ns, 64);
+  }
 
   return unchanged(expr);
 }
@@ -2311,6 +2433,258 @@ bool simplify_exprt::simplify_node_preorder(exprt &expr)
   return result;
 }
 
+namespace
+{
+/// A simplification rule for the expressions with any of the given ids,
+/// together with the statistics of its applications
+struct simplify_rulet
+{
+  using applyt =
+    simplify_exprt::resultt<> (*)(simplify_exprt &, const exprt &);
+
+  simplify_rulet(const char *_name, applyt _apply, std::vector<irep_idt> _ids)
+    : name(_name), apply(_apply), ids(std::move(_ids))
+  {
+  }
+
+  const char *name;
+  applyt apply;
+  std::vector<irep_idt> ids;
+
+  std::size_t calls = 0;
+  std::size_t rewrites = 0;
+  std::chrono::steady_clock::duration time{};
+};
+} // namespace
+
+/// \return the rules applied by simplify_exprt::simplify_node
+static std::vector<simplify_rulet> &simplify_rules()
+{
+#define RULE(name, function, cast, ...)                                        \
+  simplify_rulet(                                                              \
+    name,                                                                      \
+    [](simplify_exprt &simplifier, const exprt &expr) {                        \
+      return simplifier.function(cast(expr));                                  \
+    },                                                                         \
+    __VA_ARGS__)
+
+  static std::vector<simplify_rulet> rules{
+    RULE("typecast", simplify_typecast, to_typecast_expr, {ID_typecast}),
+    RULE(
+      "inequality",
+      simplify_inequality,
+      to_binary_relation_expr,
+      {ID_equal, ID_notequal, ID_gt, ID_lt, ID_ge, ID_le}),
+    RULE("if", simplify_if, to_if_expr, {ID_if}),
+    RULE("lambda", simplify_lambda, to_lambda_expr, {ID_lambda}),
+    RULE("with", simplify_with, to_with_expr, {ID_with}),
+    RULE("update", simplify_update, to_update_expr, {ID_update}),
+    RULE("index", simplify_index, to_index_expr, {ID_index}),
+    RULE("member", simplify_member, to_member_expr, {ID_member}),
+    RULE(
+      "byte_update",
+      simplify_byte_update,
+      to_byte_update_expr,
+      {ID_byte_update_little_endian, ID_byte_update_big_endian}),
+    RULE(
+      "byte_extract",
+      simplify_byte_extract,
+      to_byte_extract_expr,
+      {ID_byte_extract_little_endian, ID_byte_extract_big_endian}),
+    RULE(
+      "pointer_object",
+      simplify_pointer_object,
+      to_unary_expr,
+      {ID_pointer_object}),
+    RULE(
+      "is_dynamic_object",
+      simplify_is_dynamic_object,
+      to_unary_expr,
+      {ID_is_dynamic_object}),
+    RULE(
+      "is_invalid_pointer",
+      simplify_is_invalid_pointer,
+      to_unary_expr,
+      {ID_is_invalid_pointer}),
+    RULE("object_size", simplify_object_size, to_unary_expr, {ID_object_size}),
+    RULE(
+      "good_pointer",
+      simplify_good_pointer,
+      to_unary_expr,
+      {ID_good_pointer}),
+    RULE("div", simplify_div, to_div_expr, {ID_div}),
+    RULE("mod", simplify_mod, to_mod_expr, {ID_mod}),
+    RULE("bitnot", simplify_bitnot, to_bitnot_expr, {ID_bitnot}),
+    RULE(
+      "bitwise",
+      simplify_bitwise,
+      to_multi_ary_expr,
+      {ID_bitand, ID_bitor, ID_bitxor}),
+    RULE("shifts", simplify_shifts, to_shift_expr, {ID_ashr, ID_lshr, ID_shl}),
+    RULE("power", simplify_power, to_binary_expr, {ID_power}),
+    RULE("plus", simplify_plus, to_plus_expr, {ID_plus}),
+    RULE("minus", simplify_minus, to_minus_expr, {ID_minus}),
+    RULE("mult", simplify_mult, to_mult_expr, {ID_mult}),
+    RULE(
+      "floatbv_op",
+      simplify_floatbv_op,
+      to_ieee_float_op_expr,
+      {ID_floatbv_plus, ID_floatbv_minus, ID_floatbv_mult, ID_floatbv_div}),
+    RULE(
+      "floatbv_typecast",
+      simplify_floatbv_typecast,
+      to_floatbv_typecast_expr,
+      {ID_floatbv_typecast}),
+    RULE(
+      "unary_minus",
+      simplify_unary_minus,
+      to_unary_minus_expr,
+      {ID_unary_minus}),
+    RULE(
+      "unary_plus",
+      simplify_unary_plus,
+      to_unary_plus_expr,
+      {ID_unary_plus}),
+    RULE("not", simplify_not, to_not_expr, {ID_not}),
+    RULE(
+      "boolean",
+      simplify_boolean,
+      static_cast<const exprt &>,
+      {ID_implies, ID_or, ID_xor, ID_and}),
+    RULE(
+      "dereference",
+      simplify_dereference,
+      to_dereference_expr,
+      {ID_dereference}),
+    RULE(
+      "address_of",
+      simplify_address_of,
+      to_address_of_expr,
+      {ID_address_of}),
+    RULE(
+      "pointer_offset",
+      simplify_pointer_offset,
+      to_unary_expr,
+      {ID_pointer_offset}),
+    RULE(
+      "extractbit",
+      simplify_extractbit,
+      to_extractbit_expr,
+      {ID_extractbit}),
+    RULE(
+      "concatenation",
+      simplify_concatenation,
+      to_concatenation_expr,
+      {ID_concatenation}),
+    RULE(
+      "extractbits",
+      simplify_extractbits,
+      to_extractbits_expr,
+      {ID_extractbits}),
+    RULE(
+      "ieee_float_relation",
+      simplify_ieee_float_relation,
+      to_binary_relation_expr,
+      {ID_ieee_float_equal, ID_ieee_float_notequal}),
+    RULE("bswap", simplify_bswap, to_bswap_expr, {ID_bswap}),
+    RULE("isinf", simplify_isinf, to_unary_expr, {ID_isinf}),
+    RULE("isnan", simplify_isnan, to_unary_expr, {ID_isnan}),
+    RULE("isnormal", simplify_isnormal, to_unary_expr, {ID_isnormal}),
+    RULE("abs", simplify_abs, to_abs_expr, {ID_abs}),
+    RULE("sign", simplify_sign, to_sign_expr, {ID_sign}),
+    RULE("popcount", simplify_popcount, to_popcount_expr, {ID_popcount}),
+    RULE(
+      "clz",
+      simplify_clz,
+      to_count_leading_zeros_expr,
+      {ID_count_leading_zeros}),
+    RULE(
+      "ctz",
+      simplify_ctz,
+      to_count_trailing_zeros_expr,
+      {ID_count_trailing_zeros}),
+    RULE(
+      "function_application",
+      simplify_function_application,
+      to_function_application_expr,
+      {ID_function_application}),
+    RULE(
+      "complex",
+      simplify_complex,
+      to_unary_expr,
+      {ID_complex_real, ID_complex_imag}),
+    RULE(
+      "overflow_binary",
+      simplify_overflow_binary,
+      to_binary_overflow_expr,
+      {ID_overflow_plus, ID_overflow_minus, ID_overflow_mult, ID_overflow_shl}),
+    RULE(
+      "overflow_unary",
+      simplify_overflow_unary,
+      to_unary_overflow_expr,
+      {ID_overflow_unary_minus}),
+  };
+
+#undef RULE
+
+  return rules;
+}
+
+/// \return the rule for expressions with id \p id, if any
+static simplify_rulet *find_simplify_rule(const irep_idt &id)
+{
+  // indexed by the number of the id
+  static const std::vector<simplify_rulet *> dispatch = [] {
+    std::vector<simplify_rulet *> result;
+    for(auto &rule : simplify_rules())
+    {
+      for(const auto &rule_id : rule.ids)
+      {
+        if(rule_id.get_no() >= result.size())
+          result.resize(rule_id.get_no() + 1, nullptr);
+        result[rule_id.get_no()] = &rule;
+      }
+    }
+    return result;
+  }();
+
+  return id.get_no() < dispatch.size() ? dispatch[id.get_no()] : nullptr;
+}
+
+bool simplify_exprt::rule_statistics_enabled = false;
+
+json_arrayt simplify_exprt::get_rule_statistics()
+{
+  std::vector<const simplify_rulet *> applied;
+  for(const auto &rule : simplify_rules())
+  {
+    if(rule.calls != 0)
+      applied.push_back(&rule);
+  }
+
+  // the most expensive first
+  std::stable_sort(
+    applied.begin(),
+    applied.end(),
+    [](const simplify_rulet *a, const simplify_rulet *b) {
+      return a->time > b->time;
+    });
+
+  json_arrayt result;
+  for(const auto rule : applied)
+  {
+    result.push_back(json_objectt{
+      {"rule", json_stringt{rule->name}},
+      {"calls", json_numbert{std::to_string(rule->calls)}},
+      {"rewrites", json_numbert{std::to_string(rule->rewrites)}},
+      {"seconds",
+       json_numbert{std::to_string(
+         std::chrono::duration<double>(rule->time).count())}}});
+  }
+
+  return result;
+}
+
 simplify_exprt::resultt<> simplify_exprt::simplify_node(exprt node)
 {
   if(!node.has_operands())
@@ -2327,219 +2701,18 @@ simplify_exprt::resultt<> simplify_exprt::simplify_node(exprt node)
 
   resultt<> r = unchanged(expr);
 
-  if(expr.id()==ID_typecast)
-  {
-    r = simplify_typecast(to_typecast_expr(expr));
-  }
-  else if(expr.id()==ID_equal || expr.id()==ID_notequal ||
-          expr.id()==ID_gt    || expr.id()==ID_lt ||
-          expr.id()==ID_ge    || expr.id()==ID_le)
-  {
-    r = simplify_inequality(to_binary_relation_expr(expr));
-  }
-  else if(expr.id()==ID_if)
-  {
-    r = simplify_if(to_if_expr(expr));
-  }
-  else if(expr.id()==ID_lambda)
-  {
-    r = simplify_lambda(to_lambda_expr(expr));
-  }
-  else if(expr.id()==ID_with)
-  {
-    r = simplify_with(to_with_expr(expr));
-  }
-  else if(expr.id()==ID_update)
-  {
-    r = simplify_update(to_update_expr(expr));
-  }
-  else if(expr.id()==ID_index)
-  {
-    r = simplify_index(to_index_expr(expr));
-  }
-  else if(expr.id()==ID_member)
-  {
-    r = simplify_member(to_member_expr(expr));
-  }
-  else if(expr.id()==ID_byte_update_little_endian ||
-          expr.id()==ID_byte_update_big_endian)
-  {
-    r = simplify_byte_update(to_byte_update_expr(expr));
-  }
-  else if(expr.id()==ID_byte_extract_little_endian ||
-          expr.id()==ID_byte_extract_big_endian)
-  {
-    r = simplify_byte_extract(to_byte_extract_expr(expr));
-  }
-  else if(expr.id()==ID_pointer_object)
-  {
-    r = simplify_pointer_object(to_unary_expr(expr));
-  }
-  else if(expr.id() == ID_is_dynamic_object)
-  {
-    r = simplify_is_dynamic_object(to_unary_expr(expr));
-  }
-  else if(expr.id() == ID_is_invalid_pointer)
-  {
-    r = simplify_is_invalid_pointer(to_unary_expr(expr));
-  }
-  else if(expr.id()==ID_object_size)
-  {
-    r = simplify_object_size(to_unary_expr(expr));
-  }
-  else if(expr.id()==ID_good_pointer)
-  {
-    r = simplify_good_pointer(to_unary_expr(expr));
-  }
-  else if(expr.id()==ID_div)
-  {
-    r = simplify_div(to_div_expr(expr));
-  }
-  else if(expr.id()==ID_mod)
-  {
-    r = simplify_mod(to_mod_expr(expr));
-  }
-  else if(expr.id()==ID_bitnot)
-  {
-    r = simplify_bitnot(to_bitnot_expr(expr));
-  }
-  else if(expr.id()==ID_bitand ||
-          expr.id()==ID_bitor ||
-          expr.id()==ID_bitxor)
-  {
-    r = simplify_bitwise(to_multi_ary_expr(expr));
-  }
-  else if(expr.id()==ID_ashr || expr.id()==ID_lshr || expr.id()==ID_shl)
-  {
-    r = simplify_shifts(to_shift_expr(expr));
-  }
-  else if(expr.id()==ID_power)
-  {
-    r = simplify_power(to_binary_expr(expr));
-  }
-  else if(expr.id()==ID_plus)
-  {
-    r = simplify_plus(to_plus_expr(expr));
-  }
-  else if(expr.id()==ID_minus)
-  {
-    r = simplify_minus(to_minus_expr(expr));
-  }
-  else if(expr.id()==ID_mult)
-  {
-    r = simplify_mult(to_mult_expr(expr));
-  }
-  else if(expr.id()==ID_floatbv_plus ||
-          expr.id()==ID_floatbv_minus ||
-          expr.id()==ID_floatbv_mult ||
-          expr.id()==ID_floatbv_div)
-  {
-    r = simplify_floatbv_op(to_ieee_float_op_expr(expr));
-  }
-  else if(expr.id()==ID_floatbv_typecast)
-  {
-    r = simplify_floatbv_typecast(to_floatbv_typecast_expr(expr));
-  }
-  else if(expr.id()==ID_unary_minus)
-  {
-    r = simplify_unary_minus(to_unary_minus_expr(expr));
-  }
-  else if(expr.id()==ID_unary_plus)
-  {
-    r = simplify_unary_plus(to_unary_plus_expr(expr));
-  }
-  else if(expr.id()==ID_not)
-  {
-    r = simplify_not(to_not_expr(expr));
-  }
-  else if(expr.id()==ID_implies ||
-          expr.id()==ID_or      || expr.id()==ID_xor ||
-          expr.id()==ID_and)
-  {
-    r = simplify_boolean(expr);
-  }
-  else if(expr.id()==ID_dereference)
-  {
-    r = simplify_dereference(to_dereference_expr(expr));
-  }
-  else if(expr.id()==ID_address_of)
-  {
-    r = simplify_address_of(to_address_of_expr(expr));
-  }
-  else if(expr.id()==ID_pointer_offset)
-  {
-    r = simplify_pointer_offset(to_unary_expr(expr));
-  }
-  else if(expr.id()==ID_extractbit)
-  {
-    r = simplify_extractbit(to_extractbit_expr(expr));
-  }
-  else if(expr.id()==ID_concatenation)
-  {
-    r = simplify_concatenation(to_concatenation_expr(expr));
-  }
-  else if(expr.id()==ID_extractbits)
-  {
-    r = simplify_extractbits(to_extractbits_expr(expr));
-  }
-  else if(expr.id()==ID_ieee_float_equal ||
-          expr.id()==ID_ieee_float_notequal)
-  {
-    r = simplify_ieee_float_relation(to_binary_relation_expr(expr));
-  }
-  else if(expr.id() == ID_bswap)
-  {
-    r = simplify_bswap(to_bswap_expr(expr));
-  }
-  else if(expr.id()==ID_isinf)
-  {
-    r = simplify_isinf(to_unary_expr(expr));
-  }
-  else if(expr.id()==ID_isnan)
-  {
-    r = simplify_isnan(to_unary_expr(expr));
-  }
-  else if(expr.id()==ID_isnormal)
-  {
-    r = simplify_isnormal(to_unary_expr(expr));
-  }
-  else if(expr.id()==ID_abs)
-  {
-    r = simplify_abs(to_abs_expr(expr));
-  }
-  else if(expr.id()==ID_sign)
-  {
-    r = simplify_sign(to_sign_expr(expr));
-  }
-  else if(expr.id() == ID_popcount)
-  {
-    r = simplify_popcount(to_popcount_expr(expr));
-  }
-  else if(expr.id() == ID_count_leading_zeros)
-  {
-    r = simplify_clz(to_count_leading_zeros_expr(expr));
-  }
-  else if(expr.id() == ID_count_trailing_zeros)
-  {
-    r = simplify_ctz(to_count_trailing_zeros_expr(expr));
-  }
-  else if(expr.id() == ID_function_application)
-  {
-    r = simplify_function_application(to_function_application_expr(expr));
-  }
-  else if(expr.id() == ID_complex_real || expr.id() == ID_complex_imag)
-  {
-    r = simplify_complex(to_unary_expr(expr));
-  }
-  else if(
-    expr.id() == ID_overflow_plus || expr.id() == ID_overflow_minus ||
-    expr.id() == ID_overflow_mult || expr.id() == ID_overflow_shl)
-  {
-    r = simplify_overflow_binary(to_binary_overflow_expr(expr));
-  }
-  else if(expr.id() == ID_overflow_unary_minus)
+  simplify_rulet *rule = find_simplify_rule(expr.id());
+
+  if(rule != nullptr && !rule_statistics_enabled)
+    r = rule->apply(*this, expr);
+  else if(rule != nullptr)
   {
-    r = simplify_overflow_unary(to_unary_overflow_expr(expr));
+    const auto start = std::chrono::steady_clock::now();
+    r = rule->apply(*this, expr);
+    rule->time += std::chrono::steady_clock::now() - start;
+    ++rule->calls;
+    if(r.has_changed())
+      ++rule->rewrites;
   }
 
   if(!no_change_join_operands)
@@ -2564,23 +2737,17 @@ simplify_exprt::resultt<> simplify_exprt::simplify_node(exprt node)
 simplify_exprt::resultt<> simplify_exprt::simplify_rec(const exprt &expr)
 {
   // look up in cache
-
-  #ifdef USE_CACHE
-  std::pair<simplify_expr_cachet::containert::iterator, bool>
-    cache_result=simplify_expr_cache.container().
-      insert(std::pair<exprt, exprt>(expr, exprt()));
-
-  if(!cache_result.second) // found!
+  if(cache.enabled())
   {
-    const exprt &new_expr=cache_result.first->second;
-
-    if(new_expr.id().empty())
-      return true; // no change
-
-    expr=new_expr;
-    return false;
+    const exprt *cached = cache.find(expr);
+    if(cached != nullptr)
+    {
+      if(cached->is_nil())
+        return unchanged(expr);
+      else
+        return *cached;
+    }
   }
-  #endif
 
   // We work on a copy to prevent unnecessary destruction of sharing.
   exprt tmp=expr;
@@ -2614,16 +2781,14 @@ simplify_exprt::resultt<> simplify_exprt::simplify_rec(const exprt &expr)
 
   if(no_change) // no change
   {
+    cache.insert(expr, nil_exprt());
     return unchanged(expr);
   }
   else // change, new expression is 'tmp'
   {
     POSTCONDITION(as_const(tmp).type() == expr.type());
 
-#ifdef USE_CACHE
-    // save in cache
-    cache_result.first->second = tmp;
-#endif
+    cache.insert(expr, tmp);
 
     return std::move(tmp);
   }
@@ -0,0 +1,67 @@
+/*******************************************************************\
+
+Module: Bounded memoization of simplifier results
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Bounded memoization of simplifier results
+
+#include "simplify_expr_cache.h"
+
+const exprt *simplify_expr_cachet::find(const exprt &expr)
+{
+  auto it = current.find(expr);
+  if(it != current.end())
+  {
+    ++hits;
+    return &it->second;
+  }
+
+  auto previous_it = previous.find(expr);
+  if(previous_it == previous.end())
+  {
+    ++misses;
+    return nullptr;
+  }
+
+  ++hits;
+
+  // promote to the current generation so that the entry survives the next
+  // generation change
+  exprt key = previous_it->first;
+  exprt result = std::move(previous_it->second);
+  previous.erase(previous_it);
+  insert(key, std::move(result));
+
+  return &current.at(key);
+}
+
+void simplify_expr_cachet::insert(const exprt &expr, exprt result)
+{
+  if(!enabled())
+    return;
+
+  if(current.size() >= (max_entries + 1) / 2)
+  {
+    evictions += previous.size();
+    previous = std::move(current);
+    current.clear();
+  }
+
+  current[expr] = std::move(result);
+}
+
+void simplify_expr_cachet::clear()
+{
+  current.clear();
+  previous.clear();
+}
+
+void simplify_expr_cachet::set_max_entries(std::size_t _max_entries)
+{
+  max_entries = _max_entries;
+  clear();
+}
@@ -0,0 +1,79 @@
+/*******************************************************************\
+
+Module: Bounded memoization of simplifier results
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Bounded memoization of simplifier results
+
+#ifndef CPROVER_UTIL_SIMPLIFY_EXPR_CACHE_H
+#define CPROVER_UTIL_SIMPLIFY_EXPR_CACHE_H
+
+#include "expr.h"
+
+#include <unordered_map>
+
+/// A size-bounded cache mapping expressions to their simplified form.
+///
+/// Entries are held in two generations. New entries go into the current
+/// generation; once that holds half of the permitted entries, the previous
+/// generation is discarded and the current one takes its place. Hits in the
+/// previous generation are promoted, so frequently used entries survive,
+/// approximating LRU replacement without per-lookup bookkeeping.
+///
+/// Keys are hashed using the hash cached in the irep (see `HASH_CODE`) and
+/// are compared including comments, so that results carry the same
+/// source locations a fresh simplification would have produced.
+class simplify_expr_cachet
+{
+public:
+  /// \param max_entries: maximum number of cached expressions; 0 disables
+  ///   the cache
+  explicit simplify_expr_cachet(std::size_t max_entries)
+    : max_entries(max_entries)
+  {
+  }
+
+  bool enabled() const
+  {
+    return max_entries != 0;
+  }
+
+  /// Look up the simplified form of \p expr.
+  /// \return nullptr if not cached, a nil expression if \p expr is known to
+  ///   be unchanged by simplification, and the simplified expression
+  ///   otherwise
+  const exprt *find(const exprt &expr);
+
+  /// Record that simplifying \p expr yields \p result. Pass a nil expression
+  /// to record that \p expr does not simplify any further.
+  void insert(const exprt &expr, exprt result);
+
+  /// Drop all entries, e.g., when the namespace changed.
+  void clear();
+
+  /// Change the maximum number of entries, dropping all entries.
+  void set_max_entries(std::size_t);
+
+  std::size_t size() const
+  {
+    return current.size() + previous.size();
+  }
+
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  std::size_t evictions = 0;
+
+protected:
+  using containert =
+    std::unordered_map<exprt, exprt, irep_hash, irep_full_eq>;
+
+  std::size_t max_entries;
+  containert current;
+  containert previous;
+};
+
+#endif // CPROVER_UTIL_SIMPLIFY_EXPR_CACHE_H
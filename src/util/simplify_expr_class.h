@@ -20,6 +20,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "expr.h"
 #include "mp_arith.h"
 #include "nodiscard.h"
+#include "simplify_expr_cache.h"
 #include "type.h"
 // #define USE_LOCAL_REPLACE_MAP
 #ifdef USE_LOCAL_REPLACE_MAP
@@ -47,6 +48,7 @@ class extractbits_exprt;
 class floatbv_typecast_exprt;
 class function_application_exprt;
 class ieee_float_op_exprt;
+class json_arrayt;
 class if_exprt;
 class index_exprt;
 class lambda_exprt;
@@ -75,7 +77,8 @@ class simplify_exprt
 public:
   explicit simplify_exprt(const namespacet &_ns):
     do_simplify_if(true),
-    ns(_ns)
+    ns(_ns),
+    cache(0)
 #ifdef DEBUG_ON_DEMAND
     , debug_on(false)
 #endif
@@ -237,6 +240,42 @@ public:
 
   virtual bool simplify(exprt &expr);
 
+  /// Memoize the results of simplify_rec for at most \p max_entries
+  /// expressions; 0 (the default) disables memoization. The cache assumes
+  /// that neither the namespace nor `do_simplify_if` change in ways that
+  /// affect earlier results; call `clear_cache` otherwise.
+  void set_cache_size(std::size_t max_entries)
+  {
+    cache.set_max_entries(max_entries);
+  }
+
+  void clear_cache()
+  {
+    cache.clear();
+  }
+
+  const simplify_expr_cachet &get_cache() const
+  {
+    return cache;
+  }
+
+  /// Count the calls of each rule of simplify_node, the rewrites they do
+  /// and the time spent in them, including the simplification of the
+  /// rewritten expressions, in all instances of simplify_exprt from now on
+  static void enable_rule_statistics()
+  {
+    rule_statistics_enabled = true;
+  }
+
+  static bool is_rule_statistics_enabled()
+  {
+    return rule_statistics_enabled;
+  }
+
+  /// \return the statistics of the rules that have been called, the most
+  ///   expensive first
+  static json_arrayt get_rule_statistics();
+
   static bool is_bitvector_type(const typet &type)
   {
     return type.id()==ID_unsignedbv ||
@@ -245,6 +284,8 @@ public:
   }
 
 protected:
+  static bool rule_statistics_enabled;
+
   const namespacet &ns;
 #ifdef DEBUG_ON_DEMAND
   bool debug_on;
@@ -252,7 +293,7 @@ protected:
 #ifdef USE_LOCAL_REPLACE_MAP
   replace_mapt local_replace_map;
 #endif
-
+  simplify_expr_cachet cache;
 };
 
 #endif // CPROVER_UTIL_SIMPLIFY_EXPR_CLASS_H
@@ -0,0 +1,682 @@
+/*******************************************************************\
+
+Module: Vector with inline storage for a small number of elements
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Vector with inline storage for a small number of elements
+
+#ifndef CPROVER_UTIL_SMALL_VECTOR_H
+#define CPROVER_UTIL_SMALL_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "invariant.h"
+
+/// A random-access iterator wrapping a pointer into the elements of a
+/// small_vectort. Unlike a raw pointer, it is a class type, and thus provides
+/// member typedefs and can be incremented when it is a temporary.
+template <typename T>
+class small_vector_iteratort
+{
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = typename std::remove_const<T>::type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T *;
+  using reference = T &;
+
+  small_vector_iteratort() = default;
+
+  explicit small_vector_iteratort(T *p) : p(p)
+  {
+  }
+
+  /// Conversion from iterator to const_iterator
+  template <
+    typename U,
+    typename = typename std::enable_if<
+      std::is_same<const U, T>::value && !std::is_same<U, T>::value>::type>
+  // NOLINTNEXTLINE(runtime/explicit)
+  small_vector_iteratort(const small_vector_iteratort<U> &other)
+    : p(other.base())
+  {
+  }
+
+  T *base() const
+  {
+    return p;
+  }
+
+  reference operator*() const
+  {
+    return *p;
+  }
+
+  pointer operator->() const
+  {
+    return p;
+  }
+
+  reference operator[](difference_type n) const
+  {
+    return p[n];
+  }
+
+  small_vector_iteratort &operator++()
+  {
+    ++p;
+    return *this;
+  }
+
+  small_vector_iteratort operator++(int)
+  {
+    return small_vector_iteratort(p++);
+  }
+
+  small_vector_iteratort &operator--()
+  {
+    --p;
+    return *this;
+  }
+
+  small_vector_iteratort operator--(int)
+  {
+    return small_vector_iteratort(p--);
+  }
+
+  small_vector_iteratort &operator+=(difference_type n)
+  {
+    p += n;
+    return *this;
+  }
+
+  small_vector_iteratort &operator-=(difference_type n)
+  {
+    p -= n;
+    return *this;
+  }
+
+  small_vector_iteratort operator+(difference_type n) const
+  {
+    return small_vector_iteratort(p + n);
+  }
+
+  friend small_vector_iteratort
+  operator+(difference_type n, const small_vector_iteratort &it)
+  {
+    return it + n;
+  }
+
+  small_vector_iteratort operator-(difference_type n) const
+  {
+    return small_vector_iteratort(p - n);
+  }
+
+  template <typename U>
+  difference_type operator-(const small_vector_iteratort<U> &other) const
+  {
+    return p - other.base();
+  }
+
+  template <typename U>
+  bool operator==(const small_vector_iteratort<U> &other) const
+  {
+    return p == other.base();
+  }
+
+  template <typename U>
+  bool operator!=(const small_vector_iteratort<U> &other) const
+  {
+    return p != other.base();
+  }
+
+  template <typename U>
+  bool operator<(const small_vector_iteratort<U> &other) const
+  {
+    return p < other.base();
+  }
+
+  template <typename U>
+  bool operator>(const small_vector_iteratort<U> &other) const
+  {
+    return p > other.base();
+  }
+
+  template <typename U>
+  bool operator<=(const small_vector_iteratort<U> &other) const
+  {
+    return p <= other.base();
+  }
+
+  template <typename U>
+  bool operator>=(const small_vector_iteratort<U> &other) const
+  {
+    return p >= other.base();
+  }
+
+private:
+  T *p = nullptr;
+};
+
+/// A sequence container with the interface of `std::vector` that stores up to
+/// \p N elements within the object itself, and only allocates memory from the
+/// heap once more elements are added. This avoids an allocation for vectors
+/// that most of the time hold very few elements, such as the operands of
+/// expressions.
+///
+/// Unlike `std::vector`, moving a small_vectort holding no more than \p N
+/// elements moves the elements individually, and thereby invalidates
+/// iterators and references. The inline storage shares its space with the
+/// pointer to heap storage, and sizes are held in 32 bits, so that for
+/// \p N = 2 and pointer-sized elements a small_vectort is no larger than a
+/// `std::vector`.
+///
+/// \tparam T: element type
+/// \tparam N: number of elements stored inline
+/// \tparam slot_size: space reserved for each element stored inline; this
+///   may be given explicitly to permit using small_vectort as a member of a
+///   class that \p T itself is derived from, where \p T is still incomplete
+template <typename T, std::size_t N, std::size_t slot_size = sizeof(T)>
+class small_vectort
+{
+  static_assert(N > 0, "inline storage must hold at least one element");
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using iterator = small_vector_iteratort<T>;
+  using const_iterator = small_vector_iteratort<const T>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  small_vectort()
+  {
+  }
+
+  explicit small_vectort(size_type n) : small_vectort()
+  {
+    resize(n);
+  }
+
+  small_vectort(size_type n, const T &value) : small_vectort()
+  {
+    resize(n, value);
+  }
+
+  template <
+    typename input_iteratort,
+    typename = typename std::enable_if<
+      !std::is_integral<input_iteratort>::value>::type>
+  small_vectort(input_iteratort first, input_iteratort last) : small_vectort()
+  {
+    insert(end(), first, last);
+  }
+
+  small_vectort(std::initializer_list<T> list)
+    : small_vectort(list.begin(), list.end())
+  {
+  }
+
+  small_vectort(const small_vectort &other) : small_vectort()
+  {
+    reserve(other.size());
+    for(const auto &element : other)
+      push_back(element);
+  }
+
+  small_vectort(small_vectort &&other) noexcept : small_vectort()
+  {
+    steal(other);
+  }
+
+  // NOLINTNEXTLINE(runtime/explicit)
+  small_vectort(const std::vector<T> &other)
+    : small_vectort(other.begin(), other.end())
+  {
+  }
+
+  ~small_vectort()
+  {
+    clear();
+    release();
+  }
+
+  small_vectort &operator=(const small_vectort &other)
+  {
+    if(this != &other)
+    {
+      clear();
+      reserve(other.size());
+      for(const auto &element : other)
+        push_back(element);
+    }
+    return *this;
+  }
+
+  small_vectort &operator=(small_vectort &&other) noexcept
+  {
+    if(this != &other)
+    {
+      clear();
+      release();
+      reserved = N;
+      steal(other);
+    }
+    return *this;
+  }
+
+  small_vectort &operator=(std::initializer_list<T> list)
+  {
+    clear();
+    insert(end(), list.begin(), list.end());
+    return *this;
+  }
+
+  operator std::vector<T>() const
+  {
+    return std::vector<T>(begin(), end());
+  }
+
+  iterator begin()
+  {
+    return iterator(data());
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(data());
+  }
+
+  const_iterator cbegin() const
+  {
+    return const_iterator(data());
+  }
+
+  iterator end()
+  {
+    return iterator(data() + count);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(data() + count);
+  }
+
+  const_iterator cend() const
+  {
+    return const_iterator(data() + count);
+  }
+
+  reverse_iterator rbegin()
+  {
+    return reverse_iterator(end());
+  }
+
+  const_reverse_iterator rbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend()
+  {
+    return reverse_iterator(begin());
+  }
+
+  const_reverse_iterator rend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  size_type size() const
+  {
+    return count;
+  }
+
+  bool empty() const
+  {
+    return count == 0;
+  }
+
+  size_type capacity() const
+  {
+    return reserved;
+  }
+
+  /// \return true if the elements are stored within the object itself
+  bool is_inline() const
+  {
+    return reserved == N;
+  }
+
+  T *data()
+  {
+    return is_inline() ? inline_data() : heap;
+  }
+
+  const T *data() const
+  {
+    return is_inline() ? inline_data() : heap;
+  }
+
+  T &operator[](size_type i)
+  {
+    return data()[i];
+  }
+
+  const T &operator[](size_type i) const
+  {
+    return data()[i];
+  }
+
+  T &at(size_type i)
+  {
+    PRECONDITION(i < count);
+    return data()[i];
+  }
+
+  const T &at(size_type i) const
+  {
+    PRECONDITION(i < count);
+    return data()[i];
+  }
+
+  T &front()
+  {
+    return data()[0];
+  }
+
+  const T &front() const
+  {
+    return data()[0];
+  }
+
+  T &back()
+  {
+    return data()[count - 1];
+  }
+
+  const T &back() const
+  {
+    return data()[count - 1];
+  }
+
+  void reserve(size_type n)
+  {
+    if(n <= reserved)
+      return;
+
+    PRECONDITION(n <= std::numeric_limits<std::uint32_t>::max());
+
+    T *old_p = data();
+    T *new_p = static_cast<T *>(::operator new(n * sizeof(T)));
+    for(size_type i = 0; i < count; ++i)
+    {
+      new(new_p + i) T(std::move(old_p[i]));
+      old_p[i].~T();
+    }
+
+    release();
+    heap = new_p;
+    reserved = static_cast<std::uint32_t>(n);
+  }
+
+  void shrink_to_fit()
+  {
+  }
+
+  void clear()
+  {
+    for(size_type i = 0; i < count; ++i)
+      data()[i].~T();
+    count = 0;
+  }
+
+  void push_back(const T &value)
+  {
+    emplace_back(value);
+  }
+
+  void push_back(T &&value)
+  {
+    emplace_back(std::move(value));
+  }
+
+  template <typename... argst>
+  T &emplace_back(argst &&... args)
+  {
+    if(count == reserved)
+    {
+      // construct first, as the arguments may refer to an element
+      T tmp(std::forward<argst>(args)...);
+      reserve(grown_capacity(count + 1));
+      new(data() + count) T(std::move(tmp));
+    }
+    else
+      new(data() + count) T(std::forward<argst>(args)...);
+
+    return data()[count++];
+  }
+
+  void pop_back()
+  {
+    PRECONDITION(count > 0);
+    data()[--count].~T();
+  }
+
+  void resize(size_type n)
+  {
+    if(n < count)
+      erase(begin() + n, end());
+    else
+    {
+      reserve(n);
+      while(count < n)
+        new(data() + count++) T();
+    }
+  }
+
+  void resize(size_type n, const T &value)
+  {
+    if(n < count)
+      erase(begin() + n, end());
+    else
+      insert(end(), n - count, value);
+  }
+
+  iterator insert(const_iterator pos, const T &value)
+  {
+    return insert(pos, size_type(1), value);
+  }
+
+  iterator insert(const_iterator pos, T &&value)
+  {
+    const size_type index = pos - begin();
+    emplace_back(std::move(value));
+    std::rotate(begin() + index, end() - 1, end());
+    return begin() + index;
+  }
+
+  iterator insert(const_iterator pos, size_type n, const T &value)
+  {
+    const size_type index = pos - begin();
+    if(n == 0)
+      return begin() + index;
+    // copy first, as value may refer to an element
+    T tmp(value);
+    if(count + n > reserved)
+      reserve(grown_capacity(count + n));
+    for(size_type i = 0; i < n; ++i)
+      new(data() + count++) T(tmp);
+    std::rotate(begin() + index, end() - n, end());
+    return begin() + index;
+  }
+
+  template <
+    typename input_iteratort,
+    typename = typename std::enable_if<
+      !std::is_integral<input_iteratort>::value>::type>
+  iterator
+  insert(const_iterator pos, input_iteratort first, input_iteratort last)
+  {
+    const size_type index = pos - begin();
+    const size_type old_count = count;
+    for(; first != last; ++first)
+      emplace_back(*first);
+    std::rotate(begin() + index, begin() + old_count, end());
+    return begin() + index;
+  }
+
+  iterator insert(const_iterator pos, std::initializer_list<T> list)
+  {
+    return insert(pos, list.begin(), list.end());
+  }
+
+  iterator erase(const_iterator pos)
+  {
+    return erase(pos, pos + 1);
+  }
+
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    iterator dest = begin() + (first - cbegin());
+    iterator src = begin() + (last - cbegin());
+    iterator new_end = std::move(src, end(), dest);
+    for(iterator it = new_end; it != end(); ++it)
+      it->~T();
+    count = static_cast<std::uint32_t>(new_end - begin());
+    return dest;
+  }
+
+  template <typename input_iteratort>
+  void assign(input_iteratort first, input_iteratort last)
+  {
+    clear();
+    insert(end(), first, last);
+  }
+
+  void swap(small_vectort &other)
+  {
+    if(!is_inline() && !other.is_inline())
+    {
+      std::swap(heap, other.heap);
+      std::swap(count, other.count);
+      std::swap(reserved, other.reserved);
+    }
+    else
+    {
+      small_vectort tmp(std::move(other));
+      other = std::move(*this);
+      *this = std::move(tmp);
+    }
+  }
+
+  bool operator==(const small_vectort &other) const
+  {
+    return count == other.count && std::equal(begin(), end(), other.begin());
+  }
+
+  bool operator!=(const small_vectort &other) const
+  {
+    return !(*this == other);
+  }
+
+  bool operator<(const small_vectort &other) const
+  {
+    return std::lexicographical_compare(
+      begin(), end(), other.begin(), other.end());
+  }
+
+protected:
+  // The capacity is N exactly when the elements are stored inline.
+  std::uint32_t count = 0;
+  std::uint32_t reserved = N;
+  // the largest power of two dividing the slot size, up to the alignment
+  // of any scalar type
+  static constexpr std::size_t slot_alignment =
+    (slot_size & (~slot_size + 1)) < alignof(std::max_align_t)
+      ? (slot_size & (~slot_size + 1))
+      : alignof(std::max_align_t);
+
+  union
+  {
+    T *heap;
+    typename std::aligned_storage<N * slot_size, slot_alignment>::type storage;
+  };
+
+  T *inline_data()
+  {
+    static_assert(sizeof(T) <= slot_size, "elements must fit their slots");
+    static_assert(alignof(T) <= slot_alignment, "slots must be aligned");
+    return reinterpret_cast<T *>(&storage);
+  }
+
+  const T *inline_data() const
+  {
+    static_assert(sizeof(T) <= slot_size, "elements must fit their slots");
+    static_assert(alignof(T) <= slot_alignment, "slots must be aligned");
+    return reinterpret_cast<const T *>(&storage);
+  }
+
+  /// \return the capacity to grow to in order to hold \p n elements
+  size_type grown_capacity(size_type n) const
+  {
+    return std::max(n, 2 * size_type(reserved));
+  }
+
+  /// Free the heap storage, if any
+  void release()
+  {
+    if(!is_inline())
+      ::operator delete(heap);
+  }
+
+  /// Take the elements of \p other, which must be a different object, and
+  /// leave it empty; this object must be empty and use inline storage
+  void steal(small_vectort &other)
+  {
+    if(other.is_inline())
+    {
+      for(size_type i = 0; i < other.count; ++i)
+        new(inline_data() + i) T(std::move(other.inline_data()[i]));
+      count = other.count;
+      other.clear();
+    }
+    else
+    {
+      heap = other.heap;
+      count = other.count;
+      reserved = other.reserved;
+      other.count = 0;
+      other.reserved = N;
+    }
+  }
+};
+
+template <typename T, std::size_t N, std::size_t slot_size>
+void swap(
+  small_vectort<T, N, slot_size> &a,
+  small_vectort<T, N, slot_size> &b)
+{
+  a.swap(b);
+}
+
+#endif // CPROVER_UTIL_SMALL_VECTOR_H
@@ -0,0 +1,249 @@
+/*******************************************************************\
+
+Module: Maps as Sorted Vectors with Inline Storage
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Maps as Sorted Vectors with Inline Storage
+
+#ifndef CPROVER_UTIL_SORTED_VECTOR_MAP_H
+#define CPROVER_UTIL_SORTED_VECTOR_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+#include "small_vector.h"
+
+/// A map from \p keyt to \p valuet stored as a vector of key-value pairs
+/// sorted by their keys, of which the first \p N are held without any heap
+/// allocation. Lookup is a binary search and insertion moves the elements
+/// after the new one, so this is meant for small maps that are iterated and
+/// merged more often than they are modified, such as the sets of objects a
+/// pointer may point to. Iterating two such maps in step is a linear merge,
+/// without the pointer chasing of a std::map.
+///
+/// The interface follows that of a std::map, except that the elements are
+/// pairs with a non-const key, iterators are invalidated by insertion and
+/// erasure, and keys must not be changed through an iterator.
+template <typename keyt, typename valuet, std::size_t N = 4>
+class sorted_vector_mapt
+{
+public:
+  using key_type = keyt;
+  using mapped_type = valuet;
+  using value_type = std::pair<keyt, valuet>;
+  using size_type = std::size_t;
+
+protected:
+  using containert = small_vectort<value_type, N>;
+
+public:
+  using iterator = typename containert::iterator;
+  using const_iterator = typename containert::const_iterator;
+
+  sorted_vector_mapt() = default;
+
+  sorted_vector_mapt(std::initializer_list<value_type> list)
+  {
+    insert(list.begin(), list.end());
+  }
+
+  iterator begin()
+  {
+    return elements.begin();
+  }
+
+  const_iterator begin() const
+  {
+    return elements.begin();
+  }
+
+  iterator end()
+  {
+    return elements.end();
+  }
+
+  const_iterator end() const
+  {
+    return elements.end();
+  }
+
+  size_type size() const
+  {
+    return elements.size();
+  }
+
+  bool empty() const
+  {
+    return elements.empty();
+  }
+
+  void clear()
+  {
+    elements.clear();
+  }
+
+  void reserve(size_type n)
+  {
+    elements.reserve(n);
+  }
+
+  void swap(sorted_vector_mapt &other)
+  {
+    elements.swap(other.elements);
+  }
+
+  /// \return the first element whose key is not less than \p key
+  iterator lower_bound(const keyt &key)
+  {
+    return std::lower_bound(elements.begin(), elements.end(), key, key_less);
+  }
+
+  const_iterator lower_bound(const keyt &key) const
+  {
+    return std::lower_bound(elements.begin(), elements.end(), key, key_less);
+  }
+
+  iterator find(const keyt &key)
+  {
+    auto it = lower_bound(key);
+    return it != end() && !(key < it->first) ? it : end();
+  }
+
+  const_iterator find(const keyt &key) const
+  {
+    auto it = lower_bound(key);
+    return it != end() && !(key < it->first) ? it : end();
+  }
+
+  size_type count(const keyt &key) const
+  {
+    return find(key) != end() ? 1 : 0;
+  }
+
+  /// Insert \p value unless there is an element with the same key already
+  /// \return the element with the key of \p value, and whether it was
+  ///   inserted
+  std::pair<iterator, bool> insert(const value_type &value)
+  {
+    auto it = lower_bound(value.first);
+    if(it != end() && !(value.first < it->first))
+      return {it, false};
+    return {elements.insert(it, value), true};
+  }
+
+  template <typename input_iteratort>
+  void insert(input_iteratort first, input_iteratort last)
+  {
+    for(; first != last; ++first)
+      insert(*first);
+  }
+
+  /// \return the value of \p key, which is default-constructed and inserted
+  ///   if there is none
+  valuet &operator[](const keyt &key)
+  {
+    auto it = lower_bound(key);
+    if(it == end() || key < it->first)
+      it = elements.insert(it, value_type(key, valuet()));
+    return it->second;
+  }
+
+  /// Append \p value, whose key must be greater than the keys of all
+  /// elements, such as when building the result of a merge in order
+  void push_back(value_type value)
+  {
+    PRECONDITION(empty() || elements.back().first < value.first);
+    elements.push_back(std::move(value));
+  }
+
+  /// Insert the elements of \p other whose keys are not in this map, and call
+  /// `merge_value(value, other_value)` for those whose keys are. This is a
+  /// single merge of the two sorted vectors, in place from the back, which
+  /// moves each element of this map at most once.
+  template <typename merge_valuet>
+  void merge(const sorted_vector_mapt &other, merge_valuet merge_value)
+  {
+    size_type missing = 0;
+    {
+      auto it = elements.begin();
+      for(const auto &o : other.elements)
+      {
+        while(it != elements.end() && it->first < o.first)
+          ++it;
+        if(it == elements.end() || o.first < it->first)
+          ++missing;
+        else
+          merge_value(it->second, o.second);
+      }
+    }
+
+    if(missing == 0)
+      return;
+
+    size_type i = elements.size();
+    size_type j = other.elements.size();
+    size_type dest = i + missing;
+    elements.resize(dest);
+    while(j > 0)
+    {
+      const value_type &o = other.elements[j - 1];
+      if(i > 0 && !(elements[i - 1].first < o.first))
+      {
+        // the keys in both have been merged above already
+        if(!(o.first < elements[i - 1].first))
+          --j;
+        --dest;
+        --i;
+        if(dest != i)
+          elements[dest] = std::move(elements[i]);
+      }
+      else
+      {
+        elements[--dest] = o;
+        --j;
+      }
+    }
+  }
+
+  iterator erase(const_iterator it)
+  {
+    return elements.erase(it);
+  }
+
+  /// \return the number of elements erased, which is zero or one
+  size_type erase(const keyt &key)
+  {
+    auto it = find(key);
+    if(it == end())
+      return 0;
+    elements.erase(it);
+    return 1;
+  }
+
+  bool operator==(const sorted_vector_mapt &other) const
+  {
+    return elements == other.elements;
+  }
+
+  bool operator!=(const sorted_vector_mapt &other) const
+  {
+    return !(*this == other);
+  }
+
+protected:
+  /// Sorted by key, without duplicate keys
+  containert elements;
+
+  static bool key_less(const value_type &element, const keyt &key)
+  {
+    return element.first < key;
+  }
+};
+
+#endif // CPROVER_UTIL_SORTED_VECTOR_MAP_H
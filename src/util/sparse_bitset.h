@@ -0,0 +1,339 @@
+/*******************************************************************\
+
+Module: Sets of Small Integers as Sparse Bit Vectors
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Sets of Small Integers as Sparse Bit Vectors
+
+#ifndef CPROVER_UTIL_SPARSE_BITSET_H
+#define CPROVER_UTIL_SPARSE_BITSET_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "invariant.h"
+
+/// A set of non-negative integers, stored as a vector of 64-bit words sorted
+/// by their index, where word i holds the elements 64*i to 64*i+63. Words
+/// without any elements are omitted. This is meant for sets of identifiers
+/// handed out consecutively, such as the definitions in reaching definitions
+/// analysis: those of one variable tend to cluster, and union and difference
+/// of two sets then take one bitwise operation per word rather than one
+/// comparison per element, and no allocation per element as in a std::set.
+class sparse_bitsett
+{
+public:
+  typedef std::uint64_t wordt;
+  static constexpr std::size_t word_bits = 64;
+
+protected:
+  struct blockt
+  {
+    std::size_t index;
+    wordt bits;
+
+    bool operator==(const blockt &other) const
+    {
+      return index == other.index && bits == other.bits;
+    }
+  };
+
+public:
+  /// Iterates over the elements in increasing order
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::size_t *;
+    using reference = std::size_t;
+
+    std::size_t operator*() const
+    {
+      PRECONDITION(bits != 0);
+      return block->index * word_bits + count_trailing_zeros(bits);
+    }
+
+    const_iterator &operator++()
+    {
+      // clear the lowest bit set
+      bits &= bits - 1;
+      if(bits == 0)
+      {
+        ++block;
+        if(block != end)
+          bits = block->bits;
+      }
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const
+    {
+      return block == other.block && bits == other.bits;
+    }
+
+    bool operator!=(const const_iterator &other) const
+    {
+      return !(*this == other);
+    }
+
+  private:
+    friend class sparse_bitsett;
+
+    typedef std::vector<blockt>::const_iterator block_itt;
+
+    const_iterator(block_itt block, block_itt end)
+      : block(block), end(end), bits(block == end ? 0 : block->bits)
+    {
+    }
+
+    block_itt block, end;
+
+    /// The elements of the current block not yet visited
+    wordt bits;
+  };
+
+  bool empty() const
+  {
+    return blocks.empty();
+  }
+
+  std::size_t size() const
+  {
+    std::size_t result = 0;
+    for(const auto &b : blocks)
+      result += count_ones(b.bits);
+    return result;
+  }
+
+  void clear()
+  {
+    blocks.clear();
+  }
+
+  void swap(sparse_bitsett &other)
+  {
+    blocks.swap(other.blocks);
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(blocks.begin(), blocks.end());
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(blocks.end(), blocks.end());
+  }
+
+  bool contains(std::size_t element) const
+  {
+    const auto it = find_block(element / word_bits);
+    return it != blocks.end() && it->index == element / word_bits &&
+           (it->bits & mask(element)) != 0;
+  }
+
+  /// Add \p element
+  /// \return true iff it was not an element before
+  bool insert(std::size_t element)
+  {
+    const std::size_t index = element / word_bits;
+    auto it = find_block(index);
+    if(it == blocks.end() || it->index != index)
+    {
+      blocks.insert(it, blockt{index, mask(element)});
+      return true;
+    }
+
+    if((it->bits & mask(element)) != 0)
+      return false;
+
+    it->bits |= mask(element);
+    return true;
+  }
+
+  /// Remove \p element
+  /// \return true iff it was an element before
+  bool erase(std::size_t element)
+  {
+    const std::size_t index = element / word_bits;
+    auto it = find_block(index);
+    if(
+      it == blocks.end() || it->index != index ||
+      (it->bits & mask(element)) == 0)
+    {
+      return false;
+    }
+
+    it->bits &= ~mask(element);
+    if(it->bits == 0)
+      blocks.erase(it);
+    return true;
+  }
+
+  /// Add all elements of \p other
+  /// \return true iff any of them was not an element before
+  bool insert(const sparse_bitsett &other)
+  {
+    if(other.blocks.empty())
+      return false;
+
+    if(blocks.empty())
+    {
+      blocks = other.blocks;
+      return true;
+    }
+
+    // Merge in place, from the back, so that each block is moved at most
+    // once. Most merges of reaching definitions add nothing, so check for
+    // that first, without touching this set.
+    std::size_t missing = 0;
+    bool changed = false;
+    {
+      auto it = blocks.begin();
+      for(const auto &o : other.blocks)
+      {
+        while(it != blocks.end() && it->index < o.index)
+          ++it;
+        if(it == blocks.end() || it->index != o.index)
+        {
+          ++missing;
+          changed = true;
+        }
+        else if((o.bits & ~it->bits) != 0)
+          changed = true;
+      }
+    }
+
+    if(!changed)
+      return false;
+
+    std::size_t dest = blocks.size() + missing;
+    std::size_t i = blocks.size();
+    std::size_t j = other.blocks.size();
+    blocks.resize(dest);
+    while(j > 0)
+    {
+      const blockt &o = other.blocks[j - 1];
+      if(i > 0 && blocks[i - 1].index > o.index)
+        blocks[--dest] = blocks[--i];
+      else if(i > 0 && blocks[i - 1].index == o.index)
+      {
+        blocks[--dest] = blockt{o.index, blocks[--i].bits | o.bits};
+        --j;
+      }
+      else
+      {
+        blocks[--dest] = o;
+        --j;
+      }
+    }
+
+    INVARIANT(dest == i, "the blocks of this set below the merge stay put");
+    return true;
+  }
+
+  /// Remove all elements of \p other
+  /// \return true iff any of them was an element before
+  bool erase(const sparse_bitsett &other)
+  {
+    bool changed = false;
+    auto dest = blocks.begin();
+    auto o = other.blocks.begin();
+    for(auto it = blocks.begin(); it != blocks.end(); ++it)
+    {
+      while(o != other.blocks.end() && o->index < it->index)
+        ++o;
+
+      wordt bits = it->bits;
+      if(o != other.blocks.end() && o->index == it->index)
+      {
+        changed |= (bits & o->bits) != 0;
+        bits &= ~o->bits;
+      }
+
+      if(bits != 0)
+        *dest++ = blockt{it->index, bits};
+    }
+
+    blocks.erase(dest, blocks.end());
+    return changed;
+  }
+
+  bool operator==(const sparse_bitsett &other) const
+  {
+    return blocks == other.blocks;
+  }
+
+  bool operator!=(const sparse_bitsett &other) const
+  {
+    return !(*this == other);
+  }
+
+protected:
+  /// Sorted by index, and without blocks whose bits are all zero
+  std::vector<blockt> blocks;
+
+  static wordt mask(std::size_t element)
+  {
+    return wordt(1) << (element % word_bits);
+  }
+
+  std::vector<blockt>::iterator find_block(std::size_t index)
+  {
+    return std::lower_bound(
+      blocks.begin(), blocks.end(), index, [](const blockt &b, std::size_t i) {
+        return b.index < i;
+      });
+  }
+
+  std::vector<blockt>::const_iterator find_block(std::size_t index) const
+  {
+    return std::lower_bound(
+      blocks.begin(), blocks.end(), index, [](const blockt &b, std::size_t i) {
+        return b.index < i;
+      });
+  }
+
+  static std::size_t count_trailing_zeros(wordt bits)
+  {
+    PRECONDITION(bits != 0);
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctzll(bits));
+#else
+    std::size_t result = 0;
+    for(; (bits & 1) == 0; bits >>= 1)
+      ++result;
+    return result;
+#endif
+  }
+
+  static std::size_t count_ones(wordt bits)
+  {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_popcountll(bits));
+#else
+    std::size_t result = 0;
+    for(; bits != 0; bits &= bits - 1)
+      ++result;
+    return result;
+#endif
+  }
+};
+
+#endif // CPROVER_UTIL_SPARSE_BITSET_H
@@ -9,7 +9,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "ssa_expr.h"
 
 #include <sstream>
+#include <unordered_map>
 
+#include "irep_hash.h"
 #include "pointer_expr.h"
 
 /// If \p expr is:
@@ -123,15 +125,100 @@ static std::pair<irep_idt, irep_idt> build_identifier(
   return std::make_pair(irep_idt(oss.str()), irep_idt(l1_object_oss.str()));
 }
 
+namespace
+{
+/// The identifier of the root symbol of an original expression, the member
+/// and index suffixes following it, and the levels: as the levels are put
+/// between the former two, these determine the identifiers built by
+/// \ref build_identifier
+struct ssa_identifier_keyt
+{
+  irep_idt root;
+  irep_idt path;
+  irep_idt l0;
+  irep_idt l1;
+  irep_idt l2;
+
+  bool operator==(const ssa_identifier_keyt &other) const
+  {
+    return root == other.root && path == other.path && l0 == other.l0 && l1 == other.l1 &&
+           l2 == other.l2;
+  }
+};
+
+struct ssa_identifier_key_hasht
+{
+  std::size_t operator()(const ssa_identifier_keyt &key) const
+  {
+    std::size_t result = key.root.hash();
+    result = hash_combine(result, key.path.hash());
+    result = hash_combine(result, key.l0.hash());
+    result = hash_combine(result, key.l1.hash());
+    return hash_combine(result, key.l2.hash());
+  }
+};
+} // namespace
+
+/// \return the identifier of the root symbol of \p expr, with the member and
+///   index suffixes of \p expr added to \p path_os
+static const irep_idt &
+root_identifier(const exprt &expr, std::ostream &path_os)
+{
+  if(expr.id() == ID_member)
+  {
+    const member_exprt &member = to_member_expr(expr);
+    const irep_idt &root = root_identifier(member.struct_op(), path_os);
+    path_os << ".." << member.get_component_name();
+    return root;
+  }
+  else if(expr.id() == ID_index)
+  {
+    const index_exprt &index = to_index_expr(expr);
+    const irep_idt &root = root_identifier(index.array(), path_os);
+    path_os << "[[" << to_constant_expr(index.index()).get_value() << "]]";
+    return root;
+  }
+  else
+    return to_symbol_expr(expr).get_identifier();
+}
+
 static void update_identifier(ssa_exprt &ssa)
 {
-  const irep_idt &l0 = ssa.get_level_0();
-  const irep_idt &l1 = ssa.get_level_1();
-  const irep_idt &l2 = ssa.get_level_2();
+  // Levels change all the time during renaming, mostly to values seen
+  // before, so the identifiers are looked up by the numbers of their parts
+  // rather than built and hashed as strings each time.
+  static std::unordered_map<
+    ssa_identifier_keyt,
+    std::pair<irep_idt, irep_idt>,
+    ssa_identifier_key_hasht>
+    cache;
+
+  const exprt &original_expr = ssa.get_original_expr();
+  ssa_identifier_keyt key;
+  if(original_expr.id() == ID_symbol)
+  {
+    // the common case, which doesn't need any string to be built
+    key.root = to_symbol_expr(original_expr).get_identifier();
+  }
+  else
+  {
+    std::ostringstream path_os;
+    key.root = root_identifier(original_expr, path_os);
+    key.path = path_os.str();
+  }
+  key.l0 = ssa.get_level_0();
+  key.l1 = ssa.get_level_1();
+  key.l2 = ssa.get_level_2();
+
+  auto entry = cache.find(key);
+  if(entry == cache.end())
+  {
+    auto idpair = build_identifier(original_expr, key.l0, key.l1, key.l2);
+    entry = cache.emplace(std::move(key), std::move(idpair)).first;
+  }
 
-  auto idpair = build_identifier(ssa.get_original_expr(), l0, l1, l2);
-  ssa.set_identifier(idpair.first);
-  ssa.set(ID_L1_object_identifier, idpair.second);
+  ssa.set_identifier(entry->second.first);
+  ssa.set(ID_L1_object_identifier, entry->second.second);
 }
 
 void ssa_exprt::set_expression(exprt expr)
@@ -171,7 +171,7 @@ public:
   {
   }
 
-  typedef std::vector<codet> code_operandst;
+  typedef irep_sub_containert<codet> code_operandst;
 
   code_operandst &statements()
   {
@@ -2292,7 +2292,7 @@ public:
     }
   };
 
-  typedef std::vector<exception_list_entryt> exception_listt;
+  typedef irep_sub_containert<exception_list_entryt> exception_listt;
 
   code_push_catcht(
     const irep_idt &tag,
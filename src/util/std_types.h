@@ -131,7 +131,7 @@ public:
     }
   };
 
-  typedef std::vector<componentt> componentst;
+  typedef irep_sub_containert<componentt> componentst;
 
   struct_union_typet(const irep_idt &_id, componentst _components) : typet(_id)
   {
@@ -250,7 +250,7 @@ public:
     explicit baset(struct_tag_typet base);
   };
 
-  typedef std::vector<baset> basest;
+  typedef irep_sub_containert<baset> basest;
 
   /// Get the collection of base classes/structs.
   const basest &bases() const
@@ -533,7 +533,7 @@ class code_typet:public typet
 {
 public:
   class parametert;
-  typedef std::vector<parametert> parameterst;
+  typedef irep_sub_containert<parametert> parameterst;
 
   /// Constructs a new code type, i.e., function type.
   /// \param _parameters: The vector of function parameters.
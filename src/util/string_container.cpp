@@ -11,6 +11,9 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "string_container.h"
 
+#include "invariant.h"
+#include "narrow.h"
+
 #include <cstring>
 #include <iostream>
 #include <numeric>
@@ -27,85 +30,91 @@ bool string_ptrt::operator==(const string_ptrt &other) const
   return len==0 || memcmp(s, other.s, len)==0;
 }
 
+constexpr std::size_t string_containert::number_of_shards;
+constexpr std::size_t string_containert::chunk_bits;
+constexpr std::size_t string_containert::chunk_size;
+constexpr std::size_t string_containert::max_chunks;
+
 string_containert::~string_containert()
 {
 }
 
-unsigned string_containert::get(const char *s)
+unsigned string_containert::get(const string_ptrt &string_ptr)
 {
-  string_ptrt string_ptr(s);
-
-  hash_tablet::iterator it=hash_table.find(string_ptr);
-
-  if(it!=hash_table.end())
-    return it->second;
-
-  size_t r=hash_table.size();
-
-  // these are stable
-  string_list.push_back(std::string(s));
-  string_ptrt result(string_list.back());
+  const std::size_t hash = string_ptr_hash()(string_ptr);
+  shardt &shard = shards[(hash ^ (hash >> 16)) % number_of_shards];
 
-  hash_table[result]=r;
+  std::lock_guard<std::mutex> shard_lock(shard.mutex);
 
-  // these are not
-  string_vector.push_back(&string_list.back());
+  hash_tablet::iterator it = shard.hash_table.find(string_ptr);
 
-  return r;
-}
-
-unsigned string_containert::get(const std::string &s)
-{
-  string_ptrt string_ptr(s);
+  if(it != shard.hash_table.end())
+    return it->second;
 
-  hash_tablet::iterator it=hash_table.find(string_ptr);
+  std::size_t r;
+  const std::string *stored;
+  {
+    std::lock_guard<std::mutex> index_lock(index_mutex);
 
-  if(it!=hash_table.end())
-    return it->second;
+    r = string_count;
+    INVARIANT(
+      r >> chunk_bits < max_chunks, "string container should not overflow");
 
-  size_t r=hash_table.size();
+    std::unique_ptr<std::string[]> &chunk = chunks[r >> chunk_bits];
+    if(!chunk)
+      chunk.reset(new std::string[chunk_size]);
 
-  // these are stable
-  string_list.push_back(s);
-  string_ptrt result(string_list.back());
+    // these are stable
+    std::string &entry = chunk[r & (chunk_size - 1)];
+    entry.assign(string_ptr.s, string_ptr.len);
+    stored = &entry;
 
-  hash_table[result]=r;
+    ++string_count;
+  }
 
-  // these are not
-  string_vector.push_back(&string_list.back());
+  shard.hash_table[string_ptrt(*stored)] = narrow_cast<unsigned>(r);
 
-  return r;
+  return narrow_cast<unsigned>(r);
 }
 
 void string_container_statisticst::dump_on_stream(std::ostream &out) const
 {
   auto total_memory_usage = strings_memory_usage + vector_memory_usage +
-                            map_memory_usage + list_memory_usage;
+                            map_memory_usage + chunk_memory_usage;
   out << "String container statistics:"
       << "\n  string count: " << string_count
       << "\n  string memory usage: " << strings_memory_usage.to_string()
       << "\n  vector memory usage: " << vector_memory_usage.to_string()
       << "\n  map memory usage:    " << map_memory_usage.to_string()
-      << "\n  list memory usage:   " << list_memory_usage.to_string()
+      << "\n  chunk memory usage:  " << chunk_memory_usage.to_string()
       << "\n  total memory usage:  " << total_memory_usage.to_string() << '\n';
 }
 
 string_container_statisticst string_containert::compute_statistics() const
 {
   string_container_statisticst result;
-  result.string_count = string_vector.size();
+  std::size_t strings_memory = 0;
+  std::size_t map_memory = 0;
+
+  for(const auto &shard : shards)
+  {
+    std::lock_guard<std::mutex> shard_lock(shard.mutex);
+    map_memory += sizeof(hash_tablet) +
+                  shard.hash_table.size() * sizeof(hash_tablet::value_type);
+    for(const auto &entry : shard.hash_table)
+      strings_memory += get_string(entry.second).capacity();
+  }
+
+  std::lock_guard<std::mutex> index_lock(index_mutex);
+  result.string_count = string_count;
+  result.strings_memory_usage = memory_sizet::from_bytes(strings_memory);
   result.vector_memory_usage = memory_sizet::from_bytes(
-    sizeof(string_vector) +
-    sizeof(string_vectort::value_type) * string_vector.capacity());
-  result.strings_memory_usage = memory_sizet::from_bytes(std::accumulate(
-    begin(string_vector),
-    end(string_vector),
-    std::size_t(0),
-    [](std::size_t sz, const std::string *s) { return sz + s->capacity(); }));
-  result.map_memory_usage = memory_sizet::from_bytes(
-    sizeof(hash_table) + hash_table.size() * sizeof(hash_tablet::value_type));
-
-  result.list_memory_usage = memory_sizet::from_bytes(
-    sizeof(string_list) + 2 * sizeof(void *) * string_list.size());
+    sizeof(chunks) + sizeof(chunkst::value_type) * chunks.capacity());
+  result.map_memory_usage = memory_sizet::from_bytes(map_memory);
+
+  const std::size_t allocated_chunks =
+    (string_count + chunk_size - 1) >> chunk_bits;
+  result.chunk_memory_usage = memory_sizet::from_bytes(
+    allocated_chunks * chunk_size * sizeof(std::string));
   return result;
 }
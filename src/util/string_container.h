@@ -12,7 +12,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_UTIL_STRING_CONTAINER_H
 #define CPROVER_UTIL_STRING_CONTAINER_H
 
-#include <list>
+#include <array>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -55,22 +57,30 @@ struct string_container_statisticst
   memory_sizet strings_memory_usage;
   memory_sizet vector_memory_usage;
   memory_sizet map_memory_usage;
-  memory_sizet list_memory_usage;
+  memory_sizet chunk_memory_usage;
 
   void dump_on_stream(std::ostream &out) const;
 };
 
+/// Interning table for the strings that \ref dstringt refers to by index.
+///
+/// Strings are numbered consecutively in the order in which they are first
+/// added, and neither indices nor the strings they refer to ever move. The
+/// container may be used from several threads at once: the table is split
+/// into shards, selected by the hash of a string, that are locked
+/// independently, and looking up the string for a given index does not
+/// require any locking.
 class string_containert
 {
 public:
   unsigned operator[](const char *s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   unsigned operator[](const std::string &s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   // constructor and destructor
@@ -80,13 +90,13 @@ public:
   // the pointer is guaranteed to be stable
   const char *c_str(size_t no) const
   {
-    return string_vector[no]->c_str();
+    return get_string(no).c_str();
   }
 
   // the reference is guaranteed to be stable
   const std::string &get_string(size_t no) const
   {
-    return *string_vector[no];
+    return chunks[no >> chunk_bits][no & (chunk_size - 1)];
   }
 
   string_container_statisticst compute_statistics() const;
@@ -95,16 +105,30 @@ protected:
   // the 'unsigned' ought to be size_t
   typedef std::unordered_map<string_ptrt, unsigned, string_ptr_hash>
     hash_tablet;
-  hash_tablet hash_table;
 
-  unsigned get(const char *s);
-  unsigned get(const std::string &s);
-
-  typedef std::list<std::string> string_listt;
-  string_listt string_list;
-
-  typedef std::vector<std::string *> string_vectort;
-  string_vectort string_vector;
+  struct shardt
+  {
+    mutable std::mutex mutex;
+    hash_tablet hash_table;
+  };
+
+  static constexpr std::size_t number_of_shards = 16;
+  std::array<shardt, number_of_shards> shards;
+
+  unsigned get(const string_ptrt &);
+
+  /// Strings are stored in chunks of `chunk_size` strings that are never
+  /// re-allocated. The table of chunks is allocated up front so that readers
+  /// never observe it being resized.
+  static constexpr std::size_t chunk_bits = 14;
+  static constexpr std::size_t chunk_size = std::size_t(1) << chunk_bits;
+  static constexpr std::size_t max_chunks = std::size_t(1) << 18;
+  typedef std::vector<std::unique_ptr<std::string[]>> chunkst;
+  chunkst chunks;
+
+  /// Protects `string_count` and the allocation of chunks.
+  mutable std::mutex index_mutex;
+  std::size_t string_count = 0;
 };
 
 /// Get a reference to the global string container.
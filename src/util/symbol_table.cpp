@@ -91,8 +91,10 @@ void symbol_tablet::erase(const symbolst::const_iterator &entry)
 {
   const symbolt &symbol=entry->second;
 
-  auto base_it = symbol_base_map.lower_bound(symbol.base_name);
-  const auto base_it_end = symbol_base_map.upper_bound(symbol.base_name);
+  const auto base_range =
+    internal_symbol_base_map.equal_range(symbol.base_name);
+  auto base_it = base_range.first;
+  const auto base_it_end = base_range.second;
   while(base_it!=base_it_end && base_it->second!=symbol.name)
     ++base_it;
   INVARIANT(
@@ -105,8 +107,10 @@ void symbol_tablet::erase(const symbolst::const_iterator &entry)
 
   if(!symbol.module.empty())
   {
-    auto module_it = symbol_module_map.lower_bound(symbol.module);
-    auto module_it_end = symbol_module_map.upper_bound(symbol.module);
+    const auto module_range =
+      internal_symbol_module_map.equal_range(symbol.module);
+    auto module_it = module_range.first;
+    const auto module_it_end = module_range.second;
     while(module_it != module_it_end && module_it->second != symbol.name)
       ++module_it;
     INVARIANT(
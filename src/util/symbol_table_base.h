@@ -11,8 +11,10 @@
 
 #include "symbol.h"
 
-typedef std::multimap<irep_idt, irep_idt> symbol_base_mapt;
-typedef std::multimap<irep_idt, irep_idt> symbol_module_mapt;
+// hashed rather than ordered, as only the entries of a given name are ever
+// looked up
+typedef std::unordered_multimap<irep_idt, irep_idt> symbol_base_mapt;
+typedef std::unordered_multimap<irep_idt, irep_idt> symbol_module_mapt;
 
 class symbol_tablet;
 
@@ -167,7 +167,7 @@ inline type_with_subtypet &to_type_with_subtype(typet &type)
 class type_with_subtypest:public typet
 {
 public:
-  typedef std::vector<typet> subtypest;
+  typedef irep_sub_containert<typet> subtypest;
 
   type_with_subtypest(const irep_idt &_id, const subtypest &_subtypes)
     : typet(_id)
@@ -202,15 +202,12 @@ bool read_graphml(
   return build_graph(xml, dest, entry);
 }
 
-bool write_graphml(const graphmlt &src, std::ostream &os)
+graphml_writert::graphml_writert(
+  std::ostream &_os,
+  const graphmlt::key_valuest &key_values)
+  : os(_os), entry_done(false)
 {
   xmlt graphml("graphml");
-  graphml.set_attribute(
-    "xmlns:xsi",
-    "http://www.w3.org/2001/XMLSchema-instance");
-  graphml.set_attribute(
-    "xmlns",
-    "http://graphml.graphdrawing.org/xmlns");
 
   // <key attr.name="originFileName" attr.type="string" for="edge"
   //      id="originfile">
@@ -223,8 +220,8 @@ bool write_graphml(const graphmlt &src, std::ostream &os)
     key.set_attribute("for", "edge");
     key.set_attribute("id", "originfile");
 
-    if(src.key_values.find("programfile")!=src.key_values.end())
-      key.new_element("default").data=src.key_values.at("programfile");
+    if(key_values.find("programfile")!=key_values.end())
+      key.new_element("default").data=key_values.at("programfile");
     else
       key.new_element("default").data="<command-line>";
   }
@@ -486,67 +483,130 @@ bool write_graphml(const graphmlt &src, std::ostream &os)
     key.set_attribute("id", "witness-type");
   }
 
-  xmlt &graph=graphml.new_element("graph");
-  graph.set_attribute("edgedefault", "directed");
+  os << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n";
+
+  // the document up to the nodes and edges of the graph, which are written
+  // as they arrive
+  os << "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\" "
+     << "xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\">\n";
+
+  for(const auto &key : graphml.elements)
+    key.output(os, 2);
 
-  for(const auto &kv : src.key_values)
+  os << "  <graph edgedefault=\"directed\">\n";
+
+  for(const auto &kv : key_values)
   {
-    xmlt &data=graph.new_element("data");
+    xmlt data("data");
     data.set_attribute("key", kv.first);
     data.data=kv.second;
+    data.output(os, 4);
   }
+}
 
-  bool entry_done=false;
-  for(graphmlt::node_indext i=0; i<src.size(); ++i)
+void graphml_writert::add_node(const xml_graph_nodet &n)
+{
+  // <node id="A12"/>
+  xmlt node("node");
+  node.set_attribute("id", n.node_name);
+
+  // <node id="A1">
+  //     <data key="entry">true</data>
+  // </node>
+  if(!entry_done && n.node_name!="sink")
   {
-    const graphmlt::nodet &n=src[i];
+    xmlt &entry=node.new_element("data");
+    entry.set_attribute("key", "entry");
+    entry.data="true";
 
-    // <node id="A12"/>
-    xmlt &node=graph.new_element("node");
-    node.set_attribute("id", n.node_name);
+    entry_done=true;
+  }
 
-    // <node id="A1">
-    //     <data key="entry">true</data>
-    // </node>
-    if(!entry_done && n.node_name!="sink")
-    {
-      xmlt &entry=node.new_element("data");
-      entry.set_attribute("key", "entry");
-      entry.data="true";
+  // <node id="A14">
+  //     <data key="violation">true</data>
+  // </node>
+  if(n.is_violation)
+  {
+    xmlt &entry=node.new_element("data");
+    entry.set_attribute("key", "violation");
+    entry.data="true";
+  }
 
-      entry_done=true;
-    }
+  if(n.has_invariant)
+  {
+    xmlt &val=node.new_element("data");
+    val.set_attribute("key", "invariant");
+    val.data=n.invariant;
 
-    // <node id="A14">
-    //     <data key="violation">true</data>
-    // </node>
-    if(n.is_violation)
-    {
-      xmlt &entry=node.new_element("data");
-      entry.set_attribute("key", "violation");
-      entry.data="true";
-    }
+    xmlt &val_s=node.new_element("data");
+    val_s.set_attribute("key", "invariant.scope");
+    val_s.data=n.invariant_scope;
+  }
 
-    if(n.has_invariant)
-    {
-      xmlt &val=node.new_element("data");
-      val.set_attribute("key", "invariant");
-      val.data=n.invariant;
+  node.output(os, 4);
+}
 
-      xmlt &val_s=node.new_element("data");
-      val_s.set_attribute("key", "invariant.scope");
-      val_s.data=n.invariant_scope;
-    }
+void graphml_writert::add_edge(const xmlt &edge)
+{
+  edge.output(os, 4);
+}
 
-    for(graphmlt::edgest::const_iterator
-        e_it=n.out.begin();
-        e_it!=n.out.end();
-        ++e_it)
-      graph.new_element(e_it->second.xml_node);
+bool graphml_writert::finish()
+{
+  os << "  </graph>\n"
+     << "</graphml>\n";
+
+  return !os.good();
+}
+
+graphmlt::node_indext graphml_buildert::node_index(const std::string &name)
+{
+  const auto entry=node_indices.emplace(name, dest.size());
+  if(entry.second)
+  {
+    // nodes may be referred to by edges before they are added themselves
+    const graphmlt::node_indext n=dest.add_node();
+    dest[n].node_name=name;
+    dest[n].is_violation=false;
+    dest[n].has_invariant=false;
   }
 
-  os << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n";
-  os << graphml;
+  return entry.first->second;
+}
 
-  return !os.good();
+void graphml_buildert::add_node(const xml_graph_nodet &n)
+{
+  xml_graph_nodet &node=dest[node_index(n.node_name)];
+  node.file=n.file;
+  node.line=n.line;
+  node.is_violation=n.is_violation;
+  node.has_invariant=n.has_invariant;
+  node.invariant=n.invariant;
+  node.invariant_scope=n.invariant_scope;
+}
+
+void graphml_buildert::add_edge(const xmlt &edge)
+{
+  const graphmlt::node_indext from=node_index(edge.get_attribute("source"));
+  const graphmlt::node_indext to=node_index(edge.get_attribute("target"));
+
+  dest[to].in[from].xml_node=edge;
+  dest[from].out[to].xml_node=edge;
+}
+
+bool write_graphml(const graphmlt &src, std::ostream &os)
+{
+  graphml_writert writer(os, src.key_values);
+
+  for(graphmlt::node_indext i=0; i<src.size(); ++i)
+  {
+    const graphmlt::nodet &n=src[i];
+
+    writer.add_node(n);
+
+    for(const auto &edge : n.out)
+      writer.add_edge(edge.second.xml_node);
+  }
+
+  return writer.finish();
 }
@@ -14,6 +14,7 @@ Author: Michael Tautschnig, mt@eecs.qmul.ac.uk
 
 #include <iosfwd>
 #include <string>
+#include <unordered_map>
 
 #include <util/irep.h>
 #include <util/graph.h>
@@ -76,4 +77,60 @@ bool read_graphml(
 
 bool write_graphml(const graphmlt &src, std::ostream &os);
 
+/// Receives the nodes and edges of a GraphML graph one at a time, each node
+/// before its outgoing edges, so that a graph can be written out while it is
+/// being generated
+class graphml_outputt
+{
+public:
+  virtual ~graphml_outputt() = default;
+
+  /// \p node is added without its edges, which are added separately
+  virtual void add_node(const xml_graph_nodet &node) = 0;
+
+  /// \p edge is an `<edge>` element, its end points given by its `source`
+  /// and `target` attributes
+  virtual void add_edge(const xmlt &edge) = 0;
+};
+
+/// Writes nodes and edges to a stream as they arrive, without keeping them
+class graphml_writert : public graphml_outputt
+{
+public:
+  /// Writes the start of the document, with \p key_values as the data of the
+  /// graph
+  graphml_writert(std::ostream &, const graphmlt::key_valuest &key_values);
+
+  void add_node(const xml_graph_nodet &) override;
+  void add_edge(const xmlt &) override;
+
+  /// Writes the end of the document
+  /// \return true on error
+  bool finish();
+
+protected:
+  std::ostream &os;
+
+  /// The first node other than the sink is marked as the entry node
+  bool entry_done;
+};
+
+/// Collects nodes and edges in a \ref graphmlt, identifying nodes by name
+class graphml_buildert : public graphml_outputt
+{
+public:
+  explicit graphml_buildert(graphmlt &_dest) : dest(_dest)
+  {
+  }
+
+  void add_node(const xml_graph_nodet &) override;
+  void add_edge(const xmlt &) override;
+
+protected:
+  graphmlt &dest;
+  std::unordered_map<std::string, graphmlt::node_indext> node_indices;
+
+  graphmlt::node_indext node_index(const std::string &name);
+};
+
 #endif // CPROVER_XMLLANG_GRAPHML_H
@@ -41,6 +41,7 @@ public:
 
   virtual void clear()
   {
+    parsert::clear();
     parse_tree.clear();
     // set up stack
     stack.clear();
@@ -0,0 +1,124 @@
+/*******************************************************************\
+
+Module: Unit tests for the computation of dominators
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/std_expr.h>
+
+#include <analyses/cfg_dominators.h>
+
+/// \return whether \p to is reachable from \p from in \p program without
+///   passing through \p avoid
+static bool reachable(
+  const goto_programt &program,
+  goto_programt::const_targett from,
+  goto_programt::const_targett to,
+  goto_programt::const_targett avoid)
+{
+  cfg_post_dominatorst pd;
+  pd(program);
+
+  std::set<goto_programt::const_targett> visited;
+  std::vector<goto_programt::const_targett> worklist{from};
+  while(!worklist.empty())
+  {
+    const auto current = worklist.back();
+    worklist.pop_back();
+    if(current == avoid || !visited.insert(current).second)
+      continue;
+    if(current == to)
+      return true;
+
+    const auto &node = pd.get_node(current);
+    for(const auto &edge : node.out)
+      worklist.push_back(pd.cfg[edge.first].PC);
+  }
+
+  return false;
+}
+
+TEST_CASE(
+  "cfg_dominatorst computes the dominators of each instruction",
+  "[core][analyses][cfg_dominators]")
+{
+  // 0: x = 0;
+  // 1: if(c) goto 5;
+  // 2: x = 1;
+  // 3: if(d) goto 1;
+  // 4: goto 6;
+  // 5: assume(false);
+  // 6: skip;
+  // 7: if(e) goto 7;
+  // 8: END_FUNCTION
+  const symbol_exprt x("x", bool_typet());
+  goto_programt program;
+  program.add(goto_programt::make_assignment(x, false_exprt()));
+  const auto loop = program.add(goto_programt::make_skip());
+  const auto assign =
+    program.add(goto_programt::make_assignment(x, true_exprt()));
+  const auto back = program.add(goto_programt::make_skip());
+  const auto jump = program.add(goto_programt::make_skip());
+  const auto stop = program.add(goto_programt::make_assumption(false_exprt()));
+  const auto join = program.add(goto_programt::make_skip());
+  const auto self = program.add(goto_programt::make_skip());
+  program.add(goto_programt::make_end_function());
+  *loop = goto_programt::make_goto(stop, symbol_exprt("c", bool_typet()));
+  *back = goto_programt::make_goto(loop, symbol_exprt("d", bool_typet()));
+  *jump = goto_programt::make_goto(join);
+  *self = goto_programt::make_goto(self, symbol_exprt("e", bool_typet()));
+  program.update();
+
+  SECTION("Dominators")
+  {
+    cfg_dominatorst dominators;
+    dominators(program);
+
+    const auto entry = program.instructions.begin();
+    forall_goto_program_instructions(n, program)
+    {
+      const bool is_reachable =
+        reachable(program, entry, n, program.instructions.end());
+      forall_goto_program_instructions(d, program)
+      {
+        // d dominates n iff n is not reachable from the entry without d
+        const bool expected =
+          is_reachable &&
+          (d == n || !reachable(program, entry, n, d));
+        INFO(d->location_number << " dominates " << n->location_number);
+        REQUIRE(dominators.dominates(d, n) == expected);
+      }
+    }
+  }
+
+  SECTION("Post-dominators")
+  {
+    cfg_post_dominatorst post_dominators;
+    post_dominators(program);
+
+    // The END_FUNCTION and the assumption of false are exits.
+    const auto end = std::prev(program.instructions.end());
+    REQUIRE(post_dominators.dominates(end, join));
+    REQUIRE(post_dominators.dominates(end, self));
+    REQUIRE_FALSE(post_dominators.dominates(end, loop));
+    REQUIRE(post_dominators.dominates(stop, stop));
+    REQUIRE_FALSE(post_dominators.dominates(stop, loop));
+    REQUIRE(post_dominators.dominates(self, join));
+    REQUIRE(post_dominators.dominates(join, jump));
+    REQUIRE(
+      post_dominators.get_node(jump).dominators ==
+      std::set<goto_programt::const_targett>{jump, join, self, end});
+
+    // The loop may be left to either exit.
+    REQUIRE(
+      post_dominators.get_node(loop).dominators ==
+      std::set<goto_programt::const_targett>{loop});
+    REQUIRE(
+      post_dominators.get_node(assign).dominators ==
+      std::set<goto_programt::const_targett>{assign, back});
+  }
+}
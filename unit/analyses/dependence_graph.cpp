@@ -132,6 +132,35 @@ SCENARIO("dependence_graph", "[core][analyses][dependence_graph]")
           }
         }
       }
+
+      THEN("Computing the dependencies on demand yields the same ones")
+      {
+        lazy_dependence_grapht lazy_dep_graph(goto_model.goto_functions, ns);
+
+        for(const auto &gf_entry : goto_model.goto_functions.function_map)
+        {
+          forall_goto_program_instructions(i_it, gf_entry.second.body)
+          {
+            const dep_graph_domaint &node_domain = dep_graph[i_it];
+
+            // the dependencies of function entries on calls are left out
+            std::set<goto_programt::const_targett> control_deps;
+            for(const auto &dep :
+                dependence_graph_test_get_control_deps(node_domain))
+            {
+              if(!dep->is_function_call())
+                control_deps.insert(dep);
+            }
+
+            REQUIRE(
+              lazy_dep_graph.control_dependencies(gf_entry.first, i_it) ==
+              control_deps);
+            REQUIRE(
+              lazy_dep_graph.data_dependencies(gf_entry.first, i_it) ==
+              dependence_graph_test_get_data_deps(node_domain));
+          }
+        }
+      }
     }
   }
 }
@@ -0,0 +1,61 @@
+/*******************************************************************\
+
+Module: Unit tests for guard_exprt
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for guard_exprt
+
+#include <testing-utils/use_catch.h>
+
+#include <util/std_expr.h>
+
+#include <analyses/guard_expr.h>
+
+SCENARIO("guard_exprt disjunction", "[core][analyses][guard_expr]")
+{
+  guard_expr_managert manager;
+  const symbol_exprt a{"a", bool_typet{}};
+  const symbol_exprt b{"b", bool_typet{}};
+  const symbol_exprt c{"c", bool_typet{}};
+
+  GIVEN("The guards a || b and !a && !b")
+  {
+    guard_exprt g1{or_exprt{a, b}, manager};
+    const guard_exprt g2{and_exprt{not_exprt{a}, not_exprt{b}}, manager};
+
+    THEN("Their disjunction is true")
+    {
+      g1 |= g2;
+      REQUIRE(g1.is_true());
+    }
+  }
+
+  GIVEN("The guards c && (a || !b) and c && b && !a")
+  {
+    guard_exprt g1{and_exprt{c, or_exprt{a, not_exprt{b}}}, manager};
+    const guard_exprt g2{and_exprt{c, b, not_exprt{a}}, manager};
+
+    THEN("Their disjunction keeps the common prefix c")
+    {
+      g1 |= g2;
+      REQUIRE(g1.as_expr() == c);
+    }
+  }
+
+  GIVEN("Guards with more atoms than are merged using BDDs")
+  {
+    manager.max_bdd_atoms = 1;
+    guard_exprt g1{or_exprt{a, b}, manager};
+    const guard_exprt g2{and_exprt{not_exprt{a}, not_exprt{b}}, manager};
+
+    THEN("Their disjunction is built syntactically")
+    {
+      g1 |= g2;
+      REQUIRE(g1.as_expr() == or_exprt{or_exprt{a, b}, g2.as_expr()});
+    }
+  }
+}
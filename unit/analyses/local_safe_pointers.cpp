@@ -0,0 +1,55 @@
+/*******************************************************************\
+
+Module: Unit tests for local_safe_pointerst
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <analyses/local_safe_pointers.h>
+
+#include <util/c_types.h>
+#include <util/pointer_expr.h>
+
+SCENARIO(
+  "local_safe_pointerst distinguishes pointers of the same type",
+  "[core][analyses][local_safe_pointers]")
+{
+  const pointer_typet int_pointer_type = pointer_type(signed_int_type());
+  const symbol_exprt p("p", int_pointer_type);
+  const symbol_exprt q("q", int_pointer_type);
+  const symbol_exprt r("r", int_pointer_type);
+  const null_pointer_exprt null(int_pointer_type);
+
+  GIVEN("A program assuming that two of three pointers are not null")
+  {
+    goto_programt goto_program;
+    goto_program.add(goto_programt::make_assumption(notequal_exprt(p, null)));
+    goto_program.add(goto_programt::make_assumption(notequal_exprt(q, null)));
+    const auto skip = goto_program.add(goto_programt::make_skip());
+    goto_program.add(goto_programt::make_end_function());
+    goto_program.update();
+
+    local_safe_pointerst local_safe_pointers;
+    local_safe_pointers(goto_program);
+
+    THEN("Both checked pointers are known not to be null")
+    {
+      REQUIRE(local_safe_pointers.is_non_null_at_program_point(p, skip));
+      REQUIRE(local_safe_pointers.is_non_null_at_program_point(q, skip));
+    }
+
+    THEN("The pointer of the same type that is not checked may be null")
+    {
+      REQUIRE_FALSE(local_safe_pointers.is_non_null_at_program_point(r, skip));
+    }
+
+    THEN("No pointer is known not to be null before the checks")
+    {
+      REQUIRE_FALSE(local_safe_pointers.is_non_null_at_program_point(
+        p, goto_program.instructions.begin()));
+    }
+  }
+}
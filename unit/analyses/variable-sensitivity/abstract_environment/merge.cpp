@@ -0,0 +1,87 @@
+/*******************************************************************\
+
+Module: Unit tests for abstract_environmentt::merge
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+#include <analyses/variable-sensitivity/abstract_environment.h>
+#include <analyses/variable-sensitivity/variable_sensitivity_object_factory.h>
+
+static symbolt simple_symbol(const irep_idt &identifier, const typet &type)
+{
+  symbolt symbol;
+  symbol.name = symbol.base_name = symbol.pretty_name = identifier;
+  symbol.type = type;
+  return symbol;
+}
+
+SCENARIO(
+  "merging abstract environments",
+  "[core][analyses][variable-sensitivity][abstract_environment]")
+{
+  GIVEN("Two environments that only differ in one variable")
+  {
+    auto object_factory = variable_sensitivity_object_factoryt::configured_with(
+      vsd_configt::intervals());
+
+    symbol_tablet symbol_table;
+    namespacet ns{symbol_table};
+
+    const signedbv_typet number_type{32};
+    const symbolt &x = simple_symbol("x", number_type);
+    const symbolt &y = simple_symbol("y", number_type);
+    symbol_table.add(x);
+    symbol_table.add(y);
+
+    abstract_environmentt first(object_factory);
+    first.make_top();
+    first.assign(
+      x.symbol_expr(), first.eval(from_integer(1, number_type), ns), ns);
+    first.assign(
+      y.symbol_expr(), first.eval(from_integer(2, number_type), ns), ns);
+
+    abstract_environmentt second = first;
+    second.assign(
+      y.symbol_expr(), second.eval(from_integer(3, number_type), ns), ns);
+
+    THEN("A variable only in the second environment is modified")
+    {
+      REQUIRE(abstract_environmentt::modified_symbols(first, first).empty());
+
+      const symbolt &z = simple_symbol("z", number_type);
+      symbol_table.add(z);
+      second.assign(
+        z.symbol_expr(), second.eval(from_integer(4, number_type), ns), ns);
+
+      const auto modified =
+        abstract_environmentt::modified_symbols(first, second);
+      REQUIRE(modified.size() == 1);
+      REQUIRE(modified.front() == "z");
+    }
+
+    WHEN("Merging the second into the first")
+    {
+      const auto x_before = first.eval(x.symbol_expr(), ns);
+      REQUIRE(first.merge(second, widen_modet::no));
+
+      THEN("The variable that is the same in both keeps its object")
+      {
+        REQUIRE(first.eval(x.symbol_expr(), ns) == x_before);
+      }
+
+      THEN("Merging again does not change the environment")
+      {
+        REQUIRE_FALSE(first.merge(second, widen_modet::no));
+      }
+    }
+  }
+}
@@ -0,0 +1,138 @@
+/*******************************************************************\
+
+Module: Unit tests for weak_topological_ordert
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/std_expr.h>
+
+#include <analyses/weak_topological_order.h>
+
+#include <sstream>
+
+struct test_instructiont
+{
+  enum
+  {
+    SKIP,
+    GOTO,
+    CONDITIONAL_GOTO,
+    END_FUNCTION
+  } kind;
+  std::size_t target;
+};
+
+/// Build a goto program from \p instructions, each of which may jump to
+/// the instruction with the given index
+static void build(
+  goto_programt &goto_program,
+  const std::vector<test_instructiont> &instructions)
+{
+  std::vector<goto_programt::targett> targets;
+  for(const auto &instruction : instructions)
+  {
+    if(instruction.kind == test_instructiont::END_FUNCTION)
+      targets.push_back(goto_program.add(goto_programt::make_end_function()));
+    else
+      targets.push_back(goto_program.add(goto_programt::make_skip()));
+  }
+
+  for(std::size_t i = 0; i < instructions.size(); ++i)
+  {
+    const auto &instruction = instructions[i];
+    if(instruction.kind == test_instructiont::GOTO)
+      *targets[i] = goto_programt::make_goto(targets[instruction.target]);
+    else if(instruction.kind == test_instructiont::CONDITIONAL_GOTO)
+    {
+      *targets[i] = goto_programt::make_goto(
+        targets[instruction.target], symbol_exprt("c", bool_typet()));
+    }
+  }
+
+  goto_program.compute_location_numbers();
+}
+
+static std::string output(const weak_topological_ordert &wto)
+{
+  std::ostringstream out;
+  wto.output(out);
+  return out.str();
+}
+
+TEST_CASE(
+  "weak_topological_ordert orders loops",
+  "[core][analyses][weak_topological_order]")
+{
+  using it = test_instructiont;
+  goto_programt goto_program;
+
+  SECTION("Straight-line code")
+  {
+    build(goto_program, {{it::SKIP, 0}, {it::SKIP, 0}, {it::END_FUNCTION, 0}});
+    REQUIRE(output(weak_topological_ordert(goto_program)) == "0 1 2");
+  }
+
+  SECTION("A loop")
+  {
+    build(
+      goto_program,
+      {{it::CONDITIONAL_GOTO, 3},
+       {it::SKIP, 0},
+       {it::GOTO, 0},
+       {it::END_FUNCTION, 0}});
+    const weak_topological_ordert wto(goto_program);
+    REQUIRE(output(wto) == "(0 1 2) 3");
+    REQUIRE(wto.is_head(goto_program.instructions.begin()));
+    REQUIRE_FALSE(wto.is_head(std::next(goto_program.instructions.begin())));
+  }
+
+  SECTION("Nested loops")
+  {
+    build(
+      goto_program,
+      {{it::SKIP, 0},
+       {it::CONDITIONAL_GOTO, 5},
+       {it::SKIP, 0},
+       {it::CONDITIONAL_GOTO, 2},
+       {it::GOTO, 1},
+       {it::END_FUNCTION, 0}});
+    REQUIRE(output(weak_topological_ordert(goto_program)) == "0 (1 (2 3) 4) 5");
+  }
+
+  SECTION("A self-loop")
+  {
+    build(goto_program, {{it::CONDITIONAL_GOTO, 0}, {it::END_FUNCTION, 0}});
+    REQUIRE(output(weak_topological_ordert(goto_program)) == "(0) 1");
+  }
+
+  SECTION("A loop placed after its exit")
+  {
+    build(
+      goto_program,
+      {{it::GOTO, 3},
+       {it::SKIP, 0},
+       {it::GOTO, 6},
+       {it::CONDITIONAL_GOTO, 1},
+       {it::SKIP, 0},
+       {it::GOTO, 3},
+       {it::END_FUNCTION, 0}});
+    const weak_topological_ordert wto(goto_program);
+    REQUIRE(output(wto) == "0 (3 4 5) 1 2 6");
+
+    const auto i1 = std::next(goto_program.instructions.begin());
+    const auto i4 = std::next(i1, 3);
+    REQUIRE(wto.position(i4) < wto.position(i1));
+  }
+
+  SECTION("Unreachable code comes last")
+  {
+    build(
+      goto_program,
+      {{it::GOTO, 2}, {it::SKIP, 0}, {it::SKIP, 0}, {it::END_FUNCTION, 0}});
+    REQUIRE(output(weak_topological_ordert(goto_program)) == "0 2 3 1");
+  }
+}
@@ -0,0 +1,88 @@
+/*******************************************************************\
+
+Module: Unit tests for zones_domaint
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/namespace.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+#include <analyses/zones_domain.h>
+
+/// \return whether \p domain simplifies \p condition to \p expected
+static bool simplifies_to(
+  const zones_domaint &domain,
+  exprt condition,
+  const exprt &expected,
+  const namespacet &ns)
+{
+  domain.ai_simplify(condition, ns);
+  return condition == expected;
+}
+
+TEST_CASE(
+  "zones_domaint relates pairs of variables",
+  "[core][analyses][zones_domain]")
+{
+  const symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  const signedbv_typet type(32);
+  const symbol_exprt i("i", type);
+  const symbol_exprt n("n", type);
+  const symbol_exprt m("m", type);
+  const exprt one = from_integer(1, type);
+  const exprt ten = from_integer(10, type);
+
+  zones_domaint domain;
+  domain.make_top();
+  REQUIRE(domain.is_top());
+
+  SECTION("Bounds are derived transitively")
+  {
+    domain.assume(binary_relation_exprt(i, ID_le, n), ns);
+    domain.assume(binary_relation_exprt(n, ID_lt, m), ns);
+    domain.assume(binary_relation_exprt(m, ID_le, ten), ns);
+    REQUIRE_FALSE(domain.is_top());
+
+    REQUIRE(simplifies_to(
+      domain, binary_relation_exprt(i, ID_lt, m), true_exprt(), ns));
+    REQUIRE(simplifies_to(
+      domain,
+      binary_relation_exprt(plus_exprt(i, one), ID_le, ten),
+      true_exprt(),
+      ns));
+    REQUIRE(simplifies_to(
+      domain, binary_relation_exprt(m, ID_le, i), false_exprt(), ns));
+
+    const exprt unknown = binary_relation_exprt(i, ID_lt, n);
+    REQUIRE(simplifies_to(domain, unknown, unknown, ns));
+  }
+
+  SECTION("Equalities follow from two bounds")
+  {
+    domain.assume(binary_relation_exprt(i, ID_le, n), ns);
+    const exprt equal = equal_exprt(i, n);
+    REQUIRE(simplifies_to(domain, equal, equal, ns));
+
+    domain.assume(not_exprt(binary_relation_exprt(i, ID_lt, n)), ns);
+    REQUIRE(simplifies_to(domain, equal, true_exprt(), ns));
+  }
+
+  SECTION("Contradicting constraints give bottom")
+  {
+    domain.assume(binary_relation_exprt(i, ID_lt, n), ns);
+    domain.assume(binary_relation_exprt(n, ID_le, m), ns);
+    REQUIRE_FALSE(domain.is_bottom());
+
+    domain.assume(binary_relation_exprt(m, ID_le, i), ns);
+    REQUIRE(domain.is_bottom());
+  }
+}
@@ -8,6 +8,8 @@ Author: Daniel Kroening
 
 #include <testing-utils/use_catch.h>
 
+#include <chrono>
+#include <limits>
 #include <string>
 
 #include <big-int/bigint.hh>
@@ -253,4 +255,85 @@ TEST_CASE("arbitrary precision integers", "[core][big-int][bigint]")
     N += 2; // 2
     REQUIRE(N.floorPow2() == 1);
   }
+
+  // =====================================================================
+  // Tests for the transitions between small and large values
+  // =====================================================================
+  SECTION("small values")
+  {
+    const BigInt max_ullong = BigInt::ullong_t(-1);
+    BigInt N = max_ullong;
+    N += 1;
+    REQUIRE(to_string(N) == "18446744073709551616");
+    N -= 1;
+    REQUIRE(N == max_ullong);
+    N = -N;
+    N -= 1;
+    REQUIRE(to_string(N) == "-18446744073709551616");
+    N += max_ullong;
+    REQUIRE(N == -1);
+    N += 1;
+    REQUIRE(N.is_zero());
+    REQUIRE(N.is_positive());
+
+    N = BigInt::ullong_t(1) << 32;
+    N *= N;
+    REQUIRE(to_string(N) == "18446744073709551616");
+    N = BigInt(-7) * BigInt(6);
+    REQUIRE(N == -42);
+    N *= 0;
+    REQUIRE(N.is_zero());
+    REQUIRE(N.is_positive());
+
+    REQUIRE(BigInt(-1) < 0);
+    REQUIRE(max_ullong > BigInt::ullong_t(-2));
+    REQUIRE(
+      BigInt(std::numeric_limits<BigInt::llong_t>::min()) ==
+      std::numeric_limits<BigInt::llong_t>::min());
+
+    // copying, swapping and moving between small and large values
+    BigInt large = pow(BigInt(10), 50);
+    BigInt small = 3;
+    BigInt copy = large;
+    small.swap(copy);
+    REQUIRE(small == large);
+    REQUIRE(copy == 3);
+    copy = small;
+    REQUIRE(copy == large);
+    copy = 5;
+    REQUIRE(copy == 5);
+    BigInt moved = std::move(small);
+    REQUIRE(moved == large);
+    small = std::move(copy);
+    REQUIRE(small == 5);
+  }
+}
+
+TEST_CASE(
+  "arbitrary precision integer performance",
+  "[.][benchmark][big-int][bigint]")
+{
+  const std::size_t iterations = 1000000;
+
+  // Typical workload of the simplifier: offsets, widths and constants that
+  // fit into a machine word.
+  const auto start = std::chrono::steady_clock::now();
+  BigInt sum = 0;
+  BigInt product = 1;
+  std::size_t less = 0;
+  for(std::size_t i = 0; i < iterations; ++i)
+  {
+    BigInt value = i;
+    sum += value;
+    product = value * 8 + 1;
+    if(product < sum)
+      ++less;
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  REQUIRE(sum == BigInt(iterations) * (iterations - 1) / 2);
+  WARN(
+    "small additions, multiplications and comparisons: "
+    << std::chrono::duration<double>(end - start).count() << "s ("
+    << less << " less)");
 }
@@ -0,0 +1,66 @@
+/*******************************************************************\
+
+Module: Unit tests for goto_trace_storaget::insert_prefixes
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/namespace.h>
+#include <util/symbol_table.h>
+
+#include <goto-checker/goto_trace_storage.h>
+
+static void add_step(
+  goto_tracet &trace,
+  goto_trace_stept::typet type,
+  const irep_idt &property_id = irep_idt())
+{
+  goto_trace_stept step;
+  step.type = type;
+  step.step_nr = trace.steps.size() + 1;
+  step.property_id = property_id;
+  step.cond_value = property_id.empty();
+  trace.add_step(step);
+}
+
+SCENARIO(
+  "Traces are built as prefixes of a shared trace",
+  "[core][goto-checker][goto_trace_storage]")
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+  goto_trace_storaget storage(ns);
+
+  // steps 2 and 4 violate properties p and q, step 5 violates p again
+  goto_tracet trace;
+  add_step(trace, goto_trace_stept::typet::ASSIGNMENT);
+  add_step(trace, goto_trace_stept::typet::ASSERT, "p");
+  add_step(trace, goto_trace_stept::typet::ASSIGNMENT);
+  add_step(trace, goto_trace_stept::typet::ASSERT, "q");
+  add_step(trace, goto_trace_stept::typet::ASSERT, "p");
+
+  const std::vector<irep_idt> missing =
+    storage.insert_prefixes(std::move(trace), {"p", "q", "r"});
+
+  THEN("Properties without a violation are reported back")
+  {
+    REQUIRE(missing == std::vector<irep_idt>{"r"});
+  }
+
+  THEN("Each trace ends in the first violation of its property")
+  {
+    const goto_tracet &q_trace = storage["q"];
+    REQUIRE(q_trace.steps.size() == 4);
+    REQUIRE(q_trace.get_last_step().property_id == "q");
+
+    const goto_tracet &p_trace = storage["p"];
+    REQUIRE(p_trace.steps.size() == 2);
+    REQUIRE(p_trace.get_last_step().property_id == "p");
+
+    REQUIRE(&storage["p"] == &p_trace);
+    REQUIRE(storage.all().size() == 2);
+  }
+}
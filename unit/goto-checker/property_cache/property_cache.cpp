@@ -0,0 +1,155 @@
+/*******************************************************************\
+
+Module: Unit tests for the cache of property outcomes
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/config.h>
+#include <util/options.h>
+#include <util/tempfile.h>
+
+#include <goto-checker/property_cache.h>
+#include <goto-programs/goto_program.h>
+#include <goto-symex/symex_target_equation.h>
+
+/// An equation x#1 = 1; y#1 = value; assert(x#1 == 1); assert(y#1 == 2)
+static void make_equation(
+  const goto_programt &program,
+  symex_target_equationt &equation,
+  int value)
+{
+  const signedbv_typet type(32);
+  ssa_exprt x(symbol_exprt("x", type));
+  x.set_level_2(1);
+  ssa_exprt y(symbol_exprt("y", type));
+  y.set_level_2(1);
+
+  auto target = program.instructions.begin();
+  equation.assignment(
+    true_exprt(),
+    x,
+    x,
+    x.get_original_expr(),
+    from_integer(1, type),
+    symex_targett::sourcet("f", target++),
+    symex_targett::assignment_typet::STATE);
+  equation.assignment(
+    true_exprt(),
+    y,
+    y,
+    y.get_original_expr(),
+    from_integer(value, type),
+    symex_targett::sourcet("f", target++),
+    symex_targett::assignment_typet::STATE);
+  equation.assertion(
+    true_exprt(),
+    equal_exprt(x, from_integer(1, type)),
+    "x",
+    symex_targett::sourcet("f", target++));
+  equation.assertion(
+    true_exprt(),
+    equal_exprt(y, from_integer(2, type)),
+    "y",
+    symex_targett::sourcet("f", target));
+}
+
+SCENARIO(
+  "Keys and persistence of the property cache",
+  "[core][goto-checker][property_cache]")
+{
+  goto_programt program;
+  program.add(goto_programt::make_skip());
+  program.add(goto_programt::make_skip());
+  for(const auto property_id : {"f.assertion.1", "f.assertion.2"})
+  {
+    source_locationt location;
+    location.set_property_id(property_id);
+    program.add(goto_programt::make_assertion(true_exprt(), location));
+  }
+
+  symex_target_equationt equation(null_message_handler);
+  make_equation(program, equation, 2);
+  symex_target_equationt same_equation(null_message_handler);
+  make_equation(program, same_equation, 2);
+  symex_target_equationt other_equation(null_message_handler);
+  make_equation(program, other_equation, 3);
+
+  const optionst options;
+  const std::string settings = property_cachet::settings(options);
+
+  GIVEN("Equations that differ in the value assigned to y")
+  {
+    THEN("The key of a property depends on its slice only")
+    {
+      REQUIRE(
+        property_cachet::key(equation, "f.assertion.1", settings) ==
+        property_cachet::key(same_equation, "f.assertion.1", settings));
+      REQUIRE(
+        property_cachet::key(equation, "f.assertion.1", settings) ==
+        property_cachet::key(other_equation, "f.assertion.1", settings));
+      REQUIRE(
+        property_cachet::key(equation, "f.assertion.2", settings) ==
+        property_cachet::key(same_equation, "f.assertion.2", settings));
+      REQUIRE(
+        property_cachet::key(equation, "f.assertion.2", settings) !=
+        property_cachet::key(other_equation, "f.assertion.2", settings));
+      REQUIRE(
+        property_cachet::key(equation, "f.assertion.1", settings) !=
+        property_cachet::key(equation, "f.assertion.2", settings));
+    }
+  }
+
+  GIVEN("Different solver settings")
+  {
+    optionst refine_options;
+    refine_options.set_option("refine", true);
+    const std::string refine_settings =
+      property_cachet::settings(refine_options);
+
+    const std::size_t object_bits = config.bv_encoding.object_bits;
+    config.bv_encoding.object_bits = object_bits + 1;
+    const std::string object_bits_settings = property_cachet::settings(options);
+    config.bv_encoding.object_bits = object_bits;
+
+    THEN("The key of a property depends on them")
+    {
+      REQUIRE(refine_settings != settings);
+      REQUIRE(object_bits_settings != settings);
+      REQUIRE(
+        property_cachet::key(equation, "f.assertion.1", refine_settings) !=
+        property_cachet::key(equation, "f.assertion.1", settings));
+      REQUIRE(
+        property_cachet::key(equation, "f.assertion.1", object_bits_settings) !=
+        property_cachet::key(equation, "f.assertion.1", settings));
+    }
+  }
+
+  GIVEN("A cache file")
+  {
+    temporary_filet file("property_cache", ".txt");
+    const std::string key =
+      property_cachet::key(equation, "f.assertion.1", settings);
+
+    {
+      property_cachet cache(file(), null_message_handler);
+      REQUIRE_FALSE(cache.has_passed(key));
+      cache.set_passed(key);
+      REQUIRE_FALSE(cache.write());
+    }
+
+    THEN("Passed properties are found when reading it again")
+    {
+      property_cachet cache(file(), null_message_handler);
+      REQUIRE(cache.has_passed(key));
+      REQUIRE_FALSE(cache.has_passed(
+        property_cachet::key(equation, "f.assertion.2", settings)));
+    }
+  }
+}
@@ -0,0 +1,103 @@
+/*******************************************************************\
+
+Module: Unit tests for property_workerst
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <goto-checker/property_worker.h>
+
+#ifndef _WIN32
+#  include <util/message.h>
+
+#  include <map>
+
+#  include <csignal>
+#  include <unistd.h>
+
+SCENARIO(
+  "property_workerst reports the statuses decided by workers",
+  "[core][goto-checker][property_worker]")
+{
+  null_message_handlert message_handler;
+  property_workerst workers(message_handler);
+
+  GIVEN("A worker that decides its properties and one that crashes")
+  {
+    workers.start(0, {"p1", "p2"}, []() -> property_updatest {
+      return {{"p1", property_statust::PASS}, {"p2", property_statust::FAIL}};
+    });
+    workers.start(1, {"p3"}, []() -> property_updatest {
+      kill(getpid(), SIGKILL);
+      return {};
+    });
+
+    REQUIRE(workers.running() == 2);
+
+    std::map<std::size_t, property_workerst::finishedt> finished;
+    while(workers.running() != 0)
+    {
+      property_workerst::finishedt worker = workers.wait_for_any();
+      finished.emplace(worker.id, std::move(worker));
+    }
+
+    THEN("The statuses of the first are reported")
+    {
+      REQUIRE_FALSE(finished.at(0).failed);
+      REQUIRE(
+        finished.at(0).updates ==
+        property_updatest{
+          {"p1", property_statust::PASS}, {"p2", property_statust::FAIL}});
+    }
+
+    THEN("Only the properties of the crashed worker are erroneous")
+    {
+      REQUIRE(finished.at(1).failed);
+      REQUIRE(
+        finished.at(1).updates ==
+        property_updatest{{"p3", property_statust::ERROR}});
+
+      propertiest properties;
+      for(const auto &id : {"p1", "p3", "p4"})
+      {
+        properties.emplace(
+          id,
+          property_infot{
+            goto_programt::const_targett(),
+            "description",
+            property_statust::UNKNOWN});
+      }
+
+      std::unordered_set<irep_idt> updated_properties;
+      apply_property_updates(
+        finished.at(1).updates, properties, updated_properties);
+
+      REQUIRE(properties.at("p1").status == property_statust::UNKNOWN);
+      REQUIRE(properties.at("p3").status == property_statust::ERROR);
+      REQUIRE(properties.at("p4").status == property_statust::UNKNOWN);
+      REQUIRE(updated_properties == std::unordered_set<irep_idt>{"p3"});
+    }
+  }
+
+  GIVEN("A worker that throws")
+  {
+    workers.start(2, {"p1"}, []() -> property_updatest {
+      throw "failed";
+    });
+
+    THEN("Its properties are erroneous")
+    {
+      const property_workerst::finishedt finished = workers.wait_for_any();
+      REQUIRE(finished.id == 2);
+      REQUIRE(finished.failed);
+      REQUIRE(
+        finished.updates == property_updatest{{"p1", property_statust::ERROR}});
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,214 @@
+/*******************************************************************\
+
+Module: Unit tests for checkpoints of symbolic execution
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/symbol_table.h>
+
+#include <goto-checker/symex_checkpoint.h>
+#include <goto-programs/goto_model.h>
+#include <goto-symex/symex_target_equation.h>
+
+#include <sstream>
+
+SCENARIO(
+  "Writing and reading a symex checkpoint",
+  "[core][goto-checker][symex_checkpoint]")
+{
+  const signedbv_typet type(32);
+  const symbol_exprt x("x", type);
+
+  goto_modelt goto_model;
+  goto_programt &body = goto_model.goto_functions.function_map["f"].body;
+  body.add(goto_programt::make_assignment(x, from_integer(1, type)));
+  source_locationt property_location;
+  property_location.set_property_id("f.assertion.1");
+  body.add(goto_programt::make_assertion(
+    equal_exprt(x, from_integer(1, type)), property_location));
+  body.add(goto_programt::make_end_function());
+  goto_model.goto_functions.update();
+
+  const goto_programt::const_targett assignment = body.instructions.begin();
+  const goto_programt::const_targett assertion = std::next(assignment);
+
+  symex_target_equationt equation(null_message_handler);
+  ssa_exprt lhs(x);
+  lhs.set_level_2(1);
+  equation.assignment(
+    true_exprt(),
+    lhs,
+    lhs,
+    x,
+    from_integer(1, type),
+    symex_targett::sourcet("f", assignment),
+    symex_targett::assignment_typet::STATE);
+  equation.assertion(
+    true_exprt(),
+    equal_exprt(lhs, from_integer(1, type)),
+    "assertion",
+    symex_targett::sourcet("f", assertion));
+
+  symbol_tablet symex_symbol_table;
+  symbolt symbol;
+  symbol.name = "symex::tmp";
+  symbol.type = type;
+  symex_symbol_table.add(symbol);
+
+  std::stringstream checkpoint;
+  write_symex_checkpoint(checkpoint, equation, symex_symbol_table, false);
+
+  GIVEN("A checkpoint of an equation")
+  {
+    WHEN("Reading it for the same program")
+    {
+      symex_target_equationt read_equation(null_message_handler);
+      symbol_tablet read_symbol_table;
+      bool complete = true;
+
+      REQUIRE_FALSE(read_symex_checkpoint(
+        checkpoint,
+        goto_model,
+        read_equation,
+        read_symbol_table,
+        complete,
+        null_message_handler));
+
+      THEN("The steps and symbols are restored")
+      {
+        REQUIRE_FALSE(complete);
+        REQUIRE(read_symbol_table.has_symbol("symex::tmp"));
+        REQUIRE(read_equation.SSA_steps.size() == 2);
+
+        const SSA_stept &read_assignment = read_equation.SSA_steps[0];
+        REQUIRE(read_assignment.is_assignment());
+        REQUIRE(read_assignment.source.pc == assignment);
+        REQUIRE(read_assignment.ssa_lhs == lhs);
+        REQUIRE(read_assignment.cond_expr == equation.SSA_steps[0].cond_expr);
+        REQUIRE_FALSE(read_assignment.converted);
+
+        const SSA_stept &read_assertion = read_equation.SSA_steps[1];
+        REQUIRE(read_assertion.is_assert());
+        REQUIRE(read_assertion.source.pc == assertion);
+        REQUIRE(read_assertion.comment == "assertion");
+        REQUIRE(read_assertion.get_property_id() == "f.assertion.1");
+      }
+    }
+
+    WHEN("Reading it for a program without the function")
+    {
+      goto_modelt other_model;
+      symex_target_equationt read_equation(null_message_handler);
+      symbol_tablet read_symbol_table;
+      bool complete;
+
+      THEN("Reading fails")
+      {
+        REQUIRE(read_symex_checkpoint(
+          checkpoint,
+          other_model,
+          read_equation,
+          read_symbol_table,
+          complete,
+          null_message_handler));
+      }
+    }
+  }
+}
+
+SCENARIO(
+  "Writing and reading an equation dump",
+  "[core][goto-checker][symex_checkpoint]")
+{
+  const signedbv_typet type(32);
+  const symbol_exprt x("x", type);
+
+  goto_modelt goto_model;
+  goto_programt &body = goto_model.goto_functions.function_map["f"].body;
+  source_locationt property_location;
+  property_location.set_property_id("f.assertion.1");
+  property_location.set_comment("x is one");
+  body.add(goto_programt::make_assertion(
+    equal_exprt(x, from_integer(1, type)), property_location));
+  body.add(goto_programt::make_end_function());
+  goto_model.goto_functions.update();
+
+  const goto_programt::const_targett assertion = body.instructions.begin();
+
+  symex_target_equationt equation(null_message_handler);
+  equation.assertion(
+    true_exprt(),
+    equal_exprt(x, from_integer(1, type)),
+    "x is one",
+    symex_targett::sourcet("f", assertion));
+  equation.SSA_steps.back().ignore = true;
+
+  propertiest properties;
+  properties.emplace(
+    "f.assertion.1",
+    property_infot{assertion, "x is one", property_statust::UNKNOWN});
+
+  std::stringstream dump;
+  write_equation_dump(
+    dump, goto_model, equation, symbol_tablet(), true, properties);
+
+  GIVEN("A dump of an equation and its properties")
+  {
+    WHEN("Reading it for the same program")
+    {
+      symex_target_equationt read_equation(null_message_handler);
+      symbol_tablet read_symbol_table;
+      propertiest read_properties;
+      bool complete = false;
+
+      REQUIRE_FALSE(read_equation_dump(
+        dump,
+        goto_model,
+        read_equation,
+        read_symbol_table,
+        complete,
+        read_properties,
+        null_message_handler));
+
+      THEN("The steps, including what slicing did, and properties are restored")
+      {
+        REQUIRE(complete);
+        REQUIRE(read_equation.SSA_steps.size() == 1);
+        REQUIRE(read_equation.SSA_steps[0].ignore);
+        REQUIRE(read_equation.SSA_steps[0].source.pc == assertion);
+
+        REQUIRE(read_properties.size() == 1);
+        const property_infot &property_info =
+          read_properties.at("f.assertion.1");
+        REQUIRE(property_info.pc == assertion);
+        REQUIRE(property_info.description == "x is one");
+        REQUIRE(property_info.status == property_statust::UNKNOWN);
+      }
+    }
+
+    WHEN("Reading it as a checkpoint")
+    {
+      symex_target_equationt read_equation(null_message_handler);
+      symbol_tablet read_symbol_table;
+      bool complete;
+
+      THEN("Reading fails")
+      {
+        REQUIRE(read_symex_checkpoint(
+          dump,
+          goto_model,
+          read_equation,
+          read_symbol_table,
+          complete,
+          null_message_handler));
+      }
+    }
+  }
+}
@@ -0,0 +1,148 @@
+/*******************************************************************\
+
+Module: Unit tests for the inference of loop bounds
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/std_expr.h>
+
+#include <goto-instrument/loop_bounds.h>
+#include <goto-programs/goto_model.h>
+
+/// Add a local variable \p name of type \p type to \p goto_model
+static symbol_exprt
+add_variable(goto_modelt &goto_model, const irep_idt &name, const typet &type)
+{
+  symbolt symbol;
+  symbol.name = name;
+  symbol.base_name = name;
+  symbol.type = type;
+  symbol.is_lvalue = true;
+  goto_model.symbol_table.add(symbol);
+  return symbol.symbol_expr();
+}
+
+/// \return the limits inferred for the loops of \p body, as the entry point
+static std::map<irep_idt, unsigned>
+limits(goto_modelt &goto_model, goto_programt &body)
+{
+  body.add(goto_programt::make_end_function());
+  goto_model.goto_functions.function_map[goto_functionst::entry_point()]
+    .body.swap(body);
+  goto_model.goto_functions.update();
+  return infer_loop_bounds(goto_model);
+}
+
+TEST_CASE(
+  "infer_loop_bounds bounds counting loops",
+  "[core][goto-instrument][loop_bounds]")
+{
+  goto_modelt goto_model;
+  goto_programt body;
+  const irep_idt loop_id = id2string(goto_functionst::entry_point()) + ".0";
+
+  const signedbv_typet int_type(32);
+  const symbol_exprt i = add_variable(goto_model, "i", int_type);
+  const exprt zero = from_integer(0, int_type);
+  const exprt one = from_integer(1, int_type);
+  const exprt ten = from_integer(10, int_type);
+
+  SECTION("A for loop counting up to a constant")
+  {
+    // for(i = 0; i < 10; i++);
+    body.add(goto_programt::make_assignment(i, zero));
+    const auto head = body.add(goto_programt::make_skip());
+    body.add(goto_programt::make_assignment(i, plus_exprt(i, one)));
+    body.add(goto_programt::make_goto(head));
+    const auto exit = body.add(goto_programt::make_skip());
+    *head = goto_programt::make_goto(
+      exit, not_exprt(binary_relation_exprt(i, ID_lt, ten)));
+
+    const std::map<irep_idt, unsigned> expected{{loop_id, 11}};
+    REQUIRE(limits(goto_model, body) == expected);
+  }
+
+  SECTION("A while loop with a larger step up to a variable")
+  {
+    // n <= 10; i = 0; while(i <= n) i += 3;
+    const symbol_exprt n = add_variable(goto_model, "n", int_type);
+    body.add(goto_programt::make_assumption(
+      binary_relation_exprt(n, ID_le, ten)));
+    body.add(goto_programt::make_assignment(i, zero));
+    const auto head = body.add(goto_programt::make_skip());
+    body.add(goto_programt::make_assignment(
+      i, plus_exprt(i, from_integer(3, int_type))));
+    body.add(goto_programt::make_goto(head));
+    const auto exit = body.add(goto_programt::make_skip());
+    *head = goto_programt::make_goto(
+      exit, not_exprt(binary_relation_exprt(i, ID_le, n)));
+
+    const std::map<irep_idt, unsigned> expected{{loop_id, 5}};
+    REQUIRE(limits(goto_model, body) == expected);
+  }
+
+  SECTION("A loop counting an unsigned variable down to zero")
+  {
+    // n <= 100; for(u = n; u > 0; u--);
+    const unsignedbv_typet unsigned_type(32);
+    const symbol_exprt n = add_variable(goto_model, "n", unsigned_type);
+    const symbol_exprt u = add_variable(goto_model, "u", unsigned_type);
+    const exprt unsigned_zero = from_integer(0, unsigned_type);
+
+    body.add(goto_programt::make_assumption(
+      binary_relation_exprt(n, ID_le, from_integer(100, unsigned_type))));
+    body.add(goto_programt::make_assignment(u, n));
+    const auto head = body.add(goto_programt::make_skip());
+    body.add(goto_programt::make_assignment(
+      u, minus_exprt(u, from_integer(1, unsigned_type))));
+    body.add(goto_programt::make_goto(head));
+    const auto exit = body.add(goto_programt::make_skip());
+    *head = goto_programt::make_goto(
+      exit, not_exprt(binary_relation_exprt(u, ID_gt, unsigned_zero)));
+
+    const std::map<irep_idt, unsigned> expected{{loop_id, 101}};
+    REQUIRE(limits(goto_model, body) == expected);
+  }
+
+  SECTION("Loops that may not terminate have no limit")
+  {
+    const symbol_exprt n = add_variable(goto_model, "n", int_type);
+    const exprt condition = not_exprt(binary_relation_exprt(i, ID_lt, n));
+
+    body.add(goto_programt::make_assumption(
+      binary_relation_exprt(n, ID_le, ten)));
+    body.add(goto_programt::make_assignment(i, zero));
+    const auto head = body.add(goto_programt::make_skip());
+
+    SECTION("The counter moves away from the bound")
+    {
+      body.add(goto_programt::make_assignment(i, minus_exprt(i, one)));
+    }
+
+    SECTION("The counter does not change in each iteration")
+    {
+      const auto skip = body.add(goto_programt::make_skip());
+      body.add(goto_programt::make_assignment(i, plus_exprt(i, one)));
+      const auto latch = body.add(goto_programt::make_skip());
+      *skip = goto_programt::make_goto(latch, symbol_exprt("c", bool_typet()));
+    }
+
+    SECTION("The bound changes")
+    {
+      body.add(goto_programt::make_assignment(i, plus_exprt(i, one)));
+      body.add(goto_programt::make_assignment(n, plus_exprt(n, one)));
+    }
+
+    body.add(goto_programt::make_goto(head));
+    const auto exit = body.add(goto_programt::make_skip());
+    *head = goto_programt::make_goto(exit, condition);
+
+    REQUIRE(limits(goto_model, body).empty());
+  }
+}
@@ -0,0 +1,70 @@
+/*******************************************************************\
+
+Module: Unit tests for reachability_indext
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <goto-programs/goto_functions.h>
+#include <goto-programs/reachability_index.h>
+#include <goto-programs/remove_unused_functions.h>
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/pointer_expr.h>
+#include <util/std_code.h>
+#include <util/std_expr.h>
+
+TEST_CASE(
+  "Reachability index of functions and symbols",
+  "[core][goto-programs][reachability_index]")
+{
+  const code_typet function_type({}, empty_typet());
+  const symbol_exprt f("f", function_type);
+  const symbol_exprt h("h", function_type);
+  const symbol_exprt x("x", signedbv_typet(32));
+  const symbol_exprt y("y", signedbv_typet(32));
+  const symbol_exprt p("p", pointer_typet(function_type, 64));
+
+  goto_functionst goto_functions;
+
+  // the entry point calls f and takes the address of h
+  goto_programt &start =
+    goto_functions.function_map[goto_functionst::entry_point()].body;
+  start.add(goto_programt::make_function_call(f, {}));
+  start.add(goto_programt::make_assignment(p, address_of_exprt(h)));
+  start.add(goto_programt::make_end_function());
+
+  goto_programt &f_body = goto_functions.function_map["f"].body;
+  f_body.add(goto_programt::make_assignment(x, from_integer(1, x.type())));
+  f_body.add(goto_programt::make_end_function());
+
+  goto_programt &h_body = goto_functions.function_map["h"].body;
+  h_body.add(goto_programt::make_end_function());
+
+  goto_programt &unused_body = goto_functions.function_map["unused"].body;
+  unused_body.add(goto_programt::make_assignment(y, x));
+  unused_body.add(goto_programt::make_end_function());
+
+  const reachability_indext reachability_index(
+    goto_functions, goto_functionst::entry_point());
+
+  REQUIRE(reachability_index.is_reachable(goto_functionst::entry_point()));
+  REQUIRE(reachability_index.is_reachable("f"));
+  REQUIRE(reachability_index.is_reachable("h"));
+  REQUIRE_FALSE(reachability_index.is_reachable("unused"));
+
+  REQUIRE(reachability_index.is_used("x"));
+  REQUIRE(reachability_index.is_used("p"));
+  REQUIRE_FALSE(reachability_index.is_used("y"));
+
+  remove_unused_functions(
+    goto_functions, reachability_index, null_message_handler);
+
+  REQUIRE(goto_functions.function_map.size() == 3);
+  REQUIRE(goto_functions.function_map.count("unused") == 0);
+}
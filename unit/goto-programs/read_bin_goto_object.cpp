@@ -0,0 +1,152 @@
+/*******************************************************************\
+
+Module: Unit tests for reading goto binaries
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/goto_program_fingerprint.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
+
+#include <algorithm>
+#include <sstream>
+
+static void add_function(
+  goto_modelt &goto_model,
+  const irep_idt &name,
+  const std::vector<irep_idt> &callees)
+{
+  const code_typet code_type({}, empty_typet());
+
+  symbolt symbol;
+  symbol.name = name;
+  symbol.base_name = name;
+  symbol.mode = ID_C;
+  symbol.type = code_type;
+  goto_model.symbol_table.add(symbol);
+
+  goto_programt &body = goto_model.goto_functions.function_map[name].body;
+  for(const auto &callee : callees)
+  {
+    body.add(goto_programt::make_function_call(
+      code_function_callt(symbol_exprt(callee, code_type))));
+  }
+  body.add(goto_programt::make_end_function());
+}
+
+TEST_CASE(
+  "Read function bodies reachable from entry points",
+  "[core][goto-programs][read_bin_goto_object]")
+{
+  goto_modelt goto_model;
+  add_function(goto_model, "main", {"f"});
+  add_function(goto_model, "f", {"g", "f"});
+  add_function(goto_model, "g", {});
+  add_function(goto_model, "unreachable", {"g"});
+
+  std::stringstream binary;
+  REQUIRE_FALSE(write_goto_binary(binary, goto_model));
+
+  SECTION("All bodies are read without entry points")
+  {
+    symbol_tablet symbol_table;
+    goto_functionst goto_functions;
+    REQUIRE_FALSE(read_bin_goto_object(
+      binary, "", symbol_table, goto_functions, null_message_handler));
+
+    REQUIRE(symbol_table.symbols.size() == 4);
+    REQUIRE(goto_functions.function_map.size() == 4);
+    for(const auto &entry : goto_functions.function_map)
+      REQUIRE(entry.second.body_available());
+    REQUIRE(goto_functions.function_map.at("f").body.instructions.size() == 3);
+  }
+
+  SECTION("Only reachable bodies are read with entry points")
+  {
+    symbol_tablet symbol_table;
+    goto_functionst goto_functions;
+    REQUIRE_FALSE(read_bin_goto_object(
+      binary,
+      "",
+      symbol_table,
+      goto_functions,
+      null_message_handler,
+      {"main"}));
+
+    REQUIRE(symbol_table.symbols.size() == 4);
+    REQUIRE(goto_functions.function_map.at("main").body_available());
+    REQUIRE(goto_functions.function_map.at("f").body_available());
+    REQUIRE(goto_functions.function_map.at("g").body_available());
+    REQUIRE_FALSE(
+      goto_functions.function_map.at("unreachable").body_available());
+    REQUIRE(goto_functions.function_map.at("f").body.instructions.size() == 3);
+
+    // bodies decoded out of order refer to their own ireps only
+    for(const irep_idt &name : {"main", "f", "g"})
+    {
+      const auto &read_instructions =
+        goto_functions.function_map.at(name).body.instructions;
+      const auto &instructions =
+        goto_model.goto_functions.function_map.at(name).body.instructions;
+      REQUIRE(read_instructions.size() == instructions.size());
+      REQUIRE(std::equal(
+        read_instructions.begin(),
+        read_instructions.end(),
+        instructions.begin(),
+        [](
+          const goto_programt::instructiont &a,
+          const goto_programt::instructiont &b) {
+          return a.get_code() == b.get_code() && a.guard == b.guard;
+        }));
+    }
+  }
+}
+
+TEST_CASE(
+  "Read the fingerprints of function bodies",
+  "[core][goto-programs][read_bin_goto_object]")
+{
+  goto_modelt goto_model;
+  add_function(goto_model, "main", {"f"});
+  add_function(goto_model, "f", {"g"});
+  add_function(goto_model, "g", {});
+
+  std::stringstream binary;
+  REQUIRE_FALSE(write_goto_binary(binary, goto_model));
+
+  symbol_tablet symbol_table;
+  goto_functionst goto_functions;
+  goto_program_fingerprintst fingerprints;
+  REQUIRE_FALSE(read_bin_goto_object_fingerprints(
+    binary,
+    "",
+    symbol_table,
+    goto_functions,
+    null_message_handler,
+    fingerprints));
+
+  REQUIRE(symbol_table.symbols.size() == 3);
+  REQUIRE(fingerprints.size() == 3);
+  for(const auto &entry : goto_functions.function_map)
+    REQUIRE_FALSE(entry.second.body_available());
+
+  // bodies that only differ in their source locations have one fingerprint
+  goto_programt &main_body =
+    goto_model.goto_functions.function_map["main"].body;
+  for(auto &instruction : main_body.instructions)
+    instruction.source_location.set_line(42);
+  REQUIRE(fingerprints.at("main") == goto_program_fingerprint(main_body));
+  REQUIRE(fingerprints.at("main") != fingerprints.at("f"));
+  REQUIRE(
+    fingerprints.at("f") ==
+    goto_program_fingerprint(goto_model.goto_functions.function_map["f"].body));
+}
@@ -0,0 +1,99 @@
+/*******************************************************************\
+
+Module: Unit tests for reading and linking goto binaries
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/std_code.h>
+#include <util/tempfile.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/read_goto_binary.h>
+#include <goto-programs/write_goto_binary.h>
+
+#include <fstream>
+
+/// Write a goto binary defining a single function \p name that calls \p callee
+static void write_binary(
+  const std::string &file_name,
+  const irep_idt &name,
+  const irep_idt &callee)
+{
+  const code_typet code_type({}, empty_typet());
+  goto_modelt goto_model;
+
+  symbolt function;
+  function.name = name;
+  function.base_name = name;
+  function.mode = ID_C;
+  function.type = code_type;
+  goto_model.symbol_table.add(function);
+
+  symbolt declaration;
+  declaration.name = callee;
+  declaration.base_name = callee;
+  declaration.mode = ID_C;
+  declaration.type = code_type;
+  goto_model.symbol_table.add(declaration);
+
+  goto_programt &body = goto_model.goto_functions.function_map[name].body;
+  body.add(goto_programt::make_function_call(
+    code_function_callt(symbol_exprt(callee, code_type))));
+  body.add(goto_programt::make_end_function());
+
+  std::ofstream out(file_name, std::ios::binary);
+  REQUIRE_FALSE(write_goto_binary(out, goto_model));
+}
+
+TEST_CASE(
+  "Read and link goto binaries using multiple threads",
+  "[core][goto-programs][read_objects_and_link]")
+{
+  const std::size_t number_of_files = 16;
+  std::vector<temporary_filet> files;
+  std::list<std::string> file_names;
+
+  for(std::size_t i = 0; i < number_of_files; ++i)
+  {
+    files.emplace_back("read_objects_and_link", ".gb");
+    file_names.push_back(files.back()());
+    write_binary(
+      file_names.back(),
+      "f" + std::to_string(i),
+      "f" + std::to_string((i + 1) % number_of_files));
+  }
+
+  goto_modelt serial;
+  REQUIRE_FALSE(
+    read_objects_and_link(file_names, serial, null_message_handler, 1));
+
+  goto_modelt parallel;
+  REQUIRE_FALSE(
+    read_objects_and_link(file_names, parallel, null_message_handler, 4));
+
+  REQUIRE(serial.symbol_table.symbols.size() == number_of_files);
+  REQUIRE(parallel.symbol_table.symbols.size() == number_of_files);
+
+  for(std::size_t i = 0; i < number_of_files; ++i)
+  {
+    const irep_idt name = "f" + std::to_string(i);
+    REQUIRE(serial.goto_functions.function_map.at(name).body_available());
+    REQUIRE(parallel.goto_functions.function_map.at(name).body_available());
+    REQUIRE(
+      serial.goto_functions.function_map.at(name).body.instructions.size() ==
+      parallel.goto_functions.function_map.at(name).body.instructions.size());
+  }
+
+  SECTION("Missing files are reported")
+  {
+    file_names.push_back(file_names.front() + ".missing");
+    goto_modelt goto_model;
+    REQUIRE(
+      read_objects_and_link(file_names, goto_model, null_message_handler, 4));
+  }
+}
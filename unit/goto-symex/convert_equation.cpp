@@ -0,0 +1,255 @@
+/*******************************************************************\
+
+Module: Unit tests for symex_target_equationt::convert
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/std_expr.h>
+
+#include <goto-symex/symex_target_equation.h>
+#include <solvers/decision_procedure.h>
+
+#include <algorithm>
+#include <chrono>
+
+/// Decision procedure that only counts the constraints it is given
+class counting_decision_proceduret : public decision_proceduret
+{
+public:
+  std::size_t constraints = 0;
+  std::size_t handles = 0;
+
+  void set_to(const exprt &, bool) override
+  {
+    ++constraints;
+  }
+
+  exprt handle(const exprt &expr) override
+  {
+    ++handles;
+    return expr;
+  }
+
+  exprt get(const exprt &) const override
+  {
+    return nil_exprt();
+  }
+
+  void print_assignment(std::ostream &) const override
+  {
+  }
+
+  std::string decision_procedure_text() const override
+  {
+    return "counting";
+  }
+
+  std::size_t get_number_of_solver_calls() const override
+  {
+    return 0;
+  }
+
+protected:
+  resultt dec_solve() override
+  {
+    return resultt::D_ERROR;
+  }
+};
+
+/// Add \p n assignments `x#i = x#(i-1) + 1` to \p equation
+static void add_assignments(
+  symex_target_equationt &equation,
+  const symex_targett::sourcet &source,
+  std::size_t n)
+{
+  const signedbv_typet type(32);
+  const symbol_exprt x("x", type);
+
+  for(std::size_t i = 1; i <= n; ++i)
+  {
+    ssa_exprt lhs(x);
+    lhs.set_level_2(i);
+    ssa_exprt previous(x);
+    previous.set_level_2(i - 1);
+
+    equation.assignment(
+      true_exprt(),
+      lhs,
+      lhs,
+      x,
+      plus_exprt(previous, from_integer(1, type)),
+      source,
+      symex_targett::assignment_typet::STATE);
+  }
+}
+
+SCENARIO(
+  "Converting an equation",
+  "[core][goto-symex][symex_target_equation]")
+{
+  goto_programt goto_program;
+  goto_program.add_instruction(SKIP);
+  const symex_targett::sourcet source("f", goto_program);
+
+  symex_target_equationt equation(null_message_handler);
+  add_assignments(equation, source, 1000);
+  const SSA_stept &first = equation.SSA_steps.front();
+
+  GIVEN("An equation of assignments")
+  {
+    // steps do not move as the equation grows
+    add_assignments(equation, source, 1000);
+    REQUIRE(&first == &*equation.SSA_steps.begin());
+    REQUIRE(equation.SSA_steps.size() == 2000);
+    REQUIRE(&*equation.get_SSA_step(1500) == &equation.SSA_steps[1500]);
+
+    WHEN("Converting it")
+    {
+      counting_decision_proceduret decision_procedure;
+      equation.convert(decision_procedure);
+
+      THEN("Each assignment is passed on once")
+      {
+        REQUIRE(decision_procedure.constraints == 2000);
+        REQUIRE(std::all_of(
+          equation.SSA_steps.begin(),
+          equation.SSA_steps.end(),
+          [](const SSA_stept &step) { return step.converted; }));
+      }
+    }
+  }
+}
+
+SCENARIO(
+  "Streaming an equation to a decision procedure",
+  "[core][goto-symex][symex_target_equation]")
+{
+  goto_programt goto_program;
+  goto_program.add_instruction(SKIP);
+  const symex_targett::sourcet source("f", goto_program);
+  const symbol_exprt g("g", bool_typet());
+
+  symex_target_equationt equation(null_message_handler);
+  add_assignments(equation, source, 10);
+
+  GIVEN("A decision procedure that the equation is streamed to")
+  {
+    counting_decision_proceduret decision_procedure;
+    equation.stream_to(decision_procedure);
+    REQUIRE(equation.is_streaming());
+
+    THEN("Existing and new steps are converted right away")
+    {
+      REQUIRE(decision_procedure.constraints == 10);
+      add_assignments(equation, source, 5);
+      REQUIRE(decision_procedure.constraints == 15);
+      REQUIRE(equation.SSA_steps.back().converted);
+      REQUIRE(equation.SSA_steps.back().cond_expr.is_true());
+    }
+
+    THEN("Assertions are left for convert")
+    {
+      equation.assumption(g, g, source);
+      const std::size_t handles = decision_procedure.handles;
+      equation.assertion(true_exprt(), not_exprt(g), "property", source);
+      REQUIRE(decision_procedure.handles == handles);
+      REQUIRE_FALSE(equation.SSA_steps.back().converted);
+
+      equation.convert(decision_procedure);
+      REQUIRE(decision_procedure.constraints == 10 + 2);
+      REQUIRE(equation.SSA_steps.back().converted);
+      // the condition of the assumption is kept for traces
+      REQUIRE(equation.SSA_steps[10].cond_expr == g);
+    }
+  }
+}
+
+SCENARIO(
+  "Spilling the steps of an equation to disk",
+  "[core][goto-symex][symex_target_equation]")
+{
+  goto_programt goto_program;
+  goto_program.add_instruction(SKIP);
+  const symex_targett::sourcet source("f", goto_program);
+  const symbol_exprt g("g", bool_typet());
+
+  symex_target_equationt equation(null_message_handler);
+  add_assignments(equation, source, 10);
+  equation.assertion(true_exprt(), not_exprt(g), "property", source);
+
+  GIVEN("A partly converted equation")
+  {
+    counting_decision_proceduret decision_procedure;
+    equation.stream_to(decision_procedure);
+    const SSA_stept step = equation.SSA_steps[5];
+
+    WHEN("Spilling its converted steps")
+    {
+      equation.spill_converted_steps();
+      REQUIRE(equation.has_spilled_steps());
+
+      THEN("The expressions of converted steps are released")
+      {
+        const SSA_stept &spilled = equation.SSA_steps[5];
+        REQUIRE(spilled.spilled);
+        REQUIRE(spilled.ssa_rhs.is_nil());
+        REQUIRE(spilled.ssa_lhs == step.ssa_lhs);
+        REQUIRE(spilled.guard_handle == step.guard_handle);
+        // the assertion has not been converted
+        REQUIRE_FALSE(equation.SSA_steps[10].spilled);
+        REQUIRE(equation.SSA_steps[10].cond_expr == not_exprt(g));
+      }
+
+      THEN("Restoring them brings the expressions back")
+      {
+        add_assignments(equation, source, 5);
+        equation.spill_converted_steps();
+        equation.restore_spilled_steps();
+        REQUIRE_FALSE(equation.has_spilled_steps());
+
+        const SSA_stept &restored = equation.SSA_steps[5];
+        REQUIRE_FALSE(restored.spilled);
+        REQUIRE(restored.ssa_rhs == step.ssa_rhs);
+        REQUIRE(restored.ssa_full_lhs == step.ssa_full_lhs);
+        REQUIRE(restored.original_full_lhs == step.original_full_lhs);
+        REQUIRE(restored.guard == step.guard);
+        REQUIRE(restored.cond_expr == step.cond_expr);
+        REQUIRE(equation.SSA_steps[13].ssa_rhs.is_not_nil());
+      }
+    }
+  }
+}
+
+TEST_CASE(
+  "symex_target_equationt::convert benchmark",
+  "[.][benchmark][symex_target_equation]")
+{
+  using clockt = std::chrono::steady_clock;
+
+  goto_programt goto_program;
+  goto_program.add_instruction(SKIP);
+  const symex_targett::sourcet source("f", goto_program);
+
+  symex_target_equationt equation(null_message_handler);
+  add_assignments(equation, source, 1000000);
+
+  const auto start = clockt::now();
+  counting_decision_proceduret decision_procedure;
+  equation.convert(decision_procedure);
+  const auto end = clockt::now();
+
+  WARN(
+    "converted " << equation.SSA_steps.size() << " steps in "
+                 << std::chrono::duration_cast<std::chrono::milliseconds>(
+                      end - start)
+                      .count()
+                 << " ms");
+  REQUIRE(decision_procedure.constraints == equation.SSA_steps.size());
+}
@@ -0,0 +1,78 @@
+/*******************************************************************\
+
+Module: Unit tests for deduplicate_SSA_steps
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/bitvector_types.h>
+#include <util/std_expr.h>
+
+#include <goto-symex/slice.h>
+#include <goto-symex/symex_target_equation.h>
+
+SCENARIO(
+  "Duplicate SSA steps are ignored",
+  "[core][goto-symex][deduplicate_SSA_steps]")
+{
+  const signedbv_typet type(32);
+  const symbol_exprt x("x", type);
+  const symbol_exprt y("y", type);
+  const symbol_exprt g("g", bool_typet());
+
+  goto_programt goto_program;
+  goto_program.add_instruction(SKIP);
+  const symex_targett::sourcet source("f", goto_program);
+
+  symex_target_equationt equation(null_message_handler);
+
+  auto add_step = [&](goto_trace_stept::typet type, const exprt &guard,
+                      const exprt &cond) -> SSA_stept & {
+    equation.SSA_steps.emplace_back(source, type);
+    equation.SSA_steps.back().guard = guard;
+    equation.SSA_steps.back().cond_expr = cond;
+    return equation.SSA_steps.back();
+  };
+
+  GIVEN("An equation with repeated assignments, assumptions and constraints")
+  {
+    const equal_exprt x_eq_y(x, y);
+    const binary_relation_exprt x_lt_y(x, ID_lt, y);
+
+    add_step(goto_trace_stept::typet::ASSIGNMENT, true_exprt(), x_eq_y);
+    add_step(goto_trace_stept::typet::ASSUME, g, x_lt_y);
+    add_step(goto_trace_stept::typet::ASSIGNMENT, g, x_eq_y);
+    add_step(goto_trace_stept::typet::CONSTRAINT, true_exprt(), x_eq_y);
+    // an assumption under a different guard is not a duplicate
+    add_step(goto_trace_stept::typet::ASSUME, true_exprt(), x_lt_y);
+    add_step(goto_trace_stept::typet::ASSUME, g, x_lt_y);
+    // nor is an assertion
+    add_step(goto_trace_stept::typet::ASSERT, true_exprt(), x_eq_y);
+
+    WHEN("Deduplicating")
+    {
+      const std::size_t removed = deduplicate_SSA_steps(equation);
+
+      THEN("Only the later copies are ignored")
+      {
+        REQUIRE(removed == 3);
+
+        std::vector<bool> ignored;
+        for(const auto &step : equation.SSA_steps)
+          ignored.push_back(step.ignore);
+        REQUIRE(
+          ignored ==
+          std::vector<bool>{false, false, true, true, false, true, false});
+      }
+
+      THEN("A second pass finds nothing to remove")
+      {
+        REQUIRE(deduplicate_SSA_steps(equation) == 0);
+      }
+    }
+  }
+}
@@ -180,3 +180,171 @@ SCENARIO(
     }
   }
 }
+
+SCENARIO(
+  "Goto symex state rename cache",
+  "[core][goto-symex][goto-symex-state][rename_cache]")
+{
+  std::list<goto_programt::instructiont> target;
+  symex_targett::sourcet source{"fun", target.begin()};
+  guard_managert manager;
+  std::size_t fresh_name_count = 1;
+  auto fresh_name = [&fresh_name_count](const irep_idt &) {
+    return fresh_name_count++;
+  };
+  goto_symex_statet state{
+    source, DEFAULT_MAX_FIELD_SENSITIVITY_ARRAY_SIZE, manager, fresh_name};
+  state.rename_cache.set_max_entries(16);
+
+  incremental_dirtyt dirty;
+  goto_functiont function;
+  dirty.populate_dirty_for_function("fun", function);
+  state.dirty = &dirty;
+
+  symbol_tablet symbol_table;
+  namespacet ns{symbol_table};
+  const signedbv_typet int_type{32};
+  const symbol_exprt foo{"foo", int_type};
+  add_to_symbol_table(symbol_table, foo);
+  const symbol_exprt bar{"bar", int_type};
+  add_to_symbol_table(symbol_table, bar);
+
+  const plus_exprt expr{foo, from_integer(1, int_type)};
+
+  GIVEN("A symbol with a constant value")
+  {
+    (void)state.assignment(
+      ssa_exprt{foo}, from_integer(475, int_type), ns, true, true, false);
+
+    const exprt renamed = state.rename(expr, ns).get();
+    REQUIRE(renamed == plus_exprt{from_integer(475, int_type),
+                                  from_integer(1, int_type)});
+    REQUIRE(state.rename_cache.misses == 1);
+
+    WHEN("Renaming the expression again")
+    {
+      const exprt renamed_again = state.rename(expr, ns).get();
+
+      THEN("The cached renaming is used")
+      {
+        REQUIRE(renamed_again == renamed);
+        REQUIRE(state.rename_cache.hits == 1);
+      }
+    }
+
+    WHEN("Renaming the expression after assigning a non-constant value")
+    {
+      const exprt l2_bar = state.rename(bar, ns).get();
+      (void)state.assignment(ssa_exprt{foo}, l2_bar, ns, true, true, false);
+      const exprt renamed_again = state.rename(expr, ns).get();
+
+      THEN("The renaming is computed anew")
+      {
+        REQUIRE(state.rename_cache.hits == 0);
+        REQUIRE(state.rename_cache.misses == 2);
+        REQUIRE(renamed_again.id() == ID_plus);
+        REQUIRE(
+          to_ssa_expr(to_plus_expr(renamed_again).op0()).get_identifier() ==
+          "foo!0#2");
+
+        const exprt renamed_third = state.rename(expr, ns).get();
+        REQUIRE(renamed_third == renamed_again);
+        REQUIRE(state.rename_cache.hits == 1);
+      }
+    }
+  }
+}
+
+SCENARIO(
+  "Goto symex state element propagation",
+  "[core][goto-symex][goto-symex-state][element_propagation]")
+{
+  std::list<goto_programt::instructiont> target;
+  symex_targett::sourcet source{"fun", target.begin()};
+  guard_managert manager;
+  std::size_t fresh_name_count = 1;
+  auto fresh_name = [&fresh_name_count](const irep_idt &) {
+    return fresh_name_count++;
+  };
+  goto_symex_statet state{
+    source, DEFAULT_MAX_FIELD_SENSITIVITY_ARRAY_SIZE, manager, fresh_name};
+
+  incremental_dirtyt dirty;
+  goto_functiont function;
+  dirty.populate_dirty_for_function("fun", function);
+  state.dirty = &dirty;
+
+  // an array too large for field sensitivity
+  symbol_tablet symbol_table;
+  namespacet ns{symbol_table};
+  const signedbv_typet int_type{32};
+  const signedbv_typet index_type{64};
+  const array_typet array_type{int_type, from_integer(1000, index_type)};
+  const symbol_exprt arr{"arr", array_type};
+  add_to_symbol_table(symbol_table, arr);
+  const symbol_exprt bar{"bar", int_type};
+  add_to_symbol_table(symbol_table, bar);
+  const symbol_exprt i{"i", index_type};
+  add_to_symbol_table(symbol_table, i);
+
+  const index_exprt element_5{arr, from_integer(5, index_type)};
+  const index_exprt element_6{arr, from_integer(6, index_type)};
+
+  auto assign = [&](const exprt &rhs) {
+    const exprt l2_rhs = state.rename(rhs, ns).get();
+    (void)state.assignment(ssa_exprt{arr}, l2_rhs, ns, true, true, false);
+  };
+
+  GIVEN("A constant written to an element of a non-constant array")
+  {
+    assign(with_exprt{arr, element_5.index(), from_integer(3, int_type)});
+
+    THEN("Only reads of that element are propagated")
+    {
+      REQUIRE(state.rename(element_5, ns).get() == from_integer(3, int_type));
+      const exprt renamed_6 = state.rename(element_6, ns).get();
+      REQUIRE(renamed_6.id() == ID_index);
+      REQUIRE(is_ssa_expr(to_index_expr(renamed_6).array()));
+    }
+
+    WHEN("Writing a constant to another element")
+    {
+      assign(with_exprt{arr, element_6.index(), from_integer(4, int_type)});
+
+      THEN("Both elements are propagated")
+      {
+        REQUIRE(
+          state.rename(element_5, ns).get() == from_integer(3, int_type));
+        REQUIRE(
+          state.rename(element_6, ns).get() == from_integer(4, int_type));
+      }
+    }
+
+    WHEN("Writing to an element at a non-constant index")
+    {
+      assign(with_exprt{arr, i, from_integer(4, int_type)});
+
+      THEN("No element is propagated")
+      {
+        REQUIRE(state.rename(element_5, ns).get().id() == ID_index);
+      }
+    }
+  }
+
+  GIVEN("A non-constant value written to an element of a constant array")
+  {
+    const array_of_exprt zeros{from_integer(0, int_type), array_type};
+    assign(zeros);
+    assign(with_exprt{arr, element_5.index(), bar});
+
+    THEN("The other elements keep their constant value")
+    {
+      REQUIRE(
+        state.rename(element_6, ns).get() ==
+        index_exprt{zeros, element_6.index()});
+      const exprt renamed_5 = state.rename(element_5, ns).get();
+      REQUIRE(renamed_5.id() == ID_index);
+      REQUIRE(is_ssa_expr(to_index_expr(renamed_5).array()));
+    }
+  }
+}
@@ -0,0 +1,149 @@
+/*******************************************************************\
+
+Module: Unit tests for the memory models
+
+Author: Michael Tautschnig
+
+\*******************************************************************/
+
+#include <testing-utils/benchmark.h>
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/bitvector_types.h>
+#include <util/namespace.h>
+#include <util/ssa_expr.h>
+#include <util/symbol_table.h>
+
+#include <goto-symex/memory_model_sc.h>
+#include <goto-symex/symex_target_equation.h>
+
+#include <algorithm>
+
+/// Append to \p equation a shared read or write of `x` by thread
+/// \p thread_nr, with L2 index \p index
+static void add_shared_access(
+  symex_target_equationt &equation,
+  const goto_programt &goto_program,
+  goto_trace_stept::typet type,
+  unsigned thread_nr,
+  std::size_t index)
+{
+  symex_targett::sourcet source("main", goto_program);
+  source.thread_nr = thread_nr;
+
+  equation.SSA_steps.emplace_back(source, type);
+  SSA_stept &step = equation.SSA_steps.back();
+  step.guard = true_exprt();
+  ssa_exprt x{symbol_exprt{"x", signedbv_typet{32}}};
+  x.set_level_2(index);
+  step.ssa_lhs = x;
+  step.atomic_section_id = 0;
+}
+
+/// Thread 0 writes `x` \p writes times, reading it after each write, while
+/// thread 1 writes it once
+static symex_target_equationt
+make_equation(const goto_programt &goto_program, std::size_t writes)
+{
+  symex_target_equationt equation(null_message_handler);
+
+  symex_targett::sourcet source("main", goto_program);
+  equation.SSA_steps.emplace_back(source, goto_trace_stept::typet::SPAWN);
+
+  std::size_t index = 1;
+  for(std::size_t i = 0; i < writes; ++i)
+  {
+    add_shared_access(
+      equation,
+      goto_program,
+      goto_trace_stept::typet::SHARED_WRITE,
+      0,
+      index++);
+    add_shared_access(
+      equation,
+      goto_program,
+      goto_trace_stept::typet::SHARED_READ,
+      0,
+      index++);
+  }
+  add_shared_access(
+    equation, goto_program, goto_trace_stept::typet::SHARED_WRITE, 1, index++);
+
+  return equation;
+}
+
+static std::size_t count_read_from_pairs(const symex_target_equationt &equation)
+{
+  return std::count_if(
+    equation.SSA_steps.begin(),
+    equation.SSA_steps.end(),
+    [](const SSA_stept &step) {
+      return step.is_constraint() &&
+             (step.comment == "rf" || step.comment == "rfi");
+    });
+}
+
+SCENARIO(
+  "memory_model_sct prunes read-from pairs of shadowed writes",
+  "[core][goto-symex][memory_model]")
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+  goto_programt goto_program;
+  goto_program.add(goto_programt::make_skip());
+
+  GIVEN("Reads that follow one and two writes of their thread")
+  {
+    symex_target_equationt equation = make_equation(goto_program, 2);
+    memory_model_sct memory_model(ns);
+
+    WHEN("Read-from pairs are not pruned")
+    {
+      memory_model(equation, null_message_handler);
+
+      THEN("Each read may read from all writes that do not follow it")
+      {
+        // the initial value, the preceding writes and the other thread's
+        REQUIRE(count_read_from_pairs(equation) == 3 + 4);
+      }
+    }
+
+    WHEN("Read-from pairs are pruned")
+    {
+      memory_model.set_prune_read_from(true);
+      memory_model(equation, null_message_handler);
+
+      THEN("Each read may read from the last write of each thread only")
+      {
+        REQUIRE(count_read_from_pairs(equation) == 2 + 2);
+      }
+    }
+  }
+}
+
+TEST_CASE(
+  "memory_model_sct benchmark",
+  "[.][benchmark][goto-symex][memory_model]")
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+  goto_programt goto_program;
+  goto_program.add(goto_programt::make_skip());
+
+  const symex_target_equationt equation = make_equation(goto_program, 30);
+
+  for(const bool prune_read_from : {false, true})
+  {
+    run_benchmark(
+      prune_read_from ? "memory_model_sct pruning read-from pairs"
+                      : "memory_model_sct",
+      5,
+      [&]() {
+        symex_target_equationt copy = equation;
+        memory_model_sct memory_model(ns);
+        memory_model.set_prune_read_from(prune_read_from);
+        memory_model(copy, null_message_handler);
+      });
+  }
+}
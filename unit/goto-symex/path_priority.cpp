@@ -0,0 +1,120 @@
+/*******************************************************************\
+
+Module: Unit tests for the priority based path strategies
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <goto-symex/path_storage.h>
+
+/// Save a path that resumes from \p resume_at with \p depth branches taken
+static void push_path(
+  path_storaget &storage,
+  const symex_target_equationt &equation,
+  goto_symex_statet &state,
+  goto_programt::const_targett resume_at,
+  unsigned depth)
+{
+  state.saved_target = resume_at;
+  state.has_saved_next_instruction = true;
+  state.depth = depth;
+  storage.push(path_storaget::patht(equation, state));
+}
+
+SCENARIO(
+  "Priority based path strategies",
+  "[core][goto-symex][path_priority]")
+{
+  // if(c) goto 3; 1: assert(p1); 2: assert(p2); 3: assert(p3);
+  goto_programt body;
+  source_locationt locations[3];
+  goto_programt::targett assertions[3];
+  auto branch = body.add(goto_programt::make_incomplete_goto(
+    symbol_exprt("c", bool_typet())));
+  for(std::size_t i = 0; i < 3; ++i)
+  {
+    locations[i].set_property_id("p" + std::to_string(i + 1));
+    assertions[i] = body.add(
+      goto_programt::make_assertion(false_exprt(), locations[i]));
+  }
+  body.add(goto_programt::make_end_function());
+  branch->complete_goto(assertions[2]);
+  body.update();
+
+  symex_targett::sourcet source("main", body.instructions.begin());
+  guard_managert manager;
+  std::size_t fresh_name_count = 1;
+  auto fresh_name = [&fresh_name_count](const irep_idt &) {
+    return fresh_name_count++;
+  };
+  goto_symex_statet state{
+    source, DEFAULT_MAX_FIELD_SENSITIVITY_ARRAY_SIZE, manager, fresh_name};
+  symex_target_equationt equation(null_message_handler);
+
+  GIVEN("The strategy preferring shallow paths")
+  {
+    auto storage = get_path_strategy("shallow");
+    push_path(*storage, equation, state, assertions[0], 2);
+    push_path(*storage, equation, state, assertions[1], 1);
+    push_path(*storage, equation, state, assertions[2], 1);
+
+    THEN("Paths resume in order of depth, the last saved one first")
+    {
+      REQUIRE(storage->size() == 3);
+      REQUIRE(storage->peek().state.saved_target == assertions[2]);
+
+      // paths saved while a path is resumed do not replace it
+      push_path(*storage, equation, state, assertions[0], 0);
+      REQUIRE(storage->peek().state.saved_target == assertions[2]);
+      storage->pop();
+
+      REQUIRE(storage->peek().state.saved_target == assertions[0]);
+      REQUIRE(storage->peek().state.depth == 0);
+      storage->pop();
+      REQUIRE(storage->peek().state.saved_target == assertions[1]);
+      storage->pop();
+      REQUIRE(storage->peek().state.depth == 2);
+      storage->pop();
+      REQUIRE(storage->empty());
+    }
+  }
+
+  GIVEN("The strategy preferring paths to uncovered assertions")
+  {
+    auto storage = get_path_strategy("uncovered");
+    push_path(*storage, equation, state, assertions[2], 0);
+    push_path(*storage, equation, state, assertions[1], 0);
+
+    THEN("The path reaching the most assertions is resumed first")
+    {
+      REQUIRE(storage->peek().state.saved_target == assertions[1]);
+    }
+
+    WHEN("A path that reached assertions is popped")
+    {
+      path_storaget::patht &path = storage->peek();
+      for(std::size_t i = 1; i < 3; ++i)
+      {
+        path.equation.assertion(
+          true_exprt(),
+          false_exprt(),
+          "assertion",
+          symex_targett::sourcet("main", assertions[i]));
+      }
+      storage->pop();
+      push_path(*storage, equation, state, assertions[0], 0);
+
+      THEN("Paths reaching other assertions are resumed first")
+      {
+        REQUIRE(storage->size() == 2);
+        REQUIRE(storage->peek().state.saved_target == assertions[0]);
+        storage->pop();
+        REQUIRE(storage->peek().state.saved_target == assertions[2]);
+      }
+    }
+  }
+}
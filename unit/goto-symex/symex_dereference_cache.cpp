@@ -0,0 +1,72 @@
+/*******************************************************************\
+
+Module: Unit test for goto-symex/symex_dereference_cache
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/bitvector_types.h>
+#include <util/pointer_expr.h>
+
+#include <goto-symex/symex_dereference_cache.h>
+
+SCENARIO(
+  "Caching the result of value-set dereferencing",
+  "[core][goto-symex][symex_dereference_cache]")
+{
+  const signedbv_typet type(32);
+  const pointer_typet pointer_type(type, 64);
+  const symbol_exprt p("p", pointer_type);
+  const symbol_exprt q("q", pointer_type);
+  const symbol_exprt a("a", type);
+
+  dereference_dependenciest dependencies;
+  dependencies.value_sets.emplace_back(
+    p, std::vector<exprt>{address_of_exprt(a)});
+
+  GIVEN("A cache with room for two pointers")
+  {
+    symex_dereference_cachet cache(2);
+    REQUIRE(cache.enabled());
+    REQUIRE(cache.find(p, false) == nullptr);
+
+    cache.insert(p, false, a, dependencies);
+
+    THEN("The result is found for the same pointer and nullness only")
+    {
+      const symex_dereference_cachet::entryt *entry = cache.find(p, false);
+      REQUIRE(entry != nullptr);
+      REQUIRE(entry->result == a);
+      REQUIRE(entry->dependencies.value_sets.size() == 1);
+      REQUIRE(cache.find(p, true) == nullptr);
+      REQUIRE(cache.find(q, false) == nullptr);
+    }
+
+    WHEN("Inserting another pointer")
+    {
+      cache.insert(q, false, a, {});
+
+      THEN("The previous generation remains available")
+      {
+        REQUIRE(cache.evictions == 0);
+        REQUIRE(cache.find(q, false) != nullptr);
+        REQUIRE(cache.find(p, false) != nullptr);
+      }
+    }
+  }
+
+  GIVEN("A cache of size zero")
+  {
+    symex_dereference_cachet cache(0);
+
+    THEN("Nothing is cached")
+    {
+      REQUIRE_FALSE(cache.enabled());
+      cache.insert(p, false, a, dependencies);
+      REQUIRE(cache.find(p, false) == nullptr);
+    }
+  }
+}
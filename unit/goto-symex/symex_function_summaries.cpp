@@ -0,0 +1,104 @@
+/*******************************************************************\
+
+Module: Unit test for goto-symex/symex_function_summaries
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/pointer_expr.h>
+
+#include <goto-programs/remove_returns.h>
+#include <goto-symex/symex_function_summaries.h>
+
+SCENARIO(
+  "Summarising calls of functions without side effects",
+  "[core][goto-symex][symex_function_summaries]")
+{
+  const signedbv_typet type(32);
+  const symbol_exprt parameter("f::x", type);
+  const symbol_exprt local("f::1::y", type);
+  const symbol_exprt global("g", type);
+  const symbol_exprt return_value(return_value_identifier("f"), type);
+
+  goto_functiont goto_function;
+  goto_function.parameter_identifiers.push_back(parameter.get_identifier());
+  goto_programt &body = goto_function.body;
+  body.add(goto_programt::make_decl(local));
+  body.add(goto_programt::make_assignment(
+    local, plus_exprt(parameter, from_integer(1, type))));
+
+  symex_function_summariest summaries;
+
+  GIVEN("A function computing its return value from its parameter")
+  {
+    body.add(goto_programt::make_assignment(return_value, local));
+    body.add(goto_programt::make_end_function());
+
+    THEN("Its calls can be summarised")
+    {
+      REQUIRE(summaries.can_summarise("f", goto_function));
+    }
+
+    WHEN("Recording the result of a call")
+    {
+      const exprt::operandst arguments{from_integer(1, type)};
+      REQUIRE(summaries.find("f", arguments) == nullptr);
+      summaries.insert("f", arguments, from_integer(2, type));
+
+      THEN("Only calls on the same arguments find it")
+      {
+        const exprt *found = summaries.find("f", arguments);
+        REQUIRE(found != nullptr);
+        REQUIRE(*found == from_integer(2, type));
+        REQUIRE(summaries.find("f", {from_integer(2, type)}) == nullptr);
+        REQUIRE(summaries.find("h", arguments) == nullptr);
+        REQUIRE(summaries.hits == 1);
+        REQUIRE(summaries.misses == 3);
+      }
+    }
+  }
+
+  GIVEN("A function reading a global variable")
+  {
+    body.add(goto_programt::make_assignment(
+      return_value, plus_exprt(local, global)));
+    body.add(goto_programt::make_end_function());
+
+    THEN("Its calls cannot be summarised")
+    {
+      REQUIRE_FALSE(summaries.can_summarise("f", goto_function));
+    }
+  }
+
+  GIVEN("A function dereferencing a pointer")
+  {
+    const symbol_exprt pointer("f::p", pointer_typet(type, 64));
+    goto_function.parameter_identifiers.push_back(pointer.get_identifier());
+    body.add(goto_programt::make_assignment(
+      return_value, dereference_exprt(pointer)));
+    body.add(goto_programt::make_end_function());
+
+    THEN("Its calls cannot be summarised")
+    {
+      REQUIRE_FALSE(summaries.can_summarise("f", goto_function));
+    }
+  }
+
+  GIVEN("A function calling another function")
+  {
+    const symbol_exprt callee("h", code_typet({}, empty_typet()));
+    body.add(goto_programt::make_function_call(code_function_callt(callee)));
+    body.add(goto_programt::make_assignment(return_value, local));
+    body.add(goto_programt::make_end_function());
+
+    THEN("Its calls cannot be summarised")
+    {
+      REQUIRE_FALSE(summaries.can_summarise("f", goto_function));
+    }
+  }
+}
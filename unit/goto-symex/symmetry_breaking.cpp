@@ -0,0 +1,158 @@
+/*******************************************************************\
+
+Module: Unit tests for break_array_symmetries
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/std_expr.h>
+
+#include <goto-symex/symex_target_equation.h>
+#include <goto-symex/symmetry_breaking.h>
+
+SCENARIO(
+  "Arrays read at symbolic indices only are ordered",
+  "[core][goto-symex][symmetry_breaking]")
+{
+  const signedbv_typet element_type(32);
+  const signedbv_typet index_type(64);
+  const unsignedbv_typet unsigned_type(32);
+  const array_typet array_type(element_type, from_integer(4, index_type));
+
+  const symbol_exprt a("a", array_type);
+  const symbol_exprt i("i", unsigned_type);
+  const symbol_exprt j("j", unsigned_type);
+  const nondet_symbol_exprt nondet_i("nondet_i", unsigned_type);
+
+  goto_programt goto_program;
+  goto_program.add_instruction(SKIP);
+  const symex_targett::sourcet source("f", goto_program);
+
+  symex_target_equationt equation(null_message_handler);
+
+  auto add_step = [&](goto_trace_stept::typet type, const exprt &guard,
+                      const exprt &cond) {
+    equation.SSA_steps.emplace_back(source, type);
+    equation.SSA_steps.back().guard = guard;
+    equation.SSA_steps.back().cond_expr = cond;
+  };
+
+  const auto read = [&](const exprt &index) {
+    return index_exprt(a, typecast_exprt(index, index_type));
+  };
+
+  add_step(
+    goto_trace_stept::typet::ASSIGNMENT, true_exprt(), equal_exprt(i, nondet_i));
+  add_step(
+    goto_trace_stept::typet::ASSUME,
+    true_exprt(),
+    binary_relation_exprt(i, ID_lt, from_integer(4, unsigned_type)));
+  add_step(
+    goto_trace_stept::typet::ASSUME,
+    true_exprt(),
+    binary_relation_exprt(from_integer(3, unsigned_type), ID_ge, j));
+
+  const std::size_t steps = equation.SSA_steps.size();
+
+  GIVEN("Reads at symbols compared with each other and with the size")
+  {
+    add_step(
+      goto_trace_stept::typet::ASSERT,
+      notequal_exprt(i, j),
+      notequal_exprt(read(i), read(j)));
+
+    THEN("The elements of the array are constrained to ascend")
+    {
+      REQUIRE(break_array_symmetries(equation) == 1);
+      REQUIRE(equation.SSA_steps.size() == steps + 2);
+
+      const SSA_stept &constraint = equation.SSA_steps.back();
+      REQUIRE(constraint.is_constraint());
+
+      const auto element = [&](int k) {
+        return index_exprt(a, from_integer(k, index_type));
+      };
+      REQUIRE(
+        constraint.cond_expr ==
+        and_exprt(
+          binary_relation_exprt(element(0), ID_le, element(1)),
+          binary_relation_exprt(element(1), ID_le, element(2)),
+          binary_relation_exprt(element(2), ID_le, element(3))));
+
+      AND_THEN("The constraint breaks the symmetry once only")
+      {
+        REQUIRE(break_array_symmetries(equation) == 0);
+      }
+    }
+  }
+
+  GIVEN("A read at a constant index")
+  {
+    add_step(
+      goto_trace_stept::typet::ASSERT,
+      true_exprt(),
+      notequal_exprt(read(i), read(from_integer(0, unsigned_type))));
+
+    THEN("No constraint is added")
+    {
+      REQUIRE(break_array_symmetries(equation) == 0);
+      REQUIRE(equation.SSA_steps.size() == steps + 1);
+    }
+  }
+
+  GIVEN("An index compared with a value within the array")
+  {
+    add_step(
+      goto_trace_stept::typet::ASSERT,
+      binary_relation_exprt(j, ID_lt, from_integer(2, unsigned_type)),
+      notequal_exprt(read(i), read(j)));
+
+    THEN("No constraint is added")
+    {
+      REQUIRE(break_array_symmetries(equation) == 0);
+    }
+  }
+
+  GIVEN("An index computed from another one")
+  {
+    add_step(
+      goto_trace_stept::typet::ASSERT,
+      true_exprt(),
+      notequal_exprt(
+        read(i), read(plus_exprt(j, from_integer(1, unsigned_type)))));
+
+    THEN("No constraint is added")
+    {
+      REQUIRE(break_array_symmetries(equation) == 0);
+    }
+  }
+
+  GIVEN("An array that is written to")
+  {
+    const symbol_exprt a2("a2", array_type);
+    add_step(
+      goto_trace_stept::typet::ASSIGNMENT,
+      true_exprt(),
+      equal_exprt(
+        a2,
+        with_exprt(
+          a,
+          typecast_exprt(i, index_type),
+          from_integer(0, element_type))));
+    add_step(
+      goto_trace_stept::typet::ASSERT,
+      true_exprt(),
+      notequal_exprt(read(i), read(j)));
+
+    THEN("No constraint is added")
+    {
+      REQUIRE(break_array_symmetries(equation) == 0);
+    }
+  }
+}
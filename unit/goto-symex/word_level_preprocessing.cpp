@@ -0,0 +1,111 @@
+/*******************************************************************\
+
+Module: Unit tests for word_level_preprocessing
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/namespace.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+#include <goto-symex/symex_target_equation.h>
+#include <goto-symex/word_level_preprocessing.h>
+
+SCENARIO(
+  "Defined symbols are substituted and the steps simplified",
+  "[core][goto-symex][word_level_preprocessing]")
+{
+  const signedbv_typet type(32);
+  const symbol_exprt x("x", type);
+  const symbol_exprt y("y", type);
+  const symbol_exprt z("z", type);
+  const symbol_exprt w("w", type);
+  const symbol_exprt u("u", bool_typet());
+  const symbol_exprt g("g", bool_typet());
+
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  goto_programt goto_program;
+  goto_program.add_instruction(SKIP);
+  const symex_targett::sourcet source("f", goto_program);
+
+  symex_target_equationt equation(null_message_handler);
+
+  auto add_step = [&](goto_trace_stept::typet type, const exprt &guard,
+                      const exprt &cond) -> SSA_stept & {
+    equation.SSA_steps.emplace_back(source, type);
+    equation.SSA_steps.back().guard = guard;
+    equation.SSA_steps.back().cond_expr = cond;
+    return equation.SSA_steps.back();
+  };
+
+  const auto constant = [&type](int value) {
+    return from_integer(value, type);
+  };
+
+  GIVEN("An equation with constant definitions")
+  {
+    add_step(
+      goto_trace_stept::typet::ASSIGNMENT,
+      true_exprt(),
+      equal_exprt(x, constant(5)));
+    add_step(
+      goto_trace_stept::typet::ASSIGNMENT,
+      true_exprt(),
+      equal_exprt(y, plus_exprt(x, constant(1))));
+    // z is defined by a later constraint
+    add_step(
+      goto_trace_stept::typet::ASSIGNMENT,
+      true_exprt(),
+      equal_exprt(w, mult_exprt(z, y)));
+    add_step(
+      goto_trace_stept::typet::ASSIGNMENT, true_exprt(), equal_exprt(g, u));
+    add_step(
+      goto_trace_stept::typet::ASSERT,
+      g,
+      binary_relation_exprt(w, ID_equal, constant(18)));
+    add_step(
+      goto_trace_stept::typet::CONSTRAINT,
+      true_exprt(),
+      equal_exprt(z, constant(3)));
+    SSA_stept &converted = add_step(
+      goto_trace_stept::typet::ASSUME,
+      true_exprt(),
+      binary_relation_exprt(x, ID_lt, y));
+    converted.converted = true;
+
+    WHEN("Preprocessing")
+    {
+      const std::size_t changed = word_level_preprocessing(equation, ns);
+
+      THEN("The definitions are propagated")
+      {
+        REQUIRE(changed == 3);
+
+        auto it = equation.SSA_steps.begin();
+        REQUIRE(it->cond_expr == equal_exprt(x, constant(5)));
+        ++it;
+        REQUIRE(it->cond_expr == equal_exprt(y, constant(6)));
+        ++it;
+        REQUIRE(it->cond_expr == equal_exprt(w, constant(18)));
+        ++it;
+        REQUIRE(it->cond_expr == equal_exprt(g, u));
+        ++it;
+        REQUIRE(it->guard == u);
+        REQUIRE(it->cond_expr == true_exprt());
+        ++it;
+        REQUIRE(it->cond_expr == equal_exprt(z, constant(3)));
+        ++it;
+        REQUIRE(it->cond_expr == binary_relation_exprt(x, ID_lt, y));
+      }
+    }
+  }
+}
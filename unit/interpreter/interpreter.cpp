@@ -11,6 +11,8 @@ Author: Diffblue Ltd.
 #include <goto-programs/goto_functions.h>
 #include <goto-programs/interpreter_class.h>
 
+#include <util/arith_tools.h>
+#include <util/c_types.h>
 #include <util/message.h>
 #include <util/mp_arith.h>
 #include <util/pointer_expr.h>
@@ -36,6 +38,18 @@ public:
     interpreter.evaluate(expression, result);
     return result;
   }
+
+  mp_vectort evaluate_instruction_expr(const exprt &expression)
+  {
+    mp_vectort result;
+    interpreter.evaluate_instruction_expr(expression, result);
+    return result;
+  }
+
+  bool is_compiled(const exprt &expression)
+  {
+    return interpreter.compile(expression) != nullptr;
+  }
 };
 
 SCENARIO("interpreter evaluation null pointer expressions")
@@ -69,3 +83,55 @@ SCENARIO("interpreter evaluation null pointer expressions")
     REQUIRE_THAT(mp_vector, Catch::Equals(null_vector));
   }
 }
+
+SCENARIO("interpreter compiled evaluation of scalar expressions")
+{
+  interpreter_testt interpreter_test;
+  const signedbv_typet int_type(32);
+  const exprt five = from_integer(5, int_type);
+  const exprt three = from_integer(3, int_type);
+
+  GIVEN("expressions over constants of integer types")
+  {
+    const std::vector<exprt> expressions = {
+      mult_exprt(plus_exprt(five, three), unary_minus_exprt(three)),
+      div_exprt(unary_minus_exprt(five), three),
+      minus_exprt(three, five),
+      binary_relation_exprt(five, ID_ge, three),
+      and_exprt(
+        binary_relation_exprt(five, ID_lt, three), equal_exprt(five, five)),
+      or_exprt(notequal_exprt(five, five), equal_exprt(three, three)),
+      not_exprt(equal_exprt(five, three)),
+      if_exprt(equal_exprt(five, three), five, three),
+      typecast_exprt(from_integer(200, int_type), signedbv_typet(8)),
+      typecast_exprt(unary_minus_exprt(five), unsignedbv_typet(8)),
+      typecast_exprt(unary_minus_exprt(five), signedbv_typet(64))};
+
+    THEN("the compiled code computes the values the interpreter does")
+    {
+      for(const auto &expression : expressions)
+      {
+        REQUIRE(interpreter_test.is_compiled(expression));
+        REQUIRE_THAT(
+          interpreter_test.evaluate_instruction_expr(expression),
+          Catch::Equals(interpreter_test.evaluate(expression)));
+      }
+    }
+  }
+
+  GIVEN("an expression whose value does not fit into 64 bits")
+  {
+    const signedbv_typet long_type(64);
+    const exprt expression = mult_exprt(
+      from_integer(power(2, 40), long_type),
+      from_integer(power(2, 40), long_type));
+
+    THEN("the interpreter computes its value")
+    {
+      REQUIRE(interpreter_test.is_compiled(expression));
+      REQUIRE_THAT(
+        interpreter_test.evaluate_instruction_expr(expression),
+        Catch::Equals(mp_vectort{power(2, 80)}));
+    }
+  }
+}
@@ -83,3 +83,39 @@ TEST_CASE("json symbol table read/write consistency")
 
   REQUIRE(symbol_table1 == symbol_table2);
 }
+
+TEST_CASE("json symbol table streaming read consistency")
+{
+  const std::string program = "int x; int main() { return x; }\n";
+  const auto goto_model = get_goto_model_from_c(program);
+
+  const symbol_tablet &symbol_table1 = goto_model.symbol_table;
+
+  std::ostringstream out;
+
+  {
+    test_ui_message_handlert ui_message_handler(out);
+    show_symbol_table(symbol_table1, ui_message_handler);
+  }
+
+  // the JSON UI wraps the symbol table in an array
+  std::ostringstream json_symbol_table;
+
+  {
+    std::istringstream in(out.str());
+    jsont json;
+    REQUIRE(!parse_json(in, "", null_message_handler, json));
+    REQUIRE(json.is_array());
+    json_symbol_table << *to_json_array(json).begin();
+  }
+
+  symbol_tablet symbol_table2;
+
+  {
+    std::istringstream in(json_symbol_table.str());
+    REQUIRE(
+      !parse_json_symbol_table(in, "", null_message_handler, symbol_table2));
+  }
+
+  REQUIRE(symbol_table1 == symbol_table2);
+}
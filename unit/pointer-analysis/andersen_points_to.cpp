@@ -0,0 +1,178 @@
+/*******************************************************************\
+
+Module: Unit tests for andersen_points_tot
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/bitvector_types.h>
+#include <util/namespace.h>
+#include <util/pointer_expr.h>
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+
+#include <goto-programs/goto_functions.h>
+#include <pointer-analysis/andersen_points_to.h>
+
+#include <algorithm>
+
+/// Add a variable \p name of type \p type to \p symbol_table
+static symbol_exprt
+add_variable(symbol_tablet &symbol_table, const irep_idt &name, typet type)
+{
+  symbolt symbol;
+  symbol.name = name;
+  symbol.base_name = name;
+  symbol.type = std::move(type);
+  symbol.is_lvalue = true;
+  symbol_table.add(symbol);
+  return symbol.symbol_expr();
+}
+
+/// \return whether the objects \p values are exactly \p expected
+static bool
+same_objects(std::vector<exprt> values, std::vector<symbol_exprt> expected)
+{
+  const auto identifier = [](const exprt &expr) {
+    return to_symbol_expr(expr).get_identifier();
+  };
+  const auto less = [&](const exprt &a, const exprt &b) {
+    return id2string(identifier(a)) < id2string(identifier(b));
+  };
+  std::sort(values.begin(), values.end(), less);
+  std::sort(expected.begin(), expected.end(), less);
+  return values.size() == expected.size() &&
+         std::equal(
+           values.begin(),
+           values.end(),
+           expected.begin(),
+           [&](const exprt &a, const exprt &b) {
+             return identifier(a) == identifier(b);
+           });
+}
+
+TEST_CASE(
+  "andersen_points_tot solves inclusion constraints",
+  "[core][pointer-analysis][andersen_points_to]")
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+  goto_functionst goto_functions;
+
+  const signedbv_typet int_type(32);
+  const pointer_typet int_pointer(int_type, 64);
+  const pointer_typet int_pointer_pointer(int_pointer, 64);
+
+  const symbol_exprt x = add_variable(symbol_table, "x", int_type);
+  const symbol_exprt y = add_variable(symbol_table, "y", int_type);
+  const symbol_exprt p = add_variable(symbol_table, "p", int_pointer);
+  const symbol_exprt q = add_variable(symbol_table, "q", int_pointer);
+  const symbol_exprt r = add_variable(symbol_table, "r", int_pointer);
+  const symbol_exprt pp =
+    add_variable(symbol_table, "pp", int_pointer_pointer);
+
+  goto_programt &body =
+    goto_functions.function_map[goto_functionst::entry_point()].body;
+
+  SECTION("Copies, loads and stores")
+  {
+    // p = &x; pp = &p; *pp = &y; q = *pp;
+    body.add(goto_programt::make_assignment(p, address_of_exprt(x)));
+    body.add(goto_programt::make_assignment(pp, address_of_exprt(p)));
+    body.add(goto_programt::make_assignment(
+      dereference_exprt(pp), address_of_exprt(y)));
+    body.add(goto_programt::make_assignment(q, dereference_exprt(pp)));
+    body.add(goto_programt::make_end_function());
+
+    andersen_points_tot points_to(ns);
+    points_to(goto_functions);
+
+    REQUIRE(same_objects(points_to.get_values(p), {x, y}));
+    REQUIRE(same_objects(points_to.get_values(q), {x, y}));
+    REQUIRE(same_objects(points_to.get_values(pp), {to_symbol_expr(p)}));
+    REQUIRE(points_to.get_values(r).empty());
+  }
+
+  SECTION("Cycles of copies are collapsed")
+  {
+    // p = q; q = r; r = p; r = &x;
+    body.add(goto_programt::make_assignment(p, q));
+    body.add(goto_programt::make_assignment(q, r));
+    body.add(goto_programt::make_assignment(r, p));
+    body.add(goto_programt::make_assignment(r, address_of_exprt(x)));
+    body.add(goto_programt::make_end_function());
+
+    andersen_points_tot points_to(ns);
+    points_to(goto_functions);
+
+    REQUIRE(same_objects(points_to.get_values(p), {x}));
+    REQUIRE(same_objects(points_to.get_values(q), {x}));
+    REQUIRE(same_objects(points_to.get_values(r), {x}));
+    REQUIRE(points_to.number_of_collapsed_nodes() == 2);
+  }
+}
+
+TEST_CASE(
+  "andersen_points_tot connects calls through function pointers",
+  "[core][pointer-analysis][andersen_points_to]")
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+  goto_functionst goto_functions;
+
+  const signedbv_typet int_type(32);
+  const pointer_typet int_pointer(int_type, 64);
+  code_typet::parametert parameter(int_pointer);
+  parameter.set_identifier("f::a");
+  const code_typet f_type({parameter}, int_pointer);
+  const pointer_typet f_pointer(f_type, 64);
+
+  const symbol_exprt f = add_variable(symbol_table, "f", f_type);
+  const symbol_exprt g = add_variable(symbol_table, "g", f_type);
+  const symbol_exprt a = add_variable(symbol_table, "f::a", int_pointer);
+  const symbol_exprt x = add_variable(symbol_table, "x", int_type);
+  const symbol_exprt r = add_variable(symbol_table, "r", int_pointer);
+  const symbol_exprt fp = add_variable(symbol_table, "fp", f_pointer);
+
+  // int *f(int *a) { return a; }
+  auto &f_function = goto_functions.function_map["f"];
+  f_function.parameter_identifiers.push_back("f::a");
+  f_function.body.add(goto_programt::make_return(code_returnt(a)));
+  f_function.body.add(goto_programt::make_end_function());
+
+  // fp = &f; r = (*fp)(&x);
+  goto_programt main;
+  main.add(goto_programt::make_assignment(fp, address_of_exprt(f)));
+  main.add(goto_programt::make_function_call(code_function_callt(
+    r, dereference_exprt(fp), {address_of_exprt(x)})));
+  main.add(goto_programt::make_end_function());
+
+  andersen_points_tot points_to(ns);
+
+  SECTION("All at once")
+  {
+    goto_functions.function_map[goto_functionst::entry_point()].body.swap(
+      main);
+    points_to(goto_functions);
+  }
+
+  SECTION("The callee added after solving")
+  {
+    goto_functionst::goto_functiont main_function;
+    main_function.body.swap(main);
+    points_to.add_function(goto_functionst::entry_point(), main_function);
+    points_to.solve();
+    REQUIRE(points_to.get_values(r).empty());
+
+    points_to.add_function("f", f_function);
+    points_to.solve();
+  }
+
+  REQUIRE(same_objects(points_to.get_values(fp), {f}));
+  REQUIRE(same_objects(points_to.get_values(a), {x}));
+  REQUIRE(same_objects(points_to.get_values(r), {x}));
+  REQUIRE_FALSE(same_objects(points_to.get_values(fp), {f, g}));
+}
@@ -0,0 +1,45 @@
+/*******************************************************************\
+
+Module: Unit tests for object_numberingt
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+
+#include <pointer-analysis/object_numbering.h>
+
+TEST_CASE(
+  "object_numberingt numbers expressions",
+  "[core][pointer-analysis][object_numbering]")
+{
+  object_numberingt numbering;
+  const signedbv_typet int_type(32);
+
+  REQUIRE_FALSE(numbering.get_number(from_integer(0, int_type)).has_value());
+
+  // enough to grow the table a number of times
+  for(std::size_t i = 0; i < 1000; ++i)
+    REQUIRE(numbering.number(from_integer(i, int_type)) == i);
+
+  REQUIRE(numbering.size() == 1000);
+
+  for(std::size_t i = 0; i < 1000; ++i)
+  {
+    const exprt expr = from_integer(i, int_type);
+    REQUIRE(numbering.number(expr) == i);
+    REQUIRE(numbering.get_number(expr) == i);
+    REQUIRE(numbering[i] == expr);
+  }
+
+  REQUIRE(numbering.size() == 1000);
+  REQUIRE_FALSE(numbering.get_number(from_integer(1000, int_type)).has_value());
+
+  numbering.clear();
+  REQUIRE(numbering.size() == 0);
+  REQUIRE(numbering.number(from_integer(999, int_type)) == 0);
+}
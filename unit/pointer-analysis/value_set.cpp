@@ -9,6 +9,7 @@ Author: Diffblue Ltd.
 /// \file
 /// Unit tests for value_sett
 
+#include <testing-utils/benchmark.h>
 #include <testing-utils/use_catch.h>
 
 #include <pointer-analysis/value_set.h>
@@ -305,3 +306,90 @@ SCENARIO(
     }
   }
 }
+
+TEST_CASE("value_sett::make_union merges object maps", "[core][value_set]")
+{
+  value_sett value_set;
+  const signedbv_typet int_type(32);
+  auto &numbering = value_sett::object_numbering;
+  const auto a = numbering.number(symbol_exprt("a", int_type));
+  const auto b = numbering.number(symbol_exprt("b", int_type));
+  const auto c = numbering.number(symbol_exprt("c", int_type));
+
+  value_sett::object_mapt dest;
+  value_set.insert(dest, a, mp_integer(0));
+  value_set.insert(dest, b, mp_integer(4));
+
+  value_sett::object_mapt src;
+  value_set.insert(src, b, mp_integer(8));
+  value_set.insert(src, c, mp_integer(0));
+
+  const value_sett::object_mapt shared = dest;
+  REQUIRE_FALSE(value_set.make_union_would_change(dest, dest));
+  REQUIRE(value_set.make_union_would_change(dest, src));
+  REQUIRE(value_set.make_union(dest, src));
+
+  // the objects in both get an unknown offset
+  const value_sett::object_map_dt expected{
+    {a, mp_integer(0)}, {b, value_sett::offsett()}, {c, mp_integer(0)}};
+  REQUIRE(dest.read() == expected);
+
+  // maps that were shared with the destination are unchanged
+  REQUIRE(shared.read().size() == 2);
+  REQUIRE(*shared.read().find(b)->second == 4);
+
+  REQUIRE_FALSE(value_set.make_union_would_change(dest, src));
+  REQUIRE_FALSE(value_set.make_union(dest, src));
+  REQUIRE_FALSE(value_set.make_union(dest, shared));
+
+  value_sett::object_mapt empty;
+  REQUIRE(value_set.make_union(empty, src));
+  REQUIRE(empty.read() == src.read());
+}
+
+TEST_CASE("value_sett merge benchmark", "[.][benchmark][value_set]")
+{
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+  const signedbv_typet int_type(32);
+  const pointer_typet int_pointer_type(int_type, 64);
+
+  const std::size_t number_of_pointers = 10000;
+  std::vector<symbol_exprt> pointers;
+  std::vector<symbol_exprt> objects;
+  for(std::size_t i = 0; i < number_of_pointers; ++i)
+  {
+    const std::string suffix = std::to_string(i);
+    symbolt pointer_symbol;
+    pointer_symbol.name = "p" + suffix;
+    pointer_symbol.type = int_pointer_type;
+    pointer_symbol.is_static_lifetime = true;
+    symbol_table.add(pointer_symbol);
+    pointers.push_back(pointer_symbol.symbol_expr());
+
+    symbolt object_symbol;
+    object_symbol.name = "o" + suffix;
+    object_symbol.type = int_type;
+    object_symbol.is_static_lifetime = true;
+    symbol_table.add(object_symbol);
+    objects.push_back(object_symbol.symbol_expr());
+  }
+
+  // two branches that agree on most pointers, as at a typical join point
+  value_sett branch1;
+  value_sett branch2;
+  for(std::size_t i = 0; i < number_of_pointers; ++i)
+  {
+    branch1.assign(
+      pointers[i], address_of_exprt(objects[i]), ns, false, false);
+    const std::size_t target = i % 10 == 0 ? (i + 1) % number_of_pointers : i;
+    branch2.assign(
+      pointers[i], address_of_exprt(objects[target]), ns, false, false);
+  }
+
+  run_benchmark("value_sett::make_union", 20, [&] {
+    value_sett merged = branch1;
+    REQUIRE(merged.make_union(branch2));
+    REQUIRE_FALSE(merged.make_union(branch1));
+  });
+}
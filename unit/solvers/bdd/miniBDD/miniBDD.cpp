@@ -327,6 +327,42 @@ SCENARIO("miniBDD", "[core][solver][miniBDD]")
     REQUIRE(oss.str() == dot_string);
   }
 
+  GIVEN("A bdd for x&y computed twice")
+  {
+    mini_bdd_mgrt mgr;
+
+    mini_bddt x_bdd = mgr.Var("x");
+    mini_bddt y_bdd = mgr.Var("y");
+    mini_bddt first_bdd = x_bdd & y_bdd;
+    const std::size_t cache_hits = mgr.statistics().cache_hits;
+    mini_bddt second_bdd = y_bdd & x_bdd;
+
+    THEN("The second conjunction is found in the cache")
+    {
+      REQUIRE(mgr.statistics().cache_hits == cache_hits + 1);
+      REQUIRE(first_bdd.node_number() == second_bdd.node_number());
+    }
+  }
+
+  GIVEN("A bdd only referenced by the cache")
+  {
+    mini_bdd_mgrt mgr;
+
+    mini_bddt x_bdd = mgr.Var("x");
+    mini_bddt y_bdd = mgr.Var("y");
+    (void)(x_bdd & y_bdd);
+
+    REQUIRE(mgr.number_of_nodes() == 5);
+
+    THEN("It is collected once the cache is cleared")
+    {
+      mgr.clear_cache();
+      REQUIRE(mgr.number_of_nodes() == 4);
+      REQUIRE(mgr.statistics().collected_nodes == 1);
+      REQUIRE(mgr.statistics().peak_nodes == 5);
+    }
+  }
+
   GIVEN("A bdd for (a&b)|!a")
   {
     symbol_exprt a("a", bool_typet());
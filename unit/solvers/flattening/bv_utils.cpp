@@ -0,0 +1,71 @@
+/*******************************************************************\
+
+Module: Unit tests for bv_utilst
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for bv_utilst
+
+#include <testing-utils/benchmark.h>
+#include <testing-utils/use_catch.h>
+
+#include <solvers/flattening/bv_utils.h>
+#include <solvers/sat/dimacs_cnf.h>
+#include <util/cout_message.h>
+
+/// \return the value of \p bv if all its literals are constant
+static optionalt<mp_integer> constant_value(const bvt &bv)
+{
+  mp_integer value = 0;
+  for(std::size_t i = bv.size(); i != 0; --i)
+  {
+    if(!bv[i - 1].is_constant())
+      return {};
+    value = value * 2 + (bv[i - 1].is_true() ? 1 : 0);
+  }
+  return value;
+}
+
+TEST_CASE("bv_utilst folds constants", "[core][solvers][flattening][bv_utils]")
+{
+  console_message_handlert message_handler;
+  dimacs_cnft cnf(message_handler);
+  bv_utilst bv_utils(cnf);
+
+  const bvt a = bv_utilst::build_constant(1234, 32);
+  const bvt b = bv_utilst::build_constant(5678, 32);
+
+  REQUIRE(constant_value(bv_utils.add(a, b)) == mp_integer(6912));
+  REQUIRE(
+    constant_value(bv_utils.multiplier(
+      a, b, bv_utilst::representationt::UNSIGNED)) == mp_integer(7006652));
+  REQUIRE(cnf.no_clauses() == 0);
+}
+
+TEST_CASE("bv_utilst encoding benchmark", "[.][benchmark][bv_utils]")
+{
+  console_message_handlert message_handler;
+  const std::size_t width = 64;
+
+  run_benchmark("bv_utilst::add", 20, [&] {
+    dimacs_cnft cnf(message_handler);
+    bv_utilst bv_utils(cnf);
+    bvt sum = cnf.new_variables(width);
+    for(std::size_t i = 0; i < 100; ++i)
+      sum = bv_utils.add(sum, cnf.new_variables(width));
+    REQUIRE(cnf.no_clauses() != 0);
+  });
+
+  run_benchmark("bv_utilst::multiplier", 20, [&] {
+    dimacs_cnft cnf(message_handler);
+    bv_utilst bv_utils(cnf);
+    const bvt product = bv_utils.multiplier(
+      cnf.new_variables(width),
+      cnf.new_variables(width),
+      bv_utilst::representationt::SIGNED);
+    REQUIRE(product.size() == width);
+  });
+}
@@ -435,3 +435,54 @@ SCENARIO("byte_update_lowering", "[core][solvers][lowering][byte_update]")
     }
   }
 }
+
+SCENARIO(
+  "byte_operator_lowering_cache",
+  "[core][solvers][lowering][byte_update]")
+{
+  cmdlinet cmdline;
+  config.set(cmdline);
+
+  const symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  GIVEN("Two byte_extracts from the same byte_update")
+  {
+    const unsignedbv_typet u32(32);
+    const byte_update_exprt bu(
+      ID_byte_update_little_endian,
+      symbol_exprt("x", u32),
+      from_integer(1, index_type()),
+      from_integer(0x42, unsignedbv_typet(8)));
+    const byte_extract_exprt be1(
+      ID_byte_extract_little_endian,
+      bu,
+      from_integer(0, index_type()),
+      unsignedbv_typet(16));
+    const byte_extract_exprt be2(
+      ID_byte_extract_little_endian,
+      bu,
+      from_integer(2, index_type()),
+      unsignedbv_typet(16));
+    const plus_exprt sum(
+      typecast_exprt(be1, u32), typecast_exprt(be2, u32));
+
+    THEN("The byte_update is lowered once and the result is unchanged")
+    {
+      byte_operator_lowering_cachet cache;
+      const exprt lower_sum = lower_byte_operators(sum, ns, cache);
+
+      REQUIRE(lower_sum == lower_byte_operators(sum, ns));
+      REQUIRE(!has_subexpr(lower_sum, ID_byte_extract_little_endian));
+      REQUIRE(!has_subexpr(lower_sum, ID_byte_update_little_endian));
+
+      const auto lower_bu = cache.find(bu);
+      REQUIRE(lower_bu != cache.end());
+      REQUIRE(lower_bu->second == lower_byte_operators(bu, ns));
+
+      const std::size_t cache_size = cache.size();
+      REQUIRE(lower_byte_operators(be1, ns, cache) == cache.at(be1));
+      REQUIRE(cache.size() == cache_size);
+    }
+  }
+}
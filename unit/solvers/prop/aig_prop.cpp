@@ -0,0 +1,102 @@
+/*******************************************************************\
+
+Module: Unit tests for aig_prop_solvert
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for aig_prop_solvert
+
+#include <testing-utils/use_catch.h>
+
+#include <solvers/prop/aig_prop.h>
+#include <solvers/sat/dimacs_cnf.h>
+#include <util/cout_message.h>
+#include <util/make_unique.h>
+
+SCENARIO("aigt rewriting", "[core][solvers][prop][aig_prop]")
+{
+  aigt aig;
+  const literalt a = aig.new_input();
+  const literalt b = aig.new_input();
+  const literalt a_and_b = aig.new_and(a, b);
+
+  THEN("conjunctions are hashed structurally")
+  {
+    REQUIRE(aig.new_and(b, a) == a_and_b);
+    REQUIRE(aig.number_of_nodes() == 3);
+  }
+
+  THEN("conjunctions are rewritten")
+  {
+    REQUIRE(aig.new_and(a_and_b, a) == a_and_b);
+    REQUIRE(aig.new_and(a_and_b, !b).is_false());
+    REQUIRE(aig.new_and(!a_and_b, !a) == !a);
+    REQUIRE(aig.new_and(!a_and_b, a) == aig.new_and(a, !b));
+    REQUIRE(aig.new_and(!a_and_b, !aig.new_and(a, !b)) == !a);
+    REQUIRE(aig.number_of_rewrites() == 5);
+  }
+}
+
+SCENARIO("aig_prop_solvert conversion", "[core][solvers][prop][aig_prop]")
+{
+  console_message_handlert message_handler;
+  message_handler.set_verbosity(0);
+
+  auto cnf_ptr = util_make_unique<dimacs_cnft>(message_handler);
+  dimacs_cnft &cnf = *cnf_ptr;
+  aig_prop_solvert aig_prop(std::move(cnf_ptr), message_handler);
+
+  const bvt inputs = aig_prop.new_variables(4);
+
+  GIVEN("A conjunction as constraint")
+  {
+    aig_prop.l_set_to_true(aig_prop.land(inputs));
+    aig_prop.prop_solve();
+
+    THEN("each operand becomes a unit clause")
+    {
+      REQUIRE(cnf.no_clauses() == 4);
+      REQUIRE(cnf.no_variables() == 1 + 4);
+    }
+  }
+
+  GIVEN("A negated conjunction as constraint")
+  {
+    aig_prop.l_set_to_false(aig_prop.land(inputs));
+    aig_prop.prop_solve();
+
+    THEN("it becomes a single clause")
+    {
+      REQUIRE(cnf.no_clauses() == 1);
+      REQUIRE(cnf.no_variables() == 1 + 4);
+    }
+  }
+
+  GIVEN("A conjunction without further fanout")
+  {
+    const literalt l = aig_prop.land(inputs);
+    aig_prop.l_set_to_true(aig_prop.lor(l, inputs[0]));
+    aig_prop.prop_solve();
+
+    THEN("it is converted as a single gate")
+    {
+      // a clause and a gate with four operands
+      REQUIRE(cnf.no_clauses() == 1 + 4 + 1);
+      REQUIRE(cnf.no_variables() == 1 + 4 + 1);
+    }
+  }
+
+  GIVEN("Unconstrained gates")
+  {
+    aig_prop.land(inputs[0], inputs[1]);
+    aig_prop.prop_solve();
+
+    THEN("they are not converted")
+    {
+      REQUIRE(cnf.no_clauses() == 0);
+    }
+  }
+}
@@ -0,0 +1,61 @@
+/*******************************************************************\
+
+Module: Unit tests for cnft
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for cnft
+
+#include <testing-utils/use_catch.h>
+
+#include <solvers/prop/literal.h>
+#include <solvers/sat/dimacs_cnf.h>
+#include <util/cout_message.h>
+
+SCENARIO("cnft structural hashing", "[core][solvers][sat][cnf]")
+{
+  console_message_handlert message_handler;
+  message_handler.set_verbosity(0);
+
+  GIVEN("A CNF with structural hashing")
+  {
+    dimacs_cnft cnf(message_handler);
+    cnf.enable_structural_hashing();
+    const literalt a = cnf.new_variable();
+    const literalt b = cnf.new_variable();
+    const literalt c = cnf.new_variable();
+
+    THEN("equivalent gates are built once")
+    {
+      const literalt a_and_b = cnf.land(a, b);
+      const std::size_t clauses = cnf.no_clauses();
+      const std::size_t variables = cnf.no_variables();
+
+      REQUIRE(cnf.land(b, a) == a_and_b);
+      REQUIRE(cnf.lor(!a, !b) == !a_and_b);
+      REQUIRE(cnf.land(bvt{a, b, c}) == cnf.land(bvt{c, b, a}));
+      REQUIRE(cnf.lor(bvt{!a, !b, !c}) == !cnf.land(bvt{a, b, c}));
+      REQUIRE(cnf.lxor(!a, b) == !cnf.lxor(a, b));
+      REQUIRE(cnf.lselect(!a, b, c) == cnf.lselect(a, c, b));
+      REQUIRE(cnf.no_clauses() == clauses + 4 + 4 + 4);
+      REQUIRE(cnf.no_variables() == variables + 3);
+      REQUIRE(cnf.get_number_of_shared_gates() == 7);
+    }
+  }
+
+  GIVEN("A CNF without structural hashing")
+  {
+    dimacs_cnft cnf(message_handler);
+    const literalt a = cnf.new_variable();
+    const literalt b = cnf.new_variable();
+
+    THEN("each gate is built again")
+    {
+      REQUIRE(cnf.land(a, b) != cnf.land(b, a));
+      REQUIRE(cnf.get_number_of_shared_gates() == 0);
+    }
+  }
+}
@@ -0,0 +1,131 @@
+/*******************************************************************\
+
+Module: Unit tests for cnf_simplifiert
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for cnf_simplifiert
+
+#include <testing-utils/use_catch.h>
+
+#include <solvers/sat/cnf_simplifier.h>
+
+#include <random>
+
+static bool
+satisfies(const cnf_clause_listt::clausest &clauses, const std::vector<tvt> &a)
+{
+  for(const auto &clause : clauses)
+  {
+    bool satisfied = false;
+    for(const auto &l : clause)
+    {
+      if((l.sign() ? !a[l.var_no()] : a[l.var_no()]).is_true())
+        satisfied = true;
+    }
+    if(!satisfied)
+      return false;
+  }
+  return true;
+}
+
+/// \return a satisfying assignment of \p clauses over \p no_variables
+///   variables that agrees with \p partial where known, or an empty vector
+static std::vector<tvt> brute_force(
+  const cnf_clause_listt::clausest &clauses,
+  std::size_t no_variables,
+  const std::vector<tvt> &partial)
+{
+  for(unsigned bits = 0; bits < (1u << (no_variables - 1)); ++bits)
+  {
+    std::vector<tvt> assignment(no_variables);
+    for(std::size_t v = 1; v < no_variables; ++v)
+    {
+      assignment[v] = v < partial.size() && partial[v].is_known()
+                        ? partial[v]
+                        : tvt((bits & (1u << (v - 1))) != 0);
+    }
+    if(satisfies(clauses, assignment))
+      return assignment;
+  }
+  return {};
+}
+
+SCENARIO("cnf_simplifiert", "[core][solvers][sat][cnf_simplifier]")
+{
+  GIVEN("Clauses with units, subsumed clauses and eliminable variables")
+  {
+    const literalt a(1, false), b(2, false), c(3, false), d(4, false);
+    cnf_clause_listt::clausest clauses{
+      {a}, {!a, b, c}, {b, c}, {b, c, d}, {!c, d}, {!b, !d}};
+
+    cnf_simplifiert simplifier(5, {false, false, false, false, true});
+    const auto simplified = simplifier.simplify(clauses);
+
+    THEN("the clauses get simplified")
+    {
+      REQUIRE(simplifier.number_of_fixed_variables == 1);
+      REQUIRE(simplifier.number_of_subsumed_clauses >= 1);
+      REQUIRE(simplifier.number_of_eliminated_variables >= 1);
+      REQUIRE(simplified.size() < clauses.size());
+      REQUIRE_FALSE(simplifier.is_removed(4));
+    }
+  }
+
+  GIVEN("Random clauses")
+  {
+    std::mt19937 generator(0);
+    const std::size_t no_variables = 9;
+
+    for(int round = 0; round < 300; ++round)
+    {
+      cnf_clause_listt::clausest clauses;
+      const std::size_t no_clauses = 5 + generator() % 30;
+      for(std::size_t i = 0; i < no_clauses; ++i)
+      {
+        bvt clause;
+        const std::size_t size = 1 + generator() % 3;
+        for(std::size_t j = 0; j < size; ++j)
+        {
+          clause.push_back(literalt(
+            1 + generator() % (no_variables - 1), generator() % 2 != 0));
+        }
+        std::sort(clause.begin(), clause.end());
+        clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+        bool tautology = false;
+        for(std::size_t j = 1; j < clause.size(); ++j)
+          tautology |= clause[j - 1] == !clause[j];
+        if(!tautology)
+          clauses.push_back(clause);
+      }
+
+      std::vector<bool> frozen(no_variables, false);
+      frozen[1] = true;
+      cnf_simplifiert simplifier(no_variables, frozen);
+      const auto simplified = simplifier.simplify(clauses);
+
+      const auto model = brute_force(clauses, no_variables, {});
+      auto simplified_model = brute_force(simplified, no_variables, {});
+      REQUIRE(model.empty() == simplified_model.empty());
+
+      if(!simplified_model.empty())
+      {
+        simplifier.reconstruct(simplified_model);
+        REQUIRE(satisfies(clauses, simplified_model));
+
+        // frozen variables keep their meaning
+        for(bool value : {false, true})
+        {
+          std::vector<tvt> partial(no_variables);
+          partial[1] = tvt(value);
+          REQUIRE(
+            brute_force(clauses, no_variables, partial).empty() ==
+            brute_force(simplified, no_variables, partial).empty());
+        }
+      }
+    }
+  }
+}
@@ -81,6 +81,49 @@ SCENARIO("satcheck_cadical", "[core][solvers][sat][satcheck_cadical]")
       REQUIRE(satcheck.prop_solve() == propt::resultt::P_SATISFIABLE);
     }
   }
+
+  GIVEN("A formula a || b with assumptions contradicting it")
+  {
+    satcheck_cadicalt satcheck(message_handler);
+    literalt a = satcheck.new_variable();
+    literalt b = satcheck.new_variable();
+    literalt c = satcheck.new_variable();
+    satcheck.lcnf({a, b});
+
+    bvt assumptions;
+    assumptions.push_back(!a);
+    assumptions.push_back(!b);
+    assumptions.push_back(c);
+    satcheck.set_assumptions(assumptions);
+
+    THEN("the conflict consists of the assumptions on a and b")
+    {
+      REQUIRE(satcheck.prop_solve() == propt::resultt::P_UNSATISFIABLE);
+      REQUIRE(satcheck.is_in_conflict(a));
+      REQUIRE(satcheck.is_in_conflict(!b));
+      REQUIRE_FALSE(satcheck.is_in_conflict(c));
+    }
+  }
+
+  GIVEN("A frozen variable defined by a gate")
+  {
+    satcheck_cadicalt satcheck(message_handler);
+    literalt a = satcheck.new_variable();
+    literalt b = satcheck.new_variable();
+    literalt a_and_b = satcheck.land(a, b);
+    satcheck.set_frozen(a_and_b);
+
+    THEN("it can be used in clauses of later calls")
+    {
+      REQUIRE(satcheck.prop_solve() == propt::resultt::P_SATISFIABLE);
+      satcheck.l_set_to_true(a_and_b);
+      REQUIRE(satcheck.prop_solve() == propt::resultt::P_SATISFIABLE);
+      REQUIRE(satcheck.l_get(a).is_true());
+      REQUIRE(satcheck.l_get(b).is_true());
+      satcheck.l_set_to_true(!a);
+      REQUIRE(satcheck.prop_solve() == propt::resultt::P_UNSATISFIABLE);
+    }
+  }
 }
 
 #endif
@@ -82,6 +82,66 @@ SCENARIO("satcheck_minisat2", "[core][solvers][sat][satcheck_minisat2]")
       REQUIRE(satcheck.prop_solve() == propt::resultt::P_SATISFIABLE);
     }
   }
+
+  GIVEN("A formula (a || b) && (!a || c) solved by a portfolio")
+  {
+    satcheck_minisat_portfoliot satcheck(message_handler, 4);
+    literalt a = satcheck.new_variable();
+    literalt b = satcheck.new_variable();
+    literalt c = satcheck.new_variable();
+    satcheck.lcnf({a, b});
+    satcheck.lcnf({!a, c});
+
+    THEN("the model of the first instance to finish satisfies it")
+    {
+      REQUIRE(satcheck.prop_solve() == propt::resultt::P_SATISFIABLE);
+      REQUIRE((satcheck.l_get(a).is_true() || satcheck.l_get(b).is_true()));
+      REQUIRE((satcheck.l_get(a).is_false() || satcheck.l_get(c).is_true()));
+    }
+    THEN("is unsatisfiable under assumptions !b and !c, which conflict")
+    {
+      bvt assumptions;
+      assumptions.push_back(!b);
+      assumptions.push_back(!c);
+      satcheck.set_assumptions(assumptions);
+      REQUIRE(satcheck.prop_solve() == propt::resultt::P_UNSATISFIABLE);
+      REQUIRE(satcheck.is_in_conflict(b));
+
+      AND_THEN("becomes satisfiable when the assumptions are lifted")
+      {
+        satcheck.set_assumptions(bvt{});
+        REQUIRE(satcheck.prop_solve() == propt::resultt::P_SATISFIABLE);
+      }
+    }
+  }
+  GIVEN("A formula (a || b) && (!a || c) && (!b || !c) split into cubes")
+  {
+    satcheck_minisat_portfoliot satcheck(message_handler, 2, 2);
+    literalt a = satcheck.new_variable();
+    literalt b = satcheck.new_variable();
+    literalt c = satcheck.new_variable();
+    satcheck.lcnf({a, b});
+    satcheck.lcnf({!a, c});
+    satcheck.lcnf({!b, !c});
+    satcheck.set_split_candidates({a, b, c});
+
+    THEN("a cube has a model that satisfies it")
+    {
+      REQUIRE(satcheck.prop_solve() == propt::resultt::P_SATISFIABLE);
+      REQUIRE((satcheck.l_get(a).is_true() || satcheck.l_get(b).is_true()));
+      REQUIRE((satcheck.l_get(a).is_false() || satcheck.l_get(c).is_true()));
+      REQUIRE((satcheck.l_get(b).is_false() || satcheck.l_get(c).is_false()));
+    }
+    THEN("all cubes are unsatisfiable under assumption !a, which conflicts")
+    {
+      bvt assumptions;
+      assumptions.push_back(!a);
+      satcheck.lcnf({!b});
+      satcheck.set_assumptions(assumptions);
+      REQUIRE(satcheck.prop_solve() == propt::resultt::P_UNSATISFIABLE);
+      REQUIRE(satcheck.is_in_conflict(a));
+    }
+  }
 }
 
 #endif
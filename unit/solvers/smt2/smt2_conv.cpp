@@ -2,6 +2,11 @@
 
 #include <testing-utils/use_catch.h>
 
+#include <util/bitvector_types.h>
+#include <util/mathematical_expr.h>
+#include <util/namespace.h>
+#include <util/symbol_table.h>
+
 #include <solvers/smt2/smt2_conv.h>
 
 TEST_CASE(
@@ -16,3 +21,45 @@ TEST_CASE(
   CHECK(smt2_convt::convert_identifier("|") == "&124;");
   CHECK(smt2_convt::convert_identifier("&") == "&38;");
 }
+
+static std::size_t
+count_occurrences(const std::string &text, const std::string &pattern)
+{
+  std::size_t count = 0;
+  for(auto position = text.find(pattern); position != std::string::npos;
+      position = text.find(pattern, position + 1))
+  {
+    ++count;
+  }
+  return count;
+}
+
+TEST_CASE(
+  "smt2_convt defines terms that occur repeatedly once",
+  "[core][solvers][smt2]")
+{
+  symbol_tablet symbol_table;
+  const namespacet ns{symbol_table};
+  std::stringstream out;
+  smt2_convt smt2{ns, "", "", "", smt2_convt::solvert::GENERIC, out};
+  smt2.use_shared_terms = true;
+
+  const unsignedbv_typet type{32};
+  const symbol_exprt x{"x", type}, y{"y", type};
+  const plus_exprt sum{x, y};
+
+  smt2.set_to_true(binary_relation_exprt{sum, ID_gt, x});
+  smt2.set_to_true(binary_relation_exprt{sum, ID_gt, y});
+  smt2.set_to_true(
+    forall_exprt{symbol_exprt{"z", type}, equal_exprt{sum, sum}});
+
+  const std::string text = out.str();
+  CHECK(
+    count_occurrences(
+      text, "(define-fun |share.0| () (_ BitVec 32) (bvadd |x| |y|))") == 1);
+  CHECK(count_occurrences(text, "(bvugt |share.0| |y|)") == 1);
+  CHECK(count_occurrences(text, "|share.1|") == 0);
+
+  // no reference to a definition within a binder
+  CHECK(count_occurrences(text, "(= (bvadd |x| |y|) (bvadd |x| |y|))") == 1);
+}
@@ -0,0 +1,98 @@
+/*******************************************************************\
+
+Module: SMT2 tokenizer unit tests
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/magic.h>
+
+#include <solvers/smt2/smt2_tokenizer.h>
+
+#include <sstream>
+
+TEST_CASE("smt2_tokenizert splits input into tokens", "[core][solvers][smt2]")
+{
+  std::istringstream in(
+    "; comment\n"
+    "(define-fun |quoted\nsymbol| () (_ BitVec 8) #b0101)\n"
+    ":keyword \"say \"\"hi\"\"\" 12.5 #xfF");
+  smt2_tokenizert tokenizer(in);
+
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::OPEN);
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::SYMBOL);
+  REQUIRE(tokenizer.get_buffer() == "define-fun");
+  REQUIRE_FALSE(tokenizer.token_is_quoted_symbol());
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::SYMBOL);
+  REQUIRE(tokenizer.get_buffer() == "quoted\nsymbol");
+  REQUIRE(tokenizer.token_is_quoted_symbol());
+  REQUIRE(tokenizer.error().get_line_no() == 3);
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::OPEN);
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::CLOSE);
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::OPEN);
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::SYMBOL);
+  REQUIRE(tokenizer.get_buffer() == "_");
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::SYMBOL);
+  REQUIRE(tokenizer.get_buffer() == "BitVec");
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::NUMERAL);
+  REQUIRE(tokenizer.get_buffer() == "8");
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::CLOSE);
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::NUMERAL);
+  REQUIRE(tokenizer.get_buffer() == "#b0101");
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::CLOSE);
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::KEYWORD);
+  REQUIRE(tokenizer.get_buffer() == "keyword");
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::STRING_LITERAL);
+  REQUIRE(tokenizer.get_buffer() == "say \"hi\"");
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::NUMERAL);
+  REQUIRE(tokenizer.get_buffer() == "12.5");
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::NUMERAL);
+  REQUIRE(tokenizer.get_buffer() == "#xfF");
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::END_OF_FILE);
+}
+
+TEST_CASE(
+  "smt2_tokenizert reads tokens longer than its buffer",
+  "[core][solvers][smt2]")
+{
+  const std::string symbol(SMT2_TOKENIZER_BUFFER_SIZE * 2 + 1, 'a');
+  const std::string quoted(SMT2_TOKENIZER_BUFFER_SIZE + 1, ' ');
+  std::istringstream in(symbol + " |" + quoted + "| " + symbol);
+  smt2_tokenizert tokenizer(in);
+
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::SYMBOL);
+  REQUIRE(tokenizer.get_buffer() == symbol);
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::SYMBOL);
+  REQUIRE(tokenizer.get_buffer() == quoted);
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::SYMBOL);
+  REQUIRE(tokenizer.get_buffer() == symbol);
+  REQUIRE(tokenizer.next_token() == smt2_tokenizert::END_OF_FILE);
+}
+
+TEST_CASE(
+  "smt2_tokenizert leaves the input after its tokens in the stream",
+  "[core][solvers][smt2]")
+{
+  std::istringstream in("(sat) unsat rest");
+
+  {
+    smt2_tokenizert tokenizer(in);
+    REQUIRE(tokenizer.next_token() == smt2_tokenizert::OPEN);
+    REQUIRE(tokenizer.next_token() == smt2_tokenizert::SYMBOL);
+    REQUIRE(tokenizer.get_buffer() == "sat");
+  }
+
+  {
+    smt2_tokenizert tokenizer(in);
+    REQUIRE(tokenizer.next_token() == smt2_tokenizert::CLOSE);
+    REQUIRE(tokenizer.next_token() == smt2_tokenizert::SYMBOL);
+    REQUIRE(tokenizer.get_buffer() == "unsat");
+  }
+
+  std::string rest;
+  std::getline(in, rest);
+  REQUIRE(rest == " rest");
+}
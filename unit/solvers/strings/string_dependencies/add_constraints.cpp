@@ -0,0 +1,133 @@
+/*******************************************************************\
+
+Module: Unit tests for the constraints added by string_dependenciest
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/mathematical_types.h>
+#include <util/std_types.h>
+#include <util/symbol_table.h>
+
+#include <solvers/strings/string_constraint_generator.h>
+#include <solvers/strings/string_dependencies.h>
+
+#include <algorithm>
+
+SCENARIO(
+  "string_dependenciest evaluates constant builtin functions",
+  "[core][solvers][strings][string_dependencies]")
+{
+  const signedbv_typet int_type{32};
+  const unsignedbv_typet char_type{16};
+  const refined_string_typet string_type{int_type, pointer_type(char_type)};
+
+  symbol_tablet symbol_table;
+  const namespacet ns{symbol_table};
+  string_constraint_generatort generator{ns};
+  string_dependenciest dependencies;
+
+  const auto make_string = [&](const std::string &name) {
+    return refined_string_exprt{
+      symbol_exprt{name + "_length", int_type},
+      symbol_exprt{name + "_pointer", pointer_type(char_type)},
+      string_type};
+  };
+
+  std::size_t number_of_calls = 0;
+  const auto call = [&](
+                      const irep_idt &function,
+                      const std::vector<exprt> &arguments,
+                      const typet &codomain) {
+    mathematical_function_typet::domaint domain;
+    for(const auto &argument : arguments)
+      domain.push_back(argument.type());
+    const symbol_exprt return_code{
+      "return_code" + std::to_string(number_of_calls++), codomain};
+    add_node(
+      dependencies,
+      equal_exprt{
+        return_code,
+        function_application_exprt{
+          symbol_exprt{function, mathematical_function_typet{domain, codomain}},
+          arguments}},
+      generator.array_pool,
+      generator.fresh_symbol);
+  };
+
+  const auto literal = [&](const std::string &name, const std::string &value) {
+    const refined_string_exprt s = make_string(name);
+    call(
+      ID_cprover_string_literal_func,
+      {s.length(), s.content(), constant_exprt{value, string_typet{}}},
+      int_type);
+    return s;
+  };
+
+  const refined_string_exprt result = make_string("result");
+  const array_string_exprt result_array =
+    generator.array_pool.find(result.content(), result.length());
+
+  GIVEN("The concatenation of two literals, which a test depends on")
+  {
+    const refined_string_exprt s1 = literal("s1", "ab");
+    const refined_string_exprt s2 = literal("s2", "c");
+    call(
+      ID_cprover_string_concat_func,
+      {result.length(), result.content(), s1, s2},
+      int_type);
+    call(
+      ID_cprover_string_char_at_func,
+      {result, from_integer(0, int_type)},
+      char_type);
+
+    const string_constraintst constraints =
+      dependencies.add_constraints(generator);
+
+    THEN("The characters of the result are constrained without quantifiers")
+    {
+      REQUIRE(constraints.universal.empty());
+      REQUIRE(constraints.not_contains.empty());
+
+      const std::string expected = "abc";
+      for(std::size_t i = 0; i < expected.size(); ++i)
+      {
+        const equal_exprt lemma{
+          result_array[from_integer(i, int_type)],
+          from_integer(expected[i], char_type)};
+        REQUIRE(
+          std::find(
+            constraints.existential.begin(),
+            constraints.existential.end(),
+            lemma) != constraints.existential.end());
+      }
+    }
+  }
+
+  GIVEN("The concatenation of a literal and a string of unknown content")
+  {
+    const refined_string_exprt s1 = literal("s1", "ab");
+    const refined_string_exprt s2 = make_string("s2");
+    call(
+      ID_cprover_string_concat_func,
+      {result.length(), result.content(), s1, s2},
+      int_type);
+    call(
+      ID_cprover_string_char_at_func,
+      {result, from_integer(0, int_type)},
+      char_type);
+
+    const string_constraintst constraints =
+      dependencies.add_constraints(generator);
+
+    THEN("The concatenation is constrained by quantified formulas")
+    {
+      REQUIRE_FALSE(constraints.universal.empty());
+    }
+  }
+}
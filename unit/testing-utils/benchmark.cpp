@@ -0,0 +1,61 @@
+/*******************************************************************\
+
+Module: Unit test utilities
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Micro-benchmarks within the unit tests
+
+#include "benchmark.h"
+
+#include <util/json.h>
+
+#include <testing-utils/use_catch.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+double run_benchmark(
+  const std::string &name,
+  std::size_t repetitions,
+  const std::function<void()> &body)
+{
+  PRECONDITION(repetitions > 0);
+
+  body();
+
+  std::vector<double> seconds;
+  seconds.reserve(repetitions);
+  for(std::size_t i = 0; i < repetitions; ++i)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    const auto end = std::chrono::steady_clock::now();
+    seconds.push_back(std::chrono::duration<double>(end - start).count());
+  }
+
+  std::sort(seconds.begin(), seconds.end());
+  const double min = seconds.front();
+  const double median = seconds[seconds.size() / 2];
+
+  WARN(name << ": median " << median << "s, min " << min << "s");
+
+  const char *output_file = std::getenv("CBMC_BENCHMARK_OUTPUT");
+  if(output_file != nullptr)
+  {
+    std::ofstream out(output_file, std::ios::app);
+    out << "{\"benchmark\": ";
+    json_stringt{name}.output(out);
+    out << ", \"repetitions\": " << repetitions
+        << ", \"minSeconds\": " << min << ", \"medianSeconds\": " << median
+        << "}\n";
+  }
+
+  return median;
+}
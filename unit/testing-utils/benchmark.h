@@ -0,0 +1,31 @@
+/*******************************************************************\
+
+Module: Unit test utilities
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Micro-benchmarks within the unit tests
+
+#ifndef CPROVER_TESTING_UTILS_BENCHMARK_H
+#define CPROVER_TESTING_UTILS_BENCHMARK_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+/// Run \p body once to warm up and then \p repetitions times, and report the
+/// fastest and the median of the timed runs: through WARN for the reader,
+/// and as a line of JSON appended to the file named by the environment
+/// variable `CBMC_BENCHMARK_OUTPUT`, if set, for tracking them across
+/// revisions. Benchmarks are hidden test cases tagged `[.][benchmark]`, run
+/// by `make benchmarks` in `unit` or the `benchmarks` target of CMake.
+/// \return the median time in seconds
+double run_benchmark(
+  const std::string &name,
+  std::size_t repetitions,
+  const std::function<void()> &body);
+
+#endif // CPROVER_TESTING_UTILS_BENCHMARK_H
@@ -0,0 +1,67 @@
+/*******************************************************************\
+
+Module: Unit tests for arith_tools
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/mp_arith.h>
+
+TEST_CASE("bit-vector representation", "[core][util][arith_tools]")
+{
+  SECTION("values fitting into a machine word")
+  {
+    REQUIRE(integer2bvrep(0, 8) == "0");
+    REQUIRE(integer2bvrep(255, 8) == "FF");
+    REQUIRE(integer2bvrep(256, 8) == "0");
+    REQUIRE(integer2bvrep(-1, 8) == "FF");
+    REQUIRE(integer2bvrep(-128, 8) == "80");
+    REQUIRE(integer2bvrep(-1, 64) == "FFFFFFFFFFFFFFFF");
+    REQUIRE(integer2bvrep(-1, 65) == "1FFFFFFFFFFFFFFFF");
+    REQUIRE(integer2bvrep(0xABC, 100) == "ABC");
+
+    REQUIRE(bvrep2integer("FF", 8, false) == 255);
+    REQUIRE(bvrep2integer("FF", 8, true) == -1);
+    REQUIRE(bvrep2integer("80", 8, true) == -128);
+    REQUIRE(bvrep2integer("7F", 8, true) == 127);
+    REQUIRE(bvrep2integer("0", 1, true) == 0);
+    REQUIRE(bvrep2integer("1", 1, true) == -1);
+    REQUIRE(
+      bvrep2integer("8000000000000000", 64, true) ==
+      string2integer("-9223372036854775808"));
+    REQUIRE(
+      bvrep2integer("FFFFFFFFFFFFFFFF", 64, false) ==
+      string2integer("18446744073709551615"));
+  }
+
+  SECTION("round trips agree with the arbitrary-precision encoding")
+  {
+    for(std::size_t width : {1, 7, 8, 31, 32, 63, 64, 65, 128})
+    {
+      const mp_integer p = power(2, width);
+      for(const mp_integer &value :
+          {mp_integer(0),
+           mp_integer(1),
+           mp_integer(-1),
+           p / 2 - 1,
+           -(p / 2),
+           p - 1,
+           p + 5})
+      {
+        const irep_idt bvrep = integer2bvrep(value, width);
+        mp_integer expected = value % p;
+        if(expected < 0)
+          expected += p;
+        REQUIRE(bvrep == integer2string(expected, 16));
+        REQUIRE(bvrep2integer(bvrep, width, false) == expected);
+        REQUIRE(
+          bvrep2integer(bvrep, width, true) ==
+          (expected >= p / 2 ? expected - p : expected));
+      }
+    }
+  }
+}
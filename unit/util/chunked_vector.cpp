@@ -0,0 +1,105 @@
+/*******************************************************************\
+
+Module: Unit tests for chunked_vectort
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/chunked_vector.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST_CASE(
+  "chunked_vectort keeps references stable",
+  "[core][util][chunked_vector]")
+{
+  chunked_vectort<std::string, 4> v;
+  REQUIRE(v.empty());
+
+  v.push_back("a");
+  const std::string &first = v.front();
+  const auto begin = v.begin();
+  const auto end = v.end();
+
+  for(std::size_t i = 1; i < 100; ++i)
+    v.emplace_back(std::to_string(i));
+
+  REQUIRE(v.size() == 100);
+  REQUIRE(&first == &v[0]);
+  REQUIRE(&*begin == &first);
+  // the end iterator now refers to the first element appended
+  REQUIRE(*end == "1");
+  REQUIRE(v.back() == "99");
+
+  SECTION("Moving keeps references, copying does not")
+  {
+    chunked_vectort<std::string, 4> moved(std::move(v));
+    REQUIRE(v.empty());
+    REQUIRE(&moved.front() == &first);
+
+    const chunked_vectort<std::string, 4> copy(moved);
+    REQUIRE(copy.size() == 100);
+    REQUIRE(&copy.front() != &first);
+    REQUIRE(std::equal(copy.begin(), copy.end(), moved.begin()));
+  }
+
+  SECTION("Removing elements")
+  {
+    v.pop_back();
+    REQUIRE(v.back() == "98");
+    v.clear();
+    REQUIRE(v.empty());
+    REQUIRE(v.begin() == v.end());
+  }
+}
+
+TEST_CASE("chunked_vectort iterators", "[core][util][chunked_vector]")
+{
+  chunked_vectort<int, 2> v;
+  const std::vector<int> values = {3, 1, 4, 1, 5, 9, 2, 6};
+  v.append(values.begin(), values.end());
+
+  REQUIRE(std::vector<int>(v.begin(), v.end()) == values);
+  REQUIRE(v.end() - v.begin() == 8);
+  REQUIRE(v.begin()[5] == 9);
+  REQUIRE(*(v.end() - 1) == 6);
+
+  const std::vector<int> reversed(values.rbegin(), values.rend());
+  REQUIRE(std::vector<int>(v.rbegin(), v.rend()) == reversed);
+
+  chunked_vectort<int, 2>::const_iterator c = v.begin();
+  REQUIRE(c == v.begin());
+  REQUIRE(c < v.end());
+  *v.begin() = 0;
+  REQUIRE(*c == 0);
+
+  std::sort(v.begin(), v.end());
+  REQUIRE(std::is_sorted(v.begin(), v.end()));
+}
+
+TEST_CASE(
+  "chunked_vectort destroys its elements",
+  "[core][util][chunked_vector]")
+{
+  const auto counter = std::make_shared<int>(0);
+
+  {
+    chunked_vectort<std::shared_ptr<int>, 8> v;
+    for(int i = 0; i < 20; ++i)
+      v.push_back(counter);
+    REQUIRE(counter.use_count() == 21);
+
+    chunked_vectort<std::shared_ptr<int>, 8> other;
+    other.push_back(counter);
+    other = v;
+    REQUIRE(counter.use_count() == 41);
+  }
+
+  REQUIRE(counter.use_count() == 1);
+}
@@ -0,0 +1,120 @@
+/*******************************************************************\
+
+Module: Unit test for csr_graph.h
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/csr_graph.h>
+
+#include <algorithm>
+#include <random>
+
+typedef grapht<graph_nodet<empty_edget>> simple_grapht;
+
+static simple_grapht random_graph(std::size_t nodes, std::mt19937 &random)
+{
+  simple_grapht graph;
+  graph.resize(nodes);
+  std::uniform_int_distribution<std::size_t> node(0, nodes - 1);
+  for(std::size_t i = 0; i < nodes * 2; ++i)
+    graph.add_edge(node(random), node(random));
+  return graph;
+}
+
+SCENARIO("csr-graph-basic", "[core][util][csr_graph]")
+{
+  GIVEN("A graph with a cycle and a tail")
+  {
+    // 0 -> 1 -> 2 -> 0, 2 -> 3, 4 -> 3
+    const csr_grapht graph{5, {{0, 1}, {1, 2}, {2, 0}, {2, 3}, {4, 3}}};
+
+    REQUIRE(graph.size() == 5);
+    REQUIRE(graph.number_of_edges() == 5);
+    REQUIRE(graph.successors(2).begin()[0] == 0);
+    REQUIRE(graph.successors(2).begin()[1] == 3);
+    REQUIRE(graph.predecessors(3).begin()[0] == 2);
+    REQUIRE(graph.predecessors(3).begin()[1] == 4);
+
+    THEN("The cycle is one SCC, closer to the root than the tail")
+    {
+      std::vector<csr_grapht::node_indext> subgraph_nr;
+      REQUIRE(graph.SCCs(subgraph_nr) == 3);
+      REQUIRE(subgraph_nr[0] == subgraph_nr[1]);
+      REQUIRE(subgraph_nr[1] == subgraph_nr[2]);
+      REQUIRE(subgraph_nr[3] < subgraph_nr[0]);
+      REQUIRE(graph.topsort().empty());
+    }
+
+    THEN("Reachability follows the edges in either direction")
+    {
+      auto forwards = graph.get_reachable({1}, true);
+      std::sort(forwards.begin(), forwards.end());
+      REQUIRE(forwards == std::vector<csr_grapht::node_indext>{0, 1, 2, 3});
+
+      auto backwards = graph.get_reachable({3}, false);
+      std::sort(backwards.begin(), backwards.end());
+      REQUIRE(backwards == std::vector<csr_grapht::node_indext>{0, 1, 2, 3, 4});
+
+      REQUIRE(
+        graph.depth_limited_search({0}, 1) ==
+        std::vector<csr_grapht::node_indext>{0, 1});
+      REQUIRE(
+        graph.distances(0) ==
+        std::vector<std::size_t>{0, 1, 2, 3, csr_grapht::no_node});
+    }
+  }
+
+  GIVEN("A diamond with a loop")
+  {
+    // 0 -> 1, 0 -> 2, 1 -> 3, 2 -> 3, 3 -> 4, 4 -> 3
+    const csr_grapht graph{
+      6, {{0, 1}, {0, 2}, {1, 3}, {2, 3}, {3, 4}, {4, 3}}};
+
+    THEN("The join is dominated by the fork, and the loop by the join")
+    {
+      const auto idom = graph.immediate_dominators(0);
+      REQUIRE(idom[0] == 0);
+      REQUIRE(idom[1] == 0);
+      REQUIRE(idom[2] == 0);
+      REQUIRE(idom[3] == 0);
+      REQUIRE(idom[4] == 3);
+      REQUIRE(idom[5] == csr_grapht::no_node);
+    }
+  }
+}
+
+SCENARIO("csr-graph-agrees-with-grapht", "[core][util][csr_graph]")
+{
+  std::mt19937 random(42);
+
+  for(std::size_t nodes : {1, 2, 10, 100})
+  {
+    const simple_grapht graph = random_graph(nodes, random);
+    const csr_grapht csr = csr_grapht::from_graph(graph);
+
+    std::vector<simple_grapht::node_indext> expected_scc;
+    std::vector<csr_grapht::node_indext> scc;
+    REQUIRE(csr.SCCs(scc) == graph.SCCs(expected_scc));
+    REQUIRE(scc == expected_scc);
+    REQUIRE(csr.topsort().empty() == !graph.is_dag());
+
+    for(bool forwards : {true, false})
+    {
+      auto expected = graph.get_reachable(0, forwards);
+      auto reachable = csr.get_reachable({0}, forwards);
+      std::sort(expected.begin(), expected.end());
+      std::sort(reachable.begin(), reachable.end());
+      REQUIRE(reachable == expected);
+    }
+
+    auto expected_limited = graph.depth_limited_search(0, 2);
+    auto limited = csr.depth_limited_search({0}, 2);
+    std::sort(expected_limited.begin(), expected_limited.end());
+    std::sort(limited.begin(), limited.end());
+    REQUIRE(limited == expected_limited);
+  }
+}
@@ -0,0 +1,42 @@
+/*******************************************************************\
+
+Module: Unit tests for interval_templatet
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/integer_interval.h>
+
+TEST_CASE(
+  "interval_templatet::join reports changes",
+  "[core][util][interval_template]")
+{
+  integer_intervalt interval(0, 10);
+
+  SECTION("Joining a contained interval does not change it")
+  {
+    REQUIRE_FALSE(interval.join(integer_intervalt(2, 5)));
+    REQUIRE(interval == integer_intervalt(0, 10));
+  }
+
+  SECTION("Joining a larger interval widens the bounds")
+  {
+    REQUIRE(interval.join(integer_intervalt(-1, 5)));
+    REQUIRE(interval == integer_intervalt(-1, 10));
+    REQUIRE(interval.join(integer_intervalt(5, 11)));
+    REQUIRE(interval == integer_intervalt(-1, 11));
+  }
+
+  SECTION("Joining an unbounded interval drops the bound")
+  {
+    REQUIRE(interval.join(upper_interval(mp_integer(5))));
+    REQUIRE_FALSE(interval.lower_set);
+    REQUIRE(interval.upper == 10);
+    REQUIRE_FALSE(interval.join(integer_intervalt(-5, 5)));
+    REQUIRE(interval.join(integer_intervalt()));
+    REQUIRE(interval.is_top());
+  }
+}
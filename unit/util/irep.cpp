@@ -30,9 +30,13 @@ SCENARIO("irept_memory", "[core][utils][irept]")
       REQUIRE(sizeof(std::string) == sizeof(void *));
 #endif
 
+#ifdef IREP_USE_SMALL_SUB
+      const std::size_t sub_size = sizeof(irept::subt);
+#else
       const std::size_t sub_size = sizeof(std::vector<int>);
-#ifndef _GLIBCXX_DEBUG
+#  ifndef _GLIBCXX_DEBUG
       REQUIRE(sizeof(std::vector<int>) == 3 * sizeof(void *));
+#  endif
 #endif
 
 #if !NAMED_SUB_IS_FORWARD_LIST
@@ -0,0 +1,57 @@
+/*******************************************************************\
+
+Module: Unit tests for irep_hash_consingt
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/bitvector_types.h>
+#include <util/irep_hash_consing.h>
+#include <util/symbol_table.h>
+
+TEST_CASE(
+  "Hash consing shares identical ireps",
+  "[core][util][irep_hash_consing]")
+{
+  irep_hash_consingt &table = irep_hash_consingt::instance();
+
+  typet a = signedbv_typet{32};
+  typet b = signedbv_typet{32};
+  REQUIRE(&a.read() != &b.read());
+
+  const std::size_t lookups = table.number_of_lookups();
+  table(a);
+  table(b);
+  REQUIRE(&a.read() == &b.read());
+  REQUIRE(table.number_of_lookups() > lookups);
+
+  SECTION("Comments are taken into account")
+  {
+    typet c = signedbv_typet{32};
+    c.set(ID_C_constant, true);
+    table(c);
+    REQUIRE(&c.read() != &a.read());
+  }
+
+  SECTION("Symbol tables")
+  {
+    symbol_tablet symbol_table;
+    symbolt x;
+    x.name = "x";
+    x.type = signedbv_typet{32};
+    symbol_table.add(x);
+    symbolt y;
+    y.name = "y";
+    y.type = signedbv_typet{32};
+    symbol_table.add(y);
+
+    table(symbol_table);
+    REQUIRE(
+      &symbol_table.lookup_ref("x").type.read() ==
+      &symbol_table.lookup_ref("y").type.read());
+    REQUIRE(&symbol_table.lookup_ref("x").type.read() == &a.read());
+  }
+}
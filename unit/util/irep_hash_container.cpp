@@ -0,0 +1,106 @@
+/*******************************************************************\
+
+Module: Unit tests for irep_hash_containert
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/irep_hash_container.h>
+#include <util/std_expr.h>
+
+#include <chrono>
+
+/// Build a balanced tree of additions over \p depth levels, using fresh
+/// (unshared) nodes throughout
+static exprt make_sum(std::size_t depth, std::size_t &leaf)
+{
+  const signedbv_typet type(32);
+  if(depth == 0)
+    return symbol_exprt("x" + std::to_string(leaf++ % 64), type);
+
+  exprt lhs = make_sum(depth - 1, leaf);
+  exprt rhs = make_sum(depth - 1, leaf);
+  return plus_exprt(std::move(lhs), std::move(rhs));
+}
+
+TEST_CASE(
+  "irep_hash_containert numbering",
+  "[core][util][irep_hash_container]")
+{
+  const signedbv_typet type(32);
+  const symbol_exprt x("x", type);
+  const symbol_exprt y("y", type);
+
+  irep_hash_containert container;
+
+  const std::size_t x_plus_y = container.number(plus_exprt(x, y));
+  const std::size_t y_plus_x = container.number(plus_exprt(y, x));
+  REQUIRE(x_plus_y != y_plus_x);
+
+  // a structurally equal, but unshared, copy gets the same number
+  REQUIRE(container.number(plus_exprt(x, y)) == x_plus_y);
+  REQUIRE(
+    container.number(plus_exprt(symbol_exprt("x", type), y)) == x_plus_y);
+
+  SECTION("Comments are ignored")
+  {
+    plus_exprt with_location(x, y);
+    with_location.add_source_location().set_line(1);
+    REQUIRE(container.number(with_location) == x_plus_y);
+
+    irep_full_hash_containert full_container;
+    REQUIRE(
+      full_container.number(with_location) !=
+      full_container.number(plus_exprt(x, y)));
+  }
+
+  SECTION("Numbers are dense")
+  {
+    const std::size_t size = container.size();
+    REQUIRE(container.number(type) < size);
+    REQUIRE(container.number(x) < size);
+    REQUIRE(container.size() == size);
+
+    // a new irep gets the next number
+    REQUIRE(container.number(plus_exprt(x, x)) == size);
+    REQUIRE(container.size() == size + 1);
+
+    container.clear();
+    REQUIRE(container.size() == 0);
+    const std::size_t y_plus_x_again = container.number(plus_exprt(y, x));
+    REQUIRE(y_plus_x_again == container.size() - 1);
+  }
+}
+
+TEST_CASE(
+  "irep_hash_containert benchmark",
+  "[.][benchmark][irep_hash_container]")
+{
+  using clockt = std::chrono::steady_clock;
+
+  std::vector<exprt> exprs;
+  std::size_t leaf = 0;
+  for(std::size_t i = 0; i < 64; ++i)
+    exprs.push_back(make_sum(12, leaf));
+
+  const auto start = clockt::now();
+  irep_full_hash_containert container;
+  std::size_t sum = 0;
+  for(const auto &expr : exprs)
+    sum += container.number(expr);
+  const auto end = clockt::now();
+
+  WARN(
+    "numbered " << exprs.size() << " trees with " << container.size()
+                << " distinct nodes in "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(
+                     end - start)
+                     .count()
+                << " ms");
+  REQUIRE(sum > 0);
+}
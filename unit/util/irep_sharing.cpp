@@ -2,8 +2,10 @@
 
 /// \file Tests that irep sharing works correctly
 
+#include <testing-utils/benchmark.h>
 #include <testing-utils/use_catch.h>
 
+#include <util/bitvector_types.h>
 #include <util/irep.h>
 #include <util/std_expr.h>
 
@@ -220,3 +222,44 @@ SCENARIO("exprt_sharing", "[core][utils][exprt]")
 }
 
 #endif
+
+/// \return a balanced tree of `plus` with 2^16 distinct leaves, sharing no
+///   subtree with the trees built by other calls
+static exprt make_benchmark_tree()
+{
+  const signedbv_typet type{32};
+  std::vector<exprt> level;
+  for(std::size_t i = 0; i < (1u << 16); ++i)
+    level.push_back(symbol_exprt{"x" + std::to_string(i), type});
+  while(level.size() > 1)
+  {
+    std::vector<exprt> next;
+    for(std::size_t i = 0; i < level.size(); i += 2)
+      next.push_back(plus_exprt{level[i], level[i + 1]});
+    level.swap(next);
+  }
+  return level.front();
+}
+
+TEST_CASE("irept sharing benchmark", "[.][benchmark][irept]")
+{
+  const exprt tree = make_benchmark_tree();
+  const exprt equal_tree = make_benchmark_tree();
+
+  run_benchmark("irept copy and detach along one path", 20, [&tree]() {
+    exprt copy = tree;
+    exprt *node = &copy;
+    while(node->has_operands())
+      node = &to_multi_ary_expr(*node).op0();
+    node->set(ID_identifier, "y");
+    REQUIRE(copy != tree);
+  });
+
+  run_benchmark("irept comparison without sharing", 5, [&]() {
+    REQUIRE(tree == equal_tree);
+  });
+
+  run_benchmark("irept full hash", 5, [&tree]() {
+    REQUIRE(tree.full_hash() != 0);
+  });
+}
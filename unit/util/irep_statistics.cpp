@@ -0,0 +1,40 @@
+/*******************************************************************\
+
+Module: Unit tests for irep_statisticst
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/irep.h>
+#include <util/irep_statistics.h>
+
+#ifdef IREP_STATS
+
+TEST_CASE("irep_statisticst counts detaches", "[core][util][irep_statistics]")
+{
+  const irep_counterst &counters =
+    irep_statisticst::scope("irep_statistics unit test");
+  const irep_counterst before = counters;
+
+  {
+    irep_statistics_scopet scope("irep_statistics unit test");
+
+    irept irep("id");
+    irep.get_sub().push_back(irept("a"));
+    irep.get_sub().push_back(irept("b"));
+
+    irept copy = irep;
+    copy.id("other");
+  }
+
+  // "id", "a", "b" and the copy of "id"
+  REQUIRE(counters.allocations - before.allocations == 4);
+  REQUIRE(counters.deallocations - before.deallocations == 4);
+  REQUIRE(counters.detaches - before.detaches == 1);
+  REQUIRE(counters.detached_subtrees - before.detached_subtrees == 2);
+}
+
+#endif
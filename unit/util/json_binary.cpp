@@ -0,0 +1,73 @@
+/*******************************************************************\
+
+Module: Unit tests for the binary encoding of JSON values
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/exception_utils.h>
+#include <util/json.h>
+#include <util/json_binary.h>
+
+#include <sstream>
+
+static std::string as_string(const jsont &json)
+{
+  std::ostringstream out;
+  out << json;
+  return out.str();
+}
+
+SCENARIO("binary_json", "[core][util][json_binary]")
+{
+  GIVEN("A sequence of JSON values sharing strings")
+  {
+    json_objectt first{
+      {"file", json_stringt{"main.c"}},
+      {"line", json_numbert{"42"}},
+      {"value", json_numbert{"-1.5"}},
+      {"hidden", json_falset{}},
+      {"internal", json_truet{}},
+      {"lhs", json_nullt{}},
+      {"steps",
+       json_arrayt{json_numbert{"0"}, json_numbert{"007"}, json_stringt{""}}}};
+    json_objectt second{
+      {"file", json_stringt{"main.c"}},
+      {"line", json_numbert{"18446744073709551616"}}};
+
+    std::stringstream stream;
+    binary_json_writert writer(stream);
+    writer.write(first);
+    writer.write(second);
+
+    THEN("Reading them back gives the same values")
+    {
+      binary_json_readert reader(stream);
+      jsont json;
+      REQUIRE(reader.read(json));
+      REQUIRE(as_string(json) == as_string(first));
+      REQUIRE(reader.read(json));
+      REQUIRE(as_string(json) == as_string(second));
+      REQUIRE_FALSE(reader.read(json));
+    }
+
+    THEN("Repeated strings are written only once")
+    {
+      REQUIRE(stream.str().find("main.c") == stream.str().rfind("main.c"));
+    }
+
+    THEN("Truncated input is rejected")
+    {
+      std::string truncated = stream.str();
+      truncated.pop_back();
+      std::istringstream in(truncated);
+      binary_json_readert reader(in);
+      jsont json;
+      REQUIRE(reader.read(json));
+      REQUIRE_THROWS_AS(reader.read(json), deserialization_exceptiont);
+    }
+  }
+}
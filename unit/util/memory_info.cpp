@@ -19,3 +19,17 @@ TEST_CASE("memory_info returns some output", "[core][util][memory_info]")
 
   REQUIRE(!oss.str().empty());
 }
+
+TEST_CASE("resident set sizes are consistent", "[core][util][memory_info]")
+{
+  const std::size_t current = current_rss();
+  const std::size_t peak = peak_rss();
+
+#ifdef __linux__
+  REQUIRE(current != 0);
+  REQUIRE(peak != 0);
+#endif
+
+  if(current != 0 && peak != 0)
+    REQUIRE(current <= peak);
+}
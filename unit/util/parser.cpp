@@ -0,0 +1,71 @@
+/*******************************************************************\
+
+Module: Unit tests for parsert
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/parser.h>
+
+#include <sstream>
+
+class test_parsert : public parsert
+{
+public:
+  bool parse() override
+  {
+    text.clear();
+    char ch;
+    while(read(ch))
+      text += ch;
+    return false;
+  }
+
+  std::string text;
+};
+
+TEST_CASE("parsert reads all input", "[core][util][parser]")
+{
+  // more than a block of input
+  std::string input;
+  for(std::size_t i = 0; i < 20000; ++i)
+    input += "line " + std::to_string(i) + "\n";
+  input += "last";
+
+  test_parsert parser;
+  std::istringstream in(input);
+  parser.in = &in;
+  parser.parse();
+
+  REQUIRE(parser.text == input);
+  REQUIRE(parser.this_line == "last");
+  REQUIRE(parser.last_line == "line 19999");
+  REQUIRE(parser.eof());
+}
+
+TEST_CASE("parsert switches streams", "[core][util][parser]")
+{
+  test_parsert parser;
+  std::istringstream first("first\nstream");
+  parser.in = &first;
+
+  char ch;
+  REQUIRE(parser.read(ch));
+  REQUIRE(ch == 'f');
+  REQUIRE_FALSE(parser.eof());
+
+  // what is left of the first stream is not read from the second
+  std::istringstream second("second");
+  parser.in = &second;
+  parser.parse();
+  REQUIRE(parser.text == "second");
+
+  parser.clear();
+  std::istringstream third("third");
+  parser.in = &third;
+  parser.parse();
+  REQUIRE(parser.text == "third");
+}
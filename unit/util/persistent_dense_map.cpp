@@ -0,0 +1,231 @@
+/*******************************************************************\
+
+Module: Unit tests for persistent_dense_map
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/benchmark.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/persistent_dense_map.h>
+#include <util/sharing_map.h>
+
+#include <map>
+#include <random>
+
+typedef persistent_dense_mapt<std::size_t, int> mapt;
+
+static std::map<std::size_t, int> as_map(const mapt &map)
+{
+  mapt::viewt view;
+  map.get_view(view);
+
+  std::map<std::size_t, int> result;
+  for(const auto &item : view)
+    REQUIRE(result.emplace(item.first, item.second).second);
+  REQUIRE(result.size() == map.size());
+  return result;
+}
+
+TEST_CASE("persistent_dense_mapt basic", "[core][util][persistent_dense_map]")
+{
+  mapt map;
+  REQUIRE(map.empty());
+  REQUIRE(!map.has_key(0));
+
+  map.insert(0, 10);
+  map.insert(31, 20);
+  map.insert(32, 30);
+  map.insert(100000, 40);
+  REQUIRE(map.size() == 4);
+
+  REQUIRE(map.find(0)->get() == 10);
+  REQUIRE(map.find(31)->get() == 20);
+  REQUIRE(map.find(32)->get() == 30);
+  REQUIRE(map.find(100000)->get() == 40);
+  REQUIRE(!map.find(1).has_value());
+  REQUIRE(!map.find(100001).has_value());
+  REQUIRE(!map.find(std::size_t(1) << 40).has_value());
+
+  map.replace(31, 21);
+  map.update(32, [](int &m) { ++m; });
+  REQUIRE(map.find(31)->get() == 21);
+  REQUIRE(map.find(32)->get() == 31);
+
+  map.erase(100000);
+  map.erase_if_exists(100000);
+  map.erase_if_exists(5);
+  REQUIRE(map.size() == 3);
+  REQUIRE(!map.has_key(100000));
+
+  map.erase(0);
+  map.erase(31);
+  map.erase(32);
+  REQUIRE(map.empty());
+  map.insert(7, 70);
+  REQUIRE(map.find(7)->get() == 70);
+
+  cbmc_invariants_should_throwt invariants_throw_in_this_scope;
+  REQUIRE_THROWS_AS(map.insert(7, 71), invariant_failedt);
+  REQUIRE_THROWS_AS(map.replace(8, 80), invariant_failedt);
+  REQUIRE_THROWS_AS(map.erase(8), invariant_failedt);
+}
+
+TEST_CASE(
+  "persistent_dense_mapt copies are independent",
+  "[core][util][persistent_dense_map]")
+{
+  mapt map;
+  for(std::size_t i = 0; i < 2000; i += 3)
+    map.insert(i, static_cast<int>(i));
+
+  mapt copy = map;
+  copy.replace(3, -1);
+  copy.insert(1, 1);
+  copy.erase(6);
+  copy.insert(50000, 5);
+
+  REQUIRE(map.find(3)->get() == 3);
+  REQUIRE(!map.has_key(1));
+  REQUIRE(map.has_key(6));
+  REQUIRE(!map.has_key(50000));
+
+  REQUIRE(copy.find(3)->get() == -1);
+  REQUIRE(copy.find(1)->get() == 1);
+  REQUIRE(!copy.has_key(6));
+  REQUIRE(copy.find(50000)->get() == 5);
+  REQUIRE(copy.size() == map.size() + 1);
+}
+
+TEST_CASE(
+  "persistent_dense_mapt agrees with std::map",
+  "[core][util][persistent_dense_map]")
+{
+  std::mt19937 random(0);
+  // small keys most of the time, to have changes in the same leaves
+  std::uniform_int_distribution<std::size_t> key_distribution(0, 3000);
+
+  mapt map;
+  std::map<std::size_t, int> reference;
+
+  for(int round = 0; round < 4; ++round)
+  {
+    mapt old_map = map;
+    const std::map<std::size_t, int> old_reference = reference;
+
+    for(int i = 0; i < 500; ++i)
+    {
+      std::size_t k = key_distribution(random);
+      if(i % 50 == 0)
+        k <<= 10;
+      const int m = static_cast<int>(random() % 4);
+
+      if(reference.count(k) == 0)
+      {
+        map.insert(k, m);
+        reference.emplace(k, m);
+      }
+      else if(m == 0)
+      {
+        map.erase(k);
+        reference.erase(k);
+      }
+      else
+      {
+        map.replace(k, m);
+        reference[k] = m;
+      }
+    }
+
+    REQUIRE(as_map(map) == reference);
+    REQUIRE(as_map(old_map) == old_reference);
+
+    mapt::delta_viewt delta_view;
+    mapt::delta_viewt other_delta_view;
+    map.get_symmetric_delta_view(old_map, delta_view, other_delta_view);
+
+    std::map<std::size_t, int> expected_delta;
+    std::map<std::size_t, int> expected_other_delta;
+    for(const auto &entry : reference)
+    {
+      const auto it = old_reference.find(entry.first);
+      if(it == old_reference.end() || it->second != entry.second)
+        expected_delta.insert(entry);
+    }
+    for(const auto &entry : old_reference)
+    {
+      if(reference.count(entry.first) == 0)
+        expected_other_delta.insert(entry);
+    }
+
+    std::map<std::size_t, int> actual_delta;
+    for(const auto &item : delta_view)
+    {
+      const auto it = old_reference.find(item.k);
+      REQUIRE(item.is_in_both_maps() == (it != old_reference.end()));
+      if(item.is_in_both_maps())
+        REQUIRE(item.get_other_map_value() == it->second);
+      REQUIRE(actual_delta.emplace(item.k, item.m).second);
+    }
+    std::map<std::size_t, int> actual_other_delta;
+    for(const auto &item : other_delta_view)
+    {
+      REQUIRE(!item.is_in_both_maps());
+      REQUIRE(actual_other_delta.emplace(item.k, item.m).second);
+    }
+
+    REQUIRE(actual_delta == expected_delta);
+    REQUIRE(actual_other_delta == expected_other_delta);
+  }
+}
+
+TEST_CASE(
+  "persistent_dense_mapt benchmark",
+  "[.][benchmark][persistent_dense_map]")
+{
+  const std::size_t entries = 100000;
+  typedef sharing_mapt<std::size_t, std::size_t> sharing_benchmark_mapt;
+  typedef persistent_dense_mapt<std::size_t, std::size_t> dense_benchmark_mapt;
+
+  sharing_benchmark_mapt sharing_map;
+  dense_benchmark_mapt dense_map;
+  for(std::size_t i = 0; i < entries; ++i)
+  {
+    sharing_map.insert(i, i);
+    dense_map.insert(i, i);
+  }
+
+  std::size_t found = 0;
+  run_benchmark("sharing_mapt find", 5, [&]() {
+    for(std::size_t i = 0; i < entries; ++i)
+      found += sharing_map.find(i).has_value();
+  });
+  run_benchmark("persistent_dense_mapt find", 5, [&]() {
+    for(std::size_t i = 0; i < entries; ++i)
+      found += dense_map.find(i).has_value();
+  });
+  REQUIRE(found == 12 * entries);
+
+  // the situation of a merge in symex: a copy of the map with a few
+  // changes, whose delta is then computed
+  run_benchmark("sharing_mapt copy, update and delta view", 5, [&]() {
+    sharing_benchmark_mapt copy = sharing_map;
+    for(std::size_t i = 0; i < entries; i += 1000)
+      copy.replace(i, i + 1);
+    sharing_benchmark_mapt::delta_viewt delta_view;
+    sharing_benchmark_mapt::delta_viewt other_delta_view;
+    copy.get_symmetric_delta_view(sharing_map, delta_view, other_delta_view);
+    REQUIRE(delta_view.size() == entries / 1000);
+  });
+  run_benchmark("persistent_dense_mapt copy, update and delta view", 5, [&]() {
+    dense_benchmark_mapt copy = dense_map;
+    for(std::size_t i = 0; i < entries; i += 1000)
+      copy.replace(i, i + 1);
+    dense_benchmark_mapt::delta_viewt delta_view;
+    dense_benchmark_mapt::delta_viewt other_delta_view;
+    copy.get_symmetric_delta_view(dense_map, delta_view, other_delta_view);
+    REQUIRE(delta_view.size() == entries / 1000);
+  });
+}
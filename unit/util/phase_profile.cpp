@@ -0,0 +1,66 @@
+/*******************************************************************\
+
+Module: Unit tests for phase_profile.h
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/irep.h>
+#include <util/phase_profile.h>
+
+TEST_CASE("Phases nest and repeated phases merge", "[core][util][phase_profile]")
+{
+  {
+    phase_profile_scopet not_recorded("before enabling");
+  }
+
+  phase_profilert::enable();
+  REQUIRE(phase_profilert::is_enabled());
+
+  for(int i = 0; i < 2; ++i)
+  {
+    phase_profile_scopet outer("outer");
+    phase_profile_scopet inner("inner");
+  }
+  {
+    phase_profile_scopet other("other");
+  }
+
+  const json_objectt profile = phase_profilert::to_json();
+  REQUIRE(profile["name"].value == "run");
+
+  const json_arrayt &phases = to_json_array(profile["phases"]);
+  REQUIRE(phases.size() == 2);
+
+  const json_objectt &outer = to_json_object(*phases.begin());
+  REQUIRE(outer["name"].value == "outer");
+  REQUIRE(outer["calls"].value == "2");
+
+  const json_arrayt &inner = to_json_array(outer["phases"]);
+  REQUIRE(inner.size() == 1);
+  REQUIRE(to_json_object(*inner.begin())["calls"].value == "2");
+
+  const json_objectt &other = to_json_object(*std::next(phases.begin()));
+  REQUIRE(other["name"].value == "other");
+  REQUIRE(other.find("phases") == other.end());
+}
+
+#ifdef IREP_STATS
+
+TEST_CASE("Phases count the operations on ireps", "[core][util][phase_profile]")
+{
+  const irep_counterst &counters = irep_statisticst::scope("irep phase");
+  const std::size_t allocations = counters.allocations;
+
+  {
+    phase_profile_scopet phase("irep phase");
+    irept irep("id");
+  }
+
+  REQUIRE(counters.allocations - allocations == 1);
+}
+
+#endif
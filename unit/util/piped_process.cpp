@@ -0,0 +1,52 @@
+/*******************************************************************\
+
+Module: Communication with a Child Process via Pipes unit tests
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+#include <util/piped_process.h>
+
+#ifndef _WIN32
+
+TEST_CASE("Exchange lines with a child process", "[core][util][piped_process]")
+{
+  piped_processt process({"cat"});
+  REQUIRE(process.is_running());
+
+  for(int i = 0; i < 3; i++)
+  {
+    process.input() << "line " << i << '\n' << std::flush;
+
+    std::string line;
+    REQUIRE(std::getline(process.output(), line));
+    REQUIRE(line == "line " + std::to_string(i));
+  }
+}
+
+TEST_CASE(
+  "Output of a child process that cannot be run ends",
+  "[core][util][piped_process]")
+{
+  piped_processt process({"no-such-executable-for-piped-process"});
+  process.input() << "ignored\n" << std::flush;
+  REQUIRE(process.output().get() == std::char_traits<char>::eof());
+}
+
+TEST_CASE(
+  "Writing to a child process that has terminated fails",
+  "[core][util][piped_process]")
+{
+  piped_processt process({"true"});
+  REQUIRE(process.is_running());
+  REQUIRE(process.output().get() == std::char_traits<char>::eof());
+
+  const std::string line(1024, 'x');
+  for(int i = 0; i < 1024 && process.input(); i++)
+    process.input() << line << '\n' << std::flush;
+  REQUIRE(!process.input());
+}
+
+#endif
@@ -0,0 +1,59 @@
+/*******************************************************************\
+
+Module: Unit tests for pool_allocator.h
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/pool_allocator.h>
+
+#include <forward_list>
+#include <set>
+
+TEST_CASE("fixed_size_poolt re-uses freed blocks", "[core][util][pool_allocator]")
+{
+  fixed_size_poolt pool{24, 4};
+
+  REQUIRE(pool.get_block_size() >= 24);
+  REQUIRE(pool.get_block_size() % alignof(std::max_align_t) == 0);
+
+  std::set<void *> blocks;
+  for(int i = 0; i < 6; ++i)
+    blocks.insert(pool.allocate());
+
+  REQUIRE(blocks.size() == 6);
+  REQUIRE(pool.number_of_slabs() == 2);
+  REQUIRE(pool.get_blocks_in_use() == 6);
+
+  void *first = *blocks.begin();
+  pool.deallocate(first);
+  REQUIRE(pool.get_blocks_in_use() == 5);
+
+  // the most recently freed block is handed out again
+  REQUIRE(pool.allocate() == first);
+  REQUIRE(pool.number_of_slabs() == 2);
+
+  for(void *block : blocks)
+    pool.deallocate(block);
+  REQUIRE(pool.get_blocks_in_use() == 0);
+}
+
+TEST_CASE("pool_allocatort in standard containers", "[core][util][pool_allocator]")
+{
+  std::forward_list<int, pool_allocatort<int>> list;
+  for(int i = 0; i < 1000; ++i)
+    list.push_front(i);
+
+  int expected = 999;
+  for(const int value : list)
+  {
+    REQUIRE(value == expected);
+    --expected;
+  }
+
+  list.clear();
+  REQUIRE(list.empty());
+}
@@ -0,0 +1,135 @@
+/*******************************************************************\
+
+Module: Unit tests for process_poolt
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/process_pool.h>
+
+#ifndef _WIN32
+#  include <util/exit_codes.h>
+#  include <util/tempfile.h>
+
+#  include <chrono>
+#  include <fstream>
+#  include <iostream>
+#  include <map>
+#  include <stdexcept>
+
+#  include <unistd.h>
+
+SCENARIO(
+  "process_poolt runs functions in processes",
+  "[core][util][process_pool]")
+{
+  GIVEN("Processes that exit or throw")
+  {
+    process_poolt pool;
+    int shared = 1;
+
+    for(std::size_t id = 0; id < 4; ++id)
+    {
+      REQUIRE_FALSE(pool.start(id, [id, &shared]() {
+        // the process has a copy of this one's objects
+        shared = 2;
+        if(id == 3)
+          throw std::runtime_error("failed");
+        return static_cast<int>(id);
+      }));
+    }
+
+    REQUIRE(pool.running() == 4);
+
+    THEN("wait_for_any returns each of them once with their exit codes")
+    {
+      std::map<std::size_t, optionalt<int>> exit_codes;
+      while(auto finished = pool.wait_for_any())
+        REQUIRE(exit_codes.emplace(finished->id, finished->exit_code).second);
+
+      REQUIRE(pool.running() == 0);
+      REQUIRE(exit_codes.size() == 4);
+      REQUIRE(exit_codes[0] == 0);
+      REQUIRE(exit_codes[1] == 1);
+      REQUIRE(exit_codes[2] == 2);
+      REQUIRE(exit_codes[3] == CPROVER_EXIT_EXCEPTION);
+      REQUIRE(shared == 1);
+    }
+  }
+
+  GIVEN("A process writing more output than fits into a pipe")
+  {
+    process_poolt pool;
+    REQUIRE_FALSE(pool.start(
+      7,
+      []() {
+        for(std::size_t i = 0; i < 20000; ++i)
+          std::cout << i << '\n';
+        return 0;
+      },
+      true));
+
+    THEN("The output is captured entirely")
+    {
+      std::string expected;
+      for(std::size_t i = 0; i < 20000; ++i)
+        expected += std::to_string(i) + "\n";
+
+      const auto finished = pool.wait_for_any();
+      REQUIRE(finished.has_value());
+      REQUIRE(finished->id == 7);
+      REQUIRE(finished->exit_code == 0);
+      REQUIRE(finished->output == expected);
+      REQUIRE_FALSE(pool.wait_for_any().has_value());
+    }
+  }
+
+  GIVEN("A process group whose shell command starts another process")
+  {
+    temporary_filet result_file("process_pool", ".out");
+    const std::string command =
+      "(sleep 1; echo late > " + result_file() + ") & echo early";
+    const auto run_command = [&command]() {
+      execl(
+        "/bin/sh", "sh", "-c", command.c_str(), static_cast<char *>(nullptr));
+      return 127;
+    };
+
+    THEN("The process finishes once the command it started has")
+    {
+      process_poolt pool;
+      REQUIRE_FALSE(pool.start(0, run_command, true, true));
+
+      const auto finished = pool.wait_for_any();
+      REQUIRE(finished.has_value());
+      REQUIRE(finished->output == "early\n");
+
+      std::string result;
+      std::ifstream(result_file()) >> result;
+      REQUIRE(result == "late");
+    }
+
+    THEN("Destroying the pool kills the whole group")
+    {
+      const auto start = std::chrono::steady_clock::now();
+
+      {
+        process_poolt pool;
+        REQUIRE_FALSE(pool.start(0, run_command, true, true));
+      }
+
+      REQUIRE(
+        std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+
+      // the process writing the result file was killed as well
+      sleep(2);
+      std::string result;
+      std::ifstream(result_file()) >> result;
+      REQUIRE(result.empty());
+    }
+  }
+}
+#endif
@@ -12,6 +12,7 @@ Author: Michael Tautschnig
 #include <util/tempfile.h>
 
 #include <fstream>
+#include <sstream>
 
 SCENARIO("run() error reporting", "[core][util][run]")
 {
@@ -42,3 +43,26 @@ SCENARIO("run() error reporting", "[core][util][run]")
     }
   }
 }
+
+#ifndef _WIN32
+SCENARIO("run() output to a stream", "[core][util][run]")
+{
+  GIVEN("A command writing more than fits into a pipe")
+  {
+    temporary_filet tmp_input("tmp.txt", "");
+    std::string input;
+    for(std::size_t i = 0; i < 20000; ++i)
+      input += std::to_string(i) + "\n";
+    std::ofstream(tmp_input()) << input;
+
+    std::ostringstream output;
+    int result = run("cat", {"cat"}, tmp_input(), output, "");
+
+    THEN("run returns zero and the complete output")
+    {
+      REQUIRE(result == 0);
+      REQUIRE(output.str() == input);
+    }
+  }
+}
+#endif
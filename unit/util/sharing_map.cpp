@@ -9,6 +9,7 @@ Author: Daniel Poetzl
 #define SM_INTERNAL_CHECKS
 #define SN_INTERNAL_CHECKS
 
+#include <map>
 #include <set>
 
 #include <testing-utils/use_catch.h>
@@ -954,3 +955,375 @@ TEST_CASE("Sharing map with a non-default-constructable value", "[core][util]")
   REQUIRE(!entry_2.is_in_both_maps());
   REQUIRE(entry_2.m.val == 2);
 }
+
+TEST_CASE("Sharing map bulk operations", "[core][util]")
+{
+  auto take_other = [](
+                      const irep_idt &,
+                      const std::string &m,
+                      const std::string &other_m) -> optionalt<std::string> {
+    if(m == other_m)
+      return {};
+    return other_m;
+  };
+
+  auto take_other_unsigned =
+    [](const unsigned &, const std::string &m, const std::string &other_m)
+    -> optionalt<std::string> {
+    if(m == other_m)
+      return {};
+    return other_m;
+  };
+
+  SECTION("Insert range")
+  {
+    const std::vector<std::pair<irep_idt, std::string>> range = {
+      {"i", "0"}, {"j", "1"}, {"k", "2"}};
+
+    sharing_map_standardt sm;
+    sm.insert_range(range.begin(), range.end());
+
+    REQUIRE(sm.size() == 3);
+    REQUIRE(sm.find("j")->get() == "1");
+  }
+
+  SECTION("Erase if")
+  {
+    sharing_map_standardt sm1;
+    fill(sm1);
+    fill2(sm1);
+
+    sharing_map_standardt sm2(sm1);
+    sm2.erase_if([](const irep_idt &, const std::string &m) {
+      return std::stoi(m) % 2 == 0;
+    });
+
+    REQUIRE(sm2.size() == 3);
+    REQUIRE(sm2.has_key("j"));
+    REQUIRE(sm2.has_key("l"));
+    REQUIRE(sm2.has_key("n"));
+    REQUIRE(!sm2.has_key("i"));
+
+    // the original map is unchanged
+    REQUIRE(sm1.size() == 6);
+    REQUIRE(sm1.has_key("i"));
+
+    sm2.erase_if([](const irep_idt &, const std::string &) { return true; });
+    REQUIRE(sm2.empty());
+    sm2.insert("i", "0");
+    REQUIRE(sm2.size() == 1);
+  }
+
+  SECTION("Merge")
+  {
+    sharing_map_standardt sm1;
+    fill(sm1);
+
+    sharing_map_standardt sm2(sm1);
+    sm2.replace("i", "1");
+    fill2(sm2);
+
+    sm1.insert("x", "9");
+    sm1.merge_with(sm2, take_other);
+
+    REQUIRE(sm1.size() == 7);
+    REQUIRE(sm1.find("i")->get() == "1");
+    REQUIRE(sm1.find("j")->get() == "1");
+    REQUIRE(sm1.find("m")->get() == "4");
+    REQUIRE(sm1.find("x")->get() == "9");
+
+    REQUIRE(sm2.size() == 6);
+    REQUIRE(!sm2.has_key("x"));
+
+    // the elements that only exist in sm2 are now shared with sm1
+    sharing_map_standardt::delta_viewt delta_view;
+    sm2.get_delta_view(sm1, delta_view, false);
+    for(const auto &item : delta_view)
+    {
+      REQUIRE(item.is_in_both_maps());
+      REQUIRE(item.m == item.get_other_map_value());
+    }
+
+    sharing_map_standardt sm3;
+    sm3.merge_with(sm2, take_other);
+    REQUIRE(sm3.size() == 6);
+  }
+
+  SECTION("Merge (one of the maps is deeper)")
+  {
+    const std::size_t chunk = 3;
+
+    sharing_map_unsignedt sm1;
+    sm1.insert(0, "a");
+    sm1.insert(1 << (2 * chunk), "b");
+
+    sharing_map_unsignedt sm2;
+    sm2.insert(0, "c");
+    sm2.insert(1, "d");
+
+    sharing_map_unsignedt sm3(sm2);
+
+    sm2.merge_with(
+      sm1,
+      [](const unsigned &, const std::string &m, const std::string &other_m)
+        -> optionalt<std::string> { return m + other_m; });
+
+    REQUIRE(sm2.size() == 3);
+    REQUIRE(sm2.find(0)->get() == "ca");
+    REQUIRE(sm2.find(1)->get() == "d");
+    REQUIRE(sm2.find(1 << (2 * chunk))->get() == "b");
+
+    sm3.merge_with(
+      sm1,
+      [](const unsigned &, const std::string &, const std::string &other_m)
+        -> optionalt<std::string> { return other_m; });
+
+    REQUIRE(sm3.size() == 3);
+    REQUIRE(sm3.find(0)->get() == "a");
+    REQUIRE(sm3.find(1)->get() == "d");
+  }
+
+  SECTION("Merge (collisions)")
+  {
+    typedef sharing_mapt<std::size_t, std::string, false, key_hasht>
+      sharing_map_collisionst;
+
+    sharing_map_collisionst sm1;
+    sm1.insert(0, "a");
+    sm1.insert(8, "b");
+
+    sharing_map_collisionst sm2;
+    sm2.insert(8, "c");
+    sm2.insert(16, "d");
+    sm2.insert(1, "e");
+
+    sm1.merge_with(
+      sm2,
+      [](const std::size_t &, const std::string &m, const std::string &other_m)
+        -> optionalt<std::string> { return m + other_m; });
+
+    REQUIRE(sm1.size() == 4);
+    REQUIRE(sm1.find(0)->get() == "a");
+    REQUIRE(sm1.find(8)->get() == "bc");
+    REQUIRE(sm1.find(16)->get() == "d");
+    REQUIRE(sm1.find(1)->get() == "e");
+
+    sm1.erase_if([](const std::size_t &k, const std::string &) {
+      return k % 8 == 0;
+    });
+    REQUIRE(sm1.size() == 1);
+    REQUIRE(sm1.has_key(1));
+  }
+
+  SECTION("Merge and erase agree with std::map")
+  {
+    sharing_map_unsignedt sm1;
+    std::map<unsigned, std::string> expected;
+
+    // a pseudo-random sequence of keys with many common hash prefixes
+    unsigned key = 1;
+    for(std::size_t i = 0; i < 500; ++i)
+    {
+      key = key * 1103515245 + 12345;
+      const unsigned k = (key >> 8) % 4096;
+      if(expected.insert({k, std::to_string(i)}).second)
+        sm1.insert(k, std::to_string(i));
+    }
+
+    sharing_map_unsignedt sm2(sm1);
+    std::map<unsigned, std::string> expected2 = expected;
+
+    for(std::size_t i = 0; i < 300; ++i)
+    {
+      key = key * 1103515245 + 12345;
+      const unsigned k = (key >> 8) % 8192;
+      if(expected2.count(k) == 0)
+      {
+        expected2[k] = "new";
+        sm2.insert(k, "new");
+      }
+      else if(i % 3 == 0)
+      {
+        expected2[k] += "'";
+        sm2.replace(k, expected2[k]);
+      }
+    }
+
+    sm1.merge_with(sm2, take_other_unsigned);
+    for(const auto &entry : expected2)
+      expected[entry.first] = entry.second;
+
+    REQUIRE(sm1.size() == expected.size());
+    for(const auto &entry : expected)
+      REQUIRE(sm1.find(entry.first)->get() == entry.second);
+
+    auto odd = [](const unsigned &k, const std::string &) {
+      return k % 2 == 1;
+    };
+    sm1.erase_if(odd);
+    for(auto it = expected.begin(); it != expected.end();)
+      it = it->first % 2 == 1 ? expected.erase(it) : std::next(it);
+
+    REQUIRE(sm1.size() == expected.size());
+    for(const auto &entry : expected)
+      REQUIRE(sm1.find(entry.first)->get() == entry.second);
+
+    sm2.erase_if(odd);
+    REQUIRE(sm1.size() == sm2.size());
+  }
+}
+
+// compare the symmetric delta view with the keys reported by two delta views,
+// one in each direction
+template <class some_sharing_mapt>
+void check_symmetric_delta_view(
+  const some_sharing_mapt &sm1,
+  const some_sharing_mapt &sm2)
+{
+  typedef typename some_sharing_mapt::key_type key_type;
+
+  typename some_sharing_mapt::delta_viewt delta_view;
+  typename some_sharing_mapt::delta_viewt other_delta_view;
+  sm1.get_symmetric_delta_view(sm2, delta_view, other_delta_view);
+
+  typename some_sharing_mapt::delta_viewt expected;
+  sm1.get_delta_view(sm2, expected, false);
+
+  typename some_sharing_mapt::delta_viewt reverse;
+  sm2.get_delta_view(sm1, reverse, false);
+
+  std::map<key_type, std::string> found;
+  for(const auto &item : delta_view)
+  {
+    found[item.k] =
+      item.m + "|" +
+      (item.is_in_both_maps() ? item.get_other_map_value() : std::string("-"));
+  }
+
+  std::map<key_type, std::string> expected_found;
+  for(const auto &item : expected)
+  {
+    expected_found[item.k] =
+      item.m + "|" +
+      (item.is_in_both_maps() ? item.get_other_map_value() : std::string("-"));
+  }
+
+  REQUIRE(delta_view.size() == expected.size());
+  REQUIRE(found == expected_found);
+
+  std::set<key_type> other_only;
+  for(const auto &item : other_delta_view)
+  {
+    REQUIRE(!item.is_in_both_maps());
+    REQUIRE(!sm1.has_key(item.k));
+    REQUIRE(sm2.find(item.k)->get() == item.m);
+    other_only.insert(item.k);
+  }
+
+  std::set<key_type> expected_other_only;
+  for(const auto &item : reverse)
+  {
+    if(!item.is_in_both_maps())
+      expected_other_only.insert(item.k);
+  }
+
+  REQUIRE(other_delta_view.size() == expected_other_only.size());
+  REQUIRE(other_only == expected_other_only);
+}
+
+TEST_CASE("Sharing map symmetric delta view", "[core][util]")
+{
+  SECTION("Empty maps")
+  {
+    sharing_map_unsignedt sm1;
+    sharing_map_unsignedt sm2;
+    check_symmetric_delta_view(sm1, sm2);
+
+    sm2.insert(1, "a");
+    check_symmetric_delta_view(sm1, sm2);
+    check_symmetric_delta_view(sm2, sm1);
+  }
+
+  SECTION("One of the maps is deeper")
+  {
+    const std::size_t chunk = 3;
+
+    sharing_map_unsignedt sm1;
+    sm1.insert(0, "a");
+    sm1.insert(1 << (2 * chunk), "b");
+
+    sharing_map_unsignedt sm2;
+    sm2.insert(0, "c");
+    sm2.insert(1, "d");
+
+    check_symmetric_delta_view(sm1, sm2);
+    check_symmetric_delta_view(sm2, sm1);
+
+    sharing_map_unsignedt sm3;
+    sm3.insert(1 << (2 * chunk), "e");
+    check_symmetric_delta_view(sm1, sm3);
+    check_symmetric_delta_view(sm3, sm1);
+  }
+
+  SECTION("Maps with sharing")
+  {
+    sharing_map_unsignedt sm1;
+
+    // a pseudo-random sequence of keys with many common hash prefixes
+    unsigned key = 1;
+    for(std::size_t i = 0; i < 500; ++i)
+    {
+      key = key * 1103515245 + 12345;
+      const unsigned k = (key >> 8) % 4096;
+      if(!sm1.has_key(k))
+        sm1.insert(k, std::to_string(i));
+    }
+
+    sharing_map_unsignedt sm2(sm1);
+    sharing_map_unsignedt sm3(sm1);
+
+    for(std::size_t i = 0; i < 300; ++i)
+    {
+      key = key * 1103515245 + 12345;
+      const unsigned k = (key >> 8) % 8192;
+      if(!sm2.has_key(k))
+        sm2.insert(k, "new");
+      else if(i % 3 == 0)
+        sm2.replace(k, "changed");
+      else if(i % 3 == 1)
+        sm2.erase(k);
+
+      if(i % 7 == 0 && !sm3.has_key(k))
+        sm3.insert(k, "other");
+    }
+
+    check_symmetric_delta_view(sm1, sm2);
+    check_symmetric_delta_view(sm2, sm1);
+    check_symmetric_delta_view(sm2, sm3);
+    check_symmetric_delta_view(sm3, sm2);
+  }
+
+  SECTION("Collisions")
+  {
+    typedef sharing_mapt<std::size_t, std::string, false, key_hasht>
+      sharing_map_collisionst;
+
+    sharing_map_collisionst sm1;
+    sm1.insert(0, "a");
+    sm1.insert(8, "b");
+    sm1.insert(2, "c");
+
+    sharing_map_collisionst sm2;
+    sm2.insert(8, "d");
+    sm2.insert(16, "e");
+    sm2.insert(1, "f");
+
+    check_symmetric_delta_view(sm1, sm2);
+    check_symmetric_delta_view(sm2, sm1);
+
+    sharing_map_collisionst sm3(sm1);
+    sm3.insert(16, "g");
+    check_symmetric_delta_view(sm1, sm3);
+    check_symmetric_delta_view(sm3, sm1);
+  }
+}
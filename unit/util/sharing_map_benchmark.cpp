@@ -0,0 +1,57 @@
+/*******************************************************************\
+
+Module: Benchmarks of sharing map
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Benchmarks of sharing map, kept apart from the unit tests of
+/// sharing_map.cpp, which enable the internal consistency checks
+
+#include <testing-utils/benchmark.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/sharing_map.h>
+
+typedef sharing_mapt<irep_idt, std::size_t, false, irep_id_hash>
+  benchmark_mapt;
+
+TEST_CASE("sharing_mapt benchmark", "[.][benchmark][sharing_map]")
+{
+  const std::size_t entries = 100000;
+  std::vector<irep_idt> keys;
+  keys.reserve(entries);
+  for(std::size_t i = 0; i < entries; ++i)
+    keys.push_back("key" + std::to_string(i));
+
+  benchmark_mapt map;
+
+  run_benchmark("sharing_mapt insert", 5, [&keys]() {
+    benchmark_mapt m;
+    for(std::size_t i = 0; i < keys.size(); ++i)
+      m.insert(keys[i], i);
+  });
+
+  for(std::size_t i = 0; i < keys.size(); ++i)
+    map.insert(keys[i], i);
+
+  std::size_t found = 0;
+  run_benchmark("sharing_mapt find", 5, [&]() {
+    for(const auto &key : keys)
+      found += map.find(key).has_value();
+  });
+  REQUIRE(found == 6 * entries);
+
+  // the situation of a merge in an abstract interpretation: a copy of the
+  // map with a few changes, whose delta is then computed
+  run_benchmark("sharing_mapt copy, update and delta view", 5, [&]() {
+    benchmark_mapt copy = map;
+    for(std::size_t i = 0; i < keys.size(); i += 1000)
+      copy.replace(keys[i], i + 1);
+    benchmark_mapt::delta_viewt delta_view;
+    copy.get_delta_view(map, delta_view, false);
+    REQUIRE(delta_view.size() == entries / 1000);
+  });
+}
@@ -6,6 +6,7 @@ Author: Michael Tautschnig
 
 \*******************************************************************/
 
+#include <testing-utils/benchmark.h>
 #include <testing-utils/use_catch.h>
 
 #include <util/arith_tools.h>
@@ -14,12 +15,16 @@ Author: Michael Tautschnig
 #include <util/c_types.h>
 #include <util/cmdline.h>
 #include <util/config.h>
+#include <util/json.h>
+#include <util/mathematical_expr.h>
 #include <util/namespace.h>
 #include <util/pointer_expr.h>
 #include <util/pointer_predicates.h>
 #include <util/simplify_expr.h>
+#include <util/simplify_expr_class.h>
 #include <util/simplify_utils.h>
 #include <util/std_expr.h>
+#include <util/string_expr.h>
 #include <util/symbol_table.h>
 
 TEST_CASE("Simplify pointer_offset(address of array index)", "[core][util]")
@@ -540,3 +545,173 @@ TEST_CASE("Simplify inequality", "[core][util]")
     REQUIRE(simp == true_exprt{});
   }
 }
+
+TEST_CASE("Simplify with memoization", "[core][util]")
+{
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+
+  simplify_exprt simplifier{ns};
+  simplifier.set_cache_size(4);
+
+  signedbv_typet sbv{8};
+  symbol_exprt x{"x", sbv};
+  const exprt sum = plus_exprt{from_integer(1, sbv), from_integer(2, sbv)};
+
+  exprt first = sum;
+  REQUIRE(!simplifier.simplify(first));
+  REQUIRE(first == from_integer(3, sbv));
+  const std::size_t misses = simplifier.get_cache().misses;
+
+  exprt second = sum;
+  REQUIRE(!simplifier.simplify(second));
+  REQUIRE(second == from_integer(3, sbv));
+  REQUIRE(simplifier.get_cache().hits == 1);
+  REQUIRE(simplifier.get_cache().misses == misses);
+
+  // expressions that do not simplify are memoized as well
+  exprt unchanged = x;
+  REQUIRE(simplifier.simplify(unchanged));
+  REQUIRE(simplifier.simplify(unchanged));
+  REQUIRE(unchanged == x);
+
+  // the number of entries stays bounded
+  for(int i = 0; i < 10; ++i)
+  {
+    exprt e = plus_exprt{x, from_integer(i, sbv)};
+    simplifier.simplify(e);
+  }
+  REQUIRE(simplifier.get_cache().size() <= 4);
+  REQUIRE(simplifier.get_cache().evictions > 0);
+}
+
+TEST_CASE("Simplifier rule statistics", "[core][util]")
+{
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+
+  simplify_exprt::enable_rule_statistics();
+  REQUIRE(simplify_exprt::is_rule_statistics_enabled());
+
+  signedbv_typet sbv{8};
+  symbol_exprt x{"x", sbv};
+  const auto rewrites_of = [](const std::string &rule) {
+    for(const auto &entry : simplify_exprt::get_rule_statistics())
+    {
+      const json_objectt &object = to_json_object(entry);
+      if(object["rule"].value == rule)
+        return std::stoul(object["rewrites"].value);
+    }
+    return 0ul;
+  };
+  const auto plus_rewrites = rewrites_of("plus");
+
+  exprt sum = plus_exprt{from_integer(1, sbv), from_integer(2, sbv)};
+  REQUIRE(!simplify(sum, ns));
+  REQUIRE(rewrites_of("plus") == plus_rewrites + 1);
+
+  // a rule that is called, but does not rewrite
+  exprt product = mult_exprt{x, x};
+  REQUIRE(simplify(product, ns));
+  bool found = false;
+  for(const auto &entry : simplify_exprt::get_rule_statistics())
+  {
+    const json_objectt &object = to_json_object(entry);
+    if(object["rule"].value == "mult")
+    {
+      found = true;
+      REQUIRE(std::stoul(object["calls"].value) >= 1);
+    }
+  }
+  REQUIRE(found);
+}
+
+TEST_CASE("Simplify parsing constant integer strings", "[core][util]")
+{
+  config.set_arch("none");
+
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+
+  const signedbv_typet int_type{32};
+  const unsignedbv_typet char_type{16};
+
+  const auto string_of = [&](const std::string &s) {
+    const array_typet array_type{char_type, from_integer(s.size(), int_type)};
+    array_exprt chars{{}, array_type};
+    for(const char c : s)
+      chars.copy_to_operands(from_integer(c, char_type));
+
+    symbolt symbol;
+    symbol.name = "string_" + std::to_string(symbol_table.symbols.size());
+    symbol.type = array_type;
+    symbol.value = chars;
+    symbol_table.add(symbol);
+
+    return refined_string_exprt{
+      from_integer(s.size(), int_type),
+      address_of_exprt{
+        index_exprt{symbol.symbol_expr(), from_integer(0, int_type)}}};
+  };
+
+  const auto parse_int = [&](const std::string &s, int radix) {
+    const exprt string = string_of(s);
+    const symbol_exprt function{
+      ID_cprover_string_parse_int_func,
+      mathematical_function_typet{{string.type(), int_type}, int_type}};
+    exprt call = function_application_exprt{
+      function, {string, from_integer(radix, int_type)}};
+    simplify(call, ns);
+    return call;
+  };
+
+  REQUIRE(parse_int("123", 10) == from_integer(123, int_type));
+  REQUIRE(parse_int("-ff", 16) == from_integer(-255, int_type));
+  REQUIRE(parse_int("+0", 10) == from_integer(0, int_type));
+
+  // invalid or too large integers are left to the string solver
+  REQUIRE(parse_int("1a", 10).id() == ID_function_application);
+  REQUIRE(parse_int("-", 10).id() == ID_function_application);
+  REQUIRE(parse_int("2147483648", 10).id() == ID_function_application);
+
+  const auto is_valid_int = [&](const std::string &s) {
+    const exprt string = string_of(s);
+    const symbol_exprt function{
+      ID_cprover_string_is_valid_int_func,
+      mathematical_function_typet{{string.type()}, bool_typet{}}};
+    exprt call = function_application_exprt{function, {string}};
+    simplify(call, ns);
+    return call;
+  };
+
+  REQUIRE(is_valid_int("-2147483648") == from_integer(1, bool_typet{}));
+  REQUIRE(is_valid_int("") == from_integer(0, bool_typet{}));
+  REQUIRE(is_valid_int("12 ") == from_integer(0, bool_typet{}));
+}
+
+TEST_CASE("simplify_exprt benchmark", "[.][benchmark][simplify]")
+{
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+  const signedbv_typet sbv{32};
+
+  // the kind of expressions symex produces: sums of constants and
+  // variables, comparisons of those and conditionals
+  std::vector<exprt> expressions;
+  for(int i = 0; i < 10000; ++i)
+  {
+    const symbol_exprt x{"x" + std::to_string(i % 100), sbv};
+    const exprt sum = plus_exprt{
+      plus_exprt{x, from_integer(i, sbv)}, from_integer(-i, sbv)};
+    expressions.push_back(if_exprt{
+      equal_exprt{sum, from_integer(i, sbv)},
+      typecast_exprt{mult_exprt{sum, from_integer(1, sbv)}, sbv},
+      from_integer(i, sbv)});
+  }
+
+  run_benchmark("simplify_expr", 5, [&]() {
+    for(const auto &expr : expressions)
+      simplify_expr(expr, ns);
+  });
+}
+
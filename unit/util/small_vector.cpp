@@ -0,0 +1,97 @@
+/*******************************************************************\
+
+Module: Unit tests for small_vectort
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/small_vector.h>
+
+#include <memory>
+#include <string>
+
+TEST_CASE(
+  "small_vectort stores few elements inline",
+  "[core][util][small_vector]")
+{
+  small_vectort<std::string, 3> v;
+  REQUIRE(v.empty());
+  REQUIRE(v.is_inline());
+
+  v.push_back("a");
+  v.emplace_back("b");
+  v.push_back(v.front());
+  REQUIRE(v.size() == 3);
+  REQUIRE(v.is_inline());
+  REQUIRE(v[2] == "a");
+
+  v.push_back(v[1]);
+  REQUIRE(v.size() == 4);
+  REQUIRE_FALSE(v.is_inline());
+  REQUIRE(v.back() == "b");
+
+  const std::vector<std::string> expected = {"a", "b", "a", "b"};
+  REQUIRE(std::vector<std::string>(v) == expected);
+}
+
+TEST_CASE("small_vectort insert and erase", "[core][util][small_vector]")
+{
+  small_vectort<int, 2> v = {1, 2, 3};
+
+  v.insert(v.begin(), 0);
+  v.insert(v.end(), 2, 4);
+  REQUIRE(std::vector<int>(v) == std::vector<int>({0, 1, 2, 3, 4, 4}));
+
+  const std::vector<int> more = {7, 8};
+  v.insert(v.begin() + 1, more.begin(), more.end());
+  REQUIRE(std::vector<int>(v) == std::vector<int>({0, 7, 8, 1, 2, 3, 4, 4}));
+
+  v.erase(v.begin() + 1, v.begin() + 3);
+  v.erase(v.end() - 1);
+  REQUIRE(std::vector<int>(v) == std::vector<int>({0, 1, 2, 3, 4}));
+
+  v.resize(2);
+  REQUIRE(std::vector<int>(v) == std::vector<int>({0, 1}));
+  v.resize(4, 9);
+  REQUIRE(std::vector<int>(v) == std::vector<int>({0, 1, 9, 9}));
+
+  REQUIRE(*++v.begin() == 1);
+  REQUIRE(v.rbegin()[0] == 9);
+}
+
+TEST_CASE("small_vectort copy, move and swap", "[core][util][small_vector]")
+{
+  using vectort = small_vectort<std::shared_ptr<int>, 2>;
+
+  const auto element = std::make_shared<int>(42);
+
+  vectort small = {element};
+  vectort large = {element, element, element};
+  REQUIRE(element.use_count() == 5);
+
+  vectort small_copy = small;
+  vectort large_copy = large;
+  REQUIRE(element.use_count() == 9);
+  REQUIRE(small_copy == small);
+  REQUIRE(large_copy == large);
+
+  vectort moved = std::move(large_copy);
+  REQUIRE(large_copy.empty());
+  REQUIRE(moved.size() == 3);
+
+  small.swap(moved);
+  REQUIRE(small.size() == 3);
+  REQUIRE(moved.size() == 1);
+  REQUIRE(moved.is_inline());
+
+  moved = std::move(small);
+  REQUIRE(moved.size() == 3);
+
+  moved.clear();
+  small_copy.clear();
+  large.clear();
+  REQUIRE(element.use_count() == 1);
+}
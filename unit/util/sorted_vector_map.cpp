@@ -0,0 +1,123 @@
+/*******************************************************************\
+
+Module: Unit tests for sorted_vector_mapt
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/sorted_vector_map.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST_CASE(
+  "sorted_vector_mapt keeps its elements sorted by key",
+  "[core][util][sorted_vector_map]")
+{
+  sorted_vector_mapt<int, std::string, 2> map;
+  REQUIRE(map.empty());
+
+  REQUIRE(map.insert({3, "c"}).second);
+  REQUIRE(map.insert({1, "a"}).second);
+  map[2] = "b";
+  const auto existing = map.insert({1, "x"});
+  REQUIRE_FALSE(existing.second);
+  REQUIRE(existing.first->second == "a");
+
+  REQUIRE(map.size() == 3);
+  REQUIRE(map.count(2) == 1);
+  REQUIRE(map.count(4) == 0);
+  REQUIRE(map.find(4) == map.end());
+  REQUIRE(map.find(3)->second == "c");
+
+  const sorted_vector_mapt<int, std::string, 2> expected{
+    {2, "b"}, {3, "c"}, {1, "a"}};
+  REQUIRE(map == expected);
+
+  REQUIRE(map.erase(2) == 1);
+  REQUIRE(map.erase(2) == 0);
+  REQUIRE(map.begin()->first == 1);
+  REQUIRE(map.erase(map.begin())->first == 3);
+  REQUIRE(map.size() == 1);
+
+  map.push_back({5, "e"});
+  REQUIRE(map.lower_bound(4)->first == 5);
+  REQUIRE(map != expected);
+}
+
+TEST_CASE(
+  "sorted_vector_mapt behaves like std::map",
+  "[core][util][sorted_vector_map]")
+{
+  std::mt19937 random(42);
+  std::map<unsigned, unsigned> reference;
+  sorted_vector_mapt<unsigned, unsigned> map;
+
+  for(unsigned i = 0; i < 2000; ++i)
+  {
+    const unsigned key = random() % 100;
+    switch(random() % 4)
+    {
+    case 0:
+      REQUIRE(
+        map.insert({key, i}).second == reference.insert({key, i}).second);
+      break;
+    case 1:
+      map[key] = i;
+      reference[key] = i;
+      break;
+    case 2:
+      REQUIRE(map.erase(key) == reference.erase(key));
+      break;
+    default:
+      REQUIRE(map.count(key) == reference.count(key));
+    }
+
+    REQUIRE(map.size() == reference.size());
+  }
+
+  const std::vector<std::pair<unsigned, unsigned>> elements(
+    reference.begin(), reference.end());
+  REQUIRE(std::equal(map.begin(), map.end(), elements.begin()));
+}
+
+TEST_CASE(
+  "sorted_vector_mapt merges in place",
+  "[core][util][sorted_vector_map]")
+{
+  std::mt19937 random(7);
+
+  for(unsigned round = 0; round < 200; ++round)
+  {
+    std::map<unsigned, unsigned> reference;
+    sorted_vector_mapt<unsigned, unsigned> map, other;
+
+    for(unsigned i = random() % 10; i > 0; --i)
+    {
+      const unsigned key = random() % 20;
+      map[key] = key;
+      reference[key] = key;
+    }
+
+    for(unsigned i = random() % 10; i > 0; --i)
+    {
+      const unsigned key = random() % 20;
+      if(!other.insert({key, 100}).second)
+        continue;
+      if(!reference.insert({key, 100}).second)
+        reference[key] = key + 1000;
+    }
+
+    map.merge(other, [](unsigned &value, unsigned) { value += 1000; });
+
+    const std::vector<std::pair<unsigned, unsigned>> elements(
+      reference.begin(), reference.end());
+    REQUIRE(map.size() == elements.size());
+    REQUIRE(std::equal(map.begin(), map.end(), elements.begin()));
+  }
+}
@@ -0,0 +1,93 @@
+/*******************************************************************\
+
+Module: Unit tests for sparse_bitsett
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/sparse_bitset.h>
+
+#include <random>
+#include <set>
+#include <vector>
+
+static std::vector<std::size_t> elements(const sparse_bitsett &s)
+{
+  return std::vector<std::size_t>(s.begin(), s.end());
+}
+
+TEST_CASE(
+  "sparse_bitsett inserts and erases elements",
+  "[core][util][sparse_bitset]")
+{
+  sparse_bitsett s;
+  REQUIRE(s.empty());
+  REQUIRE(s.begin() == s.end());
+
+  REQUIRE(s.insert(70));
+  REQUIRE(s.insert(3));
+  REQUIRE(s.insert(1000));
+  REQUIRE(s.insert(63));
+  REQUIRE_FALSE(s.insert(3));
+  REQUIRE(s.size() == 4);
+  REQUIRE(s.contains(63));
+  REQUIRE_FALSE(s.contains(64));
+
+  const std::vector<std::size_t> expected = {3, 63, 70, 1000};
+  REQUIRE(elements(s) == expected);
+
+  REQUIRE(s.erase(70));
+  REQUIRE_FALSE(s.erase(70));
+  REQUIRE_FALSE(s.erase(5000));
+  const std::vector<std::size_t> after_erase = {3, 63, 1000};
+  REQUIRE(elements(s) == after_erase);
+
+  REQUIRE(s.erase(3));
+  REQUIRE(s.erase(63));
+  REQUIRE(s.erase(1000));
+  REQUIRE(s.empty());
+}
+
+TEST_CASE(
+  "sparse_bitsett union and difference agree with std::set",
+  "[core][util][sparse_bitset]")
+{
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<std::size_t> distribution(0, 400);
+
+  for(int round = 0; round < 100; ++round)
+  {
+    sparse_bitsett a, b;
+    std::set<std::size_t> sa, sb;
+    for(int k = 0; k < 30; ++k)
+    {
+      const std::size_t x = distribution(generator);
+      a.insert(x);
+      sa.insert(x);
+      const std::size_t y = distribution(generator);
+      b.insert(y);
+      sb.insert(y);
+    }
+
+    sparse_bitsett u = a;
+    std::set<std::size_t> su = sa;
+    su.insert(sb.begin(), sb.end());
+    REQUIRE(u.insert(b) == (su != sa));
+    REQUIRE(elements(u) == std::vector<std::size_t>(su.begin(), su.end()));
+    REQUIRE_FALSE(u.insert(b));
+    REQUIRE_FALSE(u.insert(a));
+
+    sparse_bitsett d = a;
+    std::set<std::size_t> sd;
+    for(const auto x : sa)
+      if(sb.count(x) == 0)
+        sd.insert(x);
+    REQUIRE(d.erase(b) == (sd != sa));
+    REQUIRE(elements(d) == std::vector<std::size_t>(sd.begin(), sd.end()));
+    REQUIRE(d.size() == sd.size());
+    REQUIRE_FALSE(d.erase(b));
+  }
+}
@@ -86,6 +86,40 @@ TEST_CASE("Set level", "[unit][util][ssa_expr]")
   }
 }
 
+TEST_CASE("Set level of a member", "[unit][util][ssa_expr]")
+{
+  GIVEN("An SSA expression of a member and one of a symbol of the same name")
+  {
+    const signedbv_typet int_type{32};
+    std::vector<struct_typet::componentt> components;
+    components.emplace_back("field", int_type);
+    const struct_typet struct_type{components};
+    const member_exprt member{symbol_exprt{"sym", struct_type},
+                              components.back()};
+    const symbol_exprt symbol{"sym..field", int_type};
+    ssa_exprt member_ssa{member};
+    ssa_exprt symbol_ssa{symbol};
+    REQUIRE(member_ssa.get_identifier() == symbol_ssa.get_identifier());
+
+    WHEN("the same levels are set on both")
+    {
+      for(ssa_exprt *ssa : {&member_ssa, &symbol_ssa})
+      {
+        ssa->set_level_0(1);
+        ssa->set_level_1(3);
+        ssa->set_level_2(7);
+      }
+      THEN("the levels follow the root symbol")
+      {
+        REQUIRE(member_ssa.get_identifier() == "sym!1@3#7..field");
+        REQUIRE(member_ssa.get_l1_object_identifier() == "sym!1@3..field");
+        REQUIRE(symbol_ssa.get_identifier() == "sym..field!1@3#7");
+        REQUIRE(symbol_ssa.get_l1_object_identifier() == "sym..field!1@3");
+      }
+    }
+  }
+}
+
 TEST_CASE("Set expression", "[unit][util][ssa_expr]")
 {
   GIVEN("An SSA expression constructed from a symbol")
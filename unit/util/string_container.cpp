@@ -0,0 +1,167 @@
+/*******************************************************************\
+
+Module: Unit tests for string_containert
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/benchmark.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/string_container.h>
+
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+
+static std::vector<std::string> make_identifiers(std::size_t n)
+{
+  // resembles the identifiers of a large symbol table
+  std::vector<std::string> result;
+  result.reserve(n);
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    result.push_back(
+      "string_container_test::function_" + std::to_string(i % 1000) +
+      "::1::local_" + std::to_string(i));
+  }
+  return result;
+}
+
+TEST_CASE("string_containert indices", "[core][util][string_container]")
+{
+  string_containert &container = get_string_container();
+
+  const unsigned a = container["string_container_test::a"];
+  const unsigned b = container[std::string("string_container_test::b")];
+  REQUIRE(a != b);
+  REQUIRE(container["string_container_test::a"] == a);
+  REQUIRE(container.get_string(a) == "string_container_test::a");
+  REQUIRE(std::string(container.c_str(b)) == "string_container_test::b");
+
+  // strings may contain null characters
+  const std::string with_null("x\0y", 3);
+  const unsigned c = container[with_null];
+  REQUIRE(c != container["x"]);
+  REQUIRE(container.get_string(c) == with_null);
+}
+
+TEST_CASE(
+  "string_containert concurrent interning",
+  "[core][util][string_container]")
+{
+  const std::vector<std::string> identifiers = make_identifiers(20000);
+  const std::size_t number_of_threads = 4;
+  std::vector<std::vector<unsigned>> indices(
+    number_of_threads, std::vector<unsigned>(identifiers.size()));
+
+  std::vector<std::thread> threads;
+  for(std::size_t t = 0; t < number_of_threads; ++t)
+  {
+    threads.emplace_back([&identifiers, &indices, t]() {
+      string_containert &container = get_string_container();
+      // every thread interns all identifiers, starting at different offsets
+      for(std::size_t i = 0; i < identifiers.size(); ++i)
+      {
+        const std::size_t j = (i + t * 5000) % identifiers.size();
+        indices[t][j] = container[identifiers[j]];
+      }
+    });
+  }
+  for(auto &thread : threads)
+    thread.join();
+
+  const string_containert &container = get_string_container();
+  for(std::size_t i = 0; i < identifiers.size(); ++i)
+  {
+    for(std::size_t t = 1; t < number_of_threads; ++t)
+      REQUIRE(indices[t][i] == indices[0][i]);
+    REQUIRE(container.get_string(indices[0][i]) == identifiers[i]);
+  }
+}
+
+TEST_CASE("string_containert benchmark", "[.][benchmark][string_container]")
+{
+  const std::vector<std::string> identifiers = make_identifiers(1000000);
+  using clockt = std::chrono::steady_clock;
+  const auto milliseconds = [](clockt::duration duration) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+      .count();
+  };
+
+  {
+    // the unsynchronised single-table scheme used previously
+    std::unordered_map<std::string, unsigned> table;
+    std::vector<const std::string *> strings;
+    const auto start = clockt::now();
+    for(int round = 0; round < 2; ++round)
+    {
+      for(const auto &identifier : identifiers)
+      {
+        auto entry = table.emplace(identifier, strings.size());
+        if(entry.second)
+          strings.push_back(&entry.first->first);
+      }
+    }
+    WARN(
+      "unsynchronised hash table: " << milliseconds(clockt::now() - start)
+                                     << "ms");
+  }
+
+  {
+    string_containert container;
+    const auto start = clockt::now();
+    for(int round = 0; round < 2; ++round)
+    {
+      for(const auto &identifier : identifiers)
+        container[identifier];
+    }
+    WARN(
+      "sharded container, one thread: " << milliseconds(clockt::now() - start)
+                                         << "ms");
+  }
+
+  {
+    string_containert container;
+    const std::size_t number_of_threads = 4;
+    const auto start = clockt::now();
+    std::vector<std::thread> threads;
+    for(std::size_t t = 0; t < number_of_threads; ++t)
+    {
+      threads.emplace_back([&identifiers, &container, t, number_of_threads]() {
+        for(int round = 0; round < 2; ++round)
+        {
+          for(std::size_t i = t; i < identifiers.size();
+              i += number_of_threads)
+          {
+            container[identifiers[i]];
+          }
+        }
+      });
+    }
+    for(auto &thread : threads)
+      thread.join();
+    const auto duration = clockt::now() - start;
+    WARN(
+      "sharded container, " << number_of_threads
+                            << " threads: " << milliseconds(duration) << "ms");
+  }
+}
+
+TEST_CASE(
+  "string_containert lookup benchmark",
+  "[.][benchmark][string_container]")
+{
+  const std::vector<std::string> identifiers = make_identifiers(100000);
+  string_containert container;
+  for(const auto &identifier : identifiers)
+    container[identifier];
+
+  unsigned sum = 0;
+  run_benchmark("string_containert lookup", 5, [&]() {
+    for(const auto &identifier : identifiers)
+      sum += container[identifier];
+  });
+  REQUIRE(sum != 0);
+}
@@ -0,0 +1,74 @@
+/*******************************************************************\
+
+Module: Unit tests for writing GraphML
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <xmllang/graphml.h>
+
+#include <sstream>
+
+static xml_graph_nodet make_node(const std::string &name)
+{
+  xml_graph_nodet node;
+  node.node_name = name;
+  node.is_violation = false;
+  node.has_invariant = false;
+  return node;
+}
+
+static xmlt make_edge(const std::string &source, const std::string &target)
+{
+  return xmlt("edge", {{"source", source}, {"target", target}}, {});
+}
+
+TEST_CASE("Streamed GraphML matches the written graph", "[core][xmllang]")
+{
+  graphmlt::key_valuest key_values;
+  key_values["sourcecodelang"] = "C";
+
+  // edges refer to nodes that are only added later
+  const auto add_graph = [](graphml_outputt &output) {
+    output.add_node(make_node("1.1"));
+    output.add_edge(make_edge("1.1", "2.3"));
+    xml_graph_nodet violation = make_node("2.3");
+    violation.is_violation = true;
+    output.add_node(violation);
+    output.add_edge(make_edge("2.3", "sink"));
+    output.add_node(make_node("sink"));
+  };
+
+  graphmlt graph;
+  graph.key_values = key_values;
+  graphml_buildert builder(graph);
+  add_graph(builder);
+
+  REQUIRE(graph.size() == 3);
+  REQUIRE(graph[0].node_name == "1.1");
+  REQUIRE(graph[1].node_name == "2.3");
+  REQUIRE(graph[1].is_violation);
+  REQUIRE(graph[2].node_name == "sink");
+  REQUIRE(graph.has_edge(0, 1));
+  REQUIRE(graph.has_edge(1, 2));
+  REQUIRE(!graph.has_edge(0, 2));
+
+  std::ostringstream written;
+  REQUIRE(!write_graphml(graph, written));
+
+  std::ostringstream streamed;
+  graphml_writert writer(streamed, key_values);
+  add_graph(writer);
+  REQUIRE(!writer.finish());
+
+  REQUIRE(streamed.str() == written.str());
+  REQUIRE(
+    streamed.str().find("<node id=\"1.1\">\n"
+                        "      <data key=\"entry\">true</data>\n"
+                        "    </node>\n") != std::string::npos);
+  REQUIRE(
+    streamed.str().find("  </graph>\n</graphml>\n") != std::string::npos);
+}